@@ -20,6 +20,8 @@ HomeForm {
     signal lap_clicked;
     signal peloton_start_workout;
     signal peloton_abort_workout;
+    signal journal_resume;
+    signal journal_export;
     signal plus_clicked(string name)
     signal minus_clicked(string name)
     signal largeButton_clicked(string name)
@@ -45,6 +47,16 @@ HomeForm {
         visible: rootItem.pelotonAskStart
     }
 
+    MessageDialog {
+        id: messageJournalRecoveryAsk
+        text: "Unfinished workout found"
+        informativeText: "The last workout wasn't saved. Do you want to resume it? Choose No to save it as a FIT file."
+        buttons: (MessageDialog.Yes | MessageDialog.No)
+        onYesClicked: {rootItem.journalRecoveryAsk = false; journal_resume();}
+        onNoClicked: {rootItem.journalRecoveryAsk = false; journal_export();}
+        visible: rootItem.journalRecoveryAsk
+    }
+
     Popup {
         id: popupLap
          parent: Overlay.overlay
@@ -1,6 +1,7 @@
 #include "characteristicwriteprocessor2ad9.h"
 #include "devices/elliptical.h"
 #include "devices/ftmsbike/ftmsbike.h"
+#include "devices/ftmsdecoder.h"
 #include "treadmill.h"
 #include <QSettings>
 #include <QtMath>
@@ -12,127 +13,118 @@ CharacteristicWriteProcessor2AD9::CharacteristicWriteProcessor2AD9(double bikeRe
     : CharacteristicWriteProcessor(bikeResistanceGain, bikeResistanceOffset, bike, parent), notifier(notifier) {}
 
 int CharacteristicWriteProcessor2AD9::writeProcess(quint16 uuid, const QByteArray &data, QByteArray &reply) {
-    if (data.size()) {
-        bluetoothdevice::BLUETOOTH_TYPE dt = Bike->deviceType();
-        if (dt == bluetoothdevice::BIKE) {
-            QSettings settings;
-            bool force_resistance =
-                settings.value(QZSettings::virtualbike_forceresistance, QZSettings::default_virtualbike_forceresistance)
-                    .toBool();
-            bool erg_mode = settings.value(QZSettings::zwift_erg, QZSettings::default_zwift_erg).toBool();
-            char cmd = data.at(0);
-            emit ftmsCharacteristicChanged(QLowEnergyCharacteristic(), data);
-            if (cmd == FTMS_SET_TARGET_RESISTANCE_LEVEL) {
-
-                // Set Target Resistance
-                resistance_t uresistance = data.at(1);
-                uresistance = uresistance / 10;
-                if (force_resistance && !erg_mode) {
-                    Bike->changeResistance(uresistance);
-                }
-                qDebug() << QStringLiteral("new requested resistance ") + QString::number(uresistance) +
-                                QStringLiteral(" enabled ") + force_resistance;
-                reply.append((quint8)FTMS_RESPONSE_CODE);
-                reply.append((quint8)FTMS_SET_TARGET_RESISTANCE_LEVEL);
-                reply.append((quint8)FTMS_SUCCESS);
-            } else if (cmd == FTMS_SET_INDOOR_BIKE_SIMULATION_PARAMS) // simulation parameter
-
-            {
-                qDebug() << QStringLiteral("indoor bike simulation parameters");
-                reply.append((quint8)FTMS_RESPONSE_CODE);
-                reply.append((quint8)FTMS_SET_INDOOR_BIKE_SIMULATION_PARAMS);
-                reply.append((quint8)FTMS_SUCCESS);
-
-                int16_t iresistance = (((uint8_t)data.at(3)) + (data.at(4) << 8));
-                uint8_t crr = data.at(5);
-                uint8_t cw = data.at(6);
-                changeSlope(iresistance, crr, cw);
-            } else if (cmd == FTMS_SET_TARGET_POWER) // erg mode
+    ftmsdecoder::controlpoint request;
+    if (!ftmsdecoder::decodeControlPoint(data, request)) {
+        if (data.size()) {
+            qDebug() << QStringLiteral("truncated control point request") << data.toHex(' ');
+            reply.append((quint8)FTMS_RESPONSE_CODE);
+            reply.append((quint8)request.opcode);
+            reply.append((quint8)FTMS_INVALID_PARAMETER);
+            if (notifier) {
+                notifier->answer = reply;
+            }
+            return CP_OK;
+        }
+        return CP_INVALID;
+    }
 
-            {
-                qDebug() << QStringLiteral("erg mode");
-                reply.append((quint8)FTMS_RESPONSE_CODE);
-                reply.append((quint8)FTMS_SET_TARGET_POWER);
-                reply.append((quint8)FTMS_SUCCESS);
+    bluetoothdevice::BLUETOOTH_TYPE dt = Bike->deviceType();
+    if (dt == bluetoothdevice::BIKE) {
+        QSettings settings;
+        bool force_resistance =
+            settings.value(QZSettings::virtualbike_forceresistance, QZSettings::default_virtualbike_forceresistance)
+                .toBool();
+        bool erg_mode = settings.value(QZSettings::zwift_erg, QZSettings::default_zwift_erg).toBool();
+        char cmd = request.opcode;
+        emit ftmsCharacteristicChanged(QLowEnergyCharacteristic(), data);
+        if (cmd == FTMS_SET_TARGET_RESISTANCE_LEVEL) {
 
-                uint16_t power = (((uint8_t)data.at(1)) + (data.at(2) << 8));
-                changePower(power);
-            } else if (cmd == FTMS_START_RESUME) {
-                qDebug() << QStringLiteral("start simulation!");
+            // Set Target Resistance
+            resistance_t uresistance = request.value(0);
+            if (force_resistance && !erg_mode) {
+                Bike->changeResistance(uresistance);
+            }
+            qDebug() << QStringLiteral("new requested resistance ") + QString::number(uresistance) +
+                            QStringLiteral(" enabled ") + force_resistance;
+            reply.append((quint8)FTMS_RESPONSE_CODE);
+            reply.append((quint8)FTMS_SET_TARGET_RESISTANCE_LEVEL);
+            reply.append((quint8)FTMS_SUCCESS);
+        } else if (cmd == FTMS_SET_INDOOR_BIKE_SIMULATION_PARAMS) // simulation parameter
 
-                reply.append((quint8)FTMS_RESPONSE_CODE);
-                reply.append((quint8)FTMS_START_RESUME);
-                reply.append((quint8)FTMS_SUCCESS);
-            } else if (cmd == FTMS_REQUEST_CONTROL) {
-                qDebug() << QStringLiteral("control requested");
+        {
+            qDebug() << QStringLiteral("indoor bike simulation parameters");
+            reply.append((quint8)FTMS_RESPONSE_CODE);
+            reply.append((quint8)FTMS_SET_INDOOR_BIKE_SIMULATION_PARAMS);
+            reply.append((quint8)FTMS_SUCCESS);
 
-                reply.append((quint8)FTMS_RESPONSE_CODE);
-                reply.append((char)FTMS_REQUEST_CONTROL);
-                reply.append((quint8)FTMS_SUCCESS);
-            } else {
-                qDebug() << QStringLiteral("not supported");
+            changeSlope(request.rawValue(1), request.rawValue(2), request.rawValue(3));
+        } else if (cmd == FTMS_SET_TARGET_POWER) // erg mode
 
-                reply.append((quint8)FTMS_RESPONSE_CODE);
-                reply.append((quint8)cmd);
-                reply.append((quint8)FTMS_NOT_SUPPORTED);
-            }
-        } else if (dt == bluetoothdevice::TREADMILL || dt == bluetoothdevice::ELLIPTICAL) {
-            char a, b;
-            if ((char)data.at(0) == 0x02) {
-                // Set Target Speed
-                a = data.at(1);
-                b = data.at(2);
+        {
+            qDebug() << QStringLiteral("erg mode");
+            reply.append((quint8)FTMS_RESPONSE_CODE);
+            reply.append((quint8)FTMS_SET_TARGET_POWER);
+            reply.append((quint8)FTMS_SUCCESS);
 
-                uint16_t uspeed = a + (((uint16_t)b) << 8);
-                double requestSpeed = (double)uspeed / 100.0;
-                if (dt == bluetoothdevice::TREADMILL) {
-                    ((treadmill *)Bike)->changeSpeed(requestSpeed);
-                }
-                qDebug() << QStringLiteral("new requested speed ") + QString::number(requestSpeed);
-            } else if ((char)data.at(0) == 0x03) // Set Target Inclination
-            {
-                a = data.at(1);
-                b = data.at(2);
+            changePower(request.value(0));
+        } else if (cmd == FTMS_START_RESUME) {
+            qDebug() << QStringLiteral("start simulation!");
 
-                int16_t sincline = a + (((int16_t)b) << 8);
-                double requestIncline = (double)sincline / 10.0;
-                if (requestIncline < 0)
-                    requestIncline = 0;
+            reply.append((quint8)FTMS_RESPONSE_CODE);
+            reply.append((quint8)FTMS_START_RESUME);
+            reply.append((quint8)FTMS_SUCCESS);
+        } else if (cmd == FTMS_REQUEST_CONTROL) {
+            qDebug() << QStringLiteral("control requested");
 
-                if (dt == bluetoothdevice::TREADMILL)
-                    ((treadmill *)Bike)->changeInclination(requestIncline, requestIncline);
-                // Resistance as incline on Sole E95s Elliptical #419
-                else if (dt == bluetoothdevice::ELLIPTICAL) {
-                    if(((elliptical *)Bike)->inclinationAvailableByHardware())
-                        ((elliptical *)Bike)->changeInclination(requestIncline, requestIncline);
-                    else
-                        changeSlope(requestIncline * 100.0, 33, 34);
-                }
-                qDebug() << "new requested incline " + QString::number(requestIncline);
-            } else if ((char)data.at(0) == 0x07) // Start request
-            {
-                // Bike->start();
-                qDebug() << QStringLiteral("request to start");
-            } else if ((char)data.at(0) == 0x08) // Stop request
-            {
-                // Bike->stop();
-                qDebug() << QStringLiteral("request to stop");
-            } else if ((char)data.at(0) == FTMS_SET_INDOOR_BIKE_SIMULATION_PARAMS) // simulation parameter
-            {
-                qDebug() << QStringLiteral("indoor bike simulation parameters");
-                int16_t iresistance = (((uint8_t)data.at(3)) + (data.at(4) << 8));
-                uint8_t crr = data.at(5);
-                uint8_t cw = data.at(6);
-                changeSlope(iresistance, crr, cw);
-            }
             reply.append((quint8)FTMS_RESPONSE_CODE);
-            reply.append((quint8)data.at(0));
+            reply.append((char)FTMS_REQUEST_CONTROL);
             reply.append((quint8)FTMS_SUCCESS);
+        } else {
+            qDebug() << QStringLiteral("not supported");
+
+            reply.append((quint8)FTMS_RESPONSE_CODE);
+            reply.append((quint8)cmd);
+            reply.append((quint8)FTMS_NOT_SUPPORTED);
         }
-        if (notifier) {
-            notifier->answer = reply;
+    } else if (dt == bluetoothdevice::TREADMILL || dt == bluetoothdevice::ELLIPTICAL) {
+        if (request.opcode == FTMS_SET_TARGET_SPEED) {
+            double requestSpeed = request.value(0);
+            if (dt == bluetoothdevice::TREADMILL) {
+                ((treadmill *)Bike)->changeSpeed(requestSpeed);
+            }
+            qDebug() << QStringLiteral("new requested speed ") + QString::number(requestSpeed);
+        } else if (request.opcode == FTMS_SET_TARGET_INCLINATION) {
+            double requestIncline = request.value(0);
+            if (requestIncline < 0)
+                requestIncline = 0;
+
+            if (dt == bluetoothdevice::TREADMILL)
+                ((treadmill *)Bike)->changeInclination(requestIncline, requestIncline);
+            // Resistance as incline on Sole E95s Elliptical #419
+            else if (dt == bluetoothdevice::ELLIPTICAL) {
+                if(((elliptical *)Bike)->inclinationAvailableByHardware())
+                    ((elliptical *)Bike)->changeInclination(requestIncline, requestIncline);
+                else
+                    changeSlope(requestIncline * 100.0, 33, 34);
+            }
+            qDebug() << "new requested incline " + QString::number(requestIncline);
+        } else if (request.opcode == FTMS_START_RESUME) {
+            // Bike->start();
+            qDebug() << QStringLiteral("request to start");
+        } else if (request.opcode == FTMS_STOP_PAUSE) {
+            // Bike->stop();
+            qDebug() << QStringLiteral("request to stop");
+        } else if (request.opcode == FTMS_SET_INDOOR_BIKE_SIMULATION_PARAMS) // simulation parameter
+        {
+            qDebug() << QStringLiteral("indoor bike simulation parameters");
+            changeSlope(request.rawValue(1), request.rawValue(2), request.rawValue(3));
         }
-        return CP_OK;
-    } else
-        return CP_INVALID;
+        reply.append((quint8)FTMS_RESPONSE_CODE);
+        reply.append((quint8)request.opcode);
+        reply.append((quint8)FTMS_SUCCESS);
+    }
+    if (notifier) {
+        notifier->answer = reply;
+    }
+    return CP_OK;
 }
@@ -297,7 +297,7 @@ void activiotreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
         settings.value(QZSettings::heart_rate_belt_name, QZSettings::default_heart_rate_belt_name).toString();
     Q_UNUSED(characteristic);
     QByteArray value = newValue;
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
 
     emit debug(QStringLiteral(" << ") + QString::number(value.length()) + QStringLiteral(" ") + value.toHex(' '));
     emit packetReceived();
@@ -339,12 +339,11 @@ void activiotreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                     1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastTimeCharacteristicChanged.msecsTo(
-                                now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(now - lastTimeCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                  // body weight in kg * 3.5) / 200 ) / 60
 
         Distance += ((speed / (double)3600.0) /
-                     ((double)1000.0 / (double)(lastTimeCharacteristicChanged.msecsTo(now))));
+                     ((double)1000.0 / (double)(now - lastTimeCharacteristicChanged)));
         lastTimeCharacteristicChanged = now;
     }
 
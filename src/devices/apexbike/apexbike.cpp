@@ -129,7 +129,7 @@ void apexbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void apexbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -160,18 +160,17 @@ void apexbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
     } else {
         Speed = metric::calculateSpeedFromPower(
             watts(), Inclination.value(), Speed.value(),
-            fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+            Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
     }
     if (watts())
         KCal +=
             ((((0.048 * ((double)watts()) + 1.19) *
                settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
               200.0) /
-             (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                            now)))); //(( (0.048* Output in watts +1.19) * body weight in kg
-                                                              //* 3.5) / 200 ) / 60
+             (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) * body
+                                                              // weight in kg * 3.5) / 200 ) / 60
     Distance += ((Speed.value() / 3600000.0) *
-                 ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                 ((double)(now - lastRefreshCharacteristicChanged)));
 
     if (Cadence.value() > 0) {
         CrankRevs++;
@@ -142,7 +142,7 @@ void bhfitnesselliptical::characteristicChanged(const QLowEnergyCharacteristic &
         settings.value(QZSettings::heart_ignore_builtin, QZSettings::default_heart_ignore_builtin).toBool();
 
     emit debug(QStringLiteral(" << ") + newValue.toHex(' '));
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
 
     if (characteristic.uuid() == QBluetoothUuid::HeartRate && newValue.length() > 1) {
         Heart = (uint8_t)newValue[1];
@@ -192,7 +192,7 @@ void bhfitnesselliptical::characteristicChanged(const QLowEnergyCharacteristic &
         } else {
             Speed = metric::calculateSpeedFromPower(
                 watts(), Inclination.value(), Speed.value(),
-                fabs(now.msecsTo(Speed.lastChanged()) / 1000.0),
+                Speed.msecsSinceLastChanged() / 1000.0,
                 0 /* not useful for elliptical*/);
         }
         index += 2;
@@ -242,7 +242,7 @@ void bhfitnesselliptical::characteristicChanged(const QLowEnergyCharacteristic &
         index += 3;
     } else {
         Distance += ((Speed.value() / 3600000.0) *
-                     ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                     ((double)(now - lastRefreshCharacteristicChanged)));
     }
 
     emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
@@ -288,9 +288,8 @@ void bhfitnesselliptical::characteristicChanged(const QLowEnergyCharacteristic &
                 ((((0.048 * ((double)watts()) + 1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                  // body weight in kg * 3.5) / 200 ) / 60
     }
 
     emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
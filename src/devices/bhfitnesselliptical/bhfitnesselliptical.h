@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "devices/elliptical.h"
+#include "monotonicclock.h"
 
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
@@ -53,7 +54,7 @@ class bhfitnesselliptical : public elliptical {
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
     uint8_t firstStateChanged = 0;
     uint8_t bikeResistanceOffset = 4;
     double bikeResistanceGain = 1.0;
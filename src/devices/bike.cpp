@@ -3,7 +3,25 @@
 #include "qdebugfixup.h"
 #include <QSettings>
 
-bike::bike() { elapsed.setType(metric::METRIC_ELAPSED); }
+bike::bike() {
+    elapsed.setType(metric::METRIC_ELAPSED);
+
+    commands()->setChannel(commandcoalescer::RESISTANCE, [this](double target) {
+        bool merged = requestResistance != -1;
+        requestResistance = target;
+        return merged;
+    });
+    commands()->setChannel(commandcoalescer::POWER, [this](double target) {
+        bool merged = requestPower != -1;
+        requestPower = target;
+        return merged;
+    });
+    commands()->setChannel(commandcoalescer::INCLINATION, [this](double target) {
+        bool merged = requestInclination != -100;
+        requestInclination = target;
+        return merged;
+    });
+}
 
 virtualbike *bike::VirtualBike() { return dynamic_cast<virtualbike*>(this->VirtualDevice()); }
 
@@ -24,8 +42,9 @@ void bike::changeResistance(resistance_t resistance) {
             qDebug() << "zwift_erg_resistance_down filter enabled!";
             v = (resistance_t)zwift_erg_resistance_down;
         }
-        requestResistance = v;
-        emit resistanceChanged(requestResistance);
+        resistance_t r = v;
+        commands()->request(commandcoalescer::RESISTANCE, r);
+        emit resistanceChanged(r);
     }
     RequestedResistance = resistance * m_difficult + gears();
 }
@@ -34,7 +53,7 @@ void bike::changeInclination(double grade, double percentage) {
     qDebug() << QStringLiteral("bike::changeInclination") << autoResistanceEnable << grade << percentage;
     lastRawRequestedInclinationValue = grade;
     if (autoResistanceEnable) {        
-        requestInclination = grade;
+        commands()->request(commandcoalescer::INCLINATION, grade);
     }
     emit inclinationChanged(grade, percentage);
 }
@@ -59,7 +78,7 @@ void bike::changePower(int32_t power) {
         return;
     }
 
-    requestPower = power; // used by some bikes that have ERG mode builtin
+    commands()->request(commandcoalescer::POWER, power); // used by some bikes that have ERG mode builtin
     QSettings settings;
     bool force_resistance =
         settings.value(QZSettings::virtualbike_forceresistance, QZSettings::default_virtualbike_forceresistance)
@@ -94,15 +113,15 @@ void bike::setGears(double gears) {
 
 double bike::currentCrankRevolutions() { return CrankRevs; }
 uint16_t bike::lastCrankEventTime() { return LastCrankEventTime; }
-metric bike::lastRequestedResistance() { return RequestedResistance; }
-metric bike::lastRequestedPelotonResistance() { return RequestedPelotonResistance; }
-metric bike::lastRequestedCadence() { return RequestedCadence; }
-metric bike::lastRequestedPower() { return RequestedPower; }
-metric bike::currentResistance() { return Resistance; }
+const metric &bike::lastRequestedResistance() { return RequestedResistance; }
+const metric &bike::lastRequestedPelotonResistance() { return RequestedPelotonResistance; }
+const metric &bike::lastRequestedCadence() { return RequestedCadence; }
+const metric &bike::lastRequestedPower() { return RequestedPower; }
+const metric &bike::currentResistance() { return Resistance; }
 uint8_t bike::fanSpeed() { return FanSpeed; }
 bool bike::connected() { return false; }
 uint16_t bike::watts() { return 0; }
-metric bike::pelotonResistance() { return m_pelotonResistance; }
+const metric &bike::pelotonResistance() { return m_pelotonResistance; }
 resistance_t bike::pelotonToBikeResistance(int pelotonResistance) { return pelotonResistance; }
 resistance_t bike::resistanceFromPowerRequest(uint16_t power) { return power / 10; } // in order to have something
 void bike::cadenceSensor(uint8_t cadence) { Cadence.setValue(cadence); }
@@ -14,11 +14,11 @@ class bike : public bluetoothdevice {
 
     virtualbike *VirtualBike();
 
-    metric lastRequestedResistance();
-    metric lastRequestedPelotonResistance();
-    metric lastRequestedCadence();
-    metric lastRequestedPower();
-    metric currentResistance() override;
+    const metric &lastRequestedResistance();
+    const metric &lastRequestedPelotonResistance();
+    const metric &lastRequestedCadence();
+    const metric &lastRequestedPower();
+    const metric &currentResistance() override;
     uint8_t fanSpeed() override;
     double currentCrankRevolutions() override;
     uint16_t lastCrankEventTime() override;
@@ -29,7 +29,7 @@ class bike : public bluetoothdevice {
     virtual uint16_t powerFromResistanceRequest(resistance_t requestResistance);
     virtual bool ergManagedBySS2K() { return false; }
     bluetoothdevice::BLUETOOTH_TYPE deviceType() override;
-    metric pelotonResistance();
+    const metric &pelotonResistance();
     void clearStats() override;
     void setLap() override;
     void setPaused(bool p) override;
@@ -44,7 +44,7 @@ class bike : public bluetoothdevice {
      * for the Elite Sterzo or emulating device. Expected range -45 to +45 degrees.
      * @return A metric object.
      */
-    metric currentSteeringAngle() { return m_steeringAngle; }
+    const metric &currentSteeringAngle() { return m_steeringAngle; }
     virtual bool inclinationAvailableByHardware();
     bool ergModeSupportedAvailableByHardware() { return ergModeSupported; }
 
@@ -192,7 +192,7 @@ void bkoolbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void bkoolbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -255,7 +255,7 @@ void bkoolbike::characteristicChanged(const QLowEnergyCharacteristic &characteri
                 Cadence = cadence;
             }
             lastGoodCadence = now;
-        } else if (lastGoodCadence.msecsTo(now) > 2000) {
+        } else if ((now - lastGoodCadence) > 2000) {
             Cadence = 0;
         }
 
@@ -267,7 +267,7 @@ void bkoolbike::characteristicChanged(const QLowEnergyCharacteristic &characteri
                     .toDouble();
 
         Distance += ((Speed.value() / 3600000.0) *
-                     ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                     ((double)(now - lastRefreshCharacteristicChanged)));
 
         // Resistance = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
         // (uint16_t)((uint8_t)newValue.at(index)))); debug("Current Resistance: " +
@@ -301,9 +301,8 @@ void bkoolbike::characteristicChanged(const QLowEnergyCharacteristic &characteri
                 ((((0.048 * ((double)watts()) + 1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                  // body weight in kg * 3.5) / 200 ) / 60
         lastRefreshCharacteristicChanged = now;
 
         emit debug(QStringLiteral("Current CrankRevsRead: ") + QString::number(CrankRevsRead));
@@ -386,7 +385,7 @@ void bkoolbike::characteristicChanged(const QLowEnergyCharacteristic &characteri
                         Cadence = cadence;
                     }
                     lastGoodCadence = now;
-                } else if (lastGoodCadence.msecsTo(now) > 2000) {
+                } else if ((now - lastGoodCadence) > 2000) {
                     Cadence = 0;
                 }
             }
@@ -404,12 +403,12 @@ void bkoolbike::characteristicChanged(const QLowEnergyCharacteristic &characteri
             } else {
                 Speed = metric::calculateSpeedFromPower(
                     watts(), Inclination.value(), Speed.value(),
-                    fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                    Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
             }
             emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
 
             Distance += ((Speed.value() / 3600000.0) *
-                         ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                         ((double)(now - lastRefreshCharacteristicChanged)));
             emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
             // if we change this, also change the wattsFromResistance function. We can create a standard function in
@@ -456,9 +455,8 @@ void bkoolbike::characteristicChanged(const QLowEnergyCharacteristic &characteri
                     ((((0.048 * ((double)watts()) + 1.19) *
                        settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                       200.0) /
-                     (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                    now)))); //(( (0.048* Output in watts +1.19) * body weight
-                                                                      // in kg * 3.5) / 200 ) / 60
+                     (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts
+                                                                      // +1.19) * body weight in kg * 3.5) / 200 ) / 60
             emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
         }
     }
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "devices/bike.h"
+#include "monotonicclock.h"
 
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
@@ -61,8 +62,8 @@ class bkoolbike : public bike {
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
-    QDateTime lastGoodCadence = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
+    qint64 lastGoodCadence = monotonicclock::msecs();
     uint8_t firstStateChanged = 0;
 
     bool initDone = false;
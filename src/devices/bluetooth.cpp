@@ -1,5 +1,6 @@
 #include "bluetooth.h"
 #include "homeform.h"
+#include "monotonicclock.h"
 #include <QBluetoothLocalDevice>
 #include <QDateTime>
 #include <QFile>
@@ -89,7 +90,22 @@ bluetooth::bluetooth(bool logs, const QString &deviceName, bool noWriteResistanc
 #ifndef Q_OS_WIN
         discoveryAgent->setLowEnergyDiscoveryTimeout(10000);
 #endif
+
+        startupTimer.start();
+        fastReconnectTimeout.setSingleShot(true);
+        connect(&fastReconnectTimeout, &QTimer::timeout, this, &bluetooth::fastReconnectFailed);
+        firstMetricTimer.setInterval(100);
+        connect(&firstMetricTimer, &QTimer::timeout, this, &bluetooth::checkFirstMetric);
+        // every driver is announced with the device info it was resolved from
+        connect(this, &bluetooth::deviceConnected, this, [this](const QBluetoothDeviceInfo &b) {
+            if (!connectedDeviceInfo.isValid() && reconnectcache::cacheable(b)) {
+                connectedDeviceInfo = b;
+            }
+        });
+
         this->startDiscovery();
+        // the driver created by the cached device stops the scan
+        fastReconnect();
     }
 }
 
@@ -342,6 +358,108 @@ bool bluetooth::heartRateBeltAvaiable() {
     return false;
 }
 
+void bluetooth::fastReconnect() {
+    QSettings settings;
+    // without reconnection restart() quits, there would be no scan to fall back to
+    if (!settings.value(QZSettings::bluetooth_fast_reconnect, QZSettings::default_bluetooth_fast_reconnect).toBool() ||
+        settings.value(QZSettings::bluetooth_no_reconnection, QZSettings::default_bluetooth_no_reconnection).toBool()) {
+        return;
+    }
+
+    reconnectcache::entry cached = reconnectcache::load(settings);
+    if (!cached.isValid()) {
+        qDebug() << QStringLiteral("fast reconnect: no device cached, scanning");
+        return;
+    }
+    if (!filterDevice.isEmpty() && !filterDevice.startsWith(QStringLiteral("Disabled")) &&
+        cached.name.compare(filterDevice, Qt::CaseInsensitive) != 0) {
+        qDebug() << QStringLiteral("fast reconnect: the cached device") << cached.name
+                 << QStringLiteral("isn't the filtered one, scanning");
+        return;
+    }
+
+    qDebug() << QStringLiteral("fast reconnect: connecting to") << cached.name << cached.address
+             << QStringLiteral("as") << cached.driver << QStringLiteral("the last session connected in")
+             << cached.timeToConnectedMs << QStringLiteral("ms, first metric in") << cached.timeToFirstMetricMs
+             << QStringLiteral("ms");
+    fastReconnectDriver = cached.driver;
+    fastReconnectAddress = cached.address;
+    fastReconnectTimeout.start(15000);
+    deviceDiscovered(reconnectcache::deviceInfo(cached));
+}
+
+void bluetooth::fastReconnectFailed() {
+    QString driver = fastReconnectDriver;
+    QString address = fastReconnectAddress;
+    fastReconnectDriver.clear();
+    fastReconnectAddress.clear();
+    if (!device()) {
+        // not resolved yet: the homeform isn't loaded or the accessories are still searched, the scan goes on
+        qDebug() << QStringLiteral("fast reconnect: no driver created yet, waiting for the scan");
+        return;
+    }
+    // the scan can resolve another device first: that one is still connecting and isn't restarted
+    if (!connectedDeviceInfo.isValid() || reconnectcache::fromDevice(connectedDeviceInfo, driver).address != address) {
+        qDebug() << QStringLiteral("fast reconnect: the device connecting isn't the cached one, waiting for it");
+        return;
+    }
+
+    qDebug() << QStringLiteral("fast reconnect:") << driver << QStringLiteral("didn't connect, scanning");
+    QSettings settings;
+    reconnectcache::invalidate(settings);
+    restart();
+}
+
+void bluetooth::saveReconnectCache() {
+    if (reconnectCacheSaved || !device() || !reconnectcache::cacheable(connectedDeviceInfo)) {
+        return;
+    }
+    reconnectCacheSaved = true;
+    fastReconnectTimeout.stop();
+
+    QString driver = QString::fromLatin1(device()->metaObject()->className());
+    if (!fastReconnectDriver.isEmpty() && fastReconnectDriver != driver) {
+        qDebug() << QStringLiteral("fast reconnect: the device was resolved as") << driver
+                 << QStringLiteral("instead of") << fastReconnectDriver;
+    }
+    fastReconnectDriver.clear();
+    fastReconnectAddress.clear();
+
+    timeToConnectedMs = startupTimer.isValid() ? startupTimer.elapsed() : -1;
+    connectedAtMs = monotonicclock::msecs();
+    reconnectcache::entry e = reconnectcache::fromDevice(connectedDeviceInfo, driver);
+    e.timeToConnectedMs = timeToConnectedMs;
+    QSettings settings;
+    reconnectcache::save(settings, e);
+    qDebug() << QStringLiteral("reconnect cache: saved") << e.name << e.address << e.driver
+             << QStringLiteral("connected in") << timeToConnectedMs << QStringLiteral("ms");
+    firstMetricTimer.start();
+}
+
+void bluetooth::checkFirstMetric() {
+    bluetoothdevice *d = device();
+    qint64 sinceConnected = monotonicclock::msecs() - connectedAtMs;
+    if (!d || sinceConnected > 60000) {
+        firstMetricTimer.stop();
+        return;
+    }
+
+    // the first value the driver stored after the connection
+    const metric *metrics[] = {&d->currentSpeed(), &d->wattsMetric(), &d->currentCadence(), &d->currentHeart()};
+    for (const metric *m : metrics) {
+        qint64 since = m->msecsSinceLastChanged();
+        if (since < sinceConnected) {
+            firstMetricTimer.stop();
+            qint64 timeToFirstMetricMs = startupTimer.elapsed() - since;
+            qDebug() << QStringLiteral("time to first metric") << timeToFirstMetricMs
+                     << QStringLiteral("ms, connected in") << timeToConnectedMs << QStringLiteral("ms");
+            QSettings settings;
+            reconnectcache::saveTimings(settings, timeToConnectedMs, timeToFirstMetricMs);
+            return;
+        }
+    }
+}
+
 void bluetooth::setLastBluetoothDevice(const QBluetoothDeviceInfo &b) {
     QSettings settings;
     settings.setValue(QZSettings::bluetooth_lastdevice_name, b.name());
@@ -595,6 +713,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
     if (searchDevices) {
         for (const QBluetoothDeviceInfo &b : qAsConst(devices)) {
 
+            // the chain below checks the name against hundreds of prefixes: upper-case it once
+            const QString upperName = b.name().toUpper();
+
             bool filter = true;
             if (!filterDevice.isEmpty() && !filterDevice.startsWith(QStringLiteral("Disabled"))) {
 
@@ -775,7 +896,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 }
                 this->signalBluetoothDeviceConnected(nordictrackifitadbBike);
             } else if (((csc_as_bike && b.name().startsWith(cscName)) ||
-                        b.name().toUpper().startsWith(QStringLiteral("JOROTO-BK-"))) &&
+                        upperName.startsWith(QStringLiteral("JOROTO-BK-"))) &&
                        !cscBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -805,9 +926,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 }
                 this->signalBluetoothDeviceConnected(powerBike);
             } else if ((((power_as_treadmill && b.name().startsWith(powerSensorName))) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("TREADMILL")) && (deviceHasService(b, QBluetoothUuid((quint16)0x1814)))) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("S10")) && deviceHasService(b, QBluetoothUuid((quint16)0x1814))) ||
-                        b.name().toUpper().startsWith(QStringLiteral("ZWIFT RUNPOD"))) &&
+                        (upperName.startsWith(QStringLiteral("TREADMILL")) && (deviceHasService(b, QBluetoothUuid((quint16)0x1814)))) ||
+                        (upperName.startsWith(QStringLiteral("S10")) && deviceHasService(b, QBluetoothUuid((quint16)0x1814))) ||
+                        upperName.startsWith(QStringLiteral("ZWIFT RUNPOD"))) &&
                        !powerTreadmill && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -823,7 +944,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                     emit searchingStop();
                 }
                 this->signalBluetoothDeviceConnected(powerTreadmill);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("DOMYOS-ROW")) &&
+            } else if (upperName.startsWith(QStringLiteral("DOMYOS-ROW")) &&
                        !b.name().startsWith(QStringLiteral("DomyosBridge")) && !domyosRower && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -856,8 +977,8 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                     emit searchingStop();
                 }
                 this->signalBluetoothDeviceConnected(domyosBike);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("FAL-SPORTS")) ||
-                       (b.name().toUpper().startsWith(QStringLiteral("I-CONSOLE+")) && iconsole_elliptical)) &&
+            } else if ((upperName.startsWith(QStringLiteral("FAL-SPORTS")) ||
+                       (upperName.startsWith(QStringLiteral("I-CONSOLE+")) && iconsole_elliptical)) &&
                        !trxappgateusbElliptical && ftms_bike.contains(QZSettings::default_ftms_bike) && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -891,9 +1012,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                     emit searchingStop();
                 }
                 this->signalBluetoothDeviceConnected(domyosElliptical);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("YPOO-U3-")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("SCH_590E")) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("E35")) && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
+            } else if ((upperName.startsWith(QStringLiteral("YPOO-U3-")) ||
+                        upperName.startsWith(QStringLiteral("SCH_590E")) ||
+                        (upperName.startsWith(QStringLiteral("E35")) && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
                         (b.name().startsWith(QStringLiteral("FS-")) && iconsole_elliptical)) && !ypooElliptical && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -910,8 +1031,8 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                     emit searchingStop();
                 }
                 this->signalBluetoothDeviceConnected(ypooElliptical);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("NAUTILUS E")) || 
-                        b.name().toUpper().startsWith(QStringLiteral("NAUTILUS M"))) &&
+            } else if ((upperName.startsWith(QStringLiteral("NAUTILUS E")) || 
+                        upperName.startsWith(QStringLiteral("NAUTILUS M"))) &&
                        !nautilusElliptical && // NAUTILUS E616
                        filter) {
                 this->setLastBluetoothDevice(b);
@@ -928,7 +1049,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 if (this->discoveryAgent && !this->discoveryAgent->isActive())
                     emit searchingStop();
                 this->signalBluetoothDeviceConnected(nautilusElliptical);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("NAUTILUS B"))) && !nautilusBike &&
+            } else if ((upperName.startsWith(QStringLiteral("NAUTILUS B"))) && !nautilusBike &&
                        filter) { // NAUTILUS B628
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -944,7 +1065,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 if (this->discoveryAgent && !this->discoveryAgent->isActive())
                     emit searchingStop();
                 this->signalBluetoothDeviceConnected(nautilusBike);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("I_FS"))) && !proformElliptical && filter) {
+            } else if ((upperName.startsWith(QStringLiteral("I_FS"))) && !proformElliptical && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 proformElliptical = new proformelliptical(noWriteResistance, noHeartService);
@@ -958,7 +1079,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 if (this->discoveryAgent && !this->discoveryAgent->isActive())
                     emit searchingStop();
                 this->signalBluetoothDeviceConnected(proformElliptical);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("I_EL"))) && !nordictrackElliptical && filter) {
+            } else if ((upperName.startsWith(QStringLiteral("I_EL"))) && !nordictrackElliptical && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 nordictrackElliptical = new nordictrackelliptical(noWriteResistance, noHeartService,
@@ -974,7 +1095,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                     emit searchingStop();
                 this->signalBluetoothDeviceConnected(nordictrackElliptical);
 
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("I_VE"))) && !proformEllipticalTrainer && filter) {
+            } else if ((upperName.startsWith(QStringLiteral("I_VE"))) && !proformEllipticalTrainer && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 proformEllipticalTrainer = new proformellipticaltrainer(noWriteResistance, noHeartService,
@@ -990,7 +1111,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 if (this->discoveryAgent && !this->discoveryAgent->isActive())
                     emit searchingStop();
                 this->signalBluetoothDeviceConnected(proformEllipticalTrainer);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("I_RW"))) && !proformRower && filter) {
+            } else if ((upperName.startsWith(QStringLiteral("I_RW"))) && !proformRower && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 proformRower = new proformrower(noWriteResistance, noHeartService);
@@ -1004,7 +1125,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 if (this->discoveryAgent && !this->discoveryAgent->isActive())
                     emit searchingStop();
                 this->signalBluetoothDeviceConnected(proformRower);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("B01_"))) && !bhFitnessElliptical && filter) {
+            } else if ((upperName.startsWith(QStringLiteral("B01_"))) && !bhFitnessElliptical && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 bhFitnessElliptical = new bhfitnesselliptical(noWriteResistance, noHeartService, bikeResistanceOffset,
@@ -1019,14 +1140,14 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 if (this->discoveryAgent && !this->discoveryAgent->isActive())
                     emit searchingStop();
                 this->signalBluetoothDeviceConnected(bhFitnessElliptical);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("E95S")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("E25")) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("E35")) && !deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
-                        b.name().toUpper().startsWith(QStringLiteral("E55")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("E95")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("E98")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("XG400")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("E98S"))) &&
+            } else if ((upperName.startsWith(QStringLiteral("E95S")) ||
+                        upperName.startsWith(QStringLiteral("E25")) ||
+                        (upperName.startsWith(QStringLiteral("E35")) && !deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
+                        upperName.startsWith(QStringLiteral("E55")) ||
+                        upperName.startsWith(QStringLiteral("E95")) ||
+                        upperName.startsWith(QStringLiteral("E98")) ||
+                        upperName.startsWith(QStringLiteral("XG400")) ||
+                        upperName.startsWith(QStringLiteral("E98S"))) &&
                        !soleElliptical && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1044,7 +1165,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->signalBluetoothDeviceConnected(soleElliptical);
             } else if (b.name().startsWith(QStringLiteral("Domyos")) &&
                        !b.name().startsWith(QStringLiteral("DomyosBr")) &&
-                       !b.name().toUpper().startsWith(QStringLiteral("DOMYOS-BIKING-")) && !domyos && !domyosElliptical && b.name().compare(ftms_treadmill, Qt::CaseInsensitive) &&
+                       !upperName.startsWith(QStringLiteral("DOMYOS-BIKING-")) && !domyos && !domyosElliptical && b.name().compare(ftms_treadmill, Qt::CaseInsensitive) &&
                        !domyosBike && !domyosRower && !ftmsBike && !horizonTreadmill && !deviceHasService(b, QBluetoothUuid((quint16)0x1826)) && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1065,23 +1186,23 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->signalBluetoothDeviceConnected(domyos);
             } else if ((
                            // Xiaomi k12 pro treadmill KS-ST-K12PRO
-                           b.name().toUpper().startsWith(QStringLiteral("KS-ST-K12PRO")) ||
+                           upperName.startsWith(QStringLiteral("KS-ST-K12PRO")) ||
                            // KingSmith Walking Pad R2
-                           b.name().toUpper().startsWith(QStringLiteral("KS-R1AC")) ||
-                           b.name().toUpper().startsWith(QStringLiteral("KS-HC-R1AA")) ||
-                           b.name().toUpper().startsWith(QStringLiteral("KS-HC-R1AC")) ||
+                           upperName.startsWith(QStringLiteral("KS-R1AC")) ||
+                           upperName.startsWith(QStringLiteral("KS-HC-R1AA")) ||
+                           upperName.startsWith(QStringLiteral("KS-HC-R1AC")) ||
                            // KingSmith Walking Pad X21
-                           b.name().toUpper().startsWith(QStringLiteral("KS-X21")) ||
-                           b.name().toUpper().startsWith(QStringLiteral("KS-HDSC-X21C")) ||
-                           b.name().toUpper().startsWith(QStringLiteral("KS-HDSY-X21C")) ||
-                           b.name().toUpper().startsWith(QStringLiteral("KS-NACH-X21C")) ||
-                           b.name().toUpper().startsWith(QStringLiteral("KS-NGCH-X21C")) ||
+                           upperName.startsWith(QStringLiteral("KS-X21")) ||
+                           upperName.startsWith(QStringLiteral("KS-HDSC-X21C")) ||
+                           upperName.startsWith(QStringLiteral("KS-HDSY-X21C")) ||
+                           upperName.startsWith(QStringLiteral("KS-NACH-X21C")) ||
+                           upperName.startsWith(QStringLiteral("KS-NGCH-X21C")) ||
 
                            // X23 King Smith
-                           b.name().toUpper().startsWith(QStringLiteral("KS-NACH-MXG")) ||
+                           upperName.startsWith(QStringLiteral("KS-NACH-MXG")) ||
 
                            // KingSmith Walking Pad G1
-                           b.name().toUpper().startsWith(QStringLiteral("KS-NGCH-G1C"))) &&
+                           upperName.startsWith(QStringLiteral("KS-NGCH-G1C"))) &&
                        !kingsmithR2Treadmill && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1102,17 +1223,17 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 if (this->discoveryAgent && !this->discoveryAgent->isActive())
                     emit searchingStop();
                 this->signalBluetoothDeviceConnected(kingsmithR2Treadmill);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("R1 PRO")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("KINGSMITH")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("DYNAMAX")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("WALKINGPAD")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("KS-ST-A1P")) ||  // KingSmith Walkingpad A1 Pro #2041
+            } else if ((upperName.startsWith(QStringLiteral("R1 PRO")) ||
+                        upperName.startsWith(QStringLiteral("KINGSMITH")) ||
+                        upperName.startsWith(QStringLiteral("DYNAMAX")) ||
+                        upperName.startsWith(QStringLiteral("WALKINGPAD")) ||
+                        upperName.startsWith(QStringLiteral("KS-ST-A1P")) ||  // KingSmith Walkingpad A1 Pro #2041
                         // Poland-distributed WalkingPad R2 TRR2FB
-                        b.name().toUpper().startsWith(QStringLiteral("KS-SC-BLR2C")) ||                        
-                        !b.name().toUpper().compare(QStringLiteral("RE")) || // just "RE"
-                        b.name().toUpper().startsWith(QStringLiteral("KS-H")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("KS-BLC")) || // Walkingpad C2 #1672
-                        b.name().toUpper().startsWith(
+                        upperName.startsWith(QStringLiteral("KS-SC-BLR2C")) ||                        
+                        !upperName.compare(QStringLiteral("RE")) || // just "RE"
+                        upperName.startsWith(QStringLiteral("KS-H")) ||
+                        upperName.startsWith(QStringLiteral("KS-BLC")) || // Walkingpad C2 #1672
+                        upperName.startsWith(
                             QStringLiteral("KS-BLR"))) && // Treadmill KingSmith WalkingPad R2 Pro KS-HCR1AA
                        !kingsmithR1ProTreadmill &&
                        !kingsmithR2Treadmill && filter) {
@@ -1137,7 +1258,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 if (this->discoveryAgent && !this->discoveryAgent->isActive())
                     emit searchingStop();
                 this->signalBluetoothDeviceConnected(kingsmithR1ProTreadmill);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("ZW-"))) && !shuaA5Treadmill && ftms_bike.contains(QZSettings::default_ftms_bike) && filter) {
+            } else if ((upperName.startsWith(QStringLiteral("ZW-"))) && !shuaA5Treadmill && ftms_bike.contains(QZSettings::default_ftms_bike) && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 shuaA5Treadmill = new shuaa5treadmill(noWriteResistance, noHeartService);
@@ -1155,10 +1276,10 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 if (this->discoveryAgent && !this->discoveryAgent->isActive())
                     emit searchingStop();
                 this->signalBluetoothDeviceConnected(shuaA5Treadmill);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("TRUE")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("ASSAULT TREADMILL ")) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("WDWAY")) && b.name().length() == 8) || // WdWay179
-                        (b.name().toUpper().startsWith(QStringLiteral("TREADMILL")) && !gem_module_inclination && !deviceHasService(b, QBluetoothUuid((quint16)0x1814)))) &&
+            } else if ((upperName.startsWith(QStringLiteral("TRUE")) ||
+                        upperName.startsWith(QStringLiteral("ASSAULT TREADMILL ")) ||
+                        (upperName.startsWith(QStringLiteral("WDWAY")) && b.name().length() == 8) || // WdWay179
+                        (upperName.startsWith(QStringLiteral("TREADMILL")) && !gem_module_inclination && !deviceHasService(b, QBluetoothUuid((quint16)0x1814)))) &&
                        !trueTreadmill && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1177,15 +1298,15 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 if (this->discoveryAgent && !this->discoveryAgent->isActive())
                     emit searchingStop();
                 this->signalBluetoothDeviceConnected(trueTreadmill);
-            } else if (((b.name().toUpper().startsWith(QStringLiteral("F80")) && sole_inclination) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("F89")) && sole_inclination) ||
-                        b.name().toUpper().startsWith(QStringLiteral("F65")) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("TT8")) && !deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
-                        b.name().toUpper().startsWith(QStringLiteral("F63")) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("ST90")) && !deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
-                        b.name().toUpper().startsWith(QStringLiteral("TRX7.5")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("S77")) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("F85")) && sole_inclination)) &&
+            } else if (((upperName.startsWith(QStringLiteral("F80")) && sole_inclination) ||
+                        (upperName.startsWith(QStringLiteral("F89")) && sole_inclination) ||
+                        upperName.startsWith(QStringLiteral("F65")) ||
+                        (upperName.startsWith(QStringLiteral("TT8")) && !deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
+                        upperName.startsWith(QStringLiteral("F63")) ||
+                        (upperName.startsWith(QStringLiteral("ST90")) && !deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
+                        upperName.startsWith(QStringLiteral("TRX7.5")) ||
+                        upperName.startsWith(QStringLiteral("S77")) ||
+                        (upperName.startsWith(QStringLiteral("F85")) && sole_inclination)) &&
                        !soleF80 && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1209,7 +1330,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                     emit searchingStop();
                 }
                 this->signalBluetoothDeviceConnected(soleF80);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("LF")) && b.name().length() == 18) &&
+            } else if ((upperName.startsWith(QStringLiteral("LF")) && b.name().length() == 18) &&
                        !lifefitnessTreadmill && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1234,56 +1355,56 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                     emit searchingStop();
                 }
                 this->signalBluetoothDeviceConnected(lifefitnessTreadmill);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("HORIZON")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("AFG SPORT")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("WLT2541")) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("TREADMILL")) && (gem_module_inclination || deviceHasService(b, QBluetoothUuid((quint16)0x1826)))) ||
-                        b.name().toUpper().startsWith(QStringLiteral("T318_")) || // FTMS
-                        (b.name().toUpper().startsWith(QStringLiteral("DK")) && b.name().length() >= 11 &&
+            } else if ((upperName.startsWith(QStringLiteral("HORIZON")) ||
+                        upperName.startsWith(QStringLiteral("AFG SPORT")) ||
+                        upperName.startsWith(QStringLiteral("WLT2541")) ||
+                        (upperName.startsWith(QStringLiteral("TREADMILL")) && (gem_module_inclination || deviceHasService(b, QBluetoothUuid((quint16)0x1826)))) ||
+                        upperName.startsWith(QStringLiteral("T318_")) || // FTMS
+                        (upperName.startsWith(QStringLiteral("DK")) && b.name().length() >= 11 &&
                          !toorx_bike) ||                                            // FTMS
-                        b.name().toUpper().startsWith(QStringLiteral("T218_")) ||   // FTMS
-                        b.name().toUpper().startsWith(QStringLiteral("TRX3500")) || // FTMS
-                        b.name().toUpper().startsWith(QStringLiteral("JFTMPARAGON")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("PARAGON X")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("MX-TM ")) ||     // FTMS
-                        b.name().toUpper().startsWith(QStringLiteral("JFTM")) ||       // FTMS
-                        b.name().toUpper().startsWith(QStringLiteral("CT800")) ||      // FTMS
-                        b.name().toUpper().startsWith(QStringLiteral("TRX4500")) ||    // FTMS
-                        b.name().toUpper().startsWith(QStringLiteral("MATRIXTF50")) || // FTMS
-                        b.name().toUpper().startsWith(QStringLiteral("T01_")) ||       // FTMS
-                        (b.name().toUpper().startsWith(QStringLiteral("TF-")) &&
+                        upperName.startsWith(QStringLiteral("T218_")) ||   // FTMS
+                        upperName.startsWith(QStringLiteral("TRX3500")) || // FTMS
+                        upperName.startsWith(QStringLiteral("JFTMPARAGON")) ||
+                        upperName.startsWith(QStringLiteral("PARAGON X")) ||
+                        upperName.startsWith(QStringLiteral("MX-TM ")) ||     // FTMS
+                        upperName.startsWith(QStringLiteral("JFTM")) ||       // FTMS
+                        upperName.startsWith(QStringLiteral("CT800")) ||      // FTMS
+                        upperName.startsWith(QStringLiteral("TRX4500")) ||    // FTMS
+                        upperName.startsWith(QStringLiteral("MATRIXTF50")) || // FTMS
+                        upperName.startsWith(QStringLiteral("T01_")) ||       // FTMS
+                        (upperName.startsWith(QStringLiteral("TF-")) &&
                          horizon_treadmill_force_ftms) || // FTMS, TF-769DF2
-                        ((b.name().toUpper().startsWith(QStringLiteral("TOORX")) ||
-                          (b.name().toUpper().startsWith(QStringLiteral("I-CONSOLE+")))) &&
+                        ((upperName.startsWith(QStringLiteral("TOORX")) ||
+                          (upperName.startsWith(QStringLiteral("I-CONSOLE+")))) &&
                          !toorx_ftms && toorx_ftms_treadmill) ||
                         !b.name().compare(ftms_treadmill, Qt::CaseInsensitive) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("DOMYOS-TC")) && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
-                        b.name().toUpper().startsWith(QStringLiteral("XT685")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("XT285")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("XTERRA TR")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("T118_")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("EW-EP-")) ||                          // Miweba MC700 ellipital Trainer #2419
-                        b.name().toUpper().startsWith(QStringLiteral("TF04-")) ||                           // Sport Synology Z5 Treadmill #2415
-                        b.name().toUpper().startsWith(QStringLiteral("FIT-")) ||                            // FIT-1596
-                        b.name().toUpper().startsWith(QStringLiteral("WLT-EP-")) ||                             // Flow elliptical
-                        (b.name().toUpper().startsWith("SCHWINN 810")) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("FIT-")) && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) || // sports tech f37s treadmill #2412
-                        (b.name().toUpper().startsWith(QStringLiteral("NOBLEPRO CONNECT")) && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) || // FTMS
-                        (b.name().toUpper().startsWith(QStringLiteral("TT8")) && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("ST90")) && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("XT485"))  && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
-                        b.name().toUpper().startsWith(QStringLiteral("MOBVOI TM")) ||                        // FTMS
-                            b.name().toUpper().startsWith(QStringLiteral("LB600")) ||                        // FTMS
-                        b.name().toUpper().startsWith(QStringLiteral("TUNTURI T60-")) ||                     // FTMS
-                        b.name().toUpper().startsWith(QStringLiteral("KETTLER TREADMILL")) ||                // FTMS
-                        b.name().toUpper().startsWith(QStringLiteral("ASSAULTRUNNER")) ||                    // FTMS
-                        b.name().toUpper().startsWith(QStringLiteral("CITYSPORTS-LINKER")) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("CTM")) && b.name().length() >= 15) || // FTMS
-                        (b.name().toUpper().startsWith(QStringLiteral("F85")) && !sole_inclination) ||       // FMTS
-                        (b.name().toUpper().startsWith(QStringLiteral("F89")) && !sole_inclination) ||       // FMTS
-                        (b.name().toUpper().startsWith(QStringLiteral("F80")) && !sole_inclination) ||       // FMTS
-                        (b.name().toUpper().startsWith(QStringLiteral("ANPLUS-"))) ||                        // FTMS
-                        b.name().toUpper().startsWith(QStringLiteral("ESANGLINKER"))) &&
+                        (upperName.startsWith(QStringLiteral("DOMYOS-TC")) && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
+                        upperName.startsWith(QStringLiteral("XT685")) ||
+                        upperName.startsWith(QStringLiteral("XT285")) ||
+                        upperName.startsWith(QStringLiteral("XTERRA TR")) ||
+                        upperName.startsWith(QStringLiteral("T118_")) ||
+                        upperName.startsWith(QStringLiteral("EW-EP-")) ||                          // Miweba MC700 ellipital Trainer #2419
+                        upperName.startsWith(QStringLiteral("TF04-")) ||                           // Sport Synology Z5 Treadmill #2415
+                        upperName.startsWith(QStringLiteral("FIT-")) ||                            // FIT-1596
+                        upperName.startsWith(QStringLiteral("WLT-EP-")) ||                             // Flow elliptical
+                        (upperName.startsWith("SCHWINN 810")) ||
+                        (upperName.startsWith(QStringLiteral("FIT-")) && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) || // sports tech f37s treadmill #2412
+                        (upperName.startsWith(QStringLiteral("NOBLEPRO CONNECT")) && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) || // FTMS
+                        (upperName.startsWith(QStringLiteral("TT8")) && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
+                        (upperName.startsWith(QStringLiteral("ST90")) && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
+                        (upperName.startsWith(QStringLiteral("XT485"))  && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
+                        upperName.startsWith(QStringLiteral("MOBVOI TM")) ||                        // FTMS
+                            upperName.startsWith(QStringLiteral("LB600")) ||                        // FTMS
+                        upperName.startsWith(QStringLiteral("TUNTURI T60-")) ||                     // FTMS
+                        upperName.startsWith(QStringLiteral("KETTLER TREADMILL")) ||                // FTMS
+                        upperName.startsWith(QStringLiteral("ASSAULTRUNNER")) ||                    // FTMS
+                        upperName.startsWith(QStringLiteral("CITYSPORTS-LINKER")) ||
+                        (upperName.startsWith(QStringLiteral("CTM")) && b.name().length() >= 15) || // FTMS
+                        (upperName.startsWith(QStringLiteral("F85")) && !sole_inclination) ||       // FMTS
+                        (upperName.startsWith(QStringLiteral("F89")) && !sole_inclination) ||       // FMTS
+                        (upperName.startsWith(QStringLiteral("F80")) && !sole_inclination) ||       // FMTS
+                        (upperName.startsWith(QStringLiteral("ANPLUS-"))) ||                        // FTMS
+                        upperName.startsWith(QStringLiteral("ESANGLINKER"))) &&
                        !horizonTreadmill && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1308,8 +1429,8 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                     emit searchingStop();
                 }
                 this->signalBluetoothDeviceConnected(horizonTreadmill);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("MYRUN ")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("MERACH-U3")) // FTMS
+            } else if ((upperName.startsWith(QStringLiteral("MYRUN ")) ||
+                        upperName.startsWith(QStringLiteral("MERACH-U3")) // FTMS
                         ) &&
                        !technogymmyrunTreadmill 
 #ifndef Q_OS_IOS                
@@ -1375,11 +1496,11 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                     this->signalBluetoothDeviceConnected(technogymmyrunrfcommTreadmill);
                 }
 #endif
-            } else if ((b.name().toUpper().startsWith("TACX ") ||
-                        b.name().toUpper().startsWith(QStringLiteral("THINK X")) ||
+            } else if ((upperName.startsWith("TACX ") ||
+                        upperName.startsWith(QStringLiteral("THINK X")) ||
                         b.address() == QBluetoothAddress("C1:14:D9:9C:FB:01") || // specific TACX NEO 2 #1707
-                        (b.name().toUpper().startsWith("TACX SMART BIKE"))) &&
-                        !b.name().toUpper().startsWith("TACX SATORI") &&
+                        (upperName.startsWith("TACX SMART BIKE"))) &&
+                        !upperName.startsWith("TACX SATORI") &&
                        !tacxneo2Bike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1393,10 +1514,10 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // connect(tacxneo2Bike, SIGNAL(inclinationChanged(double)), this, SLOT(inclinationChanged(double)));
                 tacxneo2Bike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(tacxneo2Bike);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral(">CABLE")) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("MD")) && b.name().length() == 7) ||
+            } else if ((upperName.startsWith(QStringLiteral(">CABLE")) ||
+                        (upperName.startsWith(QStringLiteral("MD")) && b.name().length() == 7) ||
                         // BIKE 1, BIKE 2, BIKE 3...
-                        (b.name().toUpper().startsWith(QStringLiteral("BIKE")) && flywheel_life_fitness_ic8 == false &&
+                        (upperName.startsWith(QStringLiteral("BIKE")) && flywheel_life_fitness_ic8 == false &&
                          b.name().length() == 6)) &&
                        !npeCableBike && filter) {
                 this->setLastBluetoothDevice(b);
@@ -1414,56 +1535,56 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 npeCableBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(npeCableBike);
             } else if (((b.name().startsWith("FS-") && hammerRacerS) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("ICONSOLE+")) && toorx_ftms ) ||
-                        (b.name().toUpper().startsWith("DI") && b.name().length() == 2) || // Elite smart trainer #1682
-                        (b.name().toUpper().startsWith("DHZ-")) ||                         // JK fitness 577
-                        (b.name().toUpper().startsWith("MKSM")) ||                         // MKSM3600036
-                        (b.name().toUpper().startsWith("YS_C1_")) ||                       // Yesoul C1H
-                        (b.name().toUpper().startsWith("YS_G1_")) ||                       // Yesoul S3
-                        (b.name().toUpper().startsWith("DS25-")) ||                        // Bodytone DS25
-                        (b.name().toUpper().startsWith("SCHWINN 510T")) ||
-                        (b.name().toUpper().startsWith("3G CARDIO ")) ||
-                        (b.name().toUpper().startsWith("ZWIFT HUB")) || (b.name().toUpper().startsWith("MAGNUS ")) ||
-                        (b.name().toUpper().startsWith("HAMMER ") && !power_as_bike && !saris_trainer) ||      // HAMMER 64123
-                        (b.name().toUpper().startsWith("FLXCY-")) ||                         // Pro FlexBike
-                        (b.name().toUpper().startsWith("QB-WC01")) ||                        // Nexgim QB-C01 smart bike
-                        (b.name().toUpper().startsWith("XBR55")) ||                          // Sprint XBR555
-                        (b.name().toUpper().startsWith("ECHO_BIKE_")) ||                     // Rogue echo bike V3.0
-                        (b.name().toUpper().startsWith("EW-JS-")) ||                         // EW-JS-4990
-                        (b.name().toUpper().startsWith("DT-") && b.name().length() >= 14) || // SOLE SB700
-                        (b.name().toUpper().startsWith("YSV") && b.name().length() == 9) ||  // YSV100783
-                        (b.name().toUpper().startsWith("URSB") && b.name().length() == 7) || // URSB005
-                        (b.name().toUpper().startsWith("DBF") && b.name().length() == 6) ||  // DBF135
-                        (b.name().toUpper().startsWith("KSU") && b.name().length() == 7) ||  // KSU1102
-                        (b.name().toUpper().startsWith(ftmsAccessoryName.toUpper()) &&
+                        (upperName.startsWith(QStringLiteral("ICONSOLE+")) && toorx_ftms ) ||
+                        (upperName.startsWith("DI") && b.name().length() == 2) || // Elite smart trainer #1682
+                        (upperName.startsWith("DHZ-")) ||                         // JK fitness 577
+                        (upperName.startsWith("MKSM")) ||                         // MKSM3600036
+                        (upperName.startsWith("YS_C1_")) ||                       // Yesoul C1H
+                        (upperName.startsWith("YS_G1_")) ||                       // Yesoul S3
+                        (upperName.startsWith("DS25-")) ||                        // Bodytone DS25
+                        (upperName.startsWith("SCHWINN 510T")) ||
+                        (upperName.startsWith("3G CARDIO ")) ||
+                        (upperName.startsWith("ZWIFT HUB")) || (upperName.startsWith("MAGNUS ")) ||
+                        (upperName.startsWith("HAMMER ") && !power_as_bike && !saris_trainer) ||      // HAMMER 64123
+                        (upperName.startsWith("FLXCY-")) ||                         // Pro FlexBike
+                        (upperName.startsWith("QB-WC01")) ||                        // Nexgim QB-C01 smart bike
+                        (upperName.startsWith("XBR55")) ||                          // Sprint XBR555
+                        (upperName.startsWith("ECHO_BIKE_")) ||                     // Rogue echo bike V3.0
+                        (upperName.startsWith("EW-JS-")) ||                         // EW-JS-4990
+                        (upperName.startsWith("DT-") && b.name().length() >= 14) || // SOLE SB700
+                        (upperName.startsWith("YSV") && b.name().length() == 9) ||  // YSV100783
+                        (upperName.startsWith("URSB") && b.name().length() == 7) || // URSB005
+                        (upperName.startsWith("DBF") && b.name().length() == 6) ||  // DBF135
+                        (upperName.startsWith("KSU") && b.name().length() == 7) ||  // KSU1102
+                        (upperName.startsWith(ftmsAccessoryName.toUpper()) &&
                          settings.value(QZSettings::ss2k_peloton, QZSettings::default_ss2k_peloton)
                              .toBool()) || // ss2k on a peloton bike
-                        ((b.name().toUpper().startsWith("KICKR CORE")) && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
-                        (b.name().toUpper().startsWith("MERACH-MR667-")) ||
-                        (b.name().toUpper().startsWith("DS60-")) ||
-                        (b.name().toUpper().startsWith("BIKE-")) ||
-                        (b.name().toUpper().startsWith("SPAX-BK-")) ||
-                        (b.name().toUpper().startsWith("YSV1")) ||
-                        (b.name().toUpper().startsWith("VOLT") && b.name().length() == 4) ||
-                        (b.name().toUpper().startsWith("CECOTEC")) ||       // Cecotec DrumFit Indoor 10000 MagnoMotor Connected #2420
-                        (b.name().toUpper().startsWith("WATTBIKE")) ||
-                        (b.name().toUpper().startsWith("ZYCLEZBIKE")) ||
-                        (b.name().toUpper().startsWith("WAVEFIT-")) ||                        
-                        (b.name().toUpper().startsWith("RAVE WHITE")) ||
-                        (b.name().toUpper().startsWith("DOMYOS-BIKING-")) ||
-                        (b.name().toUpper().startsWith("F") && b.name().toUpper().endsWith("ARROW")) || // FI9110 Arrow, https://www.fitnessdigital.it/bicicletta-smart-bike-ion-fitness-arrow-connect/p/10022863/ IO Fitness Arrow
-                        (b.name().toUpper().startsWith("ICSE") && b.name().length() == 4) ||
-                        (b.name().toUpper().startsWith("FLX") && b.name().length() == 10) ||
-                        (b.name().toUpper().startsWith("CSRB") && b.name().length() == 11) ||
-                        (b.name().toUpper().startsWith("DU30-")) ||                          // BodyTone du30
-                        (b.name().toUpper().startsWith("GLT") && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
-                        (b.name().toUpper().startsWith("SPORT01-") && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) || // Labgrey Magnetic Exercise Bike https://www.amazon.co.uk/dp/B0CXMF1NPY?_encoding=UTF8&psc=1&ref=cm_sw_r_cp_ud_dp_PE420HA7RD7WJBZPN075&ref_=cm_sw_r_cp_ud_dp_PE420HA7RD7WJBZPN075&social_share=cm_sw_r_cp_ud_dp_PE420HA7RD7WJBZPN075&skipTwisterOG=1
-                        (b.name().toUpper().startsWith("ZUMO")) || (b.name().toUpper().startsWith("XS08-")) ||
-                        (b.name().toUpper().startsWith("B94")) || (b.name().toUpper().startsWith("STAGES BIKE")) ||
-                        (b.name().toUpper().startsWith("SUITO")) || (b.name().toUpper().startsWith("D2RIDE")) ||
-                        (b.name().toUpper().startsWith("DIRETO X")) || (b.name().toUpper().startsWith("MERACH-667-")) ||
-                        !b.name().compare(ftms_bike, Qt::CaseInsensitive) || (b.name().toUpper().startsWith("SMB1")) ||
-                        (b.name().toUpper().startsWith("UBIKE FTMS")) || (b.name().toUpper().startsWith("INRIDE"))) &&
+                        ((upperName.startsWith("KICKR CORE")) && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
+                        (upperName.startsWith("MERACH-MR667-")) ||
+                        (upperName.startsWith("DS60-")) ||
+                        (upperName.startsWith("BIKE-")) ||
+                        (upperName.startsWith("SPAX-BK-")) ||
+                        (upperName.startsWith("YSV1")) ||
+                        (upperName.startsWith("VOLT") && b.name().length() == 4) ||
+                        (upperName.startsWith("CECOTEC")) ||       // Cecotec DrumFit Indoor 10000 MagnoMotor Connected #2420
+                        (upperName.startsWith("WATTBIKE")) ||
+                        (upperName.startsWith("ZYCLEZBIKE")) ||
+                        (upperName.startsWith("WAVEFIT-")) ||                        
+                        (upperName.startsWith("RAVE WHITE")) ||
+                        (upperName.startsWith("DOMYOS-BIKING-")) ||
+                        (upperName.startsWith("F") && upperName.endsWith("ARROW")) || // FI9110 Arrow, https://www.fitnessdigital.it/bicicletta-smart-bike-ion-fitness-arrow-connect/p/10022863/ IO Fitness Arrow
+                        (upperName.startsWith("ICSE") && b.name().length() == 4) ||
+                        (upperName.startsWith("FLX") && b.name().length() == 10) ||
+                        (upperName.startsWith("CSRB") && b.name().length() == 11) ||
+                        (upperName.startsWith("DU30-")) ||                          // BodyTone du30
+                        (upperName.startsWith("GLT") && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
+                        (upperName.startsWith("SPORT01-") && deviceHasService(b, QBluetoothUuid((quint16)0x1826))) || // Labgrey Magnetic Exercise Bike https://www.amazon.co.uk/dp/B0CXMF1NPY?_encoding=UTF8&psc=1&ref=cm_sw_r_cp_ud_dp_PE420HA7RD7WJBZPN075&ref_=cm_sw_r_cp_ud_dp_PE420HA7RD7WJBZPN075&social_share=cm_sw_r_cp_ud_dp_PE420HA7RD7WJBZPN075&skipTwisterOG=1
+                        (upperName.startsWith("ZUMO")) || (upperName.startsWith("XS08-")) ||
+                        (upperName.startsWith("B94")) || (upperName.startsWith("STAGES BIKE")) ||
+                        (upperName.startsWith("SUITO")) || (upperName.startsWith("D2RIDE")) ||
+                        (upperName.startsWith("DIRETO X")) || (upperName.startsWith("MERACH-667-")) ||
+                        !b.name().compare(ftms_bike, Qt::CaseInsensitive) || (upperName.startsWith("SMB1")) ||
+                        (upperName.startsWith("UBIKE FTMS")) || (upperName.startsWith("INRIDE"))) &&
                        !ftmsBike && !snodeBike && !fitPlusBike && !stagesBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1474,10 +1595,10 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(ftmsBike, &ftmsbike::debug, this, &bluetooth::debug);
                 ftmsBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(ftmsBike);
-            } else if ((b.name().toUpper().startsWith("KICKR SNAP") || b.name().toUpper().startsWith("KICKR BIKE") ||
-                        b.name().toUpper().startsWith("KICKR ROLLR") ||
-                        (b.name().toUpper().startsWith("HAMMER ") && saris_trainer) ||
-                        (b.name().toUpper().startsWith("WAHOO KICKR"))) &&
+            } else if ((upperName.startsWith("KICKR SNAP") || upperName.startsWith("KICKR BIKE") ||
+                        upperName.startsWith("KICKR ROLLR") ||
+                        (upperName.startsWith("HAMMER ") && saris_trainer) ||
+                        (upperName.startsWith("WAHOO KICKR"))) &&
                        !wahooKickrSnapBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1490,7 +1611,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(wahooKickrSnapBike, &wahookickrsnapbike::debug, this, &bluetooth::debug);
                 wahooKickrSnapBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(wahooKickrSnapBike);
-            } else if (((b.name().toUpper().startsWith("JFIC")) // HORIZON GR7
+            } else if (((upperName.startsWith("JFIC")) // HORIZON GR7
                         ) &&
                        !horizonGr7Bike && filter) {
                 this->setLastBluetoothDevice(b);
@@ -1504,11 +1625,11 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(horizonGr7Bike, &horizongr7bike::debug, this, &bluetooth::debug);
                 horizonGr7Bike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(horizonGr7Bike);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("STAGES ")) ||
-                        (b.name().toUpper().startsWith("TACX SATORI")) ||
-                        ((b.name().toUpper().startsWith("KICKR CORE")) && !deviceHasService(b, QBluetoothUuid((quint16)0x1826)) && deviceHasService(b, QBluetoothUuid((quint16)0x1818))) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("QD")) && b.name().length() == 2) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("ASSIOMA")) &&
+            } else if ((upperName.startsWith(QStringLiteral("STAGES ")) ||
+                        (upperName.startsWith("TACX SATORI")) ||
+                        ((upperName.startsWith("KICKR CORE")) && !deviceHasService(b, QBluetoothUuid((quint16)0x1826)) && deviceHasService(b, QBluetoothUuid((quint16)0x1818))) ||
+                        (upperName.startsWith(QStringLiteral("QD")) && b.name().length() == 2) ||
+                        (upperName.startsWith(QStringLiteral("ASSIOMA")) &&
                          powerSensorName.startsWith(QStringLiteral("Disabled")))) &&
                        !stagesBike && !ftmsBike && filter) {
                 this->setLastBluetoothDevice(b);
@@ -1523,7 +1644,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // connect(stagesBike, SIGNAL(inclinationChanged(double)), this, SLOT(inclinationChanged(double)));
                 stagesBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(stagesBike);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("SMARTROW")) && !smartrowRower && filter) {
+            } else if (upperName.startsWith(QStringLiteral("SMARTROW")) && !smartrowRower && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 smartrowRower =
@@ -1538,8 +1659,8 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // connect(smartrowRower, SIGNAL(inclinationChanged(double)), this, SLOT(inclinationChanged(double)));
                 smartrowRower->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(smartrowRower);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("PM5")) &&
-                        !b.name().toUpper().endsWith(QStringLiteral("ROW"))) &&
+            } else if ((upperName.startsWith(QStringLiteral("PM5")) &&
+                        !upperName.endsWith(QStringLiteral("ROW"))) &&
                        !concept2Skierg && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1554,17 +1675,17 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // connect(concept2Skierg, SIGNAL(inclinationChanged(double)), this, SLOT(inclinationChanged(double)));
                 concept2Skierg->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(concept2Skierg);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("CR 00")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("KAYAKPRO")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("WHIPR")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("S4 COMMS")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("KS-WLT")) || // KS-WLT-W1
-                        b.name().toUpper().startsWith(QStringLiteral("I-ROWER")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("SF-RW")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("DFIT-L-R")) ||
+            } else if ((upperName.startsWith(QStringLiteral("CR 00")) ||
+                        upperName.startsWith(QStringLiteral("KAYAKPRO")) ||
+                        upperName.startsWith(QStringLiteral("WHIPR")) ||
+                        upperName.startsWith(QStringLiteral("S4 COMMS")) ||
+                        upperName.startsWith(QStringLiteral("KS-WLT")) || // KS-WLT-W1
+                        upperName.startsWith(QStringLiteral("I-ROWER")) ||
+                        upperName.startsWith(QStringLiteral("SF-RW")) ||
+                        upperName.startsWith(QStringLiteral("DFIT-L-R")) ||
                         !b.name().compare(ftms_rower, Qt::CaseInsensitive) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("PM5")) &&
-                         b.name().toUpper().endsWith(QStringLiteral("ROW")))) &&
+                        (upperName.startsWith(QStringLiteral("PM5")) &&
+                         upperName.endsWith(QStringLiteral("ROW")))) &&
                        !ftmsRower && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1578,11 +1699,11 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // connect(ftmsRower, SIGNAL(inclinationChanged(double)), this, SLOT(inclinationChanged(double)));
                 ftmsRower->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(ftmsRower);
-            } else if ((b.name().toUpper().startsWith(QLatin1String("ECH-STRIDE")) ||
-                        b.name().toUpper().startsWith(QLatin1String("ECH-UK-")) ||
-                        b.name().toUpper().startsWith(QLatin1String("ECH-FR-")) ||
-                        b.name().toUpper().startsWith(QLatin1String("STRIDE-")) ||
-                        b.name().toUpper().startsWith(QLatin1String("ECH-SD-SPT"))) &&
+            } else if ((upperName.startsWith(QLatin1String("ECH-STRIDE")) ||
+                        upperName.startsWith(QLatin1String("ECH-UK-")) ||
+                        upperName.startsWith(QLatin1String("ECH-FR-")) ||
+                        upperName.startsWith(QLatin1String("STRIDE-")) ||
+                        upperName.startsWith(QLatin1String("ECH-SD-SPT"))) &&
                        !echelonStride && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1597,7 +1718,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(echelonStride, &echelonstride::inclinationChanged, this, &bluetooth::inclinationChanged);
                 echelonStride->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(echelonStride);
-            } else if ((b.name().toUpper().startsWith(QLatin1String("Q37"))) && !octaneElliptical && filter) {
+            } else if ((upperName.startsWith(QLatin1String("Q37"))) && !octaneElliptical && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 octaneElliptical = new octaneelliptical(this->pollDeviceTime, noConsole, noHeartService);
@@ -1611,8 +1732,8 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(octaneElliptical, &octaneelliptical::inclinationChanged, this, &bluetooth::inclinationChanged);
                 octaneElliptical->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(octaneElliptical);
-            } else if ((b.name().toUpper().startsWith(QLatin1String("ZR7")) ||
-                        b.name().toUpper().startsWith(QLatin1String("ZR8"))) &&
+            } else if ((upperName.startsWith(QLatin1String("ZR7")) ||
+                        upperName.startsWith(QLatin1String("ZR8"))) &&
                        !octaneTreadmill && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1627,7 +1748,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(octaneTreadmill, &octanetreadmill::inclinationChanged, this, &bluetooth::inclinationChanged);
                 octaneTreadmill->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(octaneTreadmill);
-            } else if ((b.name().toUpper().startsWith(QLatin1String("RZ_TREADMIL"))) && !ziproTreadmill && filter) {
+            } else if ((upperName.startsWith(QLatin1String("RZ_TREADMIL"))) && !ziproTreadmill && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 ziproTreadmill = new ziprotreadmill(this->pollDeviceTime, noConsole, noHeartService);
@@ -1642,7 +1763,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 ziproTreadmill->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(ziproTreadmill);
             } else if ((b.name().startsWith(QStringLiteral("ECH-ROW")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("ROWSPORT-")) ||
+                        upperName.startsWith(QStringLiteral("ROWSPORT-")) ||
                         b.name().startsWith(QStringLiteral("ROW-S"))) &&
                        !echelonRower && filter) {
                 this->setLastBluetoothDevice(b);
@@ -1676,7 +1797,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // SLOT(inclinationChanged(double)));
                 echelonConnectSport->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(echelonConnectSport);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("WLT8266BM")) && !apexBike && filter) {
+            } else if (upperName.startsWith(QStringLiteral("WLT8266BM")) && !apexBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 apexBike = new apexbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
@@ -1685,7 +1806,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(apexBike, &bluetoothdevice::connectedAndDiscovered, this, &bluetooth::connectedAndDiscovered);
                 apexBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(apexBike);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("BKOOLSMARTPRO")) && !bkoolBike && filter) {
+            } else if (upperName.startsWith(QStringLiteral("BKOOLSMARTPRO")) && !bkoolBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 bkoolBike = new bkoolbike(noWriteResistance, noHeartService);
@@ -1695,7 +1816,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(bkoolBike, &bkoolbike::debug, this, &bluetooth::debug);
                 bkoolBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(bkoolBike);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("MEPANEL")) && !mepanelBike && filter) {
+            } else if (upperName.startsWith(QStringLiteral("MEPANEL")) && !mepanelBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 mepanelBike =
@@ -1706,7 +1827,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                         &bluetooth::connectedAndDiscovered);
                 mepanelBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(mepanelBike);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("SCHWINN 170/270"))) && !schwinn170Bike &&
+            } else if ((upperName.startsWith(QStringLiteral("SCHWINN 170/270"))) && !schwinn170Bike &&
                        filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1723,9 +1844,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // SLOT(inclinationChanged(double)));
                 schwinn170Bike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(schwinn170Bike);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("IC BIKE")) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("C7-")) && b.name().length() != 17) ||
-                        b.name().toUpper().startsWith(QStringLiteral("C9/C10"))) &&
+            } else if ((upperName.startsWith(QStringLiteral("IC BIKE")) ||
+                        (upperName.startsWith(QStringLiteral("C7-")) && b.name().length() != 17) ||
+                        upperName.startsWith(QStringLiteral("C9/C10"))) &&
                        !schwinnIC4Bike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1741,7 +1862,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // SLOT(inclinationChanged(double)));
                 schwinnIC4Bike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(schwinnIC4Bike);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("EW-BK")) && !sportsTechBike && filter) {
+            } else if (upperName.startsWith(QStringLiteral("EW-BK")) && !sportsTechBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 sportsTechBike = new sportstechbike(noWriteResistance, noHeartService, bikeResistanceOffset,
@@ -1757,8 +1878,8 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // SLOT(inclinationChanged(double)));
                 sportsTechBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(sportsTechBike);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("CARDIOFIT")) ||
-                        (b.name().toUpper().contains(QStringLiteral("CARE")) &&
+            } else if ((upperName.startsWith(QStringLiteral("CARDIOFIT")) ||
+                        (upperName.contains(QStringLiteral("CARE")) &&
                          b.name().length() == 11)) // CARE9040177 - Carefitness CV-351
                        && !sportsPlusBike && filter) {
                 this->setLastBluetoothDevice(b);
@@ -1776,7 +1897,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 sportsPlusBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(sportsPlusBike);
             } else if ((b.name().startsWith(yesoulbike::bluetoothName) || 
-                        b.name().toUpper().startsWith("YS_G1M_")) && !yesoulBike && filter) {
+                        upperName.startsWith("YS_G1M_")) && !yesoulBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 yesoulBike =
@@ -1792,7 +1913,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 yesoulBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(yesoulBike);
             } else if ((b.name().startsWith(QStringLiteral("I_EB")) || b.name().startsWith(QStringLiteral("I_SB")) ||
-                        b.name().toUpper().contains(QStringLiteral("_IFIT_BIKE"))) &&
+                        upperName.contains(QStringLiteral("_IFIT_BIKE"))) &&
                        !proformBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1824,7 +1945,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // SLOT(inclinationChanged(double)));
                 proformTreadmill->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(proformTreadmill);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("ESLINKER")) && !eslinkerTreadmill && filter) {
+            } else if (upperName.startsWith(QStringLiteral("ESLINKER")) && !eslinkerTreadmill && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 eslinkerTreadmill = new eslinkertreadmill(this->pollDeviceTime, noConsole, noHeartService);
@@ -1839,7 +1960,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // SLOT(inclinationChanged(double)));
                 eslinkerTreadmill->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(eslinkerTreadmill);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("PAFERS_")) && !pafersTreadmill &&
+            } else if (upperName.startsWith(QStringLiteral("PAFERS_")) && !pafersTreadmill &&
                        (pafers_treadmill || pafers_treadmill_bh_iboxster_plus) && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1855,7 +1976,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // SLOT(inclinationChanged(double)));
                 pafersTreadmill->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(pafersTreadmill);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("BOWFLEX T")) && !bowflexT216Treadmill && filter) {
+            } else if (upperName.startsWith(QStringLiteral("BOWFLEX T")) && !bowflexT216Treadmill && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 bowflexT216Treadmill = new bowflext216treadmill(this->pollDeviceTime, noConsole, noHeartService);
@@ -1870,7 +1991,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // SLOT(inclinationChanged(double)));
                 bowflexT216Treadmill->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(bowflexT216Treadmill);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("CROSSROPE")) && !crossRope && filter) {
+            } else if (upperName.startsWith(QStringLiteral("CROSSROPE")) && !crossRope && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 crossRope = new crossrope(this->pollDeviceTime, noConsole, noHeartService);
@@ -1885,7 +2006,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // SLOT(inclinationChanged(double)));
                 crossRope->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(crossRope);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("NAUTILUS T")) && !nautilusTreadmill && filter) {
+            } else if (upperName.startsWith(QStringLiteral("NAUTILUS T")) && !nautilusTreadmill && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 nautilusTreadmill = new nautilustreadmill(this->pollDeviceTime, noConsole, noHeartService);
@@ -1902,7 +2023,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->signalBluetoothDeviceConnected(nautilusTreadmill);
             } else if ((b.name().startsWith(QStringLiteral("Flywheel")) ||
                         // BIKE 1, BIKE 2, BIKE 3...
-                        (b.name().toUpper().startsWith(QStringLiteral("BIKE")) && flywheel_life_fitness_ic8 == true &&
+                        (upperName.startsWith(QStringLiteral("BIKE")) && flywheel_life_fitness_ic8 == true &&
                          b.name().length() == 6)) &&
                        !flywheelBike && filter) {
                 this->setLastBluetoothDevice(b);
@@ -1919,7 +2040,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // SLOT(inclinationChanged(double)));
                 flywheelBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(flywheelBike);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("MCF-"))) && !mcfBike && filter) {
+            } else if ((upperName.startsWith(QStringLiteral("MCF-"))) && !mcfBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 mcfBike = new mcfbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
@@ -1934,8 +2055,8 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 mcfBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(mcfBike);
             } else if ((b.name().startsWith(QStringLiteral("TRX ROUTE KEY")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("BH DUALKIT TREAD")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("BH-TR-"))) && !toorx && filter) {
+                        upperName.startsWith(QStringLiteral("BH DUALKIT TREAD")) ||
+                        upperName.startsWith(QStringLiteral("BH-TR-"))) && !toorx && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 toorx = new toorxtreadmill();
@@ -1945,8 +2066,8 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(toorx, &toorxtreadmill::debug, this, &bluetooth::debug);
                 toorx->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(toorx);
-            } else if (((b.name().toUpper().startsWith(QStringLiteral("BH DUALKIT")) && !b.name().toUpper().startsWith(QStringLiteral("BH DUALKIT TREAD"))) ||
-                        b.name().toUpper().startsWith(QStringLiteral("BH-"))) && !iConceptBike &&
+            } else if (((upperName.startsWith(QStringLiteral("BH DUALKIT")) && !upperName.startsWith(QStringLiteral("BH DUALKIT TREAD"))) ||
+                        upperName.startsWith(QStringLiteral("BH-"))) && !iConceptBike &&
                        !iconcept_elliptical && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1958,7 +2079,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(iConceptBike, &iconceptbike::debug, this, &bluetooth::debug);
                 iConceptBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(iConceptBike);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("BH DUALKIT"))) && !iConceptElliptical &&
+            } else if ((upperName.startsWith(QStringLiteral("BH DUALKIT"))) && !iConceptElliptical &&
                        iconcept_elliptical && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1971,10 +2092,10 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(iConceptElliptical, &iconceptelliptical::debug, this, &bluetooth::debug);
                 iConceptElliptical->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(iConceptElliptical);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("XT385")) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("XT485"))  && !deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
-                        b.name().toUpper().startsWith(QStringLiteral("XT800")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("XT900"))) &&
+            } else if ((upperName.startsWith(QStringLiteral("XT385")) ||
+                        (upperName.startsWith(QStringLiteral("XT485"))  && !deviceHasService(b, QBluetoothUuid((quint16)0x1826))) ||
+                        upperName.startsWith(QStringLiteral("XT800")) ||
+                        upperName.startsWith(QStringLiteral("XT900"))) &&
                        !spiritTreadmill && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -1987,7 +2108,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(spiritTreadmill, &spirittreadmill::inclinationChanged, this, &bluetooth::inclinationChanged);
                 spiritTreadmill->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(spiritTreadmill);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("RUNNERT")) && !activioTreadmill && filter) {
+            } else if (upperName.startsWith(QStringLiteral("RUNNERT")) && !activioTreadmill && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 activioTreadmill = new activiotreadmill();
@@ -2000,13 +2121,13 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 this->signalBluetoothDeviceConnected(activioTreadmill);
             } else if (((b.name().startsWith(QStringLiteral("TOORX"))) ||
                         (b.name().startsWith(QStringLiteral("V-RUN"))) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("K80_"))) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("I-CONSOLE+"))) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("ICONSOLE+"))) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("I-RUNNING"))) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("DKN RUN"))) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("ADIDAS "))) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("REEBOK")))) &&
+                        (upperName.startsWith(QStringLiteral("K80_"))) ||
+                        (upperName.startsWith(QStringLiteral("I-CONSOLE+"))) ||
+                        (upperName.startsWith(QStringLiteral("ICONSOLE+"))) ||
+                        (upperName.startsWith(QStringLiteral("I-RUNNING"))) ||
+                        (upperName.startsWith(QStringLiteral("DKN RUN"))) ||
+                        (upperName.startsWith(QStringLiteral("ADIDAS "))) ||
+                        (upperName.startsWith(QStringLiteral("REEBOK")))) &&
                        !trxappgateusb && !trxappgateusbBike && !toorx_bike && !toorx_ftms && !toorx_ftms_treadmill && !iconsole_elliptical &&
                        filter) {
                 this->setLastBluetoothDevice(b);
@@ -2019,20 +2140,20 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(trxappgateusb, &trxappgateusbtreadmill::debug, this, &bluetooth::debug);
                 trxappgateusb->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(trxappgateusb);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("TUN ")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("FITHIWAY")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("FIT HI WAY")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("BIKZU_")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("PASYOU-")) ||
+            } else if ((upperName.startsWith(QStringLiteral("TUN ")) ||
+                        upperName.startsWith(QStringLiteral("FITHIWAY")) ||
+                        upperName.startsWith(QStringLiteral("FIT HI WAY")) ||
+                        upperName.startsWith(QStringLiteral("BIKZU_")) ||
+                        upperName.startsWith(QStringLiteral("PASYOU-")) ||
                         ((b.name().startsWith(QStringLiteral("TOORX")) ||
-                          b.name().toUpper().startsWith(QStringLiteral("I-CONSOIE+")) ||
-                          b.name().toUpper().startsWith(QStringLiteral("I-CONSOLE+")) ||
-                          b.name().toUpper().startsWith(QStringLiteral("IBIKING+")) ||
-                          b.name().toUpper().startsWith(QStringLiteral("ICONSOLE+")) ||
-                          b.name().toUpper().startsWith(QStringLiteral("VIFHTR2.1")) ||
-                          (b.name().toUpper().startsWith(QStringLiteral("REEBOK"))) ||
-                          b.name().toUpper().contains(QStringLiteral("CR011R")) ||
-                          b.name().toUpper().startsWith(QStringLiteral("DKN MOTION"))) &&
+                          upperName.startsWith(QStringLiteral("I-CONSOIE+")) ||
+                          upperName.startsWith(QStringLiteral("I-CONSOLE+")) ||
+                          upperName.startsWith(QStringLiteral("IBIKING+")) ||
+                          upperName.startsWith(QStringLiteral("ICONSOLE+")) ||
+                          upperName.startsWith(QStringLiteral("VIFHTR2.1")) ||
+                          (upperName.startsWith(QStringLiteral("REEBOK"))) ||
+                          upperName.contains(QStringLiteral("CR011R")) ||
+                          upperName.startsWith(QStringLiteral("DKN MOTION"))) &&
                          (toorx_bike))) &&
                        !trxappgateusb && !toorx_ftms && !toorx_ftms_treadmill && !trxappgateusbBike && filter && !iconsole_elliptical) {
                 this->setLastBluetoothDevice(b);
@@ -2046,7 +2167,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(trxappgateusbBike, &trxappgateusbbike::debug, this, &bluetooth::debug);
                 trxappgateusbBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(trxappgateusbBike);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("X-BIKE"))) && !ultraSportBike && filter) {
+            } else if ((upperName.startsWith(QStringLiteral("X-BIKE"))) && !ultraSportBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 ultraSportBike =
@@ -2058,7 +2179,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // connect(ultraSportBike, &solebike::debug, this, &bluetooth::debug);
                 ultraSportBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(ultraSportBike);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("KEEP_BIKE_"))) && !keepBike && filter) {
+            } else if ((upperName.startsWith(QStringLiteral("KEEP_BIKE_"))) && !keepBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 keepBike = new keepbike(noWriteResistance, noHeartService, bikeResistanceOffset, bikeResistanceGain);
@@ -2068,8 +2189,8 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // connect(keepBike, &solebike::debug, this, &bluetooth::debug);
                 keepBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(keepBike);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("LCB")) ||
-                        b.name().toUpper().startsWith(QStringLiteral("R92"))) &&
+            } else if ((upperName.startsWith(QStringLiteral("LCB")) ||
+                        upperName.startsWith(QStringLiteral("R92"))) &&
                        !soleBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -2080,8 +2201,8 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // connect(soleBike, &solebike::debug, this, &bluetooth::debug);
                 soleBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(soleBike);
-            } else if ((b.name().toUpper().startsWith(QStringLiteral("BFCP")) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("HT")) && b.name().length() == 11)) &&
+            } else if ((upperName.startsWith(QStringLiteral("BFCP")) ||
+                        (upperName.startsWith(QStringLiteral("HT")) && b.name().length() == 11)) &&
                        !skandikaWiriBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -2094,9 +2215,9 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(skandikaWiriBike, &skandikawiribike::debug, this, &bluetooth::debug);
                 skandikaWiriBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(skandikaWiriBike);
-            } else if (((b.name().toUpper().startsWith("RQ") && b.name().length() == 5) ||
-                        (b.name().toUpper().startsWith("R-Q") && b.name().length() > 6 && !power_as_bike) ||
-                        (b.name().toUpper().startsWith("SCH130")) || // not a renpho bike an FTMS one
+            } else if (((upperName.startsWith("RQ") && b.name().length() == 5) ||
+                        (upperName.startsWith("R-Q") && b.name().length() > 6 && !power_as_bike) ||
+                        (upperName.startsWith("SCH130")) || // not a renpho bike an FTMS one
                         ((b.name().startsWith(QStringLiteral("TOORX"))) && toorx_ftms && !toorx_ftms_treadmill)) &&
                        !renphoBike && !snodeBike && !fitPlusBike && filter) {
                 this->setLastBluetoothDevice(b);
@@ -2108,7 +2229,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 connect(renphoBike, SIGNAL(debug(QString)), this, SLOT(debug(QString)));
                 renphoBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(renphoBike);
-            } else if ((b.name().toUpper().startsWith("PAFERS_")) && !pafersBike && !pafers_treadmill && filter) {
+            } else if ((upperName.startsWith("PAFERS_")) && !pafersBike && !pafers_treadmill && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 pafersBike =
@@ -2120,7 +2241,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 pafersBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(pafersBike);
             } else if (((b.name().startsWith(QStringLiteral("FS-")) && snode_bike) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("TF-")) &&
+                        (upperName.startsWith(QStringLiteral("TF-")) &&
                          !horizon_treadmill_force_ftms)) && // TF-769DF2
                        !snodeBike &&
                        !ftmsBike && !fitPlusBike && filter) {
@@ -2134,7 +2255,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 snodeBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(snodeBike);
             } else if (((b.name().startsWith(QStringLiteral("FS-")) && fitplus_bike) ||
-                        (b.name().toUpper().startsWith("H9110 OSAKA")) ||
+                        (upperName.startsWith("H9110 OSAKA")) ||
                         b.name().startsWith(QStringLiteral("MRK-"))) &&
                        !fitPlusBike && !ftmsBike && !ftmsRower && !snodeBike && filter) {
                 this->setLastBluetoothDevice(b);
@@ -2149,7 +2270,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 // connect(fitPlusBike, SIGNAL(debug(QString)), this, SLOT(debug(QString)));
                 fitPlusBike->deviceDiscovered(b);
                 this->signalBluetoothDeviceConnected(fitPlusBike);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("EW-TM-")) &&
+            } else if (upperName.startsWith(QStringLiteral("EW-TM-")) &&
                        !focusTreadmill && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -2164,10 +2285,10 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                     emit searchingStop();
                 this->signalBluetoothDeviceConnected(focusTreadmill);
             } else if (((b.name().startsWith(QStringLiteral("FS-")) && !horizonTreadmill && !snode_bike && !fitplus_bike && !ftmsBike && !iconsole_elliptical) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("NOBLEPRO CONNECT")) && !deviceHasService(b, QBluetoothUuid((quint16)0x1826))) || // FTMS
+                        (upperName.startsWith(QStringLiteral("NOBLEPRO CONNECT")) && !deviceHasService(b, QBluetoothUuid((quint16)0x1826))) || // FTMS
                         (b.name().startsWith(QStringLiteral("SW")) && b.name().length() == 14 &&
                          !b.name().contains('(') && !b.name().contains(')')) ||
-                        (b.name().toUpper().startsWith(QStringLiteral("WINFITA"))) || //  also FTMS
+                        (upperName.startsWith(QStringLiteral("WINFITA"))) || //  also FTMS
                         (b.name().startsWith(QStringLiteral("BF70")))) &&
                        !fitshowTreadmill && !iconsole_elliptical && filter) {
                 this->setLastBluetoothDevice(b);
@@ -2182,7 +2303,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                 if (this->discoveryAgent && !this->discoveryAgent->isActive())
                     emit searchingStop();
                 this->signalBluetoothDeviceConnected(fitshowTreadmill);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("IC")) && b.name().length() == 8 && !inspireBike &&
+            } else if (upperName.startsWith(QStringLiteral("IC")) && b.name().length() == 8 && !inspireBike &&
                        filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
@@ -2205,7 +2326,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
                     emit searchingStop();
                 }
                 this->signalBluetoothDeviceConnected(inspireBike);
-            } else if (b.name().toUpper().startsWith(QStringLiteral("CHRONO ")) && !chronoBike && filter) {
+            } else if (upperName.startsWith(QStringLiteral("CHRONO ")) && !chronoBike && filter) {
                 this->setLastBluetoothDevice(b);
                 this->stopDiscovery();
                 chronoBike = new chronobike(noWriteResistance, noHeartService);
@@ -2234,6 +2355,7 @@ void bluetooth::deviceDiscovered(const QBluetoothDeviceInfo &device) {
 void bluetooth::connectedAndDiscovered() {
 
     qDebug() << "bluetooth::connectedAndDiscovered()";
+    saveReconnectCache();
 
     static bool firstConnected = true;
     QSettings settings;
@@ -2635,6 +2757,12 @@ void bluetooth::restart() {
         exit(EXIT_SUCCESS);
     }
 
+    fastReconnectTimeout.stop();
+    firstMetricTimer.stop();
+    reconnectCacheSaved = false;
+    connectedDeviceInfo = QBluetoothDeviceInfo();
+    startupTimer.start();
+
     devices.clear();
 
     emit this->bluetoothDeviceDisconnected();
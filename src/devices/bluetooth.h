@@ -2,8 +2,10 @@
 #define BLUETOOTH_H
 
 #include <QBluetoothDeviceDiscoveryAgent>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QObject>
+#include <QTimer>
 #include <QtBluetooth/qlowenergyadvertisingdata.h>
 #include <QtBluetooth/qlowenergyadvertisingparameters.h>
 #include <QtBluetooth/qlowenergycharacteristic.h>
@@ -18,6 +20,7 @@
 #include <QtCore/qloggingcategory.h>
 
 #include "devices/discoveryoptions.h"
+#include "devices/reconnectcache.h"
 #include "qzsettings.h"
 
 #include "devices/activiotreadmill/activiotreadmill.h"
@@ -305,6 +308,24 @@ class bluetooth : public QObject, public SignalHandler {
     QTimer discoveryTimeout;
 #endif
 
+    // the direct connection to the device of the last session, see reconnectcache
+    QElapsedTimer startupTimer;
+    QTimer fastReconnectTimeout;
+    QTimer firstMetricTimer;
+    QString fastReconnectDriver;
+    // the address of the cached device, or its device UUID on iOS
+    QString fastReconnectAddress;
+    QBluetoothDeviceInfo connectedDeviceInfo;
+    bool reconnectCacheSaved = false;
+    qint64 timeToConnectedMs = -1;
+    qint64 connectedAtMs = -1;
+
+    /**
+     * @brief Connects to the device of the last session without waiting for the scan to find it.
+     */
+    void fastReconnect();
+    void saveReconnectCache();
+
 #ifdef Q_OS_IOS
     lockscreen *h = nullptr;
 #endif
@@ -337,6 +358,8 @@ class bluetooth : public QObject, public SignalHandler {
     void speedChanged(double);
     void inclinationChanged(double, double);
     void connectedAndDiscovered();
+    void fastReconnectFailed();
+    void checkFirstMetric();
 
   signals:
 };
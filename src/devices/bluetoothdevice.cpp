@@ -27,9 +27,9 @@ void bluetoothdevice::stop(bool pause) {
     if (pause)
         requestPause = 1;
 }
-metric bluetoothdevice::currentHeart() { return Heart; }
-metric bluetoothdevice::currentSpeed() { return Speed; }
-metric bluetoothdevice::currentInclination() { return Inclination; }
+const metric &bluetoothdevice::currentHeart() { return Heart; }
+const metric &bluetoothdevice::currentSpeed() { return Speed; }
+const metric &bluetoothdevice::currentInclination() { return Inclination; }
 QTime bluetoothdevice::movingTime() {
     int hours = (int)(moving.value() / 3600.0);
     return QTime(hours, (int)(moving.value() - ((double)hours * 3600.0)) / 60.0, ((uint32_t)moving.value()) % 60, 0);
@@ -44,12 +44,26 @@ QTime bluetoothdevice::lapElapsedTime() {
                  ((uint32_t)elapsed.lapValue()) % 60, 0);
 }
 
-metric bluetoothdevice::currentResistance() { return Resistance; }
-metric bluetoothdevice::currentCadence() { return Cadence; }
+const metric &bluetoothdevice::currentResistance() { return Resistance; }
+const metric &bluetoothdevice::currentCadence() { return Cadence; }
 double bluetoothdevice::currentCrankRevolutions() { return 0; }
 uint16_t bluetoothdevice::lastCrankEventTime() { return 0; }
 
 virtualdevice *bluetoothdevice::VirtualDevice() { return this->virtualDevice; }
+
+gattwritequeue *bluetoothdevice::writeQueue() {
+    if (!m_writeQueue) {
+        m_writeQueue = new gattwritequeue(this);
+    }
+    return m_writeQueue;
+}
+
+commandcoalescer *bluetoothdevice::commands() {
+    if (!m_commands) {
+        m_commands = new commandcoalescer(this);
+    }
+    return m_commands;
+}
 void bluetoothdevice::changeResistance(resistance_t resistance) {}
 void bluetoothdevice::changePower(int32_t power) {}
 void bluetoothdevice::changeInclination(double grade, double percentage) {}
@@ -108,8 +122,8 @@ QTime bluetoothdevice::maxPace() {
 
 double bluetoothdevice::odometerFromStartup() { return Distance.valueRaw(); }
 double bluetoothdevice::odometer() { return Distance.value(); }
-metric bluetoothdevice::calories() { return KCal; }
-metric bluetoothdevice::jouls() { return m_jouls; }
+const metric &bluetoothdevice::calories() { return KCal; }
+const metric &bluetoothdevice::jouls() { return m_jouls; }
 uint8_t bluetoothdevice::fanSpeed() { return FanSpeed; };
 bool bluetoothdevice::changeFanSpeed(uint8_t speed) {
     // managing underflow
@@ -130,14 +144,14 @@ bool bluetoothdevice::changeFanSpeed(uint8_t speed) {
     return false;
 }
 bool bluetoothdevice::connected() { return false; }
-metric bluetoothdevice::elevationGain() { return elevationAcc; }
+const metric &bluetoothdevice::elevationGain() { return elevationAcc; }
 void bluetoothdevice::heartRate(uint8_t heart) { Heart.setValue(heart); }
 void bluetoothdevice::disconnectBluetooth() {
     if (m_control) {
         m_control->disconnectFromDevice();
     }
 }
-metric bluetoothdevice::wattsMetric() { return m_watt; }
+const metric &bluetoothdevice::wattsMetric() { return m_watt; }
 void bluetoothdevice::setDifficult(double d) { m_difficult = d; }
 double bluetoothdevice::difficult() { return m_difficult; }
 void bluetoothdevice::setInclinationDifficult(double d) { m_inclination_difficult = d; }
@@ -171,8 +185,8 @@ void bluetoothdevice::setVirtualDevice(virtualdevice *virtualDevice, VIRTUAL_DEV
 // keiser m3i has a separate management of this, so please check it
 void bluetoothdevice::update_metrics(bool watt_calc, const double watts, const bool from_accessory) {
 
-    QDateTime current = QDateTime::currentDateTime();
-    double deltaTime = (((double)_lastTimeUpdate.msecsTo(current)) / ((double)1000.0));
+    const qint64 current = monotonicclock::msecs();
+    double deltaTime = (((double)(current - _lastTimeUpdate)) / ((double)1000.0));
     QSettings settings;
     QString heartRateBeltName =
         settings.value(QZSettings::heart_rate_belt_name, QZSettings::default_heart_rate_belt_name).toString();
@@ -2,7 +2,10 @@
 #define BLUETOOTHDEVICE_H
 
 #include "definitions.h"
+#include "devices/commandcoalescer.h"
+#include "devices/gattwritequeue.h"
 #include "metric.h"
+#include "monotonicclock.h"
 #include "qzsettings.h"
 #include "ergtable.h"
 
@@ -60,12 +63,12 @@ class bluetoothdevice : public QObject {
     /**
      * @brief currentHeart Gets a metric object for getting and setting the current heart rate. Units: beats per minute
      */
-    virtual metric currentHeart();
+    virtual const metric &currentHeart();
 
     /**
      * @brief currentSpeed Gets a metric object for getting and setting the speed. Units: km/h
      */
-    virtual metric currentSpeed();
+    virtual const metric &currentSpeed();
 
     /**
      * @brief currentPace Gets the current pace. Units: time per km
@@ -77,7 +80,7 @@ class bluetoothdevice : public QObject {
      * Units: Percentage vertical to horizontal
      * Expected range: Depends on device.
      */
-    virtual metric currentInclination();
+    virtual const metric &currentInclination();
 
     /**
      * @brief setInclination Set the protected Inclination metric, which could be different from that
@@ -102,8 +105,8 @@ class bluetoothdevice : public QObject {
      */
     virtual double odometer();
     virtual double odometerFromStartup();
-    virtual metric currentDistance() {return Distance;}
-    virtual metric currentDistance1s() {return Distance1s;}
+    virtual const metric &currentDistance() {return Distance;}
+    virtual const metric &currentDistance1s() {return Distance1s;}
     void addCurrentDistance1s(double distance) { Distance1s += distance; }
 
     /**
@@ -112,12 +115,12 @@ class bluetoothdevice : public QObject {
      * Other implementations could have different units.
      * @return
      */
-    virtual metric calories();
+    virtual const metric &calories();
 
     /**
      * @brief jouls Gets a metric object to get and set the number of joules expended. Units: joules
      */
-    metric jouls();
+    const metric &jouls();
 
     /**
      * @brief fanSpeed Gets the current fan speed. Units: depends on device
@@ -155,12 +158,12 @@ class bluetoothdevice : public QObject {
      * @brief currentResistance Gets a metric object to get or set the currently requested resistance.
      * Expected range: 0 to maxResistance()
      */
-    virtual metric currentResistance();
+    virtual const metric &currentResistance();
 
     /**
      * @brief currentCadence Gets a metric object to get and set the current cadence. Units: revolutions per minute
      */
-    virtual metric currentCadence();
+    virtual const metric &currentCadence();
 
     /**
      * @brief currentCrankRevolutions Gets the current total number of crank revolutions.
@@ -214,7 +217,7 @@ class bluetoothdevice : public QObject {
     /**
      * @brief wattsMetric Gets a metric object to get or set the amount of power used.  Units: watts
      */
-    metric wattsMetric();
+    const metric &wattsMetric();
 
     /**
      * @brief changeFanSpeed Tries to change the fan speed.
@@ -225,7 +228,7 @@ class bluetoothdevice : public QObject {
     /**
      * @brief elevationGain Gets a metric object to get and set the elevation gain. Units: ?
      */
-    virtual metric elevationGain();
+    virtual const metric &elevationGain();
 
     /**
      * @brief clearStats Clear the statistics.
@@ -327,19 +330,19 @@ class bluetoothdevice : public QObject {
      * @brief wattKg Gets a metric object to get and set the watt kg of something. Units: watt kg
      * @return
      */
-    metric wattKg() { return WattKg; }
+    const metric &wattKg() { return WattKg; }
 
     /**
      * @brief currentMETS Gets a metric object to get and set the current METS (Metabolic Equivalent of Tasks)
      * Units: METs (1 MET is approximately 3.5mL of Oxygen consumed per kg of body weight per minute)
      */
-    metric currentMETS() { return METS; }
+    const metric &currentMETS() { return METS; }
 
     /**
      * @brief currentHeartZone Gets a metric object to get or set the current heart zone. Units: depends on
      * implementation.
      */
-    metric currentHeartZone() { return HeartZone; }
+    const metric &currentHeartZone() { return HeartZone; }
 
     /*
     * @brief maxHeartZone Gets the maximum number of heart zones.
@@ -358,14 +361,14 @@ class bluetoothdevice : public QObject {
      * implementation.
      * @return
      */
-    metric currentPowerZone() { return PowerZone; }
+    const metric &currentPowerZone() { return PowerZone; }
 
     /**
      * @brief currentPowerZone Gets a metric object to get or set the current power zome. Units: depends on
      * implementation.
      * @return
      */
-    metric targetPowerZone() { return TargetPowerZone; }
+    const metric &targetPowerZone() { return TargetPowerZone; }
 
     /**
      * @brief setGPXFile Sets the file for GPS data exchange.
@@ -426,6 +429,18 @@ class bluetoothdevice : public QObject {
      */
     virtual resistance_t maxResistance();
 
+    /**
+     * @brief writeQueue The asynchronous queue of the GATT writes to the device. It also reports the write-to-ack
+     * latency and the depth of the queue.
+     */
+    gattwritequeue *writeQueue();
+
+    /**
+     * @brief commands The gate between the change requests and the request fields polled by the drivers. It also
+     * reports how many requests were merged or dropped.
+     */
+    commandcoalescer *commands();
+
   public Q_SLOTS:
     virtual void start();
     virtual void stop(bool pause);
@@ -454,6 +469,12 @@ class bluetoothdevice : public QObject {
     void groundContactChanged(double groundContact);
     void verticalOscillationChanged(double verticalOscillation);
 
+    /**
+     * @brief The device has decoded new metrics, emitted by the drivers at the end of a notification. The
+     * event-driven virtual devices notify on it instead of waiting for their timer.
+     */
+    void metricsUpdated();
+
   protected:
     /**
      * @brief Mode of operation for the virtual device with the bluetoothdevice object.
@@ -679,8 +700,9 @@ class bluetoothdevice : public QObject {
 
     /**
      * @brief _lastTimeUpdate The time the (client was last updated / last update was received from the device) ???
+     * A monotonicclock::msecs() timestamp, so the elapsed time and the energy don't follow the wall clock changes.
      */
-    QDateTime _lastTimeUpdate;
+    qint64 _lastTimeUpdate = monotonicclock::msecs();
 
     /**
      * @brief _firstUpdate Indicates if this is the first update.
@@ -726,6 +748,9 @@ class bluetoothdevice : public QObject {
     VIRTUAL_DEVICE_MODE virtualDeviceMode = VIRTUAL_DEVICE_MODE::NONE;
     virtualdevice *virtualDevice = nullptr;
 
+    gattwritequeue *m_writeQueue = nullptr;
+    commandcoalescer *m_commands = nullptr;
+
   protected:
     // useful to understand if a power sensor device for treadmill, it's a real one like the stryd or it's a dumb one like the runpod from Zwift
     bool powerReceivedFromPowerSensor = false;
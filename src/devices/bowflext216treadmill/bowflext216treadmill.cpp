@@ -185,7 +185,7 @@ void bowflext216treadmill::characteristicChanged(const QLowEnergyCharacteristic
     emit packetReceived();
 
     if (characteristic.uuid() != gattNotify3Characteristic.uuid() && !bowflex_btx116 && !bowflex_t8j) {
-        if (lastTimeCharacteristicChanged.msecsTo(QDateTime::currentDateTime()) > 5000) {
+        if ((monotonicclock::msecs() - lastTimeCharacteristicChanged) > 5000) {
             Speed = 0;
             qDebug() << QStringLiteral("resetting speed since i'm not receiving metrics in the last 5 seconds");
             emit debug(QStringLiteral("Current speed: ") + QString::number(Speed.value()));
@@ -246,12 +246,12 @@ void bowflext216treadmill::characteristicChanged(const QLowEnergyCharacteristic
                     1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastTimeCharacteristicChanged.msecsTo(
-                                QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(monotonicclock::msecs() - lastTimeCharacteristicChanged)))); //(( (0.048* Output
+                                                                  // in watts +1.19) * body weight in kg * 3.5) / 200 )
+                                                                  // / 60
 
         Distance += ((Speed.value() / 3600.0) /
-                     (1000.0 / (lastTimeCharacteristicChanged.msecsTo(QDateTime::currentDateTime()))));
+                     (1000.0 / (monotonicclock::msecs() - lastTimeCharacteristicChanged)));
     }
 
     cadenceFromAppleWatch();
@@ -262,7 +262,7 @@ void bowflext216treadmill::characteristicChanged(const QLowEnergyCharacteristic
         qDebug() << QStringLiteral("QLowEnergyController ERROR!!") << m_control->errorString();
     }
 
-    lastTimeCharacteristicChanged = QDateTime::currentDateTime();
+    lastTimeCharacteristicChanged = monotonicclock::msecs();
     firstCharacteristicChanged = false;
 }
 
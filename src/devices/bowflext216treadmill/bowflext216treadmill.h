@@ -26,6 +26,7 @@
 #include <QObject>
 
 #include "treadmill.h"
+#include "monotonicclock.h"
 
 class bowflext216treadmill : public treadmill {
     Q_OBJECT
@@ -56,7 +57,7 @@ class bowflext216treadmill : public treadmill {
     uint8_t sec1Update = 0;
     uint8_t firstInit = 0;
     QByteArray lastPacket;
-    QDateTime lastTimeCharacteristicChanged;
+    qint64 lastTimeCharacteristicChanged = monotonicclock::msecs();
     bool firstCharacteristicChanged = true;
 
     int64_t lastStart = 0;
@@ -27,6 +27,7 @@
 #include <QObject>
 
 #include "treadmill.h"
+#include "monotonicclock.h"
 
 class bowflextreadmill : public treadmill {
     Q_OBJECT
@@ -58,7 +59,7 @@ class bowflextreadmill : public treadmill {
     uint8_t sec1Update = 0;
     uint8_t firstInit = 0;
     QByteArray lastPacket;
-    QDateTime lastTimeCharacteristicChanged;
+    qint64 lastTimeCharacteristicChanged = monotonicclock::msecs();
     bool firstCharacteristicChanged = true;
 
     int64_t lastStart = 0;
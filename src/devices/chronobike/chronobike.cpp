@@ -126,7 +126,7 @@ void chronobike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void chronobike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -154,18 +154,17 @@ void chronobike::characteristicChanged(const QLowEnergyCharacteristic &character
     } else {
         Speed = metric::calculateSpeedFromPower(
             watts(), Inclination.value(), Speed.value(),
-            fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+            Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
     }
     if (watts())
         KCal +=
             ((((0.048 * ((double)watts()) + 1.19) *
                settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
               200.0) /
-             (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                            now)))); //(( (0.048* Output in watts +1.19) * body weight in kg
-                                                              //* 3.5) / 200 ) / 60
+             (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) * body
+                                                              // weight in kg * 3.5) / 200 ) / 60
     Distance += ((Speed.value() / 3600000.0) *
-                 ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                 ((double)(now - lastRefreshCharacteristicChanged)));
 
     double ac = 0.01243107769;
     double bc = 1.145964912;
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "devices/bike.h"
+#include "monotonicclock.h"
 
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
@@ -52,7 +53,7 @@ class chronobike : public bike {
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
     uint8_t firstStateChanged = 0;
 
     bool noWriteResistance = false;
@@ -0,0 +1,77 @@
+#include "devices/commandcoalescer.h"
+#include "qzlog.h"
+
+commandcoalescer::commandcoalescer(QObject *parent) : QObject(parent) {
+    for (int c = 0; c < CHANNELS; c++) {
+        QTimer *timer = new QTimer(this);
+        timer->setSingleShot(true);
+        connect(timer, &QTimer::timeout, this, [this, c]() { applyPending((CHANNEL)c); });
+        m_channels[c].timer = timer;
+    }
+}
+
+void commandcoalescer::setChannel(CHANNEL channel, const applier &apply, int minIntervalMs) {
+    m_channels[channel].apply = apply;
+    m_channels[channel].minIntervalMs = minIntervalMs;
+}
+
+void commandcoalescer::request(CHANNEL channel, double target, double minStep, double current) {
+    channelstate &s = m_channels[channel];
+    if (!s.apply) {
+        return;
+    }
+    s.requested++;
+
+    auto sameStep = [minStep](double a, double b) {
+        return !std::isnan(b) && std::round(a / minStep) == std::round(b / minStep);
+    };
+    if (minStep > 0 && sameStep(target, current) && (std::isnan(s.lastTarget) || sameStep(target, s.lastTarget))) {
+        // the device is already there and isn't going anywhere else: the newest target cancels the pending one too
+        s.dropped++;
+        if (s.pending) {
+            s.merged++;
+            s.pending = false;
+            s.timer->stop();
+        }
+        qCDebug(qzCommands) << QStringLiteral("commandcoalescer: channel") << channel << QStringLiteral("target")
+                            << target << QStringLiteral("dropped, the device is at") << current
+                            << QStringLiteral("dropped") << s.dropped << QStringLiteral("merged") << s.merged;
+        return;
+    }
+
+    if (s.pending) {
+        s.merged++;
+        s.pendingTarget = target;
+        return;
+    }
+
+    qint64 wait = s.lastApplied.isValid() ? s.minIntervalMs - s.lastApplied.elapsed() : 0;
+    if (wait <= 0) {
+        applyTarget(channel, target);
+    } else {
+        s.pending = true;
+        s.pendingTarget = target;
+        s.timer->start(wait);
+    }
+}
+
+void commandcoalescer::applyTarget(CHANNEL channel, double target) {
+    channelstate &s = m_channels[channel];
+    if (s.apply(target)) {
+        s.merged++;
+        qCDebug(qzCommands) << QStringLiteral("commandcoalescer: channel") << channel << QStringLiteral("target")
+                            << target << QStringLiteral("replaced one not sent yet, merged") << s.merged;
+    }
+    s.lastTarget = target;
+    s.applied++;
+    s.lastApplied.start();
+}
+
+void commandcoalescer::applyPending(CHANNEL channel) {
+    channelstate &s = m_channels[channel];
+    if (!s.pending) {
+        return;
+    }
+    s.pending = false;
+    applyTarget(channel, s.pendingTarget);
+}
@@ -0,0 +1,73 @@
+#ifndef COMMANDCOALESCER_H
+#define COMMANDCOALESCER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <cmath>
+#include <functional>
+
+/**
+ * @brief Coalesces the targets requested to a device, one control channel at a time.
+ *
+ * The drivers poll the request fields (requestResistance, requestPower, requestInclination) and write the target
+ * they find, so a target replaced before the driver polled it is never sent. This class is the gate in front of the
+ * fields: a target is applied to its field at most once every minIntervalMs of the channel, and while it waits it is
+ * replaced by the newer ones, so a slow machine always goes to the newest target instead of chasing the old ones.
+ * A target in the same minStep as the current value of the device is dropped, the machine is already there, unless
+ * the last target applied is elsewhere: the driver may not have sent it yet or the machine may still be moving to it,
+ * so the new target is applied to stop it where it is.
+ *
+ * The requested, applied, merged and dropped targets are counted for every channel.
+ */
+class commandcoalescer : public QObject {
+    Q_OBJECT
+
+  public:
+    enum CHANNEL { RESISTANCE = 0, POWER, INCLINATION, CHANNELS };
+
+    /**
+     * @brief Writes a target in the request field the driver polls.
+     * @return true if the field still had a target the driver hadn't read, which is then merged.
+     */
+    typedef std::function<bool(double target)> applier;
+
+    explicit commandcoalescer(QObject *parent = nullptr);
+
+    void setChannel(CHANNEL channel, const applier &apply, int minIntervalMs = 0);
+
+    /**
+     * @brief Requests a target.
+     * @param minStep The smallest change the device can make, 0 if any change is sent.
+     * @param current The current value of the device, NAN if unknown.
+     */
+    void request(CHANNEL channel, double target, double minStep = 0, double current = NAN);
+
+    int requested(CHANNEL channel) const { return m_channels[channel].requested; }
+    int applied(CHANNEL channel) const { return m_channels[channel].applied; }
+    int merged(CHANNEL channel) const { return m_channels[channel].merged; }
+    int dropped(CHANNEL channel) const { return m_channels[channel].dropped; }
+
+  private:
+    struct channelstate {
+        applier apply;
+        int minIntervalMs = 0;
+        QElapsedTimer lastApplied;
+        QTimer *timer = nullptr;
+        bool pending = false;
+        double pendingTarget = 0;
+        // the last target written to the request field, NAN before the first one
+        double lastTarget = NAN;
+        int requested = 0;
+        int applied = 0;
+        int merged = 0;
+        int dropped = 0;
+    };
+
+    void applyTarget(CHANNEL channel, double target);
+    void applyPending(CHANNEL channel);
+
+    channelstate m_channels[CHANNELS];
+};
+
+#endif // COMMANDCOALESCER_H
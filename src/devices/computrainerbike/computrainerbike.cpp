@@ -240,7 +240,7 @@ void computrainerbike::update() {
         Speed = speed;
         emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
         Distance += ((Speed.value() / 3600000.0) *
-                     ((double)lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime())));
+                     ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)));
         emit debug("Current Distance: " + QString::number(Distance.value()));
         Cadence = cadence;
         emit debug(QStringLiteral("Current Cadence: ") + QString::number(Cadence.value()));
@@ -260,9 +260,8 @@ void computrainerbike::update() {
                        settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                       200.0) /
                      (60000.0 /
-                      ((double)lastRefreshCharacteristicChanged.msecsTo(
-                          QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in kg
-                                                            //* 3.5) / 200 ) / 60
+                      ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in
+                                                            // watts +1.19) * body weight in kg * 3.5) / 200 ) / 60
         /*
                                                                   Resistance = resistance;
                                                                   m_pelotonResistance = (100 / 32) * Resistance.value();
@@ -273,7 +272,7 @@ void computrainerbike::update() {
             emit debug(QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
         }
 
-        lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+        lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
 #ifdef Q_OS_ANDROID
         if (settings.value(QZSettings::ant_heart, QZSettings::default_ant_heart).toBool())
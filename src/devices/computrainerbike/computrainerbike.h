@@ -22,6 +22,7 @@
 #include <QString>
 
 #include "Computrainer.h"
+#include "monotonicclock.h"
 #include "devices/bike.h"
 #include "virtualdevices/virtualbike.h"
 
@@ -61,7 +62,7 @@ class computrainerbike : public bike {
 
     uint8_t sec1Update = 0;
     QString lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
     uint8_t firstStateChanged = 0;
     metric target_watts;
 
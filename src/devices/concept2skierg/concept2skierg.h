@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "rower.h"
+#include "monotonicclock.h"
 
 
 #ifdef Q_OS_IOS
@@ -54,7 +55,7 @@ class concept2skierg : public rower {
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
     uint8_t firstStateChanged = 0;
 
     bool initDone = false;
@@ -123,7 +123,7 @@ void crossrope::characteristicChanged(const QLowEnergyCharacteristic &characteri
         settings.value(QZSettings::heart_rate_belt_name, QZSettings::default_heart_rate_belt_name).toString();
     Q_UNUSED(characteristic);
     QByteArray value = newValue;
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     double weight = settings.value(QZSettings::weight, QZSettings::default_weight).toFloat();
 
     emit debug(QStringLiteral(" << ") + QString::number(value.length()) + QStringLiteral(" ") + value.toHex(' '));
@@ -135,14 +135,14 @@ void crossrope::characteristicChanged(const QLowEnergyCharacteristic &characteri
 
     double steps = (double)(uint16_t)((newValue.at(1) << 8) | ((uint8_t)newValue.at(2)));
     if(steps != JumpsCount.value()) {
-        CadenceRaw = (steps - JumpsCount.value()) / fabs(JumpsCount.valueChanged().msecsTo(now)) * 60000.0;
+        CadenceRaw = (steps - JumpsCount.value()) / (double)JumpsCount.msecsSinceValueChanged() * 60000.0;
         JumpsSequence = JumpsSequence.value() + 1;
         Cadence = CadenceRaw.average20s();
         JumpsCount = steps;
         Speed = Cadence.value() * 0.15; // (speed emulated)
         Distance += ((Speed.value() / 3600000.0) *
-                     ((double)lastTimeCharacteristicChanged.msecsTo(now)));
-    } else if(abs(Cadence.lastChanged().secsTo(now)) > 2) {
+                     ((double)(now - lastTimeCharacteristicChanged)));
+    } else if(Cadence.msecsSinceLastChanged() > 2000) {
         CadenceRaw = 0;
         Cadence = 0;
         JumpsSequence = 0;
@@ -154,9 +154,8 @@ void crossrope::characteristicChanged(const QLowEnergyCharacteristic &characteri
             ((((0.048 * ((double)watts(weight)) + 1.19) *
                weight * 3.5) /
               200.0) /
-             (60000.0 / ((double)lastTimeCharacteristicChanged.msecsTo(
-                            now)))); //(( (0.048* Output in watts +1.19) * body weight in kg
-                                     //* 3.5) / 200 ) / 60
+             (60000.0 / ((double)(now - lastTimeCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) * body
+                                     // weight in kg * 3.5) / 200 ) / 60
 
 
 #ifdef Q_OS_ANDROID
@@ -181,7 +180,7 @@ void crossrope::characteristicChanged(const QLowEnergyCharacteristic &characteri
         qDebug() << QStringLiteral("QLowEnergyController ERROR!!") << m_control->errorString();
     }
 
-    lastTimeCharacteristicChanged = QDateTime::currentDateTime();
+    lastTimeCharacteristicChanged = monotonicclock::msecs();
     firstCharacteristicChanged = false;
 }
 
@@ -27,6 +27,7 @@
 #include <QObject>
 
 #include "jumprope.h"
+#include "monotonicclock.h"
 
 class crossrope : public jumprope {
     Q_OBJECT
@@ -48,7 +49,7 @@ class crossrope : public jumprope {
     uint8_t sec1Update = 0;
     uint8_t firstInit = 0;
     QByteArray lastPacket;
-    QDateTime lastTimeCharacteristicChanged;
+    qint64 lastTimeCharacteristicChanged = monotonicclock::msecs();
     bool firstCharacteristicChanged = true;
 
     int64_t lastStart = 0;
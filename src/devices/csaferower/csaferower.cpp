@@ -308,8 +308,8 @@ void csaferower::update() {
     }
 
     Distance += ((Speed.value() / (double)3600.0) /
-                 ((double)1000.0 / (double)(lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime()))));
-    lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+                 ((double)1000.0 / (double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)));
+    lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
     // ******************************************* virtual bike/rower init *************************************
     if (!firstStateChanged && !this->hasVirtualDevice()
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "csafe.h"
+#include "monotonicclock.h"
 #include "devices/rower.h"
 #include "virtualdevices/virtualbike.h"
 #include "virtualdevices/virtualrower.h"
@@ -125,7 +126,7 @@ class csaferower : public rower {
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
     QDateTime lastGoodCadence = QDateTime::currentDateTime();
     uint8_t firstStateChanged = 0;
 
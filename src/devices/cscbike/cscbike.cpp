@@ -91,7 +91,7 @@ void cscbike::update() {
             settings.value(QZSettings::cadence_sensor_as_bike, QZSettings::default_cadence_sensor_as_bike).toBool();
         update_metrics(true, watts(), !cadence_sensor_as_bike);
 
-        if(lastGoodCadence.secsTo(QDateTime::currentDateTime()) > 5 && !charNotified) {
+        if((monotonicclock::msecs() - lastGoodCadence) / 1000 > 5 && !charNotified) {
             readMethod = true;
             qDebug() << "no cadence for 5 secs, switching to reading method";
         }
@@ -140,7 +140,7 @@ void cscbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void cscbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -213,7 +213,7 @@ void cscbike::characteristicChanged(const QLowEnergyCharacteristic &characterist
         if (cadence >= 0 && cadence < 256)
             Cadence = cadence;
         lastGoodCadence = now;
-    } else if (lastGoodCadence.msecsTo(now) > 2000) {
+    } else if ((now - lastGoodCadence) > 2000) {
         Cadence = 0;
     }
     emit cadenceChanged(Cadence.value());
@@ -229,12 +229,12 @@ void cscbike::characteristicChanged(const QLowEnergyCharacteristic &characterist
     } else {
         Speed = metric::calculateSpeedFromPower(
             watts(), Inclination.value(), Speed.value(),
-            fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+            Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
     }
     emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
 
     Distance += ((Speed.value() / 3600000.0) *
-                 ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                 ((double)(now - lastRefreshCharacteristicChanged)));
     emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
     double ac = 0.01243107769;
@@ -266,9 +266,8 @@ void cscbike::characteristicChanged(const QLowEnergyCharacteristic &characterist
             ((((0.048 * ((double)watts()) + 1.19) *
                settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
               200.0) /
-             (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                            now)))); //(( (0.048* Output in watts +1.19) * body weight in kg
-                                                              //* 3.5) / 200 ) / 60
+             (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) * body
+                                                              // weight in kg * 3.5) / 200 ) / 60
     emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
 
     if (Cadence.value() > 0) {
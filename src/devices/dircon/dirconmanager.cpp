@@ -166,22 +166,26 @@ DirconManager::DirconManager(bluetoothdevice *Bike, uint8_t bikeResistanceOffset
     connect(writePE005, SIGNAL(changeInclination(double, double)), this, SIGNAL(changeInclination(double, double)));
     connect(writePE005, SIGNAL(ftmsCharacteristicChanged(QLowEnergyCharacteristic, QByteArray)), this,
             SIGNAL(ftmsCharacteristicChanged(QLowEnergyCharacteristic, QByteArray)));
-    QObject::connect(&bikeTimer, &QTimer::timeout, this, &DirconManager::bikeProvider);
+    QObject::connect(&notifyScheduler, &virtualnotifyscheduler::provide, this, &DirconManager::bikeProvider);
     QString mac = getMacAddress();
     DM_MACHINE_OP(DM_MACHINE_INIT_OP, services, proc_services, type)
     if (settings.value(QZSettings::race_mode, QZSettings::default_race_mode).toBool())
-        bikeTimer.start(100ms);
+        notifyScheduler.start(Bike, 100ms);
     else
-        bikeTimer.start(1s);
+        notifyScheduler.start(Bike, 1s);
 }
 
+// every notification is encoded once and the same packet is written to all the processors and their clients
 #define DM_CHAR_NOTIF_NOTIF1_OP(UUID, P1, P2, P3)                                                                      \
     QByteArray all##UUID;                                                                                              \
-    int rv##UUID = notif##UUID->notify(all##UUID);
+    QByteArray frame##UUID;                                                                                            \
+    if (notif##UUID->notify(all##UUID) == CN_OK &&                                                                     \
+        notifyScheduler.changed(QBluetoothUuid((quint16)0x##UUID), all##UUID))                                         \
+        frame##UUID = DirconProcessor::encodeNotification(0x##UUID, all##UUID);
 
 #define DM_CHAR_NOTIF_NOTIF2_OP(UUID, P1, P2, P3)                                                                      \
-    if (rv##UUID == CN_OK)                                                                                             \
-        P1->sendCharacteristicNotification(0x##UUID, all##UUID);
+    if (!frame##UUID.isEmpty())                                                                                        \
+        P1->sendEncodedNotification(0x##UUID, frame##UUID);
 
 void DirconManager::bikeProvider() {
     DM_CHAR_NOTIF_OP(DM_CHAR_NOTIF_NOTIF1_OP, 0, 0, 0)
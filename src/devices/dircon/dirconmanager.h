@@ -14,6 +14,7 @@
 #include "characteristics/characteristicwriteprocessore005.h"
 #include "devices/dircon/dirconpacket.h"
 #include "devices/dircon/dirconprocessor.h"
+#include "virtualdevices/virtualnotifyscheduler.h"
 #include <QObject>
 
 #define DM_CHAR_NOTIF_OP(OP, P1, P2, P3)                                                                               \
@@ -26,7 +27,7 @@
 
 class DirconManager : public QObject {
     Q_OBJECT
-    QTimer bikeTimer;
+    virtualnotifyscheduler notifyScheduler;
     CharacteristicWriteProcessor2AD9 *writeP2AD9 = 0;
     CharacteristicWriteProcessorE005 *writePE005 = 0;
     DM_CHAR_NOTIF_OP(DM_CHAR_NOTIF_DEFINE_OP, 0, 0, 0)
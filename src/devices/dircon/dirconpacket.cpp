@@ -18,14 +18,22 @@ DirconPacket::operator QString() const {
 }
 
 int DirconPacket::parse(const QByteArray &buf, int last_seq_number) {
-    if (buf.size() >= DPKT_MESSAGE_HEADER_LENGTH) {
-        this->MessageVersion = ((quint8)buf.at(0));
-        this->Identifier = ((quint8)buf.at(1));
-        this->SequenceNumber = ((quint8)buf.at(2));
-        this->ResponseCode = ((quint8)buf.at(3));
-        this->Length = (((quint8)buf.at(4)) << 8) | ((quint8)buf.at(5));
+    return parse(buf.constData(), buf.size(), last_seq_number);
+}
+
+quint16 DirconPacket::uuidAt(const char *buf, int pos) {
+    return (((quint16)(quint8)buf[pos + DPKT_POS_SH8]) << 8) | (quint8)buf[pos + DPKT_POS_SH0];
+}
+
+int DirconPacket::parse(const char *buf, int size, int last_seq_number) {
+    if (size >= DPKT_MESSAGE_HEADER_LENGTH) {
+        this->MessageVersion = ((quint8)buf[0]);
+        this->Identifier = ((quint8)buf[1]);
+        this->SequenceNumber = ((quint8)buf[2]);
+        this->ResponseCode = ((quint8)buf[3]);
+        this->Length = (((quint8)buf[4]) << 8) | ((quint8)buf[5]);
         this->isRequest = false;
-        int difflen = buf.size() - DPKT_MESSAGE_HEADER_LENGTH;
+        int difflen = size - DPKT_MESSAGE_HEADER_LENGTH;
         int rembuf = DPKT_MESSAGE_HEADER_LENGTH + this->Length;
         if (difflen < this->Length)
             return DPKT_PARSE_WAIT;
@@ -39,9 +47,7 @@ int DirconPacket::parse(const QByteArray &buf, int last_seq_number) {
                 int idx = 0;
                 this->uuids.clear();
                 while (this->Length >= idx + 16) {
-                    quint16 uuid = (((quint16)buf.at(idx + DPKT_MESSAGE_HEADER_LENGTH + DPKT_POS_SH8)) << 8);
-                    uuid |= ((quint16)buf.at(idx + DPKT_MESSAGE_HEADER_LENGTH + DPKT_POS_SH0)) & 0x00FF;
-                    this->uuids.append(uuid);
+                    this->uuids.append(uuidAt(buf, idx + DPKT_MESSAGE_HEADER_LENGTH));
                     idx += 16;
                 }
                 return rembuf;
@@ -49,9 +55,7 @@ int DirconPacket::parse(const QByteArray &buf, int last_seq_number) {
                 return DPKT_PARSE_ERROR - rembuf;
         } else if (this->Identifier == DPKT_MSGID_DISCOVER_CHARACTERISTICS) {
             if (this->Length >= 16) {
-                quint16 uuid = ((quint16)buf.at(DPKT_MESSAGE_HEADER_LENGTH + DPKT_POS_SH8)) << 8;
-                uuid |= ((quint16)buf.at(DPKT_MESSAGE_HEADER_LENGTH + DPKT_POS_SH0)) & 0x00FF;
-                this->uuid = uuid;
+                this->uuid = uuidAt(buf, DPKT_MESSAGE_HEADER_LENGTH);
                 if (this->Length == 16) {
                     this->isRequest = this->checkIsRequest(last_seq_number);
                     return rembuf;
@@ -60,10 +64,8 @@ int DirconPacket::parse(const QByteArray &buf, int last_seq_number) {
                     this->additional_data.clear();
                     int idx = 16;
                     while (this->Length >= idx + 17) {
-                        quint16 uuid = (((quint16)buf.at(idx + DPKT_MESSAGE_HEADER_LENGTH + DPKT_POS_SH8)) << 8);
-                        uuid |= ((quint16)buf.at(idx + DPKT_MESSAGE_HEADER_LENGTH + DPKT_POS_SH0)) & 0x00FF;
-                        this->uuids.append(uuid);
-                        this->additional_data.append(((quint8)buf.at(idx + DPKT_MESSAGE_HEADER_LENGTH + 16)));
+                        this->uuids.append(uuidAt(buf, idx + DPKT_MESSAGE_HEADER_LENGTH));
+                        this->additional_data.append(((quint8)buf[idx + DPKT_MESSAGE_HEADER_LENGTH + 16]));
                         idx += 17;
                     }
                     return rembuf;
@@ -73,47 +75,39 @@ int DirconPacket::parse(const QByteArray &buf, int last_seq_number) {
                 return DPKT_PARSE_ERROR - rembuf;
         } else if (this->Identifier == DPKT_MSGID_READ_CHARACTERISTIC) {
             if (this->Length >= 16) {
-                quint16 uuid = ((quint16)buf.at(DPKT_MESSAGE_HEADER_LENGTH + DPKT_POS_SH8)) << 8;
-                uuid |= ((quint16)buf.at(DPKT_MESSAGE_HEADER_LENGTH + DPKT_POS_SH0)) & 0x00FF;
-                this->uuid = uuid;
+                this->uuid = uuidAt(buf, DPKT_MESSAGE_HEADER_LENGTH);
                 if (this->Length == 16)
                     this->isRequest = this->checkIsRequest(last_seq_number);
                 else
                     this->additional_data =
-                        buf.mid(DPKT_MESSAGE_HEADER_LENGTH + 16, rembuf - (DPKT_MESSAGE_HEADER_LENGTH + 16));
+                        QByteArray(buf + DPKT_MESSAGE_HEADER_LENGTH + 16, rembuf - (DPKT_MESSAGE_HEADER_LENGTH + 16));
                 return rembuf;
             } else
                 return DPKT_PARSE_ERROR - rembuf;
         } else if (this->Identifier == DPKT_MSGID_WRITE_CHARACTERISTIC) {
             if (this->Length > 16) {
-                quint16 uuid = ((quint16)buf.at(DPKT_MESSAGE_HEADER_LENGTH + DPKT_POS_SH8)) << 8;
-                uuid |= ((quint16)buf.at(DPKT_MESSAGE_HEADER_LENGTH + DPKT_POS_SH0)) & 0x00FF;
-                this->uuid = uuid;
+                this->uuid = uuidAt(buf, DPKT_MESSAGE_HEADER_LENGTH);
                 this->additional_data =
-                    buf.mid(DPKT_MESSAGE_HEADER_LENGTH + 16, rembuf - (DPKT_MESSAGE_HEADER_LENGTH + 16));
+                    QByteArray(buf + DPKT_MESSAGE_HEADER_LENGTH + 16, rembuf - (DPKT_MESSAGE_HEADER_LENGTH + 16));
                 this->isRequest = this->checkIsRequest(last_seq_number);
                 return rembuf;
             } else
                 return DPKT_PARSE_ERROR - rembuf;
         } else if (this->Identifier == DPKT_MSGID_ENABLE_CHARACTERISTIC_NOTIFICATIONS) {
             if (this->Length == 16 || this->Length == 17) {
-                quint16 uuid = ((quint16)buf.at(DPKT_MESSAGE_HEADER_LENGTH + DPKT_POS_SH8)) << 8;
-                uuid |= ((quint16)buf.at(DPKT_MESSAGE_HEADER_LENGTH + DPKT_POS_SH0)) & 0x00FF;
-                this->uuid = uuid;
+                this->uuid = uuidAt(buf, DPKT_MESSAGE_HEADER_LENGTH);
                 if (this->Length == 17) {
                     this->isRequest = true;
-                    this->additional_data = buf.mid(DPKT_MESSAGE_HEADER_LENGTH + 16, 1);
+                    this->additional_data = QByteArray(buf + DPKT_MESSAGE_HEADER_LENGTH + 16, 1);
                 }
                 return rembuf;
             } else
                 return DPKT_PARSE_ERROR - rembuf;
         } else if (this->Identifier == DPKT_MSGID_UNSOLICITED_CHARACTERISTIC_NOTIFICATION) {
             if (this->Length > 16) {
-                quint16 uuid = ((quint16)buf.at(DPKT_MESSAGE_HEADER_LENGTH + DPKT_POS_SH8)) << 8;
-                uuid |= ((quint16)buf.at(DPKT_MESSAGE_HEADER_LENGTH + DPKT_POS_SH0)) & 0x00FF;
-                this->uuid = uuid;
+                this->uuid = uuidAt(buf, DPKT_MESSAGE_HEADER_LENGTH);
                 this->additional_data =
-                    buf.mid(DPKT_MESSAGE_HEADER_LENGTH + 16, rembuf - (DPKT_MESSAGE_HEADER_LENGTH + 16));
+                    QByteArray(buf + DPKT_MESSAGE_HEADER_LENGTH + 16, rembuf - (DPKT_MESSAGE_HEADER_LENGTH + 16));
                 return rembuf;
             } else
                 return DPKT_PARSE_ERROR - rembuf;
@@ -46,12 +46,21 @@ class DirconPacket {
     DirconPacket &operator=(const DirconPacket &cp);
     QByteArray encode(int last_seq_number);
     int parse(const QByteArray &buf, int last_seq_number);
+    /**
+     * @brief Parses the packet at the start of size bytes, which can be followed by more packets: the caller moves
+     * its cursor by the value returned instead of copying the rest of its buffer.
+     * @return the length of the packet, DPKT_PARSE_WAIT if it isn't complete yet, DPKT_PARSE_ERROR minus its length
+     * if it's malformed.
+     */
+    int parse(const char *buf, int size, int last_seq_number);
     operator QString() const;
 
   private:
     quint8 uuid_bytes[16] = {0x00, 0x00, 0x18, 0x26, 0x00, 0x00, 0x10, 0x00,
                              0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x34, 0xFB};
     bool checkIsRequest(int last_seq_number);
+    // the 16 bit uuid of the 128 bit one starting at pos
+    static quint16 uuidAt(const char *buf, int pos);
 };
 
 #endif // DIRCONPACKET_H
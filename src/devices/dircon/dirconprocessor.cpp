@@ -1,4 +1,5 @@
 #include "dirconprocessor.h"
+#include "qzlog.h"
 #include "dirconpacket.h"
 #include "qzsettings.h"
 #include <QSettings>
@@ -8,21 +9,32 @@ DirconProcessor::DirconProcessor(const QList<DirconProcessorService *> &my_servi
                                  quint16 serv_port, const QString &serv_sn, const QString &my_mac, QObject *parent)
     : QObject(parent), services(my_services), mac(my_mac), serverPort(serv_port), serialN(serv_sn),
       serverName(serv_name) {
-    qDebug() << "In the constructor of dircon processor for" << serverName;
-    foreach (DirconProcessorService *my_service, my_services) { my_service->setParent(this); }
+    qCDebug(qzDircon) << "In the constructor of dircon processor for" << serverName;
+    foreach (DirconProcessorService *my_service, my_services) {
+        my_service->setParent(this);
+        // the first service or characteristic with a uuid answers its requests
+        if (!servicesMap.contains(my_service->uuid))
+            servicesMap.insert(my_service->uuid, my_service);
+        foreach (DirconProcessorCharacteristic *c, my_service->chars) {
+            if (!charsMap.contains(c->uuid))
+                charsMap.insert(c->uuid, c);
+        }
+    }
+    QSettings settings;
+    notifySubscribedOnly = settings.value(QZSettings::wahoo_rgt_dircon, QZSettings::default_wahoo_rgt_dircon).toBool();
 }
 
 DirconProcessor::~DirconProcessor() {}
 
 bool DirconProcessor::initServer() {
-    qDebug() << "Initializing dircon tcp server for" << serverName;
+    qCDebug(qzDircon) << "Initializing dircon tcp server for" << serverName;
     if (!server) {
         server = new QTcpServer(this);
         connect(server, SIGNAL(newConnection()), this, SLOT(tcpNewConnection()));
-        qDebug() << "Dircon TCP Server built" << serverName;
+        qCDebug(qzDircon) << "Dircon TCP Server built" << serverName;
     }
     if (!server->isListening()) {
-        qDebug() << "Dircon TCP Server trying to listen" << serverPort;
+        qCDebug(qzDircon) << "Dircon TCP Server trying to listen" << serverPort;
         return server->listen(QHostAddress::Any, serverPort);
     } else
         return true;
@@ -30,7 +42,7 @@ bool DirconProcessor::initServer() {
 
 void DirconProcessor::initAdvertising() {
     /*    if (!zeroConf) {
-            qDebug() << "Dircon Adv init for" << service->uuid;
+            qCDebug(qzDircon) << "Dircon Adv init for" << service->uuid;
             zeroConf = new QZeroConf(this);
             zeroConf->addServiceTxtRecord(
                 "ble-service-uuids",
@@ -44,7 +56,7 @@ void DirconProcessor::initAdvertising() {
             connect(zeroConf, SIGNAL(error(QZeroConf::error_t)), this, SLOT(advError(QZeroConf::error_t)));
         }*/
     if (!mdnsServer) {
-        qDebug() << "Dircon Adv init for" << serverName;
+        qCDebug(qzDircon) << "Dircon Adv init for" << serverName;
         mdnsServer = new QMdnsEngine::Server(this);
         mdnsHostname = new QMdnsEngine::Hostname(mdnsServer, serverName.toUtf8() + QByteArrayLiteral("H"), this);
         mdnsProvider = new QMdnsEngine::Provider(mdnsServer, mdnsHostname, this);
@@ -62,25 +74,25 @@ void DirconProcessor::initAdvertising() {
         mdnsService.addAttribute(QByteArrayLiteral("ble-service-uuids"), ble_uuids.toUtf8());
         mdnsService.setPort(serverPort);
         mdnsProvider->update(mdnsService);
-        qDebug() << "Dircon Adv init for" << serverName << " end";
+        qCDebug(qzDircon) << "Dircon Adv init for" << serverName << " end";
     }
 }
 
 bool DirconProcessor::init() {
-    qDebug() << "Dircon Processor init for" << serverName;
+    qCDebug(qzDircon) << "Dircon Processor init for" << serverName;
     bool rv = initServer();
-    qDebug() << "Dircon TCP Server RV" << rv;
+    qCDebug(qzDircon) << "Dircon TCP Server RV" << rv;
     if (rv)
         initAdvertising();
     else
-        qDebug() << "Cannot init dircon TCP server at port" << serverPort;
+        qCDebug(qzDircon) << "Cannot init dircon TCP server at port" << serverPort;
     return rv;
 }
 
 void DirconProcessor::tcpNewConnection() {
     QTcpSocket *socket = server->nextPendingConnection();
-    qDebug() << "New connection from" << socket->peerAddress().toString() << ":" << socket->peerPort()
-             << " uuid = " << serverName;
+    qCDebug(qzDircon) << "New connection from" << socket->peerAddress().toString() << ":" << socket->peerPort()
+                      << " uuid = " << serverName;
     connect(socket, SIGNAL(disconnected()), this, SLOT(tcpDisconnected()));
     connect(socket, SIGNAL(readyRead()), this, SLOT(tcpDataAvailable()));
     DirconProcessorClient *client = new DirconProcessorClient(socket);
@@ -89,16 +101,18 @@ void DirconProcessor::tcpNewConnection() {
 
 void DirconProcessor::tcpDisconnected() {
     QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
-    qDebug() << "Disconnection from" << socket->peerAddress().toString() << ":" << socket->peerPort()
-             << " uuid = " << serverName;
-    clientsMap.remove(socket);
+    qCDebug(qzDircon) << "Disconnection from" << socket->peerAddress().toString() << ":" << socket->peerPort()
+                      << " uuid = " << serverName;
+    DirconProcessorClient *client = clientsMap.take(socket);
+    for (QVector<DirconProcessorClient *> &clients : subscribers) {
+        clients.removeAll(client);
+    }
     socket->deleteLater();
 }
 
 DirconPacket DirconProcessor::processPacket(DirconProcessorClient *client, const DirconPacket &pkt) {
     DirconPacket out;
     if (pkt.isRequest) {
-        bool cfound = false;
         DirconProcessorCharacteristic *cc;
         DirconProcessorService *service;
         out.isRequest = false;
@@ -108,163 +122,164 @@ DirconPacket DirconProcessor::processPacket(DirconProcessorClient *client, const
             foreach (service, services)
                 out.uuids.append(service->uuid);
         } else if (pkt.Identifier == DPKT_MSGID_DISCOVER_CHARACTERISTICS) {
-            foreach (service, services)
-                if (service->uuid == pkt.uuid) {
-                    cfound = true;
-                    out.ResponseCode = DPKT_RESPCODE_SUCCESS_REQUEST;
-                    out.uuid = pkt.uuid;
-                    foreach (cc, service->chars) {
-                        out.uuids.append(cc->uuid);
-                        out.additional_data.append(cc->type);
-                    }
-                    break;
+            if ((service = servicesMap.value(pkt.uuid))) {
+                out.ResponseCode = DPKT_RESPCODE_SUCCESS_REQUEST;
+                out.uuid = pkt.uuid;
+                foreach (cc, service->chars) {
+                    out.uuids.append(cc->uuid);
+                    out.additional_data.append(cc->type);
                 }
-            if (!cfound)
+            } else
                 out.ResponseCode = DPKT_RESPCODE_SERVICE_NOT_FOUND;
         } else if (pkt.Identifier == DPKT_MSGID_READ_CHARACTERISTIC) {
-            foreach (service, services) {
-                foreach (cc, service->chars) {
-                    if (cc->uuid == pkt.uuid) {
-                        cfound = true;
-                        if (cc->type & DPKT_CHAR_PROP_FLAG_READ) {
-                            out.uuid = pkt.uuid;
-                            out.ResponseCode = DPKT_RESPCODE_SUCCESS_REQUEST;
-                            out.additional_data.append(cc->read_values);
-                            emit onCharacteristicRead(cc->uuid);
-                        } else
-                            out.ResponseCode = DPKT_RESPCODE_CHARACTERISTIC_OPERATION_NOT_SUPPORTED;
-                        break;
-                    }
-                }
-                if (cfound)
-                    break;
-            }
-            if (!cfound)
+            if (!(cc = charsMap.value(pkt.uuid)))
                 out.ResponseCode = DPKT_RESPCODE_CHARACTERISTIC_NOT_FOUND;
+            else if (cc->type & DPKT_CHAR_PROP_FLAG_READ) {
+                out.uuid = pkt.uuid;
+                out.ResponseCode = DPKT_RESPCODE_SUCCESS_REQUEST;
+                out.additional_data.append(cc->read_values);
+                emit onCharacteristicRead(cc->uuid);
+            } else
+                out.ResponseCode = DPKT_RESPCODE_CHARACTERISTIC_OPERATION_NOT_SUPPORTED;
         } else if (pkt.Identifier == DPKT_MSGID_WRITE_CHARACTERISTIC) {
-            foreach (service, services) {
-                foreach (cc, service->chars) {
-                    if (cc->uuid == pkt.uuid) {
-                        cfound = true;
-                        if (cc->type & DPKT_CHAR_PROP_FLAG_WRITE) {
-                            int res;
-                            if (cc->writeP &&
-                                (res = cc->writeP->writeProcess(cc->uuid, pkt.additional_data, out.additional_data)) !=
-                                    CP_INVALID) {
-                                out.uuid = pkt.uuid;
-                                out.ResponseCode = DPKT_RESPCODE_SUCCESS_REQUEST;
-                            } else
-                                out.Identifier = DPKT_MSGID_ERROR;
-                            emit onCharacteristicWrite(cc->uuid, pkt.additional_data);
-                        } else
-                            out.ResponseCode = DPKT_RESPCODE_CHARACTERISTIC_OPERATION_NOT_SUPPORTED;
-                        break;
-                    }
-                }
-                if (cfound)
-                    break;
-            }
-            if (!cfound)
+            if (!(cc = charsMap.value(pkt.uuid)))
                 out.ResponseCode = DPKT_RESPCODE_CHARACTERISTIC_NOT_FOUND;
+            else if (cc->type & DPKT_CHAR_PROP_FLAG_WRITE) {
+                int res;
+                if (cc->writeP && (res = cc->writeP->writeProcess(cc->uuid, pkt.additional_data,
+                                                                   out.additional_data)) != CP_INVALID) {
+                    out.uuid = pkt.uuid;
+                    out.ResponseCode = DPKT_RESPCODE_SUCCESS_REQUEST;
+                } else
+                    out.Identifier = DPKT_MSGID_ERROR;
+                emit onCharacteristicWrite(cc->uuid, pkt.additional_data);
+            } else
+                out.ResponseCode = DPKT_RESPCODE_CHARACTERISTIC_OPERATION_NOT_SUPPORTED;
         } else if (pkt.Identifier == DPKT_MSGID_ENABLE_CHARACTERISTIC_NOTIFICATIONS) {
-            foreach (service, services) {
-                foreach (cc, service->chars) {
-                    if (cc->uuid == pkt.uuid) {
-                        cfound = true;
-                        if (cc->type & DPKT_CHAR_PROP_FLAG_NOTIFY) {
-                            int idx;
-                            char notif = pkt.additional_data.at(0);
-                            out.uuid = pkt.uuid;
-
-                            if ((idx = client->char_notify.indexOf(pkt.uuid)) >= 0 && !notif)
-                                client->char_notify.removeAt(idx);
-                            else if (idx < 0 && notif)
-                                client->char_notify.append(pkt.uuid);
-                            out.ResponseCode = DPKT_RESPCODE_SUCCESS_REQUEST;
-                            emit onCharacteristicNotificationSwitch(cc->uuid, notif);
-                        } else
-                            out.ResponseCode = DPKT_RESPCODE_CHARACTERISTIC_OPERATION_NOT_SUPPORTED;
-                        break;
-                    }
-                }
-                if (cfound)
-                    break;
-            }
-            if (!cfound)
+            if (!(cc = charsMap.value(pkt.uuid)))
                 out.ResponseCode = DPKT_RESPCODE_CHARACTERISTIC_NOT_FOUND;
+            else if (cc->type & DPKT_CHAR_PROP_FLAG_NOTIFY) {
+                char notif = pkt.additional_data.at(0);
+                out.uuid = pkt.uuid;
+
+                QVector<DirconProcessorClient *> &clients = subscribers[pkt.uuid];
+                if (!notif)
+                    clients.removeAll(client);
+                else if (!clients.contains(client))
+                    clients.append(client);
+                out.ResponseCode = DPKT_RESPCODE_SUCCESS_REQUEST;
+                emit onCharacteristicNotificationSwitch(cc->uuid, notif);
+            } else
+                out.ResponseCode = DPKT_RESPCODE_CHARACTERISTIC_OPERATION_NOT_SUPPORTED;
         }
     }
     return out;
 }
 
-bool DirconProcessor::sendCharacteristicNotification(quint16 uuid, const QByteArray &data) {
+QByteArray DirconProcessor::encodeNotification(quint16 uuid, const QByteArray &data) {
     DirconPacket pkt;
-    QTcpSocket *socket;
-    DirconProcessorClient *client;
-    QSettings settings;
-    bool rv = true, rvs;
     pkt.additional_data = data;
     pkt.Identifier = DPKT_MSGID_UNSOLICITED_CHARACTERISTIC_NOTIFICATION;
     pkt.ResponseCode = DPKT_RESPCODE_SUCCESS_REQUEST;
     pkt.uuid = uuid;
-    for (QHash<QTcpSocket *, DirconProcessorClient *>::iterator i = clientsMap.begin(); i != clientsMap.end(); ++i) {
-        client = i.value();
-        if (client->char_notify.indexOf(uuid) >= 0 || !settings.value(QZSettings::wahoo_rgt_dircon, QZSettings::default_wahoo_rgt_dircon).toBool()) {
-            socket = i.key();
-            rvs = socket->write(pkt.encode(0)) < 0;
-            if (rvs)
+    // the sequence number of a notification is always 0
+    return pkt.encode(0);
+}
+
+bool DirconProcessor::sendCharacteristicNotification(quint16 uuid, const QByteArray &data) {
+    return sendEncodedNotification(uuid, encodeNotification(uuid, data));
+}
+
+bool DirconProcessor::sendEncodedNotification(quint16 uuid, const QByteArray &frame) {
+    bool rv = true;
+    if (notifySubscribedOnly) {
+        const QVector<DirconProcessorClient *> clients = subscribers.value(uuid);
+        for (DirconProcessorClient *client : clients) {
+            if (!writeNotification(client, uuid, frame))
+                rv = false;
+        }
+    } else {
+        for (DirconProcessorClient *client : qAsConst(clientsMap)) {
+            if (!writeNotification(client, uuid, frame))
                 rv = false;
-            qDebug() << serverName << "sending to" << socket->peerAddress().toString() << ":" << socket->peerPort()
-                     << " notification for uuid = " << QString(QStringLiteral("%1")).arg(uuid, 4, 16, QLatin1Char('0'))
-                     << "rv=" << (!rvs) << data.toHex(' ');
         }
     }
     return rv;
 }
 
+bool DirconProcessor::writeNotification(DirconProcessorClient *client, quint16 uuid, const QByteArray &frame) {
+    QTcpSocket *socket = client->sock;
+    if (socket->bytesToWrite() + frame.size() > maxQueuedBytes) {
+        // a notification is replaced by the next one: better to skip it than to queue without bounds
+        if (client->dropped++ == 0)
+            qCDebug(qzDircon) << serverName << "client" << socket->peerAddress().toString() << ":"
+                              << socket->peerPort() << "too slow, dropping its notifications";
+        droppedNotifications++;
+        return true;
+    }
+    bool rvs = socket->write(frame) < 0;
+    qCDebug(qzDircon) << serverName << "sending to" << socket->peerAddress().toString() << ":" << socket->peerPort()
+                      << " notification for uuid = " << QString(QStringLiteral("%1")).arg(uuid, 4, 16, QLatin1Char('0'))
+                      << "rv=" << (!rvs) << frame.mid(DPKT_MESSAGE_HEADER_LENGTH + 16).toHex(' ');
+    return !rvs;
+}
+
+QByteArray DirconProcessor::processData(DirconProcessorClient *client, const QByteArray &data) {
+    QByteArray responses;
+    // appending to an empty buffer shares the data instead of copying it
+    client->buffer.append(data);
+    const char *buf = client->buffer.constData();
+    const int size = client->buffer.size();
+    int pos = 0;
+    int buflimit, rembuf;
+    while (1) {
+        DirconPacket pkt;
+        buflimit = pkt.parse(buf + pos, size - pos, client->seq);
+        qCDebug(qzDircon) << "Pkt for uuid" << serverName << "parsed rv=" << buflimit << " ->" << pkt;
+        if (buflimit > 0) {
+            rembuf = buflimit;
+            if (pkt.isRequest)
+                client->seq = pkt.SequenceNumber;
+            else if (pkt.Identifier != DPKT_MSGID_UNSOLICITED_CHARACTERISTIC_NOTIFICATION)
+                client->seq += 1;
+        } else if (buflimit < DPKT_PARSE_ERROR) {
+            rembuf = -buflimit - DPKT_PARSE_ERROR;
+            qCDebug(qzDircon) << "Unexpected packet" << QByteArray(buf + pos, rembuf).toHex();
+        } else
+            rembuf = -1;
+        if (rembuf >= 0)
+            pos += rembuf;
+        if (buflimit > 0) {
+            DirconPacket resp = processPacket(client, pkt);
+            qCDebug(qzDircon) << "Sending resp for uuid" << serverName << ":" << resp;
+            if (resp.Identifier != DPKT_MSGID_ERROR)
+                responses += resp.encode(pkt.SequenceNumber);
+        } else if (rembuf >= 0) {
+            DirconPacket resp;
+            resp.isRequest = false;
+            resp.ResponseCode = DPKT_RESPCODE_UNEXPECTED_ERROR;
+            resp.Identifier = pkt.Identifier;
+            responses += resp.encode(pkt.SequenceNumber);
+        } else
+            break;
+    }
+    // the consumed packets are removed once, the partial one left is usually a few bytes if any
+    if (pos == size)
+        client->buffer.clear();
+    else if (pos > 0)
+        client->buffer.remove(0, pos);
+    return responses;
+}
+
 void DirconProcessor::tcpDataAvailable() {
     QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
     DirconProcessorClient *client = clientsMap.value(socket);
     QByteArray data = socket->readAll();
-    qDebug() << "Data available for uuid " << serverName << ":" << data.toHex();
+    qCDebug(qzDircon) << "Data available for uuid " << serverName << ":" << data.toHex();
     if (client) {
-        int buflimit, rembuf;
-        client->buffer.append(data);
-        while (1) {
-            DirconPacket pkt;
-            buflimit = pkt.parse(client->buffer, client->seq);
-            qDebug() << "Pkt for uuid" << serverName << "parsed rv=" << buflimit << " ->" << pkt;
-            if (buflimit > 0) {
-                rembuf = buflimit;
-                if (pkt.isRequest)
-                    client->seq = pkt.SequenceNumber;
-                else if (pkt.Identifier != DPKT_MSGID_UNSOLICITED_CHARACTERISTIC_NOTIFICATION)
-                    client->seq += 1;
-            } else if (buflimit < DPKT_PARSE_ERROR) {
-                rembuf = -buflimit - DPKT_PARSE_ERROR;
-                qDebug() << "Unexpected packet" << client->buffer.mid(0, rembuf).toHex();
-            } else
-                rembuf = -1;
-            if (rembuf >= 0)
-                client->buffer = client->buffer.mid(rembuf);
-            if (buflimit > 0) {
-                DirconPacket resp = processPacket(client, pkt);
-                qDebug() << "Sending resp for uuid" << serverName << ":" << resp;
-                if (resp.Identifier != DPKT_MSGID_ERROR) {
-                    QByteArray byteout = resp.encode(pkt.SequenceNumber);
-                    if (byteout.size())
-                        client->sock->write(byteout);
-                }
-            } else if (rembuf >= 0) {
-                DirconPacket resp;
-                resp.isRequest = false;
-                resp.ResponseCode = DPKT_RESPCODE_UNEXPECTED_ERROR;
-                resp.Identifier = pkt.Identifier;
-                QByteArray byteout = resp.encode(pkt.SequenceNumber);
-                if (byteout.size())
-                    client->sock->write(byteout);
-            } else
-                break;
-        }
+        // the responses to all the requests read go with one write
+        QByteArray responses = processData(client, data);
+        if (responses.size())
+            socket->write(responses);
     }
 }
@@ -11,6 +11,7 @@
 #include <QObject>
 #include <QTcpServer>
 #include <QTcpSocket>
+#include <QVector>
 
 class DirconProcessorCharacteristic : public QObject {
   public:
@@ -60,13 +61,17 @@ class DirconProcessorService : public QObject {
 #define DP_BASE_UUID "0000u-0000-1000-8000-00805F9B34FB"
 // QString("%1").arg(iTest & 0xFFFF, 4, 16);
 
+// the notifications are dropped for a client with more than these bytes still to be sent
+#define DP_CLIENT_MAX_QUEUED_BYTES (32 * 1024)
+
 class DirconProcessorClient : public QObject {
   public:
     DirconProcessorClient(QTcpSocket *sock) : QObject(sock), sock(sock) {}
     quint8 seq = 0;
-    QList<quint16> char_notify;
     QTcpSocket *sock;
     QByteArray buffer;
+    // the notifications dropped because the client doesn't read them fast enough
+    quint64 dropped = 0;
 };
 
 class DirconProcessor : public QObject {
@@ -81,16 +86,44 @@ class DirconProcessor : public QObject {
     QMdnsEngine::Provider *mdnsProvider = 0;
     QMdnsEngine::Hostname *mdnsHostname = 0;
     QHash<QTcpSocket *, DirconProcessorClient *> clientsMap;
+    // the services and characteristics by uuid, built once: every request looks one of them up
+    QHash<quint16, DirconProcessorService *> servicesMap;
+    QHash<quint16, DirconProcessorCharacteristic *> charsMap;
+    // the clients subscribed to the notifications of each characteristic
+    QHash<quint16, QVector<DirconProcessorClient *>> subscribers;
+    // wahoo_rgt_dircon: the notifications go only to the subscribed clients, otherwise to all of them
+    bool notifySubscribedOnly = false;
+    qint64 maxQueuedBytes = DP_CLIENT_MAX_QUEUED_BYTES;
+    quint64 droppedNotifications = 0;
     bool initServer();
     void initAdvertising();
     DirconPacket processPacket(DirconProcessorClient *client, const DirconPacket &pkt);
+    bool writeNotification(DirconProcessorClient *client, quint16 uuid, const QByteArray &frame);
 
   public:
     ~DirconProcessor();
     explicit DirconProcessor(const QList<DirconProcessorService *> &services, const QString &serv_name,
                              quint16 serv_port, const QString &serv_sn, const QString &mac, QObject *parent = nullptr);
+    /**
+     * @brief The unsolicited notification packet of a characteristic, the same for every client.
+     */
+    static QByteArray encodeNotification(quint16 uuid, const QByteArray &data);
     bool sendCharacteristicNotification(quint16 uuid, const QByteArray &data);
+    /**
+     * @brief Writes a packet built by encodeNotification to the clients, without encoding it again.
+     */
+    bool sendEncodedNotification(quint16 uuid, const QByteArray &frame);
     bool init();
+    /**
+     * @brief Handles the bytes received from a client: the complete requests are answered, a partial one is kept
+     * until the rest arrives.
+     * @return the responses to write to the client.
+     */
+    QByteArray processData(DirconProcessorClient *client, const QByteArray &data);
+    quint16 port() const { return server ? server->serverPort() : serverPort; }
+    int clientCount() const { return clientsMap.size(); }
+    quint64 dropped() const { return droppedNotifications; }
+    void setMaxQueuedBytes(qint64 bytes) { maxQueuedBytes = bytes; }
   private slots:
     void tcpDataAvailable();
     void tcpDisconnected();
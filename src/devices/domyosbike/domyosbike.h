@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "devices/bike.h"
+#include "monotonicclock.h"
 #include "virtualdevices/virtualbike.h"
 
 #ifdef Q_OS_IOS
@@ -79,7 +80,7 @@ class domyosbike : public bike {
     bool searchStopped = false;
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
     enum _BIKE_TYPE {
         CHANG_YOW,
@@ -361,8 +361,8 @@ void domyoselliptical::characteristicChanged(const QLowEnergyCharacteristic &cha
     Speed = speed;
     KCal = kcal;
     Distance += ((Speed.value() / 3600000.0) *
-                 ((double)lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime())));
-    lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+                 ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)));
+    lastRefreshCharacteristicChanged = monotonicclock::msecs();
 }
 
 double domyoselliptical::GetSpeedFromPacket(const QByteArray &packet) {
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "devices/elliptical.h"
+#include "monotonicclock.h"
 
 class domyoselliptical : public elliptical {
     Q_OBJECT
@@ -69,7 +70,7 @@ class domyoselliptical : public elliptical {
     bool searchStopped = false;
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
     enum _BIKE_TYPE {
         CHANG_YOW,
@@ -298,7 +298,7 @@ void domyosrower::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void domyosrower::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -386,7 +386,7 @@ void domyosrower::characteristicChanged(const QLowEnergyCharacteristic &characte
         Speed = speed;
         KCal = kcal;
         Distance += ((Speed.value() / 3600000.0) *
-                     ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                     ((double)(now - lastRefreshCharacteristicChanged)));
         lastRefreshCharacteristicChanged = now;
     } else {
         union flags {
@@ -477,7 +477,7 @@ void domyosrower::characteristicChanged(const QLowEnergyCharacteristic &characte
             index += 3;
         } else {
             Distance += ((Speed.value() / 3600000.0) *
-                         ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                         ((double)(now - lastRefreshCharacteristicChanged)));
         }
 
         emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
@@ -567,9 +567,8 @@ void domyosrower::characteristicChanged(const QLowEnergyCharacteristic &characte
                     ((((0.048 * ((double)watts()) + 1.19) *
                        settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                       200.0) /
-                     (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                    now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                      // kg * 3.5) / 200 ) / 60
+                     (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts
+                                                                      // +1.19) * body weight in kg * 3.5) / 200 ) / 60
         }
 
         emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "rower.h"
+#include "monotonicclock.h"
 
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
@@ -77,9 +78,9 @@ class domyosrower : public rower {
     bool searchStopped = false;
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
-    QDateTime lastStroke = QDateTime::currentDateTime();
+    qint64 lastStroke = monotonicclock::msecs();
     double lastStrokesCount = 0;
 
 #ifdef Q_OS_IOS
@@ -1,4 +1,5 @@
 #include "domyostreadmill.h"
+#include "qzlog.h"
 #include "keepawakehelper.h"
 #include "virtualdevices/virtualbike.h"
 #include "virtualdevices/virtualtreadmill.h"
@@ -90,13 +91,13 @@ void domyostreadmill::writeCharacteristic(uint8_t *data, uint8_t data_len, const
 
     if (gattCommunicationChannelService->state() != QLowEnergyService::ServiceState::ServiceDiscovered ||
         m_control->state() == QLowEnergyController::UnconnectedState) {
-        qDebug() << QStringLiteral("writeCharacteristic error because the connection is closed");
+        qCDebug(qzTreadmill) << QStringLiteral("writeCharacteristic error because the connection is closed");
 
         return;
     }
 
     if (!gattWriteCharacteristic.isValid()) {
-        qDebug() << QStringLiteral("gattWriteCharacteristic is invalid");
+        qCDebug(qzTreadmill) << QStringLiteral("gattWriteCharacteristic is invalid");
         return;
     }
 
@@ -108,14 +109,14 @@ void domyostreadmill::writeCharacteristic(uint8_t *data, uint8_t data_len, const
     gattCommunicationChannelService->writeCharacteristic(gattWriteCharacteristic, *writeBuffer);
 
     if (!disable_log) {
-        qDebug() << QStringLiteral(" >> ") + writeBuffer->toHex(' ')
-                 << QStringLiteral(" // ") + info;
+        qCDebug(qzTreadmill) << QStringLiteral(" >> ") + writeBuffer->toHex(' ')
+                             << QStringLiteral(" // ") + info;
     }
 
     loop.exec();
 
     if (timeout.isActive() == false) {
-        qDebug() << QStringLiteral(" exit for timeout");
+        qCDebug(qzTreadmill) << QStringLiteral(" exit for timeout");
     }
 }
 
@@ -411,7 +412,8 @@ void domyostreadmill::characteristicChanged(const QLowEnergyCharacteristic &char
     Q_UNUSED(characteristic);
     QByteArray value = newValue;
 
-    emit debug(QStringLiteral(" << ") + QString::number(value.length()) + QStringLiteral(" ") + value.toHex(' '));
+    QZ_EMIT_DEBUG(qzTreadmill,
+                  QStringLiteral(" << ") + QString::number(value.length()) + QStringLiteral(" ") + value.toHex(' '));
 
     // for the init packets, the length is always less than 20
     // for the display and status packets, the length is always grater then 20 and there are 2 cases:
@@ -421,7 +423,7 @@ void domyostreadmill::characteristicChanged(const QLowEnergyCharacteristic &char
     //         and the second one with the remained byte
     // so this simply condition will match all the cases, excluding the 20byte packet of the T900.
     if (newValue.length() != 20) {
-        emit debug(QStringLiteral("packetReceived!"));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("packetReceived!"));
 
         emit packetReceived();
     }
@@ -439,7 +441,7 @@ void domyostreadmill::characteristicChanged(const QLowEnergyCharacteristic &char
         (lastPacket.length() == 20 && lastPacket.startsWith(startBytes2) && value.length() == 7)) {
 
         incompletePackets = false;
-        emit debug(QStringLiteral("...final bytes received"));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("...final bytes received"));
         lastPacket.append(value);
         value = lastPacket;
     }
@@ -450,51 +452,51 @@ void domyostreadmill::characteristicChanged(const QLowEnergyCharacteristic &char
 
         // semaphore for any writing packets (for example, update display)
         if (value.length() == 20 && (value.startsWith(startBytes) || value.startsWith(startBytes2))) {
-            emit debug(QStringLiteral("waiting for other bytes..."));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("waiting for other bytes..."));
 
             incompletePackets = true;
         }
 
-        emit debug(QStringLiteral("packet ignored"));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("packet ignored"));
         return;
     }
 
     if (value.at(22) == 0x06) {
-        emit debug(QStringLiteral("start button pressed!"));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("start button pressed!"));
 
         requestStart = 1;
     } else if (value.at(22) == 0x07) {
-        emit debug(QStringLiteral("stop button pressed!"));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("stop button pressed!"));
 
         requestStop = 1;
     } else if (value.at(22) == 0x0b) {
-        emit debug(QStringLiteral("increase speed fan pressed!"));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("increase speed fan pressed!"));
 
         requestIncreaseFan = 1;
     } else if (value.at(22) == 0x0a) {
-        emit debug(QStringLiteral("decrease speed fan pressed!"));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("decrease speed fan pressed!"));
 
         requestDecreaseFan = 1;
     } else if (value.at(22) == 0x08) {
-        emit debug(QStringLiteral("increase speed button on console pressed!"));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("increase speed button on console pressed!"));
         if (domyos_treadmill_buttons) {
 
             changeSpeed(currentSpeed().value() + 0.2);
         }
     } else if (value.at(22) == 0x09) {
-        emit debug(QStringLiteral("decrease speed button on console pressed!"));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("decrease speed button on console pressed!"));
         if (domyos_treadmill_buttons) {
 
             changeSpeed(currentSpeed().value() - 0.2);
         }
     } else if (value.at(22) == 0x0c) {
-        emit debug(QStringLiteral("increase inclination button on console pressed!"));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("increase inclination button on console pressed!"));
         if (domyos_treadmill_buttons) {
 
             changeInclination(currentInclination().value() + 0.5, currentInclination().value() + 0.5);
         }
     } else if (value.at(22) == 0x0d) {
-        emit debug(QStringLiteral("decrease inclination button on console pressed!"));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("decrease inclination button on console pressed!"));
         if (domyos_treadmill_buttons) {
 
             changeInclination(currentInclination().value() - 0.5, currentInclination().value() - 0.5);
@@ -502,136 +504,136 @@ void domyostreadmill::characteristicChanged(const QLowEnergyCharacteristic &char
     } else if (value.at(22) == 0x11) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("10km/h speed button pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("10km/h speed button pressed!"));
                 changeSpeed(10.0);
             } else {
-                emit debug(QStringLiteral("22km/h speed button pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("22km/h speed button pressed!"));
                 changeSpeed(settings.value(QZSettings::domyos_treadmill_button_22kmh, QZSettings::default_domyos_treadmill_button_22kmh).toDouble());
             }            
         }
     } else if (value.at(22) == 0x10) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("8km/h speed button pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("8km/h speed button pressed!"));
                 changeSpeed(8.0);
             } else {
-                emit debug(QStringLiteral("16km/h speed button pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("16km/h speed button pressed!"));
                 changeSpeed(settings.value(QZSettings::domyos_treadmill_button_16kmh, QZSettings::default_domyos_treadmill_button_16kmh).toDouble());
             }            
         }
     } else if (value.at(22) == 0x0f) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("6km/h speed button pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("6km/h speed button pressed!"));
                 changeSpeed(6.0);
             } else {
-                emit debug(QStringLiteral("10km/h speed button pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("10km/h speed button pressed!"));
                 changeSpeed(settings.value(QZSettings::domyos_treadmill_button_10kmh, QZSettings::default_domyos_treadmill_button_10kmh).toDouble());
             }            
         }
     } else if (value.at(22) == 0x0e) {        
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("4km/h speed button pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("4km/h speed button pressed!"));
                 changeSpeed(4.0);
             } else {
-                emit debug(QStringLiteral("5km/h speed button pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("5km/h speed button pressed!"));
                 changeSpeed(settings.value(QZSettings::domyos_treadmill_button_5kmh, QZSettings::default_domyos_treadmill_button_5kmh).toDouble());
             }            
         }
     } else if (value.at(22) == 0x15) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("3% inclination button on console pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("3% inclination button on console pressed!"));
                 changeInclination(3.0, 3.0);
             } else {
-                emit debug(QStringLiteral("15% inclination button on console pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("15% inclination button on console pressed!"));
                 changeInclination(15.0, 15.0);
             }            
         }        
     } else if (value.at(22) == 0x14) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("2% inclination button on console pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("2% inclination button on console pressed!"));
                 changeInclination(2.0, 2.0);
             } else {
-                emit debug(QStringLiteral("10% inclination button on console pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("10% inclination button on console pressed!"));
                 changeInclination(10.0, 10.0);
             }            
         }        
     } else if (value.at(22) == 0x13) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("1% inclination button on console pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("1% inclination button on console pressed!"));
                 changeInclination(1.0, 1.0);
             } else {
-                emit debug(QStringLiteral("5% inclination button on console pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("5% inclination button on console pressed!"));
                 changeInclination(5.0, 5.0);
             }            
         }        
     } else if (value.at(22) == 0x12) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("0% inclination button on console pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("0% inclination button on console pressed!"));
                 changeInclination(0.0, 0.0);
             } else {
-                emit debug(QStringLiteral("0% inclination button on console pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("0% inclination button on console pressed!"));
                 changeInclination(0.0, 0.0);
             }            
         }        
     } else if (value.at(22) == 0x17) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("14km/h speed button pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("14km/h speed button pressed!"));
                 changeSpeed(14.0);
             }            
         }        
     } else if (value.at(22) == 0x18) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("16km/h speed button on console pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("16km/h speed button on console pressed!"));
                 changeSpeed(16.0);
             }            
         }        
     } else if (value.at(22) == 0x19) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("18km/h speed button pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("18km/h speed button pressed!"));
                 changeSpeed(18.0);
             }            
         }        
     } else if (value.at(22) == 0x16) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("12km/h speed button pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("12km/h speed button pressed!"));
                 changeSpeed(12.0);
             }            
         }        
     } else if (value.at(22) == 0x1a) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("4% inclination button on console pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("4% inclination button on console pressed!"));
                 changeInclination(4.0, 4.0);
             }            
         }        
     } else if (value.at(22) == 0x1b) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("6% inclination button on console pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("6% inclination button on console pressed!"));
                 changeInclination(6.0, 6.0);
             }            
         }        
     } else if (value.at(22) == 0x1c) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("8% inclination button on console pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("8% inclination button on console pressed!"));
                 changeInclination(8.0, 8.0);
             }            
         }        
     } else if (value.at(22) == 0x1d) {
         if (domyos_treadmill_buttons) {
             if(domyos_treadmill_t900a) {
-                emit debug(QStringLiteral("10% inclination button on console pressed!"));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("10% inclination button on console pressed!"));
                 changeInclination(10.0, 10.0);
             }            
         }        
@@ -675,24 +677,24 @@ void domyostreadmill::characteristicChanged(const QLowEnergyCharacteristic &char
                     1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastTimeCharacteristicChanged.msecsTo(
-                                QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(monotonicclock::msecs() - lastTimeCharacteristicChanged)))); //(( (0.048* Output
+                                                                  // in watts +1.19) * body weight in kg * 3.5) / 200 )
+                                                                  // / 60
         Distance += ((speed / (double)3600.0) /
-                     ((double)1000.0 / (double)(lastTimeCharacteristicChanged.msecsTo(QDateTime::currentDateTime()))));
-        lastTimeCharacteristicChanged = QDateTime::currentDateTime();
+                     ((double)1000.0 / (double)(monotonicclock::msecs() - lastTimeCharacteristicChanged)));
+        lastTimeCharacteristicChanged = monotonicclock::msecs();
     }
 
-    emit debug(QStringLiteral("Current speed: ") + QString::number(speed));
-    emit debug(QStringLiteral("Current incline: ") + QString::number(incline));
-    emit debug(QStringLiteral("Current heart: ") + QString::number(Heart.value()));
-    emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
-    emit debug(QStringLiteral("Current KCal from the machine: ") + QString::number(kcal));
-    emit debug(QStringLiteral("Current Distance: ") + QString::number(distance));
-    emit debug(QStringLiteral("Current Distance Calculated: ") + QString::number(Distance.value()));
+    QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current speed: ") + QString::number(speed));
+    QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current incline: ") + QString::number(incline));
+    QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current heart: ") + QString::number(Heart.value()));
+    QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
+    QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current KCal from the machine: ") + QString::number(kcal));
+    QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Distance: ") + QString::number(distance));
+    QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Distance Calculated: ") + QString::number(Distance.value()));
 
     if (m_control->error() != QLowEnergyController::NoError) {
-        qDebug() << QStringLiteral("QLowEnergyController ERROR!!") << m_control->errorString();
+        qCDebug(qzTreadmill) << QStringLiteral("QLowEnergyController ERROR!!") << m_control->errorString();
     }
 
     if (Speed.value() != speed) {
@@ -713,6 +715,8 @@ void domyostreadmill::characteristicChanged(const QLowEnergyCharacteristic &char
     }
 
     firstCharacteristicChanged = false;
+
+    emit metricsUpdated();
 }
 
 double domyostreadmill::GetSpeedFromPacket(const QByteArray &packet) {
@@ -820,7 +824,7 @@ void domyostreadmill::descriptorWritten(const QLowEnergyDescriptor &descriptor,
 void domyostreadmill::characteristicWritten(const QLowEnergyCharacteristic &characteristic,
                                             const QByteArray &newValue) {
     Q_UNUSED(characteristic);
-    emit debug(QStringLiteral("characteristicWritten ") + newValue.toHex(' '));
+    QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("characteristicWritten ") + newValue.toHex(' '));
 }
 
 void domyostreadmill::serviceScanDone(void) {
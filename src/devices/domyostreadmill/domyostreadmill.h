@@ -28,6 +28,7 @@
 #include <QObject>
 
 #include "treadmill.h"
+#include "monotonicclock.h"
 
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
@@ -62,7 +63,7 @@ class domyostreadmill : public treadmill {
     uint8_t sec1Update = 0;
     uint8_t firstInit = 0;
     QByteArray lastPacket;
-    QDateTime lastTimeCharacteristicChanged;
+    qint64 lastTimeCharacteristicChanged = monotonicclock::msecs();
     bool firstCharacteristicChanged = true;
     QDateTime lastInclinationChanged = QDateTime::currentDateTime();
 
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "devices/bike.h"
+#include "monotonicclock.h"
 #include "virtualdevices/virtualbike.h"
 #include "virtualdevices/virtualrower.h"
 
@@ -70,7 +71,7 @@ class echelonconnectsport : public bike {
     uint8_t counterPoll = 1;
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
     uint8_t firstStateChanged = 0;
     resistance_t lastResistanceBeforeDisconnection = -1;
 
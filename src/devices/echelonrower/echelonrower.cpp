@@ -234,7 +234,7 @@ void echelonrower::characteristicChanged(const QLowEnergyCharacteristic &charact
             .startsWith(QStringLiteral("Disabled"))) {
         Cadence = ((uint8_t)lastPacket.at(11));
         StrokesCount += (Cadence.value()) *
-                        ((double)lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime())) / 60000;
+                        ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)) / 60000;
     }
     // instant pace to km/h
     if ((((uint8_t)lastPacket.at(14)) > 0 || ((uint8_t)lastPacket.at(13)) > 0) && Cadence.value() > 0) {
@@ -253,18 +253,17 @@ void echelonrower::characteristicChanged(const QLowEnergyCharacteristic &charact
             ((((0.048 * ((double)watts()) + 1.19) *
                settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
               200.0) /
-             (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                            QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in kg
-                                                              //* 3.5) / 200 ) / 60
+             (60000.0 / ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in
+                                                              // watts +1.19) * body weight in kg * 3.5) / 200 ) / 60
     Distance += ((Speed.value() / 3600000.0) *
-                 ((double)lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime())));
+                 ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)));
 
     if (Cadence.value() > 0) {
         CrankRevs++;
         LastCrankEventTime += (uint16_t)(1024.0 / (((double)(Cadence.value())) / 60.0));
     }
 
-    lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
 #ifdef Q_OS_ANDROID
     if (settings.value(QZSettings::ant_heart, QZSettings::default_ant_heart).toBool())
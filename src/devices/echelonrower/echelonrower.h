@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "rower.h"
+#include "monotonicclock.h"
 
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
@@ -67,7 +68,7 @@ class echelonrower : public rower {
     uint8_t counterPoll = 1;
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
     uint8_t firstStateChanged = 0;
     int8_t lastResistanceBeforeDisconnection = -1;
 
@@ -237,7 +237,7 @@ void echelonstride::serviceDiscovered(const QBluetoothUuid &gatt) {
 double echelonstride::minStepInclination() { return 1.0; }
 
 void echelonstride::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
@@ -300,11 +300,10 @@ void echelonstride::characteristicChanged(const QLowEnergyCharacteristic &charac
                     1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastTimeCharacteristicChanged.msecsTo(
-                                now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(now - lastTimeCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                  // body weight in kg * 3.5) / 200 ) / 60
         Distance += ((Speed.value() / 3600.0) /
-                     (1000.0 / (lastTimeCharacteristicChanged.msecsTo(now))));
+                     (1000.0 / (now - lastTimeCharacteristicChanged)));
     }
 
     if ((uint8_t)newValue.at(1) == 0xD1 && newValue.length() > 11)
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "treadmill.h"
+#include "monotonicclock.h"
 
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
@@ -65,7 +66,7 @@ class echelonstride : public treadmill {
     uint8_t firstInit = 0;
     uint8_t counterPoll = 1;
     QByteArray lastPacket;
-    QDateTime lastTimeCharacteristicChanged;
+    qint64 lastTimeCharacteristicChanged = monotonicclock::msecs();
     bool firstCharacteristicChanged = true;
 
     int64_t lastStart = 0;
@@ -29,6 +29,7 @@
 #include <QString>
 
 #include "devices/bike.h"
+#include "monotonicclock.h"
 #include "devices/ftmsbike/ftmsbike.h"
 
 #ifdef Q_OS_IOS
@@ -58,7 +59,7 @@ class eliterizer : public bike {
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
     uint8_t firstStateChanged = 0;
 
     bool initDone = false;
@@ -2,12 +2,27 @@
 #include "devices/elliptical.h"
 #include <QSettings>
 
-elliptical::elliptical() {}
+elliptical::elliptical() {
+    commands()->setChannel(commandcoalescer::RESISTANCE, [this](double target) {
+        bool merged = requestResistance != -1;
+        requestResistance = target;
+        return merged;
+    });
+    // an incline takes seconds to move: it's sent the newest target at most twice per second
+    commands()->setChannel(
+        commandcoalescer::INCLINATION,
+        [this](double target) {
+            bool merged = requestInclination != -100;
+            requestInclination = target;
+            return merged;
+        },
+        500);
+}
 
 void elliptical::update_metrics(bool watt_calc, const double watts) {
 
-    QDateTime current = QDateTime::currentDateTime();
-    double deltaTime = (((double)_lastTimeUpdate.msecsTo(current)) / ((double)1000.0));
+    const qint64 current = monotonicclock::msecs();
+    double deltaTime = (((double)(current - _lastTimeUpdate)) / ((double)1000.0));
     QSettings settings;
     if (!_firstUpdate && !paused) {
         if (currentSpeed().value() > 0.0 || settings.value(QZSettings::continuous_moving, true).toBool()) {
@@ -76,7 +91,7 @@ double elliptical::speedFromWatts() {
 void elliptical::changeResistance(resistance_t resistance) {
     qDebug() << "changeResistance" << resistance;
     lastRawRequestedResistanceValue = resistance;
-    requestResistance = resistance + gears();
+    commands()->request(commandcoalescer::RESISTANCE, (resistance_t)(resistance + gears()));
     RequestedResistance = resistance + gears();
 }
 double elliptical::gears() { return m_gears; }
@@ -92,13 +107,13 @@ void elliptical::setGears(double gears) {
 void elliptical::changeInclination(double grade, double inclination) {
     qDebug() << "changeInclination" << grade << inclination;
     if (autoResistanceEnable) {
-        requestInclination = inclination;
+        commands()->request(commandcoalescer::INCLINATION, inclination, minStepInclination(), Inclination.value());
     }
 }
 double elliptical::currentCrankRevolutions() { return CrankRevs; }
 uint16_t elliptical::lastCrankEventTime() { return LastCrankEventTime; }
-metric elliptical::currentResistance() { return Resistance; }
-metric elliptical::currentInclination() { return Inclination; }
+const metric &elliptical::currentResistance() { return Resistance; }
+const metric &elliptical::currentInclination() { return Inclination; }
 uint8_t elliptical::fanSpeed() { return FanSpeed; }
 bool elliptical::connected() { return false; }
 
@@ -170,9 +185,9 @@ void elliptical::changeSpeed(double speed) {
     if (autoResistanceEnable)
         requestSpeed = speed;
 }
-metric elliptical::lastRequestedCadence() { return RequestedCadence; }
-metric elliptical::pelotonResistance() { return m_pelotonResistance; }
-metric elliptical::lastRequestedPelotonResistance() { return RequestedPelotonResistance; }
-metric elliptical::lastRequestedResistance() { return RequestedResistance; }
+const metric &elliptical::lastRequestedCadence() { return RequestedCadence; }
+const metric &elliptical::pelotonResistance() { return m_pelotonResistance; }
+const metric &elliptical::lastRequestedPelotonResistance() { return RequestedPelotonResistance; }
+const metric &elliptical::lastRequestedResistance() { return RequestedResistance; }
 bool elliptical::inclinationAvailableByHardware() { return true; }
 bool elliptical::inclinationSeparatedFromResistance() { return false; }
@@ -405,12 +405,12 @@ void eslinkertreadmill::characteristicChanged(const QLowEnergyCharacteristic &ch
                     1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastTimeCharacteristicChanged.msecsTo(
-                                QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(monotonicclock::msecs() - lastTimeCharacteristicChanged)))); //(( (0.048* Output
+                                                                  // in watts +1.19) * body weight in kg * 3.5) / 200 )
+                                                                  // / 60
 
         Distance += ((Speed.value() / 3600.0) /
-                     (1000.0 / (lastTimeCharacteristicChanged.msecsTo(QDateTime::currentDateTime()))));
+                     (1000.0 / (monotonicclock::msecs() - lastTimeCharacteristicChanged)));
     }
 
     cadenceFromAppleWatch();
@@ -421,7 +421,7 @@ void eslinkertreadmill::characteristicChanged(const QLowEnergyCharacteristic &ch
         qDebug() << QStringLiteral("QLowEnergyController ERROR!!") << m_control->errorString();
     }
 
-    lastTimeCharacteristicChanged = QDateTime::currentDateTime();
+    lastTimeCharacteristicChanged = monotonicclock::msecs();
     firstCharacteristicChanged = false;
 }
 
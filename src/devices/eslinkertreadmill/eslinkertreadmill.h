@@ -26,6 +26,7 @@
 #include <QObject>
 
 #include "treadmill.h"
+#include "monotonicclock.h"
 
 class eslinkertreadmill : public treadmill {
     Q_OBJECT
@@ -55,7 +56,7 @@ class eslinkertreadmill : public treadmill {
     uint8_t sec1Update = 0;
     uint8_t firstInit = 0;
     QByteArray lastPacket;
-    QDateTime lastTimeCharacteristicChanged;
+    qint64 lastTimeCharacteristicChanged = monotonicclock::msecs();
     bool firstCharacteristicChanged = true;
     uint8_t requestHandshake = 0;
     bool requestVar2 = false;
@@ -1,4 +1,5 @@
 #include "fakebike.h"
+#include "qzsettingssnapshot.h"
 #include "virtualdevices/virtualbike.h"
 
 #include <QBluetoothLocalDevice>
@@ -29,9 +30,7 @@ fakebike::fakebike(bool noWriteResistance, bool noHeartService, bool noVirtualDe
 }
 
 void fakebike::update() {
-    QSettings settings;
-    QString heartRateBeltName =
-        settings.value(QZSettings::heart_rate_belt_name, QZSettings::default_heart_rate_belt_name).toString();
+    const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
     /*
     static int updcou = 0;
     updcou++;
@@ -43,7 +42,7 @@ void fakebike::update() {
     else if (updcou > 6000)
         w = 80;
     Speed = metric::calculateSpeedFromPower(w, Inclination.value(),
-    Speed.value(),fabs(QDateTime::currentDateTime().msecsTo(Speed.lastChanged()) / 1000.0), speedLimit());
+    Speed.value(),Speed.msecsSinceLastChanged() / 1000.0, speedLimit());
     */
 
     if (requestPower != -1) {
@@ -56,9 +55,9 @@ void fakebike::update() {
         //         has a high inclination you have to give many power to get the desired playback speed,
         //         if inclination is very low little more power gives a quite high speed jump.
         // Speed = metric::calculateSpeedFromPower(m_watt.value(), Inclination.value(),
-        // Speed.value(),fabs(QDateTime::currentDateTime().msecsTo(Speed.lastChanged()) / 1000.0), speedLimit());
+        // Speed.value(),Speed.msecsSinceLastChanged() / 1000.0, speedLimit());
         Speed = metric::calculateSpeedFromPower(
-            m_watt.value(), 0, Speed.value(), fabs(QDateTime::currentDateTime().msecsTo(Speed.lastChanged()) / 1000.0),
+            m_watt.value(), 0, Speed.value(), Speed.msecsSinceLastChanged() / 1000.0,
             speedLimit());
     }
     
@@ -75,9 +74,10 @@ void fakebike::update() {
 
     update_metrics(false, watts());
 
+    const qint64 now = monotonicclock::msecs();
     Distance += ((Speed.value() / (double)3600.0) /
-                 ((double)1000.0 / (double)(lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime()))));
-    lastRefreshCharacteristicChanged = QDateTime::currentDateTime();    
+                 ((double)1000.0 / (double)(now - lastRefreshCharacteristicChanged)));
+    lastRefreshCharacteristicChanged = now;
 
     // ******************************************* virtual bike init *************************************
     if (!firstStateChanged && !this->hasVirtualDevice() && !noVirtualDevice
@@ -87,14 +87,11 @@ void fakebike::update() {
 #endif
 #endif
     ) {
-        bool virtual_device_enabled =
-            settings.value(QZSettings::virtual_device_enabled, QZSettings::default_virtual_device_enabled).toBool();
+        bool virtual_device_enabled = snapshot.virtual_device_enabled;
 #ifdef Q_OS_IOS
 #ifndef IO_UNDER_QT
-        bool cadence =
-            settings.value(QZSettings::bike_cadence_sensor, QZSettings::default_bike_cadence_sensor).toBool();
-        bool ios_peloton_workaround =
-            settings.value(QZSettings::ios_peloton_workaround, QZSettings::default_ios_peloton_workaround).toBool();
+        bool cadence = snapshot.bike_cadence_sensor;
+        bool ios_peloton_workaround = snapshot.ios_peloton_workaround;
         if (ios_peloton_workaround && cadence) {
             qDebug() << "ios_peloton_workaround activated!";
             h = new lockscreen();
@@ -117,20 +114,18 @@ void fakebike::update() {
 
     if (!noVirtualDevice) {
 #ifdef Q_OS_ANDROID
-        if (settings.value(QZSettings::ant_heart, QZSettings::default_ant_heart).toBool()) {
+        if (snapshot.ant_heart) {
             Heart = (uint8_t)KeepAwakeHelper::heart();
             debug("Current Heart: " + QString::number(Heart.value()));
         }
 #endif
-        if (heartRateBeltName.startsWith(QStringLiteral("Disabled"))) {
+        if (snapshot.heart_rate_belt_disabled) {
             update_hr_from_external();
         }
 #ifdef Q_OS_IOS
 #ifndef IO_UNDER_QT
-        bool cadence =
-            settings.value(QZSettings::bike_cadence_sensor, QZSettings::default_bike_cadence_sensor).toBool();
-        bool ios_peloton_workaround =
-            settings.value(QZSettings::ios_peloton_workaround, QZSettings::default_ios_peloton_workaround).toBool();
+        bool cadence = snapshot.bike_cadence_sensor;
+        bool ios_peloton_workaround = snapshot.ios_peloton_workaround;
         if (ios_peloton_workaround && cadence && h && firstStateChanged) {
             h->virtualbike_setCadence(currentCrankRevolutions(), lastCrankEventTime());
             h->virtualbike_setHeartRate((uint8_t)metrics_override_heartrate());
@@ -28,6 +28,7 @@
 #include <QString>
 
 #include "devices/bike.h"
+#include "monotonicclock.h"
 #include "ergtable.h"
 
 #ifdef Q_OS_IOS
@@ -48,7 +49,7 @@ class fakebike : public bike {
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
     QDateTime lastGoodCadence = QDateTime::currentDateTime();
     uint8_t firstStateChanged = 0;
 
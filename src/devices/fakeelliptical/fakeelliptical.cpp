@@ -40,8 +40,8 @@ void fakeelliptical::update() {
     }
 
     Distance += ((Speed.value() / (double)3600.0) /
-                 ((double)1000.0 / (double)(lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime()))));
-    lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+                 ((double)1000.0 / (double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)));
+    lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
     // ******************************************* virtual bike init *************************************
     if (!firstStateChanged && !this->hasVirtualDevice() && !noVirtualDevice
@@ -32,7 +32,7 @@ void faketreadmill::update() {
     QSettings settings;
     QString heartRateBeltName =
         settings.value(QZSettings::heart_rate_belt_name, QZSettings::default_heart_rate_belt_name).toString();
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     float _watts = watts(settings.value(QZSettings::weight, QZSettings::default_weight).toFloat());
 
     update_metrics(true, _watts);
@@ -54,7 +54,7 @@ void faketreadmill::update() {
     cadenceFromAppleWatch();
 
     Distance += ((Speed.value() / (double)3600.0) /
-                 ((double)1000.0 / (double)(lastRefreshCharacteristicChanged.msecsTo(now))));
+                 ((double)1000.0 / (double)(now - lastRefreshCharacteristicChanged)));
     lastRefreshCharacteristicChanged = now;
 
     // ******************************************* virtual treadmill init *************************************
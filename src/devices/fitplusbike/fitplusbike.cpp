@@ -401,7 +401,7 @@ void fitplusbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void fitplusbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -454,7 +454,7 @@ void fitplusbike::characteristicChanged(const QLowEnergyCharacteristic &characte
             } else {
                 Speed = metric::calculateSpeedFromPower(
                     watts(), Inclination.value(), Speed.value(),
-                    fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                    Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
             }
             index += 2;
             qDebug() << QStringLiteral("Current Speed: ") + QString::number(Speed.value());
@@ -550,9 +550,8 @@ void fitplusbike::characteristicChanged(const QLowEnergyCharacteristic &characte
                            settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                           200.0) /
                          (60000.0 /
-                          ((double)lastRefreshCharacteristicChanged.msecsTo(
-                              now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                // kg * 3.5) / 200 ) / 60
+                          ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                // body weight in kg * 3.5) / 200 ) / 60
         }
 
         qDebug() << (QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
@@ -646,7 +645,7 @@ void fitplusbike::characteristicChanged(const QLowEnergyCharacteristic &characte
             else*/
             Speed = metric::calculateSpeedFromPower(
                 watts(), Inclination.value(), Speed.value(),
-                fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
 
         } else if (newValue.length() == 13) {
 
@@ -674,7 +673,7 @@ void fitplusbike::characteristicChanged(const QLowEnergyCharacteristic &characte
         else
             Speed = metric::calculateSpeedFromPower(
                 watts(), Inclination.value(), Speed.value(),
-                fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
     }
 
     if (watts())
@@ -682,11 +681,10 @@ void fitplusbike::characteristicChanged(const QLowEnergyCharacteristic &characte
             ((((0.048 * ((double)watts()) + 1.19) *
                settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
               200.0) /
-             (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                            now)))); //(( (0.048* Output in watts +1.19) * body weight in kg
-                                                              //* 3.5) / 200 ) / 60
+             (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) * body
+                                                              // weight in kg * 3.5) / 200 ) / 60
     Distance += ((Speed.value() / 3600000.0) *
-                 ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                 ((double)(now - lastRefreshCharacteristicChanged)));
 
     if (Cadence.value() > 0) {
         CrankRevs++;
@@ -459,13 +459,13 @@ void fitshowtreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                                settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                               200.0) /
                              (60000.0 /
-                              ((double)lastTimeCharacteristicChanged.msecsTo(
-                                  QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                    // kg * 3.5) / 200 ) / 60
+                              ((double)(monotonicclock::msecs() - lastTimeCharacteristicChanged)))); //(( (0.048* Output
+                                                                    // in watts +1.19) * body weight in kg * 3.5) / 200
+                                                                    // ) / 60
                     DistanceCalculated +=
                         ((speed / 3600.0) /
-                         (1000.0 / (lastTimeCharacteristicChanged.msecsTo(QDateTime::currentDateTime()))));
-                    lastTimeCharacteristicChanged = QDateTime::currentDateTime();
+                         (1000.0 / (monotonicclock::msecs() - lastTimeCharacteristicChanged)));
+                    lastTimeCharacteristicChanged = monotonicclock::msecs();
                 }
 
                 StepCount = step_count;
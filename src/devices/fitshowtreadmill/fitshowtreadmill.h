@@ -27,6 +27,7 @@
 #include <QObject>
 
 #include "treadmill.h"
+#include "monotonicclock.h"
 #include "virtualdevices/virtualtreadmill.h"
 
 #ifdef Q_OS_IOS
@@ -109,7 +110,7 @@ class fitshowtreadmill : public treadmill {
     uint8_t firstInit = 0;
     double DistanceCalculated = 0;
     QByteArray lastPacket;
-    QDateTime lastTimeCharacteristicChanged;
+    qint64 lastTimeCharacteristicChanged = monotonicclock::msecs();
     bool firstCharacteristicChanged = true;
     int MAX_INCLINE = 30;
     int COUNTDOWN_VALUE = 0;
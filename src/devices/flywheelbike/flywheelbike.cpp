@@ -196,18 +196,17 @@ void flywheelbike::updateStats() {
             ((((0.048 * ((double)watts()) + 1.19) *
                settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
               200.0) /
-             (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                            QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in kg
-                                                              //* 3.5) / 200 ) / 60
+             (60000.0 / ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in
+                                                              // watts +1.19) * body weight in kg * 3.5) / 200 ) / 60
     Distance += ((Speed.value() / 3600000.0) *
-                 ((double)lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime())));
+                 ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)));
 
     if (Cadence.value() > 0) {
         CrankRevs++;
         LastCrankEventTime += (uint16_t)(1024.0 / (((double)(Cadence.value())) / 60.0));
     }
 
-    lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
     if (heartRateBeltName.startsWith(QStringLiteral("Disabled"))) {
         update_hr_from_external();
@@ -294,7 +293,7 @@ void flywheelbike::characteristicChanged(const QLowEnergyCharacteristic &charact
                 } else {
                     Speed = metric::calculateSpeedFromPower(
                         watts(), Inclination.value(), Speed.value(),
-                        fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                        Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
                 }
 
                 // https://www.facebook.com/groups/149984563348738/permalink/174268944253633/?comment_id=174366620910532&reply_comment_id=174666314213896
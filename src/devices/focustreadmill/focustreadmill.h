@@ -26,6 +26,7 @@
 #include <QObject>
 
 #include "treadmill.h"
+#include "monotonicclock.h"
 
 class focustreadmill : public treadmill {
     Q_OBJECT
@@ -55,7 +56,7 @@ class focustreadmill : public treadmill {
     uint8_t sec1Update = 0;
     uint8_t firstInit = 0;
     QByteArray lastPacket;
-    QDateTime lastTimeCharacteristicChanged;
+    qint64 lastTimeCharacteristicChanged = monotonicclock::msecs();
     bool firstCharacteristicChanged = true;
     bool searchStopped = false;
 
@@ -1,4 +1,7 @@
 #include "ftmsbike.h"
+#include "qzlog.h"
+#include "devices/ftmsdecoder.h"
+#include "qzsettingssnapshot.h"
 #include "virtualdevices/virtualbike.h"
 #include <QBluetoothLocalDevice>
 #include <QDateTime>
@@ -37,39 +40,21 @@ ftmsbike::ftmsbike(bool noWriteResistance, bool noHeartService, uint8_t bikeResi
 
 void ftmsbike::writeCharacteristic(uint8_t *data, uint8_t data_len, const QString &info, bool disable_log,
                                    bool wait_for_response) {
-    QEventLoop loop;
-    QTimer timeout;
-
     if(!gattFTMSService) {
-        qDebug() << QStringLiteral("gattFTMSService is null!");
+        qCDebug(qzBike) << QStringLiteral("gattFTMSService is null!");
         return;
     }
 
-    if (wait_for_response) {
-        connect(gattFTMSService, &QLowEnergyService::characteristicChanged, &loop, &QEventLoop::quit);
-        timeout.singleShot(300ms, &loop, &QEventLoop::quit);
-    } else {
-        connect(gattFTMSService, &QLowEnergyService::characteristicWritten, &loop, &QEventLoop::quit);
-        timeout.singleShot(300ms, &loop, &QEventLoop::quit);
-    }
-
-    if (writeBuffer) {
-        delete writeBuffer;
-    }
-    writeBuffer = new QByteArray((const char *)data, data_len);
-
-    if (gattWriteCharControlPointId.properties() & QLowEnergyCharacteristic::WriteNoResponse) {
-        gattFTMSService->writeCharacteristic(gattWriteCharControlPointId, *writeBuffer,
-                                             QLowEnergyService::WriteWithoutResponse);
-    } else {
-        gattFTMSService->writeCharacteristic(gattWriteCharControlPointId, *writeBuffer);
-    }
+    QByteArray buffer((const char *)data, data_len);
+    writeQueue()->write(gattFTMSService, gattWriteCharControlPointId, buffer,
+                        (gattWriteCharControlPointId.properties() & QLowEnergyCharacteristic::WriteNoResponse)
+                            ? QLowEnergyService::WriteWithoutResponse
+                            : QLowEnergyService::WriteWithResponse,
+                        wait_for_response);
 
     if (!disable_log) {
-        emit debug(QStringLiteral(" >> ") + writeBuffer->toHex(' ') + QStringLiteral(" // ") + info);
+        QZ_EMIT_DEBUG(qzBike, QStringLiteral(" >> ") + buffer.toHex(' ') + QStringLiteral(" // ") + info);
     }
-
-    loop.exec();
 }
 
 void ftmsbike::init() {
@@ -224,17 +209,14 @@ void ftmsbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
-    QSettings settings;
-    QString heartRateBeltName =
-        settings.value(QZSettings::heart_rate_belt_name, QZSettings::default_heart_rate_belt_name).toString();
-    bool disable_hr_frommachinery =
-        settings.value(QZSettings::heart_ignore_builtin, QZSettings::default_heart_ignore_builtin).toBool();
+    const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
+    bool disable_hr_frommachinery = snapshot.heart_ignore_builtin;
     bool heart = false;
 
-    qDebug() << characteristic.uuid() << newValue.length() << QStringLiteral(" << ") << newValue.toHex(' ');
+    qCDebug(qzBike) << characteristic.uuid() << newValue.length() << QStringLiteral(" << ") << newValue.toHex(' ');
 
     lastPacket = newValue;
 
@@ -242,105 +224,56 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
         resistance_received = true;
         Resistance = (double)(newValue.at(5));
         emit resistanceRead(Resistance.value());
-        emit debug(QStringLiteral("Current Resistance: ") + QString::number(Resistance.value()));
+        QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Resistance: ") + QString::number(Resistance.value()));
         return;
     }
 
     if (characteristic.uuid() == QBluetoothUuid((quint16)0x2AD2)) {
 
-        union flags {
-            struct {
-                uint16_t moreData : 1;
-                uint16_t avgSpeed : 1;
-                uint16_t instantCadence : 1;
-                uint16_t avgCadence : 1;
-                uint16_t totDistance : 1;
-                uint16_t resistanceLvl : 1;
-                uint16_t instantPower : 1;
-                uint16_t avgPower : 1;
-                uint16_t expEnergy : 1;
-                uint16_t heartRate : 1;
-                uint16_t metabolic : 1;
-                uint16_t elapsedTime : 1;
-                uint16_t remainingTime : 1;
-                uint16_t spare : 3;
-            };
-
-            uint16_t word_flags;
-        };
-
-        flags Flags;
-        int index = 0;
-        Flags.word_flags = (newValue.at(1) << 8) | newValue.at(0);
-        index += 2;
-
-        if (!Flags.moreData) {
-            if (!settings.value(QZSettings::speed_power_based, QZSettings::default_speed_power_based).toBool()) {
-                Speed = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                  (uint16_t)((uint8_t)newValue.at(index)))) /
-                        100.0;
+        ftmsdecoder::data ftms;
+        if (!ftmsdecoder::decode(ftmsdecoder::INDOOR_BIKE, newValue, ftms)) {
+            qCDebug(qzBike) << QStringLiteral("truncated indoor bike data, decoded") << ftms.length
+                            << QStringLiteral("bytes");
+        }
+
+        if (ftms.has(ftmsdecoder::INSTANT_SPEED)) {
+            if (!snapshot.speed_power_based) {
+                Speed = ftms.value(ftmsdecoder::INSTANT_SPEED);
             } else {
                 Speed = metric::calculateSpeedFromPower(
                     watts(), Inclination.value(), Speed.value(),
-                    fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
-            }
-            index += 2;
-            emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
-        }
-
-        if (Flags.avgSpeed) {
-            double avgSpeed;
-            avgSpeed = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                 (uint16_t)((uint8_t)newValue.at(index)))) /
-                       100.0;
-            index += 2;
-            emit debug(QStringLiteral("Current Average Speed: ") + QString::number(avgSpeed));
-        }
-
-        if (Flags.instantCadence) {
-            if (settings.value(QZSettings::cadence_sensor_name, QZSettings::default_cadence_sensor_name)
-                    .toString()
-                    .startsWith(QStringLiteral("Disabled"))) {
-                Cadence = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                    (uint16_t)((uint8_t)newValue.at(index)))) /
-                          2.0;
+                    Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
             }
-            index += 2;
-            emit debug(QStringLiteral("Current Cadence: ") + QString::number(Cadence.value()));
+            QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
         }
 
-        if (Flags.avgCadence) {
-            double avgCadence;
-            avgCadence = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                   (uint16_t)((uint8_t)newValue.at(index)))) /
-                         2.0;
-            index += 2;
-            emit debug(QStringLiteral("Current Average Cadence: ") + QString::number(avgCadence));
+        if (ftms.has(ftmsdecoder::AVG_SPEED)) {
+            QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Average Speed: ") +
+                                  QString::number(ftms.value(ftmsdecoder::AVG_SPEED)));
         }
 
-        if (Flags.totDistance) {
+        if (ftms.has(ftmsdecoder::INSTANT_CADENCE)) {
+            if (snapshot.cadence_sensor_disabled) {
+                Cadence = ftms.value(ftmsdecoder::INSTANT_CADENCE);
+            }
+            QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Cadence: ") + QString::number(Cadence.value()));
+        }
 
-            /*
-             * the distance sent from the most trainers is a total distance, so it's useless for QZ
-             *
-            Distance = ((double)((((uint32_t)((uint8_t)newValue.at(index + 2)) << 16) |
-                                  (uint32_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                 (uint32_t)((uint8_t)newValue.at(index)))) /
-                       1000.0;*/
-            index += 3;
+        if (ftms.has(ftmsdecoder::AVG_CADENCE)) {
+            QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Average Cadence: ") +
+                                  QString::number(ftms.value(ftmsdecoder::AVG_CADENCE)));
         }
 
+        // the distance sent from the most trainers is a total distance, so it's useless for QZ
         Distance += ((Speed.value() / 3600000.0) *
-                     ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                     ((double)(now - lastRefreshCharacteristicChanged)));
 
-        emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
+        QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
-        if (Flags.resistanceLvl) {
-            Resistance = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                   (uint16_t)((uint8_t)newValue.at(index))));
+        if (ftms.has(ftmsdecoder::RESISTANCE)) {
+            Resistance = ftms.value(ftmsdecoder::RESISTANCE);
             emit resistanceRead(Resistance.value());
-            index += 2;
-            emit debug(QStringLiteral("Current Resistance: ") + QString::number(Resistance.value()));
+            QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Resistance: ") + QString::number(Resistance.value()));
             resistance_received = true;
         }
             double ac = 0.01243107769;
@@ -358,186 +291,100 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
                                                       (ac * pow(Cadence.value(), 2.0) + bc * Cadence.value() + cc)))) -
                        br) /
                       (2.0 * ar)) *
-                     settings.value(QZSettings::peloton_gain, QZSettings::default_peloton_gain).toDouble()) +
-                    settings.value(QZSettings::peloton_offset, QZSettings::default_peloton_offset).toDouble();
+                     snapshot.peloton_gain) +
+                    snapshot.peloton_offset;
                 if (!resistance_received && !DU30_bike) {
                     Resistance = m_pelotonResistance;
                     emit resistanceRead(Resistance.value());
-                    emit debug(QStringLiteral("Current Resistance: ") + QString::number(Resistance.value()));
+                    QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Resistance: ") + QString::number(Resistance.value()));
                 }
             }
    
 
-        if (Flags.instantPower) {
+        if (ftms.has(ftmsdecoder::INSTANT_POWER)) {
             // power table from an user
             if(DU30_bike) {
                 m_watt = wattsFromResistance(Resistance.value());
-            } else if (settings.value(QZSettings::power_sensor_name, QZSettings::default_power_sensor_name)
-                    .toString()
-                    .startsWith(QStringLiteral("Disabled")))
-                m_watt = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                   (uint16_t)((uint8_t)newValue.at(index))));
-            index += 2;
-            emit debug(QStringLiteral("Current Watt: ") + QString::number(m_watt.value()));
+            } else if (snapshot.power_sensor_disabled)
+                m_watt = ftms.value(ftmsdecoder::INSTANT_POWER);
+            QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Watt: ") + QString::number(m_watt.value()));
         }
 
-        if (Flags.avgPower && newValue.length() > index + 1) {
-            double avgPower;
-            avgPower = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                 (uint16_t)((uint8_t)newValue.at(index))));
-            index += 2;
-            emit debug(QStringLiteral("Current Average Watt: ") + QString::number(avgPower));
+        if (ftms.has(ftmsdecoder::AVG_POWER)) {
+            QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Average Watt: ") +
+                                  QString::number(ftms.value(ftmsdecoder::AVG_POWER)));
         }
 
-        if (Flags.expEnergy && newValue.length() > index + 1) {
-            KCal = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                             (uint16_t)((uint8_t)newValue.at(index))));
-            index += 2;
-
-            // energy per hour
-            index += 2;
-
-            // energy per minute
-            index += 1;
+        if (ftms.has(ftmsdecoder::TOTAL_ENERGY)) {
+            KCal = ftms.value(ftmsdecoder::TOTAL_ENERGY);
         } else {
             if (watts())
                 KCal += ((((0.048 * ((double)watts()) + 1.19) *
-                           settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
+                           snapshot.weight * 3.5) /
                           200.0) /
                          (60000.0 /
-                          ((double)lastRefreshCharacteristicChanged.msecsTo(
-                              now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                // kg * 3.5) / 200 ) / 60
+                          ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                // body weight in kg * 3.5) / 200 ) / 60
         }
 
-        emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
+        QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
 
 #ifdef Q_OS_ANDROID
-        if (settings.value(QZSettings::ant_heart, QZSettings::default_ant_heart).toBool())
+        if (snapshot.ant_heart)
             Heart = (uint8_t)KeepAwakeHelper::heart();
         else
 #endif
         {
-            if (Flags.heartRate && !disable_hr_frommachinery && newValue.length() > index) {
-                Heart = ((double)(((uint8_t)newValue.at(index))));
-                // index += 1; // NOTE: clang-analyzer-deadcode.DeadStores
-                emit debug(QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
-            } else {
-                Flags.heartRate = false;
+            heart = ftms.has(ftmsdecoder::HEART_RATE) && !disable_hr_frommachinery;
+            if (heart) {
+                Heart = ftms.value(ftmsdecoder::HEART_RATE);
+                QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
             }
-            heart = Flags.heartRate;
-        }
-
-        if (Flags.metabolic) {
-            // todo
         }
+    } else if (characteristic.uuid() == QBluetoothUuid((quint16)0x2ACE)) {
 
-        if (Flags.elapsedTime) {
-            // todo
+        ftmsdecoder::data ftms;
+        if (!ftmsdecoder::decode(ftmsdecoder::CROSS_TRAINER, newValue, ftms)) {
+            qCDebug(qzBike) << QStringLiteral("truncated cross trainer data, decoded") << ftms.length
+                            << QStringLiteral("bytes");
         }
 
-        if (Flags.remainingTime) {
-            // todo
-        }
-    } else if (characteristic.uuid() == QBluetoothUuid((quint16)0x2ACE)) {
-        union flags {
-            struct {
-                uint32_t moreData : 1;
-                uint32_t avgSpeed : 1;
-                uint32_t totDistance : 1;
-                uint32_t stepCount : 1;
-                uint32_t strideCount : 1;
-                uint32_t elevationGain : 1;
-                uint32_t rampAngle : 1;
-                uint32_t resistanceLvl : 1;
-                uint32_t instantPower : 1;
-                uint32_t avgPower : 1;
-                uint32_t expEnergy : 1;
-                uint32_t heartRate : 1;
-                uint32_t metabolicEq : 1;
-                uint32_t elapsedTime : 1;
-                uint32_t remainingTime : 1;
-                uint32_t movementDirection : 1;
-                uint32_t spare : 8;
-            };
-
-            uint32_t word_flags;
-        };
-
-        flags Flags;
-        int index = 0;
-        Flags.word_flags = (newValue.at(2) << 16) | (newValue.at(1) << 8) | newValue.at(0);
-        index += 3;
-
-        if (!Flags.moreData) {
-            if (!settings.value(QZSettings::speed_power_based, QZSettings::default_speed_power_based).toBool()) {
-                Speed = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                  (uint16_t)((uint8_t)newValue.at(index)))) /
-                        100.0;
+        if (ftms.has(ftmsdecoder::INSTANT_SPEED)) {
+            if (!snapshot.speed_power_based) {
+                Speed = ftms.value(ftmsdecoder::INSTANT_SPEED);
             } else {
                 Speed = metric::calculateSpeedFromPower(
                     watts(), Inclination.value(), Speed.value(),
-                    fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                    Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
             }
-            emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
-            index += 2;
+            QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
         }
 
-        if (Flags.avgSpeed) {
-            double avgSpeed;
-            avgSpeed = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                 (uint16_t)((uint8_t)newValue.at(index)))) /
-                       100.0;
-            index += 2;
-            emit debug(QStringLiteral("Current Average Speed: ") + QString::number(avgSpeed));
+        if (ftms.has(ftmsdecoder::AVG_SPEED)) {
+            QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Average Speed: ") +
+                                  QString::number(ftms.value(ftmsdecoder::AVG_SPEED)));
         }
 
-        if (Flags.totDistance) {
-            Distance = ((double)((((uint32_t)((uint8_t)newValue.at(index + 2)) << 16) |
-                                  (uint32_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                 (uint32_t)((uint8_t)newValue.at(index)))) /
-                       1000.0;
-            index += 3;
+        if (ftms.has(ftmsdecoder::TOTAL_DISTANCE)) {
+            Distance = ftms.value(ftmsdecoder::TOTAL_DISTANCE) / 1000.0;
         } else {
             Distance += ((Speed.value() / 3600000.0) *
-                         ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                         ((double)(now - lastRefreshCharacteristicChanged)));
         }
 
-        emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
+        QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
-        if (Flags.stepCount) {
-            if (settings.value(QZSettings::cadence_sensor_name, QZSettings::default_cadence_sensor_name)
-                    .toString()
-                    .startsWith(QStringLiteral("Disabled"))) {
-                Cadence = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                    (uint16_t)((uint8_t)newValue.at(index))));
+        if (ftms.has(ftmsdecoder::STEP_RATE)) {
+            if (snapshot.cadence_sensor_disabled) {
+                Cadence = ftms.value(ftmsdecoder::STEP_RATE);
             }
-            emit debug(QStringLiteral("Current Cadence: ") + QString::number(Cadence.value()));
-
-            index += 2;
-            index += 2;
+            QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Cadence: ") + QString::number(Cadence.value()));
         }
 
-        if (Flags.strideCount) {
-            index += 2;
-        }
-
-        if (Flags.elevationGain) {
-            index += 2;
-            index += 2;
-        }
-
-        if (Flags.rampAngle) {
-            index += 2;
-            index += 2;
-        }
-
-        if (Flags.resistanceLvl) {
-            Resistance = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                   (uint16_t)((uint8_t)newValue.at(index))));
+        if (ftms.has(ftmsdecoder::RESISTANCE)) {
+            Resistance = ftms.value(ftmsdecoder::RESISTANCE);
             emit resistanceRead(Resistance.value());
-            index += 2;
-            emit debug(QStringLiteral("Current Resistance: ") + QString::number(Resistance.value()));
+            QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Resistance: ") + QString::number(Resistance.value()));
         } else if(!DU30_bike) {
             double ac = 0.01243107769;
             double bc = 1.145964912;
@@ -554,80 +401,49 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
                                                       (ac * pow(Cadence.value(), 2.0) + bc * Cadence.value() + cc)))) -
                        br) /
                       (2.0 * ar)) *
-                     settings.value(QZSettings::peloton_gain, QZSettings::default_peloton_gain).toDouble()) +
-                    settings.value(QZSettings::peloton_offset, QZSettings::default_peloton_offset).toDouble();
+                     snapshot.peloton_gain) +
+                    snapshot.peloton_offset;
                 Resistance = m_pelotonResistance;
                 emit resistanceRead(Resistance.value());
             }
         }
 
-        if (Flags.instantPower) {
-            if (settings.value(QZSettings::power_sensor_name, QZSettings::default_power_sensor_name)
-                    .toString()
-                    .startsWith(QStringLiteral("Disabled")))
-                m_watt = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                   (uint16_t)((uint8_t)newValue.at(index))));
-            emit debug(QStringLiteral("Current Watt: ") + QString::number(m_watt.value()));
-            index += 2;
+        if (ftms.has(ftmsdecoder::INSTANT_POWER)) {
+            if (snapshot.power_sensor_disabled)
+                m_watt = ftms.value(ftmsdecoder::INSTANT_POWER);
+            QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Watt: ") + QString::number(m_watt.value()));
         }
 
-        if (Flags.avgPower && newValue.length() > index + 1) {
-            double avgPower;
-            avgPower = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                 (uint16_t)((uint8_t)newValue.at(index))));
-            emit debug(QStringLiteral("Current Average Watt: ") + QString::number(avgPower));
-            index += 2;
+        if (ftms.has(ftmsdecoder::AVG_POWER)) {
+            QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Average Watt: ") +
+                                  QString::number(ftms.value(ftmsdecoder::AVG_POWER)));
         }
 
-        if (Flags.expEnergy && newValue.length() > index + 1) {
-            KCal = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                             (uint16_t)((uint8_t)newValue.at(index))));
-            index += 2;
-
-            // energy per hour
-            index += 2;
-
-            // energy per minute
-            index += 1;
+        if (ftms.has(ftmsdecoder::TOTAL_ENERGY)) {
+            KCal = ftms.value(ftmsdecoder::TOTAL_ENERGY);
         } else {
             if (watts())
                 KCal += ((((0.048 * ((double)watts()) + 1.19) *
-                           settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
+                           snapshot.weight * 3.5) /
                           200.0) /
                          (60000.0 /
-                          ((double)lastRefreshCharacteristicChanged.msecsTo(
-                              now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                // kg * 3.5) / 200 ) / 60
+                          ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                // body weight in kg * 3.5) / 200 ) / 60
         }
 
-        emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
+        QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
 
 #ifdef Q_OS_ANDROID
-        if (settings.value(QZSettings::ant_heart, QZSettings::default_ant_heart).toBool())
+        if (snapshot.ant_heart)
             Heart = (uint8_t)KeepAwakeHelper::heart();
         else
 #endif
         {
-            if (Flags.heartRate && !disable_hr_frommachinery && newValue.length() > index) {
-                Heart = ((double)(((uint8_t)newValue.at(index))));
-                // index += 1; // NOTE: clang-analyzer-deadcode.DeadStores
-                emit debug(QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
-            } else {
-                Flags.heartRate = false;
+            heart = ftms.has(ftmsdecoder::HEART_RATE) && !disable_hr_frommachinery;
+            if (heart) {
+                Heart = ftms.value(ftmsdecoder::HEART_RATE);
+                QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
             }
-            heart = Flags.heartRate;
-        }
-
-        if (Flags.metabolicEq) {
-            // todo
-        }
-
-        if (Flags.elapsedTime) {
-            // todo
-        }
-
-        if (Flags.remainingTime) {
-            // todo
         }
     } else {
         return;
@@ -640,16 +456,15 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
 
     lastRefreshCharacteristicChanged = now;
 
-    if (heartRateBeltName.startsWith(QStringLiteral("Disabled")) &&
+    if (snapshot.heart_rate_belt_disabled &&
         (!heart || Heart.value() == 0 || disable_hr_frommachinery)) {
         update_hr_from_external();
     }
 
 #ifdef Q_OS_IOS
 #ifndef IO_UNDER_QT
-    bool cadence = settings.value(QZSettings::bike_cadence_sensor, QZSettings::default_bike_cadence_sensor).toBool();
-    bool ios_peloton_workaround =
-        settings.value(QZSettings::ios_peloton_workaround, QZSettings::default_ios_peloton_workaround).toBool();
+    bool cadence = snapshot.bike_cadence_sensor;
+    bool ios_peloton_workaround = snapshot.ios_peloton_workaround;
     if (ios_peloton_workaround && cadence && h && firstStateChanged) {
         h->virtualbike_setCadence(currentCrankRevolutions(), lastCrankEventTime());
         h->virtualbike_setHeartRate((uint8_t)metrics_override_heartrate());
@@ -657,12 +472,14 @@ void ftmsbike::characteristicChanged(const QLowEnergyCharacteristic &characteris
 #endif
 #endif
 
-    emit debug(QStringLiteral("Current CrankRevs: ") + QString::number(CrankRevs));
-    emit debug(QStringLiteral("Last CrankEventTime: ") + QString::number(LastCrankEventTime));
+    QZ_EMIT_DEBUG(qzBike, QStringLiteral("Current CrankRevs: ") + QString::number(CrankRevs));
+    QZ_EMIT_DEBUG(qzBike, QStringLiteral("Last CrankEventTime: ") + QString::number(LastCrankEventTime));
 
     if (m_control->error() != QLowEnergyController::NoError) {
-        qDebug() << QStringLiteral("QLowEnergyController ERROR!!") << m_control->errorString();
+        qCDebug(qzBike) << QStringLiteral("QLowEnergyController ERROR!!") << m_control->errorString();
     }
+
+    emit metricsUpdated();
 }
 
 void ftmsbike::stateChanged(QLowEnergyService::ServiceState state) {
@@ -807,18 +624,19 @@ void ftmsbike::stateChanged(QLowEnergyService::ServiceState state) {
 void ftmsbike::ftmsCharacteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
 
     if (!autoResistance()) {
-        qDebug() << "ignoring routing FTMS packet to the bike from virtualbike because of auto resistance OFF"
-                 << characteristic.uuid() << newValue.toHex(' ');
+        qCDebug(qzBike) << "ignoring routing FTMS packet to the bike from virtualbike because of auto resistance OFF"
+                        << characteristic.uuid() << newValue.toHex(' ');
         return;
     }
 
     QByteArray b = newValue;
     if (gattWriteCharControlPointId.isValid()) {
-        qDebug() << "routing FTMS packet to the bike from virtualbike" << characteristic.uuid() << newValue.toHex(' ');
+        qCDebug(qzBike) << "routing FTMS packet to the bike from virtualbike" << characteristic.uuid()
+                        << newValue.toHex(' ');
 
         // handling gears
         if (b.at(0) == FTMS_SET_INDOOR_BIKE_SIMULATION_PARAMS) {
-            qDebug() << "applying gears mod" << m_gears;
+            qCDebug(qzBike) << "applying gears mod" << m_gears;
             int16_t slope = (((uint8_t)b.at(3)) + (b.at(4) << 8));
             if (m_gears != 0) {
                 slope += (m_gears * 50);
@@ -827,12 +645,7 @@ void ftmsbike::ftmsCharacteristicChanged(const QLowEnergyCharacteristic &charact
             }
         }
 
-        if (writeBuffer) {
-            delete writeBuffer;
-        }
-        writeBuffer = new QByteArray(b);
-
-        gattFTMSService->writeCharacteristic(gattWriteCharControlPointId, *writeBuffer);
+        writeQueue()->write(gattFTMSService, gattWriteCharControlPointId, b);
     }
 }
 
@@ -849,7 +662,7 @@ void ftmsbike::descriptorRead(const QLowEnergyDescriptor &descriptor, const QByt
 
 void ftmsbike::characteristicWritten(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
     Q_UNUSED(characteristic);
-    emit debug(QStringLiteral("characteristicWritten ") + newValue.toHex(' '));
+    QZ_EMIT_DEBUG(qzBike, QStringLiteral("characteristicWritten ") + newValue.toHex(' '));
 }
 
 void ftmsbike::characteristicRead(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
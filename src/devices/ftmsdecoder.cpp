@@ -0,0 +1,240 @@
+#include "devices/ftmsdecoder.h"
+
+namespace {
+
+struct fielddescriptor {
+    // the bit of the flags selecting the field
+    quint8 flag;
+    // the field is present when the flag is cleared (the "more data" bit of the instantaneous fields)
+    bool inverted;
+    ftmsdecoder::FIELD field;
+    quint8 size;
+    bool isSigned;
+    double resolution;
+};
+
+struct layout {
+    int flagBytes;
+    const fielddescriptor *fields;
+    int count;
+};
+
+const fielddescriptor indoorBikeFields[] = {
+    {0, true, ftmsdecoder::INSTANT_SPEED, 2, false, 0.01},
+    {1, false, ftmsdecoder::AVG_SPEED, 2, false, 0.01},
+    {2, false, ftmsdecoder::INSTANT_CADENCE, 2, false, 0.5},
+    {3, false, ftmsdecoder::AVG_CADENCE, 2, false, 0.5},
+    {4, false, ftmsdecoder::TOTAL_DISTANCE, 3, false, 1},
+    {5, false, ftmsdecoder::RESISTANCE, 2, true, 1},
+    {6, false, ftmsdecoder::INSTANT_POWER, 2, true, 1},
+    {7, false, ftmsdecoder::AVG_POWER, 2, true, 1},
+    {8, false, ftmsdecoder::TOTAL_ENERGY, 2, false, 1},
+    {8, false, ftmsdecoder::ENERGY_PER_HOUR, 2, false, 1},
+    {8, false, ftmsdecoder::ENERGY_PER_MINUTE, 1, false, 1},
+    {9, false, ftmsdecoder::HEART_RATE, 1, false, 1},
+    {10, false, ftmsdecoder::METABOLIC_EQUIVALENT, 1, false, 0.1},
+    {11, false, ftmsdecoder::ELAPSED_TIME, 2, false, 1},
+    {12, false, ftmsdecoder::REMAINING_TIME, 2, false, 1},
+};
+
+const fielddescriptor treadmillFields[] = {
+    {0, true, ftmsdecoder::INSTANT_SPEED, 2, false, 0.01},
+    {1, false, ftmsdecoder::AVG_SPEED, 2, false, 0.01},
+    {2, false, ftmsdecoder::TOTAL_DISTANCE, 3, false, 1},
+    {3, false, ftmsdecoder::INCLINATION, 2, true, 0.1},
+    {3, false, ftmsdecoder::RAMP_ANGLE, 2, true, 0.1},
+    {4, false, ftmsdecoder::POSITIVE_ELEVATION, 2, false, 0.1},
+    {4, false, ftmsdecoder::NEGATIVE_ELEVATION, 2, false, 0.1},
+    {5, false, ftmsdecoder::INSTANT_PACE, 1, false, 0.1},
+    {6, false, ftmsdecoder::AVG_PACE, 1, false, 0.1},
+    {7, false, ftmsdecoder::TOTAL_ENERGY, 2, false, 1},
+    {7, false, ftmsdecoder::ENERGY_PER_HOUR, 2, false, 1},
+    {7, false, ftmsdecoder::ENERGY_PER_MINUTE, 1, false, 1},
+    {8, false, ftmsdecoder::HEART_RATE, 1, false, 1},
+    {9, false, ftmsdecoder::METABOLIC_EQUIVALENT, 1, false, 0.1},
+    {10, false, ftmsdecoder::ELAPSED_TIME, 2, false, 1},
+    {11, false, ftmsdecoder::REMAINING_TIME, 2, false, 1},
+    {12, false, ftmsdecoder::FORCE_ON_BELT, 2, true, 1},
+    {12, false, ftmsdecoder::POWER_OUTPUT, 2, true, 1},
+};
+
+const fielddescriptor rowerFields[] = {
+    {0, true, ftmsdecoder::STROKE_RATE, 1, false, 0.5},
+    {0, true, ftmsdecoder::STROKE_COUNT, 2, false, 1},
+    {1, false, ftmsdecoder::AVG_STROKE_RATE, 1, false, 0.5},
+    {2, false, ftmsdecoder::TOTAL_DISTANCE, 3, false, 1},
+    {3, false, ftmsdecoder::INSTANT_PACE, 2, false, 1},
+    {4, false, ftmsdecoder::AVG_PACE, 2, false, 1},
+    {5, false, ftmsdecoder::INSTANT_POWER, 2, true, 1},
+    {6, false, ftmsdecoder::AVG_POWER, 2, true, 1},
+    {7, false, ftmsdecoder::RESISTANCE, 2, true, 1},
+    {8, false, ftmsdecoder::TOTAL_ENERGY, 2, false, 1},
+    {8, false, ftmsdecoder::ENERGY_PER_HOUR, 2, false, 1},
+    {8, false, ftmsdecoder::ENERGY_PER_MINUTE, 1, false, 1},
+    {9, false, ftmsdecoder::HEART_RATE, 1, false, 1},
+    {10, false, ftmsdecoder::METABOLIC_EQUIVALENT, 1, false, 0.1},
+    {11, false, ftmsdecoder::ELAPSED_TIME, 2, false, 1},
+    {12, false, ftmsdecoder::REMAINING_TIME, 2, false, 1},
+};
+
+// bit 15 is the movement direction, a flag without a field
+const fielddescriptor crossTrainerFields[] = {
+    {0, true, ftmsdecoder::INSTANT_SPEED, 2, false, 0.01},
+    {1, false, ftmsdecoder::AVG_SPEED, 2, false, 0.01},
+    {2, false, ftmsdecoder::TOTAL_DISTANCE, 3, false, 1},
+    {3, false, ftmsdecoder::STEP_RATE, 2, false, 1},
+    {3, false, ftmsdecoder::AVG_STEP_RATE, 2, false, 1},
+    {4, false, ftmsdecoder::STRIDE_COUNT, 2, false, 0.1},
+    {5, false, ftmsdecoder::POSITIVE_ELEVATION, 2, false, 1},
+    {5, false, ftmsdecoder::NEGATIVE_ELEVATION, 2, false, 1},
+    {6, false, ftmsdecoder::INCLINATION, 2, true, 0.1},
+    {6, false, ftmsdecoder::RAMP_ANGLE, 2, true, 0.1},
+    {7, false, ftmsdecoder::RESISTANCE, 2, true, 1},
+    {8, false, ftmsdecoder::INSTANT_POWER, 2, true, 1},
+    {9, false, ftmsdecoder::AVG_POWER, 2, true, 1},
+    {10, false, ftmsdecoder::TOTAL_ENERGY, 2, false, 1},
+    {10, false, ftmsdecoder::ENERGY_PER_HOUR, 2, false, 1},
+    {10, false, ftmsdecoder::ENERGY_PER_MINUTE, 1, false, 1},
+    {11, false, ftmsdecoder::HEART_RATE, 1, false, 1},
+    {12, false, ftmsdecoder::METABOLIC_EQUIVALENT, 1, false, 0.1},
+    {13, false, ftmsdecoder::ELAPSED_TIME, 2, false, 1},
+    {14, false, ftmsdecoder::REMAINING_TIME, 2, false, 1},
+};
+
+#define FTMS_LAYOUT(flagBytes, fields) {flagBytes, fields, int(sizeof(fields) / sizeof(fields[0]))}
+
+const layout layouts[ftmsdecoder::TYPES] = {
+    FTMS_LAYOUT(2, indoorBikeFields),
+    FTMS_LAYOUT(2, treadmillFields),
+    FTMS_LAYOUT(2, rowerFields),
+    FTMS_LAYOUT(3, crossTrainerFields),
+};
+
+struct parameterdescriptor {
+    quint8 size;
+    bool isSigned;
+    double resolution;
+};
+
+struct controlpointlayout {
+    quint8 opcode;
+    int count;
+    parameterdescriptor params[4];
+};
+
+const controlpointlayout controlPointLayouts[] = {
+    {0x02, 1, {{2, false, 0.01}}},                                               // target speed, km/h
+    {0x03, 1, {{2, true, 0.1}}},                                                 // target inclination, %
+    {0x04, 1, {{1, false, 0.1}}},                                                // target resistance level
+    {0x05, 1, {{2, true, 1}}},                                                   // target power, W
+    {0x06, 1, {{1, false, 1}}},                                                  // target heart rate, bpm
+    {0x08, 1, {{1, false, 1}}},                                                  // stop (1) or pause (2)
+    {0x09, 1, {{2, false, 1}}},                                                  // targeted expended energy, kcal
+    {0x0A, 1, {{2, false, 1}}},                                                  // targeted steps
+    {0x0B, 1, {{2, false, 1}}},                                                  // targeted strides
+    {0x0C, 1, {{3, false, 1}}},                                                  // targeted distance, m
+    {0x0D, 1, {{2, false, 1}}},                                                  // targeted time, s
+    {0x11, 4, {{2, true, 0.001}, {2, true, 0.01}, {1, false, 0.0001}, {1, false, 0.01}}}, // wind m/s, grade %, crr, cw
+    {0x12, 1, {{2, false, 0.1}}},                                                // wheel circumference, mm
+    {0x13, 1, {{1, false, 1}}},                                                  // spin down: start (1) or ignore (2)
+    {0x14, 1, {{2, false, 0.5}}},                                                // targeted cadence, rpm
+};
+
+inline qint32 readLittleEndian(const uchar *p, int size, bool isSigned) {
+    quint32 v = 0;
+    for (int i = 0; i < size; i++) {
+        v |= quint32(p[i]) << (8 * i);
+    }
+    if (isSigned && size < 4 && (v & (1u << (8 * size - 1)))) {
+        v |= ~0u << (8 * size);
+    }
+    return qint32(v);
+}
+
+} // namespace
+
+bool ftmsdecoder::decode(TYPE type, const char *value, int length, data &out) {
+    const layout &l = layouts[type];
+    const uchar *p = reinterpret_cast<const uchar *>(value);
+    out.type = type;
+    out.flags = 0;
+    out.present = 0;
+    out.truncated = false;
+
+    if (length < l.flagBytes) {
+        out.length = 0;
+        out.truncated = true;
+        return false;
+    }
+    out.flags = quint32(readLittleEndian(p, l.flagBytes, false));
+
+    int index = l.flagBytes;
+    for (const fielddescriptor *f = l.fields; f != l.fields + l.count; f++) {
+        bool set = (out.flags >> f->flag) & 1;
+        if (set == f->inverted) {
+            continue;
+        }
+        if (index + f->size > length) {
+            out.truncated = true;
+            break;
+        }
+        qint32 raw = readLittleEndian(p + index, f->size, f->isSigned);
+        out.raw[f->field] = raw;
+        out.values[f->field] = raw * f->resolution;
+        out.present |= Q_UINT64_C(1) << f->field;
+        index += f->size;
+    }
+    out.length = index;
+    return !out.truncated;
+}
+
+bool ftmsdecoder::typeOf(quint16 uuid, TYPE &type) {
+    switch (uuid) {
+    case 0x2AD2:
+        type = INDOOR_BIKE;
+        return true;
+    case 0x2ACD:
+        type = TREADMILL;
+        return true;
+    case 0x2AD1:
+        type = ROWER;
+        return true;
+    case 0x2ACE:
+        type = CROSS_TRAINER;
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool ftmsdecoder::decodeControlPoint(const QByteArray &value, controlpoint &out) {
+    out.opcode = 0;
+    out.params = 0;
+    out.truncated = false;
+    if (value.isEmpty()) {
+        out.truncated = true;
+        return false;
+    }
+
+    const uchar *p = reinterpret_cast<const uchar *>(value.constData());
+    out.opcode = p[0];
+    for (const controlpointlayout &l : controlPointLayouts) {
+        if (l.opcode != out.opcode) {
+            continue;
+        }
+        int index = 1;
+        for (int i = 0; i < l.count; i++) {
+            const parameterdescriptor &d = l.params[i];
+            if (index + d.size > value.length()) {
+                out.truncated = true;
+                return false;
+            }
+            out.raw[i] = readLittleEndian(p + index, d.size, d.isSigned);
+            out.values[i] = out.raw[i] * d.resolution;
+            out.params++;
+            index += d.size;
+        }
+        break;
+    }
+    return true;
+}
@@ -0,0 +1,112 @@
+#ifndef FTMSDECODER_H
+#define FTMSDECODER_H
+
+#include <QByteArray>
+#include <QtGlobal>
+
+/**
+ * @brief Decodes the FTMS data characteristics (indoor bike 0x2AD2, treadmill 0x2ACD, rower 0x2AD1, cross trainer
+ * 0x2ACE) and the requests written to the control point 0x2AD9.
+ *
+ * Every characteristic is a flags field followed by the fields the flags select, in a fixed order: the order, the
+ * sizes and the resolutions are declared in one table for each characteristic and decoded by the same loop, reading
+ * the bytes of the QByteArray in place, into a plain struct with a presence bit for every field. Nothing is allocated,
+ * so it's cheap enough for every notification.
+ *
+ * A field is present only if its flag is set and all its bytes are in the packet: the decoding stops at the first
+ * truncated field and the packet is reported as truncated, the fields before it are still valid.
+ */
+class ftmsdecoder {
+
+  public:
+    enum TYPE { INDOOR_BIKE = 0, TREADMILL, ROWER, CROSS_TRAINER, TYPES };
+
+    enum FIELD {
+        INSTANT_SPEED = 0,    // km/h
+        AVG_SPEED,            // km/h
+        INSTANT_CADENCE,      // rpm
+        AVG_CADENCE,          // rpm
+        TOTAL_DISTANCE,       // m
+        RESISTANCE,           // unitless
+        INSTANT_POWER,        // W
+        AVG_POWER,            // W
+        TOTAL_ENERGY,         // kcal
+        ENERGY_PER_HOUR,      // kcal
+        ENERGY_PER_MINUTE,    // kcal
+        HEART_RATE,           // bpm
+        METABOLIC_EQUIVALENT, // MET
+        ELAPSED_TIME,         // s
+        REMAINING_TIME,       // s
+        INCLINATION,          // %
+        RAMP_ANGLE,           // degrees
+        POSITIVE_ELEVATION,   // m
+        NEGATIVE_ELEVATION,   // m
+        INSTANT_PACE,         // km/min on a treadmill, s/500m on a rower
+        AVG_PACE,             // as INSTANT_PACE
+        STROKE_RATE,          // strokes per minute
+        STROKE_COUNT,
+        AVG_STROKE_RATE,      // strokes per minute
+        STEP_RATE,            // steps per minute
+        AVG_STEP_RATE,        // steps per minute
+        STRIDE_COUNT,
+        FORCE_ON_BELT,        // N
+        POWER_OUTPUT,         // W
+        FIELDS
+    };
+
+    struct data {
+        TYPE type = INDOOR_BIKE;
+        quint32 flags = 0;
+        quint64 present = 0;
+        // the bytes decoded, flags included
+        int length = 0;
+        bool truncated = false;
+        qint32 raw[FIELDS];
+        double values[FIELDS];
+
+        bool has(FIELD f) const { return present & (Q_UINT64_C(1) << f); }
+        // the value in the unit of the field, 0 if not present
+        double value(FIELD f) const { return has(f) ? values[f] : 0.0; }
+        // the value as sent, before the resolution is applied, 0 if not present
+        qint32 rawValue(FIELD f) const { return has(f) ? raw[f] : 0; }
+    };
+
+    /**
+     * @brief A request written to the fitness machine control point.
+     */
+    struct controlpoint {
+        quint8 opcode = 0;
+        // the parameters of the opcode, in the order of the specification
+        int params = 0;
+        bool truncated = false;
+        qint32 raw[4];
+        double values[4];
+
+        // the parameter in its unit, 0 if missing
+        double value(int i) const { return i < params ? values[i] : 0.0; }
+        qint32 rawValue(int i) const { return i < params ? raw[i] : 0; }
+    };
+
+    /**
+     * @brief Decodes a data characteristic.
+     * @return false if the packet is truncated.
+     */
+    static bool decode(TYPE type, const char *value, int length, data &out);
+    static bool decode(TYPE type, const QByteArray &value, data &out) {
+        return decode(type, value.constData(), value.length(), out);
+    }
+
+    /**
+     * @brief The type of a data characteristic.
+     * @return false if the uuid isn't an FTMS data characteristic.
+     */
+    static bool typeOf(quint16 uuid, TYPE &type);
+
+    /**
+     * @brief Decodes a request to the control point. An opcode without parameters, or unknown, has none.
+     * @return false if the request is empty or its parameters are truncated.
+     */
+    static bool decodeControlPoint(const QByteArray &value, controlpoint &out);
+};
+
+#endif // FTMSDECODER_H
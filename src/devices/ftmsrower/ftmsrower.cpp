@@ -1,5 +1,7 @@
 #include "devices/ftmsrower/ftmsrower.h"
+#include "qzlog.h"
 #include "devices/ftmsbike/ftmsbike.h"
+#include "devices/ftmsdecoder.h"
 #include "virtualdevices/virtualbike.h"
 #include <QBluetoothLocalDevice>
 #include <QDateTime>
@@ -32,32 +34,17 @@ ftmsrower::ftmsrower(bool noWriteResistance, bool noHeartService) {
 void ftmsrower::writeCharacteristic(uint8_t *data, uint8_t data_len, const QString &info, bool disable_log,
                                     bool wait_for_response) {
     if (!gattFTMSService || !gattWriteCharControlPointId.isValid()) {
-        qDebug() << QStringLiteral("gattWriteCharControlPointId or gattFTMSService not valid!!");
+        qCDebug(qzRower) << QStringLiteral("gattWriteCharControlPointId or gattFTMSService not valid!!");
         return;
     }
 
-    QEventLoop loop;
-    QTimer timeout;
-    if (wait_for_response) {
-        connect(gattFTMSService, &QLowEnergyService::characteristicChanged, &loop, &QEventLoop::quit);
-        timeout.singleShot(300ms, &loop, &QEventLoop::quit);
-    } else {
-        connect(gattFTMSService, &QLowEnergyService::characteristicWritten, &loop, &QEventLoop::quit);
-        timeout.singleShot(300ms, &loop, &QEventLoop::quit);
-    }
-
-    if (writeBuffer) {
-        delete writeBuffer;
-    }
-    writeBuffer = new QByteArray((const char *)data, data_len);
-
-    gattFTMSService->writeCharacteristic(gattWriteCharControlPointId, *writeBuffer);
+    QByteArray buffer((const char *)data, data_len);
+    writeQueue()->write(gattFTMSService, gattWriteCharControlPointId, buffer, QLowEnergyService::WriteWithResponse,
+                        wait_for_response);
 
     if (!disable_log) {
-        emit debug(QStringLiteral(" >> ") + writeBuffer->toHex(' ') + QStringLiteral(" // ") + info);
+        QZ_EMIT_DEBUG(qzRower, QStringLiteral(" >> ") + buffer.toHex(' ') + QStringLiteral(" // ") + info);
     }
-
-    loop.exec();
 }
 
 void ftmsrower::forceResistance(resistance_t requestResistance) {
@@ -136,7 +123,7 @@ void ftmsrower::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void ftmsrower::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
 
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
@@ -146,7 +133,7 @@ void ftmsrower::characteristicChanged(const QLowEnergyCharacteristic &characteri
     QString heartRateBeltName =
         settings.value(QZSettings::heart_rate_belt_name, QZSettings::default_heart_rate_belt_name).toString();
 
-    qDebug() << QStringLiteral(" << ") << characteristic.uuid() << " " << newValue.toHex(' ');
+    qCDebug(qzRower) << QStringLiteral(" << ") << characteristic.uuid() << " " << newValue.toHex(' ');
 
     if (characteristic.uuid() != QBluetoothUuid((quint16)0x2AD1)) {
         return;
@@ -154,161 +141,110 @@ void ftmsrower::characteristicChanged(const QLowEnergyCharacteristic &characteri
 
     lastPacket = newValue;
 
-    union flags {
-        struct {
-
-            uint16_t moreData : 1;
-            uint16_t avgStroke : 1;
-            uint16_t totDistance : 1;
-            uint16_t instantPace : 1;
-            uint16_t avgPace : 1;
-            uint16_t instantPower : 1;
-            uint16_t avgPower : 1;
-            uint16_t resistanceLvl : 1;
-            uint16_t expEnergy : 1;
-            uint16_t heartRate : 1;
-            uint16_t metabolic : 1;
-            uint16_t elapsedTime : 1;
-            uint16_t remainingTime : 1;
-            uint16_t spare : 3;
-        };
-
-        uint16_t word_flags;
-    };
-
-    flags Flags;
-    int index = 0;
+    ftmsdecoder::data ftms;
+    if (!ftmsdecoder::decode(ftmsdecoder::ROWER, newValue, ftms)) {
+        qCDebug(qzRower) << QStringLiteral("truncated rower data, decoded") << ftms.length << QStringLiteral("bytes");
+    }
+
+    // the stroke rate is sent in strokes per minute instead of half strokes by these rowers
     double cadence_divider = 2.0;
     if (WHIPR || KINGSMITH)
         cadence_divider = 1.0;
-    Flags.word_flags = (newValue.at(1) << 8) | newValue.at(0);
-    index += 2;
 
-    if (!Flags.moreData) {
+    if (ftms.has(ftmsdecoder::STROKE_RATE)) {
 
-        if (lastStroke.secsTo(now) > 3) {
-            qDebug() << "Resetting cadence!";
+        if (now - lastStroke > 3000) {
+            qCDebug(qzRower) << "Resetting cadence!";
             Cadence = 0;
             m_watt = 0;
             Speed = 0;
         } else {
-            Cadence = ((uint8_t)newValue.at(index)) / cadence_divider;
+            Cadence = ftms.rawValue(ftmsdecoder::STROKE_RATE) / cadence_divider;
         }
+    }
 
-        StrokesCount =
-            (((uint16_t)((uint8_t)newValue.at(index + 2)) << 8) | (uint16_t)((uint8_t)newValue.at(index + 1)));
+    if (ftms.has(ftmsdecoder::STROKE_COUNT)) {
+        StrokesCount = ftms.value(ftmsdecoder::STROKE_COUNT);
 
         if (lastStrokesCount != StrokesCount.value()) {
             lastStroke = now;
         }
         lastStrokesCount = StrokesCount.value();
 
-        index += 3;
-
         /*
          * the concept 2 sends the pace in 2 frames, so this condition will create a bogus speed
         if (!Flags.instantPace) {
             // eredited by echelon rower, probably we need to change this
             Speed = (0.37497622 * ((double)Cadence.value())) / 2.0;
-            emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
+            QZ_EMIT_DEBUG(qzRower, QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
         }*/
-        emit debug(QStringLiteral("Strokes Count: ") + QString::number(StrokesCount.value()));
+        QZ_EMIT_DEBUG(qzRower, QStringLiteral("Strokes Count: ") + QString::number(StrokesCount.value()));
     }
 
-    if (Flags.avgStroke) {
-
-        double avgStroke;
-        avgStroke = ((double)(uint16_t)((uint8_t)newValue.at(index))) / cadence_divider;
-        index += 1;
-        emit debug(QStringLiteral("Current Average Stroke: ") + QString::number(avgStroke));
+    if (ftms.has(ftmsdecoder::AVG_STROKE_RATE)) {
+        double avgStroke = ftms.rawValue(ftmsdecoder::AVG_STROKE_RATE) / cadence_divider;
+        QZ_EMIT_DEBUG(qzRower, QStringLiteral("Current Average Stroke: ") + QString::number(avgStroke));
     }
 
-    if (Flags.totDistance) {
-        Distance = ((double)((((uint32_t)((uint8_t)newValue.at(index + 2)) << 16) |
-                              (uint32_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                             (uint32_t)((uint8_t)newValue.at(index)))) /
-                   1000.0;
-        index += 3;
+    if (ftms.has(ftmsdecoder::TOTAL_DISTANCE)) {
+        Distance = ftms.value(ftmsdecoder::TOTAL_DISTANCE) / 1000.0;
     } else {
         Distance += ((Speed.value() / 3600000.0) *
-                     ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                     ((double)(now - lastRefreshCharacteristicChanged)));
     }
 
-    emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
+    QZ_EMIT_DEBUG(qzRower, QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
-    if (Flags.instantPace) {
+    if (ftms.has(ftmsdecoder::INSTANT_PACE)) {
 
-        double instantPace;
-        instantPace =
-            ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) | (uint16_t)((uint8_t)newValue.at(index))));
-        index += 2;
-        emit debug(QStringLiteral("Current Pace: ") + QString::number(instantPace));
+        double instantPace = ftms.value(ftmsdecoder::INSTANT_PACE);
+        QZ_EMIT_DEBUG(qzRower, QStringLiteral("Current Pace: ") + QString::number(instantPace));
 
         if((DFIT_L_R && Cadence.value() > 0) || !DFIT_L_R) {
             Speed = (60.0 / instantPace) *
                 30.0; // translating pace (min/500m) to km/h in order to match the pace function in the rower.cpp
         }
-        emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
+        QZ_EMIT_DEBUG(qzRower, QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
     }
 
-    if (Flags.avgPace) {
-
-        double avgPace;
-        avgPace =
-            ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) | (uint16_t)((uint8_t)newValue.at(index))));
-        index += 2;
-        emit debug(QStringLiteral("Current Average Pace: ") + QString::number(avgPace));
+    if (ftms.has(ftmsdecoder::AVG_PACE)) {
+        QZ_EMIT_DEBUG(qzRower,
+                      QStringLiteral("Current Average Pace: ") + QString::number(ftms.value(ftmsdecoder::AVG_PACE)));
     }
 
-    if (Flags.instantPower) {
-        double watt =
-            ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) | (uint16_t)((uint8_t)newValue.at(index))));
-        index += 2;
+    if (ftms.has(ftmsdecoder::INSTANT_POWER)) {
+        double watt = ftms.value(ftmsdecoder::INSTANT_POWER);
         if (!filterWattNull || watt != 0) {
             if((DFIT_L_R && Cadence.value() > 0) || !DFIT_L_R)
                 m_watt = watt;
         }
-        emit debug(QStringLiteral("Current Watt: ") + QString::number(m_watt.value()));
+        QZ_EMIT_DEBUG(qzRower, QStringLiteral("Current Watt: ") + QString::number(m_watt.value()));
     }
 
-    if (Flags.avgPower) {
-
-        double avgPower;
-        avgPower =
-            ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) | (uint16_t)((uint8_t)newValue.at(index))));
-        index += 2;
-        emit debug(QStringLiteral("Current Average Watt: ") + QString::number(avgPower));
+    if (ftms.has(ftmsdecoder::AVG_POWER)) {
+        QZ_EMIT_DEBUG(qzRower,
+                      QStringLiteral("Current Average Watt: ") + QString::number(ftms.value(ftmsdecoder::AVG_POWER)));
     }
 
-    if (Flags.resistanceLvl) {
-        Resistance =
-            ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) | (uint16_t)((uint8_t)newValue.at(index))));
+    if (ftms.has(ftmsdecoder::RESISTANCE)) {
+        Resistance = ftms.value(ftmsdecoder::RESISTANCE);
         emit resistanceRead(Resistance.value());
-        index += 2;
-        emit debug(QStringLiteral("Current Resistance: ") + QString::number(Resistance.value()));
+        QZ_EMIT_DEBUG(qzRower, QStringLiteral("Current Resistance: ") + QString::number(Resistance.value()));
     }
 
-    if (Flags.expEnergy && index + 1 < newValue.length()) {
-        KCal = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) | (uint16_t)((uint8_t)newValue.at(index))));
-        index += 2;
-
-        // energy per hour
-        index += 2;
-
-        // energy per minute
-        index += 1;
+    if (ftms.has(ftmsdecoder::TOTAL_ENERGY)) {
+        KCal = ftms.value(ftmsdecoder::TOTAL_ENERGY);
     } else {
         if (watts())
             KCal +=
                 ((((0.048 * ((double)watts()) + 1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                  // body weight in kg * 3.5) / 200 ) / 60
     }
 
-    emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
+    QZ_EMIT_DEBUG(qzRower, QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
 
 #ifdef Q_OS_ANDROID
     if (settings.value(QZSettings::ant_heart, QZSettings::default_ant_heart).toBool())
@@ -316,31 +252,12 @@ void ftmsrower::characteristicChanged(const QLowEnergyCharacteristic &characteri
     else
 #endif
     {
-        if (Flags.heartRate && !disable_hr_frommachinery) {
-            if (index < newValue.length()) {
-                Heart = ((double)(((uint8_t)newValue.at(index))));
-                // index += 1; //NOTE: clang-analyzer-deadcode.DeadStores
-                emit debug(QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
-            } else
-                emit debug(QStringLiteral("Error on parsing heart"));
+        if (ftms.has(ftmsdecoder::HEART_RATE) && !disable_hr_frommachinery) {
+            Heart = ftms.value(ftmsdecoder::HEART_RATE);
+            QZ_EMIT_DEBUG(qzRower, QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
         }
     }
 
-    if (Flags.metabolic) {
-
-        // todo
-    }
-
-    if (Flags.elapsedTime) {
-
-        // todo
-    }
-
-    if (Flags.remainingTime) {
-
-        // todo
-    }
-
     if (Cadence.value() > 0) {
 
         CrankRevs++;
@@ -366,12 +283,14 @@ void ftmsrower::characteristicChanged(const QLowEnergyCharacteristic &characteri
 #endif
 #endif
 
-    emit debug(QStringLiteral("Current CrankRevs: ") + QString::number(CrankRevs));
-    emit debug(QStringLiteral("Last CrankEventTime: ") + QString::number(LastCrankEventTime));
+    QZ_EMIT_DEBUG(qzRower, QStringLiteral("Current CrankRevs: ") + QString::number(CrankRevs));
+    QZ_EMIT_DEBUG(qzRower, QStringLiteral("Last CrankEventTime: ") + QString::number(LastCrankEventTime));
 
     if (m_control->error() != QLowEnergyController::NoError) {
-        qDebug() << QStringLiteral("QLowEnergyController ERROR!!") << m_control->errorString();
+        qCDebug(qzRower) << QStringLiteral("QLowEnergyController ERROR!!") << m_control->errorString();
     }
+
+    emit metricsUpdated();
 }
 
 void ftmsrower::stateChanged(QLowEnergyService::ServiceState state) {
@@ -523,7 +442,7 @@ void ftmsrower::descriptorRead(const QLowEnergyDescriptor &descriptor, const QBy
 void ftmsrower::characteristicWritten(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
 
     Q_UNUSED(characteristic);
-    emit debug(QStringLiteral("characteristicWritten ") + newValue.toHex(' '));
+    QZ_EMIT_DEBUG(qzRower, QStringLiteral("characteristicWritten ") + newValue.toHex(' '));
 }
 
 void ftmsrower::characteristicRead(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
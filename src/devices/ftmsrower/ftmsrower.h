@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "rower.h"
+#include "monotonicclock.h"
 #include "virtualdevices/virtualbike.h"
 #include "virtualdevices/virtualrower.h"
 
@@ -55,7 +56,7 @@ class ftmsrower : public rower {
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
     uint8_t firstStateChanged = 0;
 
     bool initDone = false;
@@ -71,7 +72,7 @@ class ftmsrower : public rower {
 
     bool WATER_ROWER = false;
     bool DFIT_L_R = false;
-    QDateTime lastStroke = QDateTime::currentDateTime();
+    qint64 lastStroke = monotonicclock::msecs();
     double lastStrokesCount = 0;
 
 #ifdef Q_OS_IOS
@@ -0,0 +1,297 @@
+#include "devices/gattwritequeue.h"
+#include "qzlog.h"
+#include <QDebug>
+#include <QHash>
+
+namespace {
+// the QLowEnergyService of a driver. It's a child of the service, so it's deleted with it on a disconnection
+class lowenergywriteservice : public gattwriteservice {
+  public:
+    explicit lowenergywriteservice(QLowEnergyService *service) : gattwriteservice(service), m_service(service) {
+        connect(service, &QLowEnergyService::characteristicWritten, this,
+                [this](const QLowEnergyCharacteristic &c, const QByteArray &value) {
+                    emit characteristicWritten(c.uuid(), value);
+                });
+        connect(service, &QLowEnergyService::characteristicChanged, this,
+                [this](const QLowEnergyCharacteristic &c, const QByteArray &) {
+                    emit characteristicChanged(c.uuid());
+                });
+        connect(service,
+                static_cast<void (QLowEnergyService::*)(QLowEnergyService::ServiceError)>(&QLowEnergyService::error),
+                this, [this](QLowEnergyService::ServiceError e) { emit error(e); });
+    }
+
+    void addCharacteristic(const QLowEnergyCharacteristic &characteristic) {
+        m_characteristics.insert(characteristic.uuid(), characteristic);
+    }
+
+    void writeCharacteristic(const QBluetoothUuid &characteristic, const QByteArray &data,
+                             QLowEnergyService::WriteMode mode) override {
+        m_service->writeCharacteristic(m_characteristics.value(characteristic), data, mode);
+    }
+
+  private:
+    QLowEnergyService *m_service;
+    QHash<QBluetoothUuid, QLowEnergyCharacteristic> m_characteristics;
+};
+} // namespace
+
+gattwritequeue::gattwritequeue(QObject *parent) : QObject(parent) {}
+
+gattwritequeue::~gattwritequeue() { qDeleteAll(m_lanes); }
+
+void gattwritequeue::write(QLowEnergyService *service, const QLowEnergyCharacteristic &characteristic,
+                           const QByteArray &data, QLowEnergyService::WriteMode mode, bool waitForResponse,
+                           const completion &done) {
+    if (!service || !characteristic.isValid()) {
+        qCDebug(qzGatt) << QStringLiteral("gattwritequeue: invalid service or characteristic, write dropped")
+                        << data.toHex(' ');
+        if (done) {
+            done(false);
+        }
+        return;
+    }
+
+    lowenergywriteservice *s = static_cast<lowenergywriteservice *>(serviceFor(service));
+    s->addCharacteristic(characteristic);
+    write(s, characteristic.uuid(), data, mode, waitForResponse, done);
+}
+
+void gattwritequeue::write(gattwriteservice *service, const QBluetoothUuid &characteristic, const QByteArray &data,
+                           QLowEnergyService::WriteMode mode, bool waitForResponse, const completion &done) {
+    if (!service || characteristic.isNull()) {
+        qCDebug(qzGatt) << QStringLiteral("gattwritequeue: invalid service or characteristic, write dropped")
+                        << data.toHex(' ');
+        if (done) {
+            done(false);
+        }
+        return;
+    }
+
+    lane *l = laneFor(service, characteristic);
+    request r;
+    r.data = data;
+    r.mode = mode;
+    r.waitForResponse = waitForResponse;
+    r.done = done;
+    l->pending.enqueue(r);
+
+    int d = depth();
+    if (d > m_maxDepth) {
+        m_maxDepth = d;
+    }
+
+    if (!l->busy) {
+        sendNext(l);
+    }
+}
+
+void gattwritequeue::clear() {
+    for (lane *l : qAsConst(m_lanes)) {
+        QQueue<request> dropped;
+        dropped.swap(l->pending);
+        if (l->busy) {
+            dropped.prepend(l->current);
+            l->busy = false;
+            l->timer->stop();
+        }
+        for (const request &r : qAsConst(dropped)) {
+            if (r.done) {
+                r.done(false);
+            }
+        }
+    }
+}
+
+int gattwritequeue::depth() const {
+    int d = 0;
+    for (const lane *l : m_lanes) {
+        d += l->pending.count() + (l->busy ? 1 : 0);
+    }
+    return d;
+}
+
+gattwriteservice *gattwritequeue::serviceFor(QLowEnergyService *service) {
+    // only the lowenergywriteservices are children of a QLowEnergyService
+    for (const QPointer<gattwriteservice> &s : qAsConst(m_services)) {
+        if (s && s->parent() == service) {
+            return s;
+        }
+    }
+    return new lowenergywriteservice(service);
+}
+
+gattwritequeue::lane *gattwritequeue::laneFor(gattwriteservice *service, const QBluetoothUuid &characteristic) {
+    // the lanes of the services deleted by a disconnection
+    for (int i = m_lanes.count() - 1; i >= 0; i--) {
+        lane *l = m_lanes.at(i);
+        if (l->service.isNull() && !l->busy && l->pending.isEmpty()) {
+            delete l->timer;
+            delete l;
+            m_lanes.removeAt(i);
+        }
+    }
+
+    for (lane *l : qAsConst(m_lanes)) {
+        if (l->service == service && l->characteristic == characteristic) {
+            return l;
+        }
+    }
+
+    bool connected = false;
+    for (int i = m_services.count() - 1; i >= 0; i--) {
+        if (m_services.at(i).isNull()) {
+            m_services.removeAt(i);
+        } else if (m_services.at(i) == service) {
+            connected = true;
+        }
+    }
+    if (!connected) {
+        m_services.append(service);
+        connect(service, &gattwriteservice::characteristicWritten, this,
+                [this, service](const QBluetoothUuid &c, const QByteArray &value) {
+                    characteristicWritten(service, c, value);
+                });
+        connect(service, &gattwriteservice::characteristicChanged, this,
+                [this, service](const QBluetoothUuid &c) { characteristicChanged(service, c); });
+        connect(service, &gattwriteservice::error, this,
+                [this, service](QLowEnergyService::ServiceError error) { serviceError(service, error); });
+        connect(service, &QObject::destroyed, this, [this]() { serviceDestroyed(); });
+    }
+
+    lane *l = new lane;
+    l->service = service;
+    l->characteristic = characteristic;
+    l->timer = new QTimer(this);
+    l->timer->setSingleShot(true);
+    connect(l->timer, &QTimer::timeout, this, [this, l]() { timeout(l); });
+    m_lanes.append(l);
+    return l;
+}
+
+void gattwritequeue::sendNext(lane *l) {
+    if (l->pending.isEmpty()) {
+        l->busy = false;
+        return;
+    }
+    l->current = l->pending.dequeue();
+    l->busy = true;
+    send(l);
+}
+
+void gattwritequeue::send(lane *l) {
+    if (l->service.isNull()) {
+        // the device disconnected: nothing of this lane can be written anymore
+        complete(l, false);
+        return;
+    }
+
+    l->current.attempts++;
+    l->sent.start();
+    // a write without response has no ack to wait for: it's done as soon as the event loop runs again
+    bool acked = l->current.mode == QLowEnergyService::WriteWithoutResponse && !l->current.waitForResponse;
+    l->timer->start(acked ? 0 : m_timeoutMs);
+    l->service->writeCharacteristic(l->characteristic, l->current.data, l->current.mode);
+}
+
+void gattwritequeue::complete(lane *l, bool ok) {
+    l->timer->stop();
+    request r = l->current;
+    l->current = request();
+    l->busy = false;
+
+    qint64 latency = l->sent.isValid() ? l->sent.elapsed() : 0;
+    if (ok) {
+        m_acked++;
+        m_lastLatencyMs = latency;
+        m_totalLatencyMs += latency;
+    } else {
+        m_failed++;
+    }
+    int d = depth();
+    qCDebug(qzGatt) << QStringLiteral("gattwritequeue:") << l->characteristic << r.data.toHex(' ')
+                    << (ok ? QStringLiteral("acked in") : QStringLiteral("failed after")) << latency
+                    << QStringLiteral("ms, depth") << d;
+    emit written(r.data, ok, latency, d);
+
+    if (r.done) {
+        r.done(ok);
+    }
+    if (!l->busy) {
+        sendNext(l);
+    }
+}
+
+void gattwritequeue::timeout(lane *l) {
+    if (!l->busy) {
+        return;
+    }
+    if (l->current.mode == QLowEnergyService::WriteWithoutResponse && !l->current.waitForResponse) {
+        complete(l, true);
+    } else {
+        retryOrFail(l);
+    }
+}
+
+void gattwritequeue::retryOrFail(lane *l) {
+    if (l->current.attempts <= m_retries) {
+        qCDebug(qzGatt) << QStringLiteral("gattwritequeue: timeout, sending again") << l->current.data.toHex(' ');
+        send(l);
+    } else {
+        complete(l, false);
+    }
+}
+
+void gattwritequeue::characteristicWritten(gattwriteservice *service, const QBluetoothUuid &characteristic,
+                                           const QByteArray &value) {
+    for (lane *l : qAsConst(m_lanes)) {
+        if (l->busy && !l->current.waitForResponse && l->service == service &&
+            l->characteristic == characteristic && (value.isEmpty() || value == l->current.data)) {
+            complete(l, true);
+            return;
+        }
+    }
+}
+
+void gattwritequeue::characteristicChanged(gattwriteservice *service, const QBluetoothUuid &characteristic) {
+    for (lane *l : qAsConst(m_lanes)) {
+        if (l->busy && l->current.waitForResponse && l->service == service && l->characteristic == characteristic) {
+            complete(l, true);
+            return;
+        }
+    }
+}
+
+void gattwritequeue::serviceError(gattwriteservice *service, QLowEnergyService::ServiceError error) {
+    if (error != QLowEnergyService::CharacteristicWriteError && error != QLowEnergyService::OperationError) {
+        return;
+    }
+    // the error doesn't say which write failed: if more than one is in flight on the service, their timeouts
+    // retry or fail them
+    lane *failed = nullptr;
+    for (lane *l : qAsConst(m_lanes)) {
+        if (l->busy && l->service == service) {
+            if (failed) {
+                return;
+            }
+            failed = l;
+        }
+    }
+    if (failed) {
+        retryOrFail(failed);
+    }
+}
+
+void gattwritequeue::serviceDestroyed() {
+    // the writes in flight can't be acknowledged anymore, the queued ones fail after them. A lane stays busy until
+    // it's completed, so the completions can't delete the lanes still to drain
+    QList<lane *> drained;
+    for (lane *l : qAsConst(m_lanes)) {
+        if (l->busy && l->service.isNull()) {
+            drained.append(l);
+        }
+    }
+    for (lane *l : qAsConst(drained)) {
+        complete(l, false);
+    }
+}
@@ -0,0 +1,133 @@
+#ifndef GATTWRITEQUEUE_H
+#define GATTWRITEQUEUE_H
+
+#include <QBluetoothUuid>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <QTimer>
+#include <QtBluetooth/qlowenergycharacteristic.h>
+#include <QtBluetooth/qlowenergyservice.h>
+#include <functional>
+
+/**
+ * @brief The GATT service written by a gattwritequeue: the QLowEnergyService of a driver, or a fake one in the tests.
+ * The characteristics are identified by their uuid.
+ */
+class gattwriteservice : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit gattwriteservice(QObject *parent = nullptr) : QObject(parent) {}
+
+    virtual void writeCharacteristic(const QBluetoothUuid &characteristic, const QByteArray &data,
+                                     QLowEnergyService::WriteMode mode) = 0;
+
+  signals:
+    void characteristicWritten(const QBluetoothUuid &characteristic, const QByteArray &value);
+    // a notification or an indication
+    void characteristicChanged(const QBluetoothUuid &characteristic);
+    void error(QLowEnergyService::ServiceError error);
+};
+
+/**
+ * @brief Asynchronous queue of the GATT writes of a device.
+ *
+ * write() returns at once: the writes to the same characteristic are sent in order, the next one when the previous
+ * one is acknowledged, so a driver no longer spins a nested QEventLoop for every write and the notifications keep
+ * flowing while a write is pending. A write is acknowledged by QLowEnergyService::characteristicWritten or, if it
+ * waits for a response, by the next notification or indication of the same characteristic. A write without
+ * response that doesn't wait for one is done once it's sent.
+ *
+ * A write that isn't acknowledged within timeoutMs is sent again up to retries times, then it fails and the queue
+ * goes on. When the service is deleted by a disconnection, the writes left in its lanes fail at once, in order. The
+ * write-to-ack latency and the depth of the queue are logged for every write and kept in the counters.
+ */
+class gattwritequeue : public QObject {
+    Q_OBJECT
+
+  public:
+    /**
+     * @brief Called when a write is acknowledged (ok) or failed.
+     */
+    typedef std::function<void(bool ok)> completion;
+
+    explicit gattwritequeue(QObject *parent = nullptr);
+    ~gattwritequeue();
+
+    void write(QLowEnergyService *service, const QLowEnergyCharacteristic &characteristic, const QByteArray &data,
+               QLowEnergyService::WriteMode mode = QLowEnergyService::WriteWithResponse,
+               bool waitForResponse = false, const completion &done = completion());
+    void write(gattwriteservice *service, const QBluetoothUuid &characteristic, const QByteArray &data,
+               QLowEnergyService::WriteMode mode = QLowEnergyService::WriteWithResponse,
+               bool waitForResponse = false, const completion &done = completion());
+
+    /**
+     * @brief Drops the queued writes, their completions are called with ok = false.
+     */
+    void clear();
+
+    void setTimeoutMs(int ms) { m_timeoutMs = ms; }
+    void setRetries(int retries) { m_retries = retries; }
+
+    // queued and in flight writes
+    int depth() const;
+    int maxDepth() const { return m_maxDepth; }
+    qint64 lastLatencyMs() const { return m_lastLatencyMs; }
+    double averageLatencyMs() const { return m_acked ? (double)m_totalLatencyMs / m_acked : 0; }
+    int acked() const { return m_acked; }
+    int failed() const { return m_failed; }
+
+  signals:
+    void written(const QByteArray &data, bool ok, qint64 latencyMs, int depth);
+
+  private:
+    struct request {
+        QByteArray data;
+        QLowEnergyService::WriteMode mode = QLowEnergyService::WriteWithResponse;
+        bool waitForResponse = false;
+        completion done;
+        int attempts = 0;
+    };
+
+    // the writes of a characteristic
+    struct lane {
+        QPointer<gattwriteservice> service;
+        QBluetoothUuid characteristic;
+        QQueue<request> pending;
+        request current;
+        bool busy = false;
+        QElapsedTimer sent;
+        QTimer *timer = nullptr;
+    };
+
+    gattwriteservice *serviceFor(QLowEnergyService *service);
+    lane *laneFor(gattwriteservice *service, const QBluetoothUuid &characteristic);
+    void sendNext(lane *l);
+    void send(lane *l);
+    void complete(lane *l, bool ok);
+    void timeout(lane *l);
+    void retryOrFail(lane *l);
+    void characteristicWritten(gattwriteservice *service, const QBluetoothUuid &characteristic,
+                               const QByteArray &value);
+    void characteristicChanged(gattwriteservice *service, const QBluetoothUuid &characteristic);
+    void serviceError(gattwriteservice *service, QLowEnergyService::ServiceError error);
+    void serviceDestroyed();
+
+    QList<lane *> m_lanes;
+    QList<QPointer<gattwriteservice>> m_services;
+
+    int m_timeoutMs = 300;
+    int m_retries = 0;
+
+    int m_maxDepth = 0;
+    qint64 m_lastLatencyMs = 0;
+    qint64 m_totalLatencyMs = 0;
+    int m_acked = 0;
+    int m_failed = 0;
+};
+
+#endif // GATTWRITEQUEUE_H
@@ -32,45 +32,23 @@ horizongr7bike::horizongr7bike(bool noWriteResistance, bool noHeartService, uint
 
 void horizongr7bike::writeCharacteristic(uint8_t *data, uint8_t data_len, const QString &info, bool disable_log,
                                          bool wait_for_response) {
-    QEventLoop loop;
-    QTimer timeout;
-
-    if (writeBuffer) {
-        delete writeBuffer;
-    }
-    writeBuffer = new QByteArray((const char *)data, data_len);
+    QByteArray buffer((const char *)data, data_len);
 
     if (gattFTMSService) {
-        if (wait_for_response) {
-            connect(gattFTMSService, &QLowEnergyService::characteristicChanged, &loop, &QEventLoop::quit);
-            timeout.singleShot(300ms, &loop, &QEventLoop::quit);
-        } else {
-            connect(gattFTMSService, &QLowEnergyService::characteristicWritten, &loop, &QEventLoop::quit);
-            timeout.singleShot(300ms, &loop, &QEventLoop::quit);
-        }
-
-        gattFTMSService->writeCharacteristic(gattWriteCharControlPointId, *writeBuffer);
+        writeQueue()->write(gattFTMSService, gattWriteCharControlPointId, buffer,
+                            QLowEnergyService::WriteWithResponse, wait_for_response);
     } else if (customService && customWriteChar.isValid()) {
-        if (wait_for_response) {
-            connect(customService, &QLowEnergyService::characteristicChanged, &loop, &QEventLoop::quit);
-            timeout.singleShot(300ms, &loop, &QEventLoop::quit);
-        } else {
-            connect(customService, &QLowEnergyService::characteristicWritten, &loop, &QEventLoop::quit);
-            timeout.singleShot(300ms, &loop, &QEventLoop::quit);
-        }
-
-        customService->writeCharacteristic(customWriteChar, *writeBuffer);
+        writeQueue()->write(customService, customWriteChar, buffer, QLowEnergyService::WriteWithResponse,
+                            wait_for_response);
     } else {
         qDebug() << "writeCharacteristic error!";
         return;
     }
 
     if (!disable_log) {
-        emit debug(QStringLiteral(" >> ") + writeBuffer->toHex(' ') +
+        emit debug(QStringLiteral(" >> ") + buffer.toHex(' ') +
                    QStringLiteral(" // ") + info);
     }
-
-    loop.exec();
 }
 
 void horizongr7bike::forceResistance(resistance_t requestResistance) {
@@ -144,7 +122,7 @@ void horizongr7bike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void horizongr7bike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -195,9 +173,8 @@ void horizongr7bike::characteristicChanged(const QLowEnergyCharacteristic &chara
                 ((((0.048 * ((double)watts()) + 1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                  // body weight in kg * 3.5) / 200 ) / 60
 
         if (!settings.value(QZSettings::speed_power_based, QZSettings::default_speed_power_based).toBool()) {
             Speed =
@@ -207,12 +184,12 @@ void horizongr7bike::characteristicChanged(const QLowEnergyCharacteristic &chara
         } else {
             Speed = metric::calculateSpeedFromPower(
                 watts(), Inclination.value(), Speed.value(),
-                fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
         }
         emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
 
         Distance += ((Speed.value() / 3600000.0) *
-                     ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                     ((double)(now - lastRefreshCharacteristicChanged)));
         emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
         return;
@@ -232,7 +209,7 @@ void horizongr7bike::characteristicChanged(const QLowEnergyCharacteristic &chara
             } else {
                 Speed = metric::calculateSpeedFromPower(
                     watts(), Inclination.value(), Speed.value(),
-                    fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                    Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
             }
             index += 2;
             emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
@@ -287,13 +264,13 @@ void horizongr7bike::characteristicChanged(const QLowEnergyCharacteristic &chara
                    1000.0;*/
             if (firstPacket)
                 Distance += ((Speed.value() / 3600000.0) *
-                             ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                             ((double)(now - lastRefreshCharacteristicChanged)));
 
             index += 3;
         } else {
             if (firstPacket)
                 Distance += ((Speed.value() / 3600000.0) *
-                             ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                             ((double)(now - lastRefreshCharacteristicChanged)));
         }
 
         emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
@@ -341,9 +318,8 @@ void horizongr7bike::characteristicChanged(const QLowEnergyCharacteristic &chara
                            settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                           200.0) /
                          (60000.0 /
-                          ((double)lastRefreshCharacteristicChanged.msecsTo(
-                              now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                // kg * 3.5) / 200 ) / 60
+                          ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                // body weight in kg * 3.5) / 200 ) / 60
         }
 
         emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
@@ -549,12 +525,7 @@ void horizongr7bike::ftmsCharacteristicChanged(const QLowEnergyCharacteristic &c
     if (gattWriteCharControlPointId.isValid()) {
         qDebug() << "routing FTMS packet to the bike from virtualbike" << characteristic.uuid() << newValue.toHex(' ');
 
-        if (writeBuffer) {
-            delete writeBuffer;
-        }
-        writeBuffer = new QByteArray(b);
-
-        gattFTMSService->writeCharacteristic(gattWriteCharControlPointId, *writeBuffer);
+        writeQueue()->write(gattFTMSService, gattWriteCharControlPointId, b);
     }
 }
 
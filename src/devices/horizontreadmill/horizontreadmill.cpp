@@ -1,6 +1,8 @@
 #include "horizontreadmill.h"
+#include "qzlog.h"
 
 #include "devices/ftmsbike/ftmsbike.h"
+#include "devices/ftmsdecoder.h"
 #include "virtualdevices/virtualbike.h"
 #include "virtualdevices/virtualtreadmill.h"
 #include <QBluetoothLocalDevice>
@@ -44,7 +46,7 @@ void horizontreadmill::writeCharacteristic(QLowEnergyService *service, QLowEnerg
     QTimer timeout;
 
     if (!service) {
-        qDebug() << "no gattCustomService available";
+        qCDebug(qzTreadmill) << "no gattCustomService available";
         return;
     }
 
@@ -64,7 +66,7 @@ void horizontreadmill::writeCharacteristic(QLowEnergyService *service, QLowEnerg
     service->writeCharacteristic(characteristic, *writeBuffer);
 
     if (!disable_log)
-        qDebug() << " >> " << writeBuffer->toHex(' ') << " // " << info;
+        qCDebug(qzTreadmill) << " >> " << writeBuffer->toHex(' ') << " // " << info;
 
     loop.exec();
 }
@@ -834,17 +836,16 @@ void horizontreadmill::update() {
         update_metrics(!powerReceivedFromPowerSensor, watts(settings.value(QZSettings::weight, QZSettings::default_weight).toFloat()));
 
         if (firstDistanceCalculated) {
-            QDateTime now = QDateTime::currentDateTime();
+            const qint64 now = monotonicclock::msecs();
             KCal +=
                 ((((0.048 * ((double)watts(settings.value(QZSettings::weight, QZSettings::default_weight).toFloat())) +
             1.19) *
             settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
             200.0) /
-            (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                        now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                            // kg * 3.5) / 200 ) / 60    
+            (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) * body
+                                                            // weight in kg * 3.5) / 200 ) / 60
             Distance += ((Speed.value() / 3600000.0) *
-                         ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                         ((double)(now - lastRefreshCharacteristicChanged)));
 
             lastRefreshCharacteristicChanged = now;
         }
@@ -1330,24 +1331,24 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
     QString heartRateBeltName =
         settings.value(QZSettings::heart_rate_belt_name, QZSettings::default_heart_rate_belt_name).toString();
 
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     double weight = settings.value(QZSettings::weight, QZSettings::default_weight).toFloat();
 
-    emit debug(QStringLiteral(" << ") + characteristic.uuid().toString() + " " + QString::number(newValue.length()) +
-               " " + newValue.toHex(' '));
+    QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral(" << ") + characteristic.uuid().toString() + " " +
+                                   QString::number(newValue.length()) + " " + newValue.toHex(' '));
 
     if (characteristic.uuid() == QBluetoothUuid((quint16)0xFFF4)) {
         if (newValue.at(0) == 0x55 && newValue.length() > 7) {
             lastPacketComplete.clear();
             customRecv = (((uint16_t)((uint8_t)newValue.at(7)) << 8) | (uint16_t)((uint8_t)newValue.at(6))) + 10;
-            qDebug() << "new custom packet received. Len expected: " << customRecv;
+            qCDebug(qzTreadmill) << "new custom packet received. Len expected: " << customRecv;
         }
 
         lastPacketComplete.append(newValue);
         customRecv -= newValue.length();
         if (customRecv <= 0) {
-            emit debug(QStringLiteral(" << FULL ") + " " + lastPacketComplete.toHex(' '));
-            qDebug() << "full custom packet received";
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral(" << FULL ") + " " + lastPacketComplete.toHex(' '));
+            qCDebug(qzTreadmill) << "full custom packet received";
             initPacketRecv = true;
             customRecv = 0;
             emit packetReceived();
@@ -1358,7 +1359,7 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                           .value(QZSettings::horizon_treadmill_suspend_stats_pause,
                                  QZSettings::default_horizon_treadmill_suspend_stats_pause)
                           .toBool()) {
-        qDebug() << "treadmill paused so I'm ignoring the new metrics";
+        qCDebug(qzTreadmill) << "treadmill paused so I'm ignoring the new metrics";
         return;
     }
 
@@ -1368,10 +1369,10 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                            (uint16_t)((uint8_t)lastPacketComplete.at(24)))) /
                  100.0) *
                 1.60934); // miles/h
-        emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
 
         Inclination = treadmillInclinationOverride((double)((uint8_t)lastPacketComplete.at(30)) / 10.0);
-        emit debug(QStringLiteral("Current Inclination: ") + QString::number(Inclination.value()));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Inclination: ") + QString::number(Inclination.value()));
 
         if (firstDistanceCalculated && watts(weight))
             KCal +=
@@ -1379,25 +1380,24 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                     1.19) *
                    weight * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                  // body weight in kg * 3.5) / 200 ) / 60
 
-        emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
 
         if (firstDistanceCalculated)
             Distance += ((Speed.value() / 3600000.0) *
-                         ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
-        emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
+                         ((double)(now - lastRefreshCharacteristicChanged)));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
         distanceEval = true;
     } else if (characteristic.uuid() == QBluetoothUuid((quint16)0xFFF4) && newValue.length() > 70 &&
                newValue.at(0) == 0x55 && newValue.at(5) == 0x12) {
         parseSpeed((((double)(((uint16_t)((uint8_t)newValue.at(62)) << 8) | (uint16_t)((uint8_t)newValue.at(61)))) / 1000.0) *
                        1.60934); // miles/h
-        emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
 
         Inclination = treadmillInclinationOverride((double)((uint8_t)newValue.at(63)) / 10.0);
-        emit debug(QStringLiteral("Current Inclination: ") + QString::number(Inclination.value()));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Inclination: ") + QString::number(Inclination.value()));
 
         if (firstDistanceCalculated && watts(weight))
             KCal +=
@@ -1405,21 +1405,20 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                     1.19) *
                    weight * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                  // body weight in kg * 3.5) / 200 ) / 60
 
-        emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
 
         if (firstDistanceCalculated)
             Distance += ((Speed.value() / 3600000.0) *
-                         ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
-        emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
+                         ((double)(now - lastRefreshCharacteristicChanged)));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
         distanceEval = true;
     } else if (characteristic.uuid() == QBluetoothUuid((quint16)0xFFF4) && newValue.length() == 29 &&
                newValue.at(0) == 0x55) {
         parseSpeed(((double)(((uint16_t)((uint8_t)newValue.at(15)) << 8) | (uint16_t)((uint8_t)newValue.at(14)))) / 10.0);
-        emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
 
         // Inclination = (double)((uint8_t)newValue.at(3)) / 10.0;
         // emit debug(QStringLiteral("Current Inclination: ") + QString::number(Inclination.value()));
@@ -1429,16 +1428,15 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                     1.19) *
                    weight * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                now)))); //(( (0.048* Output in watts +1.19) * body weight in
-        // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+        // body weight in kg * 3.5) / 200 ) / 60
 
-        emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
 
         if (firstDistanceCalculated)
             Distance += ((Speed.value() / 3600000.0) *
-                         ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
-        emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
+                         ((double)(now - lastRefreshCharacteristicChanged)));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
         distanceEval = true;
     } else if (characteristic.uuid() == QBluetoothUuid((quint16)0xFFF4) && newValue.length() > 10 &&
                (uint8_t)newValue.at(0) == 0x55 && (uint8_t)newValue.at(1) == 0xAA && (uint8_t)newValue.at(2) == 0x00 &&
@@ -1448,7 +1446,7 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
 
         Speed = 0;
         horizonPaused = true;
-        qDebug() << "stop from the treadmill";
+        qCDebug(qzTreadmill) << "stop from the treadmill";
     } else if (characteristic.uuid() == QBluetoothUuid((quint16)0x2AD2)) {
         union flags {
             struct {
@@ -1481,7 +1479,7 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                                   (uint16_t)((uint8_t)newValue.at(index)))) /
                         100.0;
             index += 2;
-            emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
         }
 
         if (Flags.avgSpeed) {
@@ -1490,7 +1488,7 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                                  (uint16_t)((uint8_t)newValue.at(index)))) /
                        100.0;
             index += 2;
-            emit debug(QStringLiteral("Current Average Speed: ") + QString::number(avgSpeed));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Average Speed: ") + QString::number(avgSpeed));
         }
 
         if (Flags.instantCadence) {
@@ -1502,7 +1500,7 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                           2.0;
             }
             index += 2;
-            emit debug(QStringLiteral("Current Cadence: ") + QString::number(Cadence.value()));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Cadence: ") + QString::number(Cadence.value()));
         }
 
         if (Flags.avgCadence) {
@@ -1511,7 +1509,7 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                                    (uint16_t)((uint8_t)newValue.at(index)))) /
                          2.0;
             index += 2;
-            emit debug(QStringLiteral("Current Average Cadence: ") + QString::number(avgCadence));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Average Cadence: ") + QString::number(avgCadence));
         }
 
         if (Flags.totDistance) {
@@ -1527,15 +1525,15 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
         }
 
         Distance += ((Speed.value() / 3600000.0) *
-                     ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                     ((double)(now - lastRefreshCharacteristicChanged)));
 
-        emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
         if (Flags.resistanceLvl) {
             Resistance = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
                                    (uint16_t)((uint8_t)newValue.at(index))));
             index += 2;
-            emit debug(QStringLiteral("Current Resistance: ") + QString::number(Resistance.value()));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Resistance: ") + QString::number(Resistance.value()));
         }
 
         if (Flags.instantPower) {
@@ -1545,7 +1543,7 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                 m_watt = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
                                    (uint16_t)((uint8_t)newValue.at(index))));
             index += 2;
-            emit debug(QStringLiteral("Current Watt: ") + QString::number(m_watt.value()));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Watt: ") + QString::number(m_watt.value()));
         }
 
         if (Flags.avgPower && newValue.length() > index + 1) {
@@ -1553,7 +1551,7 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
             avgPower = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
                                  (uint16_t)((uint8_t)newValue.at(index))));
             index += 2;
-            emit debug(QStringLiteral("Current Average Watt: ") + QString::number(avgPower));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Average Watt: ") + QString::number(avgPower));
         }
 
         if (Flags.expEnergy && newValue.length() > index + 1) {
@@ -1572,12 +1570,11 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                            weight * 3.5) /
                           200.0) /
                          (60000.0 /
-                          ((double)lastRefreshCharacteristicChanged.msecsTo(
-                              now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                       // kg * 3.5) / 200 ) / 60
+                          ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                       // body weight in kg * 3.5) / 200 ) / 60
         }
 
-        emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
 
 #ifdef Q_OS_ANDROID
         if (settings.value(QZSettings::ant_heart, QZSettings::default_ant_heart).toBool())
@@ -1588,7 +1585,7 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
             if (Flags.heartRate && !disable_hr_frommachinery && newValue.length() > index) {
                 Heart = ((double)(((uint8_t)newValue.at(index))));
                 // index += 1; // NOTE: clang-analyzer-deadcode.DeadStores
-                emit debug(QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
             } else {
                 Flags.heartRate = false;
             }
@@ -1612,101 +1609,39 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
 
         // default flags for this treadmill is 84 04
 
-        union flags {
-            struct {
-
-                uint16_t moreData : 1;
-                uint16_t avgSpeed : 1;
-                uint16_t totalDistance : 1;
-                uint16_t inclination : 1;
-                uint16_t elevation : 1;
-                uint16_t instantPace : 1;
-                uint16_t averagePace : 1;
-                uint16_t expEnergy : 1;
-                uint16_t heartRate : 1;
-                uint16_t metabolic : 1;
-                uint16_t elapsedTime : 1;
-                uint16_t remainingTime : 1;
-                uint16_t forceBelt : 1;
-                uint16_t spare : 3;
-            };
-
-            uint16_t word_flags;
-        };
-
-        flags Flags;
-        int index = 0;
-        Flags.word_flags = (newValue.at(1) << 8) | newValue.at(0);
-        index += 2;
-
-        if (!Flags.moreData) {
-            parseSpeed(((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                              (uint16_t)((uint8_t)newValue.at(index)))) /
-                    100.0);
-            index += 2;
-            emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
+        ftmsdecoder::data ftms;
+        if (!ftmsdecoder::decode(ftmsdecoder::TREADMILL, newValue, ftms)) {
+            qCDebug(qzTreadmill) << QStringLiteral("truncated treadmill data, decoded") << ftms.length
+                                 << QStringLiteral("bytes");
         }
 
-        if (Flags.avgSpeed) {
-            double avgSpeed;
-            avgSpeed = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                                 (uint16_t)((uint8_t)newValue.at(index)))) /
-                       100.0;
-            index += 2;
-            emit debug(QStringLiteral("Current Average Speed: ") + QString::number(avgSpeed));
+        if (ftms.has(ftmsdecoder::INSTANT_SPEED)) {
+            parseSpeed(ftms.value(ftmsdecoder::INSTANT_SPEED));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
         }
 
-        if (Flags.totalDistance) {
-            // ignoring the distance, because it's a total life odometer
-            // Distance = ((double)((((uint32_t)((uint8_t)newValue.at(index + 2)) << 16) |
-            // (uint32_t)((uint8_t)newValue.at(index + 1)) << 8) | (uint32_t)((uint8_t)newValue.at(index)))) / 1000.0;
-            index += 3;
+        if (ftms.has(ftmsdecoder::AVG_SPEED)) {
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Average Speed: ") +
+                                       QString::number(ftms.value(ftmsdecoder::AVG_SPEED)));
         }
-        // else
-        {
-            if (firstDistanceCalculated)
-                Distance += ((Speed.value() / 3600000.0) *
-                             ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
-            distanceEval = true;
-        }
-
-        emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
-        if (Flags.inclination) {
-            if(!tunturi_t60_treadmill)
-                Inclination = treadmillInclinationOverride((double)(
-                                  (int16_t)(
-                                      ((int16_t)(int8_t)newValue.at(index + 1) << 8) |
-                                      (uint8_t)newValue.at(index)
-                                      )
-                                  ) /
-                              10.0);
-            index += 4; // the ramo value is useless
-            emit debug(QStringLiteral("Current Inclination: ") + QString::number(Inclination.value()));
-        }
-
-        if (Flags.elevation) {
-            index += 4; // TODO
-        }
+        // ignoring the distance, because it's a total life odometer
+        if (firstDistanceCalculated)
+            Distance += ((Speed.value() / 3600000.0) *
+                         ((double)(now - lastRefreshCharacteristicChanged)));
+        distanceEval = true;
 
-        if (Flags.instantPace) {
-            index += 1; // TODO
-        }
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
-        if (Flags.averagePace) {
-            index += 1; // TODO
+        if (ftms.has(ftmsdecoder::INCLINATION)) {
+            if(!tunturi_t60_treadmill)
+                Inclination = treadmillInclinationOverride(ftms.value(ftmsdecoder::INCLINATION));
+            // the ramp value is useless
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Inclination: ") + QString::number(Inclination.value()));
         }
 
-        if (Flags.expEnergy) {
-            KCal = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
-                             (uint16_t)((uint8_t)newValue.at(index))));
-            index += 2;
-
-            // energy per hour
-            index += 2;
-
-            // energy per minute
-            index += 1;
+        if (ftms.has(ftmsdecoder::TOTAL_ENERGY)) {
+            KCal = ftms.value(ftmsdecoder::TOTAL_ENERGY);
         } else {
             if (firstDistanceCalculated &&
                 watts(settings.value(QZSettings::weight, QZSettings::default_weight).toFloat()))
@@ -1717,13 +1652,12 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                        settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                       200.0) /
                      (60000.0 /
-                      ((double)lastRefreshCharacteristicChanged.msecsTo(
-                          now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                            // kg * 3.5) / 200 ) / 60
+                      ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) * body
+                                                            // weight in kg * 3.5) / 200 ) / 60
             distanceEval = true;
         }
 
-        emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
 
 #ifdef Q_OS_ANDROID
         if (settings.value(QZSettings::ant_heart, QZSettings::default_ant_heart).toBool())
@@ -1731,33 +1665,11 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
         else
 #endif
         {
-            if (Flags.heartRate) {
-                if (index < newValue.length()) {
-
-                    heart = ((double)(((uint8_t)newValue.at(index))));
-                    emit debug(QStringLiteral("Current Heart: ") + QString::number(heart));
-                } else {
-                    emit debug(QStringLiteral("Error on parsing heart!"));
-                }
-                // index += 1; //NOTE: clang-analyzer-deadcode.DeadStores
+            if (ftms.has(ftmsdecoder::HEART_RATE)) {
+                heart = ftms.value(ftmsdecoder::HEART_RATE);
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Heart: ") + QString::number(heart));
             }
         }
-
-        if (Flags.metabolic) {
-            // todo
-        }
-
-        if (Flags.elapsedTime) {
-            // todo
-        }
-
-        if (Flags.remainingTime) {
-            // todo
-        }
-
-        if (Flags.forceBelt) {
-            // todo
-        }
     } else if (characteristic.uuid() == QBluetoothUuid((quint16)0x2ACE)) {
         union flags {
             struct {
@@ -1792,7 +1704,7 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
             parseSpeed(((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
                               (uint16_t)((uint8_t)newValue.at(index)))) /
                        100.0);
-            emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
             index += 2;
         }
 
@@ -1802,7 +1714,7 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                                  (uint16_t)((uint8_t)newValue.at(index)))) /
                        100.0;
             index += 2;
-            emit debug(QStringLiteral("Current Average Speed: ") + QString::number(avgSpeed));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Average Speed: ") + QString::number(avgSpeed));
         }
 
         if (Flags.totDistance && newValue.length() > index + 2) {
@@ -1814,11 +1726,11 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
         } else {
             if (firstDistanceCalculated)
                 Distance += ((Speed.value() / 3600000.0) *
-                             ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                             ((double)(now - lastRefreshCharacteristicChanged)));
             distanceEval = true;
         }
 
-        emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
         if (Flags.stepCount && newValue.length() > index + 1) {
             if (settings.value(QZSettings::cadence_sensor_name, QZSettings::default_cadence_sensor_name)
@@ -1827,7 +1739,7 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                 Cadence = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
                                     (uint16_t)((uint8_t)newValue.at(index))));
             }
-            emit debug(QStringLiteral("Current Cadence: ") + QString::number(Cadence.value()));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Cadence: ") + QString::number(Cadence.value()));
 
             index += 2;
             index += 2;
@@ -1851,14 +1763,14 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
             Resistance = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
                                    (uint16_t)((uint8_t)newValue.at(index))));
             index += 2;
-            emit debug(QStringLiteral("Current Resistance: ") + QString::number(Resistance.value()));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Resistance: ") + QString::number(Resistance.value()));
         }
 
         if (Flags.instantPower && newValue.length() > index + 1) {
             if (!powerReceivedFromPowerSensor)
                 m_watt = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
                                    (uint16_t)((uint8_t)newValue.at(index))));
-            emit debug(QStringLiteral("Current Watt: ") + QString::number(m_watt.value()));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Watt: ") + QString::number(m_watt.value()));
             index += 2;
         }
 
@@ -1866,7 +1778,7 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
             double avgPower;
             avgPower = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
                                  (uint16_t)((uint8_t)newValue.at(index))));
-            emit debug(QStringLiteral("Current Average Watt: ") + QString::number(avgPower));
+            QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Average Watt: ") + QString::number(avgPower));
             index += 2;
         }
 
@@ -1890,13 +1802,12 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                        settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                       200.0) /
                      (60000.0 /
-                      ((double)lastRefreshCharacteristicChanged.msecsTo(
-                          now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                            // kg * 3.5) / 200 ) / 60
+                      ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) * body
+                                                            // weight in kg * 3.5) / 200 ) / 60
             distanceEval = true;
         }
 
-        emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
 
 #ifdef Q_OS_ANDROID
         if (settings.value(QZSettings::ant_heart, QZSettings::default_ant_heart).toBool())
@@ -1907,7 +1818,7 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
             if (Flags.heartRate && !disable_hr_frommachinery && newValue.length() > index) {
                 Heart = ((double)(((uint8_t)newValue.at(index))));
                 // index += 1; // NOTE: clang-analyzer-deadcode.DeadStores
-                emit debug(QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
+                QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
             } else {
                 Flags.heartRate = false;
             }
@@ -1947,20 +1858,22 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
             InstantaneousStrideLengthCM =
                 (((uint16_t)((uint8_t)newValue.at(5)) << 8) | (uint16_t)((uint8_t)newValue.at(4))) / 2;
             emit instantaneousStrideLengthChanged(InstantaneousStrideLengthCM.value());
-            qDebug() << QStringLiteral("Current InstantaneousStrideLengthCM:") << InstantaneousStrideLengthCM.value();
+            qCDebug(qzTreadmill) << QStringLiteral("Current InstantaneousStrideLengthCM:")
+                                 << InstantaneousStrideLengthCM.value();
             if (InstantaneousStrideLengthCM.value() == 0) {
                 GroundContactMS.setValue(0);
                 VerticalOscillationMM.setValue(0);
                 emit groundContactChanged(GroundContactMS.value());
                 emit verticalOscillationChanged(VerticalOscillationMM.value());
-                qDebug() << QStringLiteral("Current GroundContactMS:") << GroundContactMS.value();
-                qDebug() << QStringLiteral("Current VerticalOscillationMM:") << VerticalOscillationMM.value();
+                qCDebug(qzTreadmill) << QStringLiteral("Current GroundContactMS:") << GroundContactMS.value();
+                qCDebug(qzTreadmill) << QStringLiteral("Current VerticalOscillationMM:")
+                                     << VerticalOscillationMM.value();
             }
         }
 
         Cadence = cadence;
         emit cadenceChanged(cadence);
-        emit debug(QStringLiteral("Current Cadence: ") + QString::number(cadence));
+        QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("Current Cadence: ") + QString::number(cadence));
     }
 
     if (heartRateBeltName.startsWith(QStringLiteral("Disabled"))) {
@@ -1986,8 +1899,10 @@ void horizontreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
     }
 
     if (m_control->error() != QLowEnergyController::NoError) {
-        qDebug() << QStringLiteral("QLowEnergyController ERROR!!") << m_control->errorString();
+        qCDebug(qzTreadmill) << QStringLiteral("QLowEnergyController ERROR!!") << m_control->errorString();
     }
+
+    emit metricsUpdated();
 }
 
 void horizontreadmill::stateChanged(QLowEnergyService::ServiceState state) {
@@ -2150,7 +2065,7 @@ void horizontreadmill::descriptorRead(const QLowEnergyDescriptor &descriptor, co
 void horizontreadmill::characteristicWritten(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
     Q_UNUSED(characteristic);
-    emit debug(QStringLiteral("characteristicWritten ") + newValue.toHex(' '));
+    QZ_EMIT_DEBUG(qzTreadmill, QStringLiteral("characteristicWritten ") + newValue.toHex(' '));
 }
 
 void horizontreadmill::characteristicRead(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
@@ -263,8 +263,8 @@ void iconceptbike::readSocket() {
                 settings.value(QZSettings::bh_spada_2_watt, QZSettings::default_bh_spada_2_watt).toBool();
             elapsed = GetElapsedTimeFromPacket(line);
             //Distance = GetDistanceFromPacket(line);
-            QDateTime now = QDateTime::currentDateTime();
-            Distance += ((Speed.value() / 3600000.0) * ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+            const qint64 now = monotonicclock::msecs();
+            Distance += ((Speed.value() / 3600000.0) * ((double)(now - lastRefreshCharacteristicChanged)));
             KCal = GetCaloriesFromPacket(line);
             if (bh_spada_2_watt) {
                 m_watt = GetWattFromPacket(line);
@@ -273,7 +273,7 @@ void iconceptbike::readSocket() {
                 } else {
                     Speed = metric::calculateSpeedFromPower(
                         watts(), Inclination.value(), Speed.value(),
-                        fabs(QDateTime::currentDateTime().msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                        Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
                 }
                 if (watts())
                     KCal +=
@@ -281,9 +281,8 @@ void iconceptbike::readSocket() {
                            settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                           200.0) /
                          (60000.0 /
-                          ((double)lastRefreshCharacteristicChanged.msecsTo(
-                              now)))); //(( (0.048* Output in watts +1.19) * body weight in kg
-                                                                //* 3.5) / 200 ) / 60
+                          ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                // body weight in kg * 3.5) / 200 ) / 60
             } else {
                 Speed = GetSpeedFromPacket(line);
             }
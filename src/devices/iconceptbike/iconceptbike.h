@@ -28,6 +28,7 @@
 #include <QObject>
 
 #include "devices/bike.h"
+#include "monotonicclock.h"
 
 class iconceptbike : public bike {
     Q_OBJECT
@@ -61,7 +62,7 @@ class iconceptbike : public bike {
     double GetSpeedFromPacket(const QByteArray &packet);
     double GetWattFromPacket(const QByteArray &packet);
 
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
     uint16_t watts() override;
     
@@ -226,7 +226,7 @@ void iconceptelliptical::readSocket() {
             Cadence = (uint8_t)line.at(13);
             // Heart = GetHeartRateFromPacket(line);
 
-            lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+            lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
 #ifdef Q_OS_ANDROID
             if (settings.value(QZSettings::ant_heart, QZSettings::default_ant_heart).toBool()) {
@@ -28,6 +28,7 @@
 #include <QObject>
 
 #include "devices/elliptical.h"
+#include "monotonicclock.h"
 #include "virtualdevices/virtualbike.h"
 #include "virtualdevices/virtualtreadmill.h"
 
@@ -68,7 +69,7 @@ class iconceptelliptical : public elliptical {
     uint16_t GetCaloriesFromPacket(const QByteArray &packet);
     double GetSpeedFromPacket(const QByteArray &packet);
 
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
     uint16_t watts();
 
@@ -331,13 +331,12 @@ void kingsmithr1protreadmill::characteristicChanged(const QLowEnergyCharacterist
                     1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastTimeCharacteristicChanged.msecsTo(
-                                QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in
-        // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(monotonicclock::msecs() - lastTimeCharacteristicChanged)))); //(( (0.048* Output
+        // in watts +1.19) * body weight in kg * 3.5) / 200 ) / 60
 
         Distance += ((speed / (double)3600.0) /
-                     ((double)1000.0 / (double)(lastTimeCharacteristicChanged.msecsTo(QDateTime::currentDateTime()))));
-        lastTimeCharacteristicChanged = QDateTime::currentDateTime();
+                     ((double)1000.0 / (double)(monotonicclock::msecs() - lastTimeCharacteristicChanged)));
+        lastTimeCharacteristicChanged = monotonicclock::msecs();
     }
 
     bool disable_hr_frommachinery =
@@ -350,11 +349,11 @@ void kingsmithr1protreadmill::characteristicChanged(const QLowEnergyCharacterist
         double sc = GetStepsFromPacket(value);
         StepCount = sc;
         if(lastStepCount < StepCount.value()) {
-            double c = (StepCount.value() - lastStepCount) / (lastTimeStepCountChanged.msecsTo(QDateTime::currentDateTime()) / 60000.0);
+            double c = (StepCount.value() - lastStepCount) / ((monotonicclock::msecs() - lastTimeStepCountChanged) / 60000.0);
             if(c < 255)
                 cadenceRaw = c;
             Cadence = cadenceRaw.average5s();
-            lastTimeStepCountChanged = QDateTime::currentDateTime();
+            lastTimeStepCountChanged = monotonicclock::msecs();
         }
         lastStepCount = sc;
     }    
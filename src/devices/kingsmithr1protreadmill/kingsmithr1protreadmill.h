@@ -28,6 +28,7 @@
 #include <QObject>
 
 #include "treadmill.h"
+#include "monotonicclock.h"
 
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
@@ -69,8 +70,8 @@ class kingsmithr1protreadmill : public treadmill {
     uint8_t firstInit = 0;
     double lastStepCount = 0;
     QByteArray lastPacket;
-    QDateTime lastTimeCharacteristicChanged;
-    QDateTime lastTimeStepCountChanged;
+    qint64 lastTimeCharacteristicChanged = monotonicclock::msecs();
+    qint64 lastTimeStepCountChanged = monotonicclock::msecs();
     bool firstCharacteristicChanged = true;
     metric cadenceRaw;
 
@@ -344,13 +344,12 @@ void kingsmithr2treadmill::characteristicChanged(const QLowEnergyCharacteristic
                     1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastTimeCharacteristicChanged.msecsTo(
-                                QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in
-        // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(monotonicclock::msecs() - lastTimeCharacteristicChanged)))); //(( (0.048* Output
+        // in watts +1.19) * body weight in kg * 3.5) / 200 ) / 60
 
         Distance += ((speed / (double)3600.0) /
-                     ((double)1000.0 / (double)(lastTimeCharacteristicChanged.msecsTo(QDateTime::currentDateTime()))));
-        lastTimeCharacteristicChanged = QDateTime::currentDateTime();
+                     ((double)1000.0 / (double)(monotonicclock::msecs() - lastTimeCharacteristicChanged)));
+        lastTimeCharacteristicChanged = monotonicclock::msecs();
     }
 
     emit debug(QStringLiteral("Current speed: ") + QString::number(speed));
@@ -29,6 +29,7 @@
 #include <QObject>
 
 #include "treadmill.h"
+#include "monotonicclock.h"
 
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
@@ -79,7 +80,7 @@ class kingsmithr2treadmill : public treadmill {
     QMap<QString, double> props;
     QByteArray buffer;
     QByteArray lastValue;
-    QDateTime lastTimeCharacteristicChanged;
+    qint64 lastTimeCharacteristicChanged = monotonicclock::msecs();
     bool firstCharacteristicChanged = true;
 
     QTimer *refresh;
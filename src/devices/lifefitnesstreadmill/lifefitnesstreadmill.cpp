@@ -339,7 +339,7 @@ void lifefitnesstreadmill::characteristicChanged(const QLowEnergyCharacteristic
         {
             if (firstDistanceCalculated)
                 Distance += ((Speed.value() / 3600000.0) *
-                             ((double)lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime())));
+                             ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)));
             distanceEval = true;
         }
 
@@ -385,9 +385,8 @@ void lifefitnesstreadmill::characteristicChanged(const QLowEnergyCharacteristic
                        settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                       200.0) /
                      (60000.0 /
-                      ((double)lastRefreshCharacteristicChanged.msecsTo(
-                          QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                            // kg * 3.5) / 200 ) / 60
+                      ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in
+                                                            // watts +1.19) * body weight in kg * 3.5) / 200 ) / 60
             distanceEval = true;
         }
 
@@ -482,7 +481,7 @@ void lifefitnesstreadmill::characteristicChanged(const QLowEnergyCharacteristic
         } else {
             if (firstDistanceCalculated)
                 Distance += ((Speed.value() / 3600000.0) *
-                             ((double)lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime())));
+                             ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)));
             distanceEval = true;
         }
 
@@ -562,9 +561,8 @@ void lifefitnesstreadmill::characteristicChanged(const QLowEnergyCharacteristic
                        settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                       200.0) /
                      (60000.0 /
-                      ((double)lastRefreshCharacteristicChanged.msecsTo(
-                          QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                            // kg * 3.5) / 200 ) / 60
+                      ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in
+                                                            // watts +1.19) * body weight in kg * 3.5) / 200 ) / 60
             distanceEval = true;
         }
 
@@ -615,7 +613,7 @@ void lifefitnesstreadmill::characteristicChanged(const QLowEnergyCharacteristic
 
     if (distanceEval) {
         firstDistanceCalculated = true;
-        lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+        lastRefreshCharacteristicChanged = monotonicclock::msecs();
     }
 
     if (m_control->error() != QLowEnergyController::NoError) {
@@ -29,6 +29,7 @@
 #include <QString>
 
 #include "treadmill.h"
+#include "monotonicclock.h"
 #include "virtualdevices/virtualbike.h"
 #include "virtualdevices/virtualtreadmill.h"
 
@@ -72,7 +73,7 @@ class lifefitnesstreadmill : public treadmill {
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
     QByteArray lastPacketComplete;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
     bool firstDistanceCalculated = false;
     uint8_t firstStateChanged = 0;
     double lastSpeed = 0.0;
@@ -678,7 +678,7 @@ void m3ibike::processAdvertising(const QByteArray &data) {
         if (!settings.value(QZSettings::speed_power_based, QZSettings::default_speed_power_based).toBool()) {
             Speed = k3.speed;
         } else {
-            Speed = metric::calculateSpeedFromPower(watts(),  Inclination.value(), Speed.value(),fabs(QDateTime::currentDateTime().msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+            Speed = metric::calculateSpeedFromPower(watts(),  Inclination.value(), Speed.value(),Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
         }
         if (settings.value(QZSettings::m3i_bike_kcal, QZSettings::default_m3i_bike_kcal).toBool()) {
             KCal = k3.calorie;
@@ -687,7 +687,7 @@ void m3ibike::processAdvertising(const QByteArray &data) {
                 KCal += ((((0.048 * ((double)watts()) + 1.19) *
                            settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                           200.0) /
-                         (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime()))));
+                         (60000.0 / ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged))));
         }
         Distance = k3.distance;
         if (!not_in_pause || k3.time_orig <= 10) {
@@ -710,7 +710,7 @@ void m3ibike::processAdvertising(const QByteArray &data) {
             LastCrankEventTime += (uint16_t)(1024.0 / (((double)(Cadence.value())) / 60.0));
         }
 
-        lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+        lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
 #ifdef Q_OS_ANDROID
         if (antHeart)
@@ -28,6 +28,7 @@
 #include <QString>
 
 #include "devices/bike.h"
+#include "monotonicclock.h"
 
 #ifdef Q_OS_IOS
 #include "ios/M3iIOS-Interface.h"
@@ -165,7 +166,7 @@ class m3ibike : public bike {
     keiser_m3i_out_t k3;
     qint64 lastTimerRestart = -1;
     int lastTimerRestartOffset = 0;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
     bool firstUpdate = true;
 
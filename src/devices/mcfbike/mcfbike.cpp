@@ -177,7 +177,7 @@ double mcfbike::bikeResistanceToPeloton(double resistance) {
 }
 
 void mcfbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -211,11 +211,11 @@ void mcfbike::characteristicChanged(const QLowEnergyCharacteristic &characterist
         } else {
             Speed = metric::calculateSpeedFromPower(
                 watts(), Inclination.value(), Speed.value(),
-                fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
         }
 
         Distance += ((Speed.value() / 3600000.0) *
-                     ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                     ((double)(now - lastRefreshCharacteristicChanged)));
 
         m_watt = (((uint16_t)newValue.at(9) << 8) | (uint16_t)((uint8_t)newValue.at(10)));
 
@@ -223,7 +223,7 @@ void mcfbike::characteristicChanged(const QLowEnergyCharacteristic &characterist
             KCal += ((((0.048 * ((double)watts()) + 1.19) *
                        settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                       200.0) /
-                     (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(now))));
+                     (60000.0 / ((double)(now - lastRefreshCharacteristicChanged))));
 
         if (Cadence.value() > 0) {
             CrankRevs++;
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "devices/bike.h"
+#include "monotonicclock.h"
 
 class nautilusbike : public bike {
     Q_OBJECT
@@ -69,7 +70,7 @@ class nautilusbike : public bike {
     bool searchStopped = false;
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
     bool B616 = false;
 
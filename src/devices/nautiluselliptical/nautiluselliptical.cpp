@@ -261,9 +261,9 @@ void nautiluselliptical::characteristicChanged(const QLowEnergyCharacteristic &c
             .toDouble();
     if (watts())
         KCal += ((((0.048 * ((double)watts()) + 1.19) * weight * 3.5) / 200.0) /
-                 (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)))); //(( (0.048*
+                                                                  // Output in watts +1.19) * body weight in kg * 3.5) /
+                                                                  // 200 ) / 60
     // double kcal = GetKcalFromPacket(newValue);
     // double distance = GetDistanceFromPacket(newValue) *
     // settings.value(QZSettings::domyos_elliptical_speed_ratio,
@@ -279,11 +279,11 @@ void nautiluselliptical::characteristicChanged(const QLowEnergyCharacteristic &c
     Speed = speed;
 
     Distance += ((Speed.value() / 3600000.0) *
-                 ((double)lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime())));
+                 ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)));
 
     CrankRevs++;
     LastCrankEventTime += (uint16_t)(1024.0 / (((double)(Cadence.value())) / 60.0));
-    lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
     emit debug(QStringLiteral("Current speed: ") + QString::number(speed));
     emit debug(QStringLiteral("Current cadence: ") + QString::number(Cadence.value()));
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "devices/elliptical.h"
+#include "monotonicclock.h"
 
 class nautiluselliptical : public elliptical {
     Q_OBJECT
@@ -65,7 +66,7 @@ class nautiluselliptical : public elliptical {
     bool searchStopped = false;
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
     uint8_t bt_variant =
         0; // with the same bluetooth name there are different bluetooth controller with different UUIDs
@@ -1062,14 +1062,14 @@ void nordictrackelliptical::characteristicChanged(const QLowEnergyCharacteristic
 
     if (watts())
         KCal += ((((0.048 * ((double)watts()) + 1.19) * weight * 3.5) / 200.0) /
-                 (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)))); //(( (0.048*
+                                                                  // Output in watts +1.19) * body weight in kg * 3.5) /
+                                                                  // 200 ) / 60
     // KCal = (((uint16_t)((uint8_t)newValue.at(15)) << 8) + (uint16_t)((uint8_t) newValue.at(14)));
     Distance += ((Speed.value() / 3600000.0) *
-                 ((double)lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime())));
+                 ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)));
 
-    lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
     if (disable_hr_frommachinery) {
 #ifdef Q_OS_ANDROID
@@ -20,6 +20,7 @@
 #include <QUdpSocket>
 
 #include "treadmill.h"
+#include "monotonicclock.h"
 
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
@@ -72,7 +73,7 @@ class nordictrackifitadbtreadmill : public treadmill {
     QTimer *refresh;
 
     uint8_t sec1Update = 0;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
     QDateTime lastInclinationChanged = QDateTime::currentDateTime();
     uint8_t firstStateChanged = 0;
     uint16_t m_watts = 0;
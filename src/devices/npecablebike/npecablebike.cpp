@@ -111,7 +111,7 @@ void npecablebike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void npecablebike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -169,7 +169,7 @@ void npecablebike::characteristicChanged(const QLowEnergyCharacteristic &charact
                     Cadence = cadence;
                 }
                 lastGoodCadence = now;
-            } else if (lastGoodCadence.msecsTo(now) > 2000) {
+            } else if ((now - lastGoodCadence) > 2000) {
                 Cadence = 0;
             }
         }
@@ -182,12 +182,12 @@ void npecablebike::characteristicChanged(const QLowEnergyCharacteristic &charact
         if (!settings.value(QZSettings::speed_power_based, QZSettings::default_speed_power_based).toBool()) {
             Speed = Cadence.value() * settings.value(QZSettings::cadence_sensor_speed_ratio, QZSettings::default_cadence_sensor_speed_ratio).toDouble();
         } else {
-            Speed = metric::calculateSpeedFromPower(watts(),  Inclination.value(), Speed.value(),fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+            Speed = metric::calculateSpeedFromPower(watts(),  Inclination.value(), Speed.value(),Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
         }
         emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
 
         Distance += ((Speed.value() / 3600000.0) *
-                     ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                     ((double)(now - lastRefreshCharacteristicChanged)));
         emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
         // Resistance = ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
@@ -200,9 +200,8 @@ void npecablebike::characteristicChanged(const QLowEnergyCharacteristic &charact
                 ((((0.048 * ((double)watts()) + 1.19) * settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() *
                    3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                  // body weight in kg * 3.5) / 200 ) / 60
         emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
     } else if (characteristic.uuid() == QBluetoothUuid::HeartRateMeasurement) {
         if (newValue.length() > 1) {
@@ -251,7 +250,7 @@ void npecablebike::characteristicChanged(const QLowEnergyCharacteristic &charact
                                   (uint16_t)((uint8_t)newValue.at(index)))) /
                         100.0;
             } else {
-                Speed = metric::calculateSpeedFromPower(watts(), Inclination.value(), Speed.value(),fabs(now.msecsTo(Speed.lastChanged()) / 1000.0),  this->speedLimit());
+                Speed = metric::calculateSpeedFromPower(watts(), Inclination.value(), Speed.value(),Speed.msecsSinceLastChanged() / 1000.0,  this->speedLimit());
             }
             index += 2;
             emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
@@ -295,7 +294,7 @@ void npecablebike::characteristicChanged(const QLowEnergyCharacteristic &charact
             index += 3;
         } else {
             Distance += ((Speed.value() / 3600000.0) *
-                         ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                         ((double)(now - lastRefreshCharacteristicChanged)));
         }
 
         emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
@@ -362,9 +361,8 @@ void npecablebike::characteristicChanged(const QLowEnergyCharacteristic &charact
                     ((((0.048 * ((double)watts()) + 1.19) * settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() *
                        3.5) /
                       200.0) /
-                     (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                    now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                      // kg * 3.5) / 200 ) / 60
+                     (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts
+                                                                      // +1.19) * body weight in kg * 3.5) / 200 ) / 60
         }
 
         emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
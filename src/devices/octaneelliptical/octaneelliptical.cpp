@@ -340,7 +340,7 @@ void octaneelliptical::characteristicChanged(const QLowEnergyCharacteristic &cha
 
     emit packetReceived();
 
-    if (lastTimeCharacteristicChanged.secsTo(QDateTime::currentDateTime()) > 5) {
+    if ((monotonicclock::msecs() - lastTimeCharacteristicChanged) / 1000 > 5) {
         emit debug(QStringLiteral("resetting speed"));
         Speed = 0;
     }
@@ -415,12 +415,12 @@ void octaneelliptical::characteristicChanged(const QLowEnergyCharacteristic &cha
                 (((((0.048 * ((double)watts()) + 1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastTimeCharacteristicChanged.msecsTo(
-                                QDateTime::currentDateTime())))) / 2.0); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(monotonicclock::msecs() - lastTimeCharacteristicChanged)))) / 2.0); //(( (0.048*
+                                                                  // Output in watts +1.19) * body weight in kg * 3.5) /
+                                                                  // 200 ) / 60
         Distance += ((Speed.value() / 3600000.0) *
-                     ((double)lastTimeCharacteristicChanged.msecsTo(QDateTime::currentDateTime())));
-        lastTimeCharacteristicChanged = QDateTime::currentDateTime();
+                     ((double)(monotonicclock::msecs() - lastTimeCharacteristicChanged)));
+        lastTimeCharacteristicChanged = monotonicclock::msecs();
     }
 
     emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
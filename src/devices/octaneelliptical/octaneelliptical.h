@@ -26,6 +26,7 @@
 #include <QObject>
 
 #include "devices/elliptical.h"
+#include "monotonicclock.h"
 #include "virtualdevices/virtualtreadmill.h"
 
 class octaneelliptical : public elliptical {
@@ -54,7 +55,7 @@ class octaneelliptical : public elliptical {
     uint8_t sec1Update = 0;
     uint8_t firstInit = 0;
     QByteArray lastPacket;
-    QDateTime lastTimeCharacteristicChanged;
+    qint64 lastTimeCharacteristicChanged = monotonicclock::msecs();
     bool firstCharacteristicChanged = true;
 
     int64_t lastStart = 0;
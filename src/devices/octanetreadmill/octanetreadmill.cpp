@@ -346,12 +346,12 @@ void octanetreadmill::characteristicChanged(const QLowEnergyCharacteristic &char
 
     emit packetReceived();
 
-    if (ZR8 == false && lastTimeCharacteristicChanged.secsTo(QDateTime::currentDateTime()) > 5) {
+    if (ZR8 == false && (monotonicclock::msecs() - lastTimeCharacteristicChanged) / 1000 > 5) {
         emit debug(QStringLiteral("resetting speed"));
         Speed = 0;
         Cadence = 0;
-    } else if (ZR8 == true && Speed.lastChanged().secsTo(QDateTime::currentDateTime()) > 15 &&
-               Cadence.lastChanged().secsTo(QDateTime::currentDateTime()) > 15) {
+    } else if (ZR8 == true && Speed.msecsSinceLastChanged() > 15000 &&
+               Cadence.msecsSinceLastChanged() > 15000) {
         emit debug(QStringLiteral("resetting speed"));
         Speed = 0;
         Cadence = 0;
@@ -419,12 +419,12 @@ void octanetreadmill::characteristicChanged(const QLowEnergyCharacteristic &char
                     1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastTimeCharacteristicChanged.msecsTo(
-                                QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(monotonicclock::msecs() - lastTimeCharacteristicChanged)))); //(( (0.048* Output
+                                                                  // in watts +1.19) * body weight in kg * 3.5) / 200 )
+                                                                  // / 60
 
         Distance += ((Speed.value() / 3600.0) /
-                     (1000.0 / (lastTimeCharacteristicChanged.msecsTo(QDateTime::currentDateTime()))));
+                     (1000.0 / (monotonicclock::msecs() - lastTimeCharacteristicChanged)));
     }
 
     // ZR8 has builtin cadence sensor
@@ -438,7 +438,7 @@ void octanetreadmill::characteristicChanged(const QLowEnergyCharacteristic &char
         qDebug() << QStringLiteral("QLowEnergyController ERROR!!") << m_control->errorString();
     }
 
-    lastTimeCharacteristicChanged = QDateTime::currentDateTime();
+    lastTimeCharacteristicChanged = monotonicclock::msecs();
     firstCharacteristicChanged = false;
 }
 
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "rower.h"
+#include "monotonicclock.h"
 
 
 #ifdef Q_OS_IOS
@@ -61,7 +62,7 @@ class proformrower : public rower {
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
     uint8_t firstStateChanged = 0;
     uint16_t m_watts = 0;
 
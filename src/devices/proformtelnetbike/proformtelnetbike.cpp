@@ -321,7 +321,7 @@ void proformtelnetbike::characteristicChanged(const char *buff, int len) {
         } else {
             Speed = metric::calculateSpeedFromPower(
                 watts(), Inclination.value(), Speed.value(),
-                fabs(QDateTime::currentDateTime().msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
         }
     }
 
@@ -330,11 +330,10 @@ void proformtelnetbike::characteristicChanged(const char *buff, int len) {
             ((((0.048 * ((double)watts()) + 1.19) *
                settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
               200.0) /
-             (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                            QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in kg
-                                                              //* 3.5) / 200 ) / 60
+             (60000.0 / ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in
+                                                              // watts +1.19) * body weight in kg * 3.5) / 200 ) / 60
         Distance += ((Speed.value() / (double)3600.0) /
-                     ((double)1000.0 / (double)(lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime()))));
+                     ((double)1000.0 / (double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)));
     }
     /*
         Resistance = resistance;
@@ -359,7 +358,7 @@ void proformtelnetbike::characteristicChanged(const char *buff, int len) {
         }
     }
 
-    lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
 #ifdef Q_OS_IOS
 #ifndef IO_UNDER_QT
@@ -35,6 +35,7 @@
 #include <QString>
 
 #include "devices/bike.h"
+#include "monotonicclock.h"
 
 #include "QTelnet.h"
 
@@ -77,7 +78,7 @@ class proformtelnetbike : public bike {
 
     uint8_t sec1Update = 0;
     QString lastPacket;
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
     uint8_t firstStateChanged = 0;
     metric target_watts;
 
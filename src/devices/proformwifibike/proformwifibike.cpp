@@ -323,7 +323,7 @@ void proformwifibike::update() {
             // updateDisplay(elapsed);
         }
 
-        if(lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime()) > 10000) {
+        if((monotonicclock::msecs() - lastRefreshCharacteristicChanged) > 10000) {
 
             Speed = 0;
             m_watt = 0;
@@ -413,7 +413,7 @@ void proformwifibike::serviceDiscovered(const QBluetoothUuid &gatt) {
 void proformwifibike::binaryMessageReceived(const QByteArray &message) { characteristicChanged(message); }
 
 void proformwifibike::characteristicChanged(const QString &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     QSettings settings;
     QString heartRateBeltName =
@@ -462,10 +462,10 @@ void proformwifibike::characteristicChanged(const QString &newValue) {
     } else {
         Speed = metric::calculateSpeedFromPower(
             watts(), Inclination.value(), Speed.value(),
-            fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+            Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
 
         Distance += ((Speed.value() / 3600000.0) *
-                    ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                    ((double)(now - lastRefreshCharacteristicChanged)));
     }
 
     if (!values[QStringLiteral("RPM")].isUndefined()) {
@@ -588,9 +588,8 @@ void proformwifibike::characteristicChanged(const QString &newValue) {
             ((((0.048 * ((double)watts()) + 1.19) *
                settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
               200.0) /
-             (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                            now)))); //(( (0.048* Output in watts +1.19) * body weight in kg
-                                                              //* 3.5) / 200 ) / 60
+             (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) * body
+                                                              // weight in kg * 3.5) / 200 ) / 60
                                                               /*
                                                                   Resistance = resistance;
                                                                   m_pelotonResistance = (100 / 32) * Resistance.value();
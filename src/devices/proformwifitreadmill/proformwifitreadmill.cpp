@@ -257,9 +257,8 @@ void proformwifitreadmill::characteristicChanged(const QString &newValue) {
             ((((0.048 * ((double)watts()) + 1.19) *
                settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
               200.0) /
-             (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                            QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in kg
-                                                              //* 3.5) / 200 ) / 60
+             (60000.0 / ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in
+                                                              // watts +1.19) * body weight in kg * 3.5) / 200 ) / 60
     /*
                                                                   Resistance = resistance;
                                                                   m_pelotonResistance = (100 / 32) * Resistance.value();
@@ -271,7 +270,7 @@ void proformwifitreadmill::characteristicChanged(const QString &newValue) {
         emit debug(QStringLiteral("Current Heart: ") + QString::number(Heart.value()));
     }
 
-    lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
 #ifdef Q_OS_ANDROID
     if (settings.value(QZSettings::ant_heart, QZSettings::default_ant_heart).toBool())
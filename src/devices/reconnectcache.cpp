@@ -0,0 +1,93 @@
+#include "devices/reconnectcache.h"
+#include "qzsettings.h"
+#include <QBluetoothAddress>
+#include <QStringList>
+
+reconnectcache::entry reconnectcache::load(const QSettings &settings) {
+    entry e;
+    e.name =
+        settings.value(QZSettings::bluetooth_lastdevice_name, QZSettings::default_bluetooth_lastdevice_name).toString();
+    e.address =
+        settings.value(QZSettings::bluetooth_lastdevice_address, QZSettings::default_bluetooth_lastdevice_address)
+            .toString();
+    e.driver = settings.value(QZSettings::bluetooth_lastdevice_driver, QZSettings::default_bluetooth_lastdevice_driver)
+                   .toString();
+    const QStringList services =
+        settings.value(QZSettings::bluetooth_lastdevice_services, QZSettings::default_bluetooth_lastdevice_services)
+            .toString()
+            .split(QLatin1Char(','), Qt::SkipEmptyParts);
+    for (const QString &s : services) {
+        QBluetoothUuid uuid(s);
+        if (!uuid.isNull()) {
+            e.services.append(uuid);
+        }
+    }
+    e.timeToConnectedMs = settings
+                              .value(QZSettings::bluetooth_lastdevice_time_to_connected,
+                                     QZSettings::default_bluetooth_lastdevice_time_to_connected)
+                              .toLongLong();
+    e.timeToFirstMetricMs = settings
+                                .value(QZSettings::bluetooth_lastdevice_time_to_first_metric,
+                                       QZSettings::default_bluetooth_lastdevice_time_to_first_metric)
+                                .toLongLong();
+    return e;
+}
+
+void reconnectcache::save(QSettings &settings, const entry &e) {
+    QStringList services;
+    for (const QBluetoothUuid &uuid : e.services) {
+        services.append(uuid.toString());
+    }
+    settings.setValue(QZSettings::bluetooth_lastdevice_name, e.name);
+    settings.setValue(QZSettings::bluetooth_lastdevice_address, e.address);
+    settings.setValue(QZSettings::bluetooth_lastdevice_driver, e.driver);
+    settings.setValue(QZSettings::bluetooth_lastdevice_services, services.join(QLatin1Char(',')));
+    saveTimings(settings, e.timeToConnectedMs, e.timeToFirstMetricMs);
+}
+
+void reconnectcache::invalidate(QSettings &settings) {
+    // the name and the address are still the last device for the rest of the app: without the driver the entry
+    // isn't valid anymore
+    settings.setValue(QZSettings::bluetooth_lastdevice_driver, QZSettings::default_bluetooth_lastdevice_driver);
+    settings.setValue(QZSettings::bluetooth_lastdevice_services, QZSettings::default_bluetooth_lastdevice_services);
+}
+
+void reconnectcache::saveTimings(QSettings &settings, qint64 timeToConnectedMs, qint64 timeToFirstMetricMs) {
+    settings.setValue(QZSettings::bluetooth_lastdevice_time_to_connected, timeToConnectedMs);
+    settings.setValue(QZSettings::bluetooth_lastdevice_time_to_first_metric, timeToFirstMetricMs);
+}
+
+bool reconnectcache::cacheable(const QBluetoothDeviceInfo &device) {
+    if (device.name().isEmpty()) {
+        return false;
+    }
+#ifndef Q_OS_IOS
+    return !device.address().isNull();
+#else
+    return !device.deviceUuid().isNull();
+#endif
+}
+
+reconnectcache::entry reconnectcache::fromDevice(const QBluetoothDeviceInfo &device, const QString &driver) {
+    entry e;
+    e.name = device.name();
+#ifndef Q_OS_IOS
+    e.address = device.address().toString();
+#else
+    e.address = device.deviceUuid().toString();
+#endif
+    e.driver = driver;
+    e.services = device.serviceUuids();
+    return e;
+}
+
+QBluetoothDeviceInfo reconnectcache::deviceInfo(const entry &e) {
+#ifndef Q_OS_IOS
+    QBluetoothDeviceInfo device(QBluetoothAddress(e.address), e.name, 0);
+#else
+    QBluetoothDeviceInfo device(QBluetoothUuid(e.address), e.name, 0);
+#endif
+    device.setCoreConfigurations(QBluetoothDeviceInfo::LowEnergyCoreConfiguration);
+    device.setServiceUuids(e.services);
+    return device;
+}
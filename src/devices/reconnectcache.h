@@ -0,0 +1,58 @@
+#ifndef RECONNECTCACHE_H
+#define RECONNECTCACHE_H
+
+#include <QBluetoothDeviceInfo>
+#include <QBluetoothUuid>
+#include <QSettings>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief The device of the last session that connected, stored in the settings, so the next start can connect to it
+ * directly instead of waiting for the scan to find it again.
+ *
+ * The entry keeps what bluetooth::deviceDiscovered needs to resolve the same driver without an advertisement: the
+ * name, the address (the device UUID on iOS), the advertised service UUIDs and the class name of the driver it was
+ * resolved to. It's written when the driver is connected and discovered and invalidated when a direct connection to it
+ * fails, so the next start scans.
+ */
+class reconnectcache {
+
+  public:
+    struct entry {
+        QString name;
+        // the address, or the device UUID on iOS
+        QString address;
+        // the class name of the driver
+        QString driver;
+        QVector<QBluetoothUuid> services;
+        // from the start of the bluetooth discovery, of the session that wrote the entry. -1 if not measured
+        qint64 timeToConnectedMs = -1;
+        qint64 timeToFirstMetricMs = -1;
+
+        bool isValid() const { return !name.isEmpty() && !address.isEmpty() && !driver.isEmpty(); }
+    };
+
+    static entry load(const QSettings &settings);
+    static void save(QSettings &settings, const entry &e);
+    static void invalidate(QSettings &settings);
+
+    /**
+     * @brief Stores the timings of the current session in the entry.
+     */
+    static void saveTimings(QSettings &settings, qint64 timeToConnectedMs, qint64 timeToFirstMetricMs);
+
+    /**
+     * @brief Tells if a device can be connected without a scan: the fake, wifi and serial devices have no address.
+     */
+    static bool cacheable(const QBluetoothDeviceInfo &device);
+
+    static entry fromDevice(const QBluetoothDeviceInfo &device, const QString &driver);
+
+    /**
+     * @brief The device info to feed to bluetooth::deviceDiscovered in place of an advertisement.
+     */
+    static QBluetoothDeviceInfo deviceInfo(const entry &e);
+};
+
+#endif // RECONNECTCACHE_H
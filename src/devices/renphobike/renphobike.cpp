@@ -29,35 +29,17 @@ renphobike::renphobike(bool noWriteResistance, bool noHeartService) {
 
 void renphobike::writeCharacteristic(uint8_t *data, uint8_t data_len, QString info, bool disable_log,
                                      bool wait_for_response) {
-    QEventLoop loop;
-    QTimer timeout;
-
     if (gattFTMSService == nullptr) {
         qDebug() << QStringLiteral("gattFTMSService not found! skip writing...");
         return;
     }
 
-    if (wait_for_response) {
-        connect(gattFTMSService, SIGNAL(characteristicChanged(QLowEnergyCharacteristic, QByteArray)), &loop,
-                SLOT(quit()));
-        timeout.singleShot(300, &loop, SLOT(quit()));
-    } else {
-        connect(gattFTMSService, SIGNAL(characteristicWritten(QLowEnergyCharacteristic, QByteArray)), &loop,
-                SLOT(quit()));
-        timeout.singleShot(300, &loop, SLOT(quit()));
-    }
-
-    if (writeBuffer) {
-        delete writeBuffer;
-    }
-    writeBuffer = new QByteArray((const char *)data, data_len);
-
-    gattFTMSService->writeCharacteristic(gattWriteCharControlPointId, *writeBuffer);
+    QByteArray buffer((const char *)data, data_len);
+    writeQueue()->write(gattFTMSService, gattWriteCharControlPointId, buffer, QLowEnergyService::WriteWithResponse,
+                        wait_for_response);
 
     if (!disable_log)
-        debug(" >> " + writeBuffer->toHex(' ') + " // " + info);
-
-    loop.exec();
+        debug(" >> " + buffer.toHex(' ') + " // " + info);
 }
 
 void renphobike::forcePower(int16_t requestPower) {
@@ -175,7 +157,7 @@ void renphobike::update() {
 void renphobike::serviceDiscovered(const QBluetoothUuid &gatt) { debug("serviceDiscovered " + gatt.toString()); }
 
 void renphobike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -226,7 +208,7 @@ void renphobike::characteristicChanged(const QLowEnergyCharacteristic &character
         else
             Speed = metric::calculateSpeedFromPower(
                 watts(), Inclination.value(), Speed.value(),
-                fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
         index += 2;
         debug("Current Speed: " + QString::number(Speed.value()));
     }
@@ -268,7 +250,7 @@ void renphobike::characteristicChanged(const QLowEnergyCharacteristic &character
         index += 3;
     } else {
         Distance += ((Speed.value() / 3600000.0) *
-                     ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                     ((double)(now - lastRefreshCharacteristicChanged)));
     }
 
     debug("Current Distance: " + QString::number(Distance.value()));
@@ -320,9 +302,8 @@ void renphobike::characteristicChanged(const QLowEnergyCharacteristic &character
                 ((((0.048 * ((double)watts()) + 1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                                  // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                                                  // body weight in kg * 3.5) / 200 ) / 60
     }
 
     debug("Current KCal: " + QString::number(KCal.value()));
@@ -584,12 +565,7 @@ void renphobike::ftmsCharacteristicChanged(const QLowEnergyCharacteristic &chara
             }
         }
 
-        if (writeBuffer) {
-            delete writeBuffer;
-        }
-        writeBuffer = new QByteArray(lastFTMSPacketReceived);
-
-        gattFTMSService->writeCharacteristic(gattWriteCharControlPointId, *writeBuffer);
+        writeQueue()->write(gattFTMSService, gattWriteCharControlPointId, lastFTMSPacketReceived);
     }
 }
 
@@ -509,7 +509,7 @@ void solef80treadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
         if (paused) {
             qDebug() << "solef80treadmill inclination mode paused on, resetting timer...";
             Speed = 0;
-            lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+            lastRefreshCharacteristicChanged = monotonicclock::msecs();
         }
     }
 
@@ -520,7 +520,7 @@ void solef80treadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
         if (settings.value(QZSettings::sole_treadmill_miles, QZSettings::default_sole_treadmill_miles).toBool())
             miles = 1.60934;
 
-        QDateTime now = QDateTime::currentDateTime();
+        const qint64 now = monotonicclock::msecs();
 
         Speed = ((double)((uint8_t)newValue.at(10)) / 10.0) * miles;
         emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
@@ -533,7 +533,7 @@ void solef80treadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
             emit debug(QStringLiteral("Current Heart: ") + QString::number(heart));
         }
 
-        Distance += ((Speed.value() / 3600000.0) * ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+        Distance += ((Speed.value() / 3600000.0) * ((double)(now - lastRefreshCharacteristicChanged)));
 
         if (watts(settings.value(QZSettings::weight, QZSettings::default_weight).toFloat()))
             KCal +=
@@ -541,9 +541,8 @@ void solef80treadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                     1.19) *
                    settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                   200.0) /
-                 (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                         // kg * 3.5) / 200 ) / 60
+                 (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) *
+                                         // body weight in kg * 3.5) / 200 ) / 60
         emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
         lastRefreshCharacteristicChanged = now;
@@ -604,7 +603,7 @@ void solef80treadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
             emit debug(QStringLiteral("Current Average Speed: ") + QString::number(avgSpeed));
         }
 
-        QDateTime now = QDateTime::currentDateTime();
+        const qint64 now = monotonicclock::msecs();
         if (Flags.totalDistance) {
             // ignoring the distance, because it's a total life odometer
             // Distance = ((double)((((uint32_t)((uint8_t)newValue.at(index + 2)) << 16) |
@@ -614,7 +613,7 @@ void solef80treadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
         // else
         {
             Distance += ((Speed.value() / 3600000.0) *
-                         ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                         ((double)(now - lastRefreshCharacteristicChanged)));
         }
 
         emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
@@ -658,9 +657,8 @@ void solef80treadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                        settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                       200.0) /
                      (60000.0 /
-                      ((double)lastRefreshCharacteristicChanged.msecsTo(
-                          now)))); //(( (0.048* Output in watts +1.19) * body weight in
-                                                            // kg * 3.5) / 200 ) / 60
+                      ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) * body
+                                                            // weight in kg * 3.5) / 200 ) / 60
         }
 
         emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
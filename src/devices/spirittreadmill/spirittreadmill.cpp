@@ -269,7 +269,7 @@ void spirittreadmill::characteristicChanged(const QLowEnergyCharacteristic &char
         }*/
     }
 
-    Distance += ((Speed.value() / 3600000.0) * ((double)lastTimeCharChanged.msecsTo(QTime::currentTime())));
+    Distance += ((Speed.value() / 3600000.0) * ((double)(monotonicclock::msecs() - lastTimeCharChanged)));
 
     cadenceFromAppleWatch();
 
@@ -285,7 +285,7 @@ void spirittreadmill::characteristicChanged(const QLowEnergyCharacteristic &char
         qDebug() << QStringLiteral("QLowEnergyController ERROR!!") << m_control->errorString();
     }
 
-    lastTimeCharChanged = QTime::currentTime();
+    lastTimeCharChanged = monotonicclock::msecs();
 
     Speed = speed;
     KCal = kcal;
@@ -26,6 +26,7 @@
 #include <QTime>
 
 #include "treadmill.h"
+#include "monotonicclock.h"
 
 class spirittreadmill : public treadmill {
     Q_OBJECT
@@ -52,7 +53,7 @@ class spirittreadmill : public treadmill {
 
     uint8_t firstVirtualTreadmill = 0;
     bool firstCharChanged = true;
-    QTime lastTimeCharChanged;
+    qint64 lastTimeCharChanged = monotonicclock::msecs();
     uint8_t sec1update = 0;
     QByteArray lastPacket;
     uint8_t counterPoll = 0;
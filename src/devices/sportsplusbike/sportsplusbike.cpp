@@ -120,7 +120,7 @@ void sportsplusbike::serviceDiscovered(const QBluetoothUuid &gatt) {
 }
 
 void sportsplusbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -144,7 +144,7 @@ void sportsplusbike::characteristicChanged(const QLowEnergyCharacteristic &chara
         if (newValue.at(1) == 0x20) {
             double speed = GetSpeedFromPacket(newValue);
             if (!firstCharChanged) {
-                Distance += ((speed / 3600.0) / (1000.0 / (lastTimeCharChanged.msecsTo(now))));
+                Distance += ((speed / 3600.0) / (1000.0 / (now - lastTimeCharChanged)));
             }            
             cadence = (speed * 10.0) + 12.0;
             cadence_eval = true;
@@ -160,7 +160,7 @@ void sportsplusbike::characteristicChanged(const QLowEnergyCharacteristic &chara
                 m_watt = watt;
             Speed = metric::calculateSpeedFromPower(
                 watt, Inclination.value(), Speed.value(),
-                fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
             emit debug(QStringLiteral("Current speed: ") + QString::number(Speed.value()));
             // lastTimeWattChanged = QTime::currentTime();
         }
@@ -194,13 +194,13 @@ void sportsplusbike::characteristicChanged(const QLowEnergyCharacteristic &chara
         } else {
             Speed = metric::calculateSpeedFromPower(
                 watts(), Inclination.value(), Speed.value(),
-                fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
         }
         emit debug(QStringLiteral("Current speed: ") + QString::number(Speed.value()));
 
         if (!firstCharChanged) {
             Distance +=
-                ((Speed.value() / 3600.0) / (1000.0 / (lastTimeCharChanged.msecsTo(now))));
+                ((Speed.value() / 3600.0) / (1000.0 / (now - lastTimeCharChanged)));
         }
 
         lastTimeCharChanged = now;
@@ -208,9 +208,8 @@ void sportsplusbike::characteristicChanged(const QLowEnergyCharacteristic &chara
             ((((0.048 * ((double)watts()) + 1.19) *
                settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
               200.0) /
-             (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                            now)))); //(( (0.048* Output in watts +1.19) * body weight in kg
-                                                              //* 3.5) / 200 ) / 60
+             (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts +1.19) * body
+                                                              // weight in kg * 3.5) / 200 ) / 60
     } else {
         if (settings.value(QZSettings::power_sensor_name, QZSettings::default_power_sensor_name)
                 .toString()
@@ -226,7 +225,7 @@ void sportsplusbike::characteristicChanged(const QLowEnergyCharacteristic &chara
         cadence = speed * 2.685185;
         cadence_eval = true;
         if (!firstCharChanged) {
-            Distance += ((speed / 3600.0) / (1000.0 / (lastTimeCharChanged.msecsTo(now))));
+            Distance += ((speed / 3600.0) / (1000.0 / (now - lastTimeCharChanged)));
         }
         emit debug(QStringLiteral("Current speed: ") + QString::number(speed));
 
@@ -235,7 +234,7 @@ void sportsplusbike::characteristicChanged(const QLowEnergyCharacteristic &chara
         } else {
             Speed = metric::calculateSpeedFromPower(
                 watts(), Inclination.value(), Speed.value(),
-                fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
         }
         lastTimeCharChanged = now;
         kcal = GetKcalFromPacket(newValue);
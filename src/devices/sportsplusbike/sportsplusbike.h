@@ -26,6 +26,7 @@
 #include <QTime>
 
 #include "devices/bike.h"
+#include "monotonicclock.h"
 #include "virtualdevices/virtualbike.h"
 
 class sportsplusbike : public bike {
@@ -52,14 +53,14 @@ class sportsplusbike : public bike {
 
     QTimer *refresh;
 
-    QDateTime lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCharacteristicChanged = monotonicclock::msecs();
 
     bool noWriteResistance = false;
     bool noHeartService = false;
 
     uint8_t firstVirtualBike = 0;
     bool firstCharChanged = true;
-    QDateTime lastTimeCharChanged;
+    qint64 lastTimeCharChanged = monotonicclock::msecs();
     uint8_t sec1update = 0;
     QByteArray lastPacket;
 
@@ -160,7 +160,7 @@ void sportstechbike::characteristicChanged(const QLowEnergyCharacteristic &chara
     }
 
     if (!firstCharChanged) {
-        Distance += ((speed / 3600.0) / (1000.0 / (lastTimeCharChanged.msecsTo(QTime::currentTime()))));
+        Distance += ((speed / 3600.0) / (1000.0 / (monotonicclock::msecs() - lastTimeCharChanged)));
     }
 
     emit debug(QStringLiteral("Current speed: ") + QString::number(speed));
@@ -182,7 +182,7 @@ void sportstechbike::characteristicChanged(const QLowEnergyCharacteristic &chara
     } else {
         Speed = metric::calculateSpeedFromPower(
             watts(), Inclination.value(), Speed.value(),
-            fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+            Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
     }
     Resistance = requestResistance;
     emit resistanceRead(Resistance.value());
@@ -197,7 +197,7 @@ void sportstechbike::characteristicChanged(const QLowEnergyCharacteristic &chara
             .startsWith(QStringLiteral("Disabled")))
         m_watt = watt;
 
-    lastTimeCharChanged = QTime::currentTime();
+    lastTimeCharChanged = monotonicclock::msecs();
     firstCharChanged = false;
 }
 
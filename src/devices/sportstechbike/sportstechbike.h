@@ -26,6 +26,7 @@
 #include <QTime>
 
 #include "devices/bike.h"
+#include "monotonicclock.h"
 
 class sportstechbike : public bike {
     Q_OBJECT
@@ -62,7 +63,7 @@ class sportstechbike : public bike {
 
     uint8_t firstVirtualBike = 0;
     bool firstCharChanged = true;
-    QTime lastTimeCharChanged;
+    qint64 lastTimeCharChanged = monotonicclock::msecs();
     uint8_t sec1update = 0;
     QByteArray lastPacket;
 
@@ -167,7 +167,7 @@ uint16_t stagesbike::wattsFromResistance(double resistance) {
 }
 
 void stagesbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
-    QDateTime now = QDateTime::currentDateTime();
+    const qint64 now = monotonicclock::msecs();
     // qDebug() << "characteristicChanged" << characteristic.uuid() << newValue << newValue.length();
     Q_UNUSED(characteristic);
     QSettings settings;
@@ -267,7 +267,7 @@ void stagesbike::characteristicChanged(const QLowEnergyCharacteristic &character
                         Cadence = cadence;
                     }
                     lastGoodCadence = now;
-                } else if (lastGoodCadence.msecsTo(now) > 2000) {
+                } else if ((now - lastGoodCadence) > 2000) {
                     Cadence = 0;
                 }
             }
@@ -286,12 +286,12 @@ void stagesbike::characteristicChanged(const QLowEnergyCharacteristic &character
             } else {
                 Speed = metric::calculateSpeedFromPower(
                     watts(), Inclination.value(), Speed.value(),
-                    fabs(now.msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                    Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
             }
             emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
 
             Distance += ((Speed.value() / 3600000.0) *
-                         ((double)lastRefreshCharacteristicChanged.msecsTo(now)));
+                         ((double)(now - lastRefreshCharacteristicChanged)));
             emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
             // if we change this, also change the wattsFromResistance function. We can create a standard function in
@@ -342,9 +342,8 @@ void stagesbike::characteristicChanged(const QLowEnergyCharacteristic &character
                     ((((0.048 * ((double)watts()) + 1.19) *
                        settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                       200.0) /
-                     (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                    now)))); //(( (0.048* Output in watts +1.19) * body weight
-                                                                      // in kg * 3.5) / 200 ) / 60
+                     (60000.0 / ((double)(now - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in watts
+                                                                      // +1.19) * body weight in kg * 3.5) / 200 ) / 60
             emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
         }
     }
@@ -156,9 +156,9 @@ void strydrunpowersensor::characteristicChanged(const QLowEnergyCharacteristic &
             KCal += ((((0.048 * ((double)watts()) + 1.19) *
                        settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                       200.0) /
-                     (60000.0 / ((double)lastRefreshPowerChanged.msecsTo(QDateTime::currentDateTime()))));
+                     (60000.0 / ((double)(monotonicclock::msecs() - lastRefreshPowerChanged))));
         emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
-        lastRefreshPowerChanged = QDateTime::currentDateTime();
+        lastRefreshPowerChanged = monotonicclock::msecs();
     } else if (characteristic.uuid() == QBluetoothUuid::HeartRateMeasurement) {
         if (newValue.length() > 1) {
             Heart = (uint8_t)newValue[1];
@@ -226,7 +226,7 @@ void strydrunpowersensor::characteristicChanged(const QLowEnergyCharacteristic &
             /*
             if (firstDistanceCalculated)
                 Distance += ((Speed.value() / 3600000.0) *
-                             ((double)lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime())));
+                             ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)));
             distanceEval = true;*/
         }
 
@@ -276,9 +276,8 @@ void strydrunpowersensor::characteristicChanged(const QLowEnergyCharacteristic &
                        settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                       200.0) /
                      (60000.0 /
-                      ((double)lastRefreshCharacteristicChanged.msecsTo(
-                          QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight in
-                    // kg * 3.5) / 200 ) / 60
+                      ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)))); //(( (0.048* Output in
+                    // watts +1.19) * body weight in kg * 3.5) / 200 ) / 60
             distanceEval = true;
 */
         }
@@ -354,7 +353,7 @@ void strydrunpowersensor::characteristicChanged(const QLowEnergyCharacteristic &
 
             emit speedChanged(speed);
             Distance += ((Speed.value() / 3600000.0) *
-                         ((double)lastRefreshCadenceChanged.msecsTo(QDateTime::currentDateTime())));
+                         ((double)(monotonicclock::msecs() - lastRefreshCadenceChanged)));
             emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
             emit debug(QStringLiteral("Current Speed: ") + QString::number(speed));
             if (powerReceived == false) {
@@ -364,7 +363,7 @@ void strydrunpowersensor::characteristicChanged(const QLowEnergyCharacteristic &
             }
         }
         emit debug(QStringLiteral("Current Cadence: ") + QString::number(cadence));
-        lastRefreshCadenceChanged = QDateTime::currentDateTime();
+        lastRefreshCadenceChanged = monotonicclock::msecs();
     } else if (characteristic.uuid() == QBluetoothUuid::CSCMeasurement) {
         uint8_t index = 1;
         if (newValue.at(0) == 0x02) {
@@ -412,11 +411,11 @@ void strydrunpowersensor::characteristicChanged(const QLowEnergyCharacteristic &
 
             emit speedChanged(Speed.value());
             Distance += ((Speed.value() / 3600000.0) *
-                         ((double)lastRefreshCadenceChanged.msecsTo(QDateTime::currentDateTime())));
+                         ((double)(monotonicclock::msecs() - lastRefreshCadenceChanged)));
             emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
             emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
         }
-        lastRefreshCadenceChanged = QDateTime::currentDateTime();
+        lastRefreshCadenceChanged = monotonicclock::msecs();
 
     } else if (characteristic.uuid() == QBluetoothUuid(QStringLiteral("0000ff00-0000-1000-8000-00805f9b34fb"))) {
         if (newValue.length() == 5 && newValue.at(0) == 0x0f) {
@@ -27,6 +27,7 @@
 #include <QString>
 
 #include "treadmill.h"
+#include "monotonicclock.h"
 
 
 #ifdef Q_OS_IOS
@@ -52,8 +53,8 @@ class strydrunpowersensor : public treadmill {
 
     uint8_t sec1Update = 0;
     QByteArray lastPacket;
-    QDateTime lastRefreshCadenceChanged = QDateTime::currentDateTime();
-    QDateTime lastRefreshPowerChanged = QDateTime::currentDateTime();
+    qint64 lastRefreshCadenceChanged = monotonicclock::msecs();
+    qint64 lastRefreshPowerChanged = monotonicclock::msecs();
     QDateTime lastGoodCadence = QDateTime::currentDateTime();
     uint8_t firstStateChanged = 0;
 
@@ -7,7 +7,22 @@
 #endif
 #include <QSettings>
 
-treadmill::treadmill() {}
+treadmill::treadmill() {
+    // an incline takes seconds to move: it's sent the newest target at most twice per second
+    commands()->setChannel(
+        commandcoalescer::INCLINATION,
+        [this](double target) {
+            bool merged = requestInclination != -100;
+            requestInclination = target;
+            return merged;
+        },
+        500);
+    commands()->setChannel(commandcoalescer::POWER, [this](double target) {
+        bool merged = requestPower != -1;
+        requestPower = target;
+        return merged;
+    });
+}
 
 void treadmill::changeSpeed(double speed) {
     QSettings settings;
@@ -44,14 +59,16 @@ void treadmill::changeInclination(double grade, double inclination) {
              << m_inclination_difficult_offset;
     RequestedInclination = (grade * m_inclination_difficult) + m_inclination_difficult_offset;
     if (autoResistanceEnable) {
-        requestInclination = (grade * m_inclination_difficult) + m_inclination_difficult_offset;
+        commands()->request(commandcoalescer::INCLINATION,
+                            (grade * m_inclination_difficult) + m_inclination_difficult_offset, minStepInclination(),
+                            Inclination.value());
     }
 }
 void treadmill::changeSpeedAndInclination(double speed, double inclination) {
     changeSpeed(speed);
     changeInclination(inclination, inclination);
 }
-metric treadmill::currentInclination() { return Inclination; }
+const metric &treadmill::currentInclination() { return Inclination; }
 bool treadmill::connected() { return false; }
 bluetoothdevice::BLUETOOTH_TYPE treadmill::deviceType() { return bluetoothdevice::TREADMILL; }
 
@@ -60,8 +77,8 @@ double treadmill::minStepSpeed() { return 0.5; }
 
 void treadmill::update_metrics(bool watt_calc, const double watts) {
 
-    QDateTime current = QDateTime::currentDateTime();
-    double deltaTime = (((double)_lastTimeUpdate.msecsTo(current)) / ((double)1000.0));
+    const qint64 current = monotonicclock::msecs();
+    double deltaTime = (((double)(current - _lastTimeUpdate)) / ((double)1000.0));
     QSettings settings;
     bool power_as_treadmill =
         settings.value(QZSettings::power_sensor_as_treadmill, QZSettings::default_power_sensor_as_treadmill).toBool();
@@ -410,7 +427,7 @@ double treadmill::treadmillInclinationOverride(double Inclination) {
 }
 
 void treadmill::evaluateStepCount() {
-    StepCount += (Cadence.lastChanged().msecsTo(QDateTime::currentDateTime())) * (Cadence.value() / 60000);
+    StepCount += Cadence.msecsSinceLastChanged() * (Cadence.value() / 60000);
 }
 
 void treadmill::cadenceFromAppleWatch() {
@@ -518,7 +535,7 @@ void treadmill::changePower(int32_t power) {
         return;
     }
 
-    requestPower = power; // used by some bikes that have ERG mode builtin
+    commands()->request(commandcoalescer::POWER, power); // used by some bikes that have ERG mode builtin
     QSettings settings;
     /*
     double erg_filter_upper =
@@ -585,5 +602,5 @@ void treadmill::changePower(int32_t power) {
     changeSpeed((lowSpeed + highSpeed) / 2); // Return the best estimate
 }
 
-metric treadmill::lastRequestedPower() { return RequestedPower; }
+const metric &treadmill::lastRequestedPower() { return RequestedPower; }
 
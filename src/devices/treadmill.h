@@ -10,22 +10,22 @@ class treadmill : public bluetoothdevice {
   public:
     treadmill();
     void update_metrics(bool watt_calc, const double watts);
-    metric lastRequestedSpeed() { return RequestedSpeed; }
+    const metric &lastRequestedSpeed() { return RequestedSpeed; }
     QTime lastRequestedPace();
-    metric lastRequestedInclination() { return RequestedInclination; }
+    const metric &lastRequestedInclination() { return RequestedInclination; }
     bool connected() override;
-    metric currentInclination() override;
+    const metric &currentInclination() override;
     virtual double requestedSpeed();
     virtual double currentTargetSpeed();
     virtual double requestedInclination();
-    metric lastRequestedPower();
+    const metric &lastRequestedPower();
     virtual double minStepInclination();
     virtual double minStepSpeed();
     virtual bool canStartStop() { return true; }
-    metric currentStrideLength() { return InstantaneousStrideLengthCM; }
-    metric currentGroundContact() { return GroundContactMS; }
-    metric currentVerticalOscillation() { return VerticalOscillationMM; }
-    metric currentStepCount() { return StepCount; }
+    const metric &currentStrideLength() { return InstantaneousStrideLengthCM; }
+    const metric &currentGroundContact() { return GroundContactMS; }
+    const metric &currentVerticalOscillation() { return VerticalOscillationMM; }
+    const metric &currentStepCount() { return StepCount; }
     virtual uint16_t watts(double weight);
     static uint16_t wattsCalc(double weight, double speed, double inclination);
     bluetoothdevice::BLUETOOTH_TYPE deviceType() override;
@@ -230,7 +230,7 @@ void trxappgateusbbike::characteristicChanged(const QLowEnergyCharacteristic &ch
     double speed = 0.0;
     double resistance = 0.0;
     double watt = 0.0;
-    QTime now = QTime::currentTime();
+    const qint64 now = monotonicclock::msecs();
     if (bike_type == FYTTER_RI08) {
         speed = cadence * 0.37407407407407407407407407407407;
         watt = GetWattFromPacketFytter(newValue);
@@ -238,9 +238,9 @@ void trxappgateusbbike::characteristicChanged(const QLowEnergyCharacteristic &ch
             KCal += ((((0.048 * ((double)watts()) + 1.19) *
                                      settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                                     200.0) /
-                                   (60000.0 / ((double)lastTimeCharChanged.msecsTo(
-                                                  now)))); //(( (0.048* Output in watts +1.19) *
-                                                                            // body weight in kg * 3.5) / 200 ) / 60
+                                   (60000.0 / ((double)(now - lastTimeCharChanged)))); //(( (0.048* Output in watts
+                                                                            // +1.19) * body weight in kg * 3.5) / 200 )
+                                                                            // / 60
     } else if (bike_type == TUNTURI || bike_type == TUNTURI_2) {
         speed = cadence * 0.37407407407407407407407407407407;
         resistance = GetResistanceFromPacket(newValue);
@@ -249,9 +249,9 @@ void trxappgateusbbike::characteristicChanged(const QLowEnergyCharacteristic &ch
             KCal += ((((0.048 * ((double)watts()) + 1.19) *
                                      settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                                     200.0) /
-                                   (60000.0 / ((double)lastTimeCharChanged.msecsTo(
-                                                  now)))); //(( (0.048* Output in watts +1.19) *
-                                                                            // body weight in kg * 3.5) / 200 ) / 60
+                                   (60000.0 / ((double)(now - lastTimeCharChanged)))); //(( (0.048* Output in watts
+                                                                            // +1.19) * body weight in kg * 3.5) / 200 )
+                                                                            // / 60
     } else if (bike_type != JLL_IC400 && bike_type != ASVIVA) {
 
         speed = GetSpeedFromPacket(newValue);
@@ -264,9 +264,9 @@ void trxappgateusbbike::characteristicChanged(const QLowEnergyCharacteristic &ch
                 KCal += ((((0.048 * ((double)watts()) + 1.19) *
                                       settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                                      200.0) /
-                                    (60000.0 / ((double)lastTimeCharChanged.msecsTo(
-                                                   now)))); //(( (0.048* Output in watts +1.19) * body
-                                                                             // weight in kg * 3.5) / 200 ) / 60
+                                    (60000.0 / ((double)(now - lastTimeCharChanged)))); //(( (0.048* Output in watts
+                                                                             // +1.19) * body weight in kg * 3.5) / 200
+                                                                             // ) / 60
         }
     } else {
 
@@ -278,9 +278,9 @@ void trxappgateusbbike::characteristicChanged(const QLowEnergyCharacteristic &ch
                 KCal += ((((0.048 * ((double)watt) + 1.19) *
                                       settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                                      200.0) /
-                                    (60000.0 / ((double)lastTimeCharChanged.msecsTo(
-                                                   now)))); //(( (0.048* Output in watts +1.19) *
-                                                                             // body weight in kg * 3.5) / 200 ) / 60
+                                    (60000.0 / ((double)(now - lastTimeCharChanged)))); //(( (0.048* Output in watts
+                                                                             // +1.19) * body weight in kg * 3.5) / 200
+                                                                             // ) / 60
         }
     }
 
@@ -327,10 +327,10 @@ void trxappgateusbbike::characteristicChanged(const QLowEnergyCharacteristic &ch
     } else {
         Speed = metric::calculateSpeedFromPower(
             watts(), Inclination.value(), Speed.value(),
-            fabs(QDateTime::currentDateTime().msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+            Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
     }
     if (!firstCharChanged) {
-        Distance += ((Speed.value() / 3600.0) / (1000.0 / (lastTimeCharChanged.msecsTo(now))));
+        Distance += ((Speed.value() / 3600.0) / (1000.0 / (now - lastTimeCharChanged)));
     }
     if (settings.value(QZSettings::cadence_sensor_name, QZSettings::default_cadence_sensor_name)
             .toString()
@@ -26,6 +26,7 @@
 #include <QTime>
 
 #include "devices/bike.h"
+#include "monotonicclock.h"
 #include "ergtable.h"
 
 #ifdef Q_OS_IOS
@@ -72,7 +73,7 @@ class trxappgateusbbike : public bike {
 
     uint8_t firstVirtualBike = 0;
     bool firstCharChanged = true;
-    QTime lastTimeCharChanged;
+    qint64 lastTimeCharChanged = monotonicclock::msecs();
     uint8_t sec1update = 0;
     QByteArray lastPacket;
 
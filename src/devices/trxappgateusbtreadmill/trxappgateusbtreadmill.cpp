@@ -273,9 +273,9 @@ void trxappgateusbtreadmill::characteristicChanged(const QLowEnergyCharacteristi
     }
     FanSpeed = 0;
 
-    QTime now = QTime::currentTime();
+    const qint64 now = monotonicclock::msecs();
     if (!firstCharChanged) {
-        DistanceCalculated += ((speed / 3600.0) / (1000.0 / (lastTimeCharChanged.msecsTo(now))));
+        DistanceCalculated += ((speed / 3600.0) / (1000.0 / (now - lastTimeCharChanged)));
     }
     lastTimeCharChanged = now;
 
@@ -26,6 +26,7 @@
 #include <QTime>
 
 #include "treadmill.h"
+#include "monotonicclock.h"
 
 class trxappgateusbtreadmill : public treadmill {
     Q_OBJECT
@@ -56,7 +57,7 @@ class trxappgateusbtreadmill : public treadmill {
 
     uint8_t firstVirtualTreadmill = 0;
     bool firstCharChanged = true;
-    QTime lastTimeCharChanged;
+    qint64 lastTimeCharChanged = monotonicclock::msecs();
     uint8_t sec1update = 0;
     QByteArray lastPacket;
 
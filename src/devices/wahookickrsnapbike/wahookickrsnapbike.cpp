@@ -453,12 +453,12 @@ void wahookickrsnapbike::characteristicChanged(const QLowEnergyCharacteristic &c
             } else {
                 Speed = metric::calculateSpeedFromPower(
                     watts(), Inclination.value(), Speed.value(),
-                    fabs(QDateTime::currentDateTime().msecsTo(Speed.lastChanged()) / 1000.0), this->speedLimit());
+                    Speed.msecsSinceLastChanged() / 1000.0, this->speedLimit());
             }
             emit debug(QStringLiteral("Current Speed: ") + QString::number(Speed.value()));
 
             Distance += ((Speed.value() / 3600000.0) *
-                         ((double)lastRefreshCharacteristicChanged.msecsTo(QDateTime::currentDateTime())));
+                         ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)));
             emit debug(QStringLiteral("Current Distance: ") + QString::number(Distance.value()));
 
             if (ResistanceFromFTMSAccessory.value() == 0) {
@@ -510,13 +510,13 @@ void wahookickrsnapbike::characteristicChanged(const QLowEnergyCharacteristic &c
                     ((((0.048 * ((double)watts()) + 1.19) *
                        settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() * 3.5) /
                       200.0) /
-                     (60000.0 / ((double)lastRefreshCharacteristicChanged.msecsTo(
-                                    QDateTime::currentDateTime())))); //(( (0.048* Output in watts +1.19) * body weight
-                                                                      // in kg * 3.5) / 200 ) / 60
+                     (60000.0 / ((double)(monotonicclock::msecs() - lastRefreshCharacteristicChanged)))); //(( (0.048*
+                                                                      // Output in watts +1.19) * body weight in kg *
+                                                                      // 3.5) / 200 ) / 60
             emit debug(QStringLiteral("Current KCal: ") + QString::number(KCal.value()));
         }
 
-        lastRefreshCharacteristicChanged = QDateTime::currentDateTime();
+        lastRefreshCharacteristicChanged = monotonicclock::msecs();
     }
 
     {
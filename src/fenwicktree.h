@@ -0,0 +1,68 @@
+#ifndef FENWICKTREE_H
+#define FENWICKTREE_H
+
+#include <QVector>
+#include <cstdint>
+
+/**
+ * @brief Prefix sums of a list of non-negative values that can change one at a time.
+ *
+ * Changing a value, reading the sum of the first n values and finding where a running total goes past a threshold
+ * are all O(log n), against the O(n) of walking the list every time.
+ */
+class fenwicktree {
+  public:
+    void reset(int size) {
+        m_values.fill(0, size);
+        m_tree.fill(0, size + 1);
+        m_total = 0;
+    }
+
+    int size() const { return m_values.size(); }
+    uint64_t value(int i) const { return m_values.at(i); }
+    uint64_t total() const { return m_total; }
+
+    void set(int i, uint64_t value) {
+        int64_t delta = static_cast<int64_t>(value - m_values.at(i));
+        m_values[i] = value;
+        m_total += delta;
+        for (int p = i + 1; p < m_tree.size(); p += p & -p) {
+            m_tree[p] += delta;
+        }
+    }
+
+    // sum of the first count values
+    uint64_t prefix(int count) const {
+        uint64_t sum = 0;
+        for (int p = count; p > 0; p -= p & -p) {
+            sum += m_tree.at(p);
+        }
+        return sum;
+    }
+
+    /**
+     * @brief The index of the first value that brings the running total above threshold, size() if the total
+     * never does.
+     */
+    int upperBound(uint64_t threshold) const {
+        int pos = 0;
+        int step = 1;
+        while (step * 2 <= size()) {
+            step *= 2;
+        }
+        for (; step > 0; step /= 2) {
+            if (pos + step <= size() && m_tree.at(pos + step) <= threshold) {
+                pos += step;
+                threshold -= m_tree.at(pos);
+            }
+        }
+        return pos;
+    }
+
+  private:
+    QVector<uint64_t> m_values;
+    QVector<uint64_t> m_tree;
+    uint64_t m_total = 0;
+};
+
+#endif // FENWICKTREE_H
@@ -1,12 +1,135 @@
 #include "gpx.h"
 #include "math.h"
 #include "qdebugfixup.h"
-#include <QDomDocument>
 #include <QSettings>
+#include <QXmlStreamReader>
 #include <QXmlStreamWriter>
+#include <limits>
 
 gpx::gpx(QObject *parent) : QObject(parent) {}
 
+namespace {
+// a track point kept only for gpx_loop, which walks the track back at the end
+struct gpxtrackpoint {
+    double latitude;
+    double longitude;
+    double altitude;
+    qint64 time; // msecs since epoch, invalidTime without a valid time
+};
+const qint64 invalidTime = std::numeric_limits<qint64>::min();
+
+gpxtrackpoint compact(const gpx_point &point) {
+    return {point.p.latitude(), point.p.longitude(), point.p.altitude(),
+            point.time.isValid() ? point.time.toMSecsSinceEpoch() : invalidTime};
+}
+
+gpx_point expand(const gpxtrackpoint &point) {
+    gpx_point g;
+    if (point.time != invalidTime) {
+        g.time = QDateTime::fromMSecsSinceEpoch(point.time, Qt::UTC);
+    }
+    g.p.setAltitude(point.altitude);
+    g.p.setLatitude(point.latitude);
+    g.p.setLongitude(point.longitude);
+    return g;
+}
+
+/**
+ * @brief Turns the track points into rows one point at a time: only the first point and the last one turned into a
+ * row are kept.
+ */
+class gpxrowbuilder {
+  public:
+    gpxrowbuilder(bool forceSpeed, QList<gpx_altitude_point_for_treadmill> *rows)
+        : m_forceSpeed(forceSpeed), m_rows(rows) {}
+
+    void append(const gpx_point &point) {
+        if (!m_started) {
+            // starting point
+            m_started = true;
+            m_first = point;
+            m_previous = point;
+            gpx_altitude_point_for_treadmill g;
+            g.distance = 0;
+            g.inclination = 0;
+            g.elevation = point.p.altitude();
+            g.latitude = point.p.latitude();
+            g.longitude = point.p.longitude();
+            g.seconds = 0;
+            m_rows->append(g);
+            return;
+        }
+
+        double distance = point.p.distanceTo(m_previous.p);
+        double elevation = point.p.altitude() - m_previous.p.altitude();
+        qint64 dT = qAbs(m_previous.time.secsTo(point.time));
+
+        if (distance == 0 || (m_forceSpeed && dT == 0)) {
+            return;
+        }
+
+        m_previous = point;
+
+        gpx_altitude_point_for_treadmill g;
+        g.seconds = m_first.time.secsTo(point.time);
+        g.distance = distance / 1000.0;
+        if (m_forceSpeed) {
+            g.speed = (distance / 1000.0) * (3600 / dT);
+        }
+        g.inclination = (elevation / distance) * 100;
+        g.elevation = point.p.altitude();
+        g.latitude = point.p.latitude();
+        g.longitude = point.p.longitude();
+        m_rows->append(g);
+    }
+
+  private:
+    bool m_forceSpeed;
+    QList<gpx_altitude_point_for_treadmill> *m_rows;
+    bool m_started = false;
+    gpx_point m_first;
+    gpx_point m_previous;
+};
+
+gpx_point readTrackPoint(QXmlStreamReader &xml) {
+    QXmlStreamAttributes att = xml.attributes();
+    QString ele;
+    QString time;
+    bool eleFound = false;
+    bool timeFound = false;
+
+    // only the direct children of trkpt, the first of each name
+    int depth = 0;
+    while (!xml.atEnd()) {
+        xml.readNext();
+        if (xml.isStartElement()) {
+            if (depth == 0 && !eleFound && xml.qualifiedName() == QStringLiteral("ele")) {
+                ele = xml.readElementText(QXmlStreamReader::IncludeChildElements);
+                eleFound = true;
+            } else if (depth == 0 && !timeFound && xml.qualifiedName() == QStringLiteral("time")) {
+                time = xml.readElementText(QXmlStreamReader::IncludeChildElements);
+                timeFound = true;
+            } else {
+                depth++;
+            }
+        } else if (xml.isEndElement()) {
+            if (depth == 0) {
+                break;
+            }
+            depth--;
+        }
+    }
+
+    gpx_point g;
+    // 2020-10-10T10:54:45
+    g.time = QDateTime::fromString(time, Qt::ISODate);
+    g.p.setAltitude(ele.toDouble());
+    g.p.setLatitude(att.value(QStringLiteral("lat")).toDouble());
+    g.p.setLongitude(att.value(QStringLiteral("lon")).toDouble());
+    return g;
+}
+} // namespace
+
 QList<gpx_altitude_point_for_treadmill> gpx::open(const QString &gpx, bluetoothdevice::BLUETOOTH_TYPE device_type) {
     QSettings settings;
     const double meter_limit_for_auto_loop = 300;
@@ -17,146 +140,94 @@ QList<gpx_altitude_point_for_treadmill> gpx::open(const QString &gpx, bluetoothd
     if(device_type == bluetoothdevice::BIKE)
         treadmill_force_speed = false;
     
-    QFile input(gpx);
-    input.open(QIODevice::ReadOnly);
-    QDomDocument doc;
-    doc.setContent(&input);
-    QDomNodeList metadata = doc.elementsByTagName(QStringLiteral("metadata"));
-    if (metadata.size()) {
-        QDomNodeList list = metadata.at(0).childNodes();
-        for (int i = 0; i < list.count(); i++) {
-            if (list.at(i).nodeName().toLower() == "video") {
-                QString video = list.at(i).toElement().firstChild().nodeValue();
-                if (!video.isEmpty()) {
-                    videoUrl = video;
-                    qDebug() << "gpx::videoUrl " << videoUrl;
-                    break;
-                }
-            }
-        }
-    }
-
-    QDomNodeList points = doc.elementsByTagName(QStringLiteral("trkpt"));
-    for (int i = 0; i < points.size(); i++) {
-        QDomNode point = points.item(i);
-        QDomNamedNodeMap att = point.attributes();
-        QString lat = att.namedItem(QStringLiteral("lat")).nodeValue();
-        QString lon = att.namedItem(QStringLiteral("lon")).nodeValue();
-        QDomElement ele = point.firstChildElement(QStringLiteral("ele"));
-        QDomElement time = point.firstChildElement(QStringLiteral("time"));
-        gpx_point g;
-        // 2020-10-10T10:54:45
-        g.time = QDateTime::fromString(time.text(), Qt::ISODate);
-        g.p.setAltitude(ele.text().toDouble());
-        g.p.setLatitude(lat.toDouble());
-        g.p.setLongitude(lon.toDouble());
-        this->points.append(g);
-    }
-
-    if (gpx_loop && this->points.size() > 2 &&
-        this->points.first().p.distanceTo(this->points.last().p) >= meter_limit_for_auto_loop) {
-        for (int i =
-                 this->points.size() - 2 /* -2 because otherwise the first point will be the same as the last point */;
-             i >= 0; i--) {
-            this->points.append(this->points.at(i));
-        }
-    }
-
     QList<gpx_altitude_point_for_treadmill> inclinationList;
 
-    if (this->points.isEmpty()) {
+    QFile input(gpx);
+    if (!input.open(QIODevice::ReadOnly)) {
         return inclinationList;
     }
 
-    gpx_point pP = this->points.constFirst();
+    // single pass: every trkpt becomes a row as soon as it is read, no DOM and no list of points
+    QXmlStreamReader xml(&input);
+    gpxrowbuilder rows(treadmill_force_speed, &inclinationList);
+    QVector<gpxtrackpoint> track;
+    gpx_point first;
+    gpx_point last;
+    int count = 0;
+    int depth = 0;
+    int metadataDepth = -1;
+    bool metadataDone = false;
+    bool videoFound = false;
 
-    if (treadmill_force_speed) {
-
-        // starting point
-        gpx_altitude_point_for_treadmill g;
-        g.distance = 0;
-        g.inclination = 0;
-        g.elevation = pP.p.altitude();
-        g.latitude = pP.p.latitude();
-        g.longitude = pP.p.longitude();
-        g.seconds = 0;
-        inclinationList.append(g);
-
-        for (int32_t i = 1; i < this->points.count(); i++) {
-            qint64 dT = qAbs(pP.time.secsTo(this->points.at(i).time));
-
-            double distance = this->points.at(i).p.distanceTo(pP.p);
-            double elevation = this->points.at(i).p.altitude() - pP.p.altitude();
-
-            if (distance == 0 || dT == 0) {
-                continue;
+    while (!xml.atEnd()) {
+        xml.readNext();
+        if (xml.isEndElement()) {
+            depth--;
+            if (depth == metadataDepth) {
+                metadataDepth = -1;
+                metadataDone = true;
             }
-
-            pP = this->points[i];
-
-            gpx_altitude_point_for_treadmill g;
-            g.seconds = this->points.constFirst().time.secsTo(pP.time);
-            g.distance = distance / 1000.0;
-            g.speed = (distance / 1000.0) * (3600 / dT);
-            g.inclination = (elevation / distance) * 100;
-            g.elevation = this->points.at(i).p.altitude();
-            g.latitude = pP.p.latitude();
-            g.longitude = pP.p.longitude();
-            inclinationList.append(g);
+            continue;
         }
-    }
-    if (inclinationList.empty()) {
-        gpx_point pP = this->points.constFirst();
-        double totDistance = 0;
-        if (!isnan(this->points.constFirst().p.latitude()) && !isnan(this->points.constFirst().p.longitude()) &&
-            QGeoCoordinate(this->points.first().p.latitude(), this->points.first().p.longitude())
-                    .distanceTo(QGeoCoordinate(this->points.constLast().p.latitude(),
-                                               this->points.constLast().p.longitude())) < meter_limit_for_auto_loop) {
-            // to create the circuit
-            this->points.append(this->points.constFirst());
-            this->points.last().time = this->points.at(this->points.count() - 2).time;
+        if (!xml.isStartElement()) {
+            continue;
         }
 
-        // starting point
-        gpx_altitude_point_for_treadmill g;
-        g.distance = 0;
-        g.inclination = 0;
-        g.elevation = pP.p.altitude();
-        g.latitude = pP.p.latitude();
-        g.longitude = pP.p.longitude();
-        g.seconds = 0;
-        /*qDebug() << qSetRealNumberPrecision(10) << i << g.distance << g.inclination << g.elevation << g.latitude
-             << g.longitude << totDistance << pP.time;*/
-        inclinationList.append(g);
-
-        for (int32_t i = 1; i < this->points.count(); i++) {
-            double distance = this->points.at(i).p.distanceTo(pP.p);
-            double elevation = this->points.at(i).p.altitude() - pP.p.altitude();
-
-            if (distance == 0) {
-                continue;
+        if (xml.qualifiedName() == QStringLiteral("trkpt")) {
+            gpx_point g = readTrackPoint(xml);
+            rows.append(g);
+            if (gpx_loop) {
+                track.append(compact(g));
+            }
+            if (count == 0) {
+                first = g;
             }
+            last = g;
+            count++;
+        } else if (metadataDepth >= 0 && depth == metadataDepth + 1 && !videoFound &&
+                   xml.qualifiedName().toString().toLower() == QStringLiteral("video")) {
+            QString video = xml.readElementText(QXmlStreamReader::IncludeChildElements);
+            if (!video.isEmpty()) {
+                videoFound = true;
+                videoUrl = video;
+                qDebug() << "gpx::videoUrl " << videoUrl;
+            }
+        } else if (xml.qualifiedName() == QStringLiteral("metadata") && metadataDepth < 0 && !metadataDone) {
+            metadataDepth = depth++;
+        } else {
+            depth++;
+        }
+    }
+    if (xml.hasError()) {
+        qDebug() << "gpx::open" << gpx << xml.errorString() << "at line" << xml.lineNumber() << "points read"
+                 << count;
+    }
 
-            pP = this->points[i];
+    if (count == 0) {
+        return inclinationList;
+    }
 
-            gpx_altitude_point_for_treadmill g;
-            g.distance = distance / 1000.0;
-            totDistance += g.distance;
-            g.inclination = (elevation / distance) * 100;
-            g.elevation = this->points.at(i).p.altitude();
-            g.latitude = pP.p.latitude();
-            g.longitude = pP.p.longitude();
-            g.seconds = this->points.constFirst().time.secsTo(pP.time);
-            /*qDebug() << qSetRealNumberPrecision(10) << i << g.distance << g.inclination << g.elevation << g.latitude
-             << g.longitude << totDistance << pP.time;*/
-            inclinationList.append(g);
+    if (gpx_loop && count > 2 && first.p.distanceTo(last.p) >= meter_limit_for_auto_loop) {
+        for (int i = track.size() - 2 /* -2 because otherwise the first point will be the same as the last point */;
+             i >= 0; i--) {
+            last = expand(track.at(i));
+            rows.append(last);
         }
     }
 
+    if (!treadmill_force_speed && !isnan(first.p.latitude()) && !isnan(first.p.longitude()) &&
+        QGeoCoordinate(first.p.latitude(), first.p.longitude())
+                .distanceTo(QGeoCoordinate(last.p.latitude(), last.p.longitude())) < meter_limit_for_auto_loop) {
+        // to create the circuit
+        gpx_point circuit = first;
+        circuit.time = last.time;
+        rows.append(circuit);
+    }
+
     return inclinationList;
 }
 
-void gpx::save(const QString &filename, QList<SessionLine> session, bluetoothdevice::BLUETOOTH_TYPE type) {
+void gpx::save(const QString &filename, const sessionstore &session, bluetoothdevice::BLUETOOTH_TYPE type) {
     if (session.isEmpty()) {
         return;
     }
@@ -192,11 +263,11 @@ void gpx::save(const QString &filename, QList<SessionLine> session, bluetoothdev
 
     stream.writeStartElement(QStringLiteral("metadata"));
     stream.writeTextElement(QStringLiteral("time"),
-                            session.at(0).time.toString(QStringLiteral("yyyy-MM-ddTHH:mm:ssZ")));
+                            session.time(0).toString(QStringLiteral("yyyy-MM-ddTHH:mm:ssZ")));
     stream.writeEndElement();
 
     stream.writeStartElement(QStringLiteral("trk"));
-    stream.writeTextElement(QStringLiteral("name"), session.at(0).time.toString(QStringLiteral("yyyy-MM-dd HH:mm:ss")));
+    stream.writeTextElement(QStringLiteral("name"), session.time(0).toString(QStringLiteral("yyyy-MM-dd HH:mm:ss")));
 
     if (type == bluetoothdevice::TREADMILL || type == bluetoothdevice::ELLIPTICAL) {
         stream.writeTextElement(QStringLiteral("type"), QStringLiteral("0"));
@@ -205,27 +276,32 @@ void gpx::save(const QString &filename, QList<SessionLine> session, bluetoothdev
     }
 
     stream.writeStartElement(QStringLiteral("trkseg"));
-    for (const SessionLine &s : qAsConst(session)) {
-        if (s.speed > 0) {
+    const QVector<float> &speed = session.speed();
+    const QVector<uint16_t> &watt = session.watt();
+    const QVector<uint8_t> &heart = session.heart();
+    const QVector<uint8_t> &cadence = session.cadence();
+    const QVector<double> &distance = session.distance();
+    for (int i = 0; i < session.count(); i++) {
+        if (speed.at(i) > 0) {
             stream.writeStartElement(QStringLiteral("trkpt"));
             stream.writeAttribute(QStringLiteral("lat"), QStringLiteral("0"));
             stream.writeAttribute(QStringLiteral("lon"), QStringLiteral("0"));
             stream.writeTextElement(QStringLiteral("ele"),
                                     QStringLiteral("0")); // replace with the cumulative inclination
-            stream.writeTextElement(QStringLiteral("time"), s.time.toString(QStringLiteral("yyyy-MM-ddTHH:mm:ssZ")));
-            stream.writeTextElement(QStringLiteral("speed"), QString::number(s.speed / 3.6)); // meter per second
+            stream.writeTextElement(QStringLiteral("time"), session.time(i).toString(QStringLiteral("yyyy-MM-ddTHH:mm:ssZ")));
+            stream.writeTextElement(QStringLiteral("speed"), QString::number(speed.at(i) / 3.6)); // meter per second
             stream.writeStartElement(QStringLiteral("extensions"));
-            stream.writeTextElement(QStringLiteral("power"), QString::number(s.watt));
-            stream.writeTextElement(QStringLiteral("gpxdata:hr"), QString::number(s.heart));
-            stream.writeTextElement(QStringLiteral("gpxdata:cadence"), QString::number(s.cadence));
+            stream.writeTextElement(QStringLiteral("power"), QString::number(watt.at(i)));
+            stream.writeTextElement(QStringLiteral("gpxdata:hr"), QString::number(heart.at(i)));
+            stream.writeTextElement(QStringLiteral("gpxdata:cadence"), QString::number(cadence.at(i)));
             stream.writeStartElement(QStringLiteral("gpxtpx:TrackPointExtension"));
-            stream.writeTextElement(QStringLiteral("gpxtpx:speed"), QString::number(s.speed / 3.6)); // meter per second
-            stream.writeTextElement(QStringLiteral("gpxtpx:hr"), QString::number(s.heart));
-            stream.writeTextElement(QStringLiteral("gpxtpx:cad"), QString::number(s.cadence));
-            stream.writeTextElement(QStringLiteral("gpxtpx:distance"), QString::number(s.distance));
+            stream.writeTextElement(QStringLiteral("gpxtpx:speed"), QString::number(speed.at(i) / 3.6)); // meter per second
+            stream.writeTextElement(QStringLiteral("gpxtpx:hr"), QString::number(heart.at(i)));
+            stream.writeTextElement(QStringLiteral("gpxtpx:cad"), QString::number(cadence.at(i)));
+            stream.writeTextElement(QStringLiteral("gpxtpx:distance"), QString::number(distance.at(i)));
             stream.writeEndElement(); // gpxtpx:TrackPointExtension
             stream.writeStartElement(QStringLiteral("gpxpx:PowerExtension"));
-            stream.writeTextElement(QStringLiteral("gpxpx:PowerInWatts"), QString::number(s.watt));
+            stream.writeTextElement(QStringLiteral("gpxpx:PowerInWatts"), QString::number(watt.at(i)));
             stream.writeEndElement(); // gpxtpx:PowerExtension
             stream.writeEndElement(); // extensions
             stream.writeEndElement(); // trkpt
@@ -9,6 +9,7 @@
 #endif
 #include "material.h"
 #include "qfit.h"
+#include "qzsettingssnapshot.h"
 #include "simplecrypt.h"
 #include "templateinfosenderbuilder.h"
 #include "zwiftworkout.h"
@@ -263,6 +264,18 @@ homeform::homeform(QQmlApplicationEngine *engine, bluetooth *bl) {
                                 QStringLiteral("0"), false, QStringLiteral("targetmets"), 48, labelFontSize);
     rss = new DataObject(QStringLiteral("RSS"), QStringLiteral("icons/icons/watt.png"),
                                 QStringLiteral("0"), false, QStringLiteral("rss"), 48, labelFontSize);                                
+    peakPower = new DataObject(QStringLiteral("Peak 1m (W)"), QStringLiteral("icons/icons/watt.png"),
+                               QStringLiteral("0"), false, QStringLiteral("peakpower"), 48, labelFontSize);
+    normalizedPower = new DataObject(QStringLiteral("NP (W)"), QStringLiteral("icons/icons/watt.png"), QStringLiteral("0"), false,
+                        QStringLiteral("np"), 48, labelFontSize);
+    trainingStressScore = new DataObject(QStringLiteral("TSS"), QStringLiteral("icons/icons/watt.png"), QStringLiteral("0"), false,
+                        QStringLiteral("tss"), 48, labelFontSize);
+    wPrimeBalance = new DataObject(QStringLiteral("W' Bal (kJ)"), QStringLiteral("icons/icons/watt.png"), QStringLiteral("0"), false,
+                        QStringLiteral("wbal"), 48, labelFontSize);
+    watt3s = new DataObject(QStringLiteral("Watt 3s"), QStringLiteral("icons/icons/watt.png"), QStringLiteral("0"), false,
+                            QStringLiteral("watt3s"), 48, labelFontSize);
+    watt30s = new DataObject(QStringLiteral("Watt 30s"), QStringLiteral("icons/icons/watt.png"), QStringLiteral("0"),
+                             false, QStringLiteral("watt30s"), 48, labelFontSize);
     steeringAngle = new DataObject(QStringLiteral("Steering"), QStringLiteral("icons/icons/cadence.png"),
                                    QStringLiteral("0"), false, QStringLiteral("steeringangle"), 48, labelFontSize);
     peloton_offset =
@@ -413,6 +426,10 @@ homeform::homeform(QQmlApplicationEngine *engine, bluetooth *bl) {
     stravaWorkoutName = QLatin1String("");
     movieFileName = QUrl("");
 
+    settingsSnapshotTimer.setSingleShot(true);
+    settingsSnapshotTimer.setInterval(1000);
+    connect(&settingsSnapshotTimer, &QTimer::timeout, this, []() { QZSettingsSnapshot::refresh(); });
+
 #if defined(Q_OS_WIN) || (defined(Q_OS_MAC) && !defined(Q_OS_IOS)) || (defined(Q_OS_ANDROID) && defined(LICENSE))
 #ifndef STEAM_STORE
     connect(engine, &QQmlApplicationEngine::quit, &QGuiApplication::quit);
@@ -482,6 +499,17 @@ homeform::homeform(QQmlApplicationEngine *engine, bluetooth *bl) {
     connect(backupTimer, &QTimer::timeout, this, &homeform::backup);
     backupTimer->start(1min);
 
+    // a journal left on disk belongs to a workout that didn't end: move it away from the new one and ask what to do
+    journal = new sessionjournal(getWritableAppDir() + QStringLiteral("session.qzj"), this);
+    if (QFile::exists(journal->filename())) {
+        journalRecoveryFilename = getWritableAppDir() + QStringLiteral("session-recovered.qzj");
+        QFile::remove(journalRecoveryFilename);
+        QFile::rename(journal->filename(), journalRecoveryFilename);
+        qDebug() << QStringLiteral("unfinished session journal found") << journalRecoveryFilename;
+        m_journalRecoveryAsk = true;
+        emit changeJournalRecoveryAsk(m_journalRecoveryAsk);
+    }
+
     QObject *rootObject = engine->rootObjects().constFirst();
     QObject *home = rootObject->findChild<QObject *>(QStringLiteral("home"));
     QObject *stack = rootObject;
@@ -504,6 +532,8 @@ homeform::homeform(QQmlApplicationEngine *engine, bluetooth *bl) {
     QObject::connect(home, SIGNAL(lap_clicked()), this, SLOT(Lap()));
     QObject::connect(home, SIGNAL(peloton_start_workout()), this, SLOT(peloton_start_workout()));
     QObject::connect(home, SIGNAL(peloton_abort_workout()), this, SLOT(peloton_abort_workout()));
+    QObject::connect(home, SIGNAL(journal_resume()), this, SLOT(journal_resume()));
+    QObject::connect(home, SIGNAL(journal_export()), this, SLOT(journal_export()));
     QObject::connect(stack, SIGNAL(loadSettings(QUrl)), this, SLOT(loadSettings(QUrl)));
     QObject::connect(stack, SIGNAL(saveSettings(QUrl)), this, SLOT(saveSettings(QUrl)));
     QObject::connect(stack, SIGNAL(deleteSettings(QUrl)), this, SLOT(deleteSettings(QUrl)));
@@ -789,6 +819,71 @@ void homeform::peloton_abort_workout() {
     pelotonAbortedInstructor = pelotonAskedInstructor;
 }
 
+void homeform::journal_resume() {
+    m_journalRecoveryAsk = false;
+    emit changeJournalRecoveryAsk(m_journalRecoveryAsk);
+
+    sessionstore recovered;
+    uint32_t deviceType = bluetoothdevice::BIKE;
+    if (!sessionjournal::read(journalRecoveryFilename, &recovered, &deviceType) || recovered.isEmpty()) {
+        QFile::remove(journalRecoveryFilename);
+        return;
+    }
+
+    journalResumed = true;
+    journalResumeDistance = recovered.distance().last();
+    journalResumeCalories = recovered.calories().last();
+    journalResumeElapsed = recovered.elapsedTime().last();
+    journalResumeStrokes = recovered.totalStrokes().last();
+    journalResumeSteps = recovered.stepCount().last();
+
+    // the lines recorded since the startup go after the recovered ones
+    for (int i = 0; i < Session.count(); i++) {
+        SessionLine s = Session.at(i);
+        s.distance += journalResumeDistance;
+        s.calories += journalResumeCalories;
+        s.elapsedTime += journalResumeElapsed;
+        s.totalStrokes += journalResumeStrokes;
+        s.stepCount += journalResumeSteps;
+        recovered.append(s);
+    }
+    Session = recovered;
+    delete fitWriter;
+    fitWriter = nullptr;
+
+    const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
+    TrainingLoad.clear();
+    TrainingLoad.setThresholds(snapshot.ftp, snapshot.w_prime);
+    for (uint16_t watt : Session.watt()) {
+        TrainingLoad.append(watt);
+    }
+
+    // the journal of the running workout has to contain the recovered lines too
+    journal->finish();
+    for (int i = 0; i < Session.count(); i++) {
+        journal->append(Session.at(i), deviceType);
+    }
+    QFile::remove(journalRecoveryFilename);
+    qDebug() << QStringLiteral("workout resumed from the session journal") << Session.count();
+}
+
+void homeform::journal_export() {
+    m_journalRecoveryAsk = false;
+    emit changeJournalRecoveryAsk(m_journalRecoveryAsk);
+
+    sessionstore recovered;
+    uint32_t deviceType = bluetoothdevice::BIKE;
+    if (sessionjournal::read(journalRecoveryFilename, &recovered, &deviceType) && !recovered.isEmpty()) {
+        QString filename = getWritableAppDir() +
+                           recovered.time(0).toString().replace(QStringLiteral(":"), QStringLiteral("_")) +
+                           QStringLiteral(".fit");
+        qfit::save(filename, recovered, (bluetoothdevice::BLUETOOTH_TYPE)deviceType);
+        qDebug() << QStringLiteral("session journal exported to") << filename;
+        onToastRequested(tr("Recovered workout saved: ") + filename);
+    }
+    QFile::remove(journalRecoveryFilename);
+}
+
 void homeform::peloton_start_workout() {
 
     QSettings settings;
@@ -941,9 +1036,7 @@ void homeform::backup() {
 
         QString filename = path + QString::number(index) + backupFitFileName;
         QFile::remove(filename);
-        qfit::save(filename, Session, dev->deviceType(),
-                   qobject_cast<m3ibike *>(dev) ? QFIT_PROCESS_DISTANCENOISE : QFIT_PROCESS_NONE,
-                   stravaPelotonWorkoutType, dev->bluetoothDevice.name());
+        saveFit(filename, dev->bluetoothDevice.name());
 
         index++;
         if (index > 1) {
@@ -996,6 +1089,8 @@ void homeform::aboutToQuit() {
         qDebug() << "fit_file_saved_on_quit true";
         fit_save_clicked();
     }
+    // a clean quit is not a crash: the journal must not be offered for recovery on the next start
+    journal->finish();
 
     if (bluetoothManager->device())
         bluetoothManager->device()->disconnectBluetooth();
@@ -1259,6 +1354,39 @@ void homeform::sortTiles() {
                 dataList.append(avgWattLap);
             }
 
+            if (settings.value(QZSettings::tile_peak_power_enabled, QZSettings::default_tile_peak_power_enabled)
+                    .toBool() &&
+                settings.value(QZSettings::tile_peak_power_order, QZSettings::default_tile_peak_power_order).toInt() ==
+                    i) {
+                peakPower->setGridId(i);
+                dataList.append(peakPower);
+            }
+            if (settings.value(QZSettings::tile_np_enabled, QZSettings::default_tile_np_enabled).toBool() &&
+                settings.value(QZSettings::tile_np_order, QZSettings::default_tile_np_order).toInt() == i) {
+                normalizedPower->setGridId(i);
+                dataList.append(normalizedPower);
+            }
+            if (settings.value(QZSettings::tile_tss_enabled, QZSettings::default_tile_tss_enabled).toBool() &&
+                settings.value(QZSettings::tile_tss_order, QZSettings::default_tile_tss_order).toInt() == i) {
+                trainingStressScore->setGridId(i);
+                dataList.append(trainingStressScore);
+            }
+            if (settings.value(QZSettings::tile_wbal_enabled, QZSettings::default_tile_wbal_enabled).toBool() &&
+                settings.value(QZSettings::tile_wbal_order, QZSettings::default_tile_wbal_order).toInt() == i) {
+                wPrimeBalance->setGridId(i);
+                dataList.append(wPrimeBalance);
+            }
+            if (settings.value(QZSettings::tile_watt_3s_enabled, QZSettings::default_tile_watt_3s_enabled).toBool() &&
+                settings.value(QZSettings::tile_watt_3s_order, QZSettings::default_tile_watt_3s_order).toInt() == i) {
+                watt3s->setGridId(i);
+                dataList.append(watt3s);
+            }
+            if (settings.value(QZSettings::tile_watt_30s_enabled, QZSettings::default_tile_watt_30s_enabled).toBool() &&
+                settings.value(QZSettings::tile_watt_30s_order, QZSettings::default_tile_watt_30s_order).toInt() == i) {
+                watt30s->setGridId(i);
+                dataList.append(watt30s);
+            }
+
             if (settings.value(QZSettings::tile_ftp_enabled, true).toBool() &&
                 settings.value(QZSettings::tile_ftp_order, 0).toInt() == i) {
                 ftp->setGridId(i);
@@ -1576,6 +1704,39 @@ void homeform::sortTiles() {
                 dataList.append(avgWattLap);
             }
 
+            if (settings.value(QZSettings::tile_peak_power_enabled, QZSettings::default_tile_peak_power_enabled)
+                    .toBool() &&
+                settings.value(QZSettings::tile_peak_power_order, QZSettings::default_tile_peak_power_order).toInt() ==
+                    i) {
+                peakPower->setGridId(i);
+                dataList.append(peakPower);
+            }
+            if (settings.value(QZSettings::tile_np_enabled, QZSettings::default_tile_np_enabled).toBool() &&
+                settings.value(QZSettings::tile_np_order, QZSettings::default_tile_np_order).toInt() == i) {
+                normalizedPower->setGridId(i);
+                dataList.append(normalizedPower);
+            }
+            if (settings.value(QZSettings::tile_tss_enabled, QZSettings::default_tile_tss_enabled).toBool() &&
+                settings.value(QZSettings::tile_tss_order, QZSettings::default_tile_tss_order).toInt() == i) {
+                trainingStressScore->setGridId(i);
+                dataList.append(trainingStressScore);
+            }
+            if (settings.value(QZSettings::tile_wbal_enabled, QZSettings::default_tile_wbal_enabled).toBool() &&
+                settings.value(QZSettings::tile_wbal_order, QZSettings::default_tile_wbal_order).toInt() == i) {
+                wPrimeBalance->setGridId(i);
+                dataList.append(wPrimeBalance);
+            }
+            if (settings.value(QZSettings::tile_watt_3s_enabled, QZSettings::default_tile_watt_3s_enabled).toBool() &&
+                settings.value(QZSettings::tile_watt_3s_order, QZSettings::default_tile_watt_3s_order).toInt() == i) {
+                watt3s->setGridId(i);
+                dataList.append(watt3s);
+            }
+            if (settings.value(QZSettings::tile_watt_30s_enabled, QZSettings::default_tile_watt_30s_enabled).toBool() &&
+                settings.value(QZSettings::tile_watt_30s_order, QZSettings::default_tile_watt_30s_order).toInt() == i) {
+                watt30s->setGridId(i);
+                dataList.append(watt30s);
+            }
+
             if (settings.value(QZSettings::tile_ftp_enabled, true).toBool() &&
                 settings.value(QZSettings::tile_ftp_order, 0).toInt() == i) {
                 ftp->setGridId(i);
@@ -1910,6 +2071,39 @@ void homeform::sortTiles() {
                 dataList.append(avgWattLap);
             }
 
+            if (settings.value(QZSettings::tile_peak_power_enabled, QZSettings::default_tile_peak_power_enabled)
+                    .toBool() &&
+                settings.value(QZSettings::tile_peak_power_order, QZSettings::default_tile_peak_power_order).toInt() ==
+                    i) {
+                peakPower->setGridId(i);
+                dataList.append(peakPower);
+            }
+            if (settings.value(QZSettings::tile_np_enabled, QZSettings::default_tile_np_enabled).toBool() &&
+                settings.value(QZSettings::tile_np_order, QZSettings::default_tile_np_order).toInt() == i) {
+                normalizedPower->setGridId(i);
+                dataList.append(normalizedPower);
+            }
+            if (settings.value(QZSettings::tile_tss_enabled, QZSettings::default_tile_tss_enabled).toBool() &&
+                settings.value(QZSettings::tile_tss_order, QZSettings::default_tile_tss_order).toInt() == i) {
+                trainingStressScore->setGridId(i);
+                dataList.append(trainingStressScore);
+            }
+            if (settings.value(QZSettings::tile_wbal_enabled, QZSettings::default_tile_wbal_enabled).toBool() &&
+                settings.value(QZSettings::tile_wbal_order, QZSettings::default_tile_wbal_order).toInt() == i) {
+                wPrimeBalance->setGridId(i);
+                dataList.append(wPrimeBalance);
+            }
+            if (settings.value(QZSettings::tile_watt_3s_enabled, QZSettings::default_tile_watt_3s_enabled).toBool() &&
+                settings.value(QZSettings::tile_watt_3s_order, QZSettings::default_tile_watt_3s_order).toInt() == i) {
+                watt3s->setGridId(i);
+                dataList.append(watt3s);
+            }
+            if (settings.value(QZSettings::tile_watt_30s_enabled, QZSettings::default_tile_watt_30s_enabled).toBool() &&
+                settings.value(QZSettings::tile_watt_30s_order, QZSettings::default_tile_watt_30s_order).toInt() == i) {
+                watt30s->setGridId(i);
+                dataList.append(watt30s);
+            }
+
             if (settings.value(QZSettings::tile_ftp_enabled, true).toBool() &&
                 settings.value(QZSettings::tile_ftp_order, 0).toInt() == i) {
                 ftp->setGridId(i);
@@ -2504,6 +2698,39 @@ void homeform::sortTiles() {
                 dataList.append(avgWattLap);
             }
 
+            if (settings.value(QZSettings::tile_peak_power_enabled, QZSettings::default_tile_peak_power_enabled)
+                    .toBool() &&
+                settings.value(QZSettings::tile_peak_power_order, QZSettings::default_tile_peak_power_order).toInt() ==
+                    i) {
+                peakPower->setGridId(i);
+                dataList.append(peakPower);
+            }
+            if (settings.value(QZSettings::tile_np_enabled, QZSettings::default_tile_np_enabled).toBool() &&
+                settings.value(QZSettings::tile_np_order, QZSettings::default_tile_np_order).toInt() == i) {
+                normalizedPower->setGridId(i);
+                dataList.append(normalizedPower);
+            }
+            if (settings.value(QZSettings::tile_tss_enabled, QZSettings::default_tile_tss_enabled).toBool() &&
+                settings.value(QZSettings::tile_tss_order, QZSettings::default_tile_tss_order).toInt() == i) {
+                trainingStressScore->setGridId(i);
+                dataList.append(trainingStressScore);
+            }
+            if (settings.value(QZSettings::tile_wbal_enabled, QZSettings::default_tile_wbal_enabled).toBool() &&
+                settings.value(QZSettings::tile_wbal_order, QZSettings::default_tile_wbal_order).toInt() == i) {
+                wPrimeBalance->setGridId(i);
+                dataList.append(wPrimeBalance);
+            }
+            if (settings.value(QZSettings::tile_watt_3s_enabled, QZSettings::default_tile_watt_3s_enabled).toBool() &&
+                settings.value(QZSettings::tile_watt_3s_order, QZSettings::default_tile_watt_3s_order).toInt() == i) {
+                watt3s->setGridId(i);
+                dataList.append(watt3s);
+            }
+            if (settings.value(QZSettings::tile_watt_30s_enabled, QZSettings::default_tile_watt_30s_enabled).toBool() &&
+                settings.value(QZSettings::tile_watt_30s_order, QZSettings::default_tile_watt_30s_order).toInt() == i) {
+                watt30s->setGridId(i);
+                dataList.append(watt30s);
+            }
+
             if (settings.value(QZSettings::tile_ftp_enabled, true).toBool() &&
                 settings.value(QZSettings::tile_ftp_order, 0).toInt() == i) {
                 ftp->setGridId(i);
@@ -2769,6 +2996,11 @@ void homeform::moveTile(QString name, int newIndex, int oldIndex) {
 
 void homeform::sortTilesTimeout() { sortTiles(); }
 
+void homeform::settingsChanged() {
+    // restarted on every page change, the snapshot is refreshed once after the pages have written their values
+    settingsSnapshotTimer.start();
+}
+
 void homeform::deviceConnected(QBluetoothDeviceInfo b) {
 
     qDebug() << "deviceConnected" << bluetoothManager << engine;
@@ -2876,7 +3108,7 @@ void homeform::LargeButton(const QString &name) {
         bluetoothManager->device()->deviceType() == bluetoothdevice::ELLIPTICAL ||
         bluetoothManager->device()->deviceType() == bluetoothdevice::ROWING) {
         if (name.contains(QStringLiteral("erg_mode"))) {
-            settings.setValue(QZSettings::zwift_erg, !settings.value(QZSettings::zwift_erg, QZSettings::default_zwift_erg).toBool());
+            QZSettingsSnapshot::setValue(QZSettings::zwift_erg, !settings.value(QZSettings::zwift_erg, QZSettings::default_zwift_erg).toBool());
         } else if (name.contains(QStringLiteral("preset_resistance_1"))) {
             bluetoothManager->device()->changeResistance(settings
                                                              .value(QZSettings::tile_preset_resistance_1_value,
@@ -3644,6 +3876,10 @@ void homeform::Start_inner(bool send_event_to_device) {
                 bluetoothManager->device()->clearStats();
             }
             Session.clear();
+            TrainingLoad.clear();
+            journalResumed = false;
+            delete fitWriter;
+            fitWriter = nullptr;
             chartImagesFilenames.clear();
 
 #ifdef Q_OS_IOS
@@ -3759,6 +3995,7 @@ void homeform::Stop() {
     emit workoutEventStateChanged(bluetoothdevice::STOPPED);
 
     fit_save_clicked();
+    journal->finish();
 
     if (bluetoothManager->device()) {
         bluetoothManager->device()->setPaused(paused | stopped);
@@ -3854,6 +4091,7 @@ QString homeform::signal() {
 
 void homeform::update() {
 
+    const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
     QSettings settings;
     double currentHRZone = 1;
     double ftpZone = 1;
@@ -3862,8 +4100,7 @@ void homeform::update() {
         qDebug() << "!!!!QSETTINGS ERROR!" << settings.status();
     }
 
-    if ((paused || stopped) &&
-        settings.value(QZSettings::top_bar_enabled, QZSettings::default_top_bar_enabled).toBool()) {
+    if ((paused || stopped) && snapshot.top_bar_enabled) {
 
         emit stopIconChanged(stopIcon());
         emit stopTextChanged(stopText());
@@ -3890,12 +4127,12 @@ void homeform::update() {
         double verticalOscillation = 0;
         double stepCount = 0;
 
-        bool miles = settings.value(QZSettings::miles_unit, QZSettings::default_miles_unit).toBool();
-        double ftpSetting = settings.value(QZSettings::ftp, QZSettings::default_ftp).toDouble();
+        bool miles = snapshot.miles_unit;
+        double ftpSetting = snapshot.ftp;
         double unit_conversion = 1.0;
         double meter_feet_conversion = 1.0;
         double cm_inches_conversion = 1.0;
-        bool power5s = settings.value(QZSettings::power_avg_5s, QZSettings::default_power_avg_5s).toBool();
+        bool power5s = snapshot.power_avg_5s;
         uint8_t treadmill_pid_heart_zone =
             settings.value(QZSettings::treadmill_pid_heart_zone, QZSettings::default_treadmill_pid_heart_zone)
                 .toString()
@@ -4054,6 +4291,18 @@ void homeform::update() {
         lapElapsed->setValue(bluetoothManager->device()->lapElapsedTime().toString(QStringLiteral("h:mm:ss")));
         avgWatt->setValue(QString::number(bluetoothManager->device()->wattsMetric().average(), 'f', 0));
         avgWattLap->setValue(QString::number(bluetoothManager->device()->wattsMetric().lapAverage(), 'f', 0));
+        peakPower->setValue(QString::number(Session.powerCurve().best(60), 'f', 0));
+        peakPower->setSecondLine(QStringLiteral("5m: ") + QString::number(Session.powerCurve().best(5 * 60), 'f', 0) +
+                                 QStringLiteral(" 20m: ") +
+                                 QString::number(Session.powerCurve().best(20 * 60), 'f', 0));
+        normalizedPower->setValue(QString::number(TrainingLoad.normalizedPower(), 'f', 0));
+        normalizedPower->setSecondLine(QStringLiteral("IF: ") + QString::number(TrainingLoad.intensityFactor(), 'f', 2));
+        trainingStressScore->setValue(QString::number(TrainingLoad.tss(), 'f', 0));
+        wPrimeBalance->setValue(QString::number(TrainingLoad.wPrimeBalance() / 1000.0, 'f', 1));
+        wPrimeBalance->setSecondLine(QString::number(TrainingLoad.wPrimeBalancePercentage(), 'f', 0) +
+                                     QStringLiteral("%"));
+        watt3s->setValue(QString::number(bluetoothManager->device()->wattsMetric().average3s(), 'f', 0));
+        watt30s->setValue(QString::number(bluetoothManager->device()->wattsMetric().average30s(), 'f', 0));
         wattKg->setValue(QString::number(bluetoothManager->device()->wattKg().value(), 'f', 1));
         wattKg->setSecondLine(
             QStringLiteral("AVG: ") + QString::number(bluetoothManager->device()->wattKg().average(), 'f', 1) +
@@ -4817,91 +5066,48 @@ void homeform::update() {
         double hrCurrentZoneRangeMin = 0;
         double hrCurrentZoneRangeMax = maxHeartRate;
 
-        if (percHeartRate <
-            settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble()) {
+        if (percHeartRate < snapshot.heart_rate_zone1) {
             currentHRZone = 1;
-            currentHRZone +=
-                (percHeartRate /
-                 settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble());
+            currentHRZone += (percHeartRate / snapshot.heart_rate_zone1);
             if (currentHRZone >= 2) { // double precision could cause unwanted approximation
                 currentHRZone = 1.9999;
             }
-            hrCurrentZoneRangeMax =
-                ((settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble() *
-                  maxHeartRate) /
-                 100) -
-                1;
+            hrCurrentZoneRangeMax = ((snapshot.heart_rate_zone1 * maxHeartRate) / 100) - 1;
             heart->setValueFontColor(QStringLiteral("lightsteelblue"));
-        } else if (percHeartRate <
-                   settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble()) {
+        } else if (percHeartRate < snapshot.heart_rate_zone2) {
             currentHRZone = 2;
-            currentHRZone +=
-                ((percHeartRate -
-                  settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble()) /
-                 (settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble() -
-                  settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble()));
+            currentHRZone += ((percHeartRate - snapshot.heart_rate_zone1) /
+                              (snapshot.heart_rate_zone2 - snapshot.heart_rate_zone1));
             if (currentHRZone >= 3) { // double precision could cause unwanted approximation
                 currentHRZone = 2.9999;
             }
-            hrCurrentZoneRangeMin =
-                (settings.value(QZSettings::heart_rate_zone1, QZSettings::default_heart_rate_zone1).toDouble() *
-                 maxHeartRate) /
-                100;
-            hrCurrentZoneRangeMax =
-                ((settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble() *
-                  maxHeartRate) /
-                 100) -
-                1;
+            hrCurrentZoneRangeMin = (snapshot.heart_rate_zone1 * maxHeartRate) / 100;
+            hrCurrentZoneRangeMax = ((snapshot.heart_rate_zone2 * maxHeartRate) / 100) - 1;
             heart->setValueFontColor(QStringLiteral("green"));
-        } else if (percHeartRate <
-                   settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble()) {
+        } else if (percHeartRate < snapshot.heart_rate_zone3) {
             currentHRZone = 3;
-            currentHRZone +=
-                ((percHeartRate -
-                  settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble()) /
-                 (settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble() -
-                  settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble()));
+            currentHRZone += ((percHeartRate - snapshot.heart_rate_zone2) /
+                              (snapshot.heart_rate_zone3 - snapshot.heart_rate_zone2));
             if (currentHRZone >= 4) { // double precision could cause unwanted approximation
                 currentHRZone = 3.9999;
             }
-            hrCurrentZoneRangeMin =
-                (settings.value(QZSettings::heart_rate_zone2, QZSettings::default_heart_rate_zone2).toDouble() *
-                 maxHeartRate) /
-                100;
-            hrCurrentZoneRangeMax =
-                ((settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble() *
-                  maxHeartRate) /
-                 100) -
-                1;
+            hrCurrentZoneRangeMin = (snapshot.heart_rate_zone2 * maxHeartRate) / 100;
+            hrCurrentZoneRangeMax = ((snapshot.heart_rate_zone3 * maxHeartRate) / 100) - 1;
             heart->setValueFontColor(QStringLiteral("yellow"));
-        } else if (percHeartRate <
-                   settings.value(QZSettings::heart_rate_zone4, QZSettings::default_heart_rate_zone4).toDouble()) {
+        } else if (percHeartRate < snapshot.heart_rate_zone4) {
             currentHRZone = 4;
-            currentHRZone +=
-                ((percHeartRate -
-                  settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble()) /
-                 (settings.value(QZSettings::heart_rate_zone4, QZSettings::default_heart_rate_zone4).toDouble() -
-                  settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble()));
+            currentHRZone += ((percHeartRate - snapshot.heart_rate_zone3) /
+                              (snapshot.heart_rate_zone4 - snapshot.heart_rate_zone3));
             if (currentHRZone >= 5) { // double precision could cause unwanted approximation
                 currentHRZone = 4.9999;
             }
-            hrCurrentZoneRangeMin =
-                (settings.value(QZSettings::heart_rate_zone3, QZSettings::default_heart_rate_zone3).toDouble() *
-                 maxHeartRate) /
-                100;
-            hrCurrentZoneRangeMax =
-                ((settings.value(QZSettings::heart_rate_zone4, QZSettings::default_heart_rate_zone4).toDouble() *
-                  maxHeartRate) /
-                 100) -
-                1;
+            hrCurrentZoneRangeMin = (snapshot.heart_rate_zone3 * maxHeartRate) / 100;
+            hrCurrentZoneRangeMax = ((snapshot.heart_rate_zone4 * maxHeartRate) / 100) - 1;
             heart->setValueFontColor(QStringLiteral("orange"));
         } else {
             currentHRZone = 5;
             heart->setValueFontColor(QStringLiteral("red"));
-            hrCurrentZoneRangeMin =
-                (settings.value(QZSettings::heart_rate_zone4, QZSettings::default_heart_rate_zone4).toDouble() *
-                 maxHeartRate) /
-                100;
+            hrCurrentZoneRangeMin = (snapshot.heart_rate_zone4 * maxHeartRate) / 100;
         }
         pidHR->setValue(QString::number(treadmill_pid_heart_zone));
         pidHR->setSecondLine(QString::number(hrCurrentZoneRangeMin) + "-" + QString::number(hrCurrentZoneRangeMax));
@@ -5686,7 +5892,25 @@ void homeform::update() {
                 lapTrigger, totalStrokes, avgStrokesRate, maxStrokesRate, avgStrokesLength,
                 bluetoothManager->device()->currentCordinate(), strideLength, groundContact, verticalOscillation, stepCount);
 
+            if (journalResumed) {
+                s.distance += journalResumeDistance;
+                s.calories += journalResumeCalories;
+                s.elapsedTime += journalResumeElapsed;
+                s.totalStrokes += journalResumeStrokes;
+                s.stepCount += journalResumeSteps;
+            }
+
             Session.append(s);
+            journal->append(s, bluetoothManager->device()->deviceType());
+            if (!fitWriter) {
+                fitWriter = new qfitwriter(bluetoothManager->device()->deviceType(),
+                                           qobject_cast<m3ibike *>(bluetoothManager->device())
+                                               ? QFIT_PROCESS_DISTANCENOISE
+                                               : QFIT_PROCESS_NONE);
+            }
+            fitWriter->update(Session);
+            TrainingLoad.setThresholds(snapshot.ftp, snapshot.w_prime);
+            TrainingLoad.append(bluetoothManager->device()->wattsMetric().value());
 
             if (lapTrigger) {
                 lapTrigger = false;
@@ -5918,9 +6142,7 @@ void homeform::fit_save_clicked() {
         if (!stravaPelotonActivityName.isEmpty() && !stravaPelotonInstructorName.isEmpty())
             workoutName = stravaPelotonActivityName + " - " + stravaPelotonInstructorName;
 
-        qfit::save(filename, Session, dev->deviceType(),
-                   qobject_cast<m3ibike *>(dev) ? QFIT_PROCESS_DISTANCENOISE : QFIT_PROCESS_NONE,
-                   stravaPelotonWorkoutType, workoutName, dev->bluetoothDevice.name());
+        saveFit(filename, workoutName);
         lastFitFileSaved = filename;
 
         QSettings settings;
@@ -5939,6 +6161,18 @@ void homeform::fit_save_clicked() {
     }
 }
 
+void homeform::saveFit(const QString &filename, QString workoutName) {
+    bluetoothdevice *dev = bluetoothManager->device();
+    // the records are already encoded, unless something discovered late changed them
+    if (fitWriter && fitWriter->save(filename, Session, stravaPelotonWorkoutType, workoutName,
+                                     dev->bluetoothDevice.name())) {
+        return;
+    }
+    qfit::save(filename, Session, dev->deviceType(),
+               qobject_cast<m3ibike *>(dev) ? QFIT_PROCESS_DISTANCENOISE : QFIT_PROCESS_NONE,
+               stravaPelotonWorkoutType, workoutName, dev->bluetoothDevice.name());
+}
+
 void homeform::strava_upload_file_prepare() {
     QFile f(lastFitFileSaved);
     f.open(QFile::OpenModeFlag::ReadOnly);
@@ -6611,7 +6845,7 @@ void homeform::sendMail() {
     message.addRecipient(new EmailAddress(settings.value(QZSettings::user_email, QLatin1String("")).toString(),
                                           settings.value(QZSettings::user_email, QLatin1String("")).toString()));
     if (!Session.isEmpty()) {
-        QString title = Session.constFirst().time.toString();
+        QString title = Session.time(0).toString();
         if (!stravaPelotonActivityName.isEmpty()) {
             title +=
                 QStringLiteral(" ") + stravaPelotonActivityName + QStringLiteral(" - ") + stravaPelotonInstructorName;
@@ -6994,10 +7228,14 @@ void homeform::loadSettings(const QUrl &filename) {
             }
         }
     }
+    QZSettingsSnapshot::refresh();
 }
 
 void homeform::deleteSettings(const QUrl &filename) { QFile(filename.toLocalFile()).remove(); }
-void homeform::restoreSettings() { QZSettings::restoreAll(); }
+void homeform::restoreSettings() {
+    QZSettings::restoreAll();
+    QZSettingsSnapshot::refresh();
+}
 
 QString homeform::getProfileDir() {
     QString path = getWritableAppDir() + "profiles";
@@ -6,12 +6,15 @@
 #include "fit_profile.hpp"
 #include "gpx.h"
 #include "peloton.h"
+#include "qfit.h"
 #include "qmdnsengine/browser.h"
 #include "qmdnsengine/cache.h"
 #include "qmdnsengine/resolver.h"
 #include "screencapture.h"
-#include "sessionline.h"
+#include "sessionjournal.h"
+#include "sessionstore.h"
 #include "smtpclient/src/SmtpMime"
+#include "trainingload.h"
 #include "trainprogram.h"
 #include <QChart>
 #include <QColor>
@@ -129,6 +132,8 @@ class homeform : public QObject {
     Q_PROPERTY(bool device READ getDevice NOTIFY changeOfdevice)
     Q_PROPERTY(bool lap READ getLap NOTIFY changeOflap)
     Q_PROPERTY(bool pelotonAskStart READ pelotonAskStart NOTIFY changePelotonAskStart WRITE setPelotonAskStart)
+    Q_PROPERTY(bool journalRecoveryAsk READ journalRecoveryAsk NOTIFY changeJournalRecoveryAsk WRITE
+                   setJournalRecoveryAsk)
     Q_PROPERTY(QString pelotonProvider READ pelotonProvider NOTIFY changePelotonProvider WRITE setPelotonProvider)
     Q_PROPERTY(int topBarHeight READ topBarHeight NOTIFY topBarHeightChanged)
     Q_PROPERTY(QString info READ info NOTIFY infoChanged)
@@ -367,7 +372,7 @@ class homeform : public QObject {
     QString stopColor();
     QString workoutStartDate() {
         if (!Session.isEmpty()) {
-            return Session.constFirst().time.toString();
+            return Session.time(0).toString();
         } else {
             return QLatin1String("");
         }
@@ -395,6 +400,7 @@ class homeform : public QObject {
     int pzpLogin() { return m_pzpLoginState; }
     int zwiftLogin() { return m_zwiftLoginState; }
     void setPelotonAskStart(bool value) { m_pelotonAskStart = value; }
+    void setJournalRecoveryAsk(bool value) { m_journalRecoveryAsk = value; }
     QString pelotonProvider() { return m_pelotonProvider; }
     QString toastRequested() { return m_toastRequested; }
     bool stravaUploadRequested() { return m_stravaUploadRequested; }
@@ -479,46 +485,52 @@ class homeform : public QObject {
     Q_INVOKABLE void sendMail();
 
     Q_INVOKABLE void sortTiles();
+    /**
+     * @brief Called by main.qml every time a page is pushed or popped, so every page that writes settings is
+     * covered: the settings snapshot is refreshed once the pending values of the page are written.
+     */
+    Q_INVOKABLE void settingsChanged();
     Q_INVOKABLE void moveTile(QString name, int newIndex, int oldIndex);
     DataObject *tileFromName(QString name);
+    const trainingload &trainingLoad() const { return TrainingLoad; }
 
     QList<double> workout_watt_points() {
         QList<double> l;
         l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.watt);
+        for (auto v : Session.watt()) {
+            l.append(v);
         }
         return l;
     }
     QList<double> workout_heart_points() {
         QList<double> l;
         l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.heart);
+        for (auto v : Session.heart()) {
+            l.append(v);
         }
         return l;
     }
     QList<double> workout_cadence_points() {
         QList<double> l;
         l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.cadence);
+        for (auto v : Session.cadence()) {
+            l.append(v);
         }
         return l;
     }
     QList<double> workout_resistance_points() {
         QList<double> l;
         l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.resistance);
+        for (auto v : Session.resistance()) {
+            l.append(v);
         }
         return l;
     }
     QList<double> workout_peloton_resistance_points() {
         QList<double> l;
         l.reserve(Session.size() + 1);
-        for (const SessionLine &s : qAsConst(Session)) {
-            l.append(s.peloton_resistance);
+        for (auto v : Session.peloton_resistance()) {
+            l.append(v);
         }
         return l;
     }
@@ -529,7 +541,7 @@ class homeform : public QObject {
             return l;
         QTime d = previewTrainProgram->duration();
         l.reserve((d.hour() * 3600) + (d.minute() * 60) + d.second() + 1);
-        foreach (trainrow r, previewTrainProgram->loadedRows) {
+        for (const trainrow &r : qAsConst(previewTrainProgram->loadedRows)) {
             for (int i = 0; i < (r.duration.hour() * 3600) + (r.duration.minute() * 60) + r.duration.second(); i++) {
                 l.append(r.power);
             }
@@ -628,13 +640,35 @@ class homeform : public QObject {
     DataObject *stepCount;
     DataObject *ergMode;
     DataObject *rss;
+    DataObject *peakPower;
+    DataObject *normalizedPower;
+    DataObject *trainingStressScore;
+    DataObject *wPrimeBalance;
+    DataObject *watt3s;
+    DataObject *watt30s;
 
   private:
     static homeform *m_singleton;
     TemplateInfoSenderBuilder *userTemplateManager = nullptr;
     TemplateInfoSenderBuilder *innerTemplateManager = nullptr;
     QList<QObject *> dataList;
-    QList<SessionLine> Session;
+    sessionstore Session;
+    trainingload TrainingLoad;
+
+    // FIT file of Session, encoded while the workout goes on
+    qfitwriter *fitWriter = nullptr;
+    void saveFit(const QString &filename, QString workoutName);
+
+    // crash-safe copy of Session, see sessionjournal
+    sessionjournal *journal = nullptr;
+    QString journalRecoveryFilename;
+    // totals of a resumed workout, added to the lines recorded after the resume
+    bool journalResumed = false;
+    double journalResumeDistance = 0;
+    double journalResumeCalories = 0;
+    uint32_t journalResumeElapsed = 0;
+    uint32_t journalResumeStrokes = 0;
+    double journalResumeSteps = 0;
     bluetooth *bluetoothManager;
     QQmlApplicationEngine *engine;
     trainprogram *trainProgram = nullptr;
@@ -666,6 +700,7 @@ class homeform : public QObject {
 
     peloton *pelotonHandler = nullptr;
     bool m_pelotonAskStart = false;
+    bool m_journalRecoveryAsk = false;
     QString m_pelotonProvider = "";
     QString m_toastRequested = "";
     bool m_stravaUploadRequested = false;
@@ -729,6 +764,9 @@ class homeform : public QObject {
     void licenseRequest();
 #endif
 
+    // debounces settingsChanged(): Qt.labs.settings writes the values of a page up to 500ms after the change
+    QTimer settingsSnapshotTimer;
+
     QGeoPath gpx_preview;
     PathController pathController;
     bool videoMustBeReset = true;
@@ -756,6 +794,7 @@ class homeform : public QObject {
     void saveProfile(QString profilename);
     void restart();
     bool pelotonAskStart() { return m_pelotonAskStart; }
+    bool journalRecoveryAsk() { return m_journalRecoveryAsk; }
 
   private slots:
     void Start();
@@ -803,6 +842,8 @@ class homeform : public QObject {
     void pzpLoginState(bool ok);
     void peloton_start_workout();
     void peloton_abort_workout();
+    void journal_resume();
+    void journal_export();
     void smtpError(SmtpClient::SmtpError e);
     void setActivityDescription(QString newdesc);
     void chartSaved(QString fileName);
@@ -842,6 +883,7 @@ class homeform : public QObject {
     void tile_orderChanged(QStringList value);
     void changeLabelHelp(bool value);
     void changePelotonAskStart(bool value);
+    void changeJournalRecoveryAsk(bool value);
     void changePelotonProvider(QString value);
     void toastRequestedChanged(QString value);
     void stravaUploadRequestedChanged(bool value);
@@ -0,0 +1,59 @@
+#include "latencyhistogram.h"
+
+namespace {
+const qint64 firstBucketNs = 250000;
+
+QString msecs(qint64 nsecs) { return QString::number(nsecs / 1000000.0, 'g', 3) + QStringLiteral("ms"); }
+} // namespace
+
+void latencyhistogram::add(qint64 nsecs) {
+    if (nsecs < 0) {
+        nsecs = 0;
+    }
+    int bucket = 0;
+    qint64 upper = firstBucketNs;
+    while (bucket < Buckets - 1 && nsecs >= upper) {
+        bucket++;
+        upper <<= 1;
+    }
+    m_buckets[bucket]++;
+    m_count++;
+    m_totalNs += nsecs;
+    m_maxNs = qMax(m_maxNs, nsecs);
+}
+
+void latencyhistogram::clear() {
+    m_buckets.fill(0);
+    m_count = 0;
+    m_totalNs = 0;
+    m_maxNs = 0;
+}
+
+qint64 latencyhistogram::bucketUpperNs(int bucket) const {
+    if (bucket >= Buckets - 1) {
+        return m_maxNs;
+    }
+    return firstBucketNs << bucket;
+}
+
+qint64 latencyhistogram::percentileNs(double fraction) const {
+    if (m_count == 0) {
+        return 0;
+    }
+    const quint64 wanted = qMax<quint64>(1, quint64(qBound(0.0, fraction, 1.0) * m_count + 0.5));
+    quint64 seen = 0;
+    for (int i = 0; i < Buckets; i++) {
+        seen += m_buckets[i];
+        if (seen >= wanted) {
+            return qMin(bucketUpperNs(i), m_maxNs);
+        }
+    }
+    return m_maxNs;
+}
+
+QString latencyhistogram::toString() const {
+    return QStringLiteral("n=%1 mean=%2 p50<%3 p90<%4 p99<%5 max=%6")
+        .arg(m_count)
+        .arg(msecs(qint64(meanNs())), msecs(percentileNs(0.5)), msecs(percentileNs(0.9)), msecs(percentileNs(0.99)),
+             msecs(m_maxNs));
+}
@@ -0,0 +1,50 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <QString>
+#include <QtGlobal>
+#include <array>
+
+/**
+ * @brief Histogram of latencies with power of two buckets, from 250 us to 4 s.
+ *
+ * The bucket i counts the samples under 250 us * 2^i, the last one everything above 4 s. add() is a few instructions
+ * and never allocates, so it can be called for every notification; the percentiles are the upper bound of their
+ * bucket, capped to the largest sample.
+ */
+class latencyhistogram {
+  public:
+    static constexpr int Buckets = 16;
+
+    void add(qint64 nsecs);
+    void clear();
+
+    quint64 count() const { return m_count; }
+    quint64 bucketCount(int bucket) const { return m_buckets[bucket]; }
+    qint64 maxNs() const { return m_maxNs; }
+    double meanNs() const { return m_count ? (double)m_totalNs / m_count : 0.0; }
+
+    /**
+     * @brief The upper bound of the bucket i, in nanoseconds. The last bucket has no bound: its value is the largest
+     * sample.
+     */
+    qint64 bucketUpperNs(int bucket) const;
+
+    /**
+     * @brief The latency under which the given fraction (0..1) of the samples is.
+     */
+    qint64 percentileNs(double fraction) const;
+
+    /**
+     * @brief "n=120 mean=3.1ms p50<2ms p90<8ms p99<16ms max=11.7ms", for the logs.
+     */
+    QString toString() const;
+
+  private:
+    std::array<quint64, Buckets> m_buckets{};
+    quint64 m_count = 0;
+    qint64 m_totalNs = 0;
+    qint64 m_maxNs = 0;
+};
+
+#endif // LATENCYHISTOGRAM_H
@@ -0,0 +1,232 @@
+#include "logwriter.h"
+#include <QDateTime>
+#include <QDeadlineTimer>
+#include <QMutexLocker>
+#include <cstdio>
+
+namespace {
+quint64 ringSize(int capacity) {
+    quint64 size = 2;
+    while (size < quint64(qMax(capacity, 2))) {
+        size <<= 1;
+    }
+    return size;
+}
+} // namespace
+
+logwriter::logwriter(const QString &filename, int capacity)
+    : m_filename(filename), m_slots(new slot[ringSize(capacity)]), m_mask(ringSize(capacity) - 1) {
+    for (quint64 i = 0; i <= m_mask; i++) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_thread = QThread::create([this] { run(); });
+    m_thread->start(QThread::LowPriority);
+}
+
+logwriter::~logwriter() {
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stop = true;
+        m_wake.wakeAll();
+    }
+    m_thread->wait();
+    delete m_thread;
+}
+
+bool logwriter::append(QByteArray line) {
+    quint64 pos = m_enqueue.load(std::memory_order_relaxed);
+    forever {
+        slot &s = m_slots[pos & m_mask];
+        const qint64 diff = qint64(s.sequence.load(std::memory_order_acquire)) - qint64(pos);
+        if (diff == 0) {
+            if (m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                s.line = std::move(line);
+                s.sequence.store(pos + 1, std::memory_order_release);
+                // the writer is woken every half ring, without waiting for the mutex: a wake lost because the writer
+                // wasn't waiting yet costs at most a flush interval
+                if (((pos + 1) & (m_mask >> 1)) == 0) {
+                    m_wake.wakeOne();
+                }
+                return true;
+            }
+        } else if (diff < 0) {
+            // the slot still holds a line of the previous lap: the ring is full
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = m_enqueue.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool logwriter::flush(int timeoutMs) {
+    QDeadlineTimer deadline(timeoutMs < 0 ? QDeadlineTimer(QDeadlineTimer::Forever) : QDeadlineTimer(timeoutMs));
+    if (!m_mutex.tryLock(int(deadline.remainingTime()))) {
+        return false;
+    }
+    const quint64 ticket = ++m_requests;
+    m_wake.wakeAll();
+    while (m_done < ticket) {
+        if (!m_idle.wait(&m_mutex, deadline)) {
+            break;
+        }
+    }
+    const bool written = m_done >= ticket;
+    m_mutex.unlock();
+    return written;
+}
+
+void logwriter::setFlushIntervalMs(int ms) {
+    QMutexLocker locker(&m_mutex);
+    m_flushIntervalMs = ms;
+}
+
+void logwriter::setMaxBytes(qint64 bytes) {
+    QMutexLocker locker(&m_mutex);
+    m_maxBytes = bytes;
+}
+
+void logwriter::setMaxFiles(int files) {
+    QMutexLocker locker(&m_mutex);
+    m_maxFiles = files;
+}
+
+void logwriter::setEchoStderr(bool echo) {
+    QMutexLocker locker(&m_mutex);
+    m_echoStderr = echo;
+}
+
+QString logwriter::rotatedFilename(int n) const {
+    const QString log = QStringLiteral(".log");
+    if (m_filename.endsWith(log)) {
+        return m_filename.left(m_filename.length() - log.length()) + QStringLiteral(".%1.log").arg(n);
+    }
+    return m_filename + QStringLiteral(".%1").arg(n);
+}
+
+QByteArray logwriter::format(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
+    // QDateTime::toString() is the most of the cost of a line and it changes once a second
+    thread_local qint64 second = -1;
+    thread_local QByteArray date;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (now / 1000 != second) {
+        second = now / 1000;
+        date = QDateTime::fromMSecsSinceEpoch(now).toString().toUtf8();
+    }
+
+    const char *level = "Debug";
+    switch (type) {
+    case QtInfoMsg:
+        level = "Info";
+        break;
+    case QtDebugMsg:
+        level = "Debug";
+        break;
+    case QtWarningMsg:
+        level = "Warning";
+        break;
+    case QtCriticalMsg:
+        level = "Critical";
+        break;
+    case QtFatalMsg:
+        level = "Fatal";
+        break;
+    }
+
+    const QByteArray message = msg.toUtf8();
+    QByteArray line;
+    line.reserve(date.size() + message.size() + 160);
+    line += date;
+    line += ' ';
+    line += QByteArray::number(now);
+    line += ' ';
+    line += level;
+    line += ": ";
+    line += context.file ? context.file : "";
+    line += ' ';
+    line += context.function ? context.function : "";
+    line += ' ';
+    line += message;
+    line += '\n';
+    return line;
+}
+
+void logwriter::drain(QByteArray &batch) {
+    forever {
+        slot &s = m_slots[m_dequeue & m_mask];
+        if (s.sequence.load(std::memory_order_acquire) != m_dequeue + 1) {
+            break;
+        }
+        batch += s.line;
+        // the line is freed here, not by the producer of the next lap
+        s.line = QByteArray();
+        s.sequence.store(m_dequeue + m_mask + 1, std::memory_order_release);
+        m_dequeue++;
+    }
+}
+
+void logwriter::rotate(int maxFiles) {
+    m_file.close();
+    QFile::remove(rotatedFilename(maxFiles));
+    for (int i = maxFiles - 1; i >= 1; i--) {
+        QFile::rename(rotatedFilename(i), rotatedFilename(i + 1));
+    }
+    if (maxFiles > 0) {
+        QFile::rename(m_filename, rotatedFilename(1));
+    }
+    m_file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+}
+
+void logwriter::run() {
+    m_file.setFileName(m_filename);
+    // no qDebug here: it would come back to this writer
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        fprintf(stderr, "log: unable to open %s\n", m_filename.toLocal8Bit().constData());
+    }
+
+    QByteArray batch;
+    batch.reserve(256 * 1024);
+
+    QMutexLocker locker(&m_mutex);
+    forever {
+        if (!m_stop && m_done == m_requests) {
+            m_wake.wait(&m_mutex, m_flushIntervalMs);
+        }
+        const bool stop = m_stop;
+        const quint64 ticket = m_requests;
+        const qint64 maxBytes = m_maxBytes;
+        const int maxFiles = m_maxFiles;
+        const bool echoStderr = m_echoStderr;
+        locker.unlock();
+
+        drain(batch);
+        const quint64 dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped != m_reported) {
+            batch += format(QtWarningMsg, QMessageLogContext(),
+                            QStringLiteral("log: %1 lines dropped, the disk is too slow").arg(dropped - m_reported));
+            m_reported = dropped;
+        }
+        if (!batch.isEmpty()) {
+            if (m_file.isOpen()) {
+                m_file.write(batch);
+                m_file.flush();
+                if (m_file.size() >= maxBytes) {
+                    rotate(maxFiles);
+                }
+            }
+            if (echoStderr) {
+                fwrite(batch.constData(), 1, batch.size(), stderr);
+            }
+            // the reserved capacity is kept for the next batch
+            batch.resize(0);
+        }
+
+        locker.relock();
+        m_done = ticket;
+        m_idle.wakeAll();
+        if (stop) {
+            break;
+        }
+    }
+    m_file.close();
+}
@@ -0,0 +1,106 @@
+#ifndef LOGWRITER_H
+#define LOGWRITER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+
+/**
+ * @brief Appends the debug log to its file from a writer thread, so a qDebug costs the formatting of the line and
+ * nothing else.
+ *
+ * append() reserves a slot of a fixed size ring with one compare and swap and moves the line in it: it never locks and
+ * never waits, from any thread. The writer drains the ring every flushIntervalMs milliseconds, or as soon as half of
+ * it is filled, and writes the whole batch with one write. If the producers outrun the disk and the ring is full the
+ * line is dropped and counted, the writer logs how many lines were lost with the next batch.
+ *
+ * When the file grows past maxBytes it's renamed to name.1.log, the older ones to name.2.log and so on up to
+ * maxFiles, and a new file is started with the same name.
+ */
+class logwriter {
+
+  public:
+    explicit logwriter(const QString &filename, int capacity = 16384);
+    ~logwriter();
+
+    /**
+     * @brief Queues a line, terminated by its new line.
+     * @return false if the ring is full and the line was dropped.
+     */
+    bool append(QByteArray line);
+
+    /**
+     * @brief Waits until every line appended before the call is written.
+     * @param timeoutMs The longest wait, negative to wait as long as it takes: the crash handler must not hang on a
+     * writer thread that crashed.
+     * @return false if the timeout expired first.
+     */
+    bool flush(int timeoutMs = -1);
+
+    /**
+     * @brief The lines dropped since the start.
+     */
+    quint64 dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    QString filename() const { return m_filename; }
+
+    void setFlushIntervalMs(int ms);
+    void setMaxBytes(qint64 bytes);
+    void setMaxFiles(int files);
+    // the lines are echoed on stderr too, as the message handler always did
+    void setEchoStderr(bool echo);
+
+    /**
+     * @brief The name of the n-th rotated file, n >= 1.
+     */
+    QString rotatedFilename(int n) const;
+
+    /**
+     * @brief Formats a message as "<date> <msecs since epoch> <Type>: <file> <function> <message>\n", the date is
+     * formatted once a second for each thread.
+     */
+    static QByteArray format(QtMsgType type, const QMessageLogContext &context, const QString &msg);
+
+  private:
+    struct slot {
+        std::atomic<quint64> sequence;
+        QByteArray line;
+    };
+
+    void run();
+    // moves the queued lines to the batch, in the order of their slots
+    void drain(QByteArray &batch);
+    void rotate(int maxFiles);
+
+    QString m_filename;
+    QFile m_file;
+    QThread *m_thread = nullptr;
+
+    std::unique_ptr<slot[]> m_slots;
+    const quint64 m_mask;
+    alignas(64) std::atomic<quint64> m_enqueue{0};
+    alignas(64) quint64 m_dequeue = 0;
+    std::atomic<quint64> m_dropped{0};
+    quint64 m_reported = 0;
+
+    // protected by m_mutex
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    QWaitCondition m_idle;
+    bool m_stop = false;
+    // flush() waits until the writer has handled its request
+    quint64 m_requests = 0;
+    quint64 m_done = 0;
+    int m_flushIntervalMs = 200;
+    qint64 m_maxBytes = 50 * 1024 * 1024;
+    int m_maxFiles = 3;
+    bool m_echoStderr = true;
+};
+
+#endif // LOGWRITER_H
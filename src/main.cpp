@@ -1,5 +1,6 @@
 #include <QApplication>
 #include <QStyleFactory>
+#include <csignal>
 #include <stdio.h>
 #include <stdlib.h>
 #ifdef Q_OS_LINUX
@@ -12,8 +13,11 @@
 #include "bluetooth.h"
 #include "devices/domyostreadmill/domyostreadmill.h"
 #include "homeform.h"
+#include "logwriter.h"
 #include "mainwindow.h"
 #include "qfit.h"
+#include "qzlog.h"
+#include "qzsettingssnapshot.h"
 #include "virtualdevices/virtualtreadmill.h"
 #include <QDir>
 #include <QGuiApplication>
@@ -232,10 +236,30 @@ QCoreApplication *createApplication(int &argc, char *argv[]) {
     }
 }
 
+// the debug log, opened with the first message logged
+static logwriter *debugLog = nullptr;
+
+static void flushDebugLogAndCrash(int sig) {
+    // the writer thread may be the one that crashed: it's waited for a second at most
+    debugLog->flush(1000);
+    std::signal(sig, SIG_DFL);
+    std::raise(sig);
+}
+
+static logwriter *openDebugLog() {
+    // Linux log files are generated on binary location
+    debugLog = new logwriter(homeform::getWritableAppDir() + logfilename);
+    qAddPostRoutine([] { debugLog->flush(); });
+    // the lines still in the ring are written before the app dies
+    for (int sig : {SIGSEGV, SIGABRT, SIGFPE, SIGILL}) {
+        std::signal(sig, flushDebugLogAndCrash);
+    }
+    return debugLog;
+}
+
 void myMessageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
 
-    QSettings settings;
-    static bool logdebug = settings.value(QZSettings::log_debug, QZSettings::default_log_debug).toBool();
+    static bool logdebug = QSettings().value(QZSettings::log_debug, QZSettings::default_log_debug).toBool();
 #if defined(Q_OS_LINUX) // Linux OS does not read settings file for now
     if ((logs == false && !forceQml) || (logdebug == false && forceQml))
 #else
@@ -243,40 +267,20 @@ void myMessageOutput(QtMsgType type, const QMessageLogContext &context, const QS
 #endif
         return;
 
-    // QByteArray localMsg = msg.toLocal8Bit(); // NOTE: clazy-unused-non-trivial-variable
-    const char *file = context.file ? context.file : "";
-    const char *function = context.function ? context.function : "";
-    QString txt = QDateTime::currentDateTime().toString() + QStringLiteral(" ") +
-                  QString::number(QDateTime::currentMSecsSinceEpoch()) + QStringLiteral(" ");
-    switch (type) {
-    case QtInfoMsg:
-        txt += QStringLiteral("Info: %1 %2 %3\n").arg(file, function, msg); // NOTE: clazy-qstring-arg
-        break;
-    case QtDebugMsg:
-        txt += QStringLiteral("Debug: %1 %2 %3\n").arg(file, function, msg); // NOTE: clazy-qstring-arg
-        break;
-    case QtWarningMsg:
-        txt += QStringLiteral("Warning: %1 %2 %3\n").arg(file, function, msg); // NOTE: clazy-qstring-arg
-        break;
-    case QtCriticalMsg:
-        txt += QStringLiteral("Critical: %1 %2 %3\n").arg(file, function, msg); // NOTE: clazy-qstring-arg
-        break;
-    case QtFatalMsg:
-        txt += QStringLiteral("Fatal: %1 %2 %3\n").arg(file, function, msg); // NOTE: clazy-qstring-arg
-        abort();
-    }
-
     if (logs == true || logdebug == true) {
 
-        QString path = homeform::getWritableAppDir();
-
-        // Linux log files are generated on binary location
+        // the file is written, and echoed on stderr, by the writer thread: the message is only formatted here
+        static logwriter *writer = openDebugLog();
+        writer->append(logwriter::format(type, context, msg));
+        // a critical message often comes right before a crash and a fatal one is followed by abort(): they're on disk
+        // before going on
+        if (type == QtCriticalMsg || type == QtFatalMsg) {
+            writer->flush(1000);
+        }
+    }
 
-        QFile outFile(path + logfilename);
-        outFile.open(QIODevice::WriteOnly | QIODevice::Append);
-        QTextStream ts(&outFile);
-        ts << txt;
-        fprintf(stderr, "%s", txt.toLocal8Bit().constData());
+    if (type == QtFatalMsg) {
+        abort();
     }
     (*QT_DEFAULT_MESSAGE_HANDLER)(type, context, msg);
 }
@@ -393,6 +397,8 @@ int main(int argc, char *argv[]) {
         settings.setValue(QZSettings::reebok_fr30_treadmill, reebok_fr30_treadmill);
     }
 #endif
+    // the profile and the command line options are written: the devices read them from the snapshot
+    QZSettingsSnapshot::refresh();
 
 #ifdef Q_OS_ANDROID
     if (settings.value(QZSettings::volume_change_gears, QZSettings::default_volume_change_gears).toBool()) {
@@ -402,6 +408,15 @@ int main(int argc, char *argv[]) {
 #endif
     
     qInstallMessageHandler(myMessageOutput);
+    {
+        // the same condition of myMessageOutput: if nothing is written, the qz categories don't even format it
+        const bool logdebug = settings.value(QZSettings::log_debug, QZSettings::default_log_debug).toBool();
+#if defined(Q_OS_LINUX)
+        qzlog::configure(settings, forceQml ? logdebug : logs);
+#else
+        qzlog::configure(settings, logdebug);
+#endif
+    }
     qDebug() << QStringLiteral("version ") << app->applicationVersion();
     foreach (QString s, settings.allKeys()) {
         if (!s.contains(QStringLiteral("password")) && !s.contains("user_email")) {
@@ -418,7 +433,7 @@ int main(int argc, char *argv[]) {
 #endif
 
 #if 0 // test gpx or fit export
-    QList<SessionLine> l;
+    sessionstore l;
     for(int i =0; i< 500; i++)
     {
         QDateTime d = QDateTime::currentDateTime();
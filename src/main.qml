@@ -814,6 +814,8 @@ ApplicationWindow {
         initialItem: "Home.qml"
         anchors.fill: parent
         focus: true
+        // every page writing settings is pushed here: publish the new settings snapshot when it's closed
+        onDepthChanged: if (typeof rootItem !== "undefined") rootItem.settingsChanged()
         Keys.onVolumeUpPressed: (event)=> { console.log("onVolumeUpPressed"); volumeUp(); event.accepted = settings.volume_change_gears; }
         Keys.onVolumeDownPressed: (event)=> { console.log("onVolumeDownPressed"); volumeDown(); event.accepted = settings.volume_change_gears; }
         Keys.onPressed: (event)=> {
@@ -1,6 +1,7 @@
 #include "metric.h"
 #include "qdebugfixup.h"
 #include "qzsettings.h"
+#include "qzsettingssnapshot.h"
 #include <QSettings>
 
 #ifdef TEST
@@ -13,39 +14,37 @@ metric::metric() {}
 void metric::setType(_metric_type t) { m_type = t; }
 
 void metric::setValue(double v, bool applyGainAndOffset) {
-    QSettings settings;
     if (applyGainAndOffset) {
+        const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
         if (m_type == METRIC_WATT) {
             if (v > 0) {
-                if (settings.value(QZSettings::watt_gain, QZSettings::default_watt_gain).toDouble() <= 2.00) {
-                    if (settings.value(QZSettings::watt_gain, QZSettings::default_watt_gain).toDouble() != 1.0) {
+                if (snapshot.watt_gain <= 2.00) {
+                    if (snapshot.watt_gain != 1.0) {
                         qDebug() << QStringLiteral("watt value was ") << v
-                                 << QStringLiteral("but it will be transformed to")
-                                 << v * settings.value(QZSettings::watt_gain, QZSettings::default_watt_gain).toDouble();
+                                 << QStringLiteral("but it will be transformed to") << v * snapshot.watt_gain;
                     }
-                    v *= settings.value(QZSettings::watt_gain, QZSettings::default_watt_gain).toDouble();
+                    v *= snapshot.watt_gain;
                 }
-                if (settings.value(QZSettings::watt_offset, QZSettings::default_watt_offset).toDouble() != 0.0) {
-                    qDebug()
-                        << QStringLiteral("watt value was ") << v << QStringLiteral("but it will be transformed to")
-                        << v + settings.value(QZSettings::watt_offset, QZSettings::default_watt_offset).toDouble();
-                    v += settings.value(QZSettings::watt_offset, QZSettings::default_watt_offset).toDouble();
+                if (snapshot.watt_offset != 0.0) {
+                    qDebug() << QStringLiteral("watt value was ") << v
+                             << QStringLiteral("but it will be transformed to") << v + snapshot.watt_offset;
+                    v += snapshot.watt_offset;
                 }
             }
         } else if (m_type == METRIC_SPEED) {
             if (v > 0) {
-                v *= settings.value(QZSettings::speed_gain, QZSettings::default_speed_gain).toDouble();
-                v += settings.value(QZSettings::speed_offset, QZSettings::default_speed_offset).toDouble();
+                v *= snapshot.speed_gain;
+                v += snapshot.speed_offset;
             }
         }
     }
 
-    QDateTime now = QDateTime::currentDateTime();
+    qint64 now = monotonicclock::nsecs();
     if (v != m_value && v != INFINITY) {
         m_valueChanged = now;
-        if (m_last5.count() > 1) {
+        if (m_lastValues.count() > 1) {
             double diff = v - m_value;
-            double diffFromLastValue = qAbs(now.msecsTo(m_lastChanged));
+            double diffFromLastValue = (now - m_lastChanged) / 1000000;
             if (diffFromLastValue > 0)
                 m_rateAtSec = diff * (1000.0 / diffFromLastValue);
             else
@@ -67,14 +66,12 @@ void metric::setValue(double v, bool applyGainAndOffset) {
         m_lapCountValue++;
         m_totValue += value();
         m_lapTotValue += value();
-        m_last5.append(value());
-        m_last20.append(value());
-
-        if (m_last5.count() > 5)
-            m_last5.removeAt(0);
-
-        if (m_last20.count() > 20)
-            m_last20.removeAt(0);
+        if (m_lastValues.count() == 0) {
+            m_ema = value();
+        } else {
+            m_ema += m_emaAlpha * (value() - m_ema);
+        }
+        m_lastValues.append(value());
 
         if (value() < m_min) {
             m_min = value();
@@ -102,8 +99,8 @@ void metric::clear(bool accumulator) {
     m_totValue = 0;
     m_countValue = 0;
     m_min = 999999999;
-    m_last5.clear();
-    m_last20.clear();
+    m_lastValues.clear();
+    m_ema = 0;
     clearLap(accumulator);
 #ifdef TEST
     random_value_uint8 = 0;
@@ -111,11 +108,11 @@ void metric::clear(bool accumulator) {
 #endif
 }
 
-double metric::valueRaw() {
+double metric::valueRaw() const {
     return m_value;
 }
 
-double metric::value() {
+double metric::value() const {
 #ifdef TEST
     if (m_type != METRIC_ELAPSED) {
         return (double)(rand() % 256);
@@ -127,9 +124,9 @@ double metric::value() {
     return m_value - m_offset;
 }
 
-double metric::lapValue() { return m_value - m_lapOffset; }
+double metric::lapValue() const { return m_value - m_lapOffset; }
 
-double metric::average() {
+double metric::average() const {
     if (m_countValue == 0) {
         return 0;
     } else {
@@ -137,7 +134,7 @@ double metric::average() {
     }
 }
 
-double metric::lapAverage() {
+double metric::lapAverage() const {
     if (m_lapCountValue == 0) {
         return 0;
     } else {
@@ -145,58 +142,27 @@ double metric::lapAverage() {
     }
 }
 
-double metric::average5s() {
-    if (m_last5.count() == 0)
-        return 0;
-    else {
-        double sum = 0;
-        uint8_t c = 0;
-        QMutableListIterator<double> i(m_last5);
-        while (i.hasNext()) {
-            double b = i.next();
-            sum += b;
-            c++;
-        }
-
-        if (c > 0)
-            return (sum / c);
-        else
-            return 0;
-    }
-}
+double metric::average5s() const { return m_lastValues.average(5); }
 
-double metric::average20s() {
-    if (m_last20.count() == 0)
-        return 0;
-    else {
-        double sum = 0;
-        uint8_t c = 0;
-        QMutableListIterator<double> i(m_last20);
-        while (i.hasNext()) {
-            double b = i.next();
-            sum += b;
-            c++;
-        }
+double metric::average20s() const { return m_lastValues.average(20); }
 
-        if (c > 0)
-            return (sum / c);
-        else
-            return 0;
-    }
+void metric::setEmaSamples(int samples) {
+    if (samples < 1)
+        samples = 1;
+    m_emaAlpha = 2.0 / (((double)samples) + 1.0);
 }
 
-
 void metric::operator=(double v) { setValue(v); }
 
 void metric::operator+=(double v) { setValue(m_value + v); }
 
-double metric::min() { return m_min; }
+double metric::min() const { return m_min; }
 
-double metric::max() { return m_max; }
+double metric::max() const { return m_max; }
 
-double metric::lapMin() { return m_lapMin; }
+double metric::lapMin() const { return m_lapMin; }
 
-double metric::lapMax() { return m_lapMax; }
+double metric::lapMax() const { return m_lapMax; }
 
 void metric::setPaused(bool p) { paused = p; }
 
@@ -213,11 +179,9 @@ void metric::clearLap(bool accumulator) {
 void metric::setLap(bool accumulator) { clearLap(accumulator); }
 
 double metric::calculateMaxSpeedFromPower(double power, double inclination) {
-    QSettings settings;
-    double rolling_resistance =
-        settings.value(QZSettings::rolling_resistance, QZSettings::default_rolling_resistance).toFloat();
-    double twt = 9.8 * (settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() +
-                        settings.value(QZSettings::bike_weight, QZSettings::default_bike_weight).toFloat());
+    const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
+    double rolling_resistance = snapshot.rolling_resistance;
+    double twt = 9.8 * (snapshot.weight + snapshot.bike_weight);
     double aero = 0.22691607640851885;
     double hw = 0; // wind speed
     double tr = twt * ((inclination / 100.0) + rolling_resistance);
@@ -245,25 +209,23 @@ double metric::calculateMaxSpeedFromPower(double power, double inclination) {
 }
 
 double metric::calculatePowerFromSpeed(double speed, double inclination) {
-    QSettings settings;
-    double rolling_resistance =
-        settings.value(QZSettings::rolling_resistance, QZSettings::default_rolling_resistance).toFloat();
+    const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
+    double rolling_resistance = snapshot.rolling_resistance;
     double v = speed / 3.6; // converted to m/s;
     double tv = v + 0;
     double tran = 0.95;
     const double aero = 0.22691607640851885;
     double A2Eff = (tv > 0.0) ? aero : -aero; // wind in face, must reverse effect
-    double twt = 9.8 * (settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() +
-                        settings.value(QZSettings::bike_weight, QZSettings::default_bike_weight).toFloat());
+    double twt = 9.8 * (snapshot.weight + snapshot.bike_weight);
     double tr = twt * ((inclination / 100.0) + rolling_resistance);
     return (v * tr + v * tv * tv * A2Eff) / tran;
 }
 
 double metric::calculateSpeedFromPower(double power, double inclination, double speed, double deltaTimeSeconds,
                                        double speedLimit) {
-    QSettings settings;
-    double speed_gain = settings.value(QZSettings::speed_gain, QZSettings::default_speed_gain).toDouble();
-    double speed_offset = settings.value(QZSettings::speed_offset, QZSettings::default_speed_offset).toDouble();
+    const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
+    double speed_gain = snapshot.speed_gain;
+    double speed_offset = snapshot.speed_offset;
     if (inclination < -5)
         inclination = -5;
     if (speed_offset != QZSettings::default_speed_offset)
@@ -271,8 +233,7 @@ double metric::calculateSpeedFromPower(double power, double inclination, double
     if (speed_gain != QZSettings::default_speed_gain)
         speed /= speed_gain;
 
-    double fullWeight = (settings.value(QZSettings::weight, QZSettings::default_weight).toFloat() +
-                         settings.value(QZSettings::bike_weight, QZSettings::default_bike_weight).toFloat());
+    double fullWeight = (snapshot.weight + snapshot.bike_weight);
     double maxSpeed = calculateMaxSpeedFromPower(power, inclination);
     double maxPowerFromSpeed = calculatePowerFromSpeed(speed, inclination);
     double acceleration = (power - maxPowerFromSpeed) / fullWeight;
@@ -295,73 +256,20 @@ double metric::calculateWeightLoss(double kcal) {
     return kcal / 7716.1854; // comes from 1 lbs = 3500 kcal. Converted to kg
 }
 
-struct IntervalBest {
-    double avg = 0;
-    int64_t start = 0;
-    int64_t stop = 0;
-};
-
-struct CompareBests {
-    // Sort by decreasing power and increasing start time.
-    bool operator()(const IntervalBest &a, const IntervalBest &b) const {
-        if (a.avg > b.avg)
-            return true;
-        if (b.avg > a.avg)
-            return false;
-        return a.start < b.start;
-    }
-};
-
-double metric::powerPeak(QList<SessionLine> *session, int seconds) {
-    QList<IntervalBest> bests;
-    QList<IntervalBest> _results;
-
-    uint windowSize = seconds;
-    double total = 0.0;
-    QList<const SessionLine *> window;
-
+double metric::powerPeak(const sessionstore *session, int seconds) {
     if (session->count() == 0)
         return -1;
 
-           // ride is shorter than the window size!
-    if (windowSize > session->last().elapsedTime)
+    // ride is shorter than the window size!
+    if (seconds > session->powerCurve().count())
         return -1;
 
-    int i = 0;
-    // We're looking for intervals with durations in [windowSizeSecs, windowSizeSecs + secsDelta).
-    foreach (SessionLine point, *session) {
-
-        total += point.watt;
-        window.append(&session->at(i));
-        double duration = window.last()->elapsedTime - window.first()->elapsedTime;
-
-        if (duration >= windowSize) {
-            double start = window.first()->elapsedTime;
-            double stop = window.last()->elapsedTime;
-            double avg = total / duration;
-            IntervalBest b;
-            b.start = start;
-            b.stop = stop;
-            b.avg = avg;
-            bests.append(b);
-
-            total -= window.first()->watt;
-            window.removeFirst();
-        }
-        i++;
-    }
-
-    std::sort(bests.begin(), bests.end(), CompareBests());
-
-    if(bests.length() > 0)
-        return bests.first().avg;
-    else
-        return 0;
+    return session->powerCurve().best(seconds);
 }
 
 // VO2 (L/min) = 0.0108 x power (W) + 0.007 x body mass (kg)
 // power = 5 min peak power for a specific ride
-double metric::calculateVO2Max(QList<SessionLine> *session) {       
+double metric::calculateVO2Max(const sessionstore *session) {
     double peak = powerPeak(session, 5*60);
     QSettings settings;
     return ((0.0108 * peak + 0.007 * settings.value(QZSettings::weight, QZSettings::default_weight).toFloat()) /
@@ -390,10 +298,10 @@ Women:
         A is your age in years.
             */
 
-    QSettings settings;
-    QString sex = settings.value(QZSettings::sex, QZSettings::default_sex).toString();
-    double weight = settings.value(QZSettings::weight, QZSettings::default_weight).toFloat();
-    double age = settings.value(QZSettings::age, QZSettings::default_age).toDouble();
+    const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
+    const QString &sex = snapshot.sex;
+    double weight = snapshot.weight;
+    double age = snapshot.age;
     double T = elapsed / 60;
     double H = HR_AVG;
     double W = weight;
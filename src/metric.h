@@ -1,8 +1,10 @@
 #ifndef METRIC_H
 #define METRIC_H
 
+#include "monotonicclock.h"
 #include "qdebugfixup.h"
-#include "sessionline.h"
+#include "rollingwindow.h"
+#include "sessionstore.h"
 #include <QDateTime>
 #include <math.h>
 
@@ -20,24 +22,40 @@ class metric {
     metric();
     void setType(_metric_type t);
     void setValue(double value, bool applyGainAndOffset = true);
-    double value();
-    double valueRaw();
-    QDateTime lastChanged() { return m_lastChanged; }
-    QDateTime valueChanged() { return m_valueChanged; }
-    double average();
-    double average5s();
-    double average20s();
+    double value() const;
+    double valueRaw() const;
+    QDateTime lastChanged() const { return monotonicclock::toDateTime(m_lastChanged); }
+    QDateTime valueChanged() const { return monotonicclock::toDateTime(m_valueChanged); }
+
+    // time elapsed since the last setValue() and since the value actually changed, on the monotonic clock: use these
+    // for the deltas instead of QDateTime::currentDateTime().msecsTo(lastChanged())
+    qint64 msecsSinceLastChanged() const { return (monotonicclock::nsecs() - m_lastChanged) / 1000000; }
+    qint64 msecsSinceValueChanged() const { return (monotonicclock::nsecs() - m_valueChanged) / 1000000; }
+    double average() const;
+    double average5s() const;
+    double average20s() const;
+
+    // average of the last samples (up to 60), as for average5s() and average20s() a sample is usually a second
+    double averageLast(int samples) const { return m_lastValues.average(samples); }
+    double average3s() const { return averageLast(3); }
+    double average10s() const { return averageLast(10); }
+    double average30s() const { return averageLast(30); }
+    double average60s() const { return averageLast(60); }
+
+    // exponential moving average of the samples, the weight of the last sample is 2 / (emaSamples + 1)
+    double ema() const { return m_ema; }
+    void setEmaSamples(int samples);
 
     // rate of the current metric in a second, useful to know how many Kcal i will burn in a
     // minute if i keep the current pace
-    double rate1s() { return m_rateAtSec; }
-
-    double min();
-    double max();
-    double lapValue();
-    double lapAverage();
-    double lapMin();
-    double lapMax();
+    double rate1s() const { return m_rateAtSec; }
+
+    double min() const;
+    double max() const;
+    double lapValue() const;
+    double lapAverage() const;
+    double lapMin() const;
+    double lapMax() const;
     void clearLap(bool accumulator);
     void clear(bool accumulator);
     void operator=(double);
@@ -50,10 +68,10 @@ class metric {
     static double calculateSpeedFromPower(double power, double inclination, double speed, double deltaTimeSeconds,
                                           double speedLimit);
     static double calculateWeightLoss(double kcal);
-    static double calculateVO2Max(QList<SessionLine> *session);
+    static double calculateVO2Max(const sessionstore *session);
     static double calculateKCalfromHR(double HR_AVG, double elapsed);
 
-    static double powerPeak(QList<SessionLine> *session, int seconds);
+    static double powerPeak(const sessionstore *session, int seconds);
     
   private:
     double m_value = 0;
@@ -62,8 +80,9 @@ class metric {
     double m_min = 999999999;
     double m_max = 0;
     double m_offset = 0;
-    QList<double> m_last5;
-    QList<double> m_last20;
+    rollingwindow<60> m_lastValues;
+    double m_ema = 0;
+    double m_emaAlpha = 2.0 / (10.0 + 1.0);
 
     double m_lapOffset = 0;
     double m_lapTotValue = 0;
@@ -71,8 +90,9 @@ class metric {
     double m_lapMin = 999999999;
     double m_lapMax = 0;
 
-    QDateTime m_lastChanged = QDateTime::currentDateTime();
-    QDateTime m_valueChanged = QDateTime::currentDateTime();
+    // monotonicclock::nsecs() timestamps
+    qint64 m_lastChanged = monotonicclock::nsecs();
+    qint64 m_valueChanged = m_lastChanged;
     double m_rateAtSec = 0;
 
     _metric_type m_type = METRIC_OTHER;
@@ -0,0 +1,36 @@
+#include "monotonicclock.h"
+#include <QElapsedTimer>
+#include <atomic>
+
+namespace {
+struct anchor {
+    QElapsedTimer timer;
+    qint64 epochMsecs;
+
+    anchor() : epochMsecs(QDateTime::currentMSecsSinceEpoch()) { timer.start(); }
+};
+
+const anchor &clockAnchor() {
+    static const anchor a;
+    return a;
+}
+
+std::atomic<monotonicclock::source> &currentSource() {
+    static std::atomic<monotonicclock::source> s{nullptr};
+    return s;
+}
+} // namespace
+
+qint64 monotonicclock::nsecs() {
+    source s = currentSource().load(std::memory_order_relaxed);
+    if (s) {
+        return s();
+    }
+    return clockAnchor().timer.nsecsElapsed();
+}
+
+QDateTime monotonicclock::toDateTime(qint64 nsecs) {
+    return QDateTime::fromMSecsSinceEpoch(clockAnchor().epochMsecs + nsecs / 1000000);
+}
+
+void monotonicclock::setSource(source s) { currentSource().store(s, std::memory_order_relaxed); }
@@ -0,0 +1,36 @@
+#ifndef MONOTONICCLOCK_H
+#define MONOTONICCLOCK_H
+
+#include <QDateTime>
+#include <QtGlobal>
+
+/**
+ * @brief Monotonic time source for measuring intervals between samples.
+ *
+ * QDateTime::currentDateTime() follows the wall clock: an NTP sync, a DST change or the user changing the time of the
+ * device makes it jump, and every integration based on it (distance, kcal, rates) jumps with it. Timestamps taken
+ * here are nanoseconds since the first use of the clock and never go backwards; they are converted to a wall-clock
+ * QDateTime only at the edges (UI, logs, export) with toDateTime().
+ *
+ * Tests can replace the source with setSource() to drive time by hand.
+ */
+class monotonicclock {
+  public:
+    typedef qint64 (*source)();
+
+    static qint64 nsecs();
+    static qint64 msecs() { return nsecs() / 1000000; }
+
+    /**
+     * @brief Wall-clock time of a timestamp returned by nsecs(), anchored to the wall clock read when the clock was
+     * first used.
+     */
+    static QDateTime toDateTime(qint64 nsecs);
+
+    /**
+     * @brief Replaces the time source, nullptr restores the default QElapsedTimer based one.
+     */
+    static void setSource(source s);
+};
+
+#endif // MONOTONICCLOCK_H
@@ -0,0 +1,83 @@
+#include "powercurve.h"
+
+#include <algorithm>
+
+const QVector<int> &powercurve::durations() {
+    static const QVector<int> d = {1,   2,   3,   5,   10,  15,   20,   30,   45,   60,   90,  120,
+                                   180, 240, 300, 420, 600, 900, 1200, 1800, 2400, 3600};
+    return d;
+}
+
+powercurve::powercurve() : m_prefix(1, 0.0), m_best(durations().count(), 0.0) {}
+
+void powercurve::append(double watt, uint32_t elapsedSeconds) {
+    if (m_openSamples > 0 && elapsedSeconds > m_openSecond) {
+        closeSecond(m_openSum / m_openSamples);
+        // a device slower than 1 Hz: the sample holds for the seconds since the previous one
+        for (uint32_t s = m_openSecond + 1; s < elapsedSeconds; s++) {
+            closeSecond(watt);
+        }
+        m_openSum = 0;
+        m_openSamples = 0;
+    }
+    if (m_openSamples == 0) {
+        m_openSecond = elapsedSeconds;
+    }
+    // a sample with an older elapsed time (a reset of the device counter) stays in the open second
+    m_openSum += watt;
+    m_openSamples++;
+}
+
+void powercurve::closeSecond(double watt) {
+    const double total = m_prefix.last() + watt;
+    m_prefix.append(total);
+    const int n = m_prefix.count() - 1;
+
+    // is the window ending with this second the new best one of a tracked duration?
+    const double *prefix = m_prefix.constData();
+    const QVector<int> &d = durations();
+    for (int i = 0; i < d.count() && d.at(i) <= n; i++) {
+        const double avg = (total - prefix[n - d.at(i)]) / d.at(i);
+        if (avg > m_best.at(i)) {
+            m_best[i] = avg;
+        }
+    }
+}
+
+void powercurve::clear() {
+    m_prefix.resize(1);
+    m_best.fill(0.0);
+    m_openSecond = 0;
+    m_openSum = 0;
+    m_openSamples = 0;
+}
+
+double powercurve::prefixAt(int i) const {
+    if (i < m_prefix.count()) {
+        return m_prefix.at(i);
+    }
+    return m_prefix.last() + m_openSum / m_openSamples;
+}
+
+double powercurve::best(int seconds) const {
+    const int n = count();
+    if (seconds <= 0 || seconds > n)
+        return 0;
+
+    const QVector<int> &d = durations();
+    auto it = std::lower_bound(d.constBegin(), d.constEnd(), seconds);
+    if (it != d.constEnd() && *it == seconds) {
+        // the stored best covers the closed seconds, the window ending with the open second is checked here
+        double sum = m_best.at(it - d.constBegin()) * seconds;
+        if (m_openSamples > 0) {
+            sum = std::max(sum, prefixAt(n) - prefixAt(n - seconds));
+        }
+        return sum / seconds;
+    }
+
+    double sum = 0;
+    for (int end = seconds; end <= n; end++) {
+        sum = std::max(sum, prefixAt(end) - prefixAt(end - seconds));
+    }
+    return sum / seconds;
+}
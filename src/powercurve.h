@@ -0,0 +1,55 @@
+#ifndef POWERCURVE_H
+#define POWERCURVE_H
+
+#include <QVector>
+#include <cstdint>
+
+/**
+ * @brief Mean-maximal power curve: the best average power over a duration, in seconds of elapsed time.
+ *
+ * The samples are binned by their elapsed second: the samples of a device notifying at 2-4 Hz are averaged into
+ * one value per second, and the seconds skipped by a slower device take the power of the sample that ends the gap.
+ * The bests of a bounded set of durations, from 1 second to 1 hour on a log scale (durations()), are kept up to
+ * date second by second from the prefix sums of the power, so append() costs the same on a 6 hours session as on
+ * a short one and reading one of them with best() is O(1). Any other duration is computed exactly on demand with
+ * a single pass over the prefix sums.
+ */
+class powercurve {
+  public:
+    powercurve();
+
+    void append(double watt, uint32_t elapsedSeconds);
+    void clear();
+
+    /**
+     * @brief The seconds of elapsed time covered by the curve, the second still receiving samples included.
+     */
+    int count() const { return m_prefix.count() - 1 + (m_openSamples > 0 ? 1 : 0); }
+
+    /**
+     * @brief Best average power over the given seconds, 0 if the session is shorter than that.
+     */
+    double best(int seconds) const;
+
+    /**
+     * @brief The durations, in seconds, whose bests are kept up to date on every second.
+     */
+    static const QVector<int> &durations();
+
+  private:
+    void closeSecond(double watt);
+    // the total power of the first i seconds, the open second included
+    double prefixAt(int i) const;
+
+    // m_prefix[i] is the total power of the first i closed seconds
+    QVector<double> m_prefix;
+    // m_best[i] is the best average power over durations().at(i) seconds ending with a closed second
+    QVector<double> m_best;
+
+    // the last elapsed second, still open to the samples of the same second
+    uint32_t m_openSecond = 0;
+    double m_openSum = 0;
+    int m_openSamples = 0;
+};
+
+#endif // POWERCURVE_H
@@ -87,6 +87,7 @@ devices/eliteariafan/eliteariafan.cpp \
 devices/fakerower/fakerower.cpp \
 devices/proformtelnetbike/proformtelnetbike.cpp \
 virtualdevices/virtualdevice.cpp \
+virtualdevices/virtualnotifyscheduler.cpp \
 androidactivityresultreceiver.cpp \
 androidadblog.cpp \
 devices/apexbike/apexbike.cpp \
@@ -99,6 +100,7 @@ devices/wahookickrheadwind/wahookickrheadwind.cpp \
 windows_zwift_workout_paddleocr_thread.cpp \
 devices/ypooelliptical/ypooelliptical.cpp \
 devices/ziprotreadmill/ziprotreadmill.cpp \
+zwift-api/zwift_api_poller.cpp \
 zwift_play/zwiftclickremote.cpp \
 devices/computrainerbike/Computrainer.cpp \
 PathController.cpp \
@@ -144,6 +146,10 @@ devices/bhfitnesselliptical/bhfitnesselliptical.cpp \
 devices/bike.cpp \
 devices/bluetooth.cpp \
 devices/bluetoothdevice.cpp \
+devices/commandcoalescer.cpp \
+devices/ftmsdecoder.cpp \
+devices/reconnectcache.cpp \
+devices/gattwritequeue.cpp \
 characteristics/characteristicnotifier2a37.cpp \
 characteristics/characteristicnotifier2a63.cpp \
 characteristics/characteristicnotifier2ad2.cpp \
@@ -213,6 +219,7 @@ devices/kingsmithr2treadmill/kingsmithr2treadmill.cpp \
 main.cpp \
 devices/mcfbike/mcfbike.cpp \
 metric.cpp \
+monotonicclock.cpp \
 devices/nautiluselliptical/nautiluselliptical.cpp \
 devices/nautilustreadmill/nautilustreadmill.cpp \
 devices/npecablebike/npecablebike.cpp \
@@ -225,11 +232,18 @@ devices/proformelliptical/proformelliptical.cpp \
 devices/proformtreadmill/proformtreadmill.cpp \
 qfit.cpp \
 qzsettings.cpp \
+qzsettingssnapshot.cpp \
 devices/renphobike/renphobike.cpp \
 devices/rower.cpp \
 devices/schwinnic4bike/schwinnic4bike.cpp \
+powercurve.cpp \
 screencapture.cpp \
 sessionline.cpp \
+sessionjournal.cpp \
+logwriter.cpp \
+qzlog.cpp \
+latencyhistogram.cpp \
+sessionstore.cpp \
 devices/shuaa5treadmill/shuaa5treadmill.cpp \
 signalhandler.cpp \
 simplecrypt.cpp \
@@ -271,6 +285,7 @@ devices/ultrasportbike/ultrasportbike.cpp \
 virtualdevices/virtualrower.cpp \
 devices/wahookickrsnapbike/wahookickrsnapbike.cpp \
 devices/yesoulbike/yesoulbike.cpp \
+trainingload.cpp \
 trainprogram.cpp \
 devices/trxappgateusbtreadmill/trxappgateusbtreadmill.cpp \
 virtualdevices/virtualbike.cpp \
@@ -312,6 +327,7 @@ devices/proformtelnetbike/proformtelnetbike.h \
 windows_zwift_workout_paddleocr_thread.h \
 devices/fakerower/fakerower.h \
 zwift-api/PlayerStateWrapper.h \
+zwift-api/zwift_api_poller.h \
 zwift-api/zwift_client_auth.h \
 zwift_play/abstractZapDevice.h \
 zwift_play/zapBleUuids.h \
@@ -319,6 +335,7 @@ zwift_play/zapConstants.h \
 zwift_play/zwiftPlayDevice.h \
 zwift_play/zwiftclickremote.h \
 virtualdevices/virtualdevice.h \
+virtualdevices/virtualnotifyscheduler.h \
 androidactivityresultreceiver.h \
 androidadblog.h \
 devices/apexbike/apexbike.h \
@@ -387,6 +404,10 @@ devices/bhfitnesselliptical/bhfitnesselliptical.h \
 devices/bike.h \
 devices/bluetooth.h \
 devices/bluetoothdevice.h \
+devices/commandcoalescer.h \
+devices/ftmsdecoder.h \
+devices/reconnectcache.h \
+devices/gattwritequeue.h \
 characteristics/characteristicnotifier.h \
 characteristics/characteristicnotifier2a37.h \
 characteristics/characteristicnotifier2a63.h \
@@ -654,6 +675,7 @@ ios/M3iIOS-Interface.h \
 material.h \
 devices/mcfbike/mcfbike.h \
 metric.h \
+monotonicclock.h \
 devices/nautiluselliptical/nautiluselliptical.h \
 devices/nautilustreadmill/nautilustreadmill.h \
 devices/npecablebike/npecablebike.h \
@@ -668,11 +690,20 @@ qdebugfixup.h \
 qfit.h \
 qmdnsengine_export.h \
 qzsettings.h \
+qzsettingssnapshot.h \
 devices/renphobike/renphobike.h \
 devices/rower.h \
 devices/schwinnic4bike/schwinnic4bike.h \
+powercurve.h \
 screencapture.h \
+fenwicktree.h \
+rollingwindow.h \
 sessionline.h \
+sessionjournal.h \
+logwriter.h \
+qzlog.h \
+latencyhistogram.h \
+sessionstore.h \
 devices/shuaa5treadmill/shuaa5treadmill.h \
 signalhandler.h \
 simplecrypt.h \
@@ -712,6 +743,7 @@ devices/toorxtreadmill/toorxtreadmill.h \
 gpx.h \
 devices/treadmill.h \
 mainwindow.h \
+trainingload.h \
 trainprogram.h \
 devices/truetreadmill/truetreadmill.h \
 devices/trxappgateusbbike/trxappgateusbbike.h \
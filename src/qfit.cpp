@@ -6,6 +6,7 @@
 
 #include "QSettings"
 
+#include "fit_crc.hpp"
 #include "fit_date_time.hpp"
 #include "fit_encode.hpp"
 
@@ -17,103 +18,325 @@ using namespace std;
 
 qfit::qfit(QObject *parent) : QObject(parent) {}
 
-void qfit::save(const QString &filename, QList<SessionLine> session, bluetoothdevice::BLUETOOTH_TYPE type,
+void qfit::save(const QString &filename, const sessionstore &session, bluetoothdevice::BLUETOOTH_TYPE type,
                 uint32_t processFlag, FIT_SPORT overrideSport, QString workoutName, QString bluetooth_device_name) {
-    QSettings settings;
-    bool strava_virtual_activity =
-        settings.value(QZSettings::strava_virtual_activity, QZSettings::default_strava_virtual_activity).toBool();
-    bool powr_sensor_running_cadence_half_on_strava =
-        settings
-            .value(QZSettings::powr_sensor_running_cadence_half_on_strava,
-                   QZSettings::default_powr_sensor_running_cadence_half_on_strava)
-            .toBool();
-    std::list<fit::RecordMesg> records;
-    fit::Encode encode(fit::ProtocolVersion::V20);
     if (session.isEmpty()) {
         return;
     }
-    std::fstream file;
-    uint32_t firstRealIndex = 0;
-    for (int i = 0; i < session.length(); i++) {
-        if ((session.at(i).speed > 0 && (type == bluetoothdevice::TREADMILL || type == bluetoothdevice::ELLIPTICAL)) ||
-            (session.at(i).cadence > 0 && (type == bluetoothdevice::BIKE || type == bluetoothdevice::ROWING))) {
-            firstRealIndex = i;
-            break;
+
+    // the whole session is known here: start from the first real line and tell the writer if there is a gps track
+    qfitwriter writer(type, processFlag, overrideSport);
+    int firstRealIndex = qfitwriter::firstRealIndex(session, type);
+    writer.start(session, firstRealIndex, qfitwriter::hasGpsData(session, firstRealIndex));
+    writer.save(filename, session, overrideSport, workoutName, bluetooth_device_name);
+}
+
+namespace {
+bool isRealLine(const sessionstore &session, int i, bluetoothdevice::BLUETOOTH_TYPE type) {
+    return (session.speed().at(i) > 0 && (type == bluetoothdevice::TREADMILL || type == bluetoothdevice::ELLIPTICAL)) ||
+           (session.cadence().at(i) > 0 && (type == bluetoothdevice::BIKE || type == bluetoothdevice::ROWING));
+}
+
+std::string encodedMessages(const std::stringstream &stream, std::streamoff from) {
+    return stream.str().substr(from);
+}
+} // namespace
+
+qfitwriter::qfitwriter(bluetoothdevice::BLUETOOTH_TYPE type, uint32_t processFlag, FIT_SPORT overrideSport)
+    : m_type(type), m_processFlag(processFlag), m_overrideSport(overrideSport),
+      m_body(std::ios::in | std::ios::out | std::ios::binary), m_encode(fit::ProtocolVersion::V20) {
+    QSettings settings;
+    m_cadenceHalf = settings
+                        .value(QZSettings::powr_sensor_running_cadence_half_on_strava,
+                               QZSettings::default_powr_sensor_running_cadence_half_on_strava)
+                        .toBool();
+    // the header written here is a placeholder, save() writes the real one
+    m_encode.Open(m_body);
+}
+
+int qfitwriter::firstRealIndex(const sessionstore &session, bluetoothdevice::BLUETOOTH_TYPE type) {
+    for (int i = 0; i < session.count(); i++) {
+        if (isRealLine(session, i, type)) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+bool qfitwriter::hasGpsData(const sessionstore &session, int from) {
+    for (int i = from; i < session.count(); i++) {
+        if (session.coordinateIsValid(i)) {
+            return true;
         }
     }
-    double startingDistanceOffset = 0.0;
-    if (!session.isEmpty()) {
-        startingDistanceOffset = session.at(firstRealIndex).distance;
+    return false;
+}
+
+FIT_SPORT qfitwriter::lapSport(FIT_SPORT overrideSport) const {
+    if (overrideSport != FIT_SPORT_INVALID) {
+        return FIT_SPORT_GENERIC;
+    } else if (m_type == bluetoothdevice::TREADMILL || m_type == bluetoothdevice::ELLIPTICAL) {
+        return FIT_SPORT_RUNNING;
+    } else if (m_type == bluetoothdevice::ROWING) {
+        return FIT_SPORT_ROWING;
+    } else if (m_type == bluetoothdevice::JUMPROPE) {
+        return FIT_SPORT_JUMPROPE;
     }
+    return FIT_SPORT_CYCLING;
+}
 
-    file.open(filename.toStdString(), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+void qfitwriter::write(fit::Encode &encode, fit::MesgDefinition &lastDefinition, const fit::Mesg &mesg) {
+    // the same rule of fit::Encode, so the tail of the file can be encoded as if it followed the body
+    fit::MesgDefinition definition(mesg);
+    if (!lastDefinition.Supports(definition)) {
+        lastDefinition = definition;
+    }
+    encode.Write(mesg);
+}
 
-    if (!file.is_open()) {
+void qfitwriter::start(const sessionstore &session, int index, bool gpsData) {
+    m_started = true;
+    m_firstRealIndex = index;
+    m_next = index;
+    m_scan = session.count();
+    m_gpsData = gpsData;
+    m_timeBase = session.timeMSecsSinceEpoch(0);
+    m_startingDistanceOffset = session.distance().at(index);
+    m_date = fit::DateTime((time_t)session.time(0).toSecsSinceEpoch()).GetTimeStamp();
+
+    fit::LapMesg &lapMesg = m_lap.mesg;
+    lapMesg.SetIntensity(FIT_INTENSITY_ACTIVE);
+    lapMesg.SetStartTime(m_date + index);
+    lapMesg.SetTimestamp(m_date + index);
+    lapMesg.SetEvent(FIT_EVENT_WORKOUT);
+    lapMesg.SetSubSport(FIT_SUB_SPORT_GENERIC);
+    lapMesg.SetEventType(FIT_EVENT_TYPE_STOP);
+    lapMesg.SetTotalElapsedTime(0);
+    lapMesg.SetTotalTimerTime(0);
+    lapMesg.SetSport(lapSport(m_overrideSport));
+    m_lap.lastLapOdometer = m_startingDistanceOffset;
+}
 
-        printf("Error opening file ExampleActivity.fit\n");
+void qfitwriter::update(const sessionstore &session) {
+    if (m_stale) {
+        return;
+    }
+    if (session.isEmpty()) {
+        m_stale = m_scan > 0;
+        return;
+    }
+    if (m_scan == 0) {
+        m_timeBase = session.timeMSecsSinceEpoch(0);
+    } else if (session.count() < m_scan || session.timeMSecsSinceEpoch(0) != m_timeBase) {
+        // cleared or replaced
+        m_stale = true;
         return;
     }
 
-    QFile output(filename);
-    output.open(QIODevice::WriteOnly);
-
-    fit::FileIdMesg fileIdMesg; // Every FIT file requires a File ID message
-    fileIdMesg.SetType(FIT_FILE_ACTIVITY);
-    if(bluetooth_device_name.toUpper().startsWith("DOMYOS"))
-        fileIdMesg.SetManufacturer(FIT_MANUFACTURER_DECATHLON);
-    else
-        fileIdMesg.SetManufacturer(FIT_MANUFACTURER_DEVELOPMENT);
-    fileIdMesg.SetProduct(1);
-    fileIdMesg.SetSerialNumber(12345);
-    fileIdMesg.SetTimeCreated(session.at(firstRealIndex).time.toSecsSinceEpoch() - 631065600L);
-
-    bool gps_data = false;
-    double max_alt = 0;
-    double min_alt = 99999;
-    double speed_acc = 0;
-    int speed_count = 0;
-    int lap_index = 0;
-    double speed_avg = 0;
-    for (int i = firstRealIndex; i < session.length(); i++) {
-        if (session.at(i).coordinate.isValid()) {
-            gps_data = true;
-            break;
+    if (!m_started) {
+        for (; m_scan < session.count(); m_scan++) {
+            if (isRealLine(session, m_scan, m_type)) {
+                start(session, m_scan, false);
+                break;
+            }
+        }
+        if (!m_started) {
+            return;
         }
     }
-    for (int i = firstRealIndex; i < session.length(); i++) {
-        if (gps_data) {
-            if (session.at(i).coordinate.isValid()) {
-                if (min_alt > session.at(i).coordinate.altitude())
-                    min_alt = session.at(i).coordinate.altitude();
-                if (max_alt < session.at(i).coordinate.altitude())
-                    max_alt = session.at(i).coordinate.altitude();
+
+    m_scan = session.count();
+    process(session, session.count());
+}
+
+void qfitwriter::process(const sessionstore &session, int end) {
+    for (int i = m_next; i < end; i++) {
+        QGeoCoordinate coordinate = session.coordinate(i);
+        if (coordinate.isValid()) {
+            if (m_minAltitude > coordinate.altitude())
+                m_minAltitude = coordinate.altitude();
+            if (m_maxAltitude < coordinate.altitude())
+                m_maxAltitude = coordinate.altitude();
+
+            // with a gps track the lines without a coordinate are skipped, the ones already encoded shouldn't be there
+            if (!m_gpsData) {
+                m_gpsData = true;
+                if (m_records > 0) {
+                    qDebug() << QStringLiteral("qfitwriter: gps track started after") << m_records
+                             << QStringLiteral("records");
+                    m_stale = true;
+                }
             }
-        } else {
-            min_alt = 0;
-            if (max_alt < session.at(i).elevationGain)
-                max_alt = session.at(i).elevationGain;
         }
+        if (m_maxElevationGain < session.elevationGain().at(i))
+            m_maxElevationGain = session.elevationGain().at(i);
 
-        if (session.at(i).speed > 0) {
-            speed_count++;
-            speed_acc += session.at(i).speed;
+        if (session.speed().at(i) > 0) {
+            m_speedCount++;
+            m_speedAcc += session.speed().at(i);
+        }
+
+        if (m_processFlag & QFIT_PROCESS_DISTANCENOISE) {
+            double d = session.distance().at(i);
+            if (d != m_runDistance) {
+                if (m_runStart >= 0) {
+                    m_records += flushRun(session, i, m_encode, m_lastDefinition, m_lap, nullptr);
+                }
+                m_runDistance = d;
+                m_runStart = i;
+            }
+        } else if (writeRecord(session, i, session.distance().at(i), m_encode, m_lastDefinition, m_lap)) {
+            m_records++;
         }
     }
+    m_next = end;
+}
+
+int qfitwriter::flushRun(const sessionstore &session, int end, fit::Encode &encode,
+                         fit::MesgDefinition &lastDefinition, lapstate &lap, double *lastDistance) const {
+    // the distance is spread over the lines of the run, as a device with a finer resolution would report it
+    int written = 0;
+    for (int j = m_runStart; j < end; j++) {
+        double distance = session.distance().at(j) + 0.1 * (j - m_runStart) / (end - m_runStart);
+        if (writeRecord(session, j, distance, encode, lastDefinition, lap)) {
+            written++;
+        }
+        if (lastDistance) {
+            *lastDistance = distance;
+        }
+    }
+    return written;
+}
+
+bool qfitwriter::writeRecord(const sessionstore &session, int i, double distance, fit::Encode &encode,
+                             fit::MesgDefinition &lastDefinition, lapstate &lap) const {
+    fit::RecordMesg newRecord;
+    newRecord.SetHeartRate(session.heart().at(i));
+    uint8_t cad = session.cadence().at(i);
+    if (m_cadenceHalf)
+        cad = cad / 2;
+    newRecord.SetCadence(cad);
+    newRecord.SetDistance((distance - m_startingDistanceOffset) * 1000.0); // meters
+    newRecord.SetSpeed(session.speed().at(i) / 3.6);                       // meter per second
+    newRecord.SetPower(session.watt().at(i));
+    newRecord.SetResistance(session.resistance().at(i));
+    newRecord.SetCalories(session.calories().at(i));
+    if (m_type == bluetoothdevice::TREADMILL) {
+        newRecord.SetStepLength(session.instantaneousStrideLengthCM().at(i) * 10);
+        newRecord.SetVerticalOscillation(session.verticalOscillationMM().at(i));
+        newRecord.SetStanceTime(session.groundContactMS().at(i));
+    }
 
-    if (speed_count > 0) {
-        speed_avg = speed_acc / ((double)speed_count);
+    // if a gps track contains a point without the gps information, it has to be discarded, otherwise the database
+    // structure is corrupted and 2 tracks are saved in the FIT file causing mapping issue.
+    QGeoCoordinate coordinate = session.coordinate(i);
+    if (!coordinate.isValid() && m_gpsData) {
+        return false;
+    }
+
+    if (coordinate.isValid()) {
+        newRecord.SetAltitude(coordinate.altitude());
+        newRecord.SetPositionLat(pow(2, 31) * (coordinate.latitude()) / 180.0);
+        newRecord.SetPositionLong(pow(2, 31) * (coordinate.longitude()) / 180.0);
+    } else {
+        newRecord.SetAltitude(session.elevationGain().at(i));
+    }
+
+    // using just the start point as reference in order to avoid pause time
+    // strava ignore the elapsed field
+    // this workaround could leads an accuracy issue.
+    newRecord.SetTimestamp(m_date + i);
+    write(encode, lastDefinition, newRecord);
+
+    if (session.lapTrigger().at(i)) {
+        uint32_t elapsed = session.elapsedTime().at(i);
+        fit::LapMesg &lapMesg = lap.mesg;
+        lapMesg.SetTotalDistance((distance - lap.lastLapOdometer) * 1000.0); // meters
+        lapMesg.SetTotalElapsedTime(elapsed - lap.lastLapTimer);
+        lapMesg.SetTotalTimerTime(elapsed - lap.lastLapTimer);
+        lapMesg.SetEvent(FIT_EVENT_LAP);
+        lapMesg.SetEventType(FIT_EVENT_TYPE_STOP);
+        lapMesg.SetMessageIndex(lap.lapIndex++);
+        lapMesg.SetLapTrigger(FIT_LAP_TRIGGER_DISTANCE);
+        if (m_type == bluetoothdevice::JUMPROPE)
+            lapMesg.SetRepetitionNum(session.inclination().at(i - 1));
+        lap.lastLapTimer = elapsed;
+        lap.lastLapOdometer = distance;
+
+        write(encode, lastDefinition, lapMesg);
+
+        lapMesg.SetStartTime(m_date + i);
+        lapMesg.SetTimestamp(m_date + i);
+        lapMesg.SetEvent(FIT_EVENT_WORKOUT);
+        lapMesg.SetEventType(FIT_EVENT_LAP);
+    }
+    return true;
+}
+
+bool qfitwriter::save(const QString &filename, const sessionstore &session, FIT_SPORT overrideSport,
+                      QString workoutName, QString bluetooth_device_name) {
+    if (session.isEmpty()) {
+        return true;
+    }
+    update(session);
+    if (m_stale || !m_started) {
+        return false;
+    }
+    // the laps already encoded carry the sport, it can't change anymore
+    if (m_lap.lapIndex > 0 && lapSport(overrideSport) != lapSport(m_overrideSport)) {
+        qDebug() << QStringLiteral("qfitwriter: the lap sport changed after the first lap");
+        return false;
+    }
+
+    QSettings settings;
+    bool strava_virtual_activity =
+        settings.value(QZSettings::strava_virtual_activity, QZSettings::default_strava_virtual_activity).toBool();
+
+    // the tail of the file goes on from the last definition of the body, without touching the writer
+    std::stringstream tailStream(std::ios::in | std::ios::out | std::ios::binary);
+    fit::Encode tail(fit::ProtocolVersion::V20);
+    tail.Open(tailStream);
+    fit::MesgDefinition tailDefinition = m_lastDefinition;
+    if (tailDefinition.GetNum() != FIT_MESG_NUM_INVALID) {
+        tail.Write(tailDefinition);
+    }
+    std::streamoff tailStart = tailStream.tellp();
+
+    lapstate lap = m_lap;
+    lap.mesg.SetSport(lapSport(overrideSport));
+    double lastDistance = session.distance().last();
+    if ((m_processFlag & QFIT_PROCESS_DISTANCENOISE) && m_runStart >= 0) {
+        flushRun(session, session.count(), tail, tailDefinition, lap, &lastDistance);
+    }
+
+    const int firstRealIndex = m_firstRealIndex;
+    double min_alt = m_gpsData ? m_minAltitude : 0;
+    double max_alt = m_gpsData ? m_maxAltitude : m_maxElevationGain;
+    double speed_avg = 0;
+    if (m_speedCount > 0) {
+        speed_avg = m_speedAcc / ((double)m_speedCount);
         qDebug() << "average speed from the fit file" << speed_avg;
     }
 
+    fit::FileIdMesg fileIdMesg; // Every FIT file requires a File ID message
+    fileIdMesg.SetType(FIT_FILE_ACTIVITY);
+    if(bluetooth_device_name.toUpper().startsWith("DOMYOS"))
+        fileIdMesg.SetManufacturer(FIT_MANUFACTURER_DECATHLON);
+    else
+        fileIdMesg.SetManufacturer(FIT_MANUFACTURER_DEVELOPMENT);
+    fileIdMesg.SetProduct(1);
+    fileIdMesg.SetSerialNumber(12345);
+    fileIdMesg.SetTimeCreated(session.time(firstRealIndex).toSecsSinceEpoch() - 631065600L);
+
     fit::SessionMesg sessionMesg;
-    sessionMesg.SetTimestamp(session.at(firstRealIndex).time.toSecsSinceEpoch() - 631065600L);
-    sessionMesg.SetStartTime(session.at(firstRealIndex).time.toSecsSinceEpoch() - 631065600L);
-    sessionMesg.SetTotalElapsedTime(session.last().elapsedTime);
-    sessionMesg.SetTotalTimerTime(session.last().time.toSecsSinceEpoch() -
-                                  session.at(firstRealIndex).time.toSecsSinceEpoch());
-    sessionMesg.SetTotalDistance((session.last().distance - startingDistanceOffset) * 1000.0); // meters
-    sessionMesg.SetTotalCalories(session.last().calories);
-    sessionMesg.SetTotalMovingTime(session.last().elapsedTime);
+    sessionMesg.SetTimestamp(session.time(firstRealIndex).toSecsSinceEpoch() - 631065600L);
+    sessionMesg.SetStartTime(session.time(firstRealIndex).toSecsSinceEpoch() - 631065600L);
+    sessionMesg.SetTotalElapsedTime(session.elapsedTime().last());
+    sessionMesg.SetTotalTimerTime(session.time(session.count() - 1).toSecsSinceEpoch() -
+                                  session.time(firstRealIndex).toSecsSinceEpoch());
+    sessionMesg.SetTotalDistance((session.distance().last() - m_startingDistanceOffset) * 1000.0); // meters
+    sessionMesg.SetTotalCalories(session.calories().last());
+    sessionMesg.SetTotalMovingTime(session.elapsedTime().last());
     sessionMesg.SetMinAltitude(min_alt);
     sessionMesg.SetMaxAltitude(max_alt);
     sessionMesg.SetEvent(FIT_EVENT_SESSION);
@@ -126,9 +349,9 @@ void qfit::save(const QString &filename, QList<SessionLine> session, bluetoothde
         sessionMesg.SetSport(overrideSport);
         sessionMesg.SetSubSport(FIT_SUB_SPORT_GENERIC);
         qDebug() << "overriding FIT sport " << overrideSport;
-    } else if (type == bluetoothdevice::TREADMILL) {
-        if(session.last().stepCount > 0)
-            sessionMesg.SetTotalStrides(session.last().stepCount);
+    } else if (m_type == bluetoothdevice::TREADMILL) {
+        if(session.stepCount().last() > 0)
+            sessionMesg.SetTotalStrides(session.stepCount().last());
 
         if (speed_avg == 0 || speed_avg > 6.5)
             sessionMesg.SetSport(FIT_SPORT_RUNNING);
@@ -140,7 +363,7 @@ void qfit::save(const QString &filename, QList<SessionLine> session, bluetoothde
         } else {
             sessionMesg.SetSubSport(FIT_SUB_SPORT_TREADMILL);
         }
-    } else if (type == bluetoothdevice::ELLIPTICAL) {
+    } else if (m_type == bluetoothdevice::ELLIPTICAL) {
 
         if (speed_avg == 0 || speed_avg > 6.5)
             sessionMesg.SetSport(FIT_SPORT_RUNNING);
@@ -152,24 +375,24 @@ void qfit::save(const QString &filename, QList<SessionLine> session, bluetoothde
         } else {
             sessionMesg.SetSubSport(FIT_SUB_SPORT_ELLIPTICAL);
         }
-    } else if (type == bluetoothdevice::ROWING) {
+    } else if (m_type == bluetoothdevice::ROWING) {
 
         sessionMesg.SetSport(FIT_SPORT_ROWING);
         sessionMesg.SetSubSport(FIT_SUB_SPORT_INDOOR_ROWING);
-        if (session.last().totalStrokes)
-            sessionMesg.SetTotalStrokes(session.last().totalStrokes);
-        if (session.last().avgStrokesRate)
-            sessionMesg.SetAvgStrokeCount(session.last().avgStrokesRate);
-        if (session.last().maxStrokesRate)
-            sessionMesg.SetMaxCadence(session.last().maxStrokesRate);
-        if (session.last().avgStrokesLength)
-            sessionMesg.SetAvgStrokeDistance(session.last().avgStrokesLength);
-    } else if (type == bluetoothdevice::JUMPROPE) {
+        if (session.totalStrokes().last())
+            sessionMesg.SetTotalStrokes(session.totalStrokes().last());
+        if (session.avgStrokesRate().last())
+            sessionMesg.SetAvgStrokeCount(session.avgStrokesRate().last());
+        if (session.maxStrokesRate().last())
+            sessionMesg.SetMaxCadence(session.maxStrokesRate().last());
+        if (session.avgStrokesLength().last())
+            sessionMesg.SetAvgStrokeDistance(session.avgStrokesLength().last());
+    } else if (m_type == bluetoothdevice::JUMPROPE) {
 
         sessionMesg.SetSport(FIT_SPORT_JUMPROPE);
         sessionMesg.SetSubSport(FIT_SUB_SPORT_GENERIC);
-        if (session.last().stepCount)
-            sessionMesg.SetJumpCount(session.last().stepCount);
+        if (session.stepCount().last())
+            sessionMesg.SetJumpCount(session.stepCount().last());
     } else {
 
         sessionMesg.SetSport(FIT_SPORT_CYCLING);
@@ -186,13 +409,13 @@ void qfit::save(const QString &filename, QList<SessionLine> session, bluetoothde
     devIdMesg.SetDeveloperDataIndex(0);
 
     fit::ActivityMesg activityMesg;
-    activityMesg.SetTimestamp(session.at(firstRealIndex).time.toSecsSinceEpoch() - 631065600L);
-    activityMesg.SetTotalTimerTime(session.last().elapsedTime);
+    activityMesg.SetTimestamp(session.time(firstRealIndex).toSecsSinceEpoch() - 631065600L);
+    activityMesg.SetTotalTimerTime(session.elapsedTime().last());
     activityMesg.SetNumSessions(1);
     activityMesg.SetType(FIT_ACTIVITY_MANUAL);
     activityMesg.SetEvent(FIT_EVENT_WORKOUT);
     activityMesg.SetEventType(FIT_EVENT_TYPE_START);
-    activityMesg.SetLocalTimestamp(fit::DateTime((time_t)session.last().time.toSecsSinceEpoch())
+    activityMesg.SetLocalTimestamp(fit::DateTime((time_t)session.time(session.count() - 1).toSecsSinceEpoch())
                                        .GetTimeStamp()); // seconds since 00:00 Dec d31 1989 in local time zone
     activityMesg.SetEvent(FIT_EVENT_ACTIVITY);
     activityMesg.SetEventType(FIT_EVENT_TYPE_STOP);
@@ -202,25 +425,29 @@ void qfit::save(const QString &filename, QList<SessionLine> session, bluetoothde
     eventMesg.SetEventType(FIT_EVENT_TYPE_START);
     eventMesg.SetData(0);
     eventMesg.SetEventGroup(0);
-    eventMesg.SetTimestamp(session.at(firstRealIndex).time.toSecsSinceEpoch() - 631065600L);
+    eventMesg.SetTimestamp(session.time(firstRealIndex).toSecsSinceEpoch() - 631065600L);
 
-    encode.Open(file);
-    encode.Write(fileIdMesg);
-    encode.Write(devIdMesg);
+    // the messages before the records. The last one is an event, so the body starts with the record definition
+    // whatever is written here
+    std::stringstream headStream(std::ios::in | std::ios::out | std::ios::binary);
+    fit::Encode head(fit::ProtocolVersion::V20);
+    head.Open(headStream);
+    head.Write(fileIdMesg);
+    head.Write(devIdMesg);
 
     if (workoutName.length() > 0) {
         fit::TrainingFileMesg trainingFile;
         trainingFile.SetTimestamp(sessionMesg.GetTimestamp());
         trainingFile.SetTimeCreated(sessionMesg.GetTimestamp());
         trainingFile.SetType(FIT_FILE_WORKOUT);
-        encode.Write(trainingFile);
+        head.Write(trainingFile);
 
         fit::WorkoutMesg workout;
         workout.SetSport(sessionMesg.GetSport());
         workout.SetSubSport(sessionMesg.GetSubSport());
         workout.SetWktName(workoutName.toStdWString());
         workout.SetNumValidSteps(1);
-        encode.Write(workout);
+        head.Write(workout);
 
         fit::WorkoutStepMesg workoutStep;
         workoutStep.SetDurationTime(sessionMesg.GetTotalTimerTime());
@@ -231,150 +458,53 @@ void qfit::save(const QString &filename, QList<SessionLine> session, bluetoothde
         workoutStep.SetDurationType(FIT_WKT_STEP_DURATION_TIME);
         workoutStep.SetTargetType(FIT_WKT_STEP_TARGET_SPEED);
         workoutStep.SetIntensity(FIT_INTENSITY_INTERVAL);
-        encode.Write(workoutStep);
-    }
-
-    encode.Write(eventMesg);
-
-    fit::DateTime date((time_t)session.first().time.toSecsSinceEpoch());
-
-    fit::LapMesg lapMesg;
-    lapMesg.SetIntensity(FIT_INTENSITY_ACTIVE);
-    lapMesg.SetStartTime(date.GetTimeStamp() + firstRealIndex);
-    lapMesg.SetTimestamp(date.GetTimeStamp() + firstRealIndex);
-    lapMesg.SetEvent(FIT_EVENT_WORKOUT);
-    lapMesg.SetSubSport(FIT_SUB_SPORT_GENERIC);
-    lapMesg.SetEventType(FIT_EVENT_TYPE_STOP);
-    lapMesg.SetTotalElapsedTime(0);
-    lapMesg.SetTotalTimerTime(0);
-    if (overrideSport != FIT_SPORT_INVALID) {
-
-        lapMesg.SetSport(FIT_SPORT_GENERIC);
-    } else if (type == bluetoothdevice::TREADMILL) {
-
-        lapMesg.SetSport(FIT_SPORT_RUNNING);
-    } else if (type == bluetoothdevice::ELLIPTICAL) {
-
-        lapMesg.SetSport(FIT_SPORT_RUNNING);
-    } else if (type == bluetoothdevice::ROWING) {
-
-        lapMesg.SetSport(FIT_SPORT_ROWING);
-    } else if (type == bluetoothdevice::JUMPROPE) {
-
-        lapMesg.SetSport(FIT_SPORT_JUMPROPE);
-    } else {
-
-        lapMesg.SetSport(FIT_SPORT_CYCLING);
+        head.Write(workoutStep);
     }
 
-    SessionLine sl;
-    if (processFlag & QFIT_PROCESS_DISTANCENOISE) {
-        double distanceOld = -1.0;
-        int startIdx = -1;
-        for (int i = firstRealIndex; i < session.length(); i++) {
+    head.Write(eventMesg);
 
-            sl = session.at(i);
-            if (sl.distance != distanceOld || i == session.length() - 1) {
-                if (i == session.length() - 1 && sl.distance == distanceOld) {
-                    i++;
-                }
-                if (startIdx >= 0) {
-                    for (int j = startIdx; j < i; j++) {
-                        session[j].distance += 0.1 * (j - startIdx) / (i - startIdx);
-                    }
-                }
-                distanceOld = sl.distance;
-                startIdx = i;
-            }
-        }
-    }
-
-    uint32_t lastLapTimer = 0;
-    double lastLapOdometer = startingDistanceOffset;
-    for (int i = firstRealIndex; i < session.length(); i++) {
-
-        fit::RecordMesg newRecord;
-        sl = session.at(i);
-        // fit::DateTime date((time_t)session.at(i).time.toSecsSinceEpoch());
-        newRecord.SetHeartRate(sl.heart);
-        uint8_t cad = sl.cadence;
-        if (powr_sensor_running_cadence_half_on_strava)
-            cad = cad / 2;
-        newRecord.SetCadence(cad);
-        newRecord.SetDistance((sl.distance - startingDistanceOffset) * 1000.0); // meters
-        newRecord.SetSpeed(sl.speed / 3.6);                                     // meter per second
-        newRecord.SetPower(sl.watt);
-        newRecord.SetResistance(sl.resistance);
-        newRecord.SetCalories(sl.calories);
-        if (type == bluetoothdevice::TREADMILL) {
-            newRecord.SetStepLength(sl.instantaneousStrideLengthCM * 10);
-            newRecord.SetVerticalOscillation(sl.verticalOscillationMM);
-            newRecord.SetStanceTime(sl.groundContactMS);
-        }
-
-        // if a gps track contains a point without the gps information, it has to be discarded, otherwise the database
-        // structure is corrupted and 2 tracks are saved in the FIT file causing mapping issue.
-        if (!sl.coordinate.isValid() && gps_data) {
-            continue;
-        }
-
-        if (sl.coordinate.isValid()) {
-            newRecord.SetAltitude(sl.coordinate.altitude());
-            newRecord.SetPositionLat(pow(2, 31) * (sl.coordinate.latitude()) / 180.0);
-            newRecord.SetPositionLong(pow(2, 31) * (sl.coordinate.longitude()) / 180.0);
-        } else {
-            newRecord.SetAltitude(sl.elevationGain);
-        }
-
-        // using just the start point as reference in order to avoid pause time
-        // strava ignore the elapsed field
-        // this workaround could leads an accuracy issue.
-        newRecord.SetTimestamp(date.GetTimeStamp() + i);
-        encode.Write(newRecord);
-
-        if (sl.lapTrigger) {
-
-            lapMesg.SetTotalDistance((sl.distance - lastLapOdometer) * 1000.0); // meters
-            lapMesg.SetTotalElapsedTime(sl.elapsedTime - lastLapTimer);
-            lapMesg.SetTotalTimerTime(sl.elapsedTime - lastLapTimer);
-            lapMesg.SetEvent(FIT_EVENT_LAP);
-            lapMesg.SetEventType(FIT_EVENT_TYPE_STOP);
-            lapMesg.SetMessageIndex(lap_index++);
-            lapMesg.SetLapTrigger(FIT_LAP_TRIGGER_DISTANCE);
-            if (type == bluetoothdevice::JUMPROPE)
-                lapMesg.SetRepetitionNum(session.at(i - 1).inclination);
-            lastLapTimer = sl.elapsedTime;
-            lastLapOdometer = sl.distance;
-
-            encode.Write(lapMesg);
-
-            lapMesg.SetStartTime(date.GetTimeStamp() + i);
-            lapMesg.SetTimestamp(date.GetTimeStamp() + i);
-            lapMesg.SetEvent(FIT_EVENT_WORKOUT);
-            lapMesg.SetEventType(FIT_EVENT_LAP);
-        }
-    }
-
-    lapMesg.SetTotalDistance((session.last().distance - lastLapOdometer) * 1000.0); // meters
-    lapMesg.SetTotalElapsedTime(session.last().elapsedTime - lastLapTimer);
-    lapMesg.SetTotalTimerTime(session.last().elapsedTime - lastLapTimer);
+    fit::LapMesg &lapMesg = lap.mesg;
+    lapMesg.SetTotalDistance((lastDistance - lap.lastLapOdometer) * 1000.0); // meters
+    lapMesg.SetTotalElapsedTime(session.elapsedTime().last() - lap.lastLapTimer);
+    lapMesg.SetTotalTimerTime(session.elapsedTime().last() - lap.lastLapTimer);
     lapMesg.SetEvent(FIT_EVENT_LAP);
     lapMesg.SetEventType(FIT_EVENT_TYPE_STOP);
     lapMesg.SetLapTrigger(FIT_LAP_TRIGGER_SESSION_END);
-    lapMesg.SetMessageIndex(lap_index++);
-    encode.Write(lapMesg);
-    encode.Write(sessionMesg);
-    encode.Write(activityMesg);
-
-    if (!encode.Close()) {
-
-        printf("Error closing encode.\n");
-        return;
+    lapMesg.SetMessageIndex(lap.lapIndex++);
+    write(tail, tailDefinition, lapMesg);
+    write(tail, tailDefinition, sessionMesg);
+    write(tail, tailDefinition, activityMesg);
+
+    std::string data = encodedMessages(headStream, FIT_FILE_HDR_SIZE);
+    data += encodedMessages(m_body, FIT_FILE_HDR_SIZE);
+    data += encodedMessages(tailStream, tailStart);
+
+    FIT_FILE_HDR header;
+    header.header_size = FIT_FILE_HDR_SIZE;
+    header.profile_version = FIT_PROFILE_VERSION;
+    header.protocol_version = FIT_PROTOCOL_VERSION;
+    memcpy((FIT_UINT8 *)&header.data_type, ".FIT", 4);
+    header.data_size = data.size();
+    header.crc = fit::CRC::Calc16(&header, FIT_STRUCT_OFFSET(crc, FIT_FILE_HDR));
+
+    FIT_UINT16 crc = fit::CRC::Calc16(&header, FIT_FILE_HDR_SIZE);
+    for (char byte : data) {
+        crc = fit::CRC::Get16(crc, (FIT_UINT8)byte);
     }
-    file.close();
 
-    printf("Encoded FIT file ExampleActivity.fit.\n");
-    return;
+    QFile output(filename);
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << QStringLiteral("qfitwriter: unable to write") << filename << output.errorString();
+        return true;
+    }
+    output.write(reinterpret_cast<const char *>(&header), FIT_FILE_HDR_SIZE);
+    output.write(data.data(), data.size());
+    output.putChar(crc & 0xFF);
+    output.putChar((char)(crc >> 8));
+    output.close();
+
+    qDebug() << QStringLiteral("FIT file saved") << filename << session.count() << QStringLiteral("lines");
+    return true;
 }
 
 class Listener : public fit::FileIdMesgListener,
@@ -385,7 +515,7 @@ class Listener : public fit::FileIdMesgListener,
                  public fit::DeveloperFieldDescriptionListener,
                  public fit::RecordMesgListener {
   public:
-    QList<SessionLine> *sessionOpening = nullptr;
+    sessionstore *sessionOpening = nullptr;
 
     static void PrintValues(const fit::FieldBase &field) {
         for (FIT_UINT8 j = 0; j < (FIT_UINT8)field.GetNumValues(); j++) {
@@ -609,7 +739,7 @@ class Listener : public fit::FileIdMesgListener,
     }
 };
 
-void qfit::open(const QString &filename, QList<SessionLine> *output) {
+void qfit::open(const QString &filename, sessionstore *output) {
     std::fstream file;
     file.open(filename.toStdString(), std::ios::in);
 
@@ -2,12 +2,14 @@
 #define QFIT_H
 
 #include "devices/bluetoothdevice.h"
+#include "fit_encode.hpp"
 #include "fit_profile.hpp"
-#include "sessionline.h"
+#include "sessionstore.h"
 #include <QFile>
 #include <QGeoCoordinate>
 #include <QObject>
 #include <QTime>
+#include <sstream>
 
 #define QFIT_PROCESS_NONE 0
 #define QFIT_PROCESS_DISTANCENOISE 1
@@ -16,11 +18,105 @@ class qfit : public QObject {
     Q_OBJECT
   public:
     explicit qfit(QObject *parent = nullptr);
-    static void save(const QString &filename, QList<SessionLine> session, bluetoothdevice::BLUETOOTH_TYPE type,
+    static void save(const QString &filename, const sessionstore &session, bluetoothdevice::BLUETOOTH_TYPE type,
                      uint32_t processFlag = QFIT_PROCESS_NONE, FIT_SPORT overrideSport = FIT_SPORT_INVALID, QString workoutName = "", QString bluetooth_device_name = "");
-    static void open(const QString &filename, QList<SessionLine>* output);
+    static void open(const QString &filename, sessionstore *output);
     
   signals:
 };
 
+/**
+ * @brief Encodes the FIT file of a session while the session is recorded.
+ *
+ * update() encodes the record and lap messages of the lines appended to the session since the last call, so the
+ * encoded records are kept as compact FIT bytes instead of message objects. save() encodes only the last lap, the
+ * session and the activity messages and the messages that go before the records, and writes the file: the cost of a
+ * save doesn't depend on the length of the workout apart from copying the bytes, and the writer can keep going after
+ * it, so the same writer serves the periodic backups and the final save.
+ *
+ * The output is the same of qfit::save, which is built on this class. A few things that qfit::save knows in advance
+ * can only be discovered along the way: when they contradict the records already encoded (a GPS track starting
+ * after some records without coordinates, laps written with a different sport) save() returns false and the caller
+ * has to fall back to qfit::save.
+ */
+class qfitwriter {
+  public:
+    qfitwriter(bluetoothdevice::BLUETOOTH_TYPE type, uint32_t processFlag = QFIT_PROCESS_NONE,
+               FIT_SPORT overrideSport = FIT_SPORT_INVALID);
+
+    /**
+     * @brief Encodes the lines appended to the session since the last call. The records start from the first line
+     * with some activity.
+     */
+    void update(const sessionstore &session);
+
+    /**
+     * @brief Starts the records from the line index of the session, without waiting for some activity.
+     * @param gpsData true if the session has valid coordinates from index on: the lines without one are skipped.
+     */
+    void start(const sessionstore &session, int index, bool gpsData);
+
+    /**
+     * @brief Updates the writer and writes the whole FIT file of the session.
+     * @return false if the session can't be written from the encoded records, see the class description.
+     */
+    bool save(const QString &filename, const sessionstore &session, FIT_SPORT overrideSport = FIT_SPORT_INVALID,
+              QString workoutName = "", QString bluetooth_device_name = "");
+
+    // false once the session has been cleared or replaced, or it contradicts the encoded records
+    bool isValid() const { return !m_stale; }
+
+    static int firstRealIndex(const sessionstore &session, bluetoothdevice::BLUETOOTH_TYPE type);
+    static bool hasGpsData(const sessionstore &session, int from);
+
+  private:
+    // the lap in progress, copied by save() to encode the tail of the file without touching the writer
+    struct lapstate {
+        fit::LapMesg mesg;
+        uint32_t lastLapTimer = 0;
+        double lastLapOdometer = 0;
+        int lapIndex = 0;
+    };
+
+    FIT_SPORT lapSport(FIT_SPORT overrideSport) const;
+    void process(const sessionstore &session, int end);
+    int flushRun(const sessionstore &session, int end, fit::Encode &encode, fit::MesgDefinition &lastDefinition,
+                 lapstate &lap, double *lastDistance) const;
+    bool writeRecord(const sessionstore &session, int i, double distance, fit::Encode &encode,
+                     fit::MesgDefinition &lastDefinition, lapstate &lap) const;
+    static void write(fit::Encode &encode, fit::MesgDefinition &lastDefinition, const fit::Mesg &mesg);
+
+    bluetoothdevice::BLUETOOTH_TYPE m_type;
+    uint32_t m_processFlag;
+    FIT_SPORT m_overrideSport;
+    bool m_cadenceHalf = false;
+
+    bool m_started = false;
+    bool m_stale = false;
+    int m_scan = 0;
+    int m_next = 0;
+    int m_firstRealIndex = 0;
+    qint64 m_timeBase = 0;
+    FIT_DATE_TIME m_date = 0;
+    double m_startingDistanceOffset = 0;
+    bool m_gpsData = false;
+    int m_records = 0;
+
+    // the totals of the session message
+    double m_maxAltitude = 0;
+    double m_minAltitude = 99999;
+    double m_maxElevationGain = 0;
+    double m_speedAcc = 0;
+    int m_speedCount = 0;
+
+    // QFIT_PROCESS_DISTANCENOISE: the lines with the same distance are encoded once the distance changes
+    int m_runStart = -1;
+    double m_runDistance = -1.0;
+
+    std::stringstream m_body;
+    fit::Encode m_encode;
+    fit::MesgDefinition m_lastDefinition;
+    lapstate m_lap;
+};
+
 #endif // QFIT_H
@@ -0,0 +1,122 @@
+#include "qzlog.h"
+#include "qzsettings.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+
+Q_LOGGING_CATEGORY(qzBluetooth, "qz.bluetooth")
+Q_LOGGING_CATEGORY(qzBike, "qz.devices.bike")
+Q_LOGGING_CATEGORY(qzTreadmill, "qz.devices.treadmill")
+Q_LOGGING_CATEGORY(qzRower, "qz.devices.rower")
+Q_LOGGING_CATEGORY(qzElliptical, "qz.devices.elliptical")
+Q_LOGGING_CATEGORY(qzGatt, "qz.devices.gatt")
+Q_LOGGING_CATEGORY(qzCommands, "qz.devices.commands")
+Q_LOGGING_CATEGORY(qzVirtualDevices, "qz.virtualdevices")
+Q_LOGGING_CATEGORY(qzDircon, "qz.dircon")
+Q_LOGGING_CATEGORY(qzTemplates, "qz.templates")
+Q_LOGGING_CATEGORY(qzTrainProgram, "qz.trainprogram")
+
+namespace {
+struct rule {
+    QByteArray pattern;
+    bool prefix = false;
+    // -1 for all the levels
+    int level = -1;
+    bool enabled = true;
+};
+
+// the filter runs under the lock of the Qt logging registry: the rules have their own lock, never held while calling
+// into the registry
+QMutex rulesMutex;
+QVector<rule> rules;
+QLoggingCategory::CategoryFilter qtFilter = nullptr;
+
+void categoryFilter(QLoggingCategory *category) {
+    if (qtFilter) {
+        qtFilter(category);
+    }
+    const char *name = category->categoryName();
+    if (qstrncmp(name, "qz.", 3) != 0) {
+        return;
+    }
+
+    QMutexLocker locker(&rulesMutex);
+    for (const rule &r : qAsConst(rules)) {
+        if (r.prefix ? qstrncmp(name, r.pattern.constData(), r.pattern.size()) != 0 : r.pattern != name) {
+            continue;
+        }
+        if (r.level < 0) {
+            category->setEnabled(QtDebugMsg, r.enabled);
+            category->setEnabled(QtInfoMsg, r.enabled);
+            category->setEnabled(QtWarningMsg, r.enabled);
+            category->setEnabled(QtCriticalMsg, r.enabled);
+        } else {
+            category->setEnabled(QtMsgType(r.level), r.enabled);
+        }
+    }
+}
+
+QVector<rule> parse(const QString &text) {
+    static const struct {
+        const char *suffix;
+        QtMsgType level;
+    } levels[] = {
+        {".debug", QtDebugMsg}, {".info", QtInfoMsg}, {".warning", QtWarningMsg}, {".critical", QtCriticalMsg}};
+
+    QVector<rule> out;
+    const QStringList lines = QString(text).replace(QLatin1Char(';'), QLatin1Char('\n')).split(QLatin1Char('\n'));
+    for (const QString &line : lines) {
+        const int equal = line.indexOf(QLatin1Char('='));
+        if (equal < 0) {
+            continue;
+        }
+        QByteArray key = line.left(equal).trimmed().toLatin1();
+        const QString value = line.mid(equal + 1).trimmed().toLower();
+        if (key.isEmpty() || (value != QStringLiteral("true") && value != QStringLiteral("false"))) {
+            continue;
+        }
+
+        rule r;
+        r.enabled = value == QStringLiteral("true");
+        for (const auto &l : levels) {
+            if (key.endsWith(l.suffix)) {
+                r.level = l.level;
+                key.chop(int(qstrlen(l.suffix)));
+                break;
+            }
+        }
+        if (key.endsWith('*')) {
+            r.prefix = true;
+            key.chop(1);
+        }
+        r.pattern = key;
+        out.append(r);
+    }
+    return out;
+}
+} // namespace
+
+void qzlog::configure(const QSettings &settings, bool logging) {
+    QString text;
+    if (!logging) {
+        // nothing would be written: the messages aren't even formatted
+        text = QStringLiteral("qz.*.debug=false\nqz.*.info=false\n");
+    }
+    text += settings.value(QZSettings::log_categories, QZSettings::default_log_categories).toString();
+    setRules(text);
+}
+
+void qzlog::setRules(const QString &text) {
+    {
+        QMutexLocker locker(&rulesMutex);
+        rules = parse(text);
+    }
+
+    // the filter in place is taken first, so it's chained already when the new one runs for every registered category
+    static bool installed = false;
+    if (!installed) {
+        installed = true;
+        qtFilter = QLoggingCategory::installFilter(nullptr);
+    }
+    QLoggingCategory::installFilter(categoryFilter);
+}
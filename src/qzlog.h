@@ -0,0 +1,55 @@
+#ifndef QZLOG_H
+#define QZLOG_H
+
+#include <QLoggingCategory>
+#include <QSettings>
+#include <QString>
+
+Q_DECLARE_LOGGING_CATEGORY(qzBluetooth)      // qz.bluetooth
+Q_DECLARE_LOGGING_CATEGORY(qzBike)           // qz.devices.bike
+Q_DECLARE_LOGGING_CATEGORY(qzTreadmill)      // qz.devices.treadmill
+Q_DECLARE_LOGGING_CATEGORY(qzRower)          // qz.devices.rower
+Q_DECLARE_LOGGING_CATEGORY(qzElliptical)     // qz.devices.elliptical
+Q_DECLARE_LOGGING_CATEGORY(qzGatt)           // qz.devices.gatt, the writes queued by gattwritequeue
+Q_DECLARE_LOGGING_CATEGORY(qzCommands)       // qz.devices.commands, the targets handled by commandcoalescer
+Q_DECLARE_LOGGING_CATEGORY(qzVirtualDevices) // qz.virtualdevices
+Q_DECLARE_LOGGING_CATEGORY(qzDircon)         // qz.dircon
+Q_DECLARE_LOGGING_CATEGORY(qzTemplates)      // qz.templates
+Q_DECLARE_LOGGING_CATEGORY(qzTrainProgram)   // qz.trainprogram
+
+/**
+ * Emits the debug signal of a driver only if the category logs debug messages, so the text (often the hex dump of a
+ * packet) isn't built when it would be thrown away. qCDebug already skips its arguments the same way.
+ */
+#define QZ_EMIT_DEBUG(category, ...)                                                                                   \
+    do {                                                                                                               \
+        if (category().isDebugEnabled()) {                                                                             \
+            emit debug(__VA_ARGS__);                                                                                   \
+        }                                                                                                              \
+    } while (false)
+
+/**
+ * @brief The levels of the qz log categories.
+ *
+ * The levels are applied by a category filter installed over the one of Qt, so the rules set with
+ * QLoggingCategory::setFilterRules for the Qt categories (qt.bluetooth, qt.networkauth) still work and aren't
+ * replaced by these.
+ */
+class qzlog {
+
+  public:
+    /**
+     * @brief Sets the levels from the settings: debug and info are disabled if the debug log isn't written, then the
+     * rules of QZSettings::log_categories are applied.
+     */
+    static void configure(const QSettings &settings, bool logging);
+
+    /**
+     * @brief Replaces the rules, "<category>[.<level>]=true|false" separated by new lines or ';'. A category ending
+     * with '*' matches every category starting with it, a rule without a level is applied to all the levels. The
+     * later rules win.
+     */
+    static void setRules(const QString &rules);
+};
+
+#endif // QZLOG_H
@@ -8,6 +8,14 @@ const QString QZSettings::bluetooth_lastdevice_name = QStringLiteral("bluetooth_
 const QString QZSettings::default_bluetooth_lastdevice_name = QStringLiteral("");
 const QString QZSettings::bluetooth_lastdevice_address = QStringLiteral("bluetooth_lastdevice_address");
 const QString QZSettings::default_bluetooth_lastdevice_address = QStringLiteral("");
+const QString QZSettings::bluetooth_fast_reconnect = QStringLiteral("bluetooth_fast_reconnect");
+const QString QZSettings::bluetooth_lastdevice_driver = QStringLiteral("bluetooth_lastdevice_driver");
+const QString QZSettings::default_bluetooth_lastdevice_driver = QStringLiteral("");
+const QString QZSettings::bluetooth_lastdevice_services = QStringLiteral("bluetooth_lastdevice_services");
+const QString QZSettings::default_bluetooth_lastdevice_services = QStringLiteral("");
+const QString QZSettings::bluetooth_lastdevice_time_to_connected = QStringLiteral("bluetooth_lastdevice_time_to_connected");
+const QString QZSettings::bluetooth_lastdevice_time_to_first_metric =
+    QStringLiteral("bluetooth_lastdevice_time_to_first_metric");
 const QString QZSettings::hrm_lastdevice_name = QStringLiteral("hrm_lastdevice_name");
 const QString QZSettings::default_hrm_lastdevice_name = QStringLiteral("");
 const QString QZSettings::hrm_lastdevice_address = QStringLiteral("hrm_lastdevice_address");
@@ -305,6 +313,8 @@ const QString QZSettings::virtual_device_bluetooth = QStringLiteral("virtual_dev
 const QString QZSettings::ios_peloton_workaround = QStringLiteral("ios_peloton_workaround");
 const QString QZSettings::android_wakelock = QStringLiteral("android_wakelock");
 const QString QZSettings::log_debug = QStringLiteral("log_debug");
+const QString QZSettings::log_categories = QStringLiteral("log_categories");
+const QString QZSettings::default_log_categories = QStringLiteral("");
 const QString QZSettings::virtual_device_onlyheart = QStringLiteral("virtual_device_onlyheart");
 const QString QZSettings::virtual_device_echelon = QStringLiteral("virtual_device_echelon");
 const QString QZSettings::virtual_device_ifit = QStringLiteral("virtual_device_ifit");
@@ -676,6 +686,8 @@ const QString QZSettings::ant_speed_gain = QStringLiteral("ant_speed_gain");
 const QString QZSettings::proform_rower_sport_rl = QStringLiteral("proform_rower_sport_rl");
 const QString QZSettings::strava_date_prefix = QStringLiteral("strava_date_prefix");
 const QString QZSettings::race_mode = QStringLiteral("race_mode");
+const QString QZSettings::virtual_device_event_driven = QStringLiteral("virtual_device_event_driven");
+const QString QZSettings::virtual_device_notify_interval_ms = QStringLiteral("virtual_device_notify_interval_ms");
 const QString QZSettings::proform_pro_1000_treadmill = QStringLiteral("proform_pro_1000_treadmill");
 const QString QZSettings::saris_trainer = QStringLiteral("saris_trainer");
 const QString QZSettings::proform_studio_NTEX71021 = QStringLiteral("proform_studio_NTEX71021");
@@ -745,8 +757,21 @@ const QString QZSettings::proform_treadmill_705_cst_V78_239 = QStringLiteral("pr
 const QString QZSettings::stryd_add_inclination_gain = QStringLiteral("stryd_add_inclination_gain");
 const QString QZSettings::toorx_bike_srx_500 = QStringLiteral("toorx_bike_srx_500");
 const QString QZSettings::atletica_lightspeed_treadmill = QStringLiteral("atletica_lightspeed_treadmill");
+const QString QZSettings::tile_peak_power_enabled = QStringLiteral("tile_peak_power_enabled");
+const QString QZSettings::tile_peak_power_order = QStringLiteral("tile_peak_power_order");
+const QString QZSettings::w_prime = QStringLiteral("w_prime");
+const QString QZSettings::tile_np_enabled = QStringLiteral("tile_np_enabled");
+const QString QZSettings::tile_np_order = QStringLiteral("tile_np_order");
+const QString QZSettings::tile_tss_enabled = QStringLiteral("tile_tss_enabled");
+const QString QZSettings::tile_tss_order = QStringLiteral("tile_tss_order");
+const QString QZSettings::tile_wbal_enabled = QStringLiteral("tile_wbal_enabled");
+const QString QZSettings::tile_wbal_order = QStringLiteral("tile_wbal_order");
+const QString QZSettings::tile_watt_3s_enabled = QStringLiteral("tile_watt_3s_enabled");
+const QString QZSettings::tile_watt_3s_order = QStringLiteral("tile_watt_3s_order");
+const QString QZSettings::tile_watt_30s_enabled = QStringLiteral("tile_watt_30s_enabled");
+const QString QZSettings::tile_watt_30s_order = QStringLiteral("tile_watt_30s_order");
 
-const uint32_t allSettingsCount = 629;
+const uint32_t allSettingsCount = 650;
 
 QVariant allSettings[allSettingsCount][2] = {
     {QZSettings::cryptoKeySettingsProfiles, QZSettings::default_cryptoKeySettingsProfiles},
@@ -754,6 +779,12 @@ QVariant allSettings[allSettingsCount][2] = {
     {QZSettings::bike_wheel_revs, QZSettings::default_bike_wheel_revs},
     {QZSettings::bluetooth_lastdevice_name, QZSettings::default_bluetooth_lastdevice_name},
     {QZSettings::bluetooth_lastdevice_address, QZSettings::default_bluetooth_lastdevice_address},
+    {QZSettings::bluetooth_fast_reconnect, QZSettings::default_bluetooth_fast_reconnect},
+    {QZSettings::bluetooth_lastdevice_driver, QZSettings::default_bluetooth_lastdevice_driver},
+    {QZSettings::bluetooth_lastdevice_services, QZSettings::default_bluetooth_lastdevice_services},
+    {QZSettings::bluetooth_lastdevice_time_to_connected, QZSettings::default_bluetooth_lastdevice_time_to_connected},
+    {QZSettings::bluetooth_lastdevice_time_to_first_metric,
+     QZSettings::default_bluetooth_lastdevice_time_to_first_metric},
     {QZSettings::hrm_lastdevice_name, QZSettings::default_hrm_lastdevice_name},
     {QZSettings::hrm_lastdevice_address, QZSettings::default_hrm_lastdevice_address},
     {QZSettings::ftms_accessory_address, QZSettings::default_ftms_accessory_address},
@@ -1005,6 +1036,7 @@ QVariant allSettings[allSettingsCount][2] = {
     {QZSettings::ios_peloton_workaround, QZSettings::default_ios_peloton_workaround},
     {QZSettings::android_wakelock, QZSettings::default_android_wakelock},
     {QZSettings::log_debug, QZSettings::default_log_debug},
+    {QZSettings::log_categories, QZSettings::default_log_categories},
     {QZSettings::virtual_device_onlyheart, QZSettings::default_virtual_device_onlyheart},
     {QZSettings::virtual_device_echelon, QZSettings::default_virtual_device_echelon},
     {QZSettings::virtual_device_ifit, QZSettings::default_virtual_device_ifit},
@@ -1319,6 +1351,8 @@ QVariant allSettings[allSettingsCount][2] = {
     {QZSettings::proform_rower_sport_rl, QZSettings::default_proform_rower_sport_rl},
     {QZSettings::strava_date_prefix, QZSettings::default_strava_date_prefix},
     {QZSettings::race_mode, QZSettings::default_race_mode},
+    {QZSettings::virtual_device_event_driven, QZSettings::default_virtual_device_event_driven},
+    {QZSettings::virtual_device_notify_interval_ms, QZSettings::default_virtual_device_notify_interval_ms},
     {QZSettings::proform_pro_1000_treadmill, QZSettings::default_proform_pro_1000_treadmill},
     {QZSettings::saris_trainer, QZSettings::default_saris_trainer},
     {QZSettings::proform_studio_NTEX71021, QZSettings::default_proform_studio_NTEX71021},
@@ -1382,6 +1416,19 @@ QVariant allSettings[allSettingsCount][2] = {
     {QZSettings::stryd_add_inclination_gain, QZSettings::default_stryd_add_inclination_gain},
     {QZSettings::toorx_bike_srx_500, QZSettings::default_toorx_bike_srx_500},
     {QZSettings::atletica_lightspeed_treadmill, QZSettings::default_atletica_lightspeed_treadmill},
+    {QZSettings::tile_peak_power_enabled, QZSettings::default_tile_peak_power_enabled},
+    {QZSettings::tile_peak_power_order, QZSettings::default_tile_peak_power_order},
+    {QZSettings::w_prime, QZSettings::default_w_prime},
+    {QZSettings::tile_np_enabled, QZSettings::default_tile_np_enabled},
+    {QZSettings::tile_np_order, QZSettings::default_tile_np_order},
+    {QZSettings::tile_tss_enabled, QZSettings::default_tile_tss_enabled},
+    {QZSettings::tile_tss_order, QZSettings::default_tile_tss_order},
+    {QZSettings::tile_wbal_enabled, QZSettings::default_tile_wbal_enabled},
+    {QZSettings::tile_wbal_order, QZSettings::default_tile_wbal_order},
+    {QZSettings::tile_watt_3s_enabled, QZSettings::default_tile_watt_3s_enabled},
+    {QZSettings::tile_watt_3s_order, QZSettings::default_tile_watt_3s_order},
+    {QZSettings::tile_watt_30s_enabled, QZSettings::default_tile_watt_30s_enabled},
+    {QZSettings::tile_watt_30s_order, QZSettings::default_tile_watt_30s_order},
 };
 
 void QZSettings::qDebugAllSettings(bool showDefaults) {
@@ -33,6 +33,37 @@ class QZSettings {
     static const QString bluetooth_lastdevice_address;
     static const QString default_bluetooth_lastdevice_address;
 
+    /**
+     *@brief Connect at the start to the last device that connected, without waiting for the scan to find it.
+     *If the connection fails the device is scanned for as usual.
+     */
+    static const QString bluetooth_fast_reconnect;
+    static constexpr bool default_bluetooth_fast_reconnect = false;
+
+    /**
+     *@brief The class name of the driver the last device was connected with.
+     */
+    static const QString bluetooth_lastdevice_driver;
+    static const QString default_bluetooth_lastdevice_driver;
+
+    /**
+     *@brief The service UUIDs advertised by the last device, comma separated.
+     */
+    static const QString bluetooth_lastdevice_services;
+    static const QString default_bluetooth_lastdevice_services;
+
+    /**
+     *@brief Milliseconds from the start of the discovery to the last device connected and discovered. -1 if not measured.
+     */
+    static const QString bluetooth_lastdevice_time_to_connected;
+    static constexpr int default_bluetooth_lastdevice_time_to_connected = -1;
+
+    /**
+     *@brief Milliseconds from the start of the discovery to the first metric of the last device. -1 if not measured.
+     */
+    static const QString bluetooth_lastdevice_time_to_first_metric;
+    static constexpr int default_bluetooth_lastdevice_time_to_first_metric = -1;
+
     static const QString hrm_lastdevice_name;
     static const QString default_hrm_lastdevice_name;
 
@@ -930,6 +961,12 @@ class QZSettings {
      */
     static const QString log_debug;
     static constexpr bool default_log_debug = false;
+    /**
+     *@brief The levels of the qz log categories, in the QLoggingCategory rules syntax separated by new lines or ';',
+     * e.g. "qz.devices.*.debug=false;qz.dircon.debug=true". Applied over the defaults at startup.
+     */
+    static const QString log_categories;
+    static const QString default_log_categories;
     /**
      *@brief Force QZ to communicate ONLY the Heart Rate metric to third-party apps.
      */
@@ -1899,6 +1936,18 @@ class QZSettings {
     static const QString race_mode;
     static constexpr bool default_race_mode = false;
 
+    /**
+     *@brief The virtual devices notify as soon as the device publishes new metrics, instead of on the race_mode timer.
+     */
+    static const QString virtual_device_event_driven;
+    static constexpr bool default_virtual_device_event_driven = false;
+
+    /**
+     *@brief Minimum milliseconds between two notifications of a virtual device in the event-driven mode.
+     */
+    static const QString virtual_device_notify_interval_ms;
+    static constexpr int default_virtual_device_notify_interval_ms = 100;
+
     static const QString proform_pro_1000_treadmill;
     static constexpr bool default_proform_pro_1000_treadmill = false;
 
@@ -2087,6 +2136,45 @@ class QZSettings {
     static const QString atletica_lightspeed_treadmill;
     static constexpr bool default_atletica_lightspeed_treadmill = false;
 
+    static const QString tile_peak_power_enabled;
+    static constexpr bool default_tile_peak_power_enabled = false;
+
+    static const QString tile_peak_power_order;
+    static constexpr int default_tile_peak_power_order = 54;
+
+    static const QString w_prime;
+    static constexpr float default_w_prime = 20000.0;
+
+    static const QString tile_np_enabled;
+    static constexpr bool default_tile_np_enabled = false;
+
+    static const QString tile_np_order;
+    static constexpr int default_tile_np_order = 55;
+
+    static const QString tile_tss_enabled;
+    static constexpr bool default_tile_tss_enabled = false;
+
+    static const QString tile_tss_order;
+    static constexpr int default_tile_tss_order = 56;
+
+    static const QString tile_wbal_enabled;
+    static constexpr bool default_tile_wbal_enabled = false;
+
+    static const QString tile_wbal_order;
+    static constexpr int default_tile_wbal_order = 57;
+
+    static const QString tile_watt_3s_enabled;
+    static constexpr bool default_tile_watt_3s_enabled = false;
+
+    static const QString tile_watt_3s_order;
+    static constexpr int default_tile_watt_3s_order = 58;
+
+    static const QString tile_watt_30s_enabled;
+    static constexpr bool default_tile_watt_30s_enabled = false;
+
+    static const QString tile_watt_30s_order;
+    static constexpr int default_tile_watt_30s_order = 59;
+
     /**
      * @brief Write the QSettings values using the constants from this namespace.
      * @param showDefaults Optionally indicates if the default should be shown with the key.
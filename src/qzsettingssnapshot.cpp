@@ -0,0 +1,84 @@
+#include "qzsettingssnapshot.h"
+#include <QDebug>
+#include <QMutex>
+#include <QMutexLocker>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace {
+std::atomic<const QZSettingsSnapshot *> &currentSnapshot() {
+    static std::atomic<const QZSettingsSnapshot *> current{nullptr};
+    return current;
+}
+
+QMutex &writerMutex() {
+    static QMutex mutex;
+    return mutex;
+}
+
+// every published snapshot is owned here: a reader could still be using an old one, so they are never freed.
+// A new snapshot is published only when a value changes, so this list grows only when the user edits a setting.
+std::vector<std::unique_ptr<const QZSettingsSnapshot>> &publishedSnapshots() {
+    static std::vector<std::unique_ptr<const QZSettingsSnapshot>> snapshots;
+    return snapshots;
+}
+} // namespace
+
+const QZSettingsSnapshot &QZSettingsSnapshot::get() {
+    const QZSettingsSnapshot *snapshot = currentSnapshot().load(std::memory_order_acquire);
+    if (!snapshot) {
+        refresh();
+        snapshot = currentSnapshot().load(std::memory_order_acquire);
+    }
+    return *snapshot;
+}
+
+bool QZSettingsSnapshot::refresh() {
+    QMutexLocker locker(&writerMutex());
+    QSettings settings;
+    std::unique_ptr<QZSettingsSnapshot> fresh(new QZSettingsSnapshot());
+    fresh->load(settings);
+
+    const QZSettingsSnapshot *old = currentSnapshot().load(std::memory_order_acquire);
+    if (old && fresh->sameValues(*old)) {
+        return false;
+    }
+
+    fresh->generation = old ? old->generation + 1 : 1;
+    const QZSettingsSnapshot *published = fresh.get();
+    publishedSnapshots().push_back(std::move(fresh));
+    currentSnapshot().store(published, std::memory_order_release);
+    if (old) {
+        qDebug() << QStringLiteral("settings snapshot updated, generation") << published->generation;
+    }
+    return true;
+}
+
+void QZSettingsSnapshot::setValue(const QString &key, const QVariant &value) {
+    {
+        QSettings settings;
+        settings.setValue(key, value);
+    }
+    refresh();
+}
+
+void QZSettingsSnapshot::load(const QSettings &settings) {
+#define QZ_SETTINGS_SNAPSHOT_LOAD(type, name, conversion)                                                              \
+    name = settings.value(QZSettings::name, QZSettings::default_##name).conversion();
+    QZ_SETTINGS_SNAPSHOT_FIELDS(QZ_SETTINGS_SNAPSHOT_LOAD)
+#undef QZ_SETTINGS_SNAPSHOT_LOAD
+
+    heart_rate_belt_disabled = heart_rate_belt_name.startsWith(QStringLiteral("Disabled"));
+    cadence_sensor_disabled = cadence_sensor_name.startsWith(QStringLiteral("Disabled"));
+    power_sensor_disabled = power_sensor_name.startsWith(QStringLiteral("Disabled"));
+}
+
+bool QZSettingsSnapshot::sameValues(const QZSettingsSnapshot &other) const {
+#define QZ_SETTINGS_SNAPSHOT_COMPARE(type, name, conversion)                                                           \
+    if (!(name == other.name))                                                                                         \
+        return false;
+    QZ_SETTINGS_SNAPSHOT_FIELDS(QZ_SETTINGS_SNAPSHOT_COMPARE)
+#undef QZ_SETTINGS_SNAPSHOT_COMPARE
+    return true;
+}
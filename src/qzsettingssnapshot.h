@@ -0,0 +1,110 @@
+#ifndef QZSETTINGSSNAPSHOT_H
+#define QZSETTINGSSNAPSHOT_H
+
+#include "qzsettings.h"
+#include <QSettings>
+#include <QString>
+#include <QVariant>
+
+/**
+ * @brief The settings read on the per-sample hot paths (metric, device notifications, virtual devices and the
+ * homeform tick). Each entry is (C++ type, QZSettings key, QVariant conversion): the key and the default value are
+ * taken from QZSettings, so a new entry only needs a line here.
+ */
+#define QZ_SETTINGS_SNAPSHOT_FIELDS(X)                                                                                 \
+    X(double, watt_gain, toDouble)                                                                                     \
+    X(double, watt_offset, toDouble)                                                                                   \
+    X(double, speed_gain, toDouble)                                                                                    \
+    X(double, speed_offset, toDouble)                                                                                  \
+    X(float, weight, toFloat)                                                                                          \
+    X(float, bike_weight, toFloat)                                                                                     \
+    X(float, rolling_resistance, toFloat)                                                                              \
+    X(double, age, toDouble)                                                                                           \
+    X(QString, sex, toString)                                                                                          \
+    X(double, ftp, toDouble)                                                                                           \
+    X(double, w_prime, toDouble)                                                                                       \
+    X(bool, miles_unit, toBool)                                                                                        \
+    X(bool, power_avg_5s, toBool)                                                                                      \
+    X(bool, top_bar_enabled, toBool)                                                                                   \
+    X(double, heart_rate_zone1, toDouble)                                                                              \
+    X(double, heart_rate_zone2, toDouble)                                                                              \
+    X(double, heart_rate_zone3, toDouble)                                                                              \
+    X(double, heart_rate_zone4, toDouble)                                                                              \
+    X(QString, heart_rate_belt_name, toString)                                                                         \
+    X(bool, heart_ignore_builtin, toBool)                                                                              \
+    X(QString, cadence_sensor_name, toString)                                                                          \
+    X(QString, power_sensor_name, toString)                                                                            \
+    X(bool, speed_power_based, toBool)                                                                                 \
+    X(double, peloton_gain, toDouble)                                                                                  \
+    X(double, peloton_offset, toDouble)                                                                                \
+    X(bool, ant_heart, toBool)                                                                                         \
+    X(bool, bike_cadence_sensor, toBool)                                                                               \
+    X(bool, ios_peloton_workaround, toBool)                                                                            \
+    X(bool, battery_service, toBool)                                                                                   \
+    X(bool, bike_power_sensor, toBool)                                                                                 \
+    X(bool, virtual_device_enabled, toBool)                                                                            \
+    X(bool, virtual_device_onlyheart, toBool)                                                                          \
+    X(bool, virtual_device_echelon, toBool)                                                                            \
+    X(bool, virtual_device_ifit, toBool)                                                                               \
+    X(bool, zwift_erg, toBool)                                                                                         \
+    X(bool, bluetooth_relaxed, toBool)                                                                                 \
+    X(bool, bluetooth_30m_hangs, toBool)                                                                               \
+    X(bool, race_mode, toBool)                                                                                         \
+    X(bool, powr_sensor_running_cadence_double, toBool)
+
+/**
+ * @brief Immutable, typed copy of the hot-path settings.
+ *
+ * Building a QSettings object and converting QVariants costs a mutex and, on some platforms, a settings file check
+ * for every read. Code that runs for every BLE notification or every sample should read the current snapshot with
+ * plain field access instead:
+ *
+ *     const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
+ *     if (snapshot.speed_power_based) ...
+ *
+ * The snapshot isn't polled: whoever writes the settings publishes a new one, with setValue() or with refresh() after
+ * writing them (homeform::settingsChanged() when any QML page is opened or closed, the profile loading and
+ * restoring, the command line options). A new snapshot is published
+ * atomically only when one of the values actually changed; snapshots that have been replaced stay allocated, so a
+ * reference obtained from get() is always valid.
+ */
+class QZSettingsSnapshot {
+  public:
+#define QZ_SETTINGS_SNAPSHOT_DECLARE(type, name, conversion) type name;
+    QZ_SETTINGS_SNAPSHOT_FIELDS(QZ_SETTINGS_SNAPSHOT_DECLARE)
+#undef QZ_SETTINGS_SNAPSHOT_DECLARE
+
+    // derived values, computed once when the snapshot is built
+    bool heart_rate_belt_disabled = true;
+    bool cadence_sensor_disabled = true;
+    bool power_sensor_disabled = true;
+
+    /**
+     * @brief Incremented every time a different snapshot is published. Useful to invalidate values derived from
+     * the settings.
+     */
+    uint32_t generation = 0;
+
+    /**
+     * @brief The current snapshot. Lock-free, it never constructs a QSettings object except the very first time.
+     */
+    static const QZSettingsSnapshot &get();
+
+    /**
+     * @brief Reads the settings again and publishes a new snapshot if something changed.
+     * @return true if a new snapshot has been published.
+     */
+    static bool refresh();
+
+    /**
+     * @brief Writes a value to QSettings and refreshes the snapshot.
+     */
+    static void setValue(const QString &key, const QVariant &value);
+
+  private:
+    QZSettingsSnapshot() {}
+    void load(const QSettings &settings);
+    bool sameValues(const QZSettingsSnapshot &other) const;
+};
+
+#endif // QZSETTINGSSNAPSHOT_H
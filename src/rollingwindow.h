@@ -0,0 +1,72 @@
+#ifndef ROLLINGWINDOW_H
+#define ROLLINGWINDOW_H
+
+#include <array>
+
+/**
+ * @brief Fixed-capacity window over the last Capacity samples.
+ *
+ * The ring buffer stores cumulative sums instead of the samples, so appending a sample and reading the sum or the
+ * average of any of the last 1..Capacity samples are both O(1), without allocations and without shifting a list.
+ * The cumulative sums are rebased once every lap of the ring to keep them in the same magnitude of the samples.
+ */
+template <int Capacity> class rollingwindow {
+    static_assert(Capacity > 0, "rollingwindow capacity must be positive");
+
+  public:
+    void append(double value) {
+        m_total += value;
+        m_head = (m_head + 1) % Slots;
+        m_sums[m_head] = m_total;
+        if (m_count < Capacity) {
+            m_count++;
+        }
+
+        if (m_head == 0) {
+            double base = m_sums[1];
+            for (double &s : m_sums) {
+                s -= base;
+            }
+            m_total -= base;
+        }
+    }
+
+    void clear() {
+        m_sums.fill(0);
+        m_total = 0;
+        m_head = 0;
+        m_count = 0;
+    }
+
+    int count() const { return m_count; }
+    static constexpr int capacity() { return Capacity; }
+
+    double sum(int samples) const {
+        if (samples > m_count) {
+            samples = m_count;
+        }
+        if (samples <= 0) {
+            return 0;
+        }
+        return m_total - m_sums[(m_head + Slots - samples) % Slots];
+    }
+
+    double average(int samples) const {
+        if (samples > m_count) {
+            samples = m_count;
+        }
+        if (samples <= 0) {
+            return 0;
+        }
+        return sum(samples) / samples;
+    }
+
+  private:
+    static constexpr int Slots = Capacity + 1;
+    std::array<double, Slots> m_sums{};
+    double m_total = 0;
+    int m_head = 0;
+    int m_count = 0;
+};
+
+#endif // ROLLINGWINDOW_H
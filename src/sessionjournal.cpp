@@ -0,0 +1,265 @@
+#include "sessionjournal.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <cmath>
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+const quint32 headerMagic = 0x314A5A51; // "QZJ1"
+const quint32 recordMagic = 0x524A5A51; // "QZJR"
+const quint32 journalVersion = 1;
+
+struct journalheader {
+    quint32 magic;
+    quint32 version;
+    quint32 deviceType;
+    quint32 recordSize;
+    qint64 startTime;
+    quint8 reserved[8];
+};
+static_assert(sizeof(journalheader) == 32, "the journal header layout is part of the file format");
+
+struct journalrecord {
+    quint32 magic;
+    quint32 elapsedTime;
+    qint64 time;
+    double speed;
+    double distance;
+    double pace;
+    double calories;
+    double elevationGain;
+    double avgStrokesRate;
+    double maxStrokesRate;
+    double avgStrokesLength;
+    double latitude;
+    double longitude;
+    double altitude;
+    double instantaneousStrideLengthCM;
+    double groundContactMS;
+    double verticalOscillationMM;
+    double stepCount;
+    quint32 totalStrokes;
+    quint16 watt;
+    qint16 resistance;
+    qint8 inclination;
+    qint8 peloton_resistance;
+    quint8 heart;
+    quint8 cadence;
+    quint8 lapTrigger;
+    quint8 reserved[7];
+    quint32 checksum;
+};
+static_assert(sizeof(journalrecord) == sessionjournal::recordSize, "the journal record layout is part of the file format");
+
+quint32 recordChecksum(const journalrecord &r) {
+    return qChecksum(reinterpret_cast<const char *>(&r), offsetof(journalrecord, checksum));
+}
+
+journalrecord toRecord(const SessionLine &line) {
+    journalrecord r;
+    memset(&r, 0, sizeof(r));
+    r.magic = recordMagic;
+    r.elapsedTime = line.elapsedTime;
+    r.time = line.time.toMSecsSinceEpoch();
+    r.speed = line.speed;
+    r.distance = line.distance;
+    r.pace = line.pace;
+    r.calories = line.calories;
+    r.elevationGain = line.elevationGain;
+    r.avgStrokesRate = line.avgStrokesRate;
+    r.maxStrokesRate = line.maxStrokesRate;
+    r.avgStrokesLength = line.avgStrokesLength;
+    if (line.coordinate.isValid()) {
+        r.latitude = line.coordinate.latitude();
+        r.longitude = line.coordinate.longitude();
+        r.altitude = line.coordinate.altitude();
+    } else {
+        r.latitude = NAN;
+        r.longitude = NAN;
+        r.altitude = NAN;
+    }
+    r.instantaneousStrideLengthCM = line.instantaneousStrideLengthCM;
+    r.groundContactMS = line.groundContactMS;
+    r.verticalOscillationMM = line.verticalOscillationMM;
+    r.stepCount = line.stepCount;
+    r.totalStrokes = line.totalStrokes;
+    r.watt = line.watt;
+    r.resistance = line.resistance;
+    r.inclination = line.inclination;
+    r.peloton_resistance = line.peloton_resistance;
+    r.heart = line.heart;
+    r.cadence = line.cadence;
+    r.lapTrigger = line.lapTrigger;
+    r.checksum = recordChecksum(r);
+    return r;
+}
+
+SessionLine fromRecord(const journalrecord &r) {
+    QGeoCoordinate coordinate;
+    if (!std::isnan(r.latitude)) {
+        coordinate = QGeoCoordinate(r.latitude, r.longitude, r.altitude);
+    }
+    return SessionLine(r.speed, r.inclination, r.distance, r.watt, r.resistance, r.peloton_resistance, r.heart, r.pace,
+                       r.cadence, r.calories, r.elevationGain, r.elapsedTime, r.lapTrigger, r.totalStrokes,
+                       r.avgStrokesRate, r.maxStrokesRate, r.avgStrokesLength, coordinate,
+                       r.instantaneousStrideLengthCM, r.groundContactMS, r.verticalOscillationMM, r.stepCount,
+                       QDateTime::fromMSecsSinceEpoch(r.time));
+}
+
+void syncToDisk(QFile &file) {
+    file.flush();
+#ifdef Q_OS_WIN
+    _commit(file.handle());
+#else
+    ::fsync(file.handle());
+#endif
+}
+} // namespace
+
+sessionjournal::sessionjournal(const QString &filename, QObject *parent) : QObject(parent), m_filename(filename) {
+    m_thread = QThread::create([this] { run(); });
+    m_thread->start(QThread::LowPriority);
+}
+
+sessionjournal::~sessionjournal() {
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stop = true;
+        m_wake.wakeAll();
+    }
+    m_thread->wait();
+    delete m_thread;
+}
+
+void sessionjournal::append(const SessionLine &line, uint32_t deviceType) {
+    journalrecord r = toRecord(line);
+
+    QMutexLocker locker(&m_mutex);
+    if (!m_opened) {
+        journalheader h;
+        memset(&h, 0, sizeof(h));
+        h.magic = headerMagic;
+        h.version = journalVersion;
+        h.deviceType = deviceType;
+        h.recordSize = recordSize;
+        h.startTime = r.time;
+        m_pending.append(reinterpret_cast<const char *>(&h), sizeof(h));
+        m_create = true;
+        m_opened = true;
+    }
+    m_pending.append(reinterpret_cast<const char *>(&r), sizeof(r));
+    m_wake.wakeAll();
+}
+
+void sessionjournal::finish() {
+    QMutexLocker locker(&m_mutex);
+    m_finish = true;
+    m_opened = false;
+    quint64 ticket = ++m_requests;
+    m_wake.wakeAll();
+    while (m_done < ticket) {
+        m_idle.wait(&m_mutex);
+    }
+}
+
+void sessionjournal::sync() {
+    QMutexLocker locker(&m_mutex);
+    m_syncRequested = true;
+    quint64 ticket = ++m_requests;
+    m_wake.wakeAll();
+    while (m_done < ticket) {
+        m_idle.wait(&m_mutex);
+    }
+}
+
+void sessionjournal::run() {
+    int unsynced = 0;
+    QElapsedTimer sinceSync;
+    sinceSync.start();
+
+    QMutexLocker locker(&m_mutex);
+    forever {
+        if (m_pending.isEmpty() && !m_finish && !m_syncRequested && !m_stop) {
+            m_wake.wait(&m_mutex, m_syncIntervalMs);
+        }
+
+        QByteArray batch;
+        batch.swap(m_pending);
+        bool create = m_create;
+        bool finish = m_finish;
+        bool syncRequested = m_syncRequested;
+        bool stop = m_stop;
+        quint64 ticket = m_requests;
+        m_create = false;
+        m_finish = false;
+        m_syncRequested = false;
+        locker.unlock();
+
+        if (create) {
+            m_file.close();
+            m_file.setFileName(m_filename);
+            if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                qDebug() << QStringLiteral("session journal: unable to create") << m_filename << m_file.errorString();
+            }
+        }
+        if (!batch.isEmpty() && m_file.isOpen()) {
+            m_file.write(batch);
+            unsynced += batch.size() / recordSize;
+        }
+        if (m_file.isOpen() && (finish || syncRequested || stop || unsynced >= m_syncRecords ||
+                                (unsynced > 0 && sinceSync.elapsed() >= m_syncIntervalMs))) {
+            syncToDisk(m_file);
+            unsynced = 0;
+            sinceSync.restart();
+        }
+        if (finish) {
+            m_file.close();
+            QFile::remove(m_filename);
+        }
+
+        locker.relock();
+        m_done = ticket;
+        m_idle.wakeAll();
+        if (stop) {
+            break;
+        }
+    }
+    m_file.close();
+}
+
+bool sessionjournal::read(const QString &filename, sessionstore *session, uint32_t *deviceType) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    journalheader h;
+    if (file.read(reinterpret_cast<char *>(&h), sizeof(h)) != sizeof(h) || h.magic != headerMagic ||
+        h.recordSize != recordSize) {
+        return false;
+    }
+    if (deviceType) {
+        *deviceType = h.deviceType;
+    }
+
+    journalrecord r;
+    int records = 0;
+    while (file.read(reinterpret_cast<char *>(&r), sizeof(r)) == sizeof(r)) {
+        // a torn or garbled record ends the journal: it was being written when the app died
+        if (r.magic != recordMagic || r.checksum != recordChecksum(r)) {
+            break;
+        }
+        session->append(fromRecord(r));
+        records++;
+    }
+    qDebug() << QStringLiteral("session journal: recovered") << records << QStringLiteral("records from") << filename;
+    return true;
+}
@@ -0,0 +1,85 @@
+#ifndef SESSIONJOURNAL_H
+#define SESSIONJOURNAL_H
+
+#include "sessionstore.h"
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QObject>
+#include <QThread>
+#include <QWaitCondition>
+
+/**
+ * @brief Append-only binary journal of the session lines of the current workout.
+ *
+ * Every session line becomes a fixed-size record with its own checksum, appended to the journal by a writer thread:
+ * append() only copies the record in a buffer, so the GUI thread never waits for the disk. The writer flushes and
+ * syncs the file every syncRecords records or syncIntervalMs milliseconds, whichever comes first, so a kill or a
+ * power loss costs at most the last few seconds of the workout.
+ *
+ * The journal is removed by finish() when the workout is saved. A journal still on disk at startup belongs to a
+ * workout that didn't end: read() loads every complete and valid record of it, a torn record at the end is ignored.
+ */
+class sessionjournal : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit sessionjournal(const QString &filename, QObject *parent = nullptr);
+    ~sessionjournal();
+
+    /**
+     * @brief Queues a session line, the journal is created with its header by the first line of a workout.
+     */
+    void append(const SessionLine &line, uint32_t deviceType);
+
+    /**
+     * @brief Writes the pending records, then closes and removes the journal.
+     */
+    void finish();
+
+    /**
+     * @brief Waits until every queued record is written and synced.
+     */
+    void sync();
+
+    QString filename() const { return m_filename; }
+
+    void setSyncRecords(int records) { m_syncRecords = records; }
+    void setSyncIntervalMs(int ms) { m_syncIntervalMs = ms; }
+
+    /**
+     * @brief Reads a journal.
+     * @param session The recovered lines are appended here.
+     * @param deviceType The bluetoothdevice::BLUETOOTH_TYPE of the workout.
+     * @return false if the file is missing or it isn't a journal.
+     */
+    static bool read(const QString &filename, sessionstore *session, uint32_t *deviceType);
+
+    static const int recordSize = 160;
+
+  private:
+    void run();
+
+    QString m_filename;
+    QFile m_file;
+    QThread *m_thread = nullptr;
+
+    // protected by m_mutex
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    QWaitCondition m_idle;
+    QByteArray m_pending;
+    bool m_opened = false;
+    bool m_create = false;
+    bool m_finish = false;
+    bool m_syncRequested = false;
+    bool m_stop = false;
+    // finish() and sync() wait until the writer has handled their request
+    quint64 m_requests = 0;
+    quint64 m_done = 0;
+
+    int m_syncRecords = 10;
+    int m_syncIntervalMs = 5000;
+};
+
+#endif // SESSIONJOURNAL_H
@@ -0,0 +1,73 @@
+#include "sessionstore.h"
+#include <cmath>
+
+void sessionstore::append(const SessionLine &line) {
+#define QZ_SESSION_COLUMN_APPEND(type, name) m_##name.append(static_cast<type>(line.name));
+    QZ_SESSION_COLUMNS(QZ_SESSION_COLUMN_APPEND)
+#undef QZ_SESSION_COLUMN_APPEND
+    m_powerCurve.append(line.watt, line.elapsedTime);
+
+    qint64 t = line.time.toMSecsSinceEpoch();
+    if (m_timeOffset.isEmpty()) {
+        m_timeBase = t;
+    }
+    m_timeOffset.append(static_cast<qint32>(t - m_timeBase));
+
+    if (line.coordinate.isValid() || hasCoordinates()) {
+        if (!hasCoordinates()) {
+            // first valid coordinate: the previous lines don't have one
+            int previous = m_timeOffset.count() - 1;
+            m_latitude.fill(NAN, previous);
+            m_longitude.fill(NAN, previous);
+            m_altitude.fill(NAN, previous);
+        }
+        if (line.coordinate.isValid()) {
+            m_latitude.append(line.coordinate.latitude());
+            m_longitude.append(line.coordinate.longitude());
+            m_altitude.append(line.coordinate.altitude());
+        } else {
+            m_latitude.append(NAN);
+            m_longitude.append(NAN);
+            m_altitude.append(NAN);
+        }
+    }
+}
+
+void sessionstore::clear() {
+#define QZ_SESSION_COLUMN_CLEAR(type, name) m_##name.clear();
+    QZ_SESSION_COLUMNS(QZ_SESSION_COLUMN_CLEAR)
+#undef QZ_SESSION_COLUMN_CLEAR
+
+    m_timeBase = 0;
+    m_timeOffset.clear();
+    m_latitude.clear();
+    m_longitude.clear();
+    m_altitude.clear();
+    m_powerCurve.clear();
+}
+
+void sessionstore::reserve(int size) {
+#define QZ_SESSION_COLUMN_RESERVE(type, name) m_##name.reserve(size);
+    QZ_SESSION_COLUMNS(QZ_SESSION_COLUMN_RESERVE)
+#undef QZ_SESSION_COLUMN_RESERVE
+
+    m_timeOffset.reserve(size);
+}
+
+QGeoCoordinate sessionstore::coordinate(int i) const {
+    if (!hasCoordinates() || std::isnan(m_latitude.at(i))) {
+        return QGeoCoordinate();
+    }
+    return QGeoCoordinate(m_latitude.at(i), m_longitude.at(i), m_altitude.at(i));
+}
+
+SessionLine sessionstore::at(int i) const {
+    SessionLine line;
+#define QZ_SESSION_COLUMN_AT(type, name) line.name = m_##name.at(i);
+    QZ_SESSION_COLUMNS(QZ_SESSION_COLUMN_AT)
+#undef QZ_SESSION_COLUMN_AT
+
+    line.time = time(i);
+    line.coordinate = coordinate(i);
+    return line;
+}
@@ -0,0 +1,98 @@
+#ifndef SESSIONSTORE_H
+#define SESSIONSTORE_H
+
+#include "powercurve.h"
+#include "sessionline.h"
+#include <QDateTime>
+#include <QGeoCoordinate>
+#include <QVector>
+
+/**
+ * @brief The per-second columns of a session: (C++ type, SessionLine field). The types are the narrowest ones that
+ * keep the precision the exporters need.
+ */
+#define QZ_SESSION_COLUMNS(X)                                                                                          \
+    X(float, speed)                                                                                                    \
+    X(int8_t, inclination)                                                                                             \
+    X(double, distance)                                                                                                \
+    X(uint16_t, watt)                                                                                                  \
+    X(resistance_t, resistance)                                                                                        \
+    X(int8_t, peloton_resistance)                                                                                      \
+    X(uint8_t, heart)                                                                                                  \
+    X(float, pace)                                                                                                     \
+    X(uint8_t, cadence)                                                                                                \
+    X(double, calories)                                                                                                \
+    X(float, elevationGain)                                                                                            \
+    X(uint32_t, elapsedTime)                                                                                           \
+    X(bool, lapTrigger)                                                                                                \
+    X(uint32_t, totalStrokes)                                                                                          \
+    X(float, avgStrokesRate)                                                                                           \
+    X(float, maxStrokesRate)                                                                                           \
+    X(float, avgStrokesLength)                                                                                         \
+    X(float, instantaneousStrideLengthCM)                                                                              \
+    X(float, groundContactMS)                                                                                          \
+    X(float, verticalOscillationMM)                                                                                    \
+    X(float, stepCount)
+
+/**
+ * @brief Struct-of-arrays storage for the lines of a workout session.
+ *
+ * A QList<SessionLine> keeps every line in its own heap allocation, each with a QDateTime and a QGeoCoordinate, and
+ * it is copied whole every time it is passed to an exporter. Here every field is a typed column, the timestamps are
+ * millisecond offsets from the time of the first line and the coordinate columns are allocated only once a line
+ * with a valid coordinate is appended, so indoor sessions don't pay for them.
+ *
+ * Exporters and analytics read the columns by const reference:
+ *
+ *     const QVector<uint16_t> &watt = session.watt();
+ *
+ * at() rebuilds a whole SessionLine for the code that still needs one. The mean-maximal power curve of the session
+ * is updated on every append(), so the peaks are always available with powerCurve().
+ */
+class sessionstore {
+  public:
+    void append(const SessionLine &line);
+    void clear();
+    void reserve(int size);
+
+    int count() const { return m_elapsedTime.count(); }
+    int size() const { return count(); }
+    bool isEmpty() const { return m_elapsedTime.isEmpty(); }
+
+    SessionLine at(int i) const;
+    SessionLine first() const { return at(0); }
+    SessionLine last() const { return at(count() - 1); }
+
+    QDateTime time(int i) const { return QDateTime::fromMSecsSinceEpoch(timeMSecsSinceEpoch(i)); }
+    qint64 timeMSecsSinceEpoch(int i) const { return m_timeBase + m_timeOffset.at(i); }
+
+    // false until a line with a valid coordinate has been appended
+    bool hasCoordinates() const { return !m_latitude.isEmpty(); }
+    bool coordinateIsValid(int i) const { return hasCoordinates() && coordinate(i).isValid(); }
+    QGeoCoordinate coordinate(int i) const;
+
+    const powercurve &powerCurve() const { return m_powerCurve; }
+
+#define QZ_SESSION_COLUMN_GETTER(type, name)                                                                           \
+    const QVector<type> &name() const { return m_##name; }
+    QZ_SESSION_COLUMNS(QZ_SESSION_COLUMN_GETTER)
+#undef QZ_SESSION_COLUMN_GETTER
+
+  private:
+#define QZ_SESSION_COLUMN_DECLARE(type, name) QVector<type> m_##name;
+    QZ_SESSION_COLUMNS(QZ_SESSION_COLUMN_DECLARE)
+#undef QZ_SESSION_COLUMN_DECLARE
+
+    // msecs since epoch of the first line, the offsets are enough for 24 days
+    qint64 m_timeBase = 0;
+    QVector<qint32> m_timeOffset;
+
+    // empty, or one entry per line (NaN for the lines without a coordinate)
+    QVector<double> m_latitude;
+    QVector<double> m_longitude;
+    QVector<double> m_altitude;
+
+    powercurve m_powerCurve;
+};
+
+#endif // SESSIONSTORE_H
@@ -193,6 +193,18 @@ ScrollView {
         property int  tile_erg_mode_order: 52
         property bool tile_rss_enabled: false
         property int  tile_rss_order: 53        
+        property bool tile_peak_power_enabled: false
+        property int  tile_peak_power_order: 54
+        property bool tile_np_enabled: false
+        property int  tile_np_order: 55
+        property bool tile_tss_enabled: false
+        property int  tile_tss_order: 56
+        property bool tile_wbal_enabled: false
+        property int  tile_wbal_order: 57
+        property bool tile_watt_3s_enabled: false
+        property int  tile_watt_3s_order: 58
+        property bool tile_watt_30s_enabled: false
+        property int  tile_watt_30s_order: 59
     }
 
 
@@ -2315,6 +2327,180 @@ ScrollView {
             }
         }        
 
+        AccordionCheckElement {
+            title: qsTr("Peak Power")
+            linkedBoolSetting: "tile_peak_power_enabled"
+            settings: settings
+            accordionContent: RowLayout {
+                spacing: 10
+                Label {
+                    text: qsTr("order index:")
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignRight
+                }
+                ComboBox {
+                    id: peakPowerOrderTextField
+                    model: rootItem.tile_order
+                    displayText: settings.tile_peak_power_order
+                    Layout.fillHeight: false
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onActivated: {
+                        displayText = peakPowerOrderTextField.currentValue
+                     }
+                }
+                Button {
+                    text: "OK"
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onClicked: {settings.tile_peak_power_order = peakPowerOrderTextField.displayText; toast.show("Setting saved!"); }
+                }
+            }
+        }
+
+        AccordionCheckElement {
+            title: qsTr("Normalized Power")
+            linkedBoolSetting: "tile_np_enabled"
+            settings: settings
+            accordionContent: RowLayout {
+                spacing: 10
+                Label {
+                    text: qsTr("order index:")
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignRight
+                }
+                ComboBox {
+                    id: npOrderTextField
+                    model: rootItem.tile_order
+                    displayText: settings.tile_np_order
+                    Layout.fillHeight: false
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onActivated: {
+                        displayText = npOrderTextField.currentValue
+                     }
+                }
+                Button {
+                    text: "OK"
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onClicked: {settings.tile_np_order = npOrderTextField.displayText; toast.show("Setting saved!"); }
+                }
+            }
+        }
+
+        AccordionCheckElement {
+            title: qsTr("Training Stress Score")
+            linkedBoolSetting: "tile_tss_enabled"
+            settings: settings
+            accordionContent: RowLayout {
+                spacing: 10
+                Label {
+                    text: qsTr("order index:")
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignRight
+                }
+                ComboBox {
+                    id: tssOrderTextField
+                    model: rootItem.tile_order
+                    displayText: settings.tile_tss_order
+                    Layout.fillHeight: false
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onActivated: {
+                        displayText = tssOrderTextField.currentValue
+                     }
+                }
+                Button {
+                    text: "OK"
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onClicked: {settings.tile_tss_order = tssOrderTextField.displayText; toast.show("Setting saved!"); }
+                }
+            }
+        }
+
+        AccordionCheckElement {
+            title: qsTr("W' Balance")
+            linkedBoolSetting: "tile_wbal_enabled"
+            settings: settings
+            accordionContent: RowLayout {
+                spacing: 10
+                Label {
+                    text: qsTr("order index:")
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignRight
+                }
+                ComboBox {
+                    id: wbalOrderTextField
+                    model: rootItem.tile_order
+                    displayText: settings.tile_wbal_order
+                    Layout.fillHeight: false
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onActivated: {
+                        displayText = wbalOrderTextField.currentValue
+                     }
+                }
+                Button {
+                    text: "OK"
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onClicked: {settings.tile_wbal_order = wbalOrderTextField.displayText; toast.show("Setting saved!"); }
+                }
+            }
+        }
+
+        AccordionCheckElement {
+            title: qsTr("Power 3s")
+            linkedBoolSetting: "tile_watt_3s_enabled"
+            settings: settings
+            accordionContent: RowLayout {
+                spacing: 10
+                Label {
+                    text: qsTr("order index:")
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignRight
+                }
+                ComboBox {
+                    id: watt3sOrderTextField
+                    model: rootItem.tile_order
+                    displayText: settings.tile_watt_3s_order
+                    Layout.fillHeight: false
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onActivated: {
+                        displayText = watt3sOrderTextField.currentValue
+                     }
+                }
+                Button {
+                    text: "OK"
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onClicked: {settings.tile_watt_3s_order = watt3sOrderTextField.displayText; toast.show("Setting saved!"); }
+                }
+            }
+        }
+
+        AccordionCheckElement {
+            title: qsTr("Power 30s")
+            linkedBoolSetting: "tile_watt_30s_enabled"
+            settings: settings
+            accordionContent: RowLayout {
+                spacing: 10
+                Label {
+                    text: qsTr("order index:")
+                    Layout.fillWidth: true
+                    horizontalAlignment: Text.AlignRight
+                }
+                ComboBox {
+                    id: watt30sOrderTextField
+                    model: rootItem.tile_order
+                    displayText: settings.tile_watt_30s_order
+                    Layout.fillHeight: false
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onActivated: {
+                        displayText = watt30sOrderTextField.currentValue
+                     }
+                }
+                Button {
+                    text: "OK"
+                    Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                    onClicked: {settings.tile_watt_30s_order = watt30sOrderTextField.displayText; toast.show("Setting saved!"); }
+                }
+            }
+        }
+
         AccordionCheckElement {
             id: presetResistance1EnabledAccordion
             title: qsTr("Preset Resistance 1")
@@ -955,6 +955,22 @@ import QtQuick.Dialogs 1.0
 
             // from version 2.16.66
             property bool atletica_lightspeed_treadmill: false
+            property bool tile_peak_power_enabled: false
+            property int  tile_peak_power_order: 54
+            property real w_prime: 20000.0
+            property bool tile_np_enabled: false
+            property int  tile_np_order: 55
+            property bool tile_tss_enabled: false
+            property int  tile_tss_order: 56
+            property bool tile_wbal_enabled: false
+            property int  tile_wbal_order: 57
+            property bool tile_watt_3s_enabled: false
+            property int  tile_watt_3s_order: 58
+            property bool tile_watt_30s_enabled: false
+            property int  tile_watt_30s_order: 59
+            property bool virtual_device_event_driven: false
+            property int  virtual_device_notify_interval_ms: 100
+            property bool bluetooth_fast_reconnect: false
         }
 
         function paddingZeros(text, limit) {
@@ -1189,6 +1205,42 @@ import QtQuick.Dialogs 1.0
                         color: Material.color(Material.Lime)
                     }
 
+                    RowLayout {
+                        spacing: 10
+                        Label {
+                            text: qsTr("W' value (J):")
+                            Layout.fillWidth: true
+                        }
+                        TextField {
+                            id: wPrimeTextField
+                            text: settings.w_prime
+                            horizontalAlignment: Text.AlignRight
+                            Layout.fillHeight: false
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            inputMethodHints: Qt.ImhDigitsOnly
+                            onAccepted: settings.w_prime = text
+                            onActiveFocusChanged: if(this.focus) this.cursorPosition = this.text.length
+                        }
+                        Button {
+                            text: "OK"
+                            Layout.alignment: Qt.AlignRight | Qt.AlignVCenter
+                            onClicked: { settings.w_prime = wPrimeTextField.text; toast.show("Setting saved!"); }
+                        }
+                    }
+
+                    Label {
+                        text: qsTr("The anaerobic work capacity above your FTP, in joules. It is used with the FTP to calculate the W' balance tile.")
+                        font.bold: true
+                        font.italic: true
+                        font.pixelSize: 9
+                        textFormat: Text.PlainText
+                        wrapMode: Text.WordWrap
+                        verticalAlignment: Text.AlignVCenter
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        color: Material.color(Material.Lime)
+                    }
+
                     RowLayout {
                         spacing: 10
                         Label {
@@ -9562,6 +9614,34 @@ import QtQuick.Dialogs 1.0
                         color: Material.color(Material.Lime)
                     }
 
+                    SwitchDelegate {
+                        id: bluetoothFastReconnectDelegate
+                        text: qsTr("Fast Reconnect to the Last Device")
+                        spacing: 0
+                        bottomPadding: 0
+                        topPadding: 0
+                        rightPadding: 0
+                        leftPadding: 0
+                        clip: false
+                        checked: settings.bluetooth_fast_reconnect
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        onClicked: { settings.bluetooth_fast_reconnect = checked; window.settings_restart_to_apply = true; }
+                    }
+
+                    Label {
+                        text: qsTr("At startup connects to the device of the last session without waiting for the scan to find it. If it doesn't connect within 15 seconds, QZ scans as usual. Default is off.")
+                        font.bold: true
+                        font.italic: true
+                        font.pixelSize: 9
+                        textFormat: Text.PlainText
+                        wrapMode: Text.WordWrap
+                        verticalAlignment: Text.AlignVCenter
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        color: Material.color(Material.Lime)
+                    }
+
                     SwitchDelegate {
                         id: batteryServiceDelegate
                         text: qsTr("Simulate Battery Service")
@@ -9877,6 +9957,33 @@ import QtQuick.Dialogs 1.0
                         color: Material.color(Material.Lime)
                     }
 
+                    SwitchDelegate {
+                        text: qsTr("Event-Driven Notifications")
+                        spacing: 0
+                        bottomPadding: 0
+                        topPadding: 0
+                        rightPadding: 0
+                        leftPadding: 0
+                        clip: false
+                        checked: settings.virtual_device_event_driven
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        onClicked: { settings.virtual_device_event_driven = checked; window.settings_restart_to_apply = true; }
+                    }
+
+                    Label {
+                        text: qsTr("Sends the info to Zwift or any other 3rd party apps as soon as your bike/treadmill/rower sends new data, at most every 100ms, instead of waiting for the Race Mode interval. When the device is idle QZ sends them only once a second. Devices that don't support it keep using the Race Mode interval.")
+                        font.bold: true
+                        font.italic: true
+                        font.pixelSize: 9
+                        textFormat: Text.PlainText
+                        wrapMode: Text.WordWrap
+                        verticalAlignment: Text.AlignVCenter
+                        Layout.alignment: Qt.AlignLeft | Qt.AlignTop
+                        Layout.fillWidth: true
+                        color: Material.color(Material.Lime)
+                    }
+
                     SwitchDelegate {
                         id: runCadenceSensorDelegate
                         text: qsTr("Run Cadence Sensor")
@@ -480,8 +480,8 @@ void TemplateInfoSenderBuilder::onGetTrainingProgram(const QJsonValue &msgConten
     QJsonObject outObj;
     QString fileXml;
     if (homeform::singleton() && homeform::singleton()->trainingProgram()) {
-        QList<trainrow> lst = homeform::singleton()->trainingProgram()->loadedRows;
-        for (auto &row : lst) {
+        const QVector<trainrow> &lst = homeform::singleton()->trainingProgram()->loadedRows;
+        for (const auto &row : lst) {
             QJsonObject item;
             TRAINPROGRAM_FIELD_TO_STRING();
             outArr.append(item);
@@ -959,7 +959,7 @@ void TemplateInfoSenderBuilder::buildContext(bool forceReinit) {
         QString nickName;
         bluetoothdevice::BLUETOOTH_TYPE tp = device->deviceType();
 
-        metric dep;
+        const metric *dep;
 #ifdef Q_OS_IOS
         obj.setProperty("deviceId", device->bluetoothDevice.deviceUuid().toString());
 #else
@@ -994,31 +994,40 @@ void TemplateInfoSenderBuilder::buildContext(bool forceReinit) {
         obj.setProperty(QStringLiteral("moving_s"), el.second());
         obj.setProperty(QStringLiteral("moving_m"), el.minute());
         obj.setProperty(QStringLiteral("moving_h"), el.hour());
-        obj.setProperty(QStringLiteral("speed"), (dep = device->currentSpeed()).value());
-        obj.setProperty(QStringLiteral("speed_avg"), dep.average());
+        obj.setProperty(QStringLiteral("speed"), (dep = &device->currentSpeed())->value());
+        obj.setProperty(QStringLiteral("speed_avg"), dep->average());
         obj.setProperty(QStringLiteral("speed_color"), homeform::singleton()->speed->valueFontColor());
-        obj.setProperty(QStringLiteral("speed_lapavg"), dep.lapAverage());
-        obj.setProperty(QStringLiteral("speed_lapmax"), dep.lapMax());
+        obj.setProperty(QStringLiteral("speed_lapavg"), dep->lapAverage());
+        obj.setProperty(QStringLiteral("speed_lapmax"), dep->lapMax());
         obj.setProperty(QStringLiteral("calories"), device->calories().value());
         obj.setProperty(QStringLiteral("distance"), device->odometer());
-        obj.setProperty(QStringLiteral("heart"), (dep = device->currentHeart()).value());
+        obj.setProperty(QStringLiteral("heart"), (dep = &device->currentHeart())->value());
         obj.setProperty(QStringLiteral("heart_color"), homeform::singleton()->heart->valueFontColor());
-        obj.setProperty(QStringLiteral("heart_avg"), dep.average());
-        obj.setProperty(QStringLiteral("heart_lapavg"), dep.lapAverage());
-        obj.setProperty(QStringLiteral("heart_max"), dep.max());
-        obj.setProperty(QStringLiteral("heart_lapmax"), dep.lapMax());
+        obj.setProperty(QStringLiteral("heart_avg"), dep->average());
+        obj.setProperty(QStringLiteral("heart_lapavg"), dep->lapAverage());
+        obj.setProperty(QStringLiteral("heart_max"), dep->max());
+        obj.setProperty(QStringLiteral("heart_lapmax"), dep->lapMax());
         obj.setProperty(QStringLiteral("jouls"), device->jouls().value());
         obj.setProperty(QStringLiteral("elevation"), device->elevationGain().value());
         obj.setProperty(QStringLiteral("difficult"), device->difficult());
-        obj.setProperty(QStringLiteral("watts"), (dep = device->wattsMetric()).value());
-        obj.setProperty(QStringLiteral("watts_avg"), dep.average());
+        obj.setProperty(QStringLiteral("watts"), (dep = &device->wattsMetric())->value());
+        obj.setProperty(QStringLiteral("watts_avg"), dep->average());
         obj.setProperty(QStringLiteral("watts_color"), homeform::singleton()->watt->valueFontColor());
-        obj.setProperty(QStringLiteral("watts_lapavg"), dep.lapAverage());
-        obj.setProperty(QStringLiteral("watts_max"), dep.max());
-        obj.setProperty(QStringLiteral("watts_lapmax"), dep.lapMax());
-        obj.setProperty(QStringLiteral("kgwatts"), (dep = device->wattKg()).value());
-        obj.setProperty(QStringLiteral("kgwatts_avg"), dep.average());
-        obj.setProperty(QStringLiteral("kgwatts_max"), dep.max());
+        obj.setProperty(QStringLiteral("watts_lapavg"), dep->lapAverage());
+        obj.setProperty(QStringLiteral("watts_max"), dep->max());
+        obj.setProperty(QStringLiteral("watts_lapmax"), dep->lapMax());
+        obj.setProperty(QStringLiteral("kgwatts"), (dep = &device->wattKg())->value());
+        obj.setProperty(QStringLiteral("kgwatts_avg"), dep->average());
+        obj.setProperty(QStringLiteral("kgwatts_max"), dep->max());
+        // the training load lives in homeform, which doesn't exist in the headless and console modes
+        if (homeform::singleton()) {
+            const trainingload &load = homeform::singleton()->trainingLoad();
+            obj.setProperty(QStringLiteral("np"), load.normalizedPower());
+            obj.setProperty(QStringLiteral("intensity_factor"), load.intensityFactor());
+            obj.setProperty(QStringLiteral("tss"), load.tss());
+            obj.setProperty(QStringLiteral("wbal"), load.wPrimeBalance());
+            obj.setProperty(QStringLiteral("wbal_perc"), load.wPrimeBalancePercentage());
+        }
         obj.setProperty(QStringLiteral("workoutName"), workoutName);
         obj.setProperty(QStringLiteral("workoutStartDate"), workoutStartDate);
         obj.setProperty(QStringLiteral("instructorName"), instructorName);
@@ -1068,28 +1077,28 @@ void TemplateInfoSenderBuilder::buildContext(bool forceReinit) {
             obj.setProperty(QStringLiteral("power_zone_color"), homeform::singleton()->ftp->valueFontColor());
             obj.setProperty(QStringLiteral("target_power_zone_color"), homeform::singleton()->target_zone->valueFontColor());
             obj.setProperty(QStringLiteral("peloton_resistance"),
-                            (dep = ((bike *)device)->pelotonResistance()).value());
-            obj.setProperty(QStringLiteral("peloton_resistance_avg"), dep.average());
+                            (dep = &((bike *)device)->pelotonResistance())->value());
+            obj.setProperty(QStringLiteral("peloton_resistance_avg"), dep->average());
             obj.setProperty(QStringLiteral("peloton_resistance_color"), homeform::singleton()->peloton_resistance->valueFontColor());
-            obj.setProperty(QStringLiteral("peloton_resistance_lapavg"), dep.lapAverage());
-            obj.setProperty(QStringLiteral("peloton_resistance_lapmax"), dep.lapMax());
+            obj.setProperty(QStringLiteral("peloton_resistance_lapavg"), dep->lapAverage());
+            obj.setProperty(QStringLiteral("peloton_resistance_lapmax"), dep->lapMax());
             obj.setProperty(QStringLiteral("peloton_req_resistance"),
-                            (dep = ((bike *)device)->lastRequestedPelotonResistance()).value());
-            obj.setProperty(QStringLiteral("cadence"), (dep = ((bike *)device)->currentCadence()).value());
+                            (dep = &((bike *)device)->lastRequestedPelotonResistance())->value());
+            obj.setProperty(QStringLiteral("cadence"), (dep = &((bike *)device)->currentCadence())->value());
             obj.setProperty(QStringLiteral("cadence_color"), homeform::singleton()->cadence->valueFontColor());
-            obj.setProperty(QStringLiteral("cadence_avg"), dep.average());
-            obj.setProperty(QStringLiteral("cadence_lapavg"), dep.lapAverage());
-            obj.setProperty(QStringLiteral("cadence_lapmax"), dep.lapMax());
-            obj.setProperty(QStringLiteral("resistance"), (dep = ((bike *)device)->currentResistance()).value());
-            obj.setProperty(QStringLiteral("resistance_avg"), dep.average());
-            obj.setProperty(QStringLiteral("resistance_lapavg"), dep.lapAverage());
-            obj.setProperty(QStringLiteral("resistance_lapmax"), dep.lapMax());
+            obj.setProperty(QStringLiteral("cadence_avg"), dep->average());
+            obj.setProperty(QStringLiteral("cadence_lapavg"), dep->lapAverage());
+            obj.setProperty(QStringLiteral("cadence_lapmax"), dep->lapMax());
+            obj.setProperty(QStringLiteral("resistance"), (dep = &((bike *)device)->currentResistance())->value());
+            obj.setProperty(QStringLiteral("resistance_avg"), dep->average());
+            obj.setProperty(QStringLiteral("resistance_lapavg"), dep->lapAverage());
+            obj.setProperty(QStringLiteral("resistance_lapmax"), dep->lapMax());
             obj.setProperty(QStringLiteral("cranks"), ((bike *)device)->currentCrankRevolutions());
             obj.setProperty(QStringLiteral("cranktime"), ((bike *)device)->lastCrankEventTime());
-            obj.setProperty(QStringLiteral("req_power"), (dep = ((bike *)device)->lastRequestedPower()).value());
-            obj.setProperty(QStringLiteral("req_cadence"), (dep = ((bike *)device)->lastRequestedCadence()).value());
+            obj.setProperty(QStringLiteral("req_power"), (dep = &((bike *)device)->lastRequestedPower())->value());
+            obj.setProperty(QStringLiteral("req_cadence"), (dep = &((bike *)device)->lastRequestedCadence())->value());
             obj.setProperty(QStringLiteral("req_resistance"),
-                            (dep = ((bike *)device)->lastRequestedResistance()).value());
+                            (dep = &((bike *)device)->lastRequestedResistance())->value());
         } else if (tp == bluetoothdevice::ROWING) {
             obj.setProperty(QStringLiteral("gears"), ((rower *)device)->gears());
             el = ((rower *)device)->lastRequestedPace();
@@ -1098,20 +1107,20 @@ void TemplateInfoSenderBuilder::buildContext(bool forceReinit) {
             obj.setProperty(QStringLiteral("target_pace_m"), el.minute());
             obj.setProperty(QStringLiteral("target_pace_h"), el.hour());
             obj.setProperty(QStringLiteral("peloton_resistance"),
-                            (dep = ((rower *)device)->pelotonResistance()).value());
-            obj.setProperty(QStringLiteral("peloton_resistance_avg"), dep.average());
-            obj.setProperty(QStringLiteral("cadence"), (dep = ((rower *)device)->currentCadence()).value());
+                            (dep = &((rower *)device)->pelotonResistance())->value());
+            obj.setProperty(QStringLiteral("peloton_resistance_avg"), dep->average());
+            obj.setProperty(QStringLiteral("cadence"), (dep = &((rower *)device)->currentCadence())->value());
             obj.setProperty(QStringLiteral("cadence_color"), homeform::singleton()->cadence->valueFontColor());
-            obj.setProperty(QStringLiteral("cadence_avg"), dep.average());
-            obj.setProperty(QStringLiteral("cadence_lapavg"), dep.lapAverage());
-            obj.setProperty(QStringLiteral("cadence_lapmax"), dep.lapMax());
+            obj.setProperty(QStringLiteral("cadence_avg"), dep->average());
+            obj.setProperty(QStringLiteral("cadence_lapavg"), dep->lapAverage());
+            obj.setProperty(QStringLiteral("cadence_lapmax"), dep->lapMax());
 
             // use to preserve compatibility to dochart.js and floating.htm
-            obj.setProperty(QStringLiteral("req_cadence"), (dep = ((rower *)device)->lastRequestedCadence()).value());
-            obj.setProperty(QStringLiteral("target_cadence"), (dep = ((rower *)device)->lastRequestedCadence()).value());
+            obj.setProperty(QStringLiteral("req_cadence"), (dep = &((rower *)device)->lastRequestedCadence())->value());
+            obj.setProperty(QStringLiteral("target_cadence"), (dep = &((rower *)device)->lastRequestedCadence())->value());
             
-            obj.setProperty(QStringLiteral("resistance"), (dep = ((rower *)device)->currentResistance()).value());
-            obj.setProperty(QStringLiteral("resistance_avg"), dep.average());
+            obj.setProperty(QStringLiteral("resistance"), (dep = &((rower *)device)->currentResistance())->value());
+            obj.setProperty(QStringLiteral("resistance_avg"), dep->average());
             obj.setProperty(QStringLiteral("cranks"), ((rower *)device)->currentCrankRevolutions());
             obj.setProperty(QStringLiteral("cranktime"), ((rower *)device)->lastCrankEventTime());
             obj.setProperty(QStringLiteral("strokescount"), ((rower *)device)->currentStrokesCount().value());
@@ -1124,30 +1133,30 @@ void TemplateInfoSenderBuilder::buildContext(bool forceReinit) {
             obj.setProperty(QStringLiteral("target_pace_h"), el.hour());
             obj.setProperty(QStringLiteral("target_inclination"),
                             ((treadmill *)device)->lastRequestedInclination().value());
-            obj.setProperty(QStringLiteral("cadence"), (dep = ((treadmill *)device)->currentCadence()).value());
+            obj.setProperty(QStringLiteral("cadence"), (dep = &((treadmill *)device)->currentCadence())->value());
             obj.setProperty(QStringLiteral("cadence_color"), homeform::singleton()->cadence->valueFontColor());
-            obj.setProperty(QStringLiteral("cadence_avg"), dep.average());
-            obj.setProperty(QStringLiteral("cadence_lapavg"), dep.lapAverage());
-            obj.setProperty(QStringLiteral("cadence_lapmax"), dep.lapMax());
-            obj.setProperty(QStringLiteral("inclination"), (dep = ((treadmill *)device)->currentInclination()).value());
-            obj.setProperty(QStringLiteral("inclination_avg"), dep.average());
-            obj.setProperty(QStringLiteral("inclination_lapavg"), dep.lapAverage());
-            obj.setProperty(QStringLiteral("inclination_lapmax"), dep.lapMax());
+            obj.setProperty(QStringLiteral("cadence_avg"), dep->average());
+            obj.setProperty(QStringLiteral("cadence_lapavg"), dep->lapAverage());
+            obj.setProperty(QStringLiteral("cadence_lapmax"), dep->lapMax());
+            obj.setProperty(QStringLiteral("inclination"), (dep = &((treadmill *)device)->currentInclination())->value());
+            obj.setProperty(QStringLiteral("inclination_avg"), dep->average());
+            obj.setProperty(QStringLiteral("inclination_lapavg"), dep->lapAverage());
+            obj.setProperty(QStringLiteral("inclination_lapmax"), dep->lapMax());
             obj.setProperty(QStringLiteral("stridelength"),
-                            (dep = ((treadmill *)device)->currentStrideLength()).value());
+                            (dep = &((treadmill *)device)->currentStrideLength())->value());
             obj.setProperty(QStringLiteral("groundcontact"),
-                            (dep = ((treadmill *)device)->currentGroundContact()).value());
+                            (dep = &((treadmill *)device)->currentGroundContact())->value());
             obj.setProperty(QStringLiteral("verticaloscillation"),
-                            (dep = ((treadmill *)device)->currentVerticalOscillation()).value());
+                            (dep = &((treadmill *)device)->currentVerticalOscillation())->value());
         } else if (tp == bluetoothdevice::ELLIPTICAL) {
-            obj.setProperty(QStringLiteral("cadence"), (dep = ((elliptical *)device)->currentCadence()).value());
+            obj.setProperty(QStringLiteral("cadence"), (dep = &((elliptical *)device)->currentCadence())->value());
             obj.setProperty(QStringLiteral("cadence_color"), homeform::singleton()->cadence->valueFontColor());
-            obj.setProperty(QStringLiteral("cadence_avg"), dep.average());
-            obj.setProperty(QStringLiteral("cadence_lapavg"), dep.lapAverage());
-            obj.setProperty(QStringLiteral("cadence_lapmax"), dep.lapMax());
+            obj.setProperty(QStringLiteral("cadence_avg"), dep->average());
+            obj.setProperty(QStringLiteral("cadence_lapavg"), dep->lapAverage());
+            obj.setProperty(QStringLiteral("cadence_lapmax"), dep->lapMax());
             obj.setProperty(QStringLiteral("inclination"),
-                            (dep = ((elliptical *)device)->currentInclination()).value());
-            obj.setProperty(QStringLiteral("inclination_avg"), dep.average());
+                            (dep = &((elliptical *)device)->currentInclination())->value());
+            obj.setProperty(QStringLiteral("inclination_avg"), dep->average());
         }
         if (!device->isPaused()) {
             sessionArray.append(QJsonObject::fromVariantMap(obj.toVariant().toMap()));
@@ -0,0 +1,61 @@
+#include "trainingload.h"
+#include <QtGlobal>
+#include <math.h>
+
+void trainingload::setThresholds(double ftp, double wPrime) {
+    if (ftp > 0) {
+        m_ftp = ftp;
+    }
+    if (wPrime > 0) {
+        if (m_count == 0 || m_wPrimeBalance > wPrime) {
+            m_wPrimeBalance = wPrime;
+        }
+        m_wPrime = wPrime;
+    }
+}
+
+void trainingload::append(double watt) {
+    if (watt < 0) {
+        watt = 0;
+    }
+    m_count++;
+
+    m_last30s.append(watt);
+    if (m_last30s.count() == m_last30s.capacity()) {
+        double avg = m_last30s.average(m_last30s.capacity());
+        m_sumFourthPower += avg * avg * avg * avg;
+        m_fourthPowerCount++;
+    }
+
+    // one sample is one second
+    if (watt > m_ftp) {
+        m_wPrimeBalance -= watt - m_ftp;
+    } else {
+        m_wPrimeBalance += (m_wPrime - m_wPrimeBalance) * (m_ftp - watt) / m_wPrime;
+    }
+    m_wPrimeBalance = qMin(m_wPrimeBalance, m_wPrime);
+}
+
+void trainingload::clear() {
+    m_last30s.clear();
+    m_sumFourthPower = 0;
+    m_fourthPowerCount = 0;
+    m_count = 0;
+    m_wPrimeBalance = m_wPrime;
+}
+
+double trainingload::normalizedPower() const {
+    if (m_fourthPowerCount == 0) {
+        return 0;
+    }
+    return pow(m_sumFourthPower / m_fourthPowerCount, 0.25);
+}
+
+double trainingload::intensityFactor() const { return normalizedPower() / m_ftp; }
+
+double trainingload::tss() const {
+    double np = normalizedPower();
+    return (m_count * np * intensityFactor()) / (m_ftp * 3600.0) * 100.0;
+}
+
+double trainingload::wPrimeBalancePercentage() const { return m_wPrimeBalance / m_wPrime * 100.0; }
@@ -0,0 +1,44 @@
+#ifndef TRAININGLOAD_H
+#define TRAININGLOAD_H
+
+#include "rollingwindow.h"
+
+/**
+ * @brief Training load of the current workout, updated once per sample (one sample per second, as the session
+ * lines) in O(1), without scanning the session:
+ * - normalized power: fourth root of the mean of the fourth power of the 30 seconds rolling average power;
+ * - intensity factor: normalized power / FTP;
+ * - TSS: seconds * NP * IF / (FTP * 3600) * 100;
+ * - W' balance: the differential model, W' is spent above the critical power (the FTP here) and recovered below it
+ *   proportionally to the distance from the critical power and to the W' already spent.
+ */
+class trainingload {
+  public:
+    /**
+     * @brief Sets the FTP (used as critical power too) and the W' in joules. It can be called at every sample,
+     * a change affects only the next samples.
+     */
+    void setThresholds(double ftp, double wPrime);
+
+    void append(double watt);
+    void clear();
+
+    int count() const { return m_count; }
+    double normalizedPower() const;
+    double intensityFactor() const;
+    double tss() const;
+    double wPrimeBalance() const { return m_wPrimeBalance; }
+    double wPrimeBalancePercentage() const;
+
+  private:
+    double m_ftp = 200;
+    double m_wPrime = 20000;
+
+    rollingwindow<30> m_last30s;
+    double m_sumFourthPower = 0;
+    int m_fourthPowerCount = 0;
+    int m_count = 0;
+    double m_wPrimeBalance = 20000;
+};
+
+#endif // TRAININGLOAD_H
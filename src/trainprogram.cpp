@@ -26,8 +26,8 @@ trainprogram::trainprogram(const QList<trainrow> &rows, bluetooth *b, QString *d
     bool treadmill_force_speed =
         settings.value(QZSettings::treadmill_force_speed, QZSettings::default_treadmill_force_speed).toBool();
     this->bluetoothManager = b;
-    this->rows = rows;
-    this->loadedRows = rows;
+    this->rows = rows.toVector();
+    this->loadedRows = this->rows;
     if (description)
         this->description = *description;
     if (tags)
@@ -179,6 +179,7 @@ void trainprogram::applySpeedFilter() {
     for (r = 0; r < rows.length(); r++) {
         rows[r].distance = newdistance.at(r);
     }
+    invalidateRowIndex();
 }
 
 uint32_t trainprogram::calculateTimeForRow(int32_t row) {
@@ -189,12 +190,75 @@ uint32_t trainprogram::calculateTimeForRow(int32_t row) {
         return (rows.at(row).duration.second() + (rows.at(row).duration.minute() * 60) +
                 (rows.at(row).duration.hour() * 3600));
     else {
-        if(rows.at(row).started.isValid() && rows.at(row).ended.isValid())
-            return rows.at(row).started.secsTo(rows.at(row).ended);
+        if (row < rowEnded.length() && rowStarted.at(row) && rowEnded.at(row))
+            return (rowEnded.at(row) - rowStarted.at(row)) / 1000;
     }
     return 0;
 }
 
+void trainprogram::buildRowIndex() {
+    rowTime.reset(rows.length());
+    nextDistanceRow.resize(rows.length() + 1);
+    nextDistanceRow[rows.length()] = rows.length();
+    rowsDuration = 0;
+    rowsDistance = 0;
+    bool distanceAvailable = true;
+    next100MetersAvg.fill(0, rows.length());
+    next100MetersKm.fill(0, rows.length());
+    next100MetersRows.fill(0, rows.length());
+
+    for (int32_t i = rows.length() - 1; i >= 0; i--) {
+        nextDistanceRow[i] = calculateDistanceForRow(i) > 0 ? i : nextDistanceRow.at(i + 1);
+    }
+    for (int32_t i = 0; i < rows.length(); i++) {
+        const trainrow &row = rows.at(i);
+        rowTime.set(i, calculateTimeForRow(i));
+
+        uint32_t seconds = (row.duration.hour() * 3600) + (row.duration.minute() * 60) + row.duration.second();
+        rowsDuration += seconds;
+        if (seconds && distanceAvailable) {
+            if (!row.forcespeed) {
+                distanceAvailable = false;
+            } else {
+                rowsDistance += seconds * (row.speed / 3600);
+            }
+        }
+    }
+    if (!distanceAvailable) {
+        rowsDistance = -1;
+    }
+    rowIndexValid = true;
+}
+
+void trainprogram::setRowStarted(int32_t row) {
+    if (row >= rows.length())
+        return;
+    if (rowStarted.length() != rows.length()) {
+        rowStarted.resize(rows.length());
+        rowEnded.resize(rows.length());
+    }
+    rowStarted[row] = QDateTime::currentMSecsSinceEpoch();
+    updateRowTime(row);
+}
+
+void trainprogram::setRowEnded(int32_t row) {
+    if (row >= rows.length())
+        return;
+    if (rowEnded.length() != rows.length()) {
+        rowStarted.resize(rows.length());
+        rowEnded.resize(rows.length());
+    }
+    rowEnded[row] = QDateTime::currentMSecsSinceEpoch();
+    updateRowTime(row);
+}
+
+void trainprogram::updateRowTime(int32_t row) {
+    // the time of a distance row is known once it's started and ended
+    if (rowIndexValid && row < rowTime.size()) {
+        rowTime.set(row, calculateTimeForRow(row));
+    }
+}
+
 double trainprogram::calculateDistanceForRow(int32_t row) {
     if (row >= rows.length())
         return 0;
@@ -438,35 +502,49 @@ double trainprogram::weightedInclination(int step) {
     return (inc / sumweights);
 }
 
-double trainprogram::avgInclinationNext100Meters(int step) {
+// the rows from step covering the next 100 meters: weighted inclination sum, km and number of rows
+int trainprogram::sumInclinationNext100Meters(int step, double *avg, double *km) {
     int c = step;
+    int sum = 0;
+    *km = 0;
+    *avg = 0;
+
+    while (c < rows.length()) {
+        if (*km > 0.1) {
+            break;
+        }
+        if (c == currentStep)
+            *km += (rows.at(c).distance - currentStepDistance);
+        else
+            *km += (rows.at(c).distance);
+        *avg += rows.at(c).inclination * rows.at(c).distance;
+        sum++;
+        c++;
+    }
+    return sum;
+}
+
+double trainprogram::avgInclinationNext100Meters(int step) {
     double km = 0;
     double avg = 0;
     int sum = 0;
 
-    while (1) {
-        if (c < rows.length()) {
-            if (km > 0.1) {
-                if (sum == 1) {
-                    return rows.at(currentStep).inclination;
-                }
-                return avg / (double)km;
-            }
-            if (c == currentStep)
-                km += (rows.at(c).distance - currentStepDistance);
-            else
-                km += (rows.at(c).distance);
-            avg += rows.at(c).inclination * rows.at(c).distance;
-            sum++;
-
-        } else {
-            if (sum == 1) {
-                return rows.at(currentStep).inclination;
-            }
-            return avg / (double)km;
+    if (step > currentStep && step < rows.length()) {
+        // avgInclinationNext300Meters asks for every row in the next 300 meters on every step: the windows of the
+        // rows ahead are computed once
+        if (!rowIndexValid) {
+            buildRowIndex();
         }
-        c++;
+        if (next100MetersRows.at(step) == 0) {
+            next100MetersRows[step] = sumInclinationNext100Meters(step, &next100MetersAvg[step], &next100MetersKm[step]);
+        }
+        avg = next100MetersAvg.at(step);
+        km = next100MetersKm.at(step);
+        sum = next100MetersRows.at(step);
+    } else {
+        sum = sumInclinationNext100Meters(step, &avg, &km);
     }
+
     if (sum == 1) {
         return rows.at(currentStep).inclination;
     }
@@ -519,6 +597,9 @@ double trainprogram::avgAzimuthNext300Meters() {
 void trainprogram::clearRows() {
     QMutexLocker(&this->schedulerMutex);
     rows.clear();
+    rowStarted.clear();
+    rowEnded.clear();
+    invalidateRowIndex();
 }
 
 void trainprogram::pelotonOCRprocessPendingDatagrams() {
@@ -607,8 +688,9 @@ void trainprogram::scheduler() {
         if(bluetoothManager->device() && (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL || bluetoothManager->device()->deviceType() == bluetoothdevice::ELLIPTICAL) &&
            settings.value(QZSettings::zwift_username, QZSettings::default_zwift_username).toString().length() > 0 && zwift_auth_token &&
            zwift_auth_token->access_token.length() > 0) {
-            if(!zwift_world) {
-                zwift_world = new World(1, zwift_auth_token->getAccessToken());
+            if(!zwift_api) {
+                zwift_api = new ZwiftApiPoller(1, zwift_auth_token->getAccessToken(), ZwiftRequest::DEFAULT_BASE_URL, this);
+                connect(zwift_api, &ZwiftApiPoller::loggedIn, this, [this]() { emit zwiftLoginState(true); });
                 qDebug() << "creating zwift api world";
             }
             else {
@@ -618,14 +700,9 @@ void trainprogram::scheduler() {
                     h = new lockscreen();
 #endif
 #endif
-                if(zwift_player_id == -1) {
-                    QString id = zwift_world->player_id();
-                    QJsonParseError parseError;
-                    QJsonDocument document = QJsonDocument::fromJson(id.toLocal8Bit(), &parseError);
-                    QJsonObject ride = document.object();
-                    qDebug() << "zwift api player" << ride;
-                    zwift_player_id = ride[QStringLiteral("id")].toInt();
-                    emit zwiftLoginState(true);
+                // the requests run in the background, the state received since the last tick is handled here
+                if(zwift_api->playerId() == -1) {
+                    zwift_api->poll();
                 } else {                    
                     static int zwift_counter = 5;
                     int timeout = settings.value(QZSettings::zwift_api_poll, QZSettings::default_zwift_api_poll).toInt();
@@ -633,7 +710,10 @@ void trainprogram::scheduler() {
                         timeout = 5;
                     if(zwift_counter++ >= (timeout - 1)) {
                         zwift_counter = 0;
-                        QByteArray bb = zwift_world->playerStatus(zwift_player_id);
+                        zwift_api->poll();
+                    }
+                    QByteArray bb;
+                    if(zwift_api->takePlayerState(&bb)) {
                         qDebug() << " ZWIFT API PROTOBUF << " + bb.toHex(' ');
 #ifdef Q_OS_IOS
 #ifndef IO_UNDER_QT
@@ -837,7 +917,7 @@ void trainprogram::scheduler() {
 
     // entry point
     if (ticks == 1 && currentStep == 0) {
-        rows[currentStep].started = QDateTime::currentDateTime();
+        setRowStarted(currentStep);
         currentStepDistance = 0;
         lastOdometer = odometerFromTheDevice;
         if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL) {
@@ -941,21 +1021,15 @@ void trainprogram::scheduler() {
     qDebug() << QStringLiteral("trainprogram elapsed ") + QString::number(ticks) + QStringLiteral("current row len") +
                     QString::number(currentRowLen);
 
-    uint32_t calculatedLine;
-    uint32_t calculatedElapsedTime = 0;
-    for (calculatedLine = 0; calculatedLine < static_cast<uint32_t>(rows.length()); calculatedLine++) {
-
-        calculatedElapsedTime += calculateTimeForRow(calculatedLine);
-        
-        if (calculateDistanceForRow(calculatedLine) > 0 && calculatedLine >= currentStep) {
-            break;
-        }
-
-        if (calculatedElapsedTime > static_cast<uint32_t>(ticks) && calculatedLine >= currentStep) {
-            break;
-        }
+    if (!rowIndexValid) {
+        buildRowIndex();
     }
 
+    // the first row from the current one that is a distance row or that ends after the elapsed time
+    uint32_t calculatedLine = std::min<uint32_t>(
+        nextDistanceRow.at(currentStep < rows.length() ? currentStep : rows.length()),
+        std::max<uint32_t>(currentStep, rowTime.upperBound(static_cast<uint32_t>(ticks))));
+
     bool distanceEvaluation = false;
     int sameIteration = 0;
 
@@ -976,7 +1050,7 @@ void trainprogram::scheduler() {
                 if(rows.at(currentStep).distance != -1)
                     lastOdometer -= (currentStepDistance - rows.at(currentStep).distance);
 
-                rows[currentStep].ended = QDateTime::currentDateTime();
+                setRowEnded(currentStep);
 
                 if (!distanceStep)
                     currentStep = calculatedLine;
@@ -985,7 +1059,7 @@ void trainprogram::scheduler() {
 
                 calculatedLine = currentStep;
 
-                rows[currentStep].started = QDateTime::currentDateTime();
+                setRowStarted(currentStep);
 
                 currentStepDistance = 0;
                 if (bluetoothManager->device()->deviceType() == bluetoothdevice::TREADMILL) {
@@ -1130,8 +1204,8 @@ void trainprogram::scheduler() {
                 qDebug() << QStringLiteral("trainprogram ends!");
 
                 // circuit?
-                if (!isnan(rows.first().latitude) && !isnan(rows.first().longitude) &&
-                    QGeoCoordinate(rows.first().latitude, rows.first().longitude)
+                if (!isnan(rows.constFirst().latitude) && !isnan(rows.constFirst().longitude) &&
+                    QGeoCoordinate(rows.constFirst().latitude, rows.constFirst().longitude)
                             .distanceTo(bluetoothManager->device()->currentCordinate()) < 50) {
                     emit lap();
                     restart();
@@ -1214,6 +1288,7 @@ bool trainprogram::overridePowerForCurrentRow(double power) {
     if (started && currentStep < rows.length() && currentRow().power != -1) {
         qDebug() << "overriding power from" << rows.at(currentStep).power << "to" << power;
         rows[currentStep].power = power;
+        invalidateRowIndex();
         return true;
     }
     return false;
@@ -1349,7 +1424,7 @@ bool trainprogram::saveXML(const QString &filename, const QList<trainrow> &rows)
         return false;
 }
 
-void trainprogram::save(const QString &filename) { saveXML(filename, rows); }
+void trainprogram::save(const QString &filename) { saveXML(filename, rows.toList()); }
 
 trainprogram *trainprogram::load(const QString &filename, bluetooth *b, QString Extension) {
     if (!Extension.toUpper().compare(QStringLiteral("ZWO"))) {
@@ -1587,19 +1662,21 @@ QList<trainrow> trainprogram::loadXML(const QString &filename, bluetoothdevice::
 
 QTime trainprogram::totalElapsedTime() { return QTime(0, 0, ticks); }
 
-trainrow trainprogram::currentRow() {
+const trainrow &trainprogram::currentRow() {
+    static const trainrow empty;
     if (started && !rows.isEmpty()) {
 
         return rows.at(currentStep);
     }
-    return trainrow();
+    return empty;
 }
 
-trainrow trainprogram::getRowFromCurrent(uint32_t offset) {
+const trainrow &trainprogram::getRowFromCurrent(uint32_t offset) {
+    static const trainrow empty;
     if (started && !rows.isEmpty() && (currentStep + offset) < (uint32_t)rows.length()) {
         return rows.at(currentStep + offset);
     }
-    return trainrow();
+    return empty;
 }
 
 double trainprogram::currentTargetMets() {
@@ -1610,34 +1687,27 @@ double trainprogram::currentTargetMets() {
 }
 
 QTime trainprogram::currentRowElapsedTime() {
-    uint32_t calculatedLine;
-    uint32_t calculatedElapsedTime = 0;
-
     if (rows.length() == 0)
         return QTime(0, 0, 0);
 
-    for (calculatedLine = 0; calculatedLine < static_cast<uint32_t>(rows.length()); calculatedLine++) {
+    if (!rowIndexValid) {
+        buildRowIndex();
+    }
 
-        uint32_t currentLine = calculateTimeForRow(calculatedLine);
-        calculatedElapsedTime += currentLine;
+    int32_t calculatedLine = rowTime.upperBound(static_cast<uint32_t>(ticks));
+    if (calculatedLine < rows.length()) {
         uint32_t rampElapsed = 0;
-
-        if (calculatedElapsedTime > static_cast<uint32_t>(ticks)) {
-            if (rows.at(calculatedLine).rampElapsed != QTime(0, 0, 0)) {
-                rampElapsed = (rows.at(calculatedLine).rampElapsed.second() +
-                               (rows.at(calculatedLine).rampElapsed.minute() * 60) +
-                               (rows.at(calculatedLine).rampElapsed.hour() * 3600));
-            }
-            return QTime(0, 0, 0).addSecs(rampElapsed + ticks - (calculatedElapsedTime - currentLine));
+        if (rows.at(calculatedLine).rampElapsed != QTime(0, 0, 0)) {
+            rampElapsed = (rows.at(calculatedLine).rampElapsed.second() +
+                           (rows.at(calculatedLine).rampElapsed.minute() * 60) +
+                           (rows.at(calculatedLine).rampElapsed.hour() * 3600));
         }
+        return QTime(0, 0, 0).addSecs(rampElapsed + ticks - rowTime.prefix(calculatedLine));
     }
     return QTime(0, 0, 0);
 }
 
 QTime trainprogram::currentRowRemainingTime() {
-    uint32_t calculatedLine;
-    uint32_t calculatedElapsedTime = 0;
-
     if (rows.length() == 0)
         return QTime(0, 0, 0);
 
@@ -1650,61 +1720,47 @@ QTime trainprogram::currentRowRemainingTime() {
         int hours = seconds / 3600;
         return QTime(hours, (seconds / 60) - (hours * 60), seconds % 60);
     } else {
-        for (calculatedLine = 0; calculatedLine < static_cast<uint32_t>(rows.length()); calculatedLine++) {
-
-            uint32_t currentLine = calculateTimeForRow(calculatedLine);
-            calculatedElapsedTime += currentLine;
+        if (!rowIndexValid) {
+            buildRowIndex();
+        }
 
-            if (calculatedElapsedTime > static_cast<uint32_t>(ticks)) {
-                if (rows.at(calculatedLine).rampDuration != QTime(0, 0, 0)) {
-                    calculatedElapsedTime += ((rows.at(calculatedLine).rampDuration.second() +
-                                               (rows.at(calculatedLine).rampDuration.minute() * 60) +
-                                               (rows.at(calculatedLine).rampDuration.hour() * 3600))) -
-                                             1;
-                }
-                int seconds = calculatedElapsedTime - ticks;
-                int hours = seconds / 3600;
-                return QTime(hours, (seconds / 60) - (hours * 60), seconds % 60);
-            }
+        int32_t calculatedLine = rowTime.upperBound(static_cast<uint32_t>(ticks));
+        if (calculatedLine < rows.length()) {
+            uint64_t calculatedElapsedTime = rowTime.prefix(calculatedLine + 1);
+            if (rows.at(calculatedLine).rampDuration != QTime(0, 0, 0)) {
+                calculatedElapsedTime += ((rows.at(calculatedLine).rampDuration.second() +
+                                           (rows.at(calculatedLine).rampDuration.minute() * 60) +
+                                           (rows.at(calculatedLine).rampDuration.hour() * 3600))) -
+                                         1;
+            }
+            int seconds = calculatedElapsedTime - ticks;
+            int hours = seconds / 3600;
+            return QTime(hours, (seconds / 60) - (hours * 60), seconds % 60);
         }
     }
     return QTime(0, 0, 0);
 }
 
 QTime trainprogram::remainingTime() {
-    uint32_t calculatedLine;
-    uint32_t calculatedTotalTime = 0;
-
     if (rows.length() == 0)
         return QTime(0, 0, 0);
 
-    for (calculatedLine = 0; calculatedLine < static_cast<uint32_t>(rows.length()); calculatedLine++) {
-        calculatedTotalTime += calculateTimeForRow(calculatedLine);
+    if (!rowIndexValid) {
+        buildRowIndex();
     }
-    return QTime(0, 0, 0).addSecs(calculatedTotalTime - ticks);
+    return QTime(0, 0, 0).addSecs(rowTime.total() - ticks);
 }
 
 QTime trainprogram::duration() {
-
-    QTime total(0, 0, 0, 0);
-    for (const trainrow &row : qAsConst(rows)) {
-        total = total.addSecs((row.duration.hour() * 3600) + (row.duration.minute() * 60) + row.duration.second());
+    if (!rowIndexValid) {
+        buildRowIndex();
     }
-    return total;
+    return QTime(0, 0, 0, 0).addSecs(rowsDuration % 86400);
 }
 
 double trainprogram::totalDistance() {
-
-    double distance = 0;
-    for (const trainrow &row : qAsConst(rows)) {
-        if (row.duration.hour() || row.duration.minute() || row.duration.second()) {
-            if (!row.forcespeed) {
-
-                return -1;
-            }
-            distance += ((row.duration.hour() * 3600) + (row.duration.minute() * 60) + row.duration.second()) *
-                        (row.speed / 3600);
-        }
+    if (!rowIndexValid) {
+        buildRowIndex();
     }
-    return distance;
+    return rowsDistance;
 }
@@ -1,29 +1,36 @@
 #ifndef TRAINPROGRAM_H
 #define TRAINPROGRAM_H
 #include "bluetooth.h"
+#include "fenwicktree.h"
 #include <QGeoCoordinate>
 #include <QMutex>
 #include <QObject>
 #include <QSet>
 #include <QTime>
 #include <QTimer>
+#include <QVector>
 
 #ifdef Q_OS_IOS
 #include "ios/lockscreen.h"
 #endif
 
 #include "zwift-api/PlayerStateWrapper.h"
+#include "zwift-api/zwift_api_poller.h"
 #include "zwift-api/zwift_client_auth.h"
 
 #ifdef Q_CC_MSVC
 #include "zwift-api/zwift_messages.pb.h"
 #endif
 
+/**
+ * @brief A step of a train program.
+ *
+ * The fields are grouped by size so a row doesn't carry padding: GPX programs have tens of thousands of rows. The
+ * time a row was started and ended at is runtime state of the trainprogram, not of the row, so running a program
+ * doesn't write in its rows.
+ */
 class trainrow {
   public:
-    QTime duration = QTime(0, 0, 0, 0);
-    QDateTime started = QDateTime();
-    QDateTime ended = QDateTime();
     double distance = -1;
     double speed = -1;
     double lower_speed = -1;   // used for peloton
@@ -34,37 +41,40 @@ class trainrow {
     double lower_inclination = -200;   // used for peloton
     double average_inclination = -200; // used for peloton
     double upper_inclination = -200;   // used for peloton
+    double maxSpeed = -1;
+    double minSpeed = -1;
+    // the position of a GPX row. It isn't moved to a side table: the programs with many rows are the GPX ones, where
+    // every row has a position, so a side table would take the same memory
+    double latitude = NAN;
+    double longitude = NAN;
+    double altitude = NAN;
+    double azimuth = NAN;
+    QTime duration = QTime(0, 0, 0, 0);
+    QTime rampDuration = QTime(0, 0, 0, 0); // QZ split the ramp in 1 second segments. This field will tell you how long
+                                            // is the ramp from this very moment
+    QTime rampElapsed = QTime(0, 0, 0, 0);
+    QTime gpxElapsed = QTime(0, 0, 0, 0);
+    int32_t power = -1;
+    int32_t mets = -1;
     resistance_t resistance = -1;
     resistance_t lower_resistance = -1;
     resistance_t average_resistance = -1; // used for peloton
     resistance_t upper_resistance = -1;
+    int16_t cadence = -1;
+    int16_t lower_cadence = -1;
+    int16_t average_cadence = -1; // used for peloton
+    int16_t upper_cadence = -1;
+    int16_t HRmin = -1;
+    int16_t HRmax = -1;
     int8_t requested_peloton_resistance = -1;
     int8_t lower_requested_peloton_resistance = -1;
     int8_t average_requested_peloton_resistance = -1; // used for peloton
     int8_t upper_requested_peloton_resistance = -1;
     int8_t pace_intensity = -1; // used for peloton
-    int16_t cadence = -1;
-    int16_t lower_cadence = -1;
-    int16_t average_cadence = -1; // used for peloton
-    int16_t upper_cadence = -1;
-    bool forcespeed = false;
     int8_t loopTimeHR = 10;
     int8_t zoneHR = -1;
-    int16_t HRmin = -1;
-    int16_t HRmax = -1;
-    double maxSpeed = -1;
-    double minSpeed = -1;
     int8_t maxResistance = -1;
-    int32_t power = -1;
-    int32_t mets = -1;
-    QTime rampDuration = QTime(0, 0, 0, 0); // QZ split the ramp in 1 second segments. This field will tell you how long
-                                            // is the ramp from this very moment
-    QTime rampElapsed = QTime(0, 0, 0, 0);
-    QTime gpxElapsed = QTime(0, 0, 0, 0);
-    double latitude = NAN;
-    double longitude = NAN;
-    double altitude = NAN;
-    double azimuth = NAN;
+    bool forcespeed = false;
     QString toString() const;
 };
 
@@ -85,8 +95,9 @@ class trainprogram : public QObject {
     double currentTargetMets();
     QTime duration();
     double totalDistance();
-    trainrow currentRow();
-    trainrow getRowFromCurrent(uint32_t offset);
+    // the reference is valid until the rows are edited
+    const trainrow &currentRow();
+    const trainrow &getRowFromCurrent(uint32_t offset);
     void increaseElapsedTime(uint32_t i);
     void decreaseElapsedTime(uint32_t i);
     int32_t offsetElapsedTime() { return offset; }
@@ -98,14 +109,15 @@ class trainprogram : public QObject {
     double medianInclination(int step);
     bool overridePowerForCurrentRow(double power);
     bool powerzoneWorkout() {
-        foreach(trainrow r, rows) {
+        for (const trainrow &r : qAsConst(rows)) {
             if(r.power != -1) return true;
         }
         return false;
     }
 
-    QList<trainrow> rows;
-    QList<trainrow> loadedRows; // rows as loaded
+    // rows shares the storage of loadedRows until it is edited
+    QVector<trainrow> rows;
+    QVector<trainrow> loadedRows; // rows as loaded
     QString description = "";
     QString tags = "";
     bool enabled = true;
@@ -118,6 +130,9 @@ class trainprogram : public QObject {
 
     void applySpeedFilter();
 
+    // to be called after editing rows from outside: the row index is rebuilt on the next lookup
+    void invalidateRowIndex() { rowIndexValid = false; }
+
   public slots:
     void onTapeStarted();
     void scheduler();
@@ -144,14 +159,36 @@ private slots:
     void zwiftLoginState(bool ok);
 
   private:
+    // the look-ahead tests move the position in the route without running the scheduler
+    friend class TrainProgramTestSuite;
+
     mutable QRecursiveMutex schedulerMutex;
     double avgAzimuthNext300Meters();
     QList<MetersByInclination> inclinationNext300Meters();
     QList<MetersByInclination> avgInclinationNext300Meters();
     double avgInclinationNext100Meters(int step);
+    int sumInclinationNext100Meters(int step, double *avg, double *km);
     uint32_t calculateTimeForRow(int32_t row);
     uint32_t calculateTimeForRowMergingRamps(int32_t row);
     double calculateDistanceForRow(int32_t row);
+
+    // cumulative time of the rows, with the totals that only change when the rows are edited
+    void buildRowIndex();
+    void updateRowTime(int32_t row);
+    bool rowIndexValid = false;
+    fenwicktree rowTime;
+    QVector<int32_t> nextDistanceRow;
+    uint64_t rowsDuration = 0;
+    double rowsDistance = 0;
+    // avgInclinationNext100Meters of the rows after the current one, they don't depend on the current step
+    QVector<double> next100MetersAvg;
+    QVector<double> next100MetersKm;
+    QVector<int32_t> next100MetersRows;
+    // msecs since epoch each row was started and ended at, 0 if it wasn't
+    void setRowStarted(int32_t row);
+    void setRowEnded(int32_t row);
+    QVector<qint64> rowStarted;
+    QVector<qint64> rowEnded;
     bluetooth *bluetoothManager;
     bool started = false;
     int32_t ticks = 0;
@@ -171,8 +208,7 @@ private slots:
     void pelotonOCRcomputeTime(QString t);
     
     AuthToken* zwift_auth_token = nullptr;
-    World* zwift_world = nullptr;
-    int zwift_player_id = -1;
+    ZwiftApiPoller* zwift_api = nullptr;
     
 #ifdef Q_OS_IOS
     lockscreen *h = 0;
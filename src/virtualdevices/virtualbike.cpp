@@ -1,5 +1,7 @@
 #include "virtualdevices/virtualbike.h"
+#include "qzlog.h"
 #include "devices/bike.h"
+#include "qzsettingssnapshot.h"
 
 #include <QDataStream>
 #include <QMetaEnum>
@@ -444,11 +446,11 @@ virtualbike::virtualbike(bluetoothdevice *t, bool noWriteResistance, bool noHear
     }
 
     //! [Provide Heartbeat]
-    QObject::connect(&bikeTimer, &QTimer::timeout, this, &virtualbike::bikeProvider);
+    QObject::connect(&notifyScheduler, &virtualnotifyscheduler::provide, this, &virtualbike::bikeProvider);
     if (settings.value(QZSettings::race_mode, QZSettings::default_race_mode).toBool())
-        bikeTimer.start(100ms);
+        notifyScheduler.start(Bike, 100ms);
     else
-        bikeTimer.start(1s);
+        notifyScheduler.start(Bike, 1s);
 
     //! [Provide Heartbeat]
     QObject::connect(leController, &QLowEnergyController::disconnected, this, &virtualbike::reconnect);
@@ -460,17 +462,17 @@ virtualbike::virtualbike(bluetoothdevice *t, bool noWriteResistance, bool noHear
 
 void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characteristic, const QByteArray &newValue) {
     QByteArray reply;
-    QSettings settings;
-    bool echelon =
-        settings.value(QZSettings::virtual_device_echelon, QZSettings::default_virtual_device_echelon).toBool();
-    bool ifit = settings.value(QZSettings::virtual_device_ifit, QZSettings::default_virtual_device_ifit).toBool();
+    const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
+    bool echelon = snapshot.virtual_device_echelon;
+    bool ifit = snapshot.virtual_device_ifit;
 
     double normalizeWattage = Bike->wattsMetric().value();
     if (normalizeWattage < 0)
         normalizeWattage = 0;
 
-    qDebug() << QStringLiteral("characteristicChanged ") + QString::number(characteristic.uuid().toUInt16()) +
-                    QStringLiteral(" ") + newValue.toHex(' ');
+    qCDebug(qzVirtualDevices) << QStringLiteral("characteristicChanged ") +
+                                     QString::number(characteristic.uuid().toUInt16()) + QStringLiteral(" ") +
+                                     newValue.toHex(' ');
 
     if (!echelon && !ifit) {
         lastFTMSFrameReceived = QDateTime::currentMSecsSinceEpoch();
@@ -486,7 +488,7 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
                 serviceFIT->characteristic((QBluetoothUuid::CharacteristicType)0x2AD9);
             Q_ASSERT(characteristic.isValid());
             if (leController->state() != QLowEnergyController::ConnectedState) {
-                qDebug() << QStringLiteral("virtual bike not connected");
+                qCDebug(qzVirtualDevices) << QStringLiteral("virtual bike not connected");
 
                 return;
             }
@@ -502,7 +504,7 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
 
         Q_ASSERT(characteristic.isValid());
         if (leController->state() != QLowEnergyController::ConnectedState) {
-            qDebug() << QStringLiteral("virtual bike not connected");
+            qCDebug(qzVirtualDevices) << QStringLiteral("virtual bike not connected");
 
             return;
         }
@@ -523,7 +525,7 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
         if (answer_13) {
             answer_13 = false;
 
-            qDebug() << "ifit ans 13";
+            qCDebug(qzVirtualDevices) << "ifit ans 13";
             reply1 = QByteArray::fromHex("fe020a02000000000000001bffffffffffffffff");
             reply2 = QByteArray::fromHex("ff0a010402060706900208a7ffffffffffffffff");
 
@@ -531,7 +533,7 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
             writeCharacteristic(service, characteristic, reply2);
         } else if (newValue.length() > 8 && ((uint8_t)newValue.at(0)) == 0xFF && ((uint8_t)newValue.at(8)) == 0x81) {
             // equipment information
-            qDebug() << "ifit ans 1";
+            qCDebug(qzVirtualDevices) << "ifit ans 1";
             reply1 = QByteArray::fromHex("fe02210340ff7b81600080dfbf1404fffb4808b7");
             reply2 = QByteArray::fromHex("00120104021d071d810253010300000000000fbc");
             reply3 = QByteArray::fromHex("ff0fbcfdc3fcffca94e707c0c0d118180d000fbc");
@@ -539,7 +541,7 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
             writeCharacteristic(service, characteristic, reply2);
             writeCharacteristic(service, characteristic, reply3);
         } else if (newValue.length() > 8 && ((uint8_t)newValue.at(0)) == 0xFF && ((uint8_t)newValue.at(8)) == 0x80) {
-            qDebug() << "ifit ans 2";
+            qCDebug(qzVirtualDevices) << "ifit ans 2";
             reply1 = QByteArray::fromHex("fe021303c3fcffca94e707c0c0d118180d000fbc");
             reply2 = QByteArray::fromHex("00120104020f070f8002094c4745434d4e464f41");
             reply3 = QByteArray::fromHex("ff012d04020f070f8002094c4745434d4e464f41");
@@ -547,13 +549,13 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
             writeCharacteristic(service, characteristic, reply2);
             writeCharacteristic(service, characteristic, reply3);
         } else if (newValue.length() > 8 && ((uint8_t)newValue.at(0)) == 0xFF && ((uint8_t)newValue.at(8)) == 0x88) {
-            qDebug() << "ifit ans 3";
+            qCDebug(qzVirtualDevices) << "ifit ans 3";
             reply1 = QByteArray::fromHex("fe021102020f070f8002094c4745434d4e464f41");
             reply2 = QByteArray::fromHex("ff110104020d070d880209829083718984954f41");
             writeCharacteristic(service, characteristic, reply1);
             writeCharacteristic(service, characteristic, reply2);
         } else if (newValue.length() > 8 && ((uint8_t)newValue.at(0)) == 0xFF && ((uint8_t)newValue.at(8)) == 0x82) {
-            qDebug() << "ifit ans 4";
+            qCDebug(qzVirtualDevices) << "ifit ans 4";
             reply1 = QByteArray::fromHex("fe022504020d070d880209829083718984954f41");
             reply2 = QByteArray::fromHex("00120104022107218202640001aff900002b5706");
             reply3 = QByteArray::fromHex("01120056002ae8030024f400f401000001020000");
@@ -563,7 +565,7 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
             writeCharacteristic(service, characteristic, reply3);
             writeCharacteristic(service, characteristic, reply4);
         } else if (newValue.length() > 8 && ((uint8_t)newValue.at(0)) == 0xFF && ((uint8_t)newValue.at(8)) == 0x84) {
-            qDebug() << "ifit ans 5";
+            qCDebug(qzVirtualDevices) << "ifit ans 5";
             reply1 = QByteArray::fromHex("fe022003002ae8030024f400f401000001020000");
             reply2 = QByteArray::fromHex("00120104021c071c8402539600302e312e303631");
             reply3 = QByteArray::fromHex("ff0e32323031372e30393038012a030f2e303631");
@@ -571,7 +573,7 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
             writeCharacteristic(service, characteristic, reply2);
             writeCharacteristic(service, characteristic, reply3);
         } else if (newValue.length() > 8 && ((uint8_t)newValue.at(0)) == 0xFF && ((uint8_t)newValue.at(8)) == 0x95) {
-            qDebug() << "ifit ans 6";
+            qCDebug(qzVirtualDevices) << "ifit ans 6";
             reply1 = QByteArray::fromHex("fe021c033031372e30393038012a030f2e303631");
             reply2 = QByteArray::fromHex("00120104021807189502123431373131302d4e4e");
             reply3 = QByteArray::fromHex("ff0a32335a313130313737af31373131302d4e4e");
@@ -579,7 +581,7 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
             writeCharacteristic(service, characteristic, reply2);
             writeCharacteristic(service, characteristic, reply3);
         } else if (newValue.length() > 8 && ((uint8_t)newValue.at(0)) == 0xFF && ((uint8_t)newValue.at(8)) == 0x5d) {
-            qDebug() << "ifit ans 7";
+            qCDebug(qzVirtualDevices) << "ifit ans 7";
             reply1 = QByteArray::fromHex("fe02240302060706900208a731373131302d4e4e");
             reply2 = QByteArray::fromHex("0012010402200720020202701750001e00780000");
             reply3 = QByteArray::fromHex("ff12104c2c2c010000000000000000b400000003");
@@ -588,26 +590,26 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
             writeCharacteristic(service, characteristic, reply3);
         } else if (newValue.length() > 9 && ((uint8_t)newValue.at(0)) == 0xFF && ((uint8_t)newValue.at(8)) == 0x00 &&
                    ((uint8_t)newValue.at(9)) == 0xd1) {
-            qDebug() << "ifit ans 8";
+            qCDebug(qzVirtualDevices) << "ifit ans 8";
             reply1 = QByteArray::fromHex("fe020a025a313130313737af31373131302d4e4e");
             reply2 = QByteArray::fromHex("ff0a010402060706900208a731373131302d4e4e");
             writeCharacteristic(service, characteristic, reply1);
             writeCharacteristic(service, characteristic, reply2);
         } else if (newValue.length() > 9 && ((uint8_t)newValue.at(0)) == 0xFF && ((uint8_t)newValue.at(8)) == 0x00 &&
                    ((uint8_t)newValue.at(3)) == 0x80) {
-            qDebug() << "ifit ans 9";
+            qCDebug(qzVirtualDevices) << "ifit ans 9";
             reply1 = QByteArray::fromHex("fe0209020205070502021000000000b400000003");
             reply2 = QByteArray::fromHex("ff0901040205070502021000000000b400000003");
             writeCharacteristic(service, characteristic, reply1);
             writeCharacteristic(service, characteristic, reply2);
         } else if (newValue.length() > 8 && ((uint8_t)newValue.at(0)) == 0xFF && ((uint8_t)newValue.at(8)) == 0x3d) {
-            qDebug() << "ifit ans 10";
+            qCDebug(qzVirtualDevices) << "ifit ans 10";
             reply1 = QByteArray::fromHex("fe0209020205070502021000000000b400000003");
             reply2 = QByteArray::fromHex("ff0901040205070502021000000000b400000003");
             writeCharacteristic(service, characteristic, reply1);
             writeCharacteristic(service, characteristic, reply2);
         } else if (newValue.length() > 8 && ((uint8_t)newValue.at(0)) == 0xFF && ((uint8_t)newValue.at(8)) == 0x00) {
-            qDebug() << "ifit ans 11";
+            qCDebug(qzVirtualDevices) << "ifit ans 11";
             if (iFit_timer == 0)
                 iFit_timer = QDateTime::currentSecsSinceEpoch();
             reply1 = QByteArray::fromHex("fe0233040000302a00000075ffffffffffffffff");
@@ -647,10 +649,11 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
                                   ? iFit_pelotonToBikeResistance((uint8_t)((bike *)Bike)->pelotonResistance().value())
                                   : iFit_LastResistanceRequested);
 
-            qDebug() << QStringLiteral("current resistance converted from the bike")
-                     << iFit_pelotonToBikeResistance((uint8_t)((bike *)Bike)->pelotonResistance().value())
-                     << QStringLiteral("last requested resistance") << iFit_LastResistanceRequested
-                     << QStringLiteral("resistance sent to ifit") << resistance;
+            qCDebug(qzVirtualDevices)
+                << QStringLiteral("current resistance converted from the bike")
+                << iFit_pelotonToBikeResistance((uint8_t)((bike *)Bike)->pelotonResistance().value())
+                << QStringLiteral("last requested resistance") << iFit_LastResistanceRequested
+                << QStringLiteral("resistance sent to ifit") << resistance;
 
             double odometer = Bike->odometer() * 1000;
             // ifit applies a constant multiplier to the kcal sent from bluetooth
@@ -706,7 +709,7 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
             writeCharacteristic(service, characteristic, reply4);
         } else if (newValue.length() > 8 && ((uint8_t)newValue.at(0)) == 0xFF && ((uint8_t)newValue.at(1)) == 0x07 &&
                    ((uint8_t)newValue.at(7)) == 0x10) {
-            qDebug() << "ifit ans 12";
+            qCDebug(qzVirtualDevices) << "ifit ans 12";
             reply1 = QByteArray::fromHex("fe021c0300b4002200580200000000007e0000b4");
             reply2 = QByteArray::fromHex("001201040218071802020000ffffffffffffffff");
             reply3 = QByteArray::fromHex("ff0a00000000302a00000075ffffffffffffffff");
@@ -735,7 +738,7 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
             answer_13 = true;
         } else if (newValue.length() > 12 && ((uint8_t)newValue.at(0)) == 0xFF && ((uint8_t)newValue.at(1)) == 0x0D &&
                    ((uint8_t)newValue.at(2)) == 0x02) {
-            qDebug() << "ifit ans 14";
+            qCDebug(qzVirtualDevices) << "ifit ans 14";
             // force resistance
             reply1 = QByteArray::fromHex("fe0209020205070502021075ffffffffffffffff");
             reply2 = QByteArray::fromHex("ff0901040205070502021075ffffffffffffffff");
@@ -748,7 +751,8 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
                     .toBool();
 
             iFit_LastResistanceRequested = newValue.at(12);
-            qDebug() << QStringLiteral("requested iFit resistance ") + QString::number(iFit_LastResistanceRequested);
+            qCDebug(qzVirtualDevices) << QStringLiteral("requested iFit resistance ") +
+                                             QString::number(iFit_LastResistanceRequested);
 
             if(((bike*)Bike)->inclinationAvailableByHardware()) {
                 Bike->changeInclination((iFit_LastResistanceRequested * bikeResistanceGain) + bikeResistanceOffset, (iFit_LastResistanceRequested * bikeResistanceGain) + bikeResistanceOffset);
@@ -771,7 +775,7 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
                    ((uint8_t)newValue.at(4)) == 0x02 && ((uint8_t)newValue.at(5)) == 0x0b &&
                    ((uint8_t)newValue.at(6)) == 0x07 && ((uint8_t)newValue.at(7)) == 0x0b &&
                    ((uint8_t)newValue.at(8)) == 0x02) { // ff0f0204020b070b0202041032020a0068000000
-            qDebug() << "ifit ans 15 stop request";
+            qCDebug(qzVirtualDevices) << "ifit ans 15 stop request";
             iFit_timer = 0;
             reply1 = QByteArray::fromHex("fe02090200b40000005802000000000038000000");
             reply2 = QByteArray::fromHex("ff09010402050705020210000000000038000000");
@@ -779,14 +783,14 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
             writeCharacteristic(service, characteristic, reply2);
         } else if (newValue.length() > 12 && ((uint8_t)newValue.at(0)) == 0xFF &&
                    ((uint8_t)newValue.at(1)) == 0x10) { // Value: ff100204020c040c02020004b600000400d20000
-            qDebug() << "ifit ans 16";
+            qCDebug(qzVirtualDevices) << "ifit ans 16";
             reply1 = QByteArray::fromHex("fe0209025802341c0500341c050000a56700b400");
             reply2 = QByteArray::fromHex("ff0901040205040502020d1c050000a56700b400");
             writeCharacteristic(service, characteristic, reply1);
             writeCharacteristic(service, characteristic, reply2);
 
         } else if (newValue.length() > 8 && (uint8_t)newValue.at(0) == 0xFF) {
-            qDebug() << "ifit not managed";
+            qCDebug(qzVirtualDevices) << "ifit not managed";
         }
     }
 
@@ -799,7 +803,7 @@ void virtualbike::characteristicChanged(const QLowEnergyCharacteristic &characte
 
         Q_ASSERT(characteristic.isValid());
         if (leController->state() != QLowEnergyController::ConnectedState) {
-            qDebug() << QStringLiteral("virtual bike not connected");
+            qCDebug(qzVirtualDevices) << QStringLiteral("virtual bike not connected");
 
             return;
         }
@@ -928,11 +932,12 @@ int virtualbike::iFit_pelotonToBikeResistance(int pelotonResistance) {
 void virtualbike::writeCharacteristic(QLowEnergyService *service, const QLowEnergyCharacteristic &characteristic,
                                       const QByteArray &value) {
     try {
-        qDebug() << QStringLiteral("virtualbike::writeCharacteristic ") + service->serviceName() + QStringLiteral(" ") +
-                        characteristic.name() + QStringLiteral(" ") + value.toHex(' ');
+        qCDebug(qzVirtualDevices) << QStringLiteral("virtualbike::writeCharacteristic ") + service->serviceName() +
+                                         QStringLiteral(" ") + characteristic.name() + QStringLiteral(" ") +
+                                         value.toHex(' ');
         service->writeCharacteristic(characteristic, value); // Potentially causes notification.
     } catch (...) {
-        qDebug() << QStringLiteral("virtual bike error!");
+        qCDebug(qzVirtualDevices) << QStringLiteral("virtual bike error!");
     }
 }
 
@@ -995,16 +1000,14 @@ void virtualbike::reconnect() {
 
 void virtualbike::bikeProvider() {
 
-    QSettings settings;
-    bool cadence = settings.value(QZSettings::bike_cadence_sensor, QZSettings::default_bike_cadence_sensor).toBool();
-    bool battery = settings.value(QZSettings::battery_service, QZSettings::default_battery_service).toBool();
-    bool power = settings.value(QZSettings::bike_power_sensor, QZSettings::default_bike_power_sensor).toBool();
-    bool heart_only =
-        settings.value(QZSettings::virtual_device_onlyheart, QZSettings::default_virtual_device_onlyheart).toBool();
-    bool echelon =
-        settings.value(QZSettings::virtual_device_echelon, QZSettings::default_virtual_device_echelon).toBool();
-    bool ifit = settings.value(QZSettings::virtual_device_ifit, QZSettings::default_virtual_device_ifit).toBool();
-    bool erg_mode = settings.value(QZSettings::zwift_erg, QZSettings::default_zwift_erg).toBool();
+    const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
+    bool cadence = snapshot.bike_cadence_sensor;
+    bool battery = snapshot.battery_service;
+    bool power = snapshot.bike_power_sensor;
+    bool heart_only = snapshot.virtual_device_onlyheart;
+    bool echelon = snapshot.virtual_device_echelon;
+    bool ifit = snapshot.virtual_device_ifit;
+    bool erg_mode = snapshot.zwift_erg;
 
     double normalizeWattage = Bike->wattsMetric().value();
     if (normalizeWattage < 0)
@@ -1062,10 +1065,8 @@ void virtualbike::bikeProvider() {
 
         return;
     } else {
-        bool bluetooth_relaxed =
-            settings.value(QZSettings::bluetooth_relaxed, QZSettings::default_bluetooth_relaxed).toBool();
-        bool bluetooth_30m_hangs =
-            settings.value(QZSettings::bluetooth_30m_hangs, QZSettings::default_bluetooth_30m_hangs).toBool();
+        bool bluetooth_relaxed = snapshot.bluetooth_relaxed;
+        bool bluetooth_30m_hangs = snapshot.bluetooth_30m_hangs;
         if (bluetooth_relaxed) {
 
             leController->stopAdvertising();
@@ -1104,7 +1105,9 @@ void virtualbike::bikeProvider() {
 
                         return;
                     }
-                    writeCharacteristic(serviceFIT, characteristic, value);
+                    if (notifyScheduler.changed(characteristic.uuid(), value)) {
+                        writeCharacteristic(serviceFIT, characteristic, value);
+                    }
                 }
             } else if (power) {
                 value.clear();
@@ -1124,7 +1127,9 @@ void virtualbike::bikeProvider() {
 
                         return;
                     }
-                    writeCharacteristic(service, characteristic, value);
+                    if (notifyScheduler.changed(characteristic.uuid(), value)) {
+                        writeCharacteristic(service, characteristic, value);
+                    }
                 }
             } else {
                 value.clear();
@@ -1144,7 +1149,9 @@ void virtualbike::bikeProvider() {
 
                         return;
                     }
-                    writeCharacteristic(service, characteristic, value);
+                    if (notifyScheduler.changed(characteristic.uuid(), value)) {
+                        writeCharacteristic(service, characteristic, value);
+                    }
                 }
             }
         }
@@ -1191,7 +1198,9 @@ void virtualbike::bikeProvider() {
 
             return;
         }
-        writeCharacteristic(serviceBattery, characteristicBattery, valueBattery);
+        if (notifyScheduler.changed(characteristicBattery.uuid(), valueBattery)) {
+            writeCharacteristic(serviceBattery, characteristicBattery, valueBattery);
+        }
     }
 
     if (!this->noHeartService || heart_only) {
@@ -1211,7 +1220,9 @@ void virtualbike::bikeProvider() {
 
                 return;
             }
-            writeCharacteristic(serviceHR, characteristicHR, valueHR);
+            if (notifyScheduler.changed(characteristicHR.uuid(), valueHR)) {
+                writeCharacteristic(serviceHR, characteristicHR, valueHR);
+            }
         }
     }
 }
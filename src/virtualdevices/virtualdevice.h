@@ -2,6 +2,7 @@
 #define VIRTUALDEVICE_H
 
 #include <QObject>
+#include "virtualdevices/virtualnotifyscheduler.h"
 
 class virtualdevice : public QObject
 {
@@ -11,6 +12,17 @@ public:
     ~virtualdevice() override;
     virtual bool connected()=0;
 
+    /**
+     * @brief The latency from the new metrics of the device to the notifications of the virtual device.
+     */
+    const latencyhistogram &notifyLatency() const { return notifyScheduler.latency(); }
+
+protected:
+    /**
+     * @brief Emits provide() when the notifications have to be sent, see virtualnotifyscheduler.
+     */
+    virtualnotifyscheduler notifyScheduler;
+
 signals:
 
 };
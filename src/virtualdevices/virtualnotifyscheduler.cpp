@@ -0,0 +1,113 @@
+#include "virtualnotifyscheduler.h"
+#include "devices/bluetoothdevice.h"
+#include "monotonicclock.h"
+#include "qzlog.h"
+#include "qzsettings.h"
+
+#include <QSettings>
+
+using namespace std::chrono_literals;
+
+namespace {
+const qint64 reportIntervalNs = 60LL * 1000000000LL;
+}
+
+virtualnotifyscheduler::virtualnotifyscheduler(QObject *parent) : QObject(parent) {
+    m_capTimer.setSingleShot(true);
+    m_capTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &virtualnotifyscheduler::run);
+    connect(&m_capTimer, &QTimer::timeout, this, &virtualnotifyscheduler::run);
+}
+
+void virtualnotifyscheduler::start(bluetoothdevice *source, std::chrono::milliseconds period) {
+    QSettings settings;
+    bool eventDriven =
+        settings.value(QZSettings::virtual_device_event_driven, QZSettings::default_virtual_device_event_driven)
+            .toBool();
+    int minInterval = settings
+                          .value(QZSettings::virtual_device_notify_interval_ms,
+                                 QZSettings::default_virtual_device_notify_interval_ms)
+                          .toInt();
+    start(source, period, eventDriven, std::chrono::milliseconds(minInterval));
+}
+
+void virtualnotifyscheduler::start(bluetoothdevice *source, std::chrono::milliseconds period, bool eventDriven,
+                                   std::chrono::milliseconds minInterval) {
+    m_eventDriven = eventDriven;
+    m_sourcePublishes = false;
+    m_minIntervalNs = qMax<qint64>(0, minInterval.count()) * 1000000;
+    m_keepaliveNs = qMax<qint64>(period.count(), 1000) * 1000000;
+    m_lastRunNs = monotonicclock::nsecs() - m_minIntervalNs;
+    m_lastReportNs = monotonicclock::nsecs();
+    m_pendingSinceNs = 0;
+    m_lastNotified.clear();
+    m_latency.clear();
+
+    if (source) {
+        connect(source, &bluetoothdevice::metricsUpdated, this, &virtualnotifyscheduler::sourceUpdated,
+                Qt::UniqueConnection);
+    }
+    qCDebug(qzVirtualDevices) << QStringLiteral("virtual device notifications")
+                              << (eventDriven ? QStringLiteral("event-driven") : QStringLiteral("timer"))
+                              << period.count() << minInterval.count();
+    m_timer.start(period);
+}
+
+bool virtualnotifyscheduler::changed(const QBluetoothUuid &characteristic, const QByteArray &value) {
+    if (!m_eventDriven) {
+        return true;
+    }
+    const qint64 now = monotonicclock::nsecs();
+    lastNotified &last = m_lastNotified[characteristic];
+    if (last.nsecs != 0 && last.value == value && now - last.nsecs < m_keepaliveNs / 2) {
+        return false;
+    }
+    last.value = value;
+    last.nsecs = now;
+    return true;
+}
+
+void virtualnotifyscheduler::sourceUpdated() {
+    const qint64 now = monotonicclock::nsecs();
+    if (m_pendingSinceNs == 0) {
+        m_pendingSinceNs = now;
+    }
+    if (!m_eventDriven) {
+        return;
+    }
+    if (!m_sourcePublishes) {
+        // from now on the timer is only a keepalive
+        m_sourcePublishes = true;
+        m_timer.setInterval(int(m_keepaliveNs / 1000000));
+    }
+    if (m_capTimer.isActive()) {
+        return;
+    }
+    const qint64 wait = m_lastRunNs + m_minIntervalNs - now;
+    if (wait <= 0) {
+        run();
+    } else {
+        m_capTimer.start(int((wait + 999999) / 1000000));
+    }
+}
+
+void virtualnotifyscheduler::run() {
+    m_capTimer.stop();
+    m_lastRunNs = monotonicclock::nsecs();
+    if (m_eventDriven && m_sourcePublishes) {
+        // the keepalive counts from the last run
+        m_timer.start();
+    }
+
+    emit provide();
+
+    const qint64 now = monotonicclock::nsecs();
+    if (m_pendingSinceNs != 0) {
+        m_latency.add(now - m_pendingSinceNs);
+        m_pendingSinceNs = 0;
+    }
+    if (now - m_lastReportNs >= reportIntervalNs) {
+        m_lastReportNs = now;
+        qCDebug(qzVirtualDevices) << QStringLiteral("virtual device notify latency") << m_latency.toString();
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef VIRTUALNOTIFYSCHEDULER_H
+#define VIRTUALNOTIFYSCHEDULER_H
+
+#include "latencyhistogram.h"
+
+#include <QBluetoothUuid>
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QTimer>
+#include <chrono>
+
+class bluetoothdevice;
+
+/**
+ * @brief Decides when a virtual device sends its notifications: emits provide(), connected to the provider of the
+ * virtual device.
+ *
+ * In the timer mode, the default, provide() is emitted every period, 1 s or 100 ms in race mode, whatever the source
+ * device does.
+ *
+ * In the event-driven mode (QZSettings::virtual_device_event_driven) provide() is emitted as soon as the source device
+ * publishes new metrics with bluetoothdevice::metricsUpdated, at most once every minInterval: the updates arriving
+ * before are coalesced in one run at the end of the interval. The period timer stays as a keepalive, 1 s once the
+ * source has published something, so a device that doesn't publish its updates still works as in the timer mode and
+ * an idle one costs one run a second. changed() lets the provider skip the characteristics whose value is the same
+ * of the last notification.
+ *
+ * In both modes the time from the first update of the source to the end of the next run is recorded in latency(),
+ * and logged every minute on qz.virtualdevices.
+ */
+class virtualnotifyscheduler : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit virtualnotifyscheduler(QObject *parent = nullptr);
+
+    /**
+     * @brief Starts with the mode and the interval of the settings.
+     */
+    void start(bluetoothdevice *source, std::chrono::milliseconds period);
+    void start(bluetoothdevice *source, std::chrono::milliseconds period, bool eventDriven,
+               std::chrono::milliseconds minInterval);
+
+    bool eventDriven() const { return m_eventDriven; }
+
+    /**
+     * @brief Whether the value has to be notified: always in the timer mode, in the event-driven mode if it's
+     * different from the last one notified for the characteristic or if that one is older than half the keepalive.
+     */
+    bool changed(const QBluetoothUuid &characteristic, const QByteArray &value);
+
+    /**
+     * @brief The latency from an update of the source device to the notifications of the virtual device.
+     */
+    const latencyhistogram &latency() const { return m_latency; }
+
+  signals:
+    void provide();
+
+  public slots:
+    /**
+     * @brief The source device has new metrics.
+     */
+    void sourceUpdated();
+
+  private:
+    struct lastNotified {
+        QByteArray value;
+        qint64 nsecs = 0;
+    };
+
+    void run();
+
+    // the period, or the keepalive in the event-driven mode
+    QTimer m_timer;
+    // the end of the minimum interval, when an update arrived too early
+    QTimer m_capTimer;
+    bool m_eventDriven = false;
+    bool m_sourcePublishes = false;
+    qint64 m_minIntervalNs = 0;
+    qint64 m_keepaliveNs = 0;
+    qint64 m_lastRunNs = 0;
+    // the first update not notified yet, 0 if none
+    qint64 m_pendingSinceNs = 0;
+    qint64 m_lastReportNs = 0;
+    QHash<QBluetoothUuid, lastNotified> m_lastNotified;
+    latencyhistogram m_latency;
+};
+
+#endif // VIRTUALNOTIFYSCHEDULER_H
@@ -1,4 +1,6 @@
 #include "virtualdevices/virtualrower.h"
+#include "qzlog.h"
+#include "qzsettingssnapshot.h"
 #include "qsettings.h"
 #include "rower.h"
 
@@ -186,11 +188,11 @@ virtualrower::virtualrower(bluetoothdevice *t, bool noWriteResistance, bool noHe
     }
 
     //! [Provide Heartbeat]
-    QObject::connect(&rowerTimer, &QTimer::timeout, this, &virtualrower::rowerProvider);
+    QObject::connect(&notifyScheduler, &virtualnotifyscheduler::provide, this, &virtualrower::rowerProvider);
     if (settings.value(QZSettings::race_mode, QZSettings::default_race_mode).toBool())
-        rowerTimer.start(100ms);
+        notifyScheduler.start(Rower, 100ms);
     else
-        rowerTimer.start(1s);
+        notifyScheduler.start(Rower, 1s);
 
     //! [Provide Heartbeat]
     QObject::connect(leController, &QLowEnergyController::disconnected, this, &virtualrower::reconnect);
@@ -204,8 +206,9 @@ void virtualrower::characteristicChanged(const QLowEnergyCharacteristic &charact
     QByteArray reply;
     QSettings settings;
     bool erg_mode = settings.value(QZSettings::zwift_erg, QZSettings::default_zwift_erg).toBool();
-    qDebug() << QStringLiteral("characteristicChanged ") + QString::number(characteristic.uuid().toUInt16()) +
-                    QStringLiteral(" ") + newValue.toHex(' ');
+    qCDebug(qzVirtualDevices) << QStringLiteral("characteristicChanged ") +
+                                     QString::number(characteristic.uuid().toUInt16()) + QStringLiteral(" ") +
+                                     newValue.toHex(' ');
 
     lastFTMSFrameReceived = QDateTime::currentMSecsSinceEpoch();
 
@@ -223,15 +226,15 @@ void virtualrower::characteristicChanged(const QLowEnergyCharacteristic &charact
             if (force_resistance && !erg_mode) {
                 rower->changeResistance(uresistance);
             }
-            qDebug() << QStringLiteral("new requested resistance ") + QString::number(uresistance) +
-                            QStringLiteral(" enabled ") + force_resistance;
+            qCDebug(qzVirtualDevices) << QStringLiteral("new requested resistance ") + QString::number(uresistance) +
+                                             QStringLiteral(" enabled ") + force_resistance;
             reply.append((quint8)FTMS_RESPONSE_CODE);
             reply.append((quint8)FTMS_SET_TARGET_RESISTANCE_LEVEL);
             reply.append((quint8)FTMS_SUCCESS);
         } else if ((char)newValue.at(0) == FTMS_SET_INDOOR_rower_SIMULATION_PARAMS) // simulation parameter
 
         {
-            qDebug() << QStringLiteral("indoor rower simulation parameters");
+            qCDebug(qzVirtualDevices) << QStringLiteral("indoor rower simulation parameters");
             reply.append((quint8)FTMS_RESPONSE_CODE);
             reply.append((quint8)FTMS_SET_INDOOR_rower_SIMULATION_PARAMS);
             reply.append((quint8)FTMS_SUCCESS);
@@ -241,7 +244,7 @@ void virtualrower::characteristicChanged(const QLowEnergyCharacteristic &charact
         } else if ((char)newValue.at(0) == FTMS_SET_TARGET_POWER) // erg mode
 
         {
-            qDebug() << QStringLiteral("erg mode");
+            qCDebug(qzVirtualDevices) << QStringLiteral("erg mode");
             reply.append((quint8)FTMS_RESPONSE_CODE);
             reply.append((quint8)FTMS_SET_TARGET_POWER);
             reply.append((quint8)FTMS_SUCCESS);
@@ -249,19 +252,19 @@ void virtualrower::characteristicChanged(const QLowEnergyCharacteristic &charact
             uint16_t power = (((uint8_t)newValue.at(1)) + (newValue.at(2) << 8));
             powerChanged(power);
         } else if ((char)newValue.at(0) == FTMS_START_RESUME) {
-            qDebug() << QStringLiteral("start simulation!");
+            qCDebug(qzVirtualDevices) << QStringLiteral("start simulation!");
 
             reply.append((quint8)FTMS_RESPONSE_CODE);
             reply.append((quint8)FTMS_START_RESUME);
             reply.append((quint8)FTMS_SUCCESS);
         } else if ((char)newValue.at(0) == FTMS_REQUEST_CONTROL) {
-            qDebug() << QStringLiteral("control requested");
+            qCDebug(qzVirtualDevices) << QStringLiteral("control requested");
 
             reply.append((quint8)FTMS_RESPONSE_CODE);
             reply.append((char)FTMS_REQUEST_CONTROL);
             reply.append((quint8)FTMS_SUCCESS);
         } else {
-            qDebug() << QStringLiteral("not supported");
+            qCDebug(qzVirtualDevices) << QStringLiteral("not supported");
 
             reply.append((quint8)FTMS_RESPONSE_CODE);
             reply.append((quint8)newValue.at(0));
@@ -272,7 +275,7 @@ void virtualrower::characteristicChanged(const QLowEnergyCharacteristic &charact
             serviceFIT->characteristic((QBluetoothUuid::CharacteristicType)0x2AD9);
         Q_ASSERT(characteristic.isValid());
         if (leController->state() != QLowEnergyController::ConnectedState) {
-            qDebug() << QStringLiteral("virtual rower not connected");
+            qCDebug(qzVirtualDevices) << QStringLiteral("virtual rower not connected");
 
             return;
         }
@@ -285,11 +288,12 @@ void virtualrower::characteristicChanged(const QLowEnergyCharacteristic &charact
 void virtualrower::writeCharacteristic(QLowEnergyService *service, const QLowEnergyCharacteristic &characteristic,
                                        const QByteArray &value) {
     try {
-        qDebug() << QStringLiteral("virtualrower::writeCharacteristic ") + service->serviceName() +
-                        QStringLiteral(" ") + characteristic.name() + QStringLiteral(" ") + value.toHex(' ');
+        qCDebug(qzVirtualDevices) << QStringLiteral("virtualrower::writeCharacteristic ") + service->serviceName() +
+                                         QStringLiteral(" ") + characteristic.name() + QStringLiteral(" ") +
+                                         value.toHex(' ');
         service->writeCharacteristic(characteristic, value); // Potentially causes notification.
     } catch (...) {
-        qDebug() << QStringLiteral("virtual rower error!");
+        qCDebug(qzVirtualDevices) << QStringLiteral("virtual rower error!");
     }
 }
 
@@ -326,9 +330,8 @@ void virtualrower::reconnect() {
 
 void virtualrower::rowerProvider() {
 
-    QSettings settings;
-    bool heart_only =
-        settings.value(QZSettings::virtual_device_onlyheart, QZSettings::default_virtual_device_onlyheart).toBool();
+    const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
+    bool heart_only = snapshot.virtual_device_onlyheart;
 
     double normalizeWattage = Rower->wattsMetric().value();
     if (normalizeWattage < 0)
@@ -375,10 +378,8 @@ void virtualrower::rowerProvider() {
 
         return;
     } else {
-        bool bluetooth_relaxed =
-            settings.value(QZSettings::bluetooth_relaxed, QZSettings::default_bluetooth_relaxed).toBool();
-        bool bluetooth_30m_hangs =
-            settings.value(QZSettings::bluetooth_30m_hangs, QZSettings::default_bluetooth_30m_hangs).toBool();
+        bool bluetooth_relaxed = snapshot.bluetooth_relaxed;
+        bool bluetooth_30m_hangs = snapshot.bluetooth_30m_hangs;
         if (bluetooth_relaxed) {
 
             leController->stopAdvertising();
@@ -445,7 +446,9 @@ void virtualrower::rowerProvider() {
 
             return;
         }
-        writeCharacteristic(serviceFIT, characteristic, value);
+        if (notifyScheduler.changed(characteristic.uuid(), value)) {
+            writeCharacteristic(serviceFIT, characteristic, value);
+        }
     }
     // characteristic
     //        = service->characteristic((QBluetoothUuid::CharacteristicType)0x2AD9); // Fitness Machine Control Point
@@ -470,7 +473,9 @@ void virtualrower::rowerProvider() {
 
             return;
         }
-        writeCharacteristic(serviceHR, characteristicHR, valueHR);
+        if (notifyScheduler.changed(characteristicHR.uuid(), valueHR)) {
+            writeCharacteristic(serviceHR, characteristicHR, valueHR);
+        }
     }
 }
 
@@ -43,7 +43,6 @@ class virtualrower : public virtualdevice {
     QLowEnergyAdvertisingData advertisingData;
     QLowEnergyServiceData serviceDataHR;
     QLowEnergyServiceData serviceDataFIT;
-    QTimer rowerTimer;
     bluetoothdevice *Rower;
 
     uint16_t lastWheelTime = 0;
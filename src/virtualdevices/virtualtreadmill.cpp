@@ -1,4 +1,6 @@
 #include "virtualdevices/virtualtreadmill.h"
+#include "qzlog.h"
+#include "qzsettingssnapshot.h"
 #include <QSettings>
 #include <QtMath>
 #include <chrono>
@@ -268,17 +270,17 @@ virtualtreadmill::virtualtreadmill(bluetoothdevice *t, bool noHeartService) {
         QObject::connect(leController, &QLowEnergyController::disconnected, this, &virtualtreadmill::reconnect);
     }
     //! [Provide Heartbeat]
-    QObject::connect(&treadmillTimer, &QTimer::timeout, this, &virtualtreadmill::treadmillProvider);
+    QObject::connect(&notifyScheduler, &virtualnotifyscheduler::provide, this, &virtualtreadmill::treadmillProvider);
     if (settings.value(QZSettings::race_mode, QZSettings::default_race_mode).toBool())
-        treadmillTimer.start(100ms);
+        notifyScheduler.start(treadMill, 100ms);
     else
-        treadmillTimer.start(1s);
+        notifyScheduler.start(treadMill, 1s);
 }
 
 void virtualtreadmill::characteristicChanged(const QLowEnergyCharacteristic &characteristic,
                                              const QByteArray &newValue) {
-    qDebug() << QStringLiteral("characteristicChanged ") + QString::number(characteristic.uuid().toUInt16()) +
-                    QStringLiteral(" ") + newValue;
+    qCDebug(qzVirtualDevices) << QStringLiteral("characteristicChanged ") +
+                                     QString::number(characteristic.uuid().toUInt16()) + QStringLiteral(" ") + newValue;
     QByteArray reply;
 
     switch (characteristic.uuid().toUInt16()) {
@@ -289,16 +291,17 @@ void virtualtreadmill::characteristicChanged(const QLowEnergyCharacteristic &cha
                 serviceFTMS->characteristic((QBluetoothUuid::CharacteristicType)0x2AD9);
             Q_ASSERT(characteristic.isValid());
             if (leController->state() != QLowEnergyController::ConnectedState) {
-                qDebug() << QStringLiteral("virtual treadmill not connected");
+                qCDebug(qzVirtualDevices) << QStringLiteral("virtual treadmill not connected");
 
                 return;
             }
             try {
-                qDebug() << QStringLiteral("virtualtreadmill::writeCharacteristic ") + serviceFTMS->serviceName() +
-                                QStringLiteral(" ") + characteristic.name() + QStringLiteral(" ") + reply.toHex(' ');
+                qCDebug(qzVirtualDevices) << QStringLiteral("virtualtreadmill::writeCharacteristic ") +
+                                                 serviceFTMS->serviceName() + QStringLiteral(" ") +
+                                                 characteristic.name() + QStringLiteral(" ") + reply.toHex(' ');
                 serviceFTMS->writeCharacteristic(characteristic, reply); // Potentially causes notification.
             } catch (...) {
-                qDebug() << QStringLiteral("virtual treadmill error!");
+                qCDebug(qzVirtualDevices) << QStringLiteral("virtual treadmill error!");
             }
         }
         break;
@@ -350,17 +353,14 @@ void virtualtreadmill::reconnect() {
 
 void virtualtreadmill::treadmillProvider() {
     const uint64_t slopeTimeoutSecs = 30;
-    QSettings settings;
+    const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
 
     if ((uint64_t)QDateTime::currentSecsSinceEpoch() > lastSlopeChanged + slopeTimeoutSecs)
         m_autoInclinationEnabled = false;
 
 #ifdef Q_OS_IOS
 #ifndef IO_UNDER_QT
-    bool double_cadence = settings
-                              .value(QZSettings::powr_sensor_running_cadence_double,
-                                     QZSettings::default_powr_sensor_running_cadence_double)
-                              .toBool();
+    bool double_cadence = snapshot.powr_sensor_running_cadence_double;
     double cadence_multiplier = 2.0;
     if (double_cadence)
         cadence_multiplier = 1.0;
@@ -386,9 +386,7 @@ void virtualtreadmill::treadmillProvider() {
         qDebug() << QStringLiteral("virtualtreadmill connection error");
         return;
     } else {
-        QSettings settings;
-        bool bluetooth_relaxed =
-            settings.value(QZSettings::bluetooth_relaxed, QZSettings::default_bluetooth_relaxed).toBool();
+        bool bluetooth_relaxed = snapshot.bluetooth_relaxed;
         if (bluetooth_relaxed) {
             leController->stopAdvertising();
         }
@@ -414,10 +412,12 @@ void virtualtreadmill::treadmillProvider() {
 
                     return;
                 }
-                try {
-                    serviceFTMS->writeCharacteristic(characteristic, value); // Potentially causes notification.
-                } catch (...) {
-                    qDebug() << QStringLiteral("virtualtreadmill error!");
+                if (notifyScheduler.changed(characteristic.uuid(), value)) {
+                    try {
+                        serviceFTMS->writeCharacteristic(characteristic, value); // Potentially causes notification.
+                    } catch (...) {
+                        qDebug() << QStringLiteral("virtualtreadmill error!");
+                    }
                 }
             }
         }
@@ -437,10 +437,12 @@ void virtualtreadmill::treadmillProvider() {
 
                 return;
             }
-            try {
-                serviceFTMS->writeCharacteristic(characteristic, value); // Potentially causes notification.
-            } catch (...) {
-                qDebug() << QStringLiteral("virtualtreadmill error!");
+            if (notifyScheduler.changed(characteristic.uuid(), value)) {
+                try {
+                    serviceFTMS->writeCharacteristic(characteristic, value); // Potentially causes notification.
+                } catch (...) {
+                    qDebug() << QStringLiteral("virtualtreadmill error!");
+                }
             }
         }
     }
@@ -461,10 +463,12 @@ void virtualtreadmill::treadmillProvider() {
 
                 return;
             }
-            try {
-                serviceRSC->writeCharacteristic(characteristic, value); // Potentially causes notification.
-            } catch (...) {
-                qDebug() << QStringLiteral("virtualtreadmill error!");
+            if (notifyScheduler.changed(characteristic.uuid(), value)) {
+                try {
+                    serviceRSC->writeCharacteristic(characteristic, value); // Potentially causes notification.
+                } catch (...) {
+                    qDebug() << QStringLiteral("virtualtreadmill error!");
+                }
             }
         }
     }
@@ -491,10 +495,12 @@ void virtualtreadmill::treadmillProvider() {
 
                 return;
             }
-            try {
-                serviceHR->writeCharacteristic(characteristic, value); // Potentially causes notification.
-            } catch (...) {
-                qDebug() << QStringLiteral("virtualtreadmill error!");
+            if (notifyScheduler.changed(characteristic.uuid(), value)) {
+                try {
+                    serviceHR->writeCharacteristic(characteristic, value); // Potentially causes notification.
+                } catch (...) {
+                    qDebug() << QStringLiteral("virtualtreadmill error!");
+                }
             }
         }
     }
@@ -45,7 +45,6 @@ class virtualtreadmill : public virtualdevice {
     QLowEnergyServiceData serviceDataFTMS;
     QLowEnergyServiceData serviceDataRSC;
     QLowEnergyServiceData serviceDataHR;
-    QTimer treadmillTimer;
     bluetoothdevice *treadMill;
 
     uint64_t lastSlopeChanged = 0;
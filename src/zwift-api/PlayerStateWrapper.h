@@ -7,71 +7,53 @@
 #include <QJsonDocument>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
-#include <QEventLoop>
 #include <QDebug>
 
+// the requests don't wait for the reply: the caller connects to QNetworkReply::finished and deletes the reply
 class ZwiftRequest: public QObject {
     Q_OBJECT
 
 public:
-    ZwiftRequest(const QString& getAccessToken) : getAccessToken(getAccessToken) {}
+    ZwiftRequest(const QString& getAccessToken, const QString& baseUrl = DEFAULT_BASE_URL)
+        : BASE_URL(baseUrl), getAccessToken(getAccessToken) {}
 
-    QString json(const QString& url) {
-        QNetworkRequest request(QUrl(BASE_URL + url));
-        request.setRawHeader("Accept", "application/json");
-        request.setRawHeader("Authorization", "Bearer " + getAccessToken.toUtf8());
-
-        QNetworkReply* reply = manager.get(request);
-        QEventLoop loop;
-        connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-        loop.exec();
-
-        if (reply->error() != QNetworkReply::NoError) {
-            qDebug() << "Error: " << reply->errorString();
-            return "";
-        }
+    QNetworkReply* json(const QString& url) {
+        return get(url, "application/json");
+    }
 
-        return reply->readAll();
+    QNetworkReply* protobuf(const QString& url) {
+        return get(url, "application/x-protobuf-lite");
     }
 
-    QByteArray protobuf(const QString& url) {
+    static constexpr const char* DEFAULT_BASE_URL = "https://us-or-rly101.zwift.com";
+
+private:
+    QNetworkReply* get(const QString& url, const QByteArray& accept) {
         QNetworkRequest request(QUrl(BASE_URL + url));
-        request.setRawHeader("Accept", "application/x-protobuf-lite");
+        request.setRawHeader("Accept", accept);
         request.setRawHeader("Authorization", "Bearer " + getAccessToken.toUtf8());
-
-        QNetworkReply* reply = manager.get(request);
-        QEventLoop loop;
-        connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-        loop.exec();
-
-        if (reply->error() != QNetworkReply::NoError) {
-            qDebug() << "Error: " << reply->errorString();
-            return QByteArray();
-        }
-
-        return reply->readAll();
+        return manager.get(request);
     }
 
-private:
     QNetworkAccessManager manager;
-    const QString BASE_URL = "https://us-or-rly101.zwift.com";
+    const QString BASE_URL;
     const QString getAccessToken;
 };
 
 class World {
 public:    
-    World(int worldId, const QString& getAccessToken) : worldId(worldId), request(getAccessToken) {}
+    World(int worldId, const QString& getAccessToken, const QString& baseUrl = ZwiftRequest::DEFAULT_BASE_URL)
+        : worldId(worldId), request(getAccessToken, baseUrl) {}
 
-    QString getPlayers() {
+    QNetworkReply* getPlayers() {
         return request.json("/relay/worlds/" + QString::number(worldId));
     }
 
-    QByteArray playerStatus(int playerId) {
-        QByteArray buffer = request.protobuf("/relay/worlds/" + QString::number(worldId) + "/players/" + QString::number(playerId));
-        return buffer;
+    QNetworkReply* playerStatus(int playerId) {
+        return request.protobuf("/relay/worlds/" + QString::number(worldId) + "/players/" + QString::number(playerId));
     }
 
-    QString player_id() {
+    QNetworkReply* player_id() {
         return request.json("/api/profiles/me");
     }
 
@@ -0,0 +1,67 @@
+#include "zwift_api_poller.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+
+ZwiftApiPoller::ZwiftApiPoller(int worldId, const QString &accessToken, const QString &baseUrl, QObject *parent)
+    : QObject(parent), m_world(worldId, accessToken, baseUrl) {}
+
+ZwiftApiPoller::~ZwiftApiPoller() {
+    if (m_reply) {
+        m_reply->disconnect(this);
+        m_reply->abort();
+        m_reply->deleteLater();
+    }
+}
+
+bool ZwiftApiPoller::poll() {
+    if (m_reply) {
+        m_coalescedPolls++;
+        return false;
+    }
+
+    m_profileRequest = m_playerId == -1;
+    QNetworkReply *reply = m_profileRequest ? m_world.player_id() : m_world.playerStatus(m_playerId);
+    m_reply = reply;
+    connect(reply, &QNetworkReply::finished, this, &ZwiftApiPoller::replyFinished);
+    QTimer::singleShot(m_timeoutMs, reply, &QNetworkReply::abort);
+    return true;
+}
+
+bool ZwiftApiPoller::takePlayerState(QByteArray *state) {
+    if (m_playerStateTaken) {
+        return false;
+    }
+    *state = m_playerState;
+    m_playerStateTaken = true;
+    return true;
+}
+
+void ZwiftApiPoller::replyFinished() {
+    QNetworkReply *reply = m_reply;
+    m_reply = nullptr;
+    if (!reply) {
+        return;
+    }
+    reply->deleteLater();
+
+    if (reply->error() != QNetworkReply::NoError) {
+        qDebug() << QStringLiteral("zwift api error") << reply->errorString();
+        return;
+    }
+
+    if (m_profileRequest) {
+        QJsonParseError parseError;
+        QJsonObject ride = QJsonDocument::fromJson(reply->readAll(), &parseError).object();
+        qDebug() << QStringLiteral("zwift api player") << ride;
+        int id = ride[QStringLiteral("id")].toInt(-1);
+        if (id > 0) {
+            m_playerId = id;
+            emit loggedIn(m_playerId);
+        }
+    } else {
+        m_playerState = reply->readAll();
+        m_playerStateTaken = false;
+        emit playerStateReceived();
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef ZWIFT_API_POLLER_H
+#define ZWIFT_API_POLLER_H
+
+#include "PlayerStateWrapper.h"
+#include <QByteArray>
+#include <QObject>
+#include <QPointer>
+
+/**
+ * @brief Polls the Zwift relay API without blocking the caller.
+ *
+ * poll() only starts a request: the player id is requested first, then the PlayerState of the player. Only one
+ * request is in flight at a time, a poll() while one is pending is coalesced with it. The last PlayerState received
+ * is cached, the trainprogram scheduler reads it with takePlayerState() on its own tick, so a slow or unreachable
+ * server never stalls the scheduler.
+ */
+class ZwiftApiPoller : public QObject {
+    Q_OBJECT
+
+  public:
+    ZwiftApiPoller(int worldId, const QString &accessToken, const QString &baseUrl = ZwiftRequest::DEFAULT_BASE_URL,
+                   QObject *parent = nullptr);
+    ~ZwiftApiPoller();
+
+    /**
+     * @brief Starts the next request.
+     * @return false if a request is still in flight, this poll is coalesced with it.
+     */
+    bool poll();
+
+    /**
+     * @brief The PlayerState received since the last call, if any.
+     * @return false if no new PlayerState has been received.
+     */
+    bool takePlayerState(QByteArray *state);
+
+    bool isPolling() const { return !m_reply.isNull(); }
+    // -1 until the profile of the player has been received
+    int playerId() const { return m_playerId; }
+    int coalescedPolls() const { return m_coalescedPolls; }
+
+    // a request still running after this time is aborted
+    void setTimeoutMs(int ms) { m_timeoutMs = ms; }
+
+  signals:
+    void loggedIn(int playerId);
+    void playerStateReceived();
+
+  private:
+    void replyFinished();
+
+    World m_world;
+    QPointer<QNetworkReply> m_reply;
+    bool m_profileRequest = false;
+    int m_playerId = -1;
+    QByteArray m_playerState;
+    bool m_playerStateTaken = true;
+    int m_coalescedPolls = 0;
+    int m_timeoutMs = 10000;
+};
+
+#endif // ZWIFT_API_POLLER_H
@@ -0,0 +1,118 @@
+#include "commandcoalescertestsuite.h"
+
+#include "devices/commandcoalescer.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+
+namespace {
+void processEvents(int ms) {
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < ms) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        QThread::msleep(1);
+    }
+}
+} // namespace
+
+CommandCoalescerTestSuite::CommandCoalescerTestSuite() {}
+
+void CommandCoalescerTestSuite::test_newestTargetWins() {
+    commandcoalescer commands;
+    QList<double> applied;
+    // the driver never reads the field: every applied target after the first one replaces an unread one
+    double field = -100;
+    commands.setChannel(
+        commandcoalescer::INCLINATION,
+        [&](double target) {
+            bool merged = field != -100;
+            field = target;
+            applied.append(target);
+            return merged;
+        },
+        100);
+
+    commands.request(commandcoalescer::INCLINATION, 1);
+    commands.request(commandcoalescer::INCLINATION, 2);
+    commands.request(commandcoalescer::INCLINATION, 3);
+    commands.request(commandcoalescer::INCLINATION, 4);
+    EXPECT_EQ(applied, QList<double>({1}));
+
+    processEvents(200);
+    EXPECT_EQ(applied, QList<double>({1, 4}));
+    EXPECT_EQ(commands.requested(commandcoalescer::INCLINATION), 4);
+    EXPECT_EQ(commands.applied(commandcoalescer::INCLINATION), 2);
+    EXPECT_EQ(commands.merged(commandcoalescer::INCLINATION), 3);
+    EXPECT_EQ(commands.dropped(commandcoalescer::INCLINATION), 0);
+
+    // the other channels are independent
+    EXPECT_EQ(commands.requested(commandcoalescer::POWER), 0);
+}
+
+void CommandCoalescerTestSuite::test_minStep() {
+    commandcoalescer commands;
+    QList<double> applied;
+    commands.setChannel(
+        commandcoalescer::INCLINATION,
+        [&](double target) {
+            applied.append(target);
+            return false;
+        },
+        100);
+
+    commands.request(commandcoalescer::INCLINATION, 2.2, 0.5, 2.0);
+    EXPECT_TRUE(applied.isEmpty());
+    commands.request(commandcoalescer::INCLINATION, 3.0, 0.5, 2.0);
+    EXPECT_EQ(applied, QList<double>({3.0}));
+
+    // the newest target is where the device already is: the pending one is not sent
+    commands.request(commandcoalescer::INCLINATION, 5.0, 0.5, 3.0);
+    commands.request(commandcoalescer::INCLINATION, 3.1, 0.5, 3.0);
+    processEvents(200);
+    EXPECT_EQ(applied, QList<double>({3.0}));
+    EXPECT_EQ(commands.dropped(commandcoalescer::INCLINATION), 2);
+    EXPECT_EQ(commands.merged(commandcoalescer::INCLINATION), 1);
+}
+
+void CommandCoalescerTestSuite::test_staleTarget() {
+    commandcoalescer commands;
+    QList<double> applied;
+    double field = -100;
+    commands.setChannel(
+        commandcoalescer::INCLINATION,
+        [&](double target) {
+            bool merged = field != -100;
+            field = target;
+            applied.append(target);
+            return merged;
+        },
+        100);
+
+    // 5% is applied but the driver hasn't read it yet, the treadmill is at 2%
+    commands.request(commandcoalescer::INCLINATION, 5.0, 0.5, 2.0);
+    EXPECT_EQ(field, 5.0);
+    commands.request(commandcoalescer::INCLINATION, 2.0, 0.5, 2.0);
+    processEvents(200);
+    EXPECT_EQ(applied, QList<double>({5.0, 2.0}));
+    EXPECT_EQ(field, 2.0);
+    EXPECT_EQ(commands.dropped(commandcoalescer::INCLINATION), 0);
+    EXPECT_EQ(commands.merged(commandcoalescer::INCLINATION), 1);
+
+    // the driver sent 2%: asking it again is dropped
+    field = -100;
+    commands.request(commandcoalescer::INCLINATION, 2.1, 0.5, 2.0);
+    processEvents(200);
+    EXPECT_EQ(applied, QList<double>({5.0, 2.0}));
+    EXPECT_EQ(commands.dropped(commandcoalescer::INCLINATION), 1);
+
+    // the driver sent 5% and the treadmill reads 3% on its way there: 3% stops it
+    commands.request(commandcoalescer::INCLINATION, 5.0, 0.5, 2.0);
+    processEvents(200);
+    field = -100;
+    commands.request(commandcoalescer::INCLINATION, 3.0, 0.5, 3.0);
+    processEvents(200);
+    EXPECT_EQ(applied, QList<double>({5.0, 2.0, 5.0, 3.0}));
+    EXPECT_EQ(field, 3.0);
+    EXPECT_EQ(commands.dropped(commandcoalescer::INCLINATION), 1);
+}
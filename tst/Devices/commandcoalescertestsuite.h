@@ -0,0 +1,35 @@
+#ifndef COMMANDCOALESCERTESTSUITE_H
+#define COMMANDCOALESCERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class CommandCoalescerTestSuite : public testing::Test {
+
+  public:
+    CommandCoalescerTestSuite();
+
+    /**
+     * @brief Test that the targets requested within the interval of a channel are merged and only the newest one is
+     * applied.
+     */
+    void test_newestTargetWins();
+
+    /**
+     * @brief Test that a target in the same step of the current value is dropped and cancels the pending one.
+     */
+    void test_minStep();
+
+    /**
+     * @brief Test that a target at the current value of the device is applied when an older target, unread by the
+     * driver or still being reached by the machine, would move it elsewhere.
+     */
+    void test_staleTarget();
+};
+
+TEST_F(CommandCoalescerTestSuite, TestNewestTargetWins) { this->test_newestTargetWins(); }
+
+TEST_F(CommandCoalescerTestSuite, TestMinStep) { this->test_minStep(); }
+
+TEST_F(CommandCoalescerTestSuite, TestStaleTarget) { this->test_staleTarget(); }
+
+#endif // COMMANDCOALESCERTESTSUITE_H
@@ -0,0 +1,583 @@
+#include "dirconprocessortestsuite.h"
+
+#include "Tools/testsettings.h"
+#include "devices/dircon/dirconpacket.h"
+#include "devices/dircon/dirconprocessor.h"
+#include "qzsettings.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <functional>
+#include <memory>
+
+namespace {
+const quint16 indoorBikeData = 0x2AD2;
+const quint16 heartRate = 0x2A37;
+// the response to a subscription: header and uuid
+const int subscriptionResponseSize = DPKT_MESSAGE_HEADER_LENGTH + 16;
+
+bool waitFor(const std::function<bool()> &condition, int ms = 3000) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > ms) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        QThread::msleep(1);
+    }
+    return true;
+}
+
+void processEvents(int ms) {
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < ms) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        QThread::msleep(1);
+    }
+}
+
+std::unique_ptr<DirconProcessor> newProcessor(TestSettings &testSettings, bool subscribedOnly) {
+    testSettings.qsettings.setValue(QZSettings::wahoo_rgt_dircon, subscribedOnly);
+    DirconProcessorService *service = new DirconProcessorService(QStringLiteral("FITNESS_MACHINE_CYCLE"), 0x1826, 0);
+    service->chars.append(
+        new DirconProcessorCharacteristic(indoorBikeData, DPKT_CHAR_PROP_FLAG_NOTIFY, QByteArray(1, 0), 0, service));
+    service->chars.append(
+        new DirconProcessorCharacteristic(heartRate, DPKT_CHAR_PROP_FLAG_NOTIFY, QByteArray(1, 0), 0, service));
+    // port 0: any free port
+    std::unique_ptr<DirconProcessor> processor(new DirconProcessor(
+        QList<DirconProcessorService *>() << service, QStringLiteral("QZ Test"), 0, QStringLiteral("1"),
+        QStringLiteral("00:11:22:33:44")));
+    EXPECT_TRUE(processor->init());
+    return processor;
+}
+
+std::vector<std::unique_ptr<QTcpSocket>> connectClients(quint16 port, int count,
+                                                        const std::function<int()> &accepted) {
+    std::vector<std::unique_ptr<QTcpSocket>> clients;
+    for (int i = 0; i < count; i++) {
+        clients.emplace_back(new QTcpSocket());
+        clients.back()->connectToHost(QHostAddress::LocalHost, port);
+        EXPECT_TRUE(clients.back()->waitForConnected(3000));
+    }
+    EXPECT_TRUE(waitFor([&] { return accepted() == count; }));
+    return clients;
+}
+
+void subscribe(QTcpSocket *client, quint16 uuid, bool enable) {
+    DirconPacket pkt;
+    pkt.isRequest = true;
+    pkt.Identifier = DPKT_MSGID_ENABLE_CHARACTERISTIC_NOTIFICATIONS;
+    pkt.uuid = uuid;
+    pkt.additional_data.append(enable ? 1 : 0);
+    client->write(pkt.encode(1));
+    EXPECT_TRUE(waitFor([client] { return client->bytesAvailable() >= subscriptionResponseSize; }));
+    client->readAll();
+}
+
+// the services of a trainer as DirconManager builds them, the characteristics looked up the most are the last ones
+QList<DirconProcessorService *> trainerServices() {
+    DirconProcessorService *ftms = new DirconProcessorService(QStringLiteral("FITNESS_MACHINE_CYCLE"), 0x1826, 0);
+    const quint16 ftmsChars[] = {0x2ACC, 0x2AD6, 0x2AD8, 0x2AD3, 0x2ADA, 0x2AD9, 0x2AD2};
+    for (quint16 uuid : ftmsChars) {
+        ftms->chars.append(new DirconProcessorCharacteristic(
+            uuid, DPKT_CHAR_PROP_FLAG_READ | DPKT_CHAR_PROP_FLAG_NOTIFY, QByteArray::fromHex("0c000000"), 0, ftms));
+    }
+    DirconProcessorService *power = new DirconProcessorService(QStringLiteral("CYCLING_POWER"), 0x1818, 0);
+    const quint16 powerChars[] = {0x2A65, 0x2A5D, 0x2A66, 0x2A63};
+    for (quint16 uuid : powerChars) {
+        power->chars.append(new DirconProcessorCharacteristic(
+            uuid, DPKT_CHAR_PROP_FLAG_READ | DPKT_CHAR_PROP_FLAG_NOTIFY, QByteArray::fromHex("08000000"), 0, power));
+    }
+    DirconProcessorService *heart = new DirconProcessorService(QStringLiteral("HEART_RATE"), 0x180D, 0);
+    heart->chars.append(new DirconProcessorCharacteristic(
+        heartRate, DPKT_CHAR_PROP_FLAG_READ | DPKT_CHAR_PROP_FLAG_NOTIFY, QByteArray::fromHex("0064"), 0, heart));
+    return QList<DirconProcessorService *>() << ftms << power << heart;
+}
+
+std::unique_ptr<DirconProcessor> newTrainer() {
+    // the processor isn't listening: the requests are given to processData
+    return std::unique_ptr<DirconProcessor>(new DirconProcessor(trainerServices(), QStringLiteral("QZ Test"), 0,
+                                                                QStringLiteral("1"), QStringLiteral("00:11:22:33:44")));
+}
+
+QByteArray request(quint8 identifier, quint16 uuid, const QByteArray &data, int seq) {
+    DirconPacket pkt;
+    pkt.isRequest = true;
+    pkt.Identifier = identifier;
+    pkt.uuid = uuid;
+    pkt.additional_data = data;
+    return pkt.encode(seq);
+}
+
+// one request of each kind, every one of them gets a response
+QByteArray requests(int count) {
+    QByteArray out;
+    for (int i = 0; i < count; i++) {
+        // the sequence number of a request differs from the one before
+        const int seq = (i % 255) + 1;
+        switch (i % 6) {
+        case 0:
+            out += request(DPKT_MSGID_DISCOVER_SERVICES, 0, QByteArray(), seq);
+            break;
+        case 1:
+            out += request(DPKT_MSGID_DISCOVER_CHARACTERISTICS, 0x1818, QByteArray(), seq);
+            break;
+        case 2:
+            out += request(DPKT_MSGID_READ_CHARACTERISTIC, heartRate, QByteArray(), seq);
+            break;
+        case 3:
+            out += request(DPKT_MSGID_ENABLE_CHARACTERISTIC_NOTIFICATIONS, indoorBikeData, QByteArray(1, i % 2), seq);
+            break;
+        case 4:
+            // not found
+            out += request(DPKT_MSGID_READ_CHARACTERISTIC, 0x1234, QByteArray(), seq);
+            break;
+        case 5:
+            // not writable
+            out += request(DPKT_MSGID_WRITE_CHARACTERISTIC, 0x2A63, QByteArray::fromHex("0001"), seq);
+            break;
+        }
+    }
+    return out;
+}
+
+// feeds the data to a new client in chunks of random sizes up to maxChunk, 0 for all at once
+QByteArray feed(DirconProcessor *processor, const QByteArray &data, int maxChunk, QRandomGenerator &random,
+                int *buffered = nullptr) {
+    // the subscriptions keep the client: it lives as long as the processor
+    DirconProcessorClient *client = new DirconProcessorClient(nullptr);
+    client->setParent(processor);
+    QByteArray responses;
+    int pos = 0;
+    while (pos < data.size()) {
+        const int chunk = maxChunk ? qMin(data.size() - pos, random.bounded(1, maxChunk + 1)) : data.size();
+        responses += processor->processData(client, data.mid(pos, chunk));
+        pos += chunk;
+    }
+    if (buffered) {
+        *buffered = client->buffer.size();
+    }
+    return responses;
+}
+
+// the request loop before the streaming parser: the rest of the buffer copied after every packet and the
+// characteristic searched in every service
+QByteArray legacyRead(const QList<DirconProcessorService *> &services, QByteArray &buffer, int &seq,
+                      const QByteArray &data) {
+    QByteArray responses;
+    buffer.append(data);
+    while (1) {
+        DirconPacket pkt;
+        const int buflimit = pkt.parse(buffer, seq);
+        if (buflimit <= 0) {
+            break;
+        }
+        buffer = buffer.mid(buflimit);
+        if (pkt.isRequest) {
+            seq = pkt.SequenceNumber;
+        }
+        DirconPacket out;
+        out.isRequest = false;
+        out.Identifier = pkt.Identifier;
+        bool cfound = false;
+        foreach (DirconProcessorService *service, services) {
+            foreach (DirconProcessorCharacteristic *cc, service->chars) {
+                if (cc->uuid == pkt.uuid) {
+                    cfound = true;
+                    out.uuid = pkt.uuid;
+                    out.ResponseCode = DPKT_RESPCODE_SUCCESS_REQUEST;
+                    out.additional_data.append(cc->read_values);
+                    break;
+                }
+            }
+            if (cfound) {
+                break;
+            }
+        }
+        if (!cfound) {
+            out.ResponseCode = DPKT_RESPCODE_CHARACTERISTIC_NOT_FOUND;
+        }
+        responses += out.encode(pkt.SequenceNumber);
+    }
+    return responses;
+}
+
+// what the processor did for every notification before encoding it once
+void legacySend(const QList<QTcpSocket *> &sockets, quint16 uuid, const QByteArray &data) {
+    DirconPacket pkt;
+    pkt.additional_data = data;
+    pkt.Identifier = DPKT_MSGID_UNSOLICITED_CHARACTERISTIC_NOTIFICATION;
+    pkt.ResponseCode = DPKT_RESPCODE_SUCCESS_REQUEST;
+    pkt.uuid = uuid;
+    for (QTcpSocket *socket : sockets) {
+        QSettings settings;
+        if (!settings.value(QZSettings::wahoo_rgt_dircon, QZSettings::default_wahoo_rgt_dircon).toBool()) {
+            socket->write(pkt.encode(0));
+        }
+    }
+}
+} // namespace
+
+DirconProcessorTestSuite::DirconProcessorTestSuite() {}
+
+void DirconProcessorTestSuite::test_subscriptions() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    std::unique_ptr<DirconProcessor> processor = newProcessor(testSettings, true);
+    std::vector<std::unique_ptr<QTcpSocket>> clients =
+        connectClients(processor->port(), 3, [&processor] { return processor->clientCount(); });
+    QTcpSocket *bike = clients.at(0).get();
+    QTcpSocket *heart = clients.at(1).get();
+    QTcpSocket *none = clients.at(2).get();
+
+    subscribe(bike, indoorBikeData, true);
+    subscribe(heart, heartRate, true);
+
+    const QByteArray data = QByteArray::fromHex("4402c409b400fa008c");
+    const QByteArray frame = DirconProcessor::encodeNotification(indoorBikeData, data);
+    EXPECT_TRUE(processor->sendCharacteristicNotification(indoorBikeData, data));
+    EXPECT_TRUE(waitFor([bike, &frame] { return bike->bytesAvailable() >= frame.size(); }));
+    processEvents(50);
+    EXPECT_EQ(bike->readAll(), frame);
+    EXPECT_EQ(heart->bytesAvailable(), 0);
+    EXPECT_EQ(none->bytesAvailable(), 0);
+
+    // the packet a client gets is the one it would parse
+    DirconPacket parsed;
+    EXPECT_EQ(parsed.parse(frame, 0), frame.size());
+    EXPECT_EQ(parsed.uuid, indoorBikeData);
+    EXPECT_EQ(parsed.additional_data, data);
+
+    subscribe(bike, indoorBikeData, false);
+    processor->sendCharacteristicNotification(indoorBikeData, data);
+    processEvents(50);
+    EXPECT_EQ(bike->bytesAvailable(), 0);
+
+    heart->disconnectFromHost();
+    EXPECT_TRUE(waitFor([&processor] { return processor->clientCount() == 2; }));
+    EXPECT_TRUE(processor->sendCharacteristicNotification(heartRate, QByteArray::fromHex("0064")));
+    processEvents(50);
+    EXPECT_EQ(bike->bytesAvailable(), 0);
+    EXPECT_EQ(none->bytesAvailable(), 0);
+    EXPECT_EQ(processor->dropped(), 0u);
+}
+
+void DirconProcessorTestSuite::test_allClients() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    std::unique_ptr<DirconProcessor> processor = newProcessor(testSettings, false);
+    std::vector<std::unique_ptr<QTcpSocket>> clients =
+        connectClients(processor->port(), 3, [&processor] { return processor->clientCount(); });
+
+    const QByteArray data = QByteArray::fromHex("0064");
+    const QByteArray frame = DirconProcessor::encodeNotification(heartRate, data);
+    EXPECT_TRUE(processor->sendCharacteristicNotification(heartRate, data));
+    for (const std::unique_ptr<QTcpSocket> &client : clients) {
+        QTcpSocket *socket = client.get();
+        EXPECT_TRUE(waitFor([socket, &frame] { return socket->bytesAvailable() >= frame.size(); }));
+        EXPECT_EQ(socket->readAll(), frame);
+    }
+}
+
+void DirconProcessorTestSuite::test_slowClient() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    std::unique_ptr<DirconProcessor> processor = newProcessor(testSettings, false);
+    processor->setMaxQueuedBytes(16 * 1024);
+
+    // the slow client never reads: its kernel buffers fill up, then the queue of the processor
+    QTcpSocket slow;
+    slow.setReadBufferSize(1);
+    slow.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 4096);
+    slow.connectToHost(QHostAddress::LocalHost, processor->port());
+    ASSERT_TRUE(slow.waitForConnected(3000));
+    QTcpSocket fast;
+    qint64 received = 0;
+    QObject::connect(&fast, &QTcpSocket::readyRead, [&fast, &received] { received += fast.readAll().size(); });
+    fast.connectToHost(QHostAddress::LocalHost, processor->port());
+    ASSERT_TRUE(fast.waitForConnected(3000));
+    ASSERT_TRUE(waitFor([&processor] { return processor->clientCount() == 2; }));
+
+    const int notifications = 4000;
+    const QByteArray data(500, 'x');
+    const int frameSize = DirconProcessor::encodeNotification(indoorBikeData, data).size();
+    for (int i = 0; i < notifications; i++) {
+        processor->sendCharacteristicNotification(indoorBikeData, data);
+        if (i % 10 == 9) {
+            QCoreApplication::processEvents();
+        }
+    }
+    EXPECT_TRUE(waitFor([&received, frameSize] { return received >= qint64(notifications) * frameSize; }, 10000));
+    EXPECT_EQ(received, qint64(notifications) * frameSize);
+    EXPECT_GT(processor->dropped(), 0u);
+    EXPECT_LT(processor->dropped(), quint64(notifications));
+}
+
+void DirconProcessorTestSuite::test_identicalFrames() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    std::unique_ptr<DirconProcessor> processor = newProcessor(testSettings, true);
+    const int clientsCount = 8;
+    std::vector<std::unique_ptr<QTcpSocket>> clients =
+        connectClients(processor->port(), clientsCount, [&processor] { return processor->clientCount(); });
+    for (const std::unique_ptr<QTcpSocket> &client : clients) {
+        subscribe(client.get(), indoorBikeData, true);
+    }
+
+    QByteArray expected;
+    for (int i = 0; i < 50; i++) {
+        QByteArray data = QByteArray::fromHex("4402c409b400fa008c");
+        data[2] = char(i);
+        // encoded once, written as it is to every subscriber
+        const QByteArray frame = DirconProcessor::encodeNotification(indoorBikeData, data);
+        EXPECT_TRUE(processor->sendEncodedNotification(indoorBikeData, frame));
+        expected += frame;
+    }
+    for (const std::unique_ptr<QTcpSocket> &client : clients) {
+        QTcpSocket *socket = client.get();
+        EXPECT_TRUE(waitFor([socket, &expected] { return socket->bytesAvailable() >= expected.size(); }));
+        EXPECT_EQ(socket->readAll(), expected);
+    }
+    EXPECT_EQ(processor->dropped(), 0u);
+}
+
+void DirconProcessorTestSuite::test_queueLimit() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    std::unique_ptr<DirconProcessor> processor = newProcessor(testSettings, false);
+    std::vector<std::unique_ptr<QTcpSocket>> clients =
+        connectClients(processor->port(), 1, [&processor] { return processor->clientCount(); });
+    QTcpSocket *client = clients.at(0).get();
+
+    // without the event loop nothing leaves the socket of the processor: the queue only grows
+    const QByteArray frame = DirconProcessor::encodeNotification(indoorBikeData, QByteArray(500, 'x'));
+    const int notifications = 100;
+    for (int i = 0; i < notifications; i++) {
+        processor->sendEncodedNotification(indoorBikeData, frame);
+    }
+    const int queued = DP_CLIENT_MAX_QUEUED_BYTES / frame.size();
+    EXPECT_EQ(processor->dropped(), quint64(notifications - queued));
+
+    // the frames queued are delivered whole
+    const qint64 queuedBytes = qint64(queued) * frame.size();
+    EXPECT_TRUE(waitFor([client, queuedBytes] { return client->bytesAvailable() >= queuedBytes; }));
+    processEvents(50);
+    EXPECT_EQ(client->readAll(), frame.repeated(queued));
+
+    // once the queue is drained the client gets the notifications again
+    EXPECT_TRUE(processor->sendEncodedNotification(indoorBikeData, frame));
+    EXPECT_TRUE(waitFor([client, &frame] { return client->bytesAvailable() >= frame.size(); }));
+    EXPECT_EQ(client->readAll(), frame);
+    EXPECT_EQ(processor->dropped(), quint64(notifications - queued));
+}
+
+void DirconProcessorTestSuite::test_benchmarkFanOut() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    const int clientsCount = 8;
+    const int notifications = 5000;
+    const QByteArray data = QByteArray::fromHex("4402c409b400fa008c0000");
+
+    // the same number of local connections for both, the clients drain them between the batches
+    auto drain = [](std::vector<std::unique_ptr<QTcpSocket>> &clients) {
+        QCoreApplication::processEvents();
+        for (const std::unique_ptr<QTcpSocket> &client : clients) {
+            client->readAll();
+        }
+    };
+
+    QTcpServer legacyServer;
+    ASSERT_TRUE(legacyServer.listen(QHostAddress::LocalHost, 0));
+    QList<QTcpSocket *> legacySockets;
+    QObject::connect(&legacyServer, &QTcpServer::newConnection,
+                     [&] { legacySockets.append(legacyServer.nextPendingConnection()); });
+    std::vector<std::unique_ptr<QTcpSocket>> legacyClients =
+        connectClients(legacyServer.serverPort(), clientsCount, [&legacySockets] { return legacySockets.count(); });
+    qint64 legacyNs = 0;
+    QElapsedTimer timer;
+    for (int i = 0; i < notifications; i++) {
+        timer.start();
+        legacySend(legacySockets, indoorBikeData, data);
+        legacyNs += timer.nsecsElapsed();
+        if (i % 10 == 9) {
+            drain(legacyClients);
+        }
+    }
+
+    std::unique_ptr<DirconProcessor> processor = newProcessor(testSettings, false);
+    std::vector<std::unique_ptr<QTcpSocket>> clients =
+        connectClients(processor->port(), clientsCount, [&processor] { return processor->clientCount(); });
+    qint64 fanOutNs = 0;
+    for (int i = 0; i < notifications; i++) {
+        timer.start();
+        processor->sendCharacteristicNotification(indoorBikeData, data);
+        fanOutNs += timer.nsecsElapsed();
+        if (i % 10 == 9) {
+            drain(clients);
+        }
+    }
+
+    EXPECT_EQ(processor->dropped(), 0u);
+
+    RecordProperty("legacyNsPerNotification", static_cast<int>(legacyNs / notifications));
+    RecordProperty("fanOutNsPerNotification", static_cast<int>(fanOutNs / notifications));
+}
+
+void DirconProcessorTestSuite::test_streamChunks() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    std::unique_ptr<DirconProcessor> processor = newTrainer();
+    QRandomGenerator random(1234);
+    const int count = 600;
+    const QByteArray stream = requests(count);
+
+    int buffered = -1;
+    const QByteArray whole = feed(processor.get(), stream, 0, random, &buffered);
+    EXPECT_EQ(buffered, 0);
+    EXPECT_EQ(feed(processor.get(), stream, 1, random), whole);
+    EXPECT_EQ(feed(processor.get(), stream, 7, random), whole);
+    EXPECT_EQ(feed(processor.get(), stream, 1460, random), whole);
+
+    // a response for every request, in order and with its sequence number
+    int pos = 0;
+    int responses = 0;
+    while (pos < whole.size()) {
+        DirconPacket pkt;
+        const int rv = pkt.parse(whole.constData() + pos, whole.size() - pos, 0);
+        ASSERT_GT(rv, 0);
+        EXPECT_EQ(pkt.SequenceNumber, (responses % 255) + 1);
+        switch (responses % 6) {
+        case 0:
+            EXPECT_EQ(pkt.Identifier, DPKT_MSGID_DISCOVER_SERVICES);
+            EXPECT_EQ(pkt.uuids, QList<quint16>() << 0x1826 << 0x1818 << 0x180D);
+            break;
+        case 1:
+            EXPECT_EQ(pkt.Identifier, DPKT_MSGID_DISCOVER_CHARACTERISTICS);
+            EXPECT_EQ(pkt.uuids, QList<quint16>() << 0x2A65 << 0x2A5D << 0x2A66 << 0x2A63);
+            break;
+        case 2:
+            EXPECT_EQ(pkt.Identifier, DPKT_MSGID_READ_CHARACTERISTIC);
+            EXPECT_EQ(pkt.uuid, heartRate);
+            EXPECT_EQ(pkt.additional_data, QByteArray::fromHex("0064"));
+            break;
+        case 3:
+            EXPECT_EQ(pkt.Identifier, DPKT_MSGID_ENABLE_CHARACTERISTIC_NOTIFICATIONS);
+            EXPECT_EQ(pkt.ResponseCode, DPKT_RESPCODE_SUCCESS_REQUEST);
+            break;
+        case 4:
+            EXPECT_EQ(pkt.ResponseCode, DPKT_RESPCODE_CHARACTERISTIC_NOT_FOUND);
+            break;
+        case 5:
+            EXPECT_EQ(pkt.ResponseCode, DPKT_RESPCODE_CHARACTERISTIC_OPERATION_NOT_SUPPORTED);
+            break;
+        }
+        pos += rv;
+        responses++;
+    }
+    EXPECT_EQ(responses, count);
+}
+
+void DirconProcessorTestSuite::test_fuzz() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    std::unique_ptr<DirconProcessor> processor = newTrainer();
+    QRandomGenerator random(4321);
+    const QByteArray valid = requests(60);
+
+    for (int i = 0; i < 2000; i++) {
+        QByteArray input;
+        switch (i % 3) {
+        case 0: {
+            // valid requests with a few bytes changed
+            input = valid;
+            const int flips = random.bounded(1, 8);
+            for (int f = 0; f < flips; f++) {
+                input[random.bounded(input.size())] = char(random.bounded(256));
+            }
+            break;
+        }
+        case 1: {
+            // headers with small lengths followed by random bytes
+            for (int p = 0; p < 40; p++) {
+                const int length = random.bounded(24);
+                input.append(char(1)).append(char(random.bounded(8))).append(char(random.bounded(256)));
+                input.append(char(random.bounded(3))).append(char(0)).append(char(length));
+                for (int b = 0; b < length; b++) {
+                    input.append(char(random.bounded(256)));
+                }
+            }
+            break;
+        }
+        default:
+            input.resize(random.bounded(1, 512));
+            for (int b = 0; b < input.size(); b++) {
+                input[b] = char(random.bounded(256));
+            }
+            break;
+        }
+
+        int buffered = -1;
+        const QByteArray whole = feed(processor.get(), input, 0, random, &buffered);
+        // only an incomplete packet is kept
+        EXPECT_GE(buffered, 0);
+        EXPECT_LE(buffered, input.size());
+        EXPECT_LT(buffered, DPKT_MESSAGE_HEADER_LENGTH + 65536);
+        ASSERT_EQ(feed(processor.get(), input, 1 + i % 64, random), whole) << "input " << input.toHex().constData();
+
+        // the responses are well formed packets
+        int pos = 0;
+        while (pos < whole.size()) {
+            DirconPacket pkt;
+            const int rv = pkt.parse(whole.constData() + pos, whole.size() - pos, 0);
+            ASSERT_GT(rv, 0) << "responses " << whole.toHex().constData();
+            pos += rv;
+        }
+    }
+}
+
+void DirconProcessorTestSuite::test_benchmarkRequests() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    std::unique_ptr<DirconProcessor> processor = newTrainer();
+    const QList<DirconProcessorService *> services = trainerServices();
+    // several apps reading the power and heart rate, the requests come in segments of a TCP packet
+    const int apps = 3;
+    const int count = 30000;
+    const int segment = 1460;
+    QByteArray stream;
+    for (int i = 0; i < count; i++) {
+        stream += request(DPKT_MSGID_READ_CHARACTERISTIC, i % 2 ? heartRate : 0x2A63, QByteArray(), (i % 255) + 1);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int a = 0; a < apps; a++) {
+        QByteArray buffer;
+        int seq = 0;
+        for (int pos = 0; pos < stream.size(); pos += segment) {
+            legacyRead(services, buffer, seq, stream.mid(pos, segment));
+        }
+    }
+    const qint64 legacyNs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int a = 0; a < apps; a++) {
+        DirconProcessorClient client(nullptr);
+        for (int pos = 0; pos < stream.size(); pos += segment) {
+            processor->processData(&client, stream.mid(pos, segment));
+        }
+    }
+    const qint64 streamNs = timer.nsecsElapsed();
+
+    // the responses are checked by test_streamChunks: the benchmark only measures
+    const double requests = double(apps) * count;
+    RecordProperty("legacyRequestsPerSecond", static_cast<int>(requests * 1e9 / legacyNs));
+    RecordProperty("requestsPerSecond", static_cast<int>(requests * 1e9 / streamNs));
+    qDeleteAll(services);
+}
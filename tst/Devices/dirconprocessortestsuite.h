@@ -0,0 +1,84 @@
+#ifndef DIRCONPROCESSORTESTSUITE_H
+#define DIRCONPROCESSORTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class DirconProcessorTestSuite : public testing::Test {
+
+  public:
+    DirconProcessorTestSuite();
+
+    /**
+     * @brief Test that with wahoo_rgt_dircon the notifications go only to the clients subscribed to the
+     * characteristic, and that the subscriptions follow the clients enabling, disabling and disconnecting.
+     */
+    void test_subscriptions();
+
+    /**
+     * @brief Test that without wahoo_rgt_dircon every client gets the same packet.
+     */
+    void test_allClients();
+
+    /**
+     * @brief Test that a client not reading its socket gets its notifications dropped once its queue is full, while
+     * the other clients get all of them.
+     */
+    void test_slowClient();
+
+    /**
+     * @brief Test that a notification encoded once reaches every subscriber with the same bytes.
+     */
+    void test_identicalFrames();
+
+    /**
+     * @brief Test that the notifications beyond DP_CLIENT_MAX_QUEUED_BYTES still to be sent to a client are dropped,
+     * that the ones queued arrive whole and that the client gets the notifications again once its queue is drained.
+     */
+    void test_queueLimit();
+
+    /**
+     * @brief Compare the cost of a notification sent to several local clients encoding it once with the cost of
+     * reading the settings and encoding it for every client.
+     * Disabled by default, run it with --gtest_also_run_disabled_tests: the timings are recorded as test properties.
+     */
+    void test_benchmarkFanOut();
+
+    /**
+     * @brief Test that the responses to a stream of requests don't depend on how the stream is split, down to one
+     * byte at a time, and that every request gets its response.
+     */
+    void test_streamChunks();
+
+    /**
+     * @brief Feed random and corrupted requests: the processor must not crash, must answer the same however the bytes
+     * are split, and must keep no more than the incomplete packet at the end.
+     */
+    void test_fuzz();
+
+    /**
+     * @brief Compare the requests per second answered with the cursor and the uuid index with copying the buffer after
+     * every packet and searching every service.
+     * Disabled by default, run it with --gtest_also_run_disabled_tests: the rates are recorded as test properties.
+     */
+    void test_benchmarkRequests();
+};
+
+TEST_F(DirconProcessorTestSuite, TestSubscriptions) { this->test_subscriptions(); }
+
+TEST_F(DirconProcessorTestSuite, TestAllClients) { this->test_allClients(); }
+
+TEST_F(DirconProcessorTestSuite, TestSlowClient) { this->test_slowClient(); }
+
+TEST_F(DirconProcessorTestSuite, TestIdenticalFrames) { this->test_identicalFrames(); }
+
+TEST_F(DirconProcessorTestSuite, TestQueueLimit) { this->test_queueLimit(); }
+
+TEST_F(DirconProcessorTestSuite, DISABLED_BenchmarkFanOut) { this->test_benchmarkFanOut(); }
+
+TEST_F(DirconProcessorTestSuite, TestStreamChunks) { this->test_streamChunks(); }
+
+TEST_F(DirconProcessorTestSuite, TestFuzz) { this->test_fuzz(); }
+
+TEST_F(DirconProcessorTestSuite, DISABLED_BenchmarkRequests) { this->test_benchmarkRequests(); }
+
+#endif // DIRCONPROCESSORTESTSUITE_H
@@ -0,0 +1,188 @@
+#include "ftmsdecodertestsuite.h"
+
+#include "devices/ftmsdecoder.h"
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QVector>
+
+namespace {
+QByteArray packet(std::initializer_list<int> bytes) {
+    QByteArray p;
+    for (int b : bytes) {
+        p.append((char)b);
+    }
+    return p;
+}
+
+// the indoor bike parsing of ftmsbike before the decoder, for the benchmark
+double handParse(const QByteArray &newValue) {
+    uint16_t flags = (((uint16_t)(uint8_t)newValue.at(1)) << 8) | (uint8_t)newValue.at(0);
+    int index = 2;
+    double sum = 0;
+    if (!(flags & 0x01)) {
+        sum += ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
+                         (uint16_t)((uint8_t)newValue.at(index)))) /
+               100.0;
+        index += 2;
+    }
+    if (flags & 0x04) {
+        sum += ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
+                         (uint16_t)((uint8_t)newValue.at(index)))) /
+               2.0;
+        index += 2;
+    }
+    if (flags & 0x40) {
+        sum += ((double)(((uint16_t)((uint8_t)newValue.at(index + 1)) << 8) |
+                         (uint16_t)((uint8_t)newValue.at(index))));
+        index += 2;
+    }
+    if ((flags & 0x200) && newValue.length() > index) {
+        sum += ((double)(((uint8_t)newValue.at(index))));
+    }
+    return sum;
+}
+} // namespace
+
+FtmsDecoderTestSuite::FtmsDecoderTestSuite() {}
+
+void FtmsDecoderTestSuite::test_dataCharacteristics() {
+    ftmsdecoder::data d;
+
+    // speed 25.00 km/h, cadence 90 rpm, power 250 W, heart 140 bpm
+    EXPECT_TRUE(ftmsdecoder::decode(ftmsdecoder::INDOOR_BIKE,
+                                    packet({0x44, 0x02, 0xC4, 0x09, 0xB4, 0x00, 0xFA, 0x00, 0x8C}), d));
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::INSTANT_SPEED), 25.0);
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::INSTANT_CADENCE), 90.0);
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::INSTANT_POWER), 250.0);
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::HEART_RATE), 140.0);
+    EXPECT_FALSE(d.has(ftmsdecoder::RESISTANCE));
+    EXPECT_EQ(d.length, 9);
+
+    // the flags low byte above 0x7f: more data, average power, no instantaneous speed
+    EXPECT_TRUE(ftmsdecoder::decode(ftmsdecoder::INDOOR_BIKE, packet({0x81, 0x00, 0x10, 0x00}), d));
+    EXPECT_FALSE(d.has(ftmsdecoder::INSTANT_SPEED));
+    EXPECT_FALSE(d.has(ftmsdecoder::HEART_RATE));
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::AVG_POWER), 16.0);
+
+    // speed 10.00 km/h, inclination -1.0 %, ramp 0
+    EXPECT_TRUE(
+        ftmsdecoder::decode(ftmsdecoder::TREADMILL, packet({0x08, 0x00, 0xE8, 0x03, 0xF6, 0xFF, 0x00, 0x00}), d));
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::INSTANT_SPEED), 10.0);
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::INCLINATION), -1.0);
+    EXPECT_TRUE(d.has(ftmsdecoder::RAMP_ANGLE));
+
+    // stroke rate 26 (raw 52), 120 strokes, pace 125 s/500m, power 180 W
+    EXPECT_TRUE(ftmsdecoder::decode(ftmsdecoder::ROWER,
+                                    packet({0x28, 0x00, 0x34, 0x78, 0x00, 0x7D, 0x00, 0xB4, 0x00}), d));
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::STROKE_RATE), 26.0);
+    EXPECT_EQ(d.rawValue(ftmsdecoder::STROKE_RATE), 52);
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::STROKE_COUNT), 120.0);
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::INSTANT_PACE), 125.0);
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::INSTANT_POWER), 180.0);
+
+    // 3 bytes of flags: speed 8.00 km/h, 60 steps per minute, resistance 5, movement direction backward
+    EXPECT_TRUE(ftmsdecoder::decode(ftmsdecoder::CROSS_TRAINER,
+                                    packet({0x88, 0x80, 0x00, 0x20, 0x03, 0x3C, 0x00, 0x3A, 0x00, 0x05, 0x00}), d));
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::INSTANT_SPEED), 8.0);
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::STEP_RATE), 60.0);
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::AVG_STEP_RATE), 58.0);
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::RESISTANCE), 5.0);
+    EXPECT_TRUE(d.flags & 0x8000);
+
+    ftmsdecoder::TYPE type;
+    EXPECT_TRUE(ftmsdecoder::typeOf(0x2ACD, type));
+    EXPECT_EQ(type, ftmsdecoder::TREADMILL);
+    EXPECT_FALSE(ftmsdecoder::typeOf(0x2AD9, type));
+}
+
+void FtmsDecoderTestSuite::test_truncated() {
+    ftmsdecoder::data d;
+
+    // the power is cut in half, the heart rate is missing
+    EXPECT_FALSE(ftmsdecoder::decode(ftmsdecoder::INDOOR_BIKE, packet({0x44, 0x02, 0xC4, 0x09, 0xB4, 0x00, 0xFA}), d));
+    EXPECT_TRUE(d.truncated);
+    EXPECT_DOUBLE_EQ(d.value(ftmsdecoder::INSTANT_CADENCE), 90.0);
+    EXPECT_FALSE(d.has(ftmsdecoder::INSTANT_POWER));
+    EXPECT_FALSE(d.has(ftmsdecoder::HEART_RATE));
+    EXPECT_EQ(d.length, 6);
+
+    EXPECT_FALSE(ftmsdecoder::decode(ftmsdecoder::CROSS_TRAINER, packet({0x00, 0x00}), d));
+    EXPECT_EQ(d.present, Q_UINT64_C(0));
+}
+
+void FtmsDecoderTestSuite::test_controlPoint() {
+    ftmsdecoder::controlpoint c;
+
+    // simulation: wind 0, grade 3.00 %, crr 0.0040, cw 0.51
+    EXPECT_TRUE(ftmsdecoder::decodeControlPoint(packet({0x11, 0x00, 0x00, 0x2C, 0x01, 0x28, 0x33}), c));
+    EXPECT_EQ(c.opcode, 0x11);
+    EXPECT_EQ(c.params, 4);
+    EXPECT_DOUBLE_EQ(c.value(1), 3.0);
+    EXPECT_EQ(c.rawValue(1), 300);
+    EXPECT_EQ(c.rawValue(2), 40);
+    EXPECT_EQ(c.rawValue(3), 51);
+
+    // target resistance 20.0, the byte is unsigned
+    EXPECT_TRUE(ftmsdecoder::decodeControlPoint(packet({0x04, 0xC8}), c));
+    EXPECT_DOUBLE_EQ(c.value(0), 20.0);
+
+    // target inclination -2.5 %
+    EXPECT_TRUE(ftmsdecoder::decodeControlPoint(packet({0x03, 0xE7, 0xFF}), c));
+    EXPECT_DOUBLE_EQ(c.value(0), -2.5);
+
+    EXPECT_TRUE(ftmsdecoder::decodeControlPoint(packet({0x00}), c));
+    EXPECT_EQ(c.params, 0);
+
+    EXPECT_FALSE(ftmsdecoder::decodeControlPoint(packet({0x05, 0xC8}), c));
+    EXPECT_TRUE(c.truncated);
+    EXPECT_FALSE(ftmsdecoder::decodeControlPoint(QByteArray(), c));
+}
+
+void FtmsDecoderTestSuite::test_fuzz() {
+    QRandomGenerator random(1234);
+    ftmsdecoder::data d;
+    ftmsdecoder::controlpoint c;
+    char buffer[32];
+    for (int i = 0; i < 100000; i++) {
+        int length = random.bounded(24);
+        for (int j = 0; j < length; j++) {
+            buffer[j] = (char)random.bounded(256);
+        }
+        ftmsdecoder::decode((ftmsdecoder::TYPE)(i % ftmsdecoder::TYPES), buffer, length, d);
+        ASSERT_LE(d.length, length);
+        ASSERT_EQ(d.present >> ftmsdecoder::FIELDS, Q_UINT64_C(0));
+
+        ftmsdecoder::decodeControlPoint(QByteArray(buffer, length), c);
+        ASSERT_LE(c.params, 4);
+    }
+}
+
+void FtmsDecoderTestSuite::test_benchmarkDecode() {
+    // what a trainer sends: speed, cadence, power and heart rate
+    const QByteArray data = packet({0x44, 0x02, 0xC4, 0x09, 0xB4, 0x00, 0xFA, 0x00, 0x8C});
+    const int packets = 200000;
+
+    double sink = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < packets; i++) {
+        sink += handParse(data);
+    }
+    qint64 handNs = timer.nsecsElapsed();
+
+    double decoded = 0;
+    ftmsdecoder::data d;
+    timer.restart();
+    for (int i = 0; i < packets; i++) {
+        ftmsdecoder::decode(ftmsdecoder::INDOOR_BIKE, data, d);
+        decoded += d.value(ftmsdecoder::INSTANT_SPEED) + d.value(ftmsdecoder::INSTANT_CADENCE) +
+                   d.value(ftmsdecoder::INSTANT_POWER) + d.value(ftmsdecoder::HEART_RATE);
+    }
+    qint64 decoderNs = timer.nsecsElapsed();
+
+    RecordProperty("handNsPerPacket", static_cast<int>(handNs / packets));
+    RecordProperty("decoderNsPerPacket", static_cast<int>(decoderNs / packets));
+
+    EXPECT_DOUBLE_EQ(sink, decoded);
+}
@@ -0,0 +1,49 @@
+#ifndef FTMSDECODERTESTSUITE_H
+#define FTMSDECODERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class FtmsDecoderTestSuite : public testing::Test {
+
+  public:
+    FtmsDecoderTestSuite();
+
+    /**
+     * @brief Test the fields, the resolutions and the signs decoded from known indoor bike, treadmill, rower and cross
+     * trainer packets.
+     */
+    void test_dataCharacteristics();
+
+    /**
+     * @brief Test that the fields before a truncated one are still decoded and the ones after it aren't.
+     */
+    void test_truncated();
+
+    /**
+     * @brief Test the parameters of the control point requests.
+     */
+    void test_controlPoint();
+
+    /**
+     * @brief Decode random packets of every type and check that nothing is read past the end of the packet.
+     */
+    void test_fuzz();
+
+    /**
+     * @brief Compare the decoding throughput with the hand written parsing of the indoor bike data it replaced.
+     * Disabled by default, run it with --gtest_also_run_disabled_tests: the timings are recorded as test properties.
+     */
+    void test_benchmarkDecode();
+};
+
+TEST_F(FtmsDecoderTestSuite, TestDataCharacteristics) { this->test_dataCharacteristics(); }
+
+TEST_F(FtmsDecoderTestSuite, TestTruncated) { this->test_truncated(); }
+
+TEST_F(FtmsDecoderTestSuite, TestControlPoint) { this->test_controlPoint(); }
+
+TEST_F(FtmsDecoderTestSuite, TestFuzz) { this->test_fuzz(); }
+
+TEST_F(FtmsDecoderTestSuite, DISABLED_BenchmarkDecode) { this->test_benchmarkDecode(); }
+
+#endif // FTMSDECODERTESTSUITE_H
@@ -0,0 +1,219 @@
+#include "gattwritequeuetestsuite.h"
+
+#include "devices/gattwritequeue.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QTimer>
+#include <functional>
+
+namespace {
+const QBluetoothUuid controlPoint((quint16)0x2AD9);
+const QBluetoothUuid customWrite((quint16)0xFFF2);
+
+// records the writes instead of sending them, the tests acknowledge them by emitting the signals
+class fakegattservice : public gattwriteservice {
+  public:
+    void writeCharacteristic(const QBluetoothUuid &characteristic, const QByteArray &data,
+                             QLowEnergyService::WriteMode) override {
+        if (characteristic == controlPoint) {
+            controlPointWrites.append(data);
+        } else {
+            customWrites.append(data);
+        }
+        if (onWrite) {
+            onWrite(characteristic, data);
+        }
+    }
+
+    QList<QByteArray> controlPointWrites;
+    QList<QByteArray> customWrites;
+    std::function<void(const QBluetoothUuid &, const QByteArray &)> onWrite;
+};
+
+gattwritequeue::completion record(QList<QByteArray> *done, const QByteArray &data) {
+    return [done, data](bool ok) { done->append(data + (ok ? " ok" : " failed")); };
+}
+
+bool waitFor(const std::function<bool()> &done, int ms) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!done()) {
+        if (timer.elapsed() > ms) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        QThread::msleep(1);
+    }
+    return true;
+}
+} // namespace
+
+GattWriteQueueTestSuite::GattWriteQueueTestSuite() {}
+
+void GattWriteQueueTestSuite::test_perCharacteristicOrdering() {
+    gattwritequeue queue;
+    fakegattservice service;
+    QList<QByteArray> done;
+
+    queue.write(&service, controlPoint, "a1", QLowEnergyService::WriteWithResponse, false, record(&done, "a1"));
+    queue.write(&service, controlPoint, "a2", QLowEnergyService::WriteWithResponse, false, record(&done, "a2"));
+    queue.write(&service, customWrite, "b1", QLowEnergyService::WriteWithResponse, false, record(&done, "b1"));
+    queue.write(&service, controlPoint, "a3", QLowEnergyService::WriteWithResponse, false, record(&done, "a3"));
+    EXPECT_EQ(service.controlPointWrites, QList<QByteArray>({"a1"}));
+    EXPECT_EQ(service.customWrites, QList<QByteArray>({"b1"}));
+    EXPECT_EQ(queue.depth(), 4);
+    EXPECT_EQ(queue.maxDepth(), 4);
+
+    // the ack of another value doesn't complete the write
+    emit service.characteristicWritten(controlPoint, "xx");
+    EXPECT_EQ(service.controlPointWrites, QList<QByteArray>({"a1"}));
+
+    // nor the ack of another characteristic
+    emit service.characteristicWritten(customWrite, "b1");
+    EXPECT_EQ(done, QList<QByteArray>({"b1 ok"}));
+    EXPECT_EQ(service.controlPointWrites, QList<QByteArray>({"a1"}));
+
+    emit service.characteristicWritten(controlPoint, "a1");
+    EXPECT_EQ(service.controlPointWrites, QList<QByteArray>({"a1", "a2"}));
+
+    // some stacks don't report the value written
+    emit service.characteristicWritten(controlPoint, QByteArray());
+    EXPECT_EQ(service.controlPointWrites, QList<QByteArray>({"a1", "a2", "a3"}));
+
+    emit service.characteristicWritten(controlPoint, "a3");
+    EXPECT_EQ(done, QList<QByteArray>({"b1 ok", "a1 ok", "a2 ok", "a3 ok"}));
+    EXPECT_EQ(queue.depth(), 0);
+    EXPECT_EQ(queue.acked(), 4);
+    EXPECT_EQ(queue.failed(), 0);
+}
+
+void GattWriteQueueTestSuite::test_acknowledgements() {
+    gattwritequeue queue;
+    fakegattservice service;
+    QList<QByteArray> done;
+
+    queue.write(&service, controlPoint, "a1", QLowEnergyService::WriteWithResponse, true, record(&done, "a1"));
+    emit service.characteristicWritten(controlPoint, "a1");
+    EXPECT_TRUE(done.isEmpty());
+    emit service.characteristicChanged(customWrite);
+    EXPECT_TRUE(done.isEmpty());
+    emit service.characteristicChanged(controlPoint);
+    EXPECT_EQ(done, QList<QByteArray>({"a1 ok"}));
+
+    queue.write(&service, customWrite, "b1", QLowEnergyService::WriteWithoutResponse, false, record(&done, "b1"));
+    queue.write(&service, customWrite, "b2", QLowEnergyService::WriteWithoutResponse, false, record(&done, "b2"));
+    EXPECT_EQ(service.customWrites, QList<QByteArray>({"b1"}));
+    ASSERT_TRUE(waitFor([&done]() { return done.count() == 3; }, 5000));
+    EXPECT_EQ(done, QList<QByteArray>({"a1 ok", "b1 ok", "b2 ok"}));
+    EXPECT_EQ(service.customWrites, QList<QByteArray>({"b1", "b2"}));
+}
+
+void GattWriteQueueTestSuite::test_timeout() {
+    gattwritequeue queue;
+    fakegattservice service;
+    QList<QByteArray> done;
+    queue.setTimeoutMs(20);
+
+    // the completion of a1 runs before a2 is sent: a2 gets a timeout the test can't miss
+    queue.write(&service, controlPoint, "a1", QLowEnergyService::WriteWithResponse, false,
+                [&done, &queue](bool ok) {
+                    record(&done, "a1")(ok);
+                    queue.setTimeoutMs(60000);
+                });
+    queue.write(&service, controlPoint, "a2", QLowEnergyService::WriteWithResponse, false, record(&done, "a2"));
+
+    ASSERT_TRUE(waitFor([&done]() { return done.count() == 1; }, 5000));
+    EXPECT_EQ(done, QList<QByteArray>({"a1 failed"}));
+    EXPECT_EQ(service.controlPointWrites, QList<QByteArray>({"a1", "a2"}));
+    EXPECT_EQ(queue.failed(), 1);
+
+    emit service.characteristicWritten(controlPoint, "a2");
+    EXPECT_EQ(done, QList<QByteArray>({"a1 failed", "a2 ok"}));
+    EXPECT_EQ(queue.acked(), 1);
+}
+
+void GattWriteQueueTestSuite::test_retry() {
+    gattwritequeue queue;
+    fakegattservice service;
+    QList<QByteArray> done;
+    queue.setTimeoutMs(20);
+    queue.setRetries(2);
+
+    queue.write(&service, controlPoint, "a1", QLowEnergyService::WriteWithResponse, false, record(&done, "a1"));
+    ASSERT_TRUE(waitFor([&done]() { return done.count() == 1; }, 5000));
+    EXPECT_EQ(done, QList<QByteArray>({"a1 failed"}));
+    EXPECT_EQ(service.controlPointWrites, QList<QByteArray>({"a1", "a1", "a1"}));
+
+    // the device answers the second attempt, before its timeout
+    int attempts = 0;
+    service.onWrite = [&service, &attempts](const QBluetoothUuid &characteristic, const QByteArray &data) {
+        if (++attempts == 2) {
+            QTimer::singleShot(0, &service, [&service, characteristic, data]() {
+                emit service.characteristicWritten(characteristic, data);
+            });
+        }
+    };
+    queue.write(&service, controlPoint, "a2", QLowEnergyService::WriteWithResponse, false, record(&done, "a2"));
+    ASSERT_TRUE(waitFor([&done]() { return done.count() == 2; }, 5000));
+    EXPECT_EQ(done, QList<QByteArray>({"a1 failed", "a2 ok"}));
+    EXPECT_EQ(service.controlPointWrites, QList<QByteArray>({"a1", "a1", "a1", "a2", "a2"}));
+    EXPECT_EQ(queue.acked(), 1);
+    EXPECT_EQ(queue.failed(), 1);
+}
+
+void GattWriteQueueTestSuite::test_serviceError() {
+    gattwritequeue queue;
+    fakegattservice service;
+    QList<QByteArray> done;
+
+    queue.write(&service, controlPoint, "a1", QLowEnergyService::WriteWithResponse, false, record(&done, "a1"));
+    emit service.error(QLowEnergyService::CharacteristicWriteError);
+    EXPECT_EQ(done, QList<QByteArray>({"a1 failed"}));
+
+    // the errors of the other operations are not about the writes
+    queue.write(&service, controlPoint, "a2", QLowEnergyService::WriteWithResponse, false, record(&done, "a2"));
+    emit service.error(QLowEnergyService::DescriptorWriteError);
+    EXPECT_EQ(done, QList<QByteArray>({"a1 failed"}));
+
+    // with two writes in flight the error can't be assigned to one of them
+    queue.write(&service, customWrite, "b1", QLowEnergyService::WriteWithResponse, false, record(&done, "b1"));
+    emit service.error(QLowEnergyService::CharacteristicWriteError);
+    EXPECT_EQ(done, QList<QByteArray>({"a1 failed"}));
+    emit service.characteristicWritten(controlPoint, "a2");
+    emit service.characteristicWritten(customWrite, "b1");
+    EXPECT_EQ(done, QList<QByteArray>({"a1 failed", "a2 ok", "b1 ok"}));
+
+    // a failed write with retries left is sent again
+    queue.setRetries(1);
+    queue.write(&service, controlPoint, "a3", QLowEnergyService::WriteWithResponse, false, record(&done, "a3"));
+    emit service.error(QLowEnergyService::OperationError);
+    EXPECT_EQ(service.controlPointWrites, QList<QByteArray>({"a1", "a2", "a3", "a3"}));
+    emit service.characteristicWritten(controlPoint, "a3");
+    EXPECT_EQ(done, QList<QByteArray>({"a1 failed", "a2 ok", "b1 ok", "a3 ok"}));
+}
+
+void GattWriteQueueTestSuite::test_drainOnDisconnect() {
+    gattwritequeue queue;
+    fakegattservice *service = new fakegattservice;
+    QList<QByteArray> done;
+
+    queue.write(service, controlPoint, "a1", QLowEnergyService::WriteWithResponse, false, record(&done, "a1"));
+    queue.write(service, controlPoint, "a2", QLowEnergyService::WriteWithResponse, false, record(&done, "a2"));
+    queue.write(service, customWrite, "b1", QLowEnergyService::WriteWithResponse, false, record(&done, "b1"));
+    EXPECT_EQ(queue.depth(), 3);
+
+    // the QLowEnergyService is deleted with its controller when the device disconnects
+    delete service;
+    EXPECT_EQ(done, QList<QByteArray>({"a1 failed", "a2 failed", "b1 failed"}));
+    EXPECT_EQ(queue.depth(), 0);
+    EXPECT_EQ(queue.failed(), 3);
+
+    // the device connects again
+    fakegattservice reconnected;
+    queue.write(&reconnected, controlPoint, "a3", QLowEnergyService::WriteWithResponse, false, record(&done, "a3"));
+    EXPECT_EQ(reconnected.controlPointWrites, QList<QByteArray>({"a3"}));
+    emit reconnected.characteristicWritten(controlPoint, "a3");
+    EXPECT_EQ(done, QList<QByteArray>({"a1 failed", "a2 failed", "b1 failed", "a3 ok"}));
+    EXPECT_EQ(queue.depth(), 0);
+}
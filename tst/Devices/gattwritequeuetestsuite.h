@@ -0,0 +1,59 @@
+#ifndef GATTWRITEQUEUETESTSUITE_H
+#define GATTWRITEQUEUETESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class GattWriteQueueTestSuite : public testing::Test {
+
+  public:
+    GattWriteQueueTestSuite();
+
+    /**
+     * @brief Test that the writes to a characteristic are sent one at a time, in order, each one when the previous
+     * one is acknowledged, while the writes to another characteristic go on independently.
+     */
+    void test_perCharacteristicOrdering();
+
+    /**
+     * @brief Test that a write waiting for a response is acknowledged by a notification and not by
+     * characteristicWritten, and that a write without response is done once the event loop runs.
+     */
+    void test_acknowledgements();
+
+    /**
+     * @brief Test that a write that isn't acknowledged fails after the timeout and the next one is sent.
+     */
+    void test_timeout();
+
+    /**
+     * @brief Test that a write that isn't acknowledged is sent again up to the retries, and succeeds if a retry is
+     * acknowledged.
+     */
+    void test_retry();
+
+    /**
+     * @brief Test that a write error of the service fails the only write in flight on it, and is left to the timeouts
+     * when more than one write is in flight.
+     */
+    void test_serviceError();
+
+    /**
+     * @brief Test that the writes in flight and queued on a service deleted by a disconnection fail at once, in
+     * order, and that the writes to a new service go on.
+     */
+    void test_drainOnDisconnect();
+};
+
+TEST_F(GattWriteQueueTestSuite, TestPerCharacteristicOrdering) { this->test_perCharacteristicOrdering(); }
+
+TEST_F(GattWriteQueueTestSuite, TestAcknowledgements) { this->test_acknowledgements(); }
+
+TEST_F(GattWriteQueueTestSuite, TestTimeout) { this->test_timeout(); }
+
+TEST_F(GattWriteQueueTestSuite, TestRetry) { this->test_retry(); }
+
+TEST_F(GattWriteQueueTestSuite, TestServiceError) { this->test_serviceError(); }
+
+TEST_F(GattWriteQueueTestSuite, TestDrainOnDisconnect) { this->test_drainOnDisconnect(); }
+
+#endif // GATTWRITEQUEUETESTSUITE_H
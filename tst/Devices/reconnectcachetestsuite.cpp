@@ -0,0 +1,55 @@
+#include "reconnectcachetestsuite.h"
+
+#include "Tools/testsettings.h"
+#include "devices/reconnectcache.h"
+#include "qzsettings.h"
+
+#include <QBluetoothAddress>
+
+ReconnectCacheTestSuite::ReconnectCacheTestSuite() {}
+
+void ReconnectCacheTestSuite::test_roundTrip() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    QSettings &settings = testSettings.qsettings;
+
+    QBluetoothDeviceInfo advertisement(QBluetoothAddress(QStringLiteral("00:11:22:33:44:55")),
+                                       QStringLiteral("KICKR CORE 5D21"), 0);
+    advertisement.setServiceUuids(QVector<QBluetoothUuid>(
+        {QBluetoothUuid((quint16)0x1826), QBluetoothUuid(QStringLiteral("a026ee0b-0a7d-4ab3-97fa-f1500f9feb8b"))}));
+
+    reconnectcache::entry saved = reconnectcache::fromDevice(advertisement, QStringLiteral("ftmsbike"));
+    saved.timeToConnectedMs = 1200;
+    reconnectcache::save(settings, saved);
+    reconnectcache::saveTimings(settings, 1200, 1800);
+
+    reconnectcache::entry loaded = reconnectcache::load(settings);
+    EXPECT_TRUE(loaded.isValid());
+    EXPECT_EQ(loaded.name, saved.name);
+    EXPECT_EQ(loaded.address, saved.address);
+    EXPECT_EQ(loaded.driver, QStringLiteral("ftmsbike"));
+    EXPECT_EQ(loaded.services, advertisement.serviceUuids());
+    EXPECT_EQ(loaded.timeToConnectedMs, 1200);
+    EXPECT_EQ(loaded.timeToFirstMetricMs, 1800);
+
+    QBluetoothDeviceInfo device = reconnectcache::deviceInfo(loaded);
+    EXPECT_EQ(device.name(), advertisement.name());
+    EXPECT_EQ(device.address(), advertisement.address());
+    EXPECT_EQ(device.serviceUuids(), advertisement.serviceUuids());
+    EXPECT_TRUE(device.coreConfigurations() & QBluetoothDeviceInfo::LowEnergyCoreConfiguration);
+
+    reconnectcache::invalidate(settings);
+    loaded = reconnectcache::load(settings);
+    EXPECT_FALSE(loaded.isValid());
+    // still the last device for the rest of the app
+    EXPECT_EQ(settings.value(QZSettings::bluetooth_lastdevice_name).toString(), saved.name);
+}
+
+void ReconnectCacheTestSuite::test_cacheable() {
+    EXPECT_TRUE(reconnectcache::cacheable(
+        QBluetoothDeviceInfo(QBluetoothAddress(QStringLiteral("00:11:22:33:44:55")), QStringLiteral("Domyos-Bike"), 0)));
+    // the fake and wifi devices
+    EXPECT_FALSE(reconnectcache::cacheable(QBluetoothDeviceInfo()));
+    EXPECT_FALSE(reconnectcache::cacheable(
+        QBluetoothDeviceInfo(QBluetoothAddress(QStringLiteral("00:11:22:33:44:55")), QString(), 0)));
+}
@@ -0,0 +1,27 @@
+#ifndef RECONNECTCACHETESTSUITE_H
+#define RECONNECTCACHETESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class ReconnectCacheTestSuite : public testing::Test {
+
+  public:
+    ReconnectCacheTestSuite();
+
+    /**
+     * @brief Test that a saved entry is loaded back, rebuilds the same device info and is no longer valid once
+     * invalidated.
+     */
+    void test_roundTrip();
+
+    /**
+     * @brief Test that the devices without a name or an address aren't cached.
+     */
+    void test_cacheable();
+};
+
+TEST_F(ReconnectCacheTestSuite, TestRoundTrip) { this->test_roundTrip(); }
+
+TEST_F(ReconnectCacheTestSuite, TestCacheable) { this->test_cacheable(); }
+
+#endif // RECONNECTCACHETESTSUITE_H
@@ -0,0 +1,170 @@
+#include "gpxtestsuite.h"
+
+#include "Tools/testsettings.h"
+#include "gpx.h"
+#include "qzsettings.h"
+
+#include <QDomDocument>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+namespace {
+// a ride going away from the start, with a stop (same position twice) every 50 points
+QString writeTrack(const QString &filename, int points) {
+    QFile file(filename);
+    file.open(QIODevice::WriteOnly);
+    QTextStream out(&file);
+    QDateTime start = QDateTime::fromSecsSinceEpoch(1700000000, Qt::UTC);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<gpx version=\"1.1\" creator=\"test\">\n";
+    out << "<metadata><name>test</name><video>https://example.com/ride.mp4</video></metadata>\n<trk><trkseg>\n";
+    double lat = 45.0;
+    for (int i = 0; i < points; i++) {
+        if (i % 50 != 49) {
+            lat += 0.00005;
+        }
+        out << "<trkpt lat=\"" << QString::number(lat, 'f', 7) << "\" lon=\"9.0000000\"><ele>"
+            << QString::number(100 + (i % 400) * 0.25, 'f', 2) << "</ele><time>"
+            << start.addSecs(i * 2).toString(Qt::ISODate) << "</time></trkpt>\n";
+    }
+    out << "</trkseg></trk>\n</gpx>\n";
+    return filename;
+}
+
+// the loader as it was before the streaming parser: DOM, list of points, then the rows
+QList<gpx_altitude_point_for_treadmill> openWithDom(const QString &filename, bool treadmill_force_speed,
+                                                    bool gpx_loop) {
+    const double meter_limit_for_auto_loop = 300;
+    QFile input(filename);
+    input.open(QIODevice::ReadOnly);
+    QDomDocument doc;
+    doc.setContent(&input);
+
+    QList<gpx_point> points;
+    QDomNodeList trkpt = doc.elementsByTagName(QStringLiteral("trkpt"));
+    for (int i = 0; i < trkpt.size(); i++) {
+        QDomNode point = trkpt.item(i);
+        QDomNamedNodeMap att = point.attributes();
+        gpx_point g;
+        g.time = QDateTime::fromString(point.firstChildElement(QStringLiteral("time")).text(), Qt::ISODate);
+        g.p.setAltitude(point.firstChildElement(QStringLiteral("ele")).text().toDouble());
+        g.p.setLatitude(att.namedItem(QStringLiteral("lat")).nodeValue().toDouble());
+        g.p.setLongitude(att.namedItem(QStringLiteral("lon")).nodeValue().toDouble());
+        points.append(g);
+    }
+
+    if (gpx_loop && points.size() > 2 && points.first().p.distanceTo(points.last().p) >= meter_limit_for_auto_loop) {
+        for (int i = points.size() - 2; i >= 0; i--) {
+            points.append(points.at(i));
+        }
+    }
+
+    QList<gpx_altitude_point_for_treadmill> rows;
+    if (points.isEmpty()) {
+        return rows;
+    }
+    if (!treadmill_force_speed && QGeoCoordinate(points.first().p.latitude(), points.first().p.longitude())
+                                          .distanceTo(QGeoCoordinate(points.last().p.latitude(),
+                                                                     points.last().p.longitude())) <
+                                      meter_limit_for_auto_loop) {
+        points.append(points.first());
+        points.last().time = points.at(points.count() - 2).time;
+    }
+
+    gpx_point pP = points.first();
+    gpx_altitude_point_for_treadmill g;
+    g.elevation = pP.p.altitude();
+    g.latitude = pP.p.latitude();
+    g.longitude = pP.p.longitude();
+    rows.append(g);
+    for (int i = 1; i < points.count(); i++) {
+        qint64 dT = qAbs(pP.time.secsTo(points.at(i).time));
+        double distance = points.at(i).p.distanceTo(pP.p);
+        double elevation = points.at(i).p.altitude() - pP.p.altitude();
+        if (distance == 0 || (treadmill_force_speed && dT == 0)) {
+            continue;
+        }
+        pP = points[i];
+        gpx_altitude_point_for_treadmill r;
+        r.seconds = points.first().time.secsTo(pP.time);
+        r.distance = distance / 1000.0;
+        if (treadmill_force_speed) {
+            r.speed = (distance / 1000.0) * (3600 / dT);
+        }
+        r.inclination = (elevation / distance) * 100;
+        r.elevation = points.at(i).p.altitude();
+        r.latitude = pP.p.latitude();
+        r.longitude = pP.p.longitude();
+        rows.append(r);
+    }
+    return rows;
+}
+
+void expectSameRows(const QList<gpx_altitude_point_for_treadmill> &actual,
+                    const QList<gpx_altitude_point_for_treadmill> &expected) {
+    ASSERT_EQ(actual.count(), expected.count());
+    for (int i = 0; i < expected.count(); i++) {
+        EXPECT_EQ(actual.at(i).seconds, expected.at(i).seconds) << i;
+        EXPECT_DOUBLE_EQ(actual.at(i).distance, expected.at(i).distance) << i;
+        EXPECT_FLOAT_EQ(actual.at(i).inclination, expected.at(i).inclination) << i;
+        EXPECT_FLOAT_EQ(actual.at(i).speed, expected.at(i).speed) << i;
+        EXPECT_FLOAT_EQ(actual.at(i).elevation, expected.at(i).elevation) << i;
+        EXPECT_DOUBLE_EQ(actual.at(i).latitude, expected.at(i).latitude) << i;
+        EXPECT_DOUBLE_EQ(actual.at(i).longitude, expected.at(i).longitude) << i;
+    }
+}
+} // namespace
+
+GpxTestSuite::GpxTestSuite() {}
+
+void GpxTestSuite::test_sameRowsAsDom() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+
+    QTemporaryDir dir;
+    // 1000 points are about 5.5 km: far enough from the start for gpx_loop
+    QString longTrack = writeTrack(dir.filePath(QStringLiteral("long.gpx")), 1000);
+    // 40 points are about 220 m: closed into a circuit
+    QString shortTrack = writeTrack(dir.filePath(QStringLiteral("short.gpx")), 40);
+
+    for (bool forceSpeed : {false, true}) {
+        for (bool loop : {false, true}) {
+            testSettings.qsettings.setValue(QZSettings::treadmill_force_speed, forceSpeed);
+            testSettings.qsettings.setValue(QZSettings::gpx_loop, loop);
+            for (const QString &track : {longTrack, shortTrack}) {
+                gpx g;
+                expectSameRows(g.open(track, bluetoothdevice::TREADMILL), openWithDom(track, forceSpeed, loop));
+                EXPECT_EQ(g.getVideoURL(), QStringLiteral("https://example.com/ride.mp4"));
+            }
+        }
+    }
+
+    testSettings.qsettings.remove(QZSettings::treadmill_force_speed);
+    testSettings.qsettings.remove(QZSettings::gpx_loop);
+}
+
+void GpxTestSuite::test_benchmarkLargeTrack() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    testSettings.qsettings.setValue(QZSettings::gpx_loop, false);
+
+    QTemporaryDir dir;
+    QString track = writeTrack(dir.filePath(QStringLiteral("large.gpx")), 120000);
+
+    QElapsedTimer timer;
+    timer.start();
+    QList<gpx_altitude_point_for_treadmill> expected = openWithDom(track, false, false);
+    qint64 domMs = timer.elapsed();
+
+    timer.restart();
+    gpx g;
+    QList<gpx_altitude_point_for_treadmill> rows = g.open(track, bluetoothdevice::BIKE);
+    qint64 streamMs = timer.elapsed();
+
+    RecordProperty("domMs", static_cast<int>(domMs));
+    RecordProperty("streamingMs", static_cast<int>(streamMs));
+
+    expectSameRows(rows, expected);
+
+    testSettings.qsettings.remove(QZSettings::gpx_loop);
+}
@@ -0,0 +1,28 @@
+#ifndef GPXTESTSUITE_H
+#define GPXTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class GpxTestSuite : public testing::Test {
+
+  public:
+    GpxTestSuite();
+
+    /**
+     * @brief Test that the streaming loader returns the same rows of the DOM based one, with and without
+     * gpx_loop and treadmill_force_speed.
+     */
+    void test_sameRowsAsDom();
+
+    /**
+     * @brief Time the streaming loader and the DOM based one on a 120k points track.
+     * Disabled by default, run it with --gtest_also_run_disabled_tests: the timings are recorded as test properties.
+     */
+    void test_benchmarkLargeTrack();
+};
+
+TEST_F(GpxTestSuite, TestSameRowsAsDom) { this->test_sameRowsAsDom(); }
+
+TEST_F(GpxTestSuite, DISABLED_BenchmarkLargeTrack) { this->test_benchmarkLargeTrack(); }
+
+#endif // GPXTESTSUITE_H
@@ -0,0 +1,244 @@
+#include "logwritertestsuite.h"
+
+#include "Tools/testsettings.h"
+#include "logwriter.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRegularExpression>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QThread>
+#include <QVector>
+
+namespace {
+QList<QByteArray> readLines(const QString &filename) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QList<QByteArray>();
+    }
+    QList<QByteArray> lines = file.readAll().split('\n');
+    if (!lines.isEmpty() && lines.last().isEmpty()) {
+        lines.removeLast();
+    }
+    return lines;
+}
+
+// the message handler of main.cpp before the writer, without the echo on stderr
+void legacyHandler(const QString &filename, QtMsgType type, const QMessageLogContext &context, const QString &msg) {
+    QSettings settings;
+    Q_UNUSED(settings);
+    const char *file = context.file ? context.file : "";
+    const char *function = context.function ? context.function : "";
+    QString txt = QDateTime::currentDateTime().toString() + QStringLiteral(" ") +
+                  QString::number(QDateTime::currentMSecsSinceEpoch()) + QStringLiteral(" ");
+    switch (type) {
+    case QtDebugMsg:
+        txt += QStringLiteral("Debug: %1 %2 %3\n").arg(file, function, msg);
+        break;
+    default:
+        txt += QStringLiteral("Info: %1 %2 %3\n").arg(file, function, msg);
+        break;
+    }
+    QFile outFile(filename);
+    outFile.open(QIODevice::WriteOnly | QIODevice::Append);
+    QTextStream ts(&outFile);
+    ts << txt;
+}
+} // namespace
+
+LogWriterTestSuite::LogWriterTestSuite() {}
+
+void LogWriterTestSuite::test_multipleProducers() {
+    QTemporaryDir dir;
+    const QString filename = dir.filePath(QStringLiteral("debug.log"));
+    const int threads = 4;
+    const int lines = 5000;
+    {
+        logwriter writer(filename, threads * lines);
+        writer.setEchoStderr(false);
+        QVector<QThread *> producers;
+        for (int t = 0; t < threads; t++) {
+            producers.append(QThread::create([&writer, t, lines] {
+                for (int i = 0; i < lines; i++) {
+                    writer.append(QByteArray::number(t) + ' ' + QByteArray::number(i) + '\n');
+                }
+            }));
+            producers.last()->start();
+        }
+        for (QThread *producer : producers) {
+            producer->wait();
+            delete producer;
+        }
+        writer.flush();
+        EXPECT_EQ(writer.dropped(), 0u);
+    }
+
+    QVector<int> next(threads, 0);
+    const QList<QByteArray> written = readLines(filename);
+    ASSERT_EQ(written.count(), threads * lines);
+    for (const QByteArray &line : written) {
+        const QList<QByteArray> fields = line.split(' ');
+        ASSERT_EQ(fields.count(), 2);
+        const int t = fields.at(0).toInt();
+        ASSERT_TRUE(t >= 0 && t < threads);
+        EXPECT_EQ(fields.at(1).toInt(), next[t]++);
+    }
+}
+
+void LogWriterTestSuite::test_rotation() {
+    QTemporaryDir dir;
+    const QString filename = dir.filePath(QStringLiteral("debug.log"));
+    logwriter writer(filename);
+    writer.setEchoStderr(false);
+    writer.setMaxBytes(4096);
+    writer.setMaxFiles(2);
+
+    EXPECT_EQ(writer.rotatedFilename(1), dir.filePath(QStringLiteral("debug.1.log")));
+
+    const QByteArray line = QByteArray(99, 'x') + '\n';
+    for (int i = 0; i < 200; i++) {
+        writer.append(line);
+        if (i % 20 == 19) {
+            writer.flush();
+        }
+    }
+    writer.append("last\n");
+    writer.flush();
+
+    EXPECT_TRUE(QFile::exists(filename));
+    EXPECT_TRUE(QFile::exists(writer.rotatedFilename(1)));
+    EXPECT_TRUE(QFile::exists(writer.rotatedFilename(2)));
+    EXPECT_FALSE(QFile::exists(writer.rotatedFilename(3)));
+    // a file is rotated after the batch that made it too big
+    EXPECT_LE(QFile(writer.rotatedFilename(1)).size(), 4096 + 20 * line.size());
+    EXPECT_EQ(readLines(filename).last(), QByteArray("last"));
+}
+
+void LogWriterTestSuite::test_dropped() {
+    QTemporaryDir dir;
+    const QString filename = dir.filePath(QStringLiteral("debug.log"));
+    const int lines = 10000;
+    quint64 dropped = 0;
+    {
+        logwriter writer(filename, 16);
+        writer.setEchoStderr(false);
+        int accepted = 0;
+        for (int i = 0; i < lines; i++) {
+            accepted += writer.append(QByteArray::number(i) + '\n') ? 1 : 0;
+        }
+        writer.flush();
+        dropped = writer.dropped();
+        EXPECT_GT(dropped, 0u);
+        EXPECT_EQ(accepted + dropped, quint64(lines));
+    }
+
+    int written = 0;
+    quint64 reported = 0;
+    int last = -1;
+    static const QRegularExpression droppedRe(QStringLiteral("log: (\\d+) lines dropped"));
+    for (const QByteArray &line : readLines(filename)) {
+        QRegularExpressionMatch match = droppedRe.match(QString::fromUtf8(line));
+        if (match.hasMatch()) {
+            reported += match.captured(1).toULongLong();
+            continue;
+        }
+        // the lines kept are still in order
+        EXPECT_GT(line.toInt(), last);
+        last = line.toInt();
+        written++;
+    }
+    EXPECT_EQ(reported, dropped);
+    EXPECT_EQ(written + dropped, quint64(lines));
+}
+
+void LogWriterTestSuite::test_flushTimeout() {
+    QTemporaryDir dir;
+    const QString filename = dir.filePath(QStringLiteral("debug.log"));
+    logwriter writer(filename);
+    writer.setEchoStderr(false);
+    // only the flushes write
+    writer.setFlushIntervalMs(60000);
+
+    for (int i = 0; i < 100; i++) {
+        writer.append(QByteArray::number(i) + '\n');
+    }
+    EXPECT_TRUE(writer.flush(5000));
+    EXPECT_EQ(readLines(filename).count(), 100);
+
+    // a flush that gives up loses nothing, the lines are written by the next one
+    for (int i = 100; i < 200; i++) {
+        writer.append(QByteArray::number(i) + '\n');
+    }
+    writer.flush(0);
+    EXPECT_TRUE(writer.flush());
+    const QList<QByteArray> written = readLines(filename);
+    ASSERT_EQ(written.count(), 200);
+    EXPECT_EQ(written.last(), QByteArray("199"));
+}
+
+void LogWriterTestSuite::test_format() {
+    QMessageLogContext context("ftmsbike.cpp", 218, "void ftmsbike::characteristicChanged()", "default");
+    const qint64 before = QDateTime::currentMSecsSinceEpoch();
+    const QString line = QString::fromUtf8(logwriter::format(QtDebugMsg, context, QStringLiteral("speed 25 km/h")));
+    const qint64 after = QDateTime::currentMSecsSinceEpoch();
+
+    static const QRegularExpression lineRe(
+        QStringLiteral("^(.+) (\\d+) Debug: ftmsbike.cpp void ftmsbike::characteristicChanged\\(\\) speed 25 km/h\\n$"));
+    QRegularExpressionMatch match = lineRe.match(line);
+    ASSERT_TRUE(match.hasMatch()) << line.toStdString();
+    const qint64 msecs = match.captured(2).toLongLong();
+    EXPECT_GE(msecs, before);
+    EXPECT_LE(msecs, after);
+    EXPECT_EQ(match.captured(1), QDateTime::fromMSecsSinceEpoch(msecs).toString());
+
+    EXPECT_TRUE(logwriter::format(QtWarningMsg, QMessageLogContext(), QStringLiteral("w")).endsWith(" Warning:   w\n"));
+}
+
+void LogWriterTestSuite::test_benchmarkHandler() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+
+    QTemporaryDir dir;
+    const int messages = 20000;
+    QMessageLogContext context("domyostreadmill.cpp", 414, "void domyostreadmill::characteristicChanged()", "default");
+    const QString msg = QStringLiteral(" << 26 f0 bc 04 64 00 00 00 54 00 00 00 01 00 00 00 00 00 00 00 00 00 00 00 00 00 00");
+
+    QElapsedTimer timer;
+    const QString legacyFilename = dir.filePath(QStringLiteral("legacy.log"));
+    timer.start();
+    for (int i = 0; i < messages; i++) {
+        legacyHandler(legacyFilename, QtDebugMsg, context, msg);
+    }
+    const double legacyNs = (double)timer.nsecsElapsed() / messages;
+
+    quint64 dropped = 0;
+    double writerNs = 0;
+    double drainedNs = 0;
+    {
+        logwriter writer(dir.filePath(QStringLiteral("writer.log")));
+        writer.setEchoStderr(false);
+        timer.restart();
+        for (int i = 0; i < messages; i++) {
+            writer.append(logwriter::format(QtDebugMsg, context, msg));
+        }
+        writerNs = (double)timer.nsecsElapsed() / messages;
+        writer.flush();
+        drainedNs = (double)timer.nsecsElapsed() / messages;
+        dropped = writer.dropped();
+    }
+
+    // the lines reporting the drops aren't counted
+    int written = 0;
+    for (const QByteArray &line : readLines(dir.filePath(QStringLiteral("writer.log")))) {
+        written += line.contains("domyostreadmill::characteristicChanged") ? 1 : 0;
+    }
+    EXPECT_EQ(written + dropped, quint64(messages));
+
+    RecordProperty("legacyNsPerMessage", static_cast<int>(legacyNs));
+    RecordProperty("writerNsPerMessage", static_cast<int>(writerNs));
+    RecordProperty("drainedNsPerMessage", static_cast<int>(drainedNs));
+    RecordProperty("dropped", static_cast<int>(dropped));
+}
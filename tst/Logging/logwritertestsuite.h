@@ -0,0 +1,56 @@
+#ifndef LOGWRITERTESTSUITE_H
+#define LOGWRITERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class LogWriterTestSuite : public testing::Test {
+
+  public:
+    LogWriterTestSuite();
+
+    /**
+     * @brief Test that the lines of several threads are all written, each thread's in its order.
+     */
+    void test_multipleProducers();
+
+    /**
+     * @brief Test the size based rotation and the number of rotated files kept.
+     */
+    void test_rotation();
+
+    /**
+     * @brief Test that the lines of producers outrunning the writer are dropped, counted and reported in the log.
+     */
+    void test_dropped();
+
+    /**
+     * @brief Test that a flush with a timeout, the one of the crash handler and of the critical messages, writes the
+     * lines appended before it, and that a flush that gives up loses nothing.
+     */
+    void test_flushTimeout();
+
+    /**
+     * @brief Test that the formatted line is the one the message handler always wrote.
+     */
+    void test_format();
+
+    /**
+     * @brief Compare the cost of a message with the writer and with the handler that opened the file for each of them.
+     * Disabled by default, run it with --gtest_also_run_disabled_tests: the timings are recorded as test properties.
+     */
+    void test_benchmarkHandler();
+};
+
+TEST_F(LogWriterTestSuite, TestMultipleProducers) { this->test_multipleProducers(); }
+
+TEST_F(LogWriterTestSuite, TestRotation) { this->test_rotation(); }
+
+TEST_F(LogWriterTestSuite, TestDropped) { this->test_dropped(); }
+
+TEST_F(LogWriterTestSuite, TestFlushTimeout) { this->test_flushTimeout(); }
+
+TEST_F(LogWriterTestSuite, TestFormat) { this->test_format(); }
+
+TEST_F(LogWriterTestSuite, DISABLED_BenchmarkHandler) { this->test_benchmarkHandler(); }
+
+#endif // LOGWRITERTESTSUITE_H
@@ -0,0 +1,200 @@
+#include "qzlogtestsuite.h"
+
+#include "Tools/gattreplay.h"
+#include "Tools/testsettings.h"
+#include "devices/domyostreadmill/domyostreadmill.h"
+#include "qzlog.h"
+#include "qzsettings.h"
+
+#include <QString>
+
+Q_LOGGING_CATEGORY(qzlogTestOther, "qzlogtest.other")
+
+namespace {
+// a driver is only the debug signal here
+struct tracer {
+    int emitted = 0;
+    void debug(const QString &text) {
+        Q_UNUSED(text);
+        emitted++;
+    }
+    void trace(const QLoggingCategory &(*category)(), int &evaluated) {
+        QZ_EMIT_DEBUG(category, QString::number(++evaluated));
+    }
+};
+
+void discard(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
+    Q_UNUSED(type);
+    Q_UNUSED(context);
+    Q_UNUSED(msg);
+}
+
+QList<QString> treadmillMessages;
+
+void recordTreadmill(QtMsgType type, const QMessageLogContext &context, const QString &msg) {
+    Q_UNUSED(type);
+    if (context.category && qstrcmp(context.category, "qz.devices.treadmill") == 0) {
+        treadmillMessages.append(msg);
+    }
+}
+
+QVector<GattReplay::Notification> readCapture(TestSettings &testSettings) {
+    testSettings.activate();
+    testSettings.qsettings.clear();
+    testSettings.qsettings.setValue(QZSettings::heart_rate_belt_name, QStringLiteral("Disabled"));
+    return GattReplay::read(QStringLiteral(BTLOGS_DIR "/btsnoop_hci.log"));
+}
+} // namespace
+
+QZLogTestSuite::QZLogTestSuite() {}
+
+QZLogTestSuite::~QZLogTestSuite() { qzlog::setRules(QString()); }
+
+void QZLogTestSuite::test_rules() {
+    qzlog::setRules(QStringLiteral("qz.devices.treadmill.debug=false"));
+    EXPECT_FALSE(qzTreadmill().isDebugEnabled());
+    EXPECT_TRUE(qzTreadmill().isInfoEnabled());
+    EXPECT_TRUE(qzTreadmill().isWarningEnabled());
+    EXPECT_TRUE(qzBike().isDebugEnabled());
+
+    // the later rules win, a rule without a level sets all of them
+    qzlog::setRules(QStringLiteral("qz.devices.*=false; qz.devices.bike.warning=true\nqz.dircon.debug = FALSE"));
+    EXPECT_FALSE(qzTreadmill().isDebugEnabled());
+    EXPECT_FALSE(qzTreadmill().isWarningEnabled());
+    EXPECT_FALSE(qzTreadmill().isCriticalEnabled());
+    EXPECT_FALSE(qzBike().isDebugEnabled());
+    EXPECT_TRUE(qzBike().isWarningEnabled());
+    EXPECT_FALSE(qzGatt().isInfoEnabled());
+    EXPECT_FALSE(qzDircon().isDebugEnabled());
+    EXPECT_TRUE(qzVirtualDevices().isDebugEnabled());
+
+    qzlog::setRules(QStringLiteral("qz.*.debug=false;qz.virtualdevices.debug=true"));
+    EXPECT_FALSE(qzBluetooth().isDebugEnabled());
+    EXPECT_FALSE(qzTrainProgram().isDebugEnabled());
+    EXPECT_TRUE(qzVirtualDevices().isDebugEnabled());
+
+    // the lines that aren't rules are skipped
+    qzlog::setRules(QStringLiteral("garbage;qz.dircon=maybe;=false;qz.rower.debug=false"));
+    EXPECT_TRUE(qzDircon().isDebugEnabled());
+    EXPECT_FALSE(qzRower().isDebugEnabled());
+
+    // without rules the levels are the ones of Qt again
+    qzlog::setRules(QString());
+    EXPECT_TRUE(qzTreadmill().isDebugEnabled());
+    EXPECT_TRUE(qzRower().isDebugEnabled());
+}
+
+void QZLogTestSuite::test_otherCategories() {
+    QLoggingCategory::setFilterRules(QStringLiteral("qzlogtest.other.debug=false"));
+    qzlog::setRules(QStringLiteral("*=false"));
+    EXPECT_FALSE(qzBike().isDebugEnabled());
+    EXPECT_FALSE(qzlogTestOther().isDebugEnabled());
+    EXPECT_TRUE(qzlogTestOther().isWarningEnabled());
+
+    // the rules of Qt are still applied after the qz filter is installed
+    QLoggingCategory::setFilterRules(QString());
+    EXPECT_TRUE(qzlogTestOther().isDebugEnabled());
+    EXPECT_FALSE(qzBike().isDebugEnabled());
+    qzlog::setRules(QString());
+}
+
+void QZLogTestSuite::test_configure() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    testSettings.qsettings.clear();
+
+    qzlog::configure(testSettings.qsettings, false);
+    EXPECT_FALSE(qzBike().isDebugEnabled());
+    EXPECT_FALSE(qzBike().isInfoEnabled());
+    EXPECT_TRUE(qzBike().isWarningEnabled());
+
+    qzlog::configure(testSettings.qsettings, true);
+    EXPECT_TRUE(qzBike().isDebugEnabled());
+
+    testSettings.qsettings.setValue(QZSettings::log_categories, QStringLiteral("qz.devices.bike.debug=false"));
+    qzlog::configure(testSettings.qsettings, true);
+    EXPECT_FALSE(qzBike().isDebugEnabled());
+    EXPECT_TRUE(qzTreadmill().isDebugEnabled());
+
+    // a category can log even when the others don't
+    testSettings.qsettings.setValue(QZSettings::log_categories, QStringLiteral("qz.devices.bike.debug=true"));
+    qzlog::configure(testSettings.qsettings, false);
+    EXPECT_TRUE(qzBike().isDebugEnabled());
+    EXPECT_FALSE(qzTreadmill().isDebugEnabled());
+}
+
+void QZLogTestSuite::test_disabledSkipsEvaluation() {
+    QtMessageHandler previous = qInstallMessageHandler(discard);
+    int evaluated = 0;
+    tracer t;
+
+    qzlog::setRules(QStringLiteral("qz.devices.treadmill.debug=false"));
+    t.trace(qzTreadmill, evaluated);
+    qCDebug(qzTreadmill) << ++evaluated;
+    EXPECT_EQ(evaluated, 0);
+    EXPECT_EQ(t.emitted, 0);
+
+    t.trace(qzBike, evaluated);
+    qCDebug(qzBike) << ++evaluated;
+    EXPECT_EQ(evaluated, 2);
+    EXPECT_EQ(t.emitted, 1);
+
+    qInstallMessageHandler(previous);
+}
+
+void QZLogTestSuite::test_disabledReplayIsSilent() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    QVector<GattReplay::Notification> notifications = readCapture(testSettings);
+    ASSERT_FALSE(notifications.isEmpty());
+
+    QtMessageHandler previous = qInstallMessageHandler(recordTreadmill);
+    auto run = [&notifications](const QString &rules) {
+        qzlog::setRules(rules);
+        treadmillMessages.clear();
+        int emitted = 0;
+        domyostreadmill device(200, true, true);
+        QObject::connect(&device, &domyostreadmill::debug, [&emitted](const QString &) { emitted++; });
+        GattReplay::attach(&device);
+        GattReplay::replay(&device, notifications);
+        return emitted;
+    };
+
+    EXPECT_GT(run(QStringLiteral("qz.devices.treadmill.debug=true")), 0);
+
+    EXPECT_EQ(run(QStringLiteral("qz.devices.treadmill.debug=false")), 0);
+    EXPECT_FALSE(qzTreadmill().isDebugEnabled());
+    EXPECT_TRUE(qzTreadmill().isWarningEnabled());
+    EXPECT_TRUE(treadmillMessages.isEmpty()) << treadmillMessages.first().toStdString();
+
+    qInstallMessageHandler(previous);
+}
+
+void QZLogTestSuite::test_benchmarkDisabledTracing() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    QVector<GattReplay::Notification> notifications = readCapture(testSettings);
+    ASSERT_FALSE(notifications.isEmpty());
+
+    // the messages are formatted and handed to a handler which drops them, the disk isn't measured
+    QtMessageHandler previous = qInstallMessageHandler(discard);
+    auto run = [&notifications](const QString &rules) {
+        qzlog::setRules(rules);
+        domyostreadmill device(200, true, true);
+        GattReplay::attach(&device);
+        return GattReplay::replay(&device, notifications).nsPerNotification();
+    };
+
+    // the first replay warms up the driver and the caches
+    run(QStringLiteral("qz.devices.treadmill.debug=true"));
+    double enabledNs = 0;
+    double disabledNs = 0;
+    const int rounds = 3;
+    for (int i = 0; i < rounds; i++) {
+        enabledNs += run(QStringLiteral("qz.devices.treadmill.debug=true")) / rounds;
+        disabledNs += run(QStringLiteral("qz.devices.treadmill.debug=false")) / rounds;
+    }
+    qInstallMessageHandler(previous);
+
+    RecordProperty("notifications", notifications.count());
+    RecordProperty("enabledNsPerNotification", static_cast<int>(enabledNs));
+    RecordProperty("disabledNsPerNotification", static_cast<int>(disabledNs));
+}
@@ -0,0 +1,58 @@
+#ifndef QZLOGTESTSUITE_H
+#define QZLOGTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class QZLogTestSuite : public testing::Test {
+
+  public:
+    QZLogTestSuite();
+    ~QZLogTestSuite() override;
+
+    /**
+     * @brief Test the parsing of the rules, the levels, the prefixes and the order in which the rules are applied.
+     */
+    void test_rules();
+
+    /**
+     * @brief Test that the rules are applied only to the qz categories.
+     */
+    void test_otherCategories();
+
+    /**
+     * @brief Test the levels set from the settings, with and without the debug log.
+     */
+    void test_configure();
+
+    /**
+     * @brief Test that the arguments of a disabled category aren't evaluated.
+     */
+    void test_disabledSkipsEvaluation();
+
+    /**
+     * @brief Replay a captured session into domyostreadmill with its debug messages disabled and check that neither
+     * the debug signal nor the category emit anything, while they do when the messages are enabled.
+     */
+    void test_disabledReplayIsSilent();
+
+    /**
+     * @brief Compare the cost of a notification of a captured session replayed into domyostreadmill with the debug
+     * messages of the treadmill enabled and disabled.
+     * Disabled by default, run it with --gtest_also_run_disabled_tests: the timings are recorded as test properties.
+     */
+    void test_benchmarkDisabledTracing();
+};
+
+TEST_F(QZLogTestSuite, TestRules) { this->test_rules(); }
+
+TEST_F(QZLogTestSuite, TestOtherCategories) { this->test_otherCategories(); }
+
+TEST_F(QZLogTestSuite, TestConfigure) { this->test_configure(); }
+
+TEST_F(QZLogTestSuite, TestDisabledSkipsEvaluation) { this->test_disabledSkipsEvaluation(); }
+
+TEST_F(QZLogTestSuite, TestDisabledReplayIsSilent) { this->test_disabledReplayIsSilent(); }
+
+TEST_F(QZLogTestSuite, DISABLED_BenchmarkDisabledTracing) { this->test_benchmarkDisabledTracing(); }
+
+#endif // QZLOGTESTSUITE_H
@@ -0,0 +1,203 @@
+#include "metrictestsuite.h"
+
+#include "Tools/testsettings.h"
+#include "metric.h"
+#include "monotonicclock.h"
+#include "qzsettings.h"
+#include "qzsettingssnapshot.h"
+#include "sessionstore.h"
+
+#include <QElapsedTimer>
+#include <QList>
+
+namespace {
+qint64 fakeNsecs = 0;
+qint64 fakeClock() { return fakeNsecs; }
+
+// the metrics a device exposes to homeform, read through both getter flavours
+class metricsHolder {
+  public:
+    metric Speed, Heart, Cadence, Watt, Resistance, Inclination, KCal, Distance;
+
+    metric speedCopy() { return Speed; }
+    metric heartCopy() { return Heart; }
+    metric cadenceCopy() { return Cadence; }
+    metric wattCopy() { return Watt; }
+    metric resistanceCopy() { return Resistance; }
+    metric inclinationCopy() { return Inclination; }
+    metric kcalCopy() { return KCal; }
+    metric distanceCopy() { return Distance; }
+
+    const metric &speed() { return Speed; }
+    const metric &heart() { return Heart; }
+    const metric &cadence() { return Cadence; }
+    const metric &watt() { return Watt; }
+    const metric &resistance() { return Resistance; }
+    const metric &inclination() { return Inclination; }
+    const metric &kcal() { return KCal; }
+    const metric &distance() { return Distance; }
+};
+} // namespace
+
+MetricTestSuite::MetricTestSuite() {}
+
+void MetricTestSuite::test_rollingAverages() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    QZSettingsSnapshot::refresh();
+
+    metric m;
+    QList<double> samples;
+
+    // zeros are not part of the averages, as before
+    m.setValue(0);
+    EXPECT_EQ(m.average5s(), 0);
+
+    for (int i = 1; i <= 500; i++) {
+        double v = (i * 37) % 251 + 1;
+        m.setValue(v);
+        samples.append(v);
+
+        for (int window : {3, 5, 10, 20, 30, 60}) {
+            double sum = 0;
+            int count = 0;
+            for (int j = samples.count() - 1; j >= 0 && count < window; j--, count++)
+                sum += samples.at(j);
+            EXPECT_NEAR(m.averageLast(window), sum / count, 1e-9) << "window " << window << " sample " << i;
+        }
+    }
+
+    EXPECT_DOUBLE_EQ(m.average5s(), m.averageLast(5));
+    EXPECT_DOUBLE_EQ(m.average20s(), m.averageLast(20));
+    EXPECT_DOUBLE_EQ(m.average30s(), m.averageLast(30));
+
+    m.clear(false);
+    EXPECT_EQ(m.average60s(), 0);
+}
+
+void MetricTestSuite::test_ema() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    QZSettingsSnapshot::refresh();
+
+    metric m;
+    m.setEmaSamples(3); // alpha = 0.5
+    m.setValue(100);
+    EXPECT_DOUBLE_EQ(m.ema(), 100);
+    m.setValue(200);
+    EXPECT_DOUBLE_EQ(m.ema(), 150);
+    m.setValue(300);
+    EXPECT_DOUBLE_EQ(m.ema(), 225);
+
+    m.clear(false);
+    EXPECT_DOUBLE_EQ(m.ema(), 0);
+    m.setValue(50);
+    EXPECT_DOUBLE_EQ(m.ema(), 50);
+}
+
+void MetricTestSuite::test_monotonicTiming() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    QZSettingsSnapshot::refresh();
+
+    fakeNsecs = 1000000000;
+    monotonicclock::setSource(fakeClock);
+
+    metric m;
+    EXPECT_EQ(m.msecsSinceLastChanged(), 0);
+
+    m.setValue(10);
+    fakeNsecs += 500000000;
+    m.setValue(20);
+    fakeNsecs += 500000000;
+    m.setValue(30);
+    // +10 in half a second
+    EXPECT_DOUBLE_EQ(m.rate1s(), 20);
+
+    fakeNsecs += 1500000000;
+    EXPECT_EQ(m.msecsSinceLastChanged(), 1500);
+    EXPECT_EQ(m.msecsSinceValueChanged(), 1500);
+
+    // the same value refreshes lastChanged but not valueChanged
+    m.setValue(30);
+    EXPECT_EQ(m.msecsSinceLastChanged(), 0);
+    EXPECT_EQ(m.msecsSinceValueChanged(), 1500);
+
+    // the wall-clock view keeps the distance between the timestamps
+    EXPECT_EQ(m.valueChanged().msecsTo(m.lastChanged()), 1500);
+
+    monotonicclock::setSource(nullptr);
+}
+
+void MetricTestSuite::test_powerPeakVO2Max() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    testSettings.qsettings.setValue(QZSettings::weight, 75.0);
+
+    sessionstore session;
+    QDateTime start = QDateTime::fromMSecsSinceEpoch(1700000000000);
+    for (uint32_t i = 0; i < 600; i++) {
+        session.append(SessionLine(30, 0, i / 120.0, 200, 0, 0, 140, 0, 90, i * 0.01, 0, i, false, 0, 0, 0, 0,
+                                   QGeoCoordinate(), 0, 0, 0, i, start.addSecs(i)));
+    }
+
+    // before this curve the 5 minutes peak summed 301 samples over 300s: 200.67W and a VO2max of 35.896
+    const double vo2MaxBefore = 35.896;
+    EXPECT_DOUBLE_EQ(metric::powerPeak(&session, 5 * 60), 200.0);
+    EXPECT_NEAR(metric::calculateVO2Max(&session), 35.8, 1e-9);
+    EXPECT_NEAR(metric::calculateVO2Max(&session) - vo2MaxBefore, -0.096, 1e-9);
+
+    // the 10 minutes window is the whole session, the old search needed one more second of elapsed time for it
+    EXPECT_DOUBLE_EQ(metric::powerPeak(&session, 10 * 60), 200.0);
+    EXPECT_EQ(metric::powerPeak(&session, 10 * 60 + 1), -1);
+}
+
+void MetricTestSuite::test_benchmarkGetterReads() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    QZSettingsSnapshot::refresh();
+
+    metricsHolder device;
+    for (int i = 1; i <= 60; i++) {
+        device.Speed.setValue(20 + i % 5);
+        device.Heart.setValue(120 + i % 7);
+        device.Cadence.setValue(80 + i % 3);
+        device.Watt.setValue(200 + i % 11);
+        device.Resistance.setValue(10);
+        device.Inclination.setValue(1);
+        device.KCal.setValue(i);
+        device.Distance.setValue(i / 10.0);
+    }
+
+    // homeform::update reads each metric several times (value, average, max, lap values...) in a tick
+    const int ticks = 2000;
+    const int readsPerMetric = 30;
+    double copySum = 0;
+    double referenceSum = 0;
+    QElapsedTimer timer;
+
+    timer.start();
+    for (int t = 0; t < ticks; t++) {
+        for (int r = 0; r < readsPerMetric; r++) {
+            copySum += device.speedCopy().value() + device.heartCopy().average() + device.cadenceCopy().value() +
+                       device.wattCopy().average5s() + device.resistanceCopy().value() +
+                       device.inclinationCopy().value() + device.kcalCopy().value() + device.distanceCopy().value();
+        }
+    }
+    qint64 copyNs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int t = 0; t < ticks; t++) {
+        for (int r = 0; r < readsPerMetric; r++) {
+            referenceSum += device.speed().value() + device.heart().average() + device.cadence().value() +
+                            device.watt().average5s() + device.resistance().value() + device.inclination().value() +
+                            device.kcal().value() + device.distance().value();
+        }
+    }
+    qint64 referenceNs = timer.nsecsElapsed();
+
+    RecordProperty("copyNsPerTick", static_cast<int>(copyNs / ticks));
+    RecordProperty("referenceNsPerTick", static_cast<int>(referenceNs / ticks));
+
+    EXPECT_DOUBLE_EQ(referenceSum, copySum);
+}
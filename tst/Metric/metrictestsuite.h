@@ -0,0 +1,50 @@
+#ifndef METRICTESTSUITE_H
+#define METRICTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class MetricTestSuite : public testing::Test {
+
+  public:
+    MetricTestSuite();
+
+    /**
+     * @brief Test the rolling window averages against a plain recomputation over the last samples.
+     */
+    void test_rollingAverages();
+
+    /**
+     * @brief Test the exponential moving average and its reset.
+     */
+    void test_ema();
+
+    /**
+     * @brief Test rate1s() and the elapsed time helpers with a fake monotonic clock.
+     */
+    void test_monotonicTiming();
+
+    /**
+     * @brief Test powerPeak and calculateVO2Max on a steady session: the peak is now the average of exactly the
+     * window's samples, the old search summed one sample more than the window and divided by its duration.
+     */
+    void test_powerPeakVO2Max();
+
+    /**
+     * @brief Compare the cost of the metric reads of a homeform::update tick through by-value getters and through
+     * the const reference getters used by bluetoothdevice.
+     * Disabled by default, run it with --gtest_also_run_disabled_tests: the timings are recorded as test properties.
+     */
+    void test_benchmarkGetterReads();
+};
+
+TEST_F(MetricTestSuite, TestRollingAverages) { this->test_rollingAverages(); }
+
+TEST_F(MetricTestSuite, TestEma) { this->test_ema(); }
+
+TEST_F(MetricTestSuite, TestMonotonicTiming) { this->test_monotonicTiming(); }
+
+TEST_F(MetricTestSuite, TestPowerPeakVO2Max) { this->test_powerPeakVO2Max(); }
+
+TEST_F(MetricTestSuite, DISABLED_BenchmarkGetterReads) { this->test_benchmarkGetterReads(); }
+
+#endif // METRICTESTSUITE_H
@@ -0,0 +1,67 @@
+#include "trainingloadtestsuite.h"
+
+#include "trainingload.h"
+
+#include <QList>
+#include <math.h>
+
+TrainingLoadTestSuite::TrainingLoadTestSuite() {}
+
+void TrainingLoadTestSuite::test_normalizedPower() {
+    trainingload load;
+    load.setThresholds(250, 20000);
+    EXPECT_EQ(load.normalizedPower(), 0);
+
+    QList<double> watts;
+    for (int i = 0; i < 3600; i++) {
+        double w = (i / 60) % 2 ? 320 : 150;
+        load.append(w);
+        watts.append(w);
+    }
+
+    double sum = 0;
+    int count = 0;
+    for (int i = 29; i < watts.count(); i++) {
+        double avg = 0;
+        for (int j = i - 29; j <= i; j++)
+            avg += watts.at(j);
+        avg /= 30;
+        sum += pow(avg, 4);
+        count++;
+    }
+    double np = pow(sum / count, 0.25);
+
+    EXPECT_NEAR(load.normalizedPower(), np, 1e-6);
+    EXPECT_NEAR(load.intensityFactor(), np / 250, 1e-9);
+    EXPECT_NEAR(load.tss(), 3600 * np * (np / 250) / (250 * 3600) * 100, 1e-6);
+
+    // a steady hour at FTP is 100 TSS
+    trainingload steady;
+    steady.setThresholds(250, 20000);
+    for (int i = 0; i < 3600; i++)
+        steady.append(250);
+    EXPECT_NEAR(steady.tss(), 100, 1e-6);
+}
+
+void TrainingLoadTestSuite::test_wPrimeBalance() {
+    trainingload load;
+    load.setThresholds(200, 20000);
+    EXPECT_DOUBLE_EQ(load.wPrimeBalance(), 20000);
+
+    for (int i = 0; i < 60; i++)
+        load.append(300);
+    EXPECT_DOUBLE_EQ(load.wPrimeBalance(), 20000 - 60 * 100);
+    EXPECT_DOUBLE_EQ(load.wPrimeBalancePercentage(), 70);
+
+    double spent = load.wPrimeBalance();
+    load.append(100);
+    EXPECT_GT(load.wPrimeBalance(), spent);
+    for (int i = 0; i < 3600; i++)
+        load.append(100);
+    EXPECT_LE(load.wPrimeBalance(), 20000);
+    EXPECT_GT(load.wPrimeBalance(), 19990);
+
+    load.clear();
+    EXPECT_DOUBLE_EQ(load.wPrimeBalance(), 20000);
+    EXPECT_EQ(load.count(), 0);
+}
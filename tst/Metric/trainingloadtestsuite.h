@@ -0,0 +1,26 @@
+#ifndef TRAININGLOADTESTSUITE_H
+#define TRAININGLOADTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class TrainingLoadTestSuite : public testing::Test {
+
+  public:
+    TrainingLoadTestSuite();
+
+    /**
+     * @brief Test NP, IF and TSS against a recomputation over the whole list of samples.
+     */
+    void test_normalizedPower();
+
+    /**
+     * @brief Test that W' is spent above the FTP and recovered below it, never above W'.
+     */
+    void test_wPrimeBalance();
+};
+
+TEST_F(TrainingLoadTestSuite, TestNormalizedPower) { this->test_normalizedPower(); }
+
+TEST_F(TrainingLoadTestSuite, TestWPrimeBalance) { this->test_wPrimeBalance(); }
+
+#endif // TRAININGLOADTESTSUITE_H
@@ -0,0 +1,100 @@
+#include "qfitwritertestsuite.h"
+
+#include "Tools/testsettings.h"
+#include "qfit.h"
+#include <QFile>
+#include <QTemporaryDir>
+
+namespace {
+SessionLine line(uint32_t elapsed, const QDateTime &start, const QGeoCoordinate &coordinate = QGeoCoordinate()) {
+    // idle for the first 10 seconds, the distance changes every 3 seconds
+    uint8_t cadence = elapsed < 10 ? 0 : 80 + elapsed % 10;
+    return SessionLine(elapsed < 10 ? 0 : 25.0, 1, (elapsed / 3) * 0.02, elapsed < 10 ? 0 : 150 + elapsed % 40, 10,
+                       20, 120 + elapsed % 30, 2.4, cadence, elapsed * 0.15, 0, elapsed, elapsed % 120 == 119, 0, 0,
+                       0, 0, coordinate, 0, 0, 0, 0, start.addSecs(elapsed));
+}
+
+QByteArray readAll(const QString &filename) {
+    QFile file(filename);
+    file.open(QIODevice::ReadOnly);
+    return file.readAll();
+}
+
+// golden is the file written by qfit::save, before it was built on qfitwriter, for the same 1000 lines
+void compare(uint32_t processFlag, const char *golden) {
+    // the golden files were written with the default settings
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.qsettings.clear();
+    testSettings.activate();
+
+    QTemporaryDir dir;
+    QString streamed = dir.filePath(QStringLiteral("streamed.fit"));
+    QString backup = dir.filePath(QStringLiteral("backup.fit"));
+    QString batch = dir.filePath(QStringLiteral("batch.fit"));
+    QDateTime start = QDateTime::fromSecsSinceEpoch(1700000000);
+
+    sessionstore session;
+    qfitwriter writer(bluetoothdevice::BIKE, processFlag);
+    for (uint32_t i = 0; i < 1000; i++) {
+        session.append(line(i, start));
+        writer.update(session);
+        if (i == 500) {
+            ASSERT_TRUE(writer.save(backup, session));
+        }
+    }
+    ASSERT_TRUE(writer.save(streamed, session, FIT_SPORT_INVALID, QStringLiteral("Workout")));
+    qfit::save(batch, session, bluetoothdevice::BIKE, processFlag, FIT_SPORT_INVALID, QStringLiteral("Workout"));
+
+    QByteArray expected = readAll(QStringLiteral(FIT_FIXTURES_DIR "/") + QLatin1String(golden));
+    ASSERT_FALSE(expected.isEmpty());
+    EXPECT_EQ(readAll(streamed), expected);
+    EXPECT_EQ(readAll(batch), expected);
+
+    sessionstore decodedStreamed;
+    sessionstore decodedBatch;
+    qfit::open(streamed, &decodedStreamed);
+    qfit::open(batch, &decodedBatch);
+    // the idle lines at the start aren't written
+    ASSERT_EQ(decodedBatch.count(), 990);
+    ASSERT_EQ(decodedStreamed.count(), decodedBatch.count());
+    for (int i = 0; i < decodedBatch.count(); i++) {
+        EXPECT_EQ(decodedStreamed.watt().at(i), decodedBatch.watt().at(i));
+        EXPECT_DOUBLE_EQ(decodedStreamed.distance().at(i), decodedBatch.distance().at(i));
+        EXPECT_EQ(decodedStreamed.time(i), decodedBatch.time(i));
+    }
+
+    // the backup is a complete file of the first half
+    sessionstore decodedBackup;
+    qfit::open(backup, &decodedBackup);
+    EXPECT_EQ(decodedBackup.count(), 491);
+}
+} // namespace
+
+QFitWriterTestSuite::QFitWriterTestSuite() {}
+
+void QFitWriterTestSuite::test_streamingMatchesBatch() { compare(QFIT_PROCESS_NONE, "bike-1000s.fit"); }
+
+void QFitWriterTestSuite::test_streamingMatchesBatchDistanceNoise() {
+    compare(QFIT_PROCESS_DISTANCENOISE, "bike-1000s-distancenoise.fit");
+}
+
+void QFitWriterTestSuite::test_lateGpsTrack() {
+    QTemporaryDir dir;
+    QDateTime start = QDateTime::fromSecsSinceEpoch(1700000000);
+
+    sessionstore session;
+    qfitwriter writer(bluetoothdevice::BIKE);
+    for (uint32_t i = 0; i < 100; i++) {
+        session.append(line(i, start, i < 50 ? QGeoCoordinate() : QGeoCoordinate(45.0, 9.0 + i * 0.0001, 120)));
+        writer.update(session);
+    }
+    EXPECT_FALSE(writer.isValid());
+    EXPECT_FALSE(writer.save(dir.filePath(QStringLiteral("streamed.fit")), session));
+
+    // qfit::save knows the track from the start and skips the lines without a coordinate
+    QString batch = dir.filePath(QStringLiteral("batch.fit"));
+    qfit::save(batch, session, bluetoothdevice::BIKE);
+    sessionstore decoded;
+    qfit::open(batch, &decoded);
+    EXPECT_EQ(decoded.count(), 50);
+}
@@ -0,0 +1,37 @@
+#ifndef QFITWRITERTESTSUITE_H
+#define QFITWRITERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class QFitWriterTestSuite : public testing::Test {
+
+  public:
+    QFitWriterTestSuite();
+
+    /**
+     * @brief Test that a FIT file encoded while the session is recorded has the same bytes of the file written by the
+     * qfit::save before the streaming writer (Session/fixtures), and the same decoded records of qfit::save, with laps,
+     * idle lines at the start and a backup saved in the middle.
+     */
+    void test_streamingMatchesBatch();
+
+    /**
+     * @brief Test the same with QFIT_PROCESS_DISTANCENOISE, where the records wait for the distance to change.
+     */
+    void test_streamingMatchesBatchDistanceNoise();
+
+    /**
+     * @brief Test that the writer refuses to save when a GPS track starts after some records without coordinates.
+     */
+    void test_lateGpsTrack();
+};
+
+TEST_F(QFitWriterTestSuite, TestStreamingMatchesBatch) { this->test_streamingMatchesBatch(); }
+
+TEST_F(QFitWriterTestSuite, TestStreamingMatchesBatchDistanceNoise) {
+    this->test_streamingMatchesBatchDistanceNoise();
+}
+
+TEST_F(QFitWriterTestSuite, TestLateGpsTrack) { this->test_lateGpsTrack(); }
+
+#endif // QFITWRITERTESTSUITE_H
@@ -0,0 +1,121 @@
+#include "sessionjournaltestsuite.h"
+
+#include "sessionjournal.h"
+#include <QFile>
+#include <QTemporaryDir>
+
+#ifdef Q_OS_UNIX
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace {
+const uint32_t deviceType = 2;
+
+SessionLine line(uint32_t elapsed, const QDateTime &start) {
+    return SessionLine(20.5, 2, elapsed / 100.0, 150 + elapsed % 50, 12, 30, 130, 2.9, 85, elapsed * 0.2, 1.5,
+                       elapsed, elapsed % 60 == 0, 0, 0, 0, 0, QGeoCoordinate(), 0, 0, 0, elapsed * 1.5,
+                       start.addSecs(elapsed));
+}
+
+void expectLines(const sessionstore &session, int count, const QDateTime &start) {
+    ASSERT_EQ(session.count(), count);
+    for (int i = 0; i < count; i++) {
+        SessionLine expected = line(i, start);
+        EXPECT_EQ(session.elapsedTime().at(i), expected.elapsedTime);
+        EXPECT_EQ(session.watt().at(i), expected.watt);
+        EXPECT_DOUBLE_EQ(session.distance().at(i), expected.distance);
+        EXPECT_EQ(session.time(i), expected.time);
+    }
+}
+} // namespace
+
+SessionJournalTestSuite::SessionJournalTestSuite() {}
+
+void SessionJournalTestSuite::test_roundTrip() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath(QStringLiteral("session.qzj"));
+    QDateTime start = QDateTime::fromMSecsSinceEpoch(1700000000000);
+
+    sessionjournal journal(filename);
+    for (uint32_t i = 0; i < 300; i++) {
+        journal.append(line(i, start), deviceType);
+    }
+    journal.sync();
+
+    sessionstore session;
+    uint32_t type = 0;
+    ASSERT_TRUE(sessionjournal::read(filename, &session, &type));
+    EXPECT_EQ(type, deviceType);
+    expectLines(session, 300, start);
+
+    // a saved workout doesn't leave its journal behind
+    journal.finish();
+    EXPECT_FALSE(QFile::exists(filename));
+}
+
+void SessionJournalTestSuite::test_tornTail() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath(QStringLiteral("session.qzj"));
+    QDateTime start = QDateTime::fromMSecsSinceEpoch(1700000000000);
+
+    {
+        sessionjournal journal(filename);
+        for (uint32_t i = 0; i < 50; i++) {
+            journal.append(line(i, start), deviceType);
+        }
+        journal.sync();
+    }
+
+    // cut the last record in half
+    QFile file(filename);
+    ASSERT_TRUE(file.resize(file.size() - sessionjournal::recordSize / 2));
+
+    sessionstore session;
+    ASSERT_TRUE(sessionjournal::read(filename, &session, nullptr));
+    expectLines(session, 49, start);
+
+    // a whole record of garbage after the valid ones
+    file.resize(file.size() - (sessionjournal::recordSize - sessionjournal::recordSize / 2));
+    ASSERT_TRUE(file.open(QIODevice::Append));
+    file.write(QByteArray(sessionjournal::recordSize, '\x5a'));
+    file.close();
+
+    session.clear();
+    ASSERT_TRUE(sessionjournal::read(filename, &session, nullptr));
+    expectLines(session, 49, start);
+}
+
+void SessionJournalTestSuite::test_killedWriter() {
+#ifdef Q_OS_UNIX
+    QTemporaryDir dir;
+    QString filename = dir.filePath(QStringLiteral("session.qzj"));
+    QDateTime start = QDateTime::fromMSecsSinceEpoch(1700000000000);
+
+    pid_t child = fork();
+    ASSERT_NE(child, -1);
+    if (child == 0) {
+        // the writer thread isn't inherited by fork(), the child builds its own journal
+        sessionjournal journal(filename);
+        journal.setSyncRecords(1);
+        for (uint32_t i = 0;; i++) {
+            journal.append(line(i, start), deviceType);
+        }
+    }
+
+    // wait for the child to write something, then kill it wherever it is
+    for (int i = 0; i < 500 && QFile(filename).size() < 64 * sessionjournal::recordSize; i++) {
+        usleep(10000);
+    }
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+
+    sessionstore session;
+    ASSERT_TRUE(sessionjournal::read(filename, &session, nullptr));
+    EXPECT_GT(session.count(), 0);
+    expectLines(session, session.count(), start);
+#else
+    GTEST_SKIP() << "fork() is not available";
+#endif
+}
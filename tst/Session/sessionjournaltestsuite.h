@@ -0,0 +1,34 @@
+#ifndef SESSIONJOURNALTESTSUITE_H
+#define SESSIONJOURNALTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class SessionJournalTestSuite : public testing::Test {
+
+  public:
+    SessionJournalTestSuite();
+
+    /**
+     * @brief Test that the lines appended to the journal are read back after a sync.
+     */
+    void test_roundTrip();
+
+    /**
+     * @brief Test that a torn or garbled record at the end of the journal is ignored and the records before it are
+     * recovered.
+     */
+    void test_tornTail();
+
+    /**
+     * @brief Test that a process killed while appending leaves a journal with a valid prefix of its records.
+     */
+    void test_killedWriter();
+};
+
+TEST_F(SessionJournalTestSuite, TestRoundTrip) { this->test_roundTrip(); }
+
+TEST_F(SessionJournalTestSuite, TestTornTail) { this->test_tornTail(); }
+
+TEST_F(SessionJournalTestSuite, TestKilledWriter) { this->test_killedWriter(); }
+
+#endif // SESSIONJOURNALTESTSUITE_H
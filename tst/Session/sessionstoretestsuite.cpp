@@ -0,0 +1,182 @@
+#include "sessionstoretestsuite.h"
+
+#include "metric.h"
+#include "sessionstore.h"
+
+#include <QElapsedTimer>
+
+namespace {
+SessionLine line(uint32_t elapsed, const QDateTime &time, const QGeoCoordinate &coordinate = QGeoCoordinate()) {
+    return SessionLine(20.5, 2, elapsed / 100.0, 150 + elapsed % 50, 12, 30, 130, 2.9, 85, elapsed * 0.2, 1.5,
+                       elapsed, elapsed % 60 == 0, 0, 0, 0, 0, coordinate, 0, 0, 0, elapsed * 1.5, time);
+}
+
+// best average over d consecutive values, by brute force
+double bruteForceBest(const QList<double> &perSecond, int d) {
+    double best = 0;
+    for (int end = d; end <= perSecond.count(); end++) {
+        double sum = 0;
+        for (int j = end - d; j < end; j++)
+            sum += perSecond.at(j);
+        best = qMax(best, sum / d);
+    }
+    return best;
+}
+} // namespace
+
+SessionStoreTestSuite::SessionStoreTestSuite() {}
+
+void SessionStoreTestSuite::test_roundTrip() {
+    sessionstore session;
+    EXPECT_TRUE(session.isEmpty());
+
+    QDateTime start = QDateTime::fromMSecsSinceEpoch(1700000000123);
+    for (uint32_t i = 0; i < 600; i++) {
+        session.append(line(i, start.addMSecs(i * 1000 + i % 7)));
+    }
+
+    ASSERT_EQ(session.count(), 600);
+    for (int i = 0; i < session.count(); i++) {
+        SessionLine expected = line(i, start.addMSecs(i * 1000 + i % 7));
+        SessionLine actual = session.at(i);
+        EXPECT_EQ(actual.watt, expected.watt);
+        EXPECT_EQ(session.watt().at(i), expected.watt);
+        EXPECT_EQ(actual.heart, expected.heart);
+        EXPECT_EQ(actual.cadence, expected.cadence);
+        EXPECT_EQ(actual.resistance, expected.resistance);
+        EXPECT_EQ(actual.elapsedTime, expected.elapsedTime);
+        EXPECT_EQ(actual.lapTrigger, expected.lapTrigger);
+        EXPECT_DOUBLE_EQ(actual.distance, expected.distance);
+        EXPECT_DOUBLE_EQ(actual.calories, expected.calories);
+        EXPECT_FLOAT_EQ(actual.speed, expected.speed);
+        EXPECT_FLOAT_EQ(actual.stepCount, expected.stepCount);
+        EXPECT_EQ(actual.time, expected.time);
+        EXPECT_FALSE(actual.coordinate.isValid());
+    }
+    EXPECT_EQ(session.last().elapsedTime, 599u);
+
+    session.clear();
+    EXPECT_TRUE(session.isEmpty());
+    EXPECT_FALSE(session.hasCoordinates());
+}
+
+void SessionStoreTestSuite::test_coordinates() {
+    sessionstore session;
+    QDateTime start = QDateTime::fromMSecsSinceEpoch(1700000000000);
+
+    session.append(line(0, start));
+    session.append(line(1, start.addSecs(1)));
+    EXPECT_FALSE(session.hasCoordinates());
+
+    session.append(line(2, start.addSecs(2), QGeoCoordinate(45.5, 9.2, 120)));
+    session.append(line(3, start.addSecs(3)));
+    EXPECT_TRUE(session.hasCoordinates());
+
+    EXPECT_FALSE(session.coordinateIsValid(0));
+    EXPECT_FALSE(session.coordinateIsValid(1));
+    EXPECT_TRUE(session.coordinateIsValid(2));
+    EXPECT_FALSE(session.coordinateIsValid(3));
+    EXPECT_EQ(session.coordinate(2), QGeoCoordinate(45.5, 9.2, 120));
+    EXPECT_EQ(session.at(2).coordinate, QGeoCoordinate(45.5, 9.2, 120));
+}
+
+void SessionStoreTestSuite::test_powerCurve() {
+    sessionstore session;
+    QDateTime start = QDateTime::fromMSecsSinceEpoch(1700000000000);
+    QList<double> watts;
+
+    EXPECT_EQ(metric::powerPeak(&session, 5), -1);
+
+    for (uint32_t i = 0; i < 900; i++) {
+        SessionLine l = line(i, start.addSecs(i));
+        l.watt = 100 + (i * 7919) % 300;
+        session.append(l);
+        watts.append(l.watt);
+    }
+
+    const powercurve &curve = session.powerCurve();
+    ASSERT_EQ(curve.count(), 900);
+    for (int d = 1; d <= watts.count(); d++) {
+        EXPECT_NEAR(curve.best(d), bruteForceBest(watts, d), 1e-9) << "duration " << d;
+    }
+
+    EXPECT_EQ(curve.best(901), 0);
+    EXPECT_DOUBLE_EQ(metric::powerPeak(&session, 60), curve.best(60));
+    EXPECT_EQ(metric::powerPeak(&session, 20 * 60), -1);
+
+    session.clear();
+    EXPECT_EQ(session.powerCurve().count(), 0);
+}
+
+void SessionStoreTestSuite::test_powerCurveRate() {
+    QDateTime start = QDateTime::fromMSecsSinceEpoch(1700000000000);
+
+    // 4 Hz: the four samples of an elapsed second are averaged into that second
+    sessionstore fast;
+    QList<double> perSecond;
+    for (uint32_t i = 0; i < 4 * 600; i++) {
+        SessionLine l = line(i / 4, start.addMSecs(i * 250));
+        l.watt = 100 + (i * 7919) % 300;
+        fast.append(l);
+        if (i % 4 == 0)
+            perSecond.append(0);
+        perSecond.last() += l.watt / 4.0;
+    }
+
+    ASSERT_EQ(fast.powerCurve().count(), 600);
+    for (int d : {1, 5, 7, 60, 61, 300, 599, 600}) {
+        EXPECT_NEAR(fast.powerCurve().best(d), bruteForceBest(perSecond, d), 1e-9) << "duration " << d;
+    }
+    EXPECT_EQ(metric::powerPeak(&fast, 20 * 60), -1);
+
+    // 0.5 Hz: every sample holds for the two seconds since the previous one
+    sessionstore slow;
+    perSecond.clear();
+    for (uint32_t i = 0; i < 300; i++) {
+        SessionLine l = line(i * 2, start.addSecs(i * 2));
+        l.watt = 100 + (i * 7919) % 300;
+        slow.append(l);
+        if (i > 0)
+            perSecond.append(l.watt);
+        perSecond.append(l.watt);
+    }
+
+    ASSERT_EQ(slow.powerCurve().count(), 599);
+    for (int d : {1, 2, 3, 60, 300, 599}) {
+        EXPECT_NEAR(slow.powerCurve().best(d), bruteForceBest(perSecond, d), 1e-9) << "duration " << d;
+    }
+}
+
+void SessionStoreTestSuite::test_benchmarkPowerCurve() {
+    const int samples = 6 * 3600;
+    QDateTime start = QDateTime::fromMSecsSinceEpoch(1700000000000);
+    QVector<SessionLine> lines;
+    QList<double> watts;
+    lines.reserve(samples);
+    for (int i = 0; i < samples; i++) {
+        SessionLine l = line(i, start.addSecs(i));
+        l.watt = 100 + (i * 7919) % 300;
+        lines.append(l);
+        watts.append(l.watt);
+    }
+
+    sessionstore session;
+    QElapsedTimer timer;
+    timer.start();
+    for (const SessionLine &l : lines) {
+        session.append(l);
+    }
+    const qint64 appendNs = timer.nsecsElapsed();
+
+    // an untracked duration is computed on demand with one pass
+    timer.restart();
+    const double best7 = session.powerCurve().best(7);
+    const qint64 lookupNs = timer.nsecsElapsed();
+
+    RecordProperty("appendNsPerLine", static_cast<int>(appendNs / samples));
+    RecordProperty("best7Ns", static_cast<int>(lookupNs));
+
+    EXPECT_NEAR(best7, bruteForceBest(watts, 7), 1e-9);
+    EXPECT_GE(session.powerCurve().best(5), session.powerCurve().best(60));
+    EXPECT_GE(session.powerCurve().best(60), session.powerCurve().best(3600));
+}
@@ -0,0 +1,49 @@
+#ifndef SESSIONSTORETESTSUITE_H
+#define SESSIONSTORETESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class SessionStoreTestSuite : public testing::Test {
+
+  public:
+    SessionStoreTestSuite();
+
+    /**
+     * @brief Test that the lines appended to the store are read back from the columns and from at().
+     */
+    void test_roundTrip();
+
+    /**
+     * @brief Test that the coordinate columns are allocated only once a valid coordinate is appended.
+     */
+    void test_coordinates();
+
+    /**
+     * @brief Test the mean-maximal power curve kept by the store against a brute force search.
+     */
+    void test_powerCurve();
+
+    /**
+     * @brief Test that the power curve durations are seconds of elapsed time with a device notifying at 4 Hz and
+     * with one notifying every 2 seconds.
+     */
+    void test_powerCurveRate();
+
+    /**
+     * @brief Measure loading a 6 hours session into the store: the power curve must keep append() cheap.
+     * Disabled by default, run it with --gtest_also_run_disabled_tests: the timings are recorded as test properties.
+     */
+    void test_benchmarkPowerCurve();
+};
+
+TEST_F(SessionStoreTestSuite, TestRoundTrip) { this->test_roundTrip(); }
+
+TEST_F(SessionStoreTestSuite, TestCoordinates) { this->test_coordinates(); }
+
+TEST_F(SessionStoreTestSuite, TestPowerCurve) { this->test_powerCurve(); }
+
+TEST_F(SessionStoreTestSuite, TestPowerCurveRate) { this->test_powerCurveRate(); }
+
+TEST_F(SessionStoreTestSuite, DISABLED_BenchmarkPowerCurve) { this->test_benchmarkPowerCurve(); }
+
+#endif // SESSIONSTORETESTSUITE_H
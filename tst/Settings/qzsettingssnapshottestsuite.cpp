@@ -0,0 +1,116 @@
+#include "qzsettingssnapshottestsuite.h"
+
+#include "Tools/testsettings.h"
+#include "metric.h"
+#include "qzsettings.h"
+#include "qzsettingssnapshot.h"
+
+#include <QElapsedTimer>
+
+QZSettingsSnapshotTestSuite::QZSettingsSnapshotTestSuite() {}
+
+void QZSettingsSnapshotTestSuite::test_refresh() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+
+    testSettings.qsettings.setValue(QZSettings::watt_gain, 1.5);
+    testSettings.qsettings.setValue(QZSettings::miles_unit, true);
+    QZSettingsSnapshot::refresh();
+
+    const QZSettingsSnapshot &first = QZSettingsSnapshot::get();
+    EXPECT_DOUBLE_EQ(first.watt_gain, 1.5);
+    EXPECT_TRUE(first.miles_unit);
+
+    // nothing changed: the same snapshot must be kept
+    EXPECT_FALSE(QZSettingsSnapshot::refresh());
+    EXPECT_EQ(&first, &QZSettingsSnapshot::get());
+
+    QZSettingsSnapshot::setValue(QZSettings::watt_gain, 1.2);
+    const QZSettingsSnapshot &second = QZSettingsSnapshot::get();
+    EXPECT_NE(&first, &second);
+    EXPECT_EQ(second.generation, first.generation + 1);
+    EXPECT_DOUBLE_EQ(second.watt_gain, 1.2);
+
+    // the old snapshot is still readable by whoever kept a reference to it
+    EXPECT_DOUBLE_EQ(first.watt_gain, 1.5);
+
+    testSettings.qsettings.remove(QZSettings::watt_gain);
+    testSettings.qsettings.remove(QZSettings::miles_unit);
+    QZSettingsSnapshot::refresh();
+    EXPECT_DOUBLE_EQ(QZSettingsSnapshot::get().watt_gain, QZSettings::default_watt_gain);
+}
+
+void QZSettingsSnapshotTestSuite::test_metricGainAndOffset() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+
+    testSettings.qsettings.setValue(QZSettings::watt_gain, 1.1);
+    testSettings.qsettings.setValue(QZSettings::watt_offset, 5.0);
+    testSettings.qsettings.setValue(QZSettings::speed_gain, 2.0);
+    QZSettingsSnapshot::refresh();
+
+    metric watt;
+    watt.setType(metric::METRIC_WATT);
+    watt.setValue(100);
+    EXPECT_DOUBLE_EQ(watt.valueRaw(), 100 * 1.1 + 5.0);
+
+    metric speed;
+    speed.setType(metric::METRIC_SPEED);
+    speed.setValue(10);
+    EXPECT_DOUBLE_EQ(speed.valueRaw(), 20);
+
+    testSettings.qsettings.remove(QZSettings::watt_gain);
+    testSettings.qsettings.remove(QZSettings::watt_offset);
+    testSettings.qsettings.remove(QZSettings::speed_gain);
+    QZSettingsSnapshot::refresh();
+}
+
+void QZSettingsSnapshotTestSuite::test_benchmarkPerSampleReads() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    testSettings.qsettings.setValue(QZSettings::watt_gain, 1.0);
+    testSettings.qsettings.setValue(QZSettings::watt_offset, 0.0);
+    QZSettingsSnapshot::refresh();
+
+    const int samples = 20000;
+    double qsettingsSum = 0;
+    double snapshotSum = 0;
+    QElapsedTimer timer;
+
+    // what metric::setValue used to do for every watt sample
+    timer.start();
+    for (int i = 0; i < samples; i++) {
+        QSettings settings;
+        double v = i;
+        if (settings.value(QZSettings::watt_gain, QZSettings::default_watt_gain).toDouble() <= 2.00) {
+            if (settings.value(QZSettings::watt_gain, QZSettings::default_watt_gain).toDouble() != 1.0) {
+                qsettingsSum += settings.value(QZSettings::watt_gain, QZSettings::default_watt_gain).toDouble();
+            }
+            v *= settings.value(QZSettings::watt_gain, QZSettings::default_watt_gain).toDouble();
+        }
+        if (settings.value(QZSettings::watt_offset, QZSettings::default_watt_offset).toDouble() != 0.0) {
+            v += settings.value(QZSettings::watt_offset, QZSettings::default_watt_offset).toDouble();
+        }
+        qsettingsSum += v;
+    }
+    qint64 qsettingsNs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int i = 0; i < samples; i++) {
+        const QZSettingsSnapshot &snapshot = QZSettingsSnapshot::get();
+        double v = i;
+        if (snapshot.watt_gain <= 2.00) {
+            v *= snapshot.watt_gain;
+        }
+        if (snapshot.watt_offset != 0.0) {
+            v += snapshot.watt_offset;
+        }
+        snapshotSum += v;
+    }
+    qint64 snapshotNs = timer.nsecsElapsed();
+
+    RecordProperty("qsettingsNsPerSample", static_cast<int>(qsettingsNs / samples));
+    RecordProperty("snapshotNsPerSample", static_cast<int>(snapshotNs / samples));
+
+    EXPECT_DOUBLE_EQ(snapshotSum, qsettingsSum);
+}
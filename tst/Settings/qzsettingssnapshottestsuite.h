@@ -0,0 +1,34 @@
+#ifndef QZSETTINGSSNAPSHOTTESTSUITE_H
+#define QZSETTINGSSNAPSHOTTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class QZSettingsSnapshotTestSuite : public testing::Test {
+
+  public:
+    QZSettingsSnapshotTestSuite();
+
+    /**
+     * @brief Test that the snapshot follows the QSettings values and is republished only when they change.
+     */
+    void test_refresh();
+
+    /**
+     * @brief Test that metric applies the watt/speed gain and offset read from the snapshot.
+     */
+    void test_metricGainAndOffset();
+
+    /**
+     * @brief Compare the per-sample cost of the QSettings reads done by metric::setValue with the snapshot reads.
+     * Disabled by default, run it with --gtest_also_run_disabled_tests: the timings are recorded as test properties.
+     */
+    void test_benchmarkPerSampleReads();
+};
+
+TEST_F(QZSettingsSnapshotTestSuite, TestRefresh) { this->test_refresh(); }
+
+TEST_F(QZSettingsSnapshotTestSuite, TestMetricGainAndOffset) { this->test_metricGainAndOffset(); }
+
+TEST_F(QZSettingsSnapshotTestSuite, DISABLED_BenchmarkPerSampleReads) { this->test_benchmarkPerSampleReads(); }
+
+#endif // QZSETTINGSSNAPSHOTTESTSUITE_H
@@ -0,0 +1,214 @@
+#include "gattreplaytestsuite.h"
+
+#include "Tools/gattreplay.h"
+#include "Tools/testsettings.h"
+#include "devices/domyostreadmill/domyostreadmill.h"
+#include "devices/ftmsbike/ftmsbike.h"
+#include "monotonicclock.h"
+#include "qzsettings.h"
+
+#include <QTemporaryFile>
+#include <QTextStream>
+
+namespace {
+const QBluetoothUuid domyosNotify(QStringLiteral("49535343-1e4d-4bd9-ba61-23c647249616"));
+
+qint64 fakeNow = 0;
+qint64 fakeClock() { return fakeNow; }
+void fakeWait(qint64 ns) { fakeNow += ns; }
+
+QString btlog(const char *name) { return QStringLiteral(BTLOGS_DIR "/") + QLatin1String(name); }
+
+void setupDomyos(TestSettings &testSettings) {
+    testSettings.activate();
+    testSettings.qsettings.clear();
+    // the heart rate of the treadmill is used only without a belt
+    testSettings.qsettings.setValue(QZSettings::heart_rate_belt_name, QStringLiteral("Disabled"));
+}
+} // namespace
+
+GattReplayTestSuite::GattReplayTestSuite() {}
+
+void GattReplayTestSuite::test_readBtsnoop() {
+    QString error;
+    QVector<GattReplay::Notification> notifications = GattReplay::read(btlog("btsnoop_hci.log"), &error);
+    EXPECT_TRUE(error.isEmpty()) << error.toStdString();
+    ASSERT_EQ(notifications.count(), 1030);
+
+    // the ISSC transparent UART of the treadmill, discovered in the same capture
+    QVector<QBluetoothUuid> characteristics = GattReplay::characteristics(notifications);
+    ASSERT_EQ(characteristics.count(), 1);
+    EXPECT_EQ(characteristics.first(), domyosNotify);
+    EXPECT_EQ(notifications.first().connection, 2);
+    EXPECT_EQ(notifications.first().handle, 82);
+    EXPECT_EQ(GattReplay::filter(notifications, domyosNotify).count(), 1030);
+
+    qint64 last = 0;
+    for (const GattReplay::Notification &n : notifications) {
+        EXPECT_GE(n.timestampUs, last);
+        last = n.timestampUs;
+    }
+    EXPECT_NEAR((notifications.last().timestampUs - notifications.first().timestampUs) / 1000000.0, 153.0, 1.0);
+
+    // the 26 bytes frames arrive as 20 + 6
+    EXPECT_EQ(notifications.first().value.length() + notifications.at(1).value.length(), 26);
+
+    EXPECT_TRUE(GattReplay::readBtsnoop(btlog("missing.log"), &error).isEmpty());
+    EXPECT_FALSE(error.isEmpty());
+}
+
+void GattReplayTestSuite::test_readDebugLog() {
+    QTemporaryFile file;
+    ASSERT_TRUE(file.open());
+    {
+        QTextStream stream(&file);
+        stream << "Sat Oct 18 10:00:00 2026 1792317600000 Debug: ftmsbike.cpp void "
+                  "ftmsbike::characteristicChanged(const QLowEnergyCharacteristic&, const QByteArray&) "
+                  "QUuid(\"{00002ad2-0000-1000-8000-00805f9b34fb}\") 9 \" << \" \"44 02 c4 09 b4 00 fa 00 8c\"\n";
+        stream << "Sat Oct 18 10:00:00 2026 1792317600100 Debug: bluetooth.cpp void bluetooth::debug(const "
+                  "QString&) \" << 6 f0 bc 01 02 03 04\"\n";
+        stream << "Sat Oct 18 10:00:00 2026 1792317600200 Debug: solebike.cpp void "
+                  "solebike::characteristicChanged(const QLowEnergyCharacteristic&, const QByteArray&) \" << 5b 04\"\n";
+        // not a notification
+        stream << "Sat Oct 18 10:00:00 2026 1792317600300 Debug: solebike.cpp void solebike::update() \" >> 5b 04\"\n";
+        stream << "Sat Oct 18 10:00:00 2026 1792317600400 Debug: homeform.cpp void homeform::update() "
+                  "\" << not hex\"\n";
+    }
+    file.close();
+
+    QVector<GattReplay::Notification> notifications = GattReplay::read(file.fileName());
+    ASSERT_EQ(notifications.count(), 3);
+
+    EXPECT_EQ(notifications.at(0).uuid, QBluetoothUuid((quint16)0x2AD2));
+    EXPECT_EQ(notifications.at(0).value, QByteArray::fromHex("4402c409b400fa008c"));
+    EXPECT_EQ(notifications.at(0).timestampUs, Q_INT64_C(1792317600000000));
+
+    EXPECT_TRUE(notifications.at(1).uuid.isNull());
+    EXPECT_EQ(notifications.at(1).value, QByteArray::fromHex("f0bc01020304"));
+
+    EXPECT_EQ(notifications.at(2).value, QByteArray::fromHex("5b04"));
+    EXPECT_EQ(notifications.at(2).timestampUs - notifications.at(0).timestampUs, 200000);
+}
+
+void GattReplayTestSuite::test_replayDomyosTreadmill() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    setupDomyos(testSettings);
+
+    QVector<GattReplay::Notification> notifications = GattReplay::read(btlog("heart200andstop.log"));
+    ASSERT_FALSE(notifications.isEmpty());
+
+    domyostreadmill device(200, true, true);
+    GattReplay::attach(&device);
+    GattReplay::Result result = GattReplay::replay(&device, notifications);
+    ASSERT_EQ(result.samples.count(), notifications.count());
+
+    // rebuild the frames as the driver does and check the metrics right after each of them
+    QByteArray last;
+    int frames = 0;
+    double maxHeart = 0;
+    for (int i = 0; i < notifications.count(); i++) {
+        QByteArray value = notifications.at(i).value;
+        if (last.length() == 20 && last.startsWith("\xf0\xbc") && value.length() == 6) {
+            value = last + value;
+        }
+        last = value;
+        if (value.length() != 26) {
+            continue;
+        }
+        frames++;
+        const GattReplay::Sample &s = result.samples.at(i);
+        EXPECT_DOUBLE_EQ(s.speed, (quint8)value.at(7) / 10.0) << "notification " << i;
+        if ((quint8)value.at(18)) {
+            EXPECT_DOUBLE_EQ(s.heart, (quint8)value.at(18)) << "notification " << i;
+        }
+        maxHeart = qMax(maxHeart, s.heart);
+    }
+    EXPECT_EQ(frames, 669);
+    EXPECT_GE(maxHeart, 200);
+    // the treadmill was stopped at the end of the capture
+    EXPECT_DOUBLE_EQ(result.samples.last().speed, 0);
+}
+
+void GattReplayTestSuite::test_replayTiming() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    setupDomyos(testSettings);
+
+    // the first 3 seconds of the capture, 6 times faster
+    QVector<GattReplay::Notification> notifications;
+    for (const GattReplay::Notification &n : GattReplay::read(btlog("btsnoop_hci.log"))) {
+        if (!notifications.isEmpty() && n.timestampUs - notifications.first().timestampUs > 3000000) {
+            break;
+        }
+        notifications.append(n);
+    }
+    ASSERT_GT(notifications.count(), 2);
+
+    fakeNow = 1000000000LL;
+    monotonicclock::setSource(fakeClock);
+    GattReplay::setWaiter(fakeWait);
+
+    domyostreadmill device(200, true, true);
+    GattReplay::attach(&device);
+    GattReplay::Result result = GattReplay::replay(&device, notifications, 6);
+    ASSERT_EQ(result.samples.count(), notifications.count());
+
+    const qint64 first = notifications.first().timestampUs;
+    qint64 expectedNs = 0;
+    for (int i = 0; i < notifications.count(); i++) {
+        expectedNs = qint64((notifications.at(i).timestampUs - first) * 1000 / 6.0);
+        EXPECT_EQ(result.samples.at(i).replayedNs, expectedNs) << "notification " << i;
+    }
+    EXPECT_EQ(result.elapsedMs, expectedNs / 1000000);
+    // the replay waited only for the gaps of the capture
+    EXPECT_EQ(fakeNow, 1000000000LL + expectedNs);
+
+    GattReplay::setWaiter(nullptr);
+    monotonicclock::setSource(nullptr);
+}
+
+void GattReplayTestSuite::test_replayFtmsBikeDistance() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    testSettings.qsettings.clear();
+
+    fakeNow = 1000000000LL;
+    monotonicclock::setSource(fakeClock);
+
+    // indoor bike data with the instantaneous speed only, 25.00 km/h
+    GattReplay::Notification n;
+    n.uuid = QBluetoothUuid((quint16)0x2AD2);
+    n.value = QByteArray::fromHex("0000c409");
+    const QVector<GattReplay::Notification> notifications({n});
+
+    ftmsbike device(false, false, 0, 1.0);
+    GattReplay::attach(&device);
+    GattReplay::replay(&device, notifications);
+    EXPECT_DOUBLE_EQ(device.currentSpeed().value(), 25.0);
+    EXPECT_DOUBLE_EQ(device.currentDistance().value(), 0.0);
+
+    // an hour later on the monotonic clock, a few milliseconds on the wall clock
+    fakeNow += 3600LL * 1000000000LL;
+    GattReplay::replay(&device, notifications);
+    EXPECT_NEAR(device.currentDistance().value(), 25.0, 0.001);
+
+    monotonicclock::setSource(nullptr);
+}
+
+void GattReplayTestSuite::test_benchmarkReplay() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    setupDomyos(testSettings);
+
+    QVector<GattReplay::Notification> notifications = GattReplay::read(btlog("btsnoop_hci.log"));
+    ASSERT_FALSE(notifications.isEmpty());
+
+    domyostreadmill device(200, true, true);
+    GattReplay::attach(&device);
+    GattReplay::Result result = GattReplay::replay(&device, notifications);
+
+    EXPECT_EQ(result.samples.count(), notifications.count());
+
+    RecordProperty("notifications", result.samples.count());
+    RecordProperty("nsPerNotification", static_cast<int>(result.nsPerNotification()));
+    RecordProperty("maxProcessingNs", static_cast<int>(result.maxProcessingNs));
+    RecordProperty("elapsedMs", static_cast<int>(result.elapsedMs));
+}
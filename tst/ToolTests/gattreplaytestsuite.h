@@ -0,0 +1,59 @@
+#ifndef GATTREPLAYTESTSUITE_H
+#define GATTREPLAYTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class GattReplayTestSuite : public testing::Test {
+
+  public:
+    GattReplayTestSuite();
+
+    /**
+     * @brief Test the notifications and the characteristic read from btlogs/btsnoop_hci.log.
+     */
+    void test_readBtsnoop();
+
+    /**
+     * @brief Test the notifications read from the lines of a qz debug log, with and without the characteristic and the
+     * length.
+     */
+    void test_readDebugLog();
+
+    /**
+     * @brief Replay btlogs/heart200andstop.log into a Domyos treadmill and check the speed and the heart rate of
+     * every complete frame.
+     */
+    void test_replayDomyosTreadmill();
+
+    /**
+     * @brief Test that an accelerated replay feeds every notification at its time in the capture divided by the
+     * speedup, on the monotonic clock.
+     */
+    void test_replayTiming();
+
+    /**
+     * @brief Test that an FTMS bike integrates the distance on the monotonic clock: an hour of it at 25 km/h is 25 km
+     * whatever the wall clock does.
+     */
+    void test_replayFtmsBikeDistance();
+
+    /**
+     * @brief Measure the time the Domyos treadmill takes to process each notification of btlogs/btsnoop_hci.log.
+     * Disabled by default, run it with --gtest_also_run_disabled_tests: the timings are recorded as test properties.
+     */
+    void test_benchmarkReplay();
+};
+
+TEST_F(GattReplayTestSuite, TestReadBtsnoop) { this->test_readBtsnoop(); }
+
+TEST_F(GattReplayTestSuite, TestReadDebugLog) { this->test_readDebugLog(); }
+
+TEST_F(GattReplayTestSuite, TestReplayDomyosTreadmill) { this->test_replayDomyosTreadmill(); }
+
+TEST_F(GattReplayTestSuite, TestReplayTiming) { this->test_replayTiming(); }
+
+TEST_F(GattReplayTestSuite, TestReplayFtmsBikeDistance) { this->test_replayFtmsBikeDistance(); }
+
+TEST_F(GattReplayTestSuite, DISABLED_BenchmarkReplay) { this->test_benchmarkReplay(); }
+
+#endif // GATTREPLAYTESTSUITE_H
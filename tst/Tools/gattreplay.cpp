@@ -0,0 +1,388 @@
+#include "gattreplay.h"
+
+#include "devices/bluetoothdevice.h"
+#include "monotonicclock.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QHash>
+#include <QLowEnergyCharacteristic>
+#include <QLowEnergyCharacteristicData>
+#include <QLowEnergyController>
+#include <QLowEnergyService>
+#include <QLowEnergyServiceData>
+#include <QRegularExpression>
+#include <QScopedPointer>
+#include <QStringList>
+#include <QTextStream>
+#include <QTimer>
+#include <QtEndian>
+
+namespace {
+const int btsnoopHeaderSize = 16;
+const int btsnoopRecordSize = 24;
+const quint32 datalinkHci = 1001;
+const quint32 datalinkH4 = 1002;
+
+const quint8 h4Acl = 0x02;
+const quint16 l2capAtt = 0x0004;
+
+const quint8 attReadByTypeRequest = 0x08;
+const quint8 attReadByTypeResponse = 0x09;
+const quint8 attNotification = 0x1B;
+const quint8 attIndication = 0x1D;
+const quint16 characteristicDeclaration = 0x2803;
+
+// the bytes of a uuid as they are sent, little endian
+QBluetoothUuid uuidFromAtt(const uchar *p, int size) {
+    if (size == 2) {
+        return QBluetoothUuid(qFromLittleEndian<quint16>(p));
+    }
+    if (size == 16) {
+        quint128 uuid;
+        for (int i = 0; i < 16; i++) {
+            uuid.data[i] = p[15 - i];
+        }
+        return QBluetoothUuid(uuid);
+    }
+    return QBluetoothUuid();
+}
+
+quint32 key(quint16 connection, quint16 handle) { return (quint32(connection) << 16) | handle; }
+
+struct attstate {
+    // the ACL packets of an L2CAP frame not complete yet, by connection
+    QHash<quint16, QByteArray> fragments;
+    // the type of the last read by type request, by connection
+    QHash<quint16, quint16> readByType;
+    // the uuid of the value handles, by connection and handle
+    QHash<quint32, QBluetoothUuid> characteristics;
+};
+
+void parseAtt(attstate &state, quint16 connection, const QByteArray &pdu, qint64 timestampUs,
+              QVector<GattReplay::Notification> &out) {
+    const uchar *p = reinterpret_cast<const uchar *>(pdu.constData());
+    const int length = pdu.length();
+    if (length < 1) {
+        return;
+    }
+    switch (p[0]) {
+    case attReadByTypeRequest:
+        if (length >= 7) {
+            state.readByType[connection] = qFromLittleEndian<quint16>(p + 5);
+        }
+        break;
+    case attReadByTypeResponse: {
+        if (length < 2 || state.readByType.value(connection) != characteristicDeclaration) {
+            break;
+        }
+        // declaration handle (2), properties (1), value handle (2), uuid (2 or 16)
+        const int entry = p[1];
+        if (entry != 7 && entry != 21) {
+            break;
+        }
+        for (int i = 2; i + entry <= length; i += entry) {
+            quint16 valueHandle = qFromLittleEndian<quint16>(p + i + 3);
+            state.characteristics[key(connection, valueHandle)] = uuidFromAtt(p + i + 5, entry - 5);
+        }
+        break;
+    }
+    case attNotification:
+    case attIndication: {
+        if (length < 3) {
+            break;
+        }
+        GattReplay::Notification n;
+        n.timestampUs = timestampUs;
+        n.connection = connection;
+        n.handle = qFromLittleEndian<quint16>(p + 1);
+        n.uuid = state.characteristics.value(key(connection, n.handle));
+        n.value = pdu.mid(3);
+        out.append(n);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void parseAcl(attstate &state, const QByteArray &packet, qint64 timestampUs,
+              QVector<GattReplay::Notification> &out) {
+    if (packet.length() < 4) {
+        return;
+    }
+    const uchar *p = reinterpret_cast<const uchar *>(packet.constData());
+    const quint16 header = qFromLittleEndian<quint16>(p);
+    const quint16 connection = header & 0x0FFF;
+    const quint8 boundary = (header >> 12) & 0x03;
+    const int length = qMin<int>(qFromLittleEndian<quint16>(p + 2), packet.length() - 4);
+    const QByteArray data = packet.mid(4, length);
+
+    QByteArray &frame = state.fragments[connection];
+    if (boundary == 0x01) {
+        // a continuation without its start is dropped
+        if (frame.isEmpty()) {
+            return;
+        }
+        frame.append(data);
+    } else {
+        frame = data;
+    }
+
+    if (frame.length() < 4) {
+        return;
+    }
+    const uchar *l2cap = reinterpret_cast<const uchar *>(frame.constData());
+    const int pduLength = qFromLittleEndian<quint16>(l2cap);
+    if (frame.length() < 4 + pduLength) {
+        return;
+    }
+    const quint16 channel = qFromLittleEndian<quint16>(l2cap + 2);
+    const QByteArray pdu = frame.mid(4, pduLength);
+    frame.clear();
+    if (channel == l2capAtt) {
+        parseAtt(state, connection, pdu, timestampUs, out);
+    }
+}
+
+void setError(QString *error, const QString &message) {
+    if (error) {
+        *error = message;
+    }
+}
+
+void processEventsFor(qint64 ns) {
+    QEventLoop loop;
+    // rounded up, the replay checks the clock again anyway
+    QTimer::singleShot(int((ns + 999999) / 1000000), &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+GattReplay::waiter currentWaiter = processEventsFor;
+} // namespace
+
+QVector<GattReplay::Notification> GattReplay::readBtsnoop(const QString &fileName, QString *error) {
+    QVector<Notification> out;
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        setError(error, file.errorString());
+        return out;
+    }
+    const QByteArray log = file.readAll();
+    const uchar *p = reinterpret_cast<const uchar *>(log.constData());
+    if (log.length() < btsnoopHeaderSize || !log.startsWith(QByteArray("btsnoop\0", 8))) {
+        setError(error, QStringLiteral("not a btsnoop log"));
+        return out;
+    }
+    const quint32 datalink = qFromBigEndian<quint32>(p + 12);
+    if (datalink != datalinkHci && datalink != datalinkH4) {
+        setError(error, QStringLiteral("unsupported datalink %1").arg(datalink));
+        return out;
+    }
+
+    attstate state;
+    qint64 start = -1;
+    for (int offset = btsnoopHeaderSize; offset + btsnoopRecordSize <= log.length();) {
+        const quint32 included = qFromBigEndian<quint32>(p + offset + 4);
+        const quint32 flags = qFromBigEndian<quint32>(p + offset + 8);
+        const qint64 timestamp = qFromBigEndian<qint64>(p + offset + 16);
+        offset += btsnoopRecordSize;
+        if (included > quint32(log.length() - offset)) {
+            // the last record of a capture still being written
+            break;
+        }
+        QByteArray packet = log.mid(offset, included);
+        offset += included;
+
+        if (start < 0) {
+            start = timestamp;
+        }
+        if (datalink == datalinkH4) {
+            if (packet.isEmpty() || quint8(packet.at(0)) != h4Acl) {
+                continue;
+            }
+            packet.remove(0, 1);
+        } else if (flags & 0x02) {
+            // a command or an event
+            continue;
+        }
+        parseAcl(state, packet, timestamp - start, out);
+    }
+    return out;
+}
+
+QVector<GattReplay::Notification> GattReplay::readDebugLog(const QString &fileName, QString *error) {
+    QVector<Notification> out;
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        setError(error, file.errorString());
+        return out;
+    }
+
+    // "<date> <msecs since epoch> Debug: <file> <function> <message>", see myMessageOutput
+    static const QRegularExpression timestampRe(
+        QStringLiteral("\\s(\\d{10,})\\s(?:Debug|Info|Warning|Critical|Fatal):"));
+    static const QRegularExpression uuidRe(
+        QStringLiteral("[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12}"));
+    static const QRegularExpression byteRe(QStringLiteral("^[0-9a-fA-F]{2}$"));
+    const QLatin1String marker(" << ");
+
+    QTextStream stream(&file);
+    QString line;
+    while (stream.readLineInto(&line)) {
+        const int at = line.indexOf(marker);
+        if (at < 0) {
+            continue;
+        }
+        QRegularExpressionMatch timestamp = timestampRe.match(line);
+        if (!timestamp.hasMatch() || timestamp.capturedStart() > at) {
+            continue;
+        }
+
+        QStringList tokens = line.mid(at + marker.size())
+                                 .remove(QLatin1Char('"'))
+                                 .split(QLatin1Char(' '), Qt::SkipEmptyParts);
+        // some drivers print the length before the bytes: it's one or two decimal digits matching the count
+        bool isNumber = false;
+        if (tokens.count() > 1 && tokens.first().toInt(&isNumber) == tokens.count() - 1 && isNumber) {
+            tokens.removeFirst();
+        }
+        QByteArray value;
+        for (const QString &token : qAsConst(tokens)) {
+            if (!byteRe.match(token).hasMatch()) {
+                value.clear();
+                break;
+            }
+            value.append(char(token.toUInt(nullptr, 16)));
+        }
+        if (value.isEmpty()) {
+            continue;
+        }
+
+        Notification n;
+        n.timestampUs = timestamp.captured(1).toLongLong() * 1000;
+        QRegularExpressionMatch uuid = uuidRe.match(line.left(at));
+        if (uuid.hasMatch()) {
+            n.uuid = QBluetoothUuid(uuid.captured(0));
+        }
+        n.value = value;
+        out.append(n);
+    }
+    return out;
+}
+
+QVector<GattReplay::Notification> GattReplay::read(const QString &fileName, QString *error) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        setError(error, file.errorString());
+        return QVector<Notification>();
+    }
+    const bool btsnoop = file.read(8) == QByteArray("btsnoop\0", 8);
+    file.close();
+    return btsnoop ? readBtsnoop(fileName, error) : readDebugLog(fileName, error);
+}
+
+QVector<GattReplay::Notification> GattReplay::filter(const QVector<Notification> &notifications,
+                                                     const QBluetoothUuid &uuid) {
+    QVector<Notification> out;
+    for (const Notification &n : notifications) {
+        if (n.uuid == uuid) {
+            out.append(n);
+        }
+    }
+    return out;
+}
+
+QVector<QBluetoothUuid> GattReplay::characteristics(const QVector<Notification> &notifications) {
+    QVector<QBluetoothUuid> out;
+    for (const Notification &n : notifications) {
+        if (!out.contains(n.uuid)) {
+            out.append(n.uuid);
+        }
+    }
+    return out;
+}
+
+void GattReplay::attach(bluetoothdevice *device, const QBluetoothDeviceInfo &info) {
+    QMetaObject::invokeMethod(device, "deviceDiscovered", Qt::DirectConnection,
+                              Q_ARG(QBluetoothDeviceInfo, info));
+}
+
+GattReplay::Result GattReplay::replay(bluetoothdevice *device, const QVector<Notification> &notifications,
+                                      double speedup) {
+    Result result;
+    if (notifications.isEmpty()) {
+        return result;
+    }
+
+    // a QLowEnergyCharacteristic with a uuid can only be obtained from a service: the characteristics of the log
+    // are added to a local one
+    QScopedPointer<QLowEnergyController> peripheral(QLowEnergyController::createPeripheral());
+    QHash<QBluetoothUuid, QLowEnergyCharacteristic> byUuid;
+    QLowEnergyServiceData serviceData;
+    serviceData.setType(QLowEnergyServiceData::ServiceTypePrimary);
+    serviceData.setUuid(QBluetoothUuid(QStringLiteral("{6e400001-b5a3-f393-e0a9-e50e24dcca9e}")));
+    for (const QBluetoothUuid &uuid : characteristics(notifications)) {
+        if (uuid.isNull()) {
+            continue;
+        }
+        QLowEnergyCharacteristicData data;
+        data.setUuid(uuid);
+        data.setProperties(QLowEnergyCharacteristic::Notify);
+        serviceData.addCharacteristic(data);
+    }
+    if (peripheral && !serviceData.characteristics().isEmpty()) {
+        QLowEnergyService *service = peripheral->addService(serviceData, peripheral.data());
+        if (service) {
+            for (const QLowEnergyCharacteristic &c : service->characteristics()) {
+                byUuid.insert(c.uuid(), c);
+            }
+        }
+    }
+
+    const qint64 start = monotonicclock::nsecs();
+    QElapsedTimer timer;
+    const qint64 first = notifications.first().timestampUs;
+    for (const Notification &n : notifications) {
+        if (speedup > 0) {
+            const qint64 due = start + qint64((n.timestampUs - first) * 1000 / speedup);
+            for (qint64 remaining = due - monotonicclock::nsecs(); remaining > 0;
+                 remaining = due - monotonicclock::nsecs()) {
+                currentWaiter(remaining);
+            }
+        }
+        const qint64 replayedNs = monotonicclock::nsecs() - start;
+
+        const QLowEnergyCharacteristic characteristic = byUuid.value(n.uuid);
+        timer.start();
+        if (!QMetaObject::invokeMethod(device, "characteristicChanged", Qt::DirectConnection,
+                                       Q_ARG(QLowEnergyCharacteristic, characteristic), Q_ARG(QByteArray, n.value))) {
+            qWarning() << "GattReplay: no characteristicChanged slot in" << device->metaObject()->className();
+            break;
+        }
+        const qint64 ns = timer.nsecsElapsed();
+
+        Sample s;
+        s.timestampUs = n.timestampUs;
+        s.uuid = n.uuid;
+        s.speed = device->currentSpeed().value();
+        s.cadence = device->currentCadence().value();
+        s.watts = device->wattsMetric().value();
+        s.heart = device->currentHeart().value();
+        s.inclination = device->currentInclination().value();
+        s.replayedNs = replayedNs;
+        s.processingNs = ns;
+        result.samples.append(s);
+        result.totalProcessingNs += ns;
+        result.maxProcessingNs = qMax(result.maxProcessingNs, ns);
+
+        QCoreApplication::processEvents();
+    }
+    result.elapsedMs = (monotonicclock::nsecs() - start) / 1000000;
+    return result;
+}
+
+void GattReplay::setWaiter(waiter w) { currentWaiter = w ? w : processEventsFor; }
@@ -0,0 +1,112 @@
+#ifndef GATTREPLAY_H
+#define GATTREPLAY_H
+
+#include <QBluetoothAddress>
+#include <QBluetoothDeviceInfo>
+#include <QBluetoothUuid>
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+class bluetoothdevice;
+
+/**
+ * @brief The GattReplay class reads the GATT notifications captured in a btsnoop log (the Android HCI snoop log, the
+ * format of the files in btlogs) or in a qz debug log, and feeds them to the characteristicChanged slot of a driver,
+ * recording the metrics of the driver after every notification and the time the driver took to process it.
+ *
+ * The characteristic of a btsnoop notification is resolved from the characteristic discovery captured in the same
+ * log, the one of a debug log line from the UUID the driver printed, if any. The drivers get a characteristic with
+ * that UUID, or an invalid one if the UUID isn't known.
+ */
+class GattReplay {
+  public:
+    typedef void (*waiter)(qint64 ns);
+
+    struct Notification {
+        // from the start of the capture for a btsnoop log, since the epoch for a debug log
+        qint64 timestampUs = 0;
+        // the ACL connection and the attribute handle, 0 for a debug log
+        quint16 connection = 0;
+        quint16 handle = 0;
+        // null if the characteristic discovery isn't in the log
+        QBluetoothUuid uuid;
+        QByteArray value;
+    };
+
+    struct Sample {
+        qint64 timestampUs = 0;
+        QBluetoothUuid uuid;
+        double speed = 0;
+        double cadence = 0;
+        double watts = 0;
+        double heart = 0;
+        double inclination = 0;
+        // when the notification was fed, from the start of the replay on the monotonic clock
+        qint64 replayedNs = 0;
+        // the time spent in characteristicChanged
+        qint64 processingNs = 0;
+    };
+
+    struct Result {
+        QVector<Sample> samples;
+        qint64 totalProcessingNs = 0;
+        qint64 maxProcessingNs = 0;
+        // the monotonic time of the whole replay, waits included
+        qint64 elapsedMs = 0;
+
+        double nsPerNotification() const {
+            return samples.isEmpty() ? 0.0 : (double)totalProcessingNs / samples.count();
+        }
+    };
+
+    /**
+     * @brief Reads the notifications and the indications of a btsnoop log, H4 (1002) or HCI (1001) datalink.
+     * @param error Set to the reason, if the file can't be read or isn't a btsnoop log.
+     */
+    static QVector<Notification> readBtsnoop(const QString &fileName, QString *error = nullptr);
+
+    /**
+     * @brief Reads the " << " lines of a qz debug log, the hex dump of the values received by the drivers.
+     */
+    static QVector<Notification> readDebugLog(const QString &fileName, QString *error = nullptr);
+
+    /**
+     * @brief Reads a btsnoop or a debug log, according to the content of the file.
+     */
+    static QVector<Notification> read(const QString &fileName, QString *error = nullptr);
+
+    /**
+     * @brief The notifications of one characteristic.
+     */
+    static QVector<Notification> filter(const QVector<Notification> &notifications, const QBluetoothUuid &uuid);
+
+    /**
+     * @brief The characteristics of the notifications, in the order of their first notification.
+     */
+    static QVector<QBluetoothUuid> characteristics(const QVector<Notification> &notifications);
+
+    /**
+     * @brief Calls the deviceDiscovered slot of the driver, which creates the controller the driver expects to
+     * exist when a notification arrives. The connection fails, there's no device, but the driver stays usable.
+     */
+    static void attach(bluetoothdevice *device,
+                       const QBluetoothDeviceInfo &info = QBluetoothDeviceInfo(QBluetoothAddress(), QString(), 0));
+
+    /**
+     * @brief Feeds the notifications to the driver.
+     * @param speedup 1 for the timing of the capture, 2 for twice as fast and so on, 0 to feed the notifications as
+     * fast as the driver takes them. The notifications are timed on the monotonic clock. The events of the driver
+     * are processed while waiting and after every notification.
+     */
+    static Result replay(bluetoothdevice *device, const QVector<Notification> &notifications, double speedup = 0);
+
+    /**
+     * @brief Replaces the wait of a timed replay until the next notification is due, nullptr restores the default
+     * one, which processes the events until the monotonic clock gets there. Tests pair it with
+     * monotonicclock::setSource() to replay without waiting.
+     */
+    static void setWaiter(waiter w);
+};
+
+#endif // GATTREPLAY_H
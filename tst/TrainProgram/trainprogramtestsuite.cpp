@@ -0,0 +1,310 @@
+#include "trainprogramtestsuite.h"
+
+#include "Tools/testsettings.h"
+#include "gpx.h"
+#include "qzsettings.h"
+#include "trainprogram.h"
+
+#include <QElapsedTimer>
+
+namespace {
+uint32_t seconds(const QTime &t) { return t.second() + (t.minute() * 60) + (t.hour() * 3600); }
+
+uint32_t timeForRow(const trainrow &row) {
+    // a distance row has a time once the scheduler has run it, these programs are never run
+    if (row.distance == -1)
+        return seconds(row.duration);
+    return 0;
+}
+
+// the lookups as they were, walking the rows from the first one
+QTime walkCurrentRowElapsedTime(const QVector<trainrow> &rows, int ticks) {
+    uint32_t calculatedElapsedTime = 0;
+    for (int i = 0; i < rows.length(); i++) {
+        uint32_t currentLine = timeForRow(rows.at(i));
+        calculatedElapsedTime += currentLine;
+        if (calculatedElapsedTime > static_cast<uint32_t>(ticks)) {
+            uint32_t rampElapsed = seconds(rows.at(i).rampElapsed);
+            return QTime(0, 0, 0).addSecs(rampElapsed + ticks - (calculatedElapsedTime - currentLine));
+        }
+    }
+    return QTime(0, 0, 0);
+}
+
+QTime walkCurrentRowRemainingTime(const QVector<trainrow> &rows, int ticks) {
+    uint32_t calculatedElapsedTime = 0;
+    for (int i = 0; i < rows.length(); i++) {
+        calculatedElapsedTime += timeForRow(rows.at(i));
+        if (calculatedElapsedTime > static_cast<uint32_t>(ticks)) {
+            if (rows.at(i).rampDuration != QTime(0, 0, 0)) {
+                calculatedElapsedTime += seconds(rows.at(i).rampDuration) - 1;
+            }
+            int s = calculatedElapsedTime - ticks;
+            int hours = s / 3600;
+            return QTime(hours, (s / 60) - (hours * 60), s % 60);
+        }
+    }
+    return QTime(0, 0, 0);
+}
+
+QTime walkRemainingTime(const QVector<trainrow> &rows, int ticks) {
+    uint32_t total = 0;
+    for (const trainrow &row : rows) {
+        total += timeForRow(row);
+    }
+    return QTime(0, 0, 0).addSecs(total - ticks);
+}
+
+double walkTotalDistance(const QVector<trainrow> &rows) {
+    double distance = 0;
+    for (const trainrow &row : rows) {
+        if (seconds(row.duration)) {
+            if (!row.forcespeed)
+                return -1;
+            distance += seconds(row.duration) * (row.speed / 3600);
+        }
+    }
+    return distance;
+}
+
+// avgInclinationNext100Meters and the next 300 meters lists as they were, walking the rows ahead on every call
+double walkAvgInclinationNext100Meters(const QVector<trainrow> &rows, int currentStep, double currentStepDistance,
+                                       int step) {
+    double km = 0;
+    double avg = 0;
+    int sum = 0;
+    for (int c = step; c < rows.length() && km <= 0.1; c++) {
+        if (c == currentStep)
+            km += (rows.at(c).distance - currentStepDistance);
+        else
+            km += (rows.at(c).distance);
+        avg += rows.at(c).inclination * rows.at(c).distance;
+        sum++;
+    }
+    if (sum == 1) {
+        return rows.at(currentStep).inclination;
+    }
+    return avg / (double)km;
+}
+
+QList<MetersByInclination> walkNext300Meters(const QVector<trainrow> &rows, int currentStep,
+                                             double currentStepDistance, bool average) {
+    double km = 0;
+    QList<MetersByInclination> next300;
+    for (int c = currentStep; c < rows.length() && km <= 0.3; c++) {
+        MetersByInclination p;
+        if (c == currentStep) {
+            p.meters = (rows.at(c).distance - currentStepDistance) * 1000.0;
+            km += (rows.at(c).distance - currentStepDistance);
+        } else {
+            p.meters = (rows.at(c).distance) * 1000.0;
+            km += (rows.at(c).distance);
+        }
+        p.inclination = average ? walkAvgInclinationNext100Meters(rows, currentStep, currentStepDistance, c)
+                                : rows.at(c).inclination;
+        next300.append(p);
+    }
+    return next300;
+}
+
+void expectSameSections(const QList<MetersByInclination> &actual, const QList<MetersByInclination> &expected,
+                        int step) {
+    ASSERT_EQ(actual.count(), expected.count()) << step;
+    for (int i = 0; i < expected.count(); i++) {
+        // the same sums in the same order: the values are the same, not just close
+        EXPECT_EQ(actual.at(i).meters, expected.at(i).meters) << step << " " << i;
+        EXPECT_EQ(actual.at(i).inclination, expected.at(i).inclination) << step << " " << i;
+    }
+}
+
+// an ERG program split in 1 second ramp segments, with some longer steady rows
+QList<trainrow> timeRows(int count) {
+    QList<trainrow> rows;
+    for (int i = 0; i < count; i++) {
+        trainrow row;
+        row.duration = QTime(0, 0, 0).addSecs(i % 10 == 0 ? 120 : 1);
+        row.forcespeed = true;
+        row.speed = 8 + i % 5;
+        if (i % 10 != 0) {
+            row.rampElapsed = QTime(0, 0, 0).addSecs(i % 10);
+            row.rampDuration = QTime(0, 0, 0).addSecs(10 - i % 10);
+        }
+        rows.append(row);
+    }
+    return rows;
+}
+
+// what a GPX file becomes: distance rows with the gpx timestamps
+QList<trainrow> gpxRows(int count) {
+    QList<trainrow> rows;
+    for (int i = 0; i < count; i++) {
+        trainrow row;
+        row.distance = 0.01;
+        row.inclination = (i % 60) / 10.0;
+        row.latitude = 45.0 + i * 0.0001;
+        row.longitude = 9.0;
+        row.altitude = 100 + i % 200;
+        row.gpxElapsed = QTime(0, 0, 0).addSecs(i * 2);
+        rows.append(row);
+    }
+    return rows;
+}
+} // namespace
+
+TrainProgramTestSuite::TrainProgramTestSuite() {}
+
+void TrainProgramTestSuite::test_rowLookups() {
+    trainprogram program(timeRows(2000), nullptr);
+
+    EXPECT_EQ(program.duration(), QTime(0, 0, 0).addSecs(200 * 120 + 1800));
+    EXPECT_DOUBLE_EQ(program.totalDistance(), walkTotalDistance(program.rows));
+
+    int ticks = 0;
+    for (int step : {0, 1, 7, 119, 120, 121, 500, 3000, 25799, 25800, 26000}) {
+        program.increaseElapsedTime(step - ticks);
+        ticks = step;
+        EXPECT_EQ(program.currentRowElapsedTime(), walkCurrentRowElapsedTime(program.rows, ticks)) << ticks;
+        EXPECT_EQ(program.currentRowRemainingTime(), walkCurrentRowRemainingTime(program.rows, ticks)) << ticks;
+        EXPECT_EQ(program.remainingTime(), walkRemainingTime(program.rows, ticks)) << ticks;
+    }
+
+    // an edited program is indexed again
+    program.rows[5].duration = QTime(0, 10, 0);
+    program.rows[6].forcespeed = false;
+    program.invalidateRowIndex();
+    EXPECT_EQ(program.duration(), QTime(0, 0, 0).addSecs(200 * 120 + 1799 + 600));
+    EXPECT_DOUBLE_EQ(program.totalDistance(), -1);
+    EXPECT_EQ(program.currentRowElapsedTime(), walkCurrentRowElapsedTime(program.rows, ticks));
+    EXPECT_EQ(program.remainingTime(), walkRemainingTime(program.rows, ticks));
+}
+
+void TrainProgramTestSuite::test_rowsShareStorage() {
+    trainprogram program(gpxRows(1000), nullptr);
+    program.restart();
+    program.increaseElapsedTime(600);
+
+    // reading the rows doesn't copy them
+    EXPECT_EQ(program.currentRowElapsedTime(), walkCurrentRowElapsedTime(program.rows, 600));
+    EXPECT_EQ(program.remainingTime(), walkRemainingTime(program.rows, 600));
+    EXPECT_EQ(&program.getRowFromCurrent(1), &program.rows.at(1));
+    EXPECT_EQ(program.rows.constData(), program.loadedRows.constData());
+
+    // the first edit does, and the loaded rows are left as they were
+    program.rows[3].inclination = 5;
+    program.invalidateRowIndex();
+    EXPECT_NE(program.rows.constData(), program.loadedRows.constData());
+    EXPECT_EQ(program.rows.at(3).inclination, 5);
+    EXPECT_EQ(program.loadedRows.at(3).inclination, gpxRows(4).at(3).inclination);
+}
+
+void TrainProgramTestSuite::test_inclinationLookAhead() {
+    // rows from 4 to 94 meters, so the 100 and 300 meters windows cover a different number of rows
+    QList<trainrow> rows = gpxRows(400);
+    for (int i = 0; i < rows.count(); i++) {
+        rows[i].distance = 0.004 + (i % 7) * 0.015;
+    }
+    trainprogram program(rows, nullptr);
+
+    auto check = [&program](int step, double fraction) {
+        program.currentStep = step;
+        program.currentStepDistance = program.rows.at(step).distance * fraction;
+        expectSameSections(program.inclinationNext300Meters(),
+                           walkNext300Meters(program.rows, step, program.currentStepDistance, false), step);
+        expectSameSections(program.avgInclinationNext300Meters(),
+                           walkNext300Meters(program.rows, step, program.currentStepDistance, true), step);
+    };
+
+    // forward as a ride goes, then back to rows whose windows were computed from another position
+    for (int step : {0, 1, 2, 6, 7, 50, 51, 52, 200, 390, 396, 398, 399, 100, 3}) {
+        for (double fraction : {0.0, 0.4, 0.95}) {
+            check(step, fraction);
+        }
+    }
+
+    // the windows of the edited rows are computed again
+    program.rows[60].inclination = 12;
+    program.rows[61].distance = 0.2;
+    program.rows[62].inclination = -4;
+    program.invalidateRowIndex();
+    for (int step : {50, 55, 59, 60, 61, 62}) {
+        check(step, 0.5);
+    }
+}
+
+void TrainProgramTestSuite::test_realGpxMemory() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    testSettings.activate();
+    testSettings.qsettings.setValue(QZSettings::gpx_loop, false);
+
+    gpx g;
+    QList<gpx_altitude_point_for_treadmill> points =
+        g.open(QStringLiteral(GPX_DIR "/Box Hill.gpx"), bluetoothdevice::BIKE);
+    ASSERT_GT(points.count(), 1000);
+
+    // the rows homeform::gpx_open_clicked makes of the points
+    QList<trainrow> list;
+    list.reserve(points.count());
+    for (int i = 1; i < points.count(); i++) {
+        const gpx_altitude_point_for_treadmill &last = points.at(i - 1);
+        trainrow r;
+        r.azimuth = QGeoCoordinate(last.latitude, last.longitude)
+                        .azimuthTo(QGeoCoordinate(points.at(i).latitude, points.at(i).longitude));
+        r.distance = points.at(i).distance;
+        r.altitude = last.elevation;
+        r.inclination = points.at(i).inclination;
+        r.latitude = last.latitude;
+        r.longitude = last.longitude;
+        r.gpxElapsed = QTime(0, 0, 0).addSecs(points.at(i).seconds);
+        list.append(r);
+    }
+
+    trainprogram program(list, nullptr);
+    program.restart();
+    program.increaseElapsedTime(600);
+    EXPECT_EQ(program.currentRowElapsedTime(), walkCurrentRowElapsedTime(program.rows, 600));
+
+    // one copy of the rows for the whole ride
+    EXPECT_EQ(program.rows.constData(), program.loadedRows.constData());
+    EXPECT_LE(sizeof(trainrow), size_t(184));
+
+    RecordProperty("rows", program.rows.count());
+    RecordProperty("rowsBytes", static_cast<int>(program.rows.count() * sizeof(trainrow)));
+    RecordProperty("positionBytes", static_cast<int>(program.rows.count() * 4 * sizeof(double)));
+
+    testSettings.qsettings.remove(QZSettings::gpx_loop);
+}
+
+void TrainProgramTestSuite::test_benchmarkLargeProgram() {
+    const int lookups = 1000;
+    trainprogram program(gpxRows(50000), nullptr);
+    program.increaseElapsedTime(1800);
+
+    QElapsedTimer timer;
+    double walkSum = 0;
+    double indexSum = 0;
+
+    timer.start();
+    for (int i = 0; i < lookups; i++) {
+        walkSum += walkCurrentRowElapsedTime(program.rows, 1800).second();
+        walkSum += walkCurrentRowRemainingTime(program.rows, 1800).second();
+        walkSum += walkRemainingTime(program.rows, 1800).second();
+        walkSum += walkTotalDistance(program.rows);
+    }
+    qint64 walkNs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int i = 0; i < lookups; i++) {
+        indexSum += program.currentRowElapsedTime().second();
+        indexSum += program.currentRowRemainingTime().second();
+        indexSum += program.remainingTime().second();
+        indexSum += program.totalDistance();
+    }
+    qint64 indexNs = timer.nsecsElapsed();
+
+    RecordProperty("walkNsPerTick", static_cast<int>(walkNs / lookups));
+    RecordProperty("indexNsPerTick", static_cast<int>(indexNs / lookups));
+
+    EXPECT_DOUBLE_EQ(indexSum, walkSum);
+    EXPECT_EQ(program.currentRowElapsedTime(), walkCurrentRowElapsedTime(program.rows, 1800));
+    EXPECT_EQ(program.remainingTime(), walkRemainingTime(program.rows, 1800));
+}
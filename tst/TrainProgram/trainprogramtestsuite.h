@@ -0,0 +1,51 @@
+#ifndef TRAINPROGRAMTESTSUITE_H
+#define TRAINPROGRAMTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class TrainProgramTestSuite : public testing::Test {
+
+  public:
+    TrainProgramTestSuite();
+
+    /**
+     * @brief Test the row lookups against a walk of the rows from the first one, as the elapsed time goes on and
+     * after the rows are edited.
+     */
+    void test_rowLookups();
+
+    /**
+     * @brief Test that the rows share the storage of the loaded rows until they are edited.
+     */
+    void test_rowsShareStorage();
+
+    /**
+     * @brief Test the inclinations of the next 300 meters, raw and averaged on 100 meters, against the walk of the
+     * rows, at several positions in a program with rows of different lengths and after the rows are edited.
+     */
+    void test_inclinationLookAhead();
+
+    /**
+     * @brief Test that the rows of a real GPX route (Box Hill, shipped with the app) are kept once, and record their
+     * memory as test properties.
+     */
+    void test_realGpxMemory();
+
+    /**
+     * @brief Time the per-tick lookups on a 50k rows GPX program against the walk of the rows.
+     * Disabled by default, run it with --gtest_also_run_disabled_tests: the timings are recorded as test properties.
+     */
+    void test_benchmarkLargeProgram();
+};
+
+TEST_F(TrainProgramTestSuite, TestRowLookups) { this->test_rowLookups(); }
+
+TEST_F(TrainProgramTestSuite, TestRowsShareStorage) { this->test_rowsShareStorage(); }
+
+TEST_F(TrainProgramTestSuite, TestInclinationLookAhead) { this->test_inclinationLookAhead(); }
+
+TEST_F(TrainProgramTestSuite, TestRealGpxMemory) { this->test_realGpxMemory(); }
+
+TEST_F(TrainProgramTestSuite, DISABLED_BenchmarkLargeProgram) { this->test_benchmarkLargeProgram(); }
+
+#endif // TRAINPROGRAMTESTSUITE_H
@@ -0,0 +1,269 @@
+#include "virtualnotifyschedulertestsuite.h"
+
+#include "Tools/gattreplay.h"
+#include "Tools/testsettings.h"
+#include "devices/domyostreadmill/domyostreadmill.h"
+#include "latencyhistogram.h"
+#include "monotonicclock.h"
+#include "qzsettings.h"
+#include "virtualdevices/virtualnotifyscheduler.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+#include <functional>
+
+using namespace std::chrono_literals;
+
+namespace {
+void processEvents(int ms) {
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < ms) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        QThread::msleep(1);
+    }
+}
+
+bool waitFor(const std::function<bool()> &done, int ms) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!done()) {
+        if (timer.elapsed() > ms) {
+            return false;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        QThread::msleep(1);
+    }
+    return true;
+}
+
+qint64 fakeNow = 0;
+qint64 fakeClock() { return fakeNow; }
+
+void setupDomyos(TestSettings &testSettings) {
+    testSettings.activate();
+    testSettings.qsettings.clear();
+    testSettings.qsettings.setValue(QZSettings::heart_rate_belt_name, QStringLiteral("Disabled"));
+}
+} // namespace
+
+VirtualNotifySchedulerTestSuite::VirtualNotifySchedulerTestSuite() {}
+
+void VirtualNotifySchedulerTestSuite::test_latencyHistogram() {
+    latencyhistogram histogram;
+    EXPECT_EQ(histogram.percentileNs(0.5), 0);
+
+    histogram.add(100000);
+    histogram.add(300000);
+    histogram.add(1000000);
+    histogram.add(10000000000LL);
+    EXPECT_EQ(histogram.count(), 4u);
+    EXPECT_EQ(histogram.bucketCount(0), 1u);
+    EXPECT_EQ(histogram.bucketCount(1), 1u);
+    EXPECT_EQ(histogram.bucketCount(2), 0u);
+    EXPECT_EQ(histogram.bucketCount(3), 1u);
+    EXPECT_EQ(histogram.bucketCount(latencyhistogram::Buckets - 1), 1u);
+    EXPECT_EQ(histogram.bucketUpperNs(3), 2000000);
+
+    EXPECT_EQ(histogram.percentileNs(0.5), 500000);
+    EXPECT_EQ(histogram.percentileNs(0.75), 2000000);
+    EXPECT_EQ(histogram.percentileNs(1.0), 10000000000LL);
+    EXPECT_EQ(histogram.maxNs(), 10000000000LL);
+    EXPECT_DOUBLE_EQ(histogram.meanNs(), (100000 + 300000 + 1000000 + 10000000000.0) / 4);
+    EXPECT_TRUE(histogram.toString().startsWith(QStringLiteral("n=4 "))) << histogram.toString().toStdString();
+
+    histogram.clear();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.maxNs(), 0);
+}
+
+void VirtualNotifySchedulerTestSuite::test_timerMode() {
+    virtualnotifyscheduler scheduler;
+    int runs = 0;
+    QObject::connect(&scheduler, &virtualnotifyscheduler::provide, [&runs] { runs++; });
+    scheduler.start(nullptr, 20ms, false, 10ms);
+    EXPECT_FALSE(scheduler.eventDriven());
+
+    scheduler.sourceUpdated();
+    EXPECT_EQ(runs, 0);
+    const QBluetoothUuid uuid((quint16)0x2AD2);
+    EXPECT_TRUE(scheduler.changed(uuid, QByteArray("a")));
+    EXPECT_TRUE(scheduler.changed(uuid, QByteArray("a")));
+
+    processEvents(210);
+    EXPECT_GE(runs, 7);
+    EXPECT_LE(runs, 12);
+    // the update is notified on the next tick
+    EXPECT_EQ(scheduler.latency().count(), 1u);
+    EXPECT_LE(scheduler.latency().maxNs(), 100000000);
+}
+
+void VirtualNotifySchedulerTestSuite::test_eventDriven() {
+    virtualnotifyscheduler scheduler;
+    int runs = 0;
+    QObject::connect(&scheduler, &virtualnotifyscheduler::provide, [&runs] { runs++; });
+    scheduler.start(nullptr, 1000ms, true, 50ms);
+    EXPECT_TRUE(scheduler.eventDriven());
+
+    scheduler.sourceUpdated();
+    EXPECT_EQ(runs, 1);
+    EXPECT_EQ(scheduler.latency().count(), 1u);
+
+    // too early: the three updates are notified together at the end of the interval
+    scheduler.sourceUpdated();
+    scheduler.sourceUpdated();
+    scheduler.sourceUpdated();
+    EXPECT_EQ(runs, 1);
+    processEvents(100);
+    EXPECT_EQ(runs, 2);
+    EXPECT_EQ(scheduler.latency().count(), 2u);
+    EXPECT_GE(scheduler.latency().maxNs(), 40000000);
+
+    // idle, only the keepalive
+    processEvents(1100);
+    EXPECT_EQ(runs, 3);
+    EXPECT_EQ(scheduler.latency().count(), 2u);
+}
+
+void VirtualNotifySchedulerTestSuite::test_changed() {
+    fakeNow = 1000000000LL;
+    monotonicclock::setSource(fakeClock);
+
+    virtualnotifyscheduler scheduler;
+    scheduler.start(nullptr, 1000ms, true, 50ms);
+    const QBluetoothUuid bike((quint16)0x2AD2);
+    const QBluetoothUuid heart((quint16)0x2A37);
+
+    EXPECT_TRUE(scheduler.changed(bike, QByteArray("a")));
+    EXPECT_FALSE(scheduler.changed(bike, QByteArray("a")));
+    EXPECT_TRUE(scheduler.changed(bike, QByteArray("b")));
+    EXPECT_TRUE(scheduler.changed(heart, QByteArray("b")));
+
+    fakeNow += 400000000LL;
+    EXPECT_FALSE(scheduler.changed(bike, QByteArray("b")));
+    fakeNow += 100000000LL;
+    EXPECT_TRUE(scheduler.changed(bike, QByteArray("b")));
+    EXPECT_FALSE(scheduler.changed(bike, QByteArray("b")));
+
+    monotonicclock::setSource(nullptr);
+}
+
+void VirtualNotifySchedulerTestSuite::test_latencyBuckets() {
+    fakeNow = 1000000000LL;
+    monotonicclock::setSource(fakeClock);
+
+    {
+        virtualnotifyscheduler scheduler;
+        int runs = 0;
+        QObject::connect(&scheduler, &virtualnotifyscheduler::provide, [&runs] { runs++; });
+        scheduler.start(nullptr, 20ms, false, 10ms);
+
+        // the tick after the update is 3 ms later on the fake clock, whenever the timer fires
+        scheduler.sourceUpdated();
+        fakeNow += 3000000LL;
+        ASSERT_TRUE(waitFor([&runs] { return runs > 0; }, 5000));
+        const latencyhistogram &latency = scheduler.latency();
+        EXPECT_EQ(latency.count(), 1u);
+        // 2 ms <= 3 ms < 4 ms
+        EXPECT_EQ(latency.bucketCount(4), 1u);
+        EXPECT_EQ(latency.maxNs(), 3000000);
+    }
+
+    {
+        virtualnotifyscheduler scheduler;
+        int runs = 0;
+        QObject::connect(&scheduler, &virtualnotifyscheduler::provide, [&runs] { runs++; });
+        scheduler.start(nullptr, 1000ms, true, 50ms);
+
+        // notified at once
+        scheduler.sourceUpdated();
+        EXPECT_EQ(runs, 1);
+
+        // 10 and 20 ms later: both are notified at the end of the 50 ms interval, 40 ms after the first one
+        fakeNow += 10000000LL;
+        scheduler.sourceUpdated();
+        fakeNow += 10000000LL;
+        scheduler.sourceUpdated();
+        fakeNow += 30000000LL;
+        ASSERT_TRUE(waitFor([&runs] { return runs == 2; }, 5000));
+        const latencyhistogram &latency = scheduler.latency();
+        EXPECT_EQ(latency.count(), 2u);
+        EXPECT_EQ(latency.bucketCount(0), 1u);
+        // 32 ms <= 40 ms < 64 ms
+        EXPECT_EQ(latency.bucketCount(8), 1u);
+        EXPECT_EQ(latency.maxNs(), 40000000);
+        EXPECT_DOUBLE_EQ(latency.meanNs(), 20000000.0);
+    }
+
+    monotonicclock::setSource(nullptr);
+}
+
+void VirtualNotifySchedulerTestSuite::test_sourceDevice() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    setupDomyos(testSettings);
+
+    QVector<GattReplay::Notification> notifications =
+        GattReplay::read(QStringLiteral(BTLOGS_DIR "/heart200andstop.log"));
+    ASSERT_FALSE(notifications.isEmpty());
+
+    domyostreadmill device(200, true, true);
+    GattReplay::attach(&device);
+    virtualnotifyscheduler scheduler;
+    int runs = 0;
+    double lastSpeed = -1;
+    QObject::connect(&scheduler, &virtualnotifyscheduler::provide, [&] {
+        runs++;
+        lastSpeed = device.currentSpeed().value();
+    });
+    // the keepalive doesn't fire during the replay
+    scheduler.start(&device, 10000ms, true, 0ms);
+    GattReplay::replay(&device, notifications);
+
+    // once for every complete frame of the treadmill (669 status frames), with the metrics of the frame
+    EXPECT_GE(runs, 669);
+    EXPECT_LT(runs, notifications.count());
+    EXPECT_EQ(scheduler.latency().count(), quint64(runs));
+    EXPECT_DOUBLE_EQ(lastSpeed, device.currentSpeed().value());
+}
+
+void VirtualNotifySchedulerTestSuite::test_benchmarkLatency() {
+    TestSettings testSettings("Roberto Viola", "QDomyos-Zwift Testing");
+    setupDomyos(testSettings);
+
+    // the first 3 seconds of the capture, in real time
+    QVector<GattReplay::Notification> notifications;
+    for (const GattReplay::Notification &n : GattReplay::read(QStringLiteral(BTLOGS_DIR "/btsnoop_hci.log"))) {
+        if (!notifications.isEmpty() && n.timestampUs - notifications.first().timestampUs > 3000000) {
+            break;
+        }
+        notifications.append(n);
+    }
+    ASSERT_GT(notifications.count(), 2);
+
+    auto run = [&notifications](bool eventDriven, int &runs) {
+        domyostreadmill device(200, true, true);
+        GattReplay::attach(&device);
+        virtualnotifyscheduler scheduler;
+        QObject::connect(&scheduler, &virtualnotifyscheduler::provide, [&runs] { runs++; });
+        // race mode
+        scheduler.start(&device, 100ms, eventDriven, 100ms);
+        GattReplay::replay(&device, notifications, 1);
+        return scheduler.latency();
+    };
+
+    int timerRuns = 0;
+    int eventRuns = 0;
+    const latencyhistogram timer = run(false, timerRuns);
+    const latencyhistogram event = run(true, eventRuns);
+
+    EXPECT_GT(timer.count(), 0u);
+    EXPECT_GT(event.count(), 0u);
+
+    RecordProperty("timerRuns", timerRuns);
+    RecordProperty("timerMeanNs", static_cast<int>(timer.meanNs()));
+    RecordProperty("timerP90Ns", static_cast<int>(timer.percentileNs(0.9)));
+    RecordProperty("eventRuns", eventRuns);
+    RecordProperty("eventMeanNs", static_cast<int>(event.meanNs()));
+    RecordProperty("eventP90Ns", static_cast<int>(event.percentileNs(0.9)));
+}
@@ -0,0 +1,66 @@
+#ifndef VIRTUALNOTIFYSCHEDULERTESTSUITE_H
+#define VIRTUALNOTIFYSCHEDULERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class VirtualNotifySchedulerTestSuite : public testing::Test {
+
+  public:
+    VirtualNotifySchedulerTestSuite();
+
+    /**
+     * @brief Test the buckets, the percentiles and the summary of the latency histogram.
+     */
+    void test_latencyHistogram();
+
+    /**
+     * @brief Test that the timer mode runs every period and ignores the updates of the source, except for the latency.
+     */
+    void test_timerMode();
+
+    /**
+     * @brief Test that the event-driven mode runs on the updates of the source, coalescing the ones arriving before the
+     * minimum interval, and on the keepalive.
+     */
+    void test_eventDriven();
+
+    /**
+     * @brief Test that the unchanged values are skipped until half the keepalive in the event-driven mode.
+     */
+    void test_changed();
+
+    /**
+     * @brief Test the buckets of the latency recorded by the scheduler on a fake monotonic clock, for an update
+     * notified by the next tick of the timer mode and for updates coalesced to the end of the minimum interval of the
+     * event-driven mode.
+     */
+    void test_latencyBuckets();
+
+    /**
+     * @brief Test that a driver publishing its metrics drives the scheduler, replaying a captured session.
+     */
+    void test_sourceDevice();
+
+    /**
+     * @brief Compare the latency from the notifications of a replayed treadmill to the virtual device in the timer and
+     * in the event-driven modes.
+     * Disabled by default, run it with --gtest_also_run_disabled_tests: the latencies are recorded as test properties.
+     */
+    void test_benchmarkLatency();
+};
+
+TEST_F(VirtualNotifySchedulerTestSuite, TestLatencyHistogram) { this->test_latencyHistogram(); }
+
+TEST_F(VirtualNotifySchedulerTestSuite, TestTimerMode) { this->test_timerMode(); }
+
+TEST_F(VirtualNotifySchedulerTestSuite, TestEventDriven) { this->test_eventDriven(); }
+
+TEST_F(VirtualNotifySchedulerTestSuite, TestChanged) { this->test_changed(); }
+
+TEST_F(VirtualNotifySchedulerTestSuite, TestLatencyBuckets) { this->test_latencyBuckets(); }
+
+TEST_F(VirtualNotifySchedulerTestSuite, TestSourceDevice) { this->test_sourceDevice(); }
+
+TEST_F(VirtualNotifySchedulerTestSuite, DISABLED_BenchmarkLatency) { this->test_benchmarkLatency(); }
+
+#endif // VIRTUALNOTIFYSCHEDULERTESTSUITE_H
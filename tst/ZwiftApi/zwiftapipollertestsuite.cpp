@@ -0,0 +1,129 @@
+#include "zwiftapipollertestsuite.h"
+
+#include "zwift-api/zwift_api_poller.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QNetworkProxy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+#include <functional>
+
+namespace {
+const int playerId = 1234;
+
+// PlayerState { id: 1234, distance: 5000, altitude: 101.5 }
+const QByteArray playerState = QByteArray::fromHex("08d209188827d5010000cb42");
+
+// serves the canned Zwift API replies after latencyMs
+class zwiftapistub {
+  public:
+    explicit zwiftapistub(int latencyMs) : latencyMs(latencyMs) {
+        server.listen(QHostAddress::LocalHost, 0);
+        QObject::connect(&server, &QTcpServer::newConnection, [this]() {
+            while (QTcpSocket *socket = server.nextPendingConnection()) {
+                QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+                QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket]() { reply(socket); });
+            }
+        });
+    }
+
+    QString baseUrl() const { return QStringLiteral("http://127.0.0.1:%1").arg(server.serverPort()); }
+
+    QStringList requests;
+    int latencyMs;
+
+  private:
+    void reply(QTcpSocket *socket) {
+        if (!socket->peek(socket->bytesAvailable()).contains("\r\n\r\n")) {
+            return;
+        }
+        QString path = QString::fromLatin1(socket->readAll().split(' ').value(1));
+        requests.append(path);
+
+        QByteArray body;
+        QByteArray type;
+        if (path == QStringLiteral("/api/profiles/me")) {
+            body = QByteArray("{\"id\":") + QByteArray::number(playerId) + "}";
+            type = "application/json";
+        } else if (path == QStringLiteral("/relay/worlds/1/players/%1").arg(playerId)) {
+            body = playerState;
+            type = "application/x-protobuf-lite";
+        }
+        QByteArray response = (body.isEmpty() ? QByteArray("HTTP/1.1 404 Not Found\r\n")
+                                              : QByteArray("HTTP/1.1 200 OK\r\n")) +
+                              "Content-Type: " + type + "\r\nContent-Length: " + QByteArray::number(body.size()) +
+                              "\r\nConnection: close\r\n\r\n" + body;
+        QTimer::singleShot(latencyMs, socket, [socket, response]() {
+            socket->write(response);
+            socket->disconnectFromHost();
+        });
+    }
+
+    QTcpServer server;
+};
+
+bool waitFor(const std::function<bool()> &done, int timeoutMs) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!done() && timer.elapsed() < timeoutMs) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        QThread::msleep(1);
+    }
+    return done();
+}
+} // namespace
+
+ZwiftApiPollerTestSuite::ZwiftApiPollerTestSuite() {
+    QNetworkProxy::setApplicationProxy(QNetworkProxy::NoProxy);
+}
+
+void ZwiftApiPollerTestSuite::test_pollDoesNotBlock() {
+    const int latencyMs = 500;
+    zwiftapistub stub(latencyMs);
+    ZwiftApiPoller poller(1, QStringLiteral("token"), stub.baseUrl());
+    int loggedIn = -1;
+    QObject::connect(&poller, &ZwiftApiPoller::loggedIn, [&loggedIn](int id) { loggedIn = id; });
+
+    // the reply can only arrive through the event loop: a poll() waiting for it would return with the request done
+    EXPECT_TRUE(poller.poll());
+    EXPECT_TRUE(poller.isPolling());
+    EXPECT_FALSE(poller.poll());
+    EXPECT_TRUE(poller.isPolling());
+    EXPECT_EQ(poller.coalescedPolls(), 1);
+    EXPECT_EQ(poller.playerId(), -1);
+
+    ASSERT_TRUE(waitFor([&poller]() { return !poller.isPolling(); }, 5000));
+    EXPECT_EQ(poller.playerId(), playerId);
+    EXPECT_EQ(loggedIn, playerId);
+
+    QByteArray state;
+    EXPECT_TRUE(poller.poll());
+    EXPECT_TRUE(poller.isPolling());
+    EXPECT_FALSE(poller.takePlayerState(&state));
+
+    ASSERT_TRUE(waitFor([&poller]() { return !poller.isPolling(); }, 5000));
+    EXPECT_TRUE(poller.takePlayerState(&state));
+    EXPECT_EQ(state, playerState);
+    EXPECT_FALSE(poller.takePlayerState(&state));
+
+    // one request for the profile and one for the state: the coalesced poll didn't reach the server
+    EXPECT_EQ(stub.requests, QStringList({QStringLiteral("/api/profiles/me"),
+                                          QStringLiteral("/relay/worlds/1/players/%1").arg(playerId)}));
+}
+
+void ZwiftApiPollerTestSuite::test_timeout() {
+    zwiftapistub stub(3000);
+    ZwiftApiPoller poller(1, QStringLiteral("token"), stub.baseUrl());
+    poller.setTimeoutMs(200);
+
+    EXPECT_TRUE(poller.poll());
+    ASSERT_TRUE(waitFor([&poller]() { return !poller.isPolling(); }, 2000));
+    EXPECT_EQ(poller.playerId(), -1);
+
+    stub.latencyMs = 10;
+    EXPECT_TRUE(poller.poll());
+    ASSERT_TRUE(waitFor([&poller]() { return !poller.isPolling(); }, 2000));
+    EXPECT_EQ(poller.playerId(), playerId);
+}
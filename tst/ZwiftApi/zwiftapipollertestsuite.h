@@ -0,0 +1,27 @@
+#ifndef ZWIFTAPIPOLLERTESTSUITE_H
+#define ZWIFTAPIPOLLERTESTSUITE_H
+
+#include "gtest/gtest.h"
+
+class ZwiftApiPollerTestSuite : public testing::Test {
+
+  public:
+    ZwiftApiPollerTestSuite();
+
+    /**
+     * @brief Test against a slow local server that poll() returns at once, that a poll while a request is in flight
+     * is coalesced with it and that the PlayerState received is read once from the cache.
+     */
+    void test_pollDoesNotBlock();
+
+    /**
+     * @brief Test that a request the server doesn't answer is aborted and the next poll starts a new one.
+     */
+    void test_timeout();
+};
+
+TEST_F(ZwiftApiPollerTestSuite, TestPollDoesNotBlock) { this->test_pollDoesNotBlock(); }
+
+TEST_F(ZwiftApiPollerTestSuite, TestTimeout) { this->test_timeout(); }
+
+#endif // ZWIFTAPIPOLLERTESTSUITE_H
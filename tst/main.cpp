@@ -1,8 +1,11 @@
-
 #include <gtest/gtest.h>
 
+#include <QCoreApplication>
+
 int main(int argc, char *argv[])
 {
     ::testing::InitGoogleTest(&argc, argv);
+    // the suites with sockets, timers and queued signals need an event loop
+    QCoreApplication app(argc, argv);
     return RUN_ALL_TESTS();
 }
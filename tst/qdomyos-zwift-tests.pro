@@ -22,10 +22,29 @@ SOURCES += \
         Devices/bluetoothdevicetestdata.cpp \
         Devices/bluetoothdevicetestsuite.cpp \
         Devices/bluetoothsignalreceiver.cpp \
+        Devices/commandcoalescertestsuite.cpp \
+        Devices/dirconprocessortestsuite.cpp \
+        Devices/ftmsdecodertestsuite.cpp \
+        Devices/gattwritequeuetestsuite.cpp \
+        Devices/reconnectcachetestsuite.cpp \
         Devices/devicediscoveryinfo.cpp \
         Erg/ergtabletestsuite.cpp \
+        Gpx/gpxtestsuite.cpp \
+        Logging/logwritertestsuite.cpp \
+        Logging/qzlogtestsuite.cpp \
+        Metric/metrictestsuite.cpp \
+        Metric/trainingloadtestsuite.cpp \
+        Session/qfitwritertestsuite.cpp \
+        Session/sessionjournaltestsuite.cpp \
+        Session/sessionstoretestsuite.cpp \
+        Settings/qzsettingssnapshottestsuite.cpp \
+        ToolTests/gattreplaytestsuite.cpp \
         ToolTests/testsettingstestsuite.cpp \
+        TrainProgram/trainprogramtestsuite.cpp \
+        Tools/gattreplay.cpp \
         Tools/testsettings.cpp \
+        VirtualDevices/virtualnotifyschedulertestsuite.cpp \
+        ZwiftApi/zwiftapipollertestsuite.cpp \
         main.cpp
 
 # Avoid the "File too big" error building in Windows. This has happened when a template class is used with Google Test / typed tests
@@ -39,6 +58,13 @@ else:unix: LIBS += -L$$OUT_PWD/../src/ -lqdomyos-zwift
 INCLUDEPATH += $$PWD/../src $$PWD/../src/devices
 DEPENDPATH += $$PWD/../src $$PWD/../src/devices
 
+# the captures replayed by the tests
+DEFINES += BTLOGS_DIR=\\\"$$PWD/../btlogs\\\"
+# the FIT files written by qfit::save before the streaming writer
+DEFINES += FIT_FIXTURES_DIR=\\\"$$PWD/Session/fixtures\\\"
+# the GPX routes shipped with the app
+DEFINES += GPX_DIR=\\\"$$PWD/../src/gpx\\\"
+
 win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../src/release/libqdomyos-zwift.a
 else:win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../src/debug/libqdomyos-zwift.a
 else:win32:!win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../src/release/qdomyos-zwift.lib
@@ -134,6 +160,11 @@ HEADERS += \
     Devices/bluetoothdevicetestdata.h \
     Devices/bluetoothdevicetestsuite.h \
     Devices/bluetoothsignalreceiver.h \
+    Devices/commandcoalescertestsuite.h \
+    Devices/dirconprocessortestsuite.h \
+    Devices/ftmsdecodertestsuite.h \
+    Devices/gattwritequeuetestsuite.h \
+    Devices/reconnectcachetestsuite.h \
     Devices/devicediscoveryinfo.h \
     Devices/devices.h \
     Devices/iConceptBike/iconceptbiketestdata.h \
@@ -141,5 +172,19 @@ HEADERS += \
     Devices/YpooElliptical/ypooellipticaltestdata.h \
     Devices/TrxAppGateUsbElliptical/trxappgateusbellipticaltestdata.h \
     Erg/ergtabletestsuite.h \
+    Gpx/gpxtestsuite.h \
+    Logging/logwritertestsuite.h \
+    Logging/qzlogtestsuite.h \
+    Metric/metrictestsuite.h \
+    Metric/trainingloadtestsuite.h \
+    Session/qfitwritertestsuite.h \
+    Session/sessionjournaltestsuite.h \
+    Session/sessionstoretestsuite.h \
+    Settings/qzsettingssnapshottestsuite.h \
+    ToolTests/gattreplaytestsuite.h \
     ToolTests/testsettingstestsuite.h \
-    Tools/testsettings.h
+    TrainProgram/trainprogramtestsuite.h \
+    Tools/gattreplay.h \
+    Tools/testsettings.h \
+    VirtualDevices/virtualnotifyschedulertestsuite.h \
+    ZwiftApi/zwiftapipollertestsuite.h